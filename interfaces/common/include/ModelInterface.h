@@ -477,6 +477,9 @@ struct MapCompilerOptions
     /// <summary> Maximum num of parallel threads. </summary>
     int maxThreads = 4;
 
+    /// <summary> Use work-stealing scheduling in the thread pool (if thread pool enabled). </summary>
+    bool useWorkStealing = false;
+
     /// <summary> Allow emitting more efficient code that isn't necessarily IEEE-754 compatible. </summary>
     bool useFastMath = true;
 
@@ -504,6 +507,9 @@ struct MapCompilerOptions
 
     /// <summary> Skip ELLCode optimization. </summary>
     bool skip_ellcode = false;
+
+    /// <summary> Number of samples the compiled code computes per call (use ComputeBatch with batchSize > 1). </summary>
+    int batchSize = 1;
 };
 
 //
@@ -347,7 +347,7 @@ del SinkNode_RegisterCallback
 #include <utilities/include/TypeName.h>
 
 template<typename ElementType>
-void ExtractBufferFromPythonList(std::shared_ptr<ell::model::Map> map, PyObject* list, size_t i, std::vector<void*>& args)
+void ExtractBufferFromPythonList(std::shared_ptr<ell::model::Map> map, PyObject* list, size_t i, std::vector<void*>& args, size_t batchSize)
 {
     auto item = PyList_GetItem(list, i);
     std::vector<ElementType>* ptr = nullptr;
@@ -357,7 +357,7 @@ void ExtractBufferFromPythonList(std::shared_ptr<ell::model::Map> map, PyObject*
         std::string typeName = ell::utilities::TypeName<ElementType>::GetName();
         throw std::invalid_argument(ell::utilities::FormatString("List argument %zu is the wrong type, expecting '%s*'", i, typeName.c_str()));
     }
-    auto argSize = map->GetInputSize(i);
+    auto argSize = map->GetInputSize(i) * batchSize;
     if (argSize != ptr->size())
     {
         throw std::invalid_argument(ell::utilities::FormatString("List argument %zu is the wrong size, expecting '%zu'", i, argSize));
@@ -369,7 +369,7 @@ void ExtractBufferFromPythonList(std::shared_ptr<ell::model::Map> map, PyObject*
     }            
 }
 
-std::vector<void*> GetInputBuffersFromList(std::shared_ptr<ell::model::Map> map, PyObject *list) 
+std::vector<void*> GetInputBuffersFromList(std::shared_ptr<ell::model::Map> map, PyObject *list, size_t batchSize = 1)
 {
     // Here we expect a list of arguments, each one is a pre-allocated FloatVector or DoubleVector or AutoDataVector
     // for all the expected inputs of the model.
@@ -393,7 +393,7 @@ std::vector<void*> GetInputBuffersFromList(std::shared_ptr<ell::model::Map> map,
         switch (portType)
         {
         case ell::model::Port::PortType::smallReal:
-            ExtractBufferFromPythonList<float>(map, list, i, args);
+            ExtractBufferFromPythonList<float>(map, list, i, args, batchSize);
             break;
         case ell::model::Port::PortType::real:
             {
@@ -404,7 +404,7 @@ std::vector<void*> GetInputBuffersFromList(std::shared_ptr<ell::model::Map> map,
                 {                        
                     throw std::invalid_argument(ell::utilities::FormatString("List argument %zu is the wrong type, expecting 'double*'", i));
                 }
-                auto argSize = map->GetInputSize(i);
+                auto argSize = map->GetInputSize(i) * batchSize;
                 if (argSize != ptr->size())
                 {
                     throw std::invalid_argument(ell::utilities::FormatString("List argument %zu is the wrong size, expecting '%zu'", i, argSize));
@@ -421,7 +421,7 @@ std::vector<void*> GetInputBuffersFromList(std::shared_ptr<ell::model::Map> map,
                 {                        
                     throw std::invalid_argument(ell::utilities::FormatString("List argument %zu is the wrong type, expecting 'int*'", i));
                 }
-                auto argSize = map->GetInputSize(i);
+                auto argSize = map->GetInputSize(i) * batchSize;
                 if (argSize != ptr->size())
                 {
                     throw std::invalid_argument(ell::utilities::FormatString("List argument %zu is the wrong size, expecting '%zu'", i, argSize));
@@ -438,7 +438,7 @@ std::vector<void*> GetInputBuffersFromList(std::shared_ptr<ell::model::Map> map,
                 {                        
                     throw std::invalid_argument(ell::utilities::FormatString("List argument %zu is the wrong type, expecting 'int64_t*'", i));
                 }
-                auto argSize = map->GetInputSize(i);
+                auto argSize = map->GetInputSize(i) * batchSize;
                 if (argSize != ptr->size())
                 {
                     throw std::invalid_argument(ell::utilities::FormatString("List argument %zu is the wrong size, expecting '%zu'", i, argSize));
@@ -458,7 +458,7 @@ std::vector<void*> GetInputBuffersFromList(std::shared_ptr<ell::model::Map> map,
                 {                        
                     throw std::invalid_argument(ell::utilities::FormatString("List argument %zu is the wrong type, expecting 'int8_t*'", i));
                 }
-                auto argSize = map->GetInputSize(i);
+                auto argSize = map->GetInputSize(i) * batchSize;
                 if (argSize != ptr->size())
                 {
                     throw std::invalid_argument(ell::utilities::FormatString("List argument %zu is the wrong size, expecting '%zu'", i, argSize));
@@ -474,7 +474,7 @@ std::vector<void*> GetInputBuffersFromList(std::shared_ptr<ell::model::Map> map,
     return args;
 }
     
-std::vector<void*> GetOutputBuffersFromList(std::shared_ptr<ell::model::Map> map, PyObject *list) 
+std::vector<void*> GetOutputBuffersFromList(std::shared_ptr<ell::model::Map> map, PyObject *list, size_t batchSize = 1)
 {
     // Here we expect a list of arguments, each one is a pre-allocated FloatVector or DoubleVector or AutoDataVector
     // for all the expected outputs of the model.
@@ -506,7 +506,7 @@ std::vector<void*> GetOutputBuffersFromList(std::shared_ptr<ell::model::Map> map
                 {                        
                     throw std::invalid_argument(ell::utilities::FormatString("List argument %zu is the wrong type, expecting 'float*'", i));
                 }
-                auto argSize = map->GetOutputSize(i);
+                auto argSize = map->GetOutputSize(i) * batchSize;
                 if (argSize != ptr->size())
                 {
                     throw std::invalid_argument(ell::utilities::FormatString("List argument %zu is the wrong size, expecting '%zu'", i, argSize));
@@ -523,7 +523,7 @@ std::vector<void*> GetOutputBuffersFromList(std::shared_ptr<ell::model::Map> map
                 {                        
                     throw std::invalid_argument(ell::utilities::FormatString("List argument %zu is the wrong type, expecting 'double*'", i));
                 }
-                auto argSize = map->GetOutputSize(i);
+                auto argSize = map->GetOutputSize(i) * batchSize;
                 if (argSize != ptr->size())
                 {
                     throw std::invalid_argument(ell::utilities::FormatString("List argument %zu is the wrong size, expecting '%zu'", i, argSize));
@@ -540,7 +540,7 @@ std::vector<void*> GetOutputBuffersFromList(std::shared_ptr<ell::model::Map> map
                 {                        
                     throw std::invalid_argument(ell::utilities::FormatString("List argument %zu is the wrong type, expecting 'int*'", i));
                 }
-                auto argSize = map->GetOutputSize(i);
+                auto argSize = map->GetOutputSize(i) * batchSize;
                 if (argSize != ptr->size())
                 {
                     throw std::invalid_argument(ell::utilities::FormatString("List argument %zu is the wrong size, expecting '%zu'", i, argSize));
@@ -557,7 +557,7 @@ std::vector<void*> GetOutputBuffersFromList(std::shared_ptr<ell::model::Map> map
                 {                        
                     throw std::invalid_argument(ell::utilities::FormatString("List argument %zu is the wrong type, expecting 'int64_t*'", i));
                 }
-                auto argSize = map->GetOutputSize(i);
+                auto argSize = map->GetOutputSize(i) * batchSize;
                 if (argSize != ptr->size())
                 {
                     throw std::invalid_argument(ell::utilities::FormatString("List argument %zu is the wrong size, expecting '%zu'", i, argSize));
@@ -577,7 +577,7 @@ std::vector<void*> GetOutputBuffersFromList(std::shared_ptr<ell::model::Map> map
                 {                        
                     throw std::invalid_argument(ell::utilities::FormatString("List argument %zu is the wrong type, expecting 'int8_t*'", i));
                 }
-                auto argSize = map->GetOutputSize(i);
+                auto argSize = map->GetOutputSize(i) * batchSize;
                 if (argSize != ptr->size())
                 {
                     throw std::invalid_argument(ell::utilities::FormatString("List argument %zu is the wrong size, expecting '%zu'", i, argSize));
@@ -618,11 +618,33 @@ namespace ELL_API
         {
             throw std::invalid_argument("Cannot use ComputeMultiple on a model with Source and Sink nodes, use RegisterCallbacks and Step instead");
         }
+        if (self->GetInnerCompiledMap()->GetCompiledBatchSize() > 1)
+        {
+            throw std::invalid_argument("Cannot use ComputeMultiple on a model compiled for a batch of samples, use ComputeBatch instead");
+        }
         auto map = self->GetInnerMap();
         std::vector<void*> inputs = GetInputBuffersFromList(map, inputList);
         std::vector<void*> outputs = GetOutputBuffersFromList(map, outputList);
         self->GetInnerCompiledMap()->ComputeMultiple(inputs, outputs);
     }
+
+    void ComputeBatch(PyObject *inputList, PyObject *outputList, int batchSize) 
+    {
+        // Each buffer holds batchSize samples, stored one after another. With MapCompilerOptions.batchSize > 1,
+        // the compiled code computes that many samples at a time, sharing the weights of its matrix products.
+        if (self->HasSourceNodes())
+        {
+            throw std::invalid_argument("Cannot use ComputeBatch on a model with Source and Sink nodes, use RegisterCallbacks and Step instead");
+        }
+        if (batchSize < 0)
+        {
+            throw std::invalid_argument("ComputeBatch expects a non-negative batch size");
+        }
+        auto map = self->GetInnerMap();
+        std::vector<void*> inputs = GetInputBuffersFromList(map, inputList, batchSize);
+        std::vector<void*> outputs = GetOutputBuffersFromList(map, outputList, batchSize);
+        self->GetInnerCompiledMap()->ComputeBatch(inputs, outputs, batchSize);
+    }
 }
 
 }
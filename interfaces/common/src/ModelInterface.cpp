@@ -957,6 +957,7 @@ CompiledMap Map::Compile(const std::string& targetDevice, const std::string& mod
     settings.compilerSettings.parallelize = compilerSettings.parallelize;
     settings.compilerSettings.useThreadPool = compilerSettings.useThreadPool;
     settings.compilerSettings.maxThreads = compilerSettings.maxThreads;
+    settings.compilerSettings.useWorkStealing = compilerSettings.useWorkStealing;
     settings.compilerSettings.useFastMath = compilerSettings.useFastMath;
     settings.compilerSettings.includeDiagnosticInfo = compilerSettings.includeDiagnosticInfo;
     settings.compilerSettings.useBlas = compilerSettings.useBlas;
@@ -966,6 +967,7 @@ CompiledMap Map::Compile(const std::string& targetDevice, const std::string& mod
     settings.compilerSettings.vectorWidth = compilerSettings.vectorWidth;
     settings.compilerSettings.debug = compilerSettings.debug;
     settings.compilerSettings.skip_ellcode = compilerSettings.skip_ellcode;
+    settings.batchSize = compilerSettings.batchSize;
 
     ell::model::ModelOptimizerOptions optimizerOptions;
     optimizerOptions["fuseLinearFunctionNodes"] = optimizerSettings.fuseLinearFunctionNodes;
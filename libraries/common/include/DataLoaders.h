@@ -63,6 +63,36 @@ namespace common
     /// <returns> The dataset. </returns>
     data::AutoSupervisedMultiClassDataset GetMultiClassDataset(std::istream& stream);
 
+    /// <summary>
+    /// Gets the number of features of the data in an input stream: the largest size of any of its data vectors. The
+    /// examples are parsed and discarded one at a time, so the data is never held in memory.
+    /// </summary>
+    ///
+    /// <param name="stream"> Input stream to load data from. </param>
+    ///
+    /// <returns> The number of features. </returns>
+    size_t GetDataDimension(std::istream& stream);
+
+    /// <summary>
+    /// Gets an AutoSupervisedDataset dataset from data load arguments. The data file is memory-mapped
+    /// and parsed on `dataLoadArguments.numLoadThreads` threads.
+    /// </summary>
+    ///
+    /// <param name="dataLoadArguments"> The data load arguments. </param>
+    ///
+    /// <returns> The dataset. </returns>
+    data::AutoSupervisedDataset GetDataset(const DataLoadArguments& dataLoadArguments);
+
+    /// <summary>
+    /// Gets an AutoSupervisedMultiClassDataset dataset from data load arguments. The data file is
+    /// memory-mapped and parsed on `dataLoadArguments.numLoadThreads` threads.
+    /// </summary>
+    ///
+    /// <param name="dataLoadArguments"> The data load arguments. </param>
+    ///
+    /// <returns> The dataset. </returns>
+    data::AutoSupervisedMultiClassDataset GetMultiClassDataset(const DataLoadArguments& dataLoadArguments);
+
     /// <summary>
     /// Gets a new dataset by running an existing dataset through a map.
     /// </summary>
@@ -19,13 +19,16 @@ namespace ell
 {
 namespace common
 {
-    /// <summary> Loads a model from a file, or creates a new one if given an empty filename. </summary>
+    /// <summary>
+    /// Loads a model from a file, or creates a new one if given an empty filename. The file may be a JSON
+    /// archive or a binary archive; binary archives are memory-mapped and read without parsing any text.
+    /// </summary>
     ///
     /// <param name="filename"> The filename. </param>
     /// <returns> The loaded model. </returns>
     model::Model LoadModel(const std::string& filename);
 
-    /// <summary> Saves a model to a file. </summary>
+    /// <summary> Saves a model to a file. Files with the extension `.ellb` are written as binary archives, others as JSON. </summary>
     ///
     /// <param name="model"> The model. </param>
     /// <param name="filename"> The filename. </param>
@@ -47,7 +50,10 @@ namespace common
     /// <param name="context"> The `SerializationContext` </param>
     void RegisterMapTypes(utilities::SerializationContext& context);
 
-    /// <summary> Loads a map from a file, or creates a new one if given an empty filename. </summary>
+    /// <summary>
+    /// Loads a map from a file, or creates a new one if given an empty filename. The file may be a JSON
+    /// archive or a binary archive; binary archives are memory-mapped and read without parsing any text.
+    /// </summary>
     ///
     /// <param name="filename"> The filename. </param>
     /// <returns> The loaded map. </returns>
@@ -59,7 +65,7 @@ namespace common
     /// <returns> The loaded map. </returns>
     model::Map LoadMap(const MapLoadArguments& mapLoadArguments);
 
-    /// <summary> Saves a map to a file. </summary>
+    /// <summary> Saves a map to a file. Files with the extension `.ellb` are written as binary archives, others as JSON. </summary>
     ///
     /// <param name="map"> The map. </param>
     /// <param name="filename"> The filename. </param>
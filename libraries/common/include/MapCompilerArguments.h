@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <emitters/include/CompilerOptions.h>
+
 #include <model/include/MapCompilerOptions.h>
 #include <model/include/ModelOptimizerOptions.h>
 
@@ -41,6 +43,10 @@ namespace common
         bool debug = false;
         utilities::Optional<bool> positionIndependentCode = false; // for generating -fPIC object code
         int globalValueAlignment = 32;
+        bool reusePortMemory = false;
+        std::string tuningCachePath;
+        std::string compiledMapCachePath;
+        int compiledBatchSize = 1;
 
         // potentially per-node options:
         bool enableVectorization = true;
@@ -48,10 +54,15 @@ namespace common
         bool parallelize = true;
         bool useThreadPool = true;
         int maxThreads = 4;
+        bool useWorkStealing = false;
+        emitters::FastMathAccuracy fastMathAccuracy = emitters::FastMathAccuracy::ulpBounded;
 
         // optimization options (configurable per-node)
         bool fuseLinearOperations = true;
+        bool fuseEpilogueOperations = true;
         bool optimizeReorderDataNodes = true;
+        bool foldConstants = true;
+        bool eliminateDeadNodes = true;
         PreferredConvolutionMethod convolutionMethod = PreferredConvolutionMethod::automatic; // known methods: auto, unrolled, simple, diagonal, winograd
 
         // raw options to store in metadata
@@ -55,9 +55,19 @@ namespace common
                 "Number of elements to read from each data vector",
                 "");
         }
+
+        if (!_loadThreadsOptionString.empty())
+        {
+            parser.AddOption(
+                numLoadThreads,
+                _loadThreadsOptionString,
+                _shortLoadThreadsOptionString,
+                "Number of threads used to parse the input data file (0 = use all available cores)",
+                0);
+        }
     }
 
-    ParsedDataLoadArguments::ParsedDataLoadArguments(std::optional<OptionName> filenameOption, std::optional<OptionName> directoryOption, std::optional<OptionName> dimensionOption)
+    ParsedDataLoadArguments::ParsedDataLoadArguments(std::optional<OptionName> filenameOption, std::optional<OptionName> directoryOption, std::optional<OptionName> dimensionOption, std::optional<OptionName> loadThreadsOption)
     {
         if (filenameOption)
         {
@@ -76,6 +86,12 @@ namespace common
             _dimensionOptionString = dimensionOption->longName;
             _shortDimensionOptionString = dimensionOption->shortName;
         }
+
+        if (loadThreadsOption)
+        {
+            _loadThreadsOptionString = loadThreadsOption->longName;
+            _shortLoadThreadsOptionString = loadThreadsOption->shortName;
+        }
     }
 
     utilities::CommandLineParseResult ParsedDataLoadArguments::PostProcess(const utilities::CommandLineParser& parser)
@@ -99,13 +115,7 @@ namespace common
             }
 
             auto stream = utilities::OpenIfstream(GetDataFilePath());
-            auto exampleIterator = GetAutoSupervisedExampleIterator(stream);
-            while (exampleIterator.IsValid())
-            {
-                auto size = exampleIterator.Get().GetDataVector().PrefixLength();
-                parsedDataDimension = std::max(parsedDataDimension, size);
-                exampleIterator.Next();
-            }
+            parsedDataDimension = std::max(parsedDataDimension, GetDataDimension(stream));
         }
         else if (dataDimension != "")
         {
@@ -9,15 +9,18 @@
 #include "DataLoaders.h"
 
 #include <utilities/include/Files.h>
+#include <utilities/include/MemoryMappedFile.h>
 
 #include <data/include/Dataset.h>
 #include <data/include/SequentialLineIterator.h>
 
 #include <data/include/AutoDataVector.h>
 #include <data/include/GeneralizedSparseParsingIterator.h>
+#include <data/include/ParallelParsing.h>
 #include <data/include/SingleLineParsingExampleIterator.h>
 #include <data/include/WeightLabel.h>
 
+#include <algorithm>
 #include <memory>
 #include <stdexcept>
 
@@ -36,6 +39,18 @@ namespace common
         return GetExampleIterator<data::SequentialLineIterator, data::ClassIndexParser, data::AutoDataVectorParser<data::GeneralizedSparseParsingIterator>>(stream);
     }
 
+    size_t GetDataDimension(std::istream& stream)
+    {
+        size_t dimension = 0;
+        auto exampleIterator = GetAutoSupervisedExampleIterator(stream);
+        while (exampleIterator.IsValid())
+        {
+            dimension = std::max(dimension, exampleIterator.Get().GetDataVector().PrefixLength());
+            exampleIterator.Next();
+        }
+        return dimension;
+    }
+
     data::AutoSupervisedDataset GetDataset(std::istream& stream)
     {
         return data::MakeDataset(GetExampleIterator<data::SequentialLineIterator, data::LabelParser, data::AutoDataVectorParser<data::GeneralizedSparseParsingIterator>>(stream));
@@ -45,5 +60,17 @@ namespace common
     {
         return data::MakeDataset(GetExampleIterator<data::SequentialLineIterator, data::ClassIndexParser, data::AutoDataVectorParser<data::GeneralizedSparseParsingIterator>>(stream));
     }
+
+    data::AutoSupervisedDataset GetDataset(const DataLoadArguments& dataLoadArguments)
+    {
+        utilities::MemoryMappedFile file(dataLoadArguments.GetDataFilePath());
+        return data::ParseDatasetInParallel(file.GetData(), file.GetSize(), data::LabelParser(), data::AutoDataVectorParser<data::GeneralizedSparseParsingIterator>(), dataLoadArguments.numLoadThreads);
+    }
+
+    data::AutoSupervisedMultiClassDataset GetMultiClassDataset(const DataLoadArguments& dataLoadArguments)
+    {
+        utilities::MemoryMappedFile file(dataLoadArguments.GetDataFilePath());
+        return data::ParseDatasetInParallel(file.GetData(), file.GetSize(), data::ClassIndexParser(), data::AutoDataVectorParser<data::GeneralizedSparseParsingIterator>(), dataLoadArguments.numLoadThreads);
+    }
 } // namespace common
 } // namespace ell
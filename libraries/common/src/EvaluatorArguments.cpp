@@ -27,6 +27,13 @@ namespace common
             "aze",
             "Add an evaluation using the constant zero predictor",
             true);
+
+        parser.AddOption(
+            numThreads,
+            "evaluationThreads",
+            "et",
+            "Number of threads to evaluate with (0 means one per core)",
+            1);
     }
 } // namespace common
 } // namespace ell
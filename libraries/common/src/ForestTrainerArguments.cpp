@@ -50,6 +50,18 @@ namespace common
                          "The number of split candidates to create per input element",
                          8);
 
+        parser.AddOption(numBins,
+                         "numBins",
+                         "nb",
+                         "If nonzero, the histogram trainer buckets each input element into this many bins (at most 256) and finds splits from histograms of the bins",
+                         0);
+
+        parser.AddOption(numThreads,
+                         "numThreads",
+                         "nt",
+                         "The number of threads the histogram trainer uses to build histograms of binned inputs (0 = use all cores)",
+                         0);
+
         parser.AddOption(sortingTrainer,
                          "sortingTrainer",
                          "st",
@@ -29,10 +29,12 @@
 #include <nodes/include/DelayNode.h>
 #include <nodes/include/DiagonalConvolutionNode.h>
 #include <nodes/include/DotProductNode.h>
+#include <nodes/include/ExponentialMovingAverageNode.h>
 #include <nodes/include/ExtremalValueNode.h>
 #include <nodes/include/FastGRNNNode.h>
 #include <nodes/include/FFTNode.h>
 #include <nodes/include/FilterBankNode.h>
+#include <nodes/include/FlatForestPredictorNode.h>
 #include <nodes/include/ForestPredictorNode.h>
 #include <nodes/include/GRUNode.h>
 #include <nodes/include/HammingWindowNode.h>
@@ -50,6 +52,7 @@
 #include <nodes/include/MultiplexerNode.h>
 #include <nodes/include/NeuralNetworkPredictorNode.h>
 #include <nodes/include/ProtoNNPredictorNode.h>
+#include <nodes/include/QuantizedMatrixMatrixMultiplyNode.h>
 #include <nodes/include/RNNNode.h>
 #include <nodes/include/ReceptiveFieldMatrixNode.h>
 #include <nodes/include/ReinterpretLayoutNode.h>
@@ -58,6 +61,7 @@
 #include <nodes/include/ScalingNode.h>
 #include <nodes/include/SimpleConvolutionNode.h>
 #include <nodes/include/SinkNode.h>
+#include <nodes/include/SlidingWindowStatisticsNode.h>
 #include <nodes/include/SourceNode.h>
 #include <nodes/include/SpatialConvolutionNode.h>
 #include <nodes/include/UnaryOperationNode.h>
@@ -79,8 +83,10 @@
 #include <predictors/neural/include/TanhActivation.h>
 
 #include <utilities/include/Archiver.h>
+#include <utilities/include/BinaryArchiver.h>
 #include <utilities/include/Files.h>
 #include <utilities/include/JsonArchiver.h>
+#include <utilities/include/MemoryMappedFile.h>
 
 #include <cstdint>
 
@@ -121,6 +127,7 @@ namespace common
         context.GetTypeFactory().AddType<model::Node, nodes::DiagonalConvolutionComputeNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::DotProductNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::DTWDistanceNode<ElementType>>();
+        context.GetTypeFactory().AddType<model::Node, nodes::ExponentialMovingAverageNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::FastGRNNNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::FFTNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::GRUNode<ElementType>>();
@@ -140,6 +147,7 @@ namespace common
         context.GetTypeFactory().AddType<model::Node, nodes::MovingAverageNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::MovingVarianceNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::NeuralNetworkPredictorNode<ElementType>>();
+        context.GetTypeFactory().AddType<model::Node, nodes::QuantizedMatrixMatrixMultiplyNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::ReceptiveFieldMatrixNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::ReorderDataCodeNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::ReorderDataNode<ElementType>>();
@@ -149,6 +157,7 @@ namespace common
         context.GetTypeFactory().AddType<model::Node, nodes::SimpleConvolutionComputeNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::SimpleConvolutionNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::SinkNode<ElementType>>();
+        context.GetTypeFactory().AddType<model::Node, nodes::SlidingWindowStatisticsNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::SourceNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::SpatialConvolutionNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::SumNode<ElementType>>();
@@ -267,6 +276,7 @@ namespace common
         context.GetTypeFactory().AddType<model::Node, nodes::ReinterpretLayoutNode<bool>>();
 
         context.GetTypeFactory().AddType<model::Node, nodes::SimpleForestPredictorNode>();
+        context.GetTypeFactory().AddType<model::Node, nodes::FlatForestPredictorNode>();
 
         context.GetTypeFactory().AddType<model::Node, nodes::SingleElementThresholdNode>();
 
@@ -320,6 +330,43 @@ namespace common
         archiver.Archive(obj);
     }
 
+    namespace
+    {
+        bool IsBinaryArchiveFilename(const std::string& filename)
+        {
+            return GetFileExtension(filename, true) == "ellb";
+        }
+
+        // Only reads the header, so text archives are never mapped
+        bool IsBinaryArchiveFile(const std::string& filename)
+        {
+            auto filestream = OpenBinaryIfstream(filename);
+            return BinaryUnarchiver::IsBinaryArchive(filestream);
+        }
+
+        model::Model LoadMappedModel(const MemoryMappedFile& file)
+        {
+            SerializationContext context;
+            RegisterNodeTypes(context);
+            BinaryUnarchiver unarchiver(file.GetData(), file.GetSize(), context);
+            model::Model model;
+            unarchiver.Unarchive(model);
+            return model;
+        }
+
+        model::Map LoadMappedMap(const MemoryMappedFile& file)
+        {
+            SerializationContext context;
+            RegisterNodeTypes(context);
+            RegisterMapTypes(context);
+            AddCustomTypes(context);
+            BinaryUnarchiver unarchiver(file.GetData(), file.GetSize(), context);
+            model::Map map;
+            unarchiver.Unarchive(map);
+            return map;
+        }
+    } // namespace
+
     model::Model LoadModel(const std::string& filename)
     {
         if (!IsFileReadable(filename))
@@ -327,6 +374,13 @@ namespace common
             throw SystemException(SystemExceptionErrors::fileNotFound);
         }
 
+        // Binary archives are read straight out of the mapped file, without parsing or buffering it
+        if (IsBinaryArchiveFile(filename))
+        {
+            MemoryMappedFile file(filename);
+            return LoadMappedModel(file);
+        }
+
         auto filestream = OpenIfstream(filename);
         return LoadArchivedModel<JsonUnarchiver>(filestream);
     }
@@ -337,6 +391,14 @@ namespace common
         {
             throw SystemException(SystemExceptionErrors::fileNotWritable);
         }
+
+        if (IsBinaryArchiveFilename(filename))
+        {
+            auto filestream = OpenBinaryOfstream(filename);
+            SaveArchivedObject<BinaryArchiver>(model, filestream);
+            return;
+        }
+
         auto filestream = OpenOfstream(filename);
         SaveModel(model, filestream);
     }
@@ -422,10 +484,15 @@ namespace common
             throw SystemException(SystemExceptionErrors::fileNotFound, "File not found '" + filename + "'");
         }
 
-        auto filestream = OpenIfstream(filename);
-
         try
         {
+            if (IsBinaryArchiveFile(filename))
+            {
+                MemoryMappedFile file(filename);
+                return LoadMappedMap(file);
+            }
+
+            auto filestream = OpenIfstream(filename);
             return LoadArchivedMap<JsonUnarchiver>(filestream);
         }
         catch (const std::exception& ex)
@@ -440,6 +507,14 @@ namespace common
         {
             throw SystemException(SystemExceptionErrors::fileNotWritable);
         }
+
+        if (IsBinaryArchiveFilename(filename))
+        {
+            auto filestream = OpenBinaryOfstream(filename);
+            SaveArchivedObject<BinaryArchiver>(map, filestream);
+            return;
+        }
+
         auto filestream = OpenOfstream(filename);
         SaveMap(map, filestream);
     }
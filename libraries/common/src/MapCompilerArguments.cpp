@@ -62,6 +62,13 @@ namespace common
             "Fuse sequences of linear operations with constant coefficients into a single operation",
             true);
 
+        parser.AddOption(
+            fuseEpilogueOperations,
+            "fuseEpilogues",
+            "",
+            "Apply the bias, scaling and activation after a convolution or matrix multiplication as part of that operation",
+            true);
+
         parser.AddOption(
             optimizeReorderDataNodes,
             "optimizeReorderDataNodes",
@@ -69,6 +76,20 @@ namespace common
             "Optimize sequences of reordering nodes",
             true);
 
+        parser.AddOption(
+            foldConstants,
+            "foldConstants",
+            "",
+            "Precompute nodes whose inputs are all constant",
+            true);
+
+        parser.AddOption(
+            eliminateDeadNodes,
+            "eliminateDeadNodes",
+            "",
+            "Remove unused constant nodes left behind by other optimizations",
+            true);
+
         parser.AddOption(
             convolutionMethod,
             "convolutionMethod",
@@ -130,6 +151,22 @@ namespace common
             "Maximum num of parallel threads",
             4);
 
+        parser.AddOption(
+            useWorkStealing,
+            "workStealing",
+            "ws",
+            "Use work-stealing scheduling in the thread pool (if thread pool enabled)",
+            false);
+
+        parser.AddOption(
+            fastMathAccuracy,
+            "fastMathAccuracy",
+            "",
+            "Accuracy of the exp, log, tanh, and sigmoid approximations used for float values",
+            { { "ulpBounded", emitters::FastMathAccuracy::ulpBounded },
+              { "fast", emitters::FastMathAccuracy::fast } },
+            "ulpBounded");
+
         parser.AddOption(
             debug,
             "debug",
@@ -198,6 +235,34 @@ namespace common
             "gva",
             "The number of bytes to align global buffers to",
             32);
+
+        parser.AddOption(
+            reusePortMemory,
+            "reusePortMemory",
+            "rpm",
+            "Share memory between intermediate buffers whose lifetimes don't overlap",
+            false);
+
+        parser.AddOption(
+            tuningCachePath,
+            "tuningCachePath",
+            "tcp",
+            "A file of tuned tile sizes to use for matrix multiplications and convolutions",
+            "");
+
+        parser.AddOption(
+            compiledMapCachePath,
+            "compiledMapCache",
+            "cmc",
+            "A directory of previously compiled models to reuse, keyed by a hash of the model and compiler options",
+            "");
+
+        parser.AddOption(
+            compiledBatchSize,
+            "compiledBatchSize",
+            "cbs",
+            "The number of samples the compiled predict function computes in one call. Matrix-vector products with fixed weights become one matrix-matrix product over the batch",
+            1);
         
         parser.AddOption(
             skip_ellcode,
@@ -241,8 +306,16 @@ namespace common
         settings.compilerSettings.useBlas = useBlas;
         settings.compilerSettings.allowVectorInstructions = enableVectorization;
         settings.compilerSettings.parallelize = parallelize;
+        settings.compilerSettings.useThreadPool = useThreadPool;
+        settings.compilerSettings.maxThreads = maxThreads;
+        settings.compilerSettings.useWorkStealing = useWorkStealing;
+        settings.compilerSettings.fastMathAccuracy = fastMathAccuracy;
         settings.compilerSettings.vectorWidth = vectorWidth;
         settings.profile = profile;
+        settings.reusePortMemory = reusePortMemory;
+        settings.tuningCachePath = tuningCachePath;
+        settings.compiledMapCachePath = compiledMapCachePath;
+        settings.batchSize = compiledBatchSize;
         settings.compilerSettings.profile = profile;
         settings.compilerSettings.positionIndependentCode = positionIndependentCode;
         settings.compilerSettings.globalValueAlignment = globalValueAlignment;
@@ -292,7 +365,10 @@ namespace common
     {
         model::ModelOptimizerOptions options;
         options["fuseLinearFunctionNodes"] = fuseLinearOperations;
+        options["fuseEpilogueOperations"] = fuseEpilogueOperations;
         options["optimizeReorderDataNodes"] = optimizeReorderDataNodes;
+        options["foldConstants"] = foldConstants;
+        options["eliminateDeadNodes"] = eliminateDeadNodes;
         options["preferredConvolutionMethod"] = convolutionMethod;
 
         auto metadata = GetOptionsMetadata();
@@ -9,4 +9,5 @@ namespace ell
 {
 void TestLoadDataset(const std::string& examplePath);
 void TestLoadMappedDataset(const std::string& examplePath);
+void TestGetDataDimension(const std::string& examplePath);
 } // namespace ell
\ No newline at end of file
@@ -12,6 +12,7 @@
 
 #include <testing/include/testing.h>
 
+#include <utilities/include/CommandLineParser.h>
 #include <utilities/include/Files.h>
 
 #include <iostream>
@@ -37,4 +38,24 @@ void TestLoadMappedDataset(const std::string& examplePath)
     auto dataset = common::GetDataset(stream);
     dataset = common::TransformDataset(dataset, map);
 }
+
+void TestGetDataDimension(const std::string& examplePath)
+{
+    auto dataPath = utilities::JoinPaths(examplePath, { "data", "testData.txt" });
+    auto datasetStream = utilities::OpenIfstream(dataPath);
+    auto dataset = common::GetDataset(datasetStream);
+
+    auto dimensionStream = utilities::OpenIfstream(dataPath);
+    auto dimension = common::GetDataDimension(dimensionStream);
+    testing::ProcessTest("Testing GetDataDimension", dimension > 0 && dimension == dataset.NumFeatures());
+
+    // The 'auto' data dimension option is resolved with the same scan
+    common::ParsedDataLoadArguments args;
+    args.inputDataFilename = dataPath;
+    args.dataDimension = "auto";
+    const char* argv[] = { "TestGetDataDimension" };
+    utilities::CommandLineParser parser(1, argv);
+    auto result = args.PostProcess(parser);
+    testing::ProcessTest("Testing 'auto' data dimension", result && args.parsedDataDimension == dataset.NumFeatures());
+}
 } // namespace ell
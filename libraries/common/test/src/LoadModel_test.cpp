@@ -96,4 +96,19 @@ void TestSaveModels()
     testing::ProcessTest("Testing tree model 2 size", newTree2.Size() == expectedTreeModel2Size);
     testing::ProcessTest("Testing tree model 3 size", newTree3.Size() == expectedTreeModel3Size);
 }
+
+void TestSaveBinaryModels()
+{
+    auto model1 = common::LoadTestModel("[1]");
+    auto tree3 = common::LoadTestModel("[tree_3]");
+
+    common::SaveModel(model1, "model_1.ellb");
+    common::SaveModel(tree3, "tree_3.ellb");
+
+    auto newModel1 = common::LoadModel("model_1.ellb");
+    auto newTree3 = common::LoadModel("tree_3.ellb");
+
+    testing::ProcessTest("Testing binary model 1 size", newModel1.Size() == expectedModel1Size);
+    testing::ProcessTest("Testing binary tree model 3 size", newTree3.Size() == expectedTreeModel3Size);
+}
 } // namespace ell
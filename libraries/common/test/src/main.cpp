@@ -37,12 +37,14 @@ int main(int argc, char* argv[])
         TestLoadSavedModels(examplePath);
 
         TestSaveModels();
+        TestSaveBinaryModels();
 
         TestLoadMapWithDefaultArgs(examplePath);
         TestLoadMapWithPorts(examplePath);
 
         TestLoadDataset(examplePath);
         TestLoadMappedDataset(examplePath);
+        TestGetDataDimension(examplePath);
     }
     catch (const utilities::Exception& exception)
     {
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ParallelParsing.h (data)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Dataset.h"
+#include "Example.h"
+#include "TextLine.h"
+
+#include <utilities/include/ThreadPool.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ell
+{
+namespace data
+{
+    /// <summary>
+    /// Parses a block of text that holds one example per line (for instance, the contents of a memory-mapped
+    /// data file) into a dataset. The text is split into chunks at line boundaries, the chunks are parsed
+    /// concurrently into separate example buffers, and the buffers are concatenated in order. Lines are
+    /// treated exactly as `SingleLineParsingExampleIterator` treats them: lines that hold just whitespace or
+    /// a comment are skipped, and the order of the examples matches the order of the lines.
+    /// </summary>
+    ///
+    /// <typeparam name="MetadataParserType"> Metadata parser type. </typeparam>
+    /// <typeparam name="DataVectorParserType"> DataVector parser type. </typeparam>
+    /// <param name="text"> Pointer to the text. </param>
+    /// <param name="size"> The size of the text, in bytes. </param>
+    /// <param name="metadataParser"> The metadata parser. Each chunk is parsed with its own copy. </param>
+    /// <param name="dataVectorParser"> The data vector parser. Each chunk is parsed with its own copy. </param>
+    /// <param name="numThreads"> The number of threads to parse with. If zero, uses the hardware concurrency of the machine. </param>
+    ///
+    /// <returns> The dataset. </returns>
+    template <typename MetadataParserType, typename DataVectorParserType>
+    auto ParseDatasetInParallel(const char* text, size_t size, const MetadataParserType& metadataParser, const DataVectorParserType& dataVectorParser, size_t numThreads = 0);
+
+    /// <summary> Splits a block of text into chunks that end on line boundaries. </summary>
+    ///
+    /// <param name="text"> Pointer to the text. </param>
+    /// <param name="size"> The size of the text, in bytes. </param>
+    /// <param name="numChunks"> The desired number of chunks. Fewer chunks are returned if the text has too few lines. </param>
+    ///
+    /// <returns> The offsets of the chunk boundaries, starting with 0 and ending with `size`. </returns>
+    std::vector<size_t> GetLineAlignedChunkBoundaries(const char* text, size_t size, size_t numChunks);
+} // namespace data
+} // namespace ell
+
+#pragma region implementation
+
+namespace ell
+{
+namespace data
+{
+    namespace detail
+    {
+        // chunks smaller than this aren't worth handing to another thread
+        constexpr size_t minParsingChunkSize = 1 << 16;
+
+        template <typename ExampleType, typename MetadataParserType, typename DataVectorParserType>
+        void ParseChunk(const char* begin, const char* end, MetadataParserType metadataParser, DataVectorParserType dataVectorParser, std::vector<ExampleType>& examples)
+        {
+            while (begin < end)
+            {
+                auto lineEnd = std::find(begin, end, '\n');
+                TextLine line(std::string(begin, lineEnd));
+                begin = lineEnd == end ? end : lineEnd + 1;
+
+                // skip lines that contain just whitespace or just a comment
+                line.TrimLeadingWhitespace();
+                if (line.IsEndOfContent())
+                {
+                    continue;
+                }
+
+                auto metaData = metadataParser.Parse(line);
+                auto dataVector = dataVectorParser.Parse(line);
+                examples.emplace_back(std::move(dataVector), std::move(metaData));
+            }
+        }
+    } // namespace detail
+
+    template <typename MetadataParserType, typename DataVectorParserType>
+    auto ParseDatasetInParallel(const char* text, size_t size, const MetadataParserType& metadataParser, const DataVectorParserType& dataVectorParser, size_t numThreads)
+    {
+        using ExampleType = ParserExample<DataVectorParserType, MetadataParserType>;
+
+        // Give each thread a few chunks, so that a chunk full of long lines doesn't hold up the others.
+        // Small inputs are parsed on the calling thread.
+        size_t numChunks = std::min(size / detail::minParsingChunkSize, 4 * std::max<size_t>(numThreads, 1));
+        std::unique_ptr<utilities::ThreadPool> threadPool;
+        if (numChunks > 1 && numThreads != 1)
+        {
+            threadPool = std::make_unique<utilities::ThreadPool>(numThreads);
+            numChunks = std::min(size / detail::minParsingChunkSize, 4 * (threadPool->NumThreads() + 1));
+        }
+
+        auto boundaries = GetLineAlignedChunkBoundaries(text, size, std::max<size_t>(numChunks, 1));
+        std::vector<std::vector<ExampleType>> chunkExamples(boundaries.size() - 1);
+        auto parseChunk = [&](size_t chunkIndex) {
+            detail::ParseChunk(text + boundaries[chunkIndex], text + boundaries[chunkIndex + 1], metadataParser, dataVectorParser, chunkExamples[chunkIndex]);
+        };
+
+        if (threadPool && chunkExamples.size() > 1)
+        {
+            threadPool->ParallelFor(chunkExamples.size(), parseChunk, 1);
+        }
+        else
+        {
+            for (size_t chunkIndex = 0; chunkIndex < chunkExamples.size(); ++chunkIndex)
+            {
+                parseChunk(chunkIndex);
+            }
+        }
+
+        Dataset<ExampleType> dataset;
+        for (auto& examples : chunkExamples)
+        {
+            for (auto& example : examples)
+            {
+                dataset.AddExample(std::move(example));
+            }
+            std::vector<ExampleType>().swap(examples);
+        }
+        return dataset;
+    }
+} // namespace data
+} // namespace ell
+
+#pragma endregion implementation
@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ParallelParsing.cpp (data)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ParallelParsing.h"
+
+#include <algorithm>
+
+namespace ell
+{
+namespace data
+{
+    std::vector<size_t> GetLineAlignedChunkBoundaries(const char* text, size_t size, size_t numChunks)
+    {
+        std::vector<size_t> boundaries{ 0 };
+        numChunks = std::max<size_t>(numChunks, 1);
+        for (size_t chunkIndex = 1; chunkIndex < numChunks; ++chunkIndex)
+        {
+            // move the nominal boundary forward to just past the end of the line it falls in
+            auto begin = std::max(boundaries.back(), chunkIndex * size / numChunks);
+            if (begin == 0)
+            {
+                continue;
+            }
+
+            auto lineEnd = std::find(text + begin - 1, text + size, '\n');
+            if (lineEnd == text + size)
+            {
+                break;
+            }
+
+            auto boundary = static_cast<size_t>(lineEnd - text) + 1;
+            if (boundary > boundaries.back() && boundary < size)
+            {
+                boundaries.push_back(boundary);
+            }
+        }
+        boundaries.push_back(size);
+        return boundaries;
+    }
+} // namespace data
+} // namespace ell
@@ -11,6 +11,7 @@
 #include <data/include/AutoDataVector.h>
 #include <data/include/Dataset.h>
 #include <data/include/GeneralizedSparseParsingIterator.h>
+#include <data/include/ParallelParsing.h>
 #include <data/include/SequentialLineIterator.h>
 #include <data/include/SingleLineParsingExampleIterator.h>
 #include <data/include/TextLine.h>
@@ -142,4 +143,48 @@ void SingleFileParseTest()
     testing::ProcessTest("SingleFileParse test2", dataset[1].GetMetadata().label == -1 && testing::IsEqual(dataset[1].GetDataVector().ToArray(), { 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 3 }));
     testing::ProcessTest("SingleFileParse test3", dataset[2].GetMetadata().label == 1 && testing::IsEqual(dataset[2].GetDataVector().ToArray(), { 2.7, 0, 0, 0, -0.3, 0, 0, 0, 0, 0, 3.14 }));
 }
+
+void ParallelParseTest()
+{
+    // generate enough lines to be split into several chunks, including comments and blank lines
+    std::stringstream textStream;
+    const size_t numRows = 20000;
+    for (size_t row = 0; row < numRows; ++row)
+    {
+        textStream << (row % 2 == 0 ? "1.0" : "-1.0") << "\t" << (row % 5) << ":" << row << " " << (row % 7 + 5) << ":0.5";
+        if (row % 3 == 0)
+        {
+            textStream << " // comment";
+        }
+        textStream << "\n";
+        if (row % 11 == 0)
+        {
+            textStream << "   \n# comment line\n";
+        }
+    }
+    textStream << "1.0 3 4 5"; // last line without a newline
+    auto text = textStream.str();
+
+    auto boundaries = data::GetLineAlignedChunkBoundaries(text.data(), text.size(), 16);
+    bool boundariesOk = boundaries.size() > 2 && boundaries.front() == 0 && boundaries.back() == text.size();
+    for (size_t index = 1; index + 1 < boundaries.size(); ++index)
+    {
+        boundariesOk = boundariesOk && boundaries[index] > boundaries[index - 1] && text[boundaries[index] - 1] == '\n';
+    }
+    testing::ProcessTest("ParallelParse chunk boundaries", boundariesOk);
+
+    std::stringstream stream(text);
+    auto expected = data::MakeDataset(data::MakeSingleLineParsingExampleIterator(data::SequentialLineIterator(stream), data::LabelParser(), data::AutoDataVectorParser<data::GeneralizedSparseParsingIterator>()));
+
+    for (size_t numThreads : { 1, 4 })
+    {
+        auto dataset = data::ParseDatasetInParallel(text.data(), text.size(), data::LabelParser(), data::AutoDataVectorParser<data::GeneralizedSparseParsingIterator>(), numThreads);
+        bool ok = dataset.NumExamples() == expected.NumExamples() && dataset.NumExamples() == numRows + 1 && dataset.NumFeatures() == expected.NumFeatures();
+        for (size_t index = 0; ok && index < dataset.NumExamples(); ++index)
+        {
+            ok = dataset[index].GetMetadata().label == expected[index].GetMetadata().label && testing::IsEqual(dataset[index].GetDataVector().ToArray(), expected[index].GetDataVector().ToArray());
+        }
+        testing::ProcessTest("ParallelParse test with " + std::to_string(numThreads) + " threads", ok);
+    }
+}
 } // namespace ell
\ No newline at end of file
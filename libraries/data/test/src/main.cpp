@@ -30,6 +30,7 @@ int main()
     DataVectorParseTest();
     AutoDataVectorParseTest();
     SingleFileParseTest();
+    ParallelParseTest();
 
     if (testing::DidTestFail())
     {
@@ -6,10 +6,11 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-#include <math/include/MathConstants.h>
-#include <math/include/Vector.h>
+#pragma once
+
+#include "FFTPlan.h"
 
-#include <utilities/include/Unused.h>
+#include <math/include/Vector.h>
 
 #include <complex>
 #include <vector>
@@ -22,6 +23,8 @@ namespace dsp
     ///
     /// <param name="signal"> The signal vector to process. Must be a power of 2 in length. </param>
     /// <param name="inverse"> A flag indicating if the inverse FFT should be computed instead. </param>
+    ///
+    /// <remarks> Uses the shared `FFTPlan` for the size of the signal. To avoid the lookup, use an `FFTPlan` directly. </remarks>
     template <typename ValueType>
     void FFT(std::vector<std::complex<ValueType>>& signal, bool inverse = false);
 
@@ -59,109 +62,31 @@ namespace dsp
 {
     namespace detail
     {
-        template <typename Iterator>
-        void Deinterleave(Iterator begin, Iterator end, Iterator scratch)
-        {
-            const auto size = end - begin;
-            const auto halfN = size / 2;
-            for (int index = 0; index < halfN; ++index)
-            {
-                scratch[index] = begin[2 * index + 1];
-                begin[index] = begin[2 * index];
-            }
-            for (int index = 0; index < halfN; ++index)
-            {
-                begin[index + halfN] = scratch[index];
-            }
-        }
-
-        template <typename Iterator>
-        void FFT(Iterator begin, Iterator end, Iterator scratch, bool inverse)
+        template <typename ValueType, typename SignalType>
+        void FFTMagnitudes(SignalType& signal, size_t size, bool inverse)
         {
-            if (inverse)
+            if (size == 0)
             {
-                throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented);
+                return;
             }
-            using ValueType = typename Iterator::value_type::value_type;
-            const ValueType pi = math::Constants<ValueType>::pi;
 
-            auto halfN = (end - begin) / 2;
-            if (halfN < 1)
+            const auto plan = GetFFTPlan<ValueType>(size);
+            std::vector<ValueType> input(size);
+            for (size_t index = 0; index < size; ++index)
             {
-                return; // done
+                input[index] = signal[index];
             }
 
-            Deinterleave(begin, end, scratch);
-            auto evens = begin;
-            auto odds = begin + halfN;
+            std::vector<std::complex<ValueType>> output(size / 2 + 1);
+            plan->RealTransform(input.data(), output.data());
 
-            if (halfN > 1)
+            // The transform of a real-valued signal is conjugate-symmetric, so the magnitudes of the upper half mirror
+            // the lower half. The inverse transform of a real signal is the conjugate of the forward one, scaled by 1/N.
+            const auto scale = inverse ? ValueType{ 1 } / static_cast<ValueType>(size) : ValueType{ 1 };
+            for (size_t index = 0; index < size; ++index)
             {
-                FFT(evens, evens + halfN, scratch, inverse);
-                FFT(odds, odds + halfN, scratch, inverse);
-            }
-
-            for (int k = 0; k < halfN; k++)
-            {
-                // w = e^(2*pi*k/N)
-                std::complex<ValueType> w = std::exp(std::complex<ValueType>(0, pi * k / halfN));
-                auto e = evens[k];
-                auto o = odds[k];
-                auto wo = w * o;
-                evens[k] = e + wo; // even
-                odds[k] = e - wo; // odd
-            }
-        }
-
-        template <typename Iterator, typename ComplexIterator>
-        void FFTReal(Iterator begin, Iterator end, Iterator scratch, ComplexIterator outputBegin, ComplexIterator outputEnd, bool inverse)
-        {
-            UNUSED(outputEnd);
-            if (inverse)
-            {
-                throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented, "inverse must be false");
-            }
-
-            using ValueType = typename Iterator::value_type;
-            const ValueType pi = math::Constants<ValueType>::pi;
-
-            auto halfN = (end - begin) / 2;
-            if (halfN < 1)
-            {
-                return; // done
-            }
-
-            Deinterleave(begin, end, scratch);
-
-            auto evens = begin;
-            auto odds = begin + halfN;
-            auto complexEvens = outputBegin;
-            auto complexOdds = outputBegin + halfN;
-
-            if (halfN > 1)
-            {
-                FFTReal(evens, evens + halfN, scratch, complexEvens, complexEvens + halfN, inverse);
-                FFTReal(odds, odds + halfN, scratch, complexOdds, complexOdds + halfN, inverse);
-            }
-            else
-            {
-                // Base case: copy from real to complex
-                for (int index = 0; index < halfN; ++index)
-                {
-                    complexEvens[index] = evens[index];
-                    complexOdds[index] = odds[index];
-                }
-            }
-
-            for (int k = 0; k < halfN; k++)
-            {
-                // w = e^(2*pi*k/N)
-                std::complex<ValueType> w = std::exp(std::complex<ValueType>(0, pi * k / halfN));
-                auto e = complexEvens[k];
-                auto o = complexOdds[k];
-                auto wo = w * o;
-                complexEvens[k] = e + wo; // even
-                complexOdds[k] = e - wo; // odd
+                const auto bin = index <= size / 2 ? index : size - index;
+                signal[index] = std::abs(output[bin]) * scale;
             }
         }
     } // namespace detail
@@ -169,35 +94,23 @@ namespace dsp
     template <typename ValueType>
     void FFT(std::vector<std::complex<ValueType>>& input, bool inverse)
     {
-        std::vector<std::complex<ValueType>> scratch(input.size() / 2);
-        detail::FFT(std::begin(input), std::end(input), std::begin(scratch), inverse);
+        if (input.empty())
+        {
+            return;
+        }
+        GetFFTPlan<ValueType>(input.size())->Transform(input, inverse);
     }
 
     template <typename ValueType>
     void FFT(std::vector<ValueType>& input, bool inverse)
     {
-        auto size = input.size();
-        std::vector<ValueType> scratch(size / 2);
-        std::vector<std::complex<ValueType>> output(size);
-        detail::FFTReal(std::begin(input), std::end(input), std::begin(scratch), std::begin(output), std::end(output), inverse);
-        for (size_t index = 0; index < size; ++index)
-        {
-            input[index] = std::abs(output[index]);
-        }
+        detail::FFTMagnitudes<ValueType>(input, input.size(), inverse);
     }
 
     template <typename ValueType>
     void FFT(math::RowVector<ValueType>& input, bool inverse)
     {
-        using std::begin;
-        auto size = input.Size();
-        math::RowVector<ValueType> scratch(size / 2);
-        std::vector<std::complex<ValueType>> output(size);
-        detail::FFTReal(begin(input), end(input), begin(scratch), begin(output), end(output), inverse);
-        for (size_t index = 0; index < size; ++index)
-        {
-            input[index] = std::abs(output[index]);
-        }
+        detail::FFTMagnitudes<ValueType>(input, input.Size(), inverse);
     }
 } // namespace dsp
 } // namespace ell
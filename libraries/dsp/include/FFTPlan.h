@@ -0,0 +1,343 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FFTPlan.h (dsp)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <math/include/MathConstants.h>
+
+#include <utilities/include/Exception.h>
+
+#include <complex>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace ell
+{
+namespace dsp
+{
+    /// <summary>
+    /// A plan for computing discrete ("fast") fourier transforms (FFTs) of a fixed, power-of-2 size.
+    /// The twiddle factors and bit-reversal permutation are computed once, when the plan is created,
+    /// and the transforms themselves are iterative radix-4 passes (with one radix-2 pass when the
+    /// number of bits in the size is odd). A plan is immutable once created, so it can be shared by
+    /// several threads.
+    ///
+    /// The forward transform uses the kernel e^(2*pi*i*n*k/N), and the inverse transform uses
+    /// e^(-2*pi*i*n*k/N) and scales the result by 1/N, so that the inverse undoes the forward transform.
+    /// </summary>
+    template <typename ValueType>
+    class FFTPlan
+    {
+    public:
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="size"> The size of the transform. Must be a power of 2. </param>
+        explicit FFTPlan(size_t size);
+
+        /// <summary> Gets the size of the transform. </summary>
+        ///
+        /// <returns> The size of the transform. </returns>
+        size_t Size() const { return _size; }
+
+        /// <summary> Performs an in-place transform of a complex-valued signal. </summary>
+        ///
+        /// <param name="signal"> The signal to transform. Must have exactly `Size()` entries. </param>
+        /// <param name="inverse"> A flag indicating if the inverse transform should be computed instead. </param>
+        void Transform(std::vector<std::complex<ValueType>>& signal, bool inverse = false) const;
+
+        /// <summary> Performs an in-place transform of a complex-valued signal. </summary>
+        ///
+        /// <param name="signal"> A pointer to the `Size()` entries of the signal to transform. </param>
+        /// <param name="inverse"> A flag indicating if the inverse transform should be computed instead. </param>
+        void Transform(std::complex<ValueType>* signal, bool inverse = false) const;
+
+        /// <summary>
+        /// Performs the forward transform of a real-valued signal. The signal is packed into a complex
+        /// signal of half the size, so this is roughly twice as fast as transforming a complex signal.
+        /// </summary>
+        ///
+        /// <param name="signal"> A pointer to the `Size()` entries of the signal to transform. </param>
+        /// <param name="output"> A pointer to the `Size()/2 + 1` entries of the output. The remaining
+        /// entries of the transform are the complex conjugates of these, in reverse order. </param>
+        void RealTransform(const ValueType* signal, std::complex<ValueType>* output) const;
+
+        /// <summary> Performs the inverse of `RealTransform`, reconstructing a real-valued signal. </summary>
+        ///
+        /// <param name="input"> A pointer to the `Size()/2 + 1` entries of the transformed signal. </param>
+        /// <param name="signal"> A pointer to the `Size()` entries of the reconstructed signal. </param>
+        void InverseRealTransform(const std::complex<ValueType>* input, ValueType* signal) const;
+
+        /// <summary> Gets the twiddle factors used by the transform: entry k is e^(2*pi*i*k/N). </summary>
+        ///
+        /// <returns> The twiddle factors. </returns>
+        const std::vector<std::complex<ValueType>>& GetTwiddleFactors() const { return _twiddles; }
+
+        /// <summary> Gets the bit-reversal permutation used to reorder the input to the transform. </summary>
+        ///
+        /// <returns> A vector where entry k is the index k with its bits reversed. </returns>
+        const std::vector<size_t>& GetBitReversalPermutation() const { return _bitReversal; }
+
+    private:
+        void TransformInPlace(std::complex<ValueType>* signal, size_t size, bool inverse) const;
+        std::complex<ValueType> GetTwiddleFactor(size_t index, bool inverse) const;
+
+        size_t _size = 0;
+        std::vector<std::complex<ValueType>> _twiddles;
+        std::vector<size_t> _bitReversal;
+    };
+
+    /// <summary> Gets a shared plan for transforms of the given size, creating it the first time it's requested. </summary>
+    ///
+    /// <param name="size"> The size of the transform. Must be a power of 2. </param>
+    ///
+    /// <returns> A pointer to the shared plan. </returns>
+    template <typename ValueType>
+    std::shared_ptr<const FFTPlan<ValueType>> GetFFTPlan(size_t size);
+} // namespace dsp
+} // namespace ell
+
+#pragma region implementation
+
+namespace ell
+{
+namespace dsp
+{
+    template <typename ValueType>
+    FFTPlan<ValueType>::FFTPlan(size_t size) :
+        _size(size)
+    {
+        if (size == 0 || (size & (size - 1)) != 0)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "FFT size must be a power of 2");
+        }
+
+        size_t numBits = 0;
+        while ((size_t{ 1 } << numBits) < size)
+        {
+            ++numBits;
+        }
+
+        // A pass of size L uses the twiddle factors e^(2*pi*i*k/L) for k < 3L/4, which are every (N/L)th entry of this table
+        const auto pi = math::Constants<ValueType>::pi;
+        _twiddles.resize(size);
+        for (size_t k = 0; k < size; ++k)
+        {
+            _twiddles[k] = std::polar(ValueType{ 1 }, 2 * pi * static_cast<ValueType>(k) / static_cast<ValueType>(size));
+        }
+
+        _bitReversal.resize(size);
+        for (size_t k = 0; k < size; ++k)
+        {
+            size_t reversed = 0;
+            for (size_t bit = 0; bit < numBits; ++bit)
+            {
+                reversed |= ((k >> bit) & 1) << (numBits - 1 - bit);
+            }
+            _bitReversal[k] = reversed;
+        }
+    }
+
+    template <typename ValueType>
+    void FFTPlan<ValueType>::Transform(std::vector<std::complex<ValueType>>& signal, bool inverse) const
+    {
+        if (signal.size() != _size)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "Signal size doesn't match the FFT plan size");
+        }
+        Transform(signal.data(), inverse);
+    }
+
+    template <typename ValueType>
+    void FFTPlan<ValueType>::Transform(std::complex<ValueType>* signal, bool inverse) const
+    {
+        TransformInPlace(signal, _size, inverse);
+        if (inverse)
+        {
+            const auto scale = ValueType{ 1 } / static_cast<ValueType>(_size);
+            for (size_t index = 0; index < _size; ++index)
+            {
+                signal[index] *= scale;
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void FFTPlan<ValueType>::RealTransform(const ValueType* signal, std::complex<ValueType>* output) const
+    {
+        if (_size == 1)
+        {
+            output[0] = signal[0];
+            return;
+        }
+
+        // Pack the even entries into the real part and the odd entries into the imaginary part, and transform
+        // that with a half-size complex FFT: Z[k] = E[k] + iO[k], where E and O are the transforms of the evens and odds
+        const auto halfN = _size / 2;
+        for (size_t index = 0; index < halfN; ++index)
+        {
+            output[index] = { signal[2 * index], signal[2 * index + 1] };
+        }
+        TransformInPlace(output, halfN, false);
+
+        // Untangle the two transforms using their conjugate symmetry, and combine them with the final radix-2 pass:
+        //   E[k] = (Z[k] + conj(Z[N/2-k])) / 2
+        //   O[k] = (Z[k] - conj(Z[N/2-k])) / 2i
+        //   X[k] = E[k] + w^k O[k]
+        // Entries k and N/2-k are computed together, so this can be done in place.
+        const auto z0 = output[0];
+        output[0] = { z0.real() + z0.imag(), 0 };
+        output[halfN] = { z0.real() - z0.imag(), 0 };
+        const std::complex<ValueType> minusHalfI(0, ValueType{ -0.5 });
+        for (size_t k = 1; k <= halfN / 2; ++k)
+        {
+            const auto j = halfN - k;
+            const auto zk = output[k];
+            const auto zj = output[j];
+            const auto evens = ValueType{ 0.5 } * (zk + std::conj(zj));
+            const auto odds = minusHalfI * (zk - std::conj(zj));
+            output[k] = evens + _twiddles[k] * odds;
+            output[j] = std::conj(evens) + _twiddles[j] * std::conj(odds);
+        }
+    }
+
+    template <typename ValueType>
+    void FFTPlan<ValueType>::InverseRealTransform(const std::complex<ValueType>* input, ValueType* signal) const
+    {
+        if (_size == 1)
+        {
+            signal[0] = input[0].real();
+            return;
+        }
+
+        // Reverse the steps of `RealTransform`: recover E and O from X, and inverse-transform Z = E + iO
+        const auto halfN = _size / 2;
+        std::vector<std::complex<ValueType>> packed(halfN);
+        const std::complex<ValueType> i(0, 1);
+        for (size_t k = 0; k < halfN; ++k)
+        {
+            const auto xk = input[k];
+            const auto xj = std::conj(input[halfN - k]);
+            const auto evens = ValueType{ 0.5 } * (xk + xj);
+            const auto odds = ValueType{ 0.5 } * (xk - xj) * std::conj(_twiddles[k]);
+            packed[k] = evens + i * odds;
+        }
+
+        TransformInPlace(packed.data(), halfN, true);
+        const auto scale = ValueType{ 1 } / static_cast<ValueType>(halfN);
+        for (size_t index = 0; index < halfN; ++index)
+        {
+            signal[2 * index] = packed[index].real() * scale;
+            signal[2 * index + 1] = packed[index].imag() * scale;
+        }
+    }
+
+    template <typename ValueType>
+    std::complex<ValueType> FFTPlan<ValueType>::GetTwiddleFactor(size_t index, bool inverse) const
+    {
+        return inverse ? std::conj(_twiddles[index]) : _twiddles[index];
+    }
+
+    template <typename ValueType>
+    void FFTPlan<ValueType>::TransformInPlace(std::complex<ValueType>* signal, size_t size, bool inverse) const
+    {
+        // `size` is either the plan's size, or half of it (for the packed real-valued transform). Both the
+        // bit-reversal permutation and the twiddle factors for the smaller size are a subset of the plan's.
+        size_t sizeShift = 0;
+        while ((size << sizeShift) < _size)
+        {
+            ++sizeShift;
+        }
+
+        for (size_t index = 0; index < size; ++index)
+        {
+            auto reversed = _bitReversal[index] >> sizeShift;
+            if (index < reversed)
+            {
+                std::swap(signal[index], signal[reversed]);
+            }
+        }
+
+        // If the number of passes is odd, start with a radix-2 pass, so the rest can be done with radix-4 passes
+        size_t passSize = 1;
+        size_t numBits = 0;
+        while ((size_t{ 1 } << numBits) < size)
+        {
+            ++numBits;
+        }
+        if (numBits % 2 == 1)
+        {
+            for (size_t index = 0; index < size; index += 2)
+            {
+                auto a = signal[index];
+                auto b = signal[index + 1];
+                signal[index] = a + b;
+                signal[index + 1] = a - b;
+            }
+            passSize = 2;
+        }
+
+        // Each radix-4 pass combines 4 transforms of size `passSize` into one of size 4 * `passSize`. After the
+        // bit-reversal permutation, the 4 inputs to a pass hold the entries whose indices are 0, 2, 1, and 3 (mod 4).
+        const std::complex<ValueType> quarterTurn(0, inverse ? -1 : 1); // w^(L/4) == +/- i
+        for (; passSize < size; passSize *= 4)
+        {
+            const auto nextPassSize = 4 * passSize;
+            const auto twiddleStride = _size / nextPassSize;
+            for (size_t begin = 0; begin < size; begin += nextPassSize)
+            {
+                auto x0 = signal + begin;
+                auto x2 = x0 + passSize;
+                auto x1 = x2 + passSize;
+                auto x3 = x1 + passSize;
+                for (size_t k = 0; k < passSize; ++k)
+                {
+                    const auto w1 = GetTwiddleFactor(k * twiddleStride, inverse);
+                    const auto w2 = GetTwiddleFactor(2 * k * twiddleStride, inverse);
+                    const auto w3 = GetTwiddleFactor(3 * k * twiddleStride, inverse);
+
+                    const auto a0 = x0[k];
+                    const auto a1 = w1 * x1[k];
+                    const auto a2 = w2 * x2[k];
+                    const auto a3 = w3 * x3[k];
+
+                    const auto sum02 = a0 + a2;
+                    const auto diff02 = a0 - a2;
+                    const auto sum13 = a1 + a3;
+                    const auto diff13 = quarterTurn * (a1 - a3);
+
+                    x0[k] = sum02 + sum13;
+                    x2[k] = diff02 + diff13;
+                    x1[k] = sum02 - sum13;
+                    x3[k] = diff02 - diff13;
+                }
+            }
+        }
+    }
+
+    template <typename ValueType>
+    std::shared_ptr<const FFTPlan<ValueType>> GetFFTPlan(size_t size)
+    {
+        static std::mutex plansMutex;
+        static std::map<size_t, std::shared_ptr<const FFTPlan<ValueType>>> plans;
+
+        std::lock_guard<std::mutex> lock(plansMutex);
+        auto& plan = plans[size];
+        if (!plan)
+        {
+            plan = std::make_shared<const FFTPlan<ValueType>>(size);
+        }
+        return plan;
+    }
+} // namespace dsp
+} // namespace ell
+
+#pragma endregion implementation
@@ -10,6 +10,7 @@
 #include "DSPTestData.h"
 
 #include <dsp/include/FFT.h>
+#include <dsp/include/FFTPlan.h>
 
 #include <math/include/Vector.h>
 #include <math/include/VectorOperations.h>
@@ -83,6 +84,59 @@ void TestFFT(size_t N)
     }
 }
 
+template <typename ValueType>
+void TestFFTPlan(size_t N)
+{
+    const ValueType epsilon = static_cast<ValueType>(1e-5);
+    auto randomEngine = utilities::GetRandomEngine();
+    std::uniform_real_distribution<ValueType> uniform(-1, 1);
+    std::vector<ValueType> signal(N);
+    std::vector<std::complex<ValueType>> complexSignal(N);
+    for (size_t index = 0; index < N; ++index)
+    {
+        signal[index] = uniform(randomEngine);
+        complexSignal[index] = { signal[index], uniform(randomEngine) };
+    }
+
+    //
+    // Plans are shared between callers
+    //
+    auto plan = GetFFTPlan<ValueType>(N);
+    testing::ProcessTest("Testing FFT plan size", plan->Size() == N);
+    testing::ProcessTest("Testing FFT plan reuse", plan == GetFFTPlan<ValueType>(N));
+
+    //
+    // Inverse of the forward transform of a complex signal
+    //
+    auto transformed = complexSignal;
+    plan->Transform(transformed);
+    plan->Transform(transformed, true);
+    bool ok = true;
+    for (size_t index = 0; index < N; ++index)
+    {
+        ok = ok && testing::IsEqual(std::abs(transformed[index] - complexSignal[index]), static_cast<ValueType>(0), epsilon);
+    }
+    testing::ProcessTest("Testing inverse FFT of complex signal", ok);
+
+    //
+    // Real-valued transform agrees with the complex one, and inverts
+    //
+    std::vector<std::complex<ValueType>> complexTransform(signal.begin(), signal.end());
+    plan->Transform(complexTransform);
+    std::vector<std::complex<ValueType>> realTransform(N / 2 + 1);
+    plan->RealTransform(signal.data(), realTransform.data());
+    ok = true;
+    for (size_t index = 0; index < realTransform.size(); ++index)
+    {
+        ok = ok && testing::IsEqual(std::abs(realTransform[index] - complexTransform[index]), static_cast<ValueType>(0), epsilon);
+    }
+    testing::ProcessTest("Testing real-valued FFT plan vs complex FFT", ok);
+
+    std::vector<ValueType> reconstructed(N);
+    plan->InverseRealTransform(realTransform.data(), reconstructed.data());
+    testing::ProcessTest("Testing inverse real-valued FFT", testing::IsEqual(reconstructed, signal, epsilon));
+}
+
 template <typename ValueType>
 void VerifyFFT(std::vector<ValueType> input, const std::vector<ValueType>& reference)
 {
@@ -110,5 +164,8 @@ void VerifyFFT()
 template void TestFFT<float>(size_t);
 template void TestFFT<double>(size_t);
 
+template void TestFFTPlan<float>(size_t);
+template void TestFFTPlan<double>(size_t);
+
 template void VerifyFFT<float>();
 template void VerifyFFT<double>();
@@ -98,6 +98,10 @@ void DspTest(const std::string& path)
     // FFT
     TestFFT<float>(16);
     TestFFT<double>(16);
+    TestFFTPlan<float>(2);
+    TestFFTPlan<float>(64);
+    TestFFTPlan<double>(128);
+    TestFFTPlan<double>(512);
     VerifyFFT<float>();
     VerifyFFT<double>();
 
@@ -40,16 +40,9 @@ namespace emittable_functions
 
     Scalar Sigmoid(Scalar x)
     {
-        Scalar zero = Cast(0, x.GetType());
-        Scalar one = Cast(1, x.GetType());
-        Scalar result;
-        If(x > zero, [&] {
-            result = one / (Exp(-x) + one);
-        }).Else([&] {
-            auto expInput = Exp(x);
-            result = expInput / (expInput + one);
-        });
-        return result;
+        // sigmoid(x) = (1 + tanh(x / 2)) / 2, which needs no branch and doesn't overflow
+        Scalar half = Cast(0.5, x.GetType());
+        return half + half * Tanh(half * x);
     }
 
     Scalar HardSigmoid(Scalar x)
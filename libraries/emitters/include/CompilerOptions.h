@@ -28,6 +28,17 @@ namespace emitters
 
     std::string ToString(BlasType t);
 
+    /// <summary> Accuracy of the polynomial approximations of exp, log, tanh, and sigmoid emitted when fast math is enabled. </summary>
+    enum class FastMathAccuracy
+    {
+        /// <summary> Within a few ULPs of the correctly-rounded result. </summary>
+        ulpBounded = 0,
+        /// <summary> Shorter polynomials with a relative error below 1e-4. </summary>
+        fast
+    };
+
+    std::string ToString(FastMathAccuracy accuracy);
+
     /// <summary> Standard compiler switches. </summary>
     struct CompilerOptions
     {
@@ -61,9 +72,15 @@ namespace emitters
         /// <summary> Maximum num of parallel threads. </summary>
         int maxThreads = 4;
 
-        /// <summary> Allow emitting more efficient code that isn't necessarily IEEE-754 compatible. </summary>
+        /// <summary> Schedule thread pool tasks with per-thread work-stealing ranges instead of a single locked queue (if thread pool enabled). </summary>
+        bool useWorkStealing = false;
+
+        /// <summary> Allow emitting more efficient code that isn't necessarily IEEE-754 compatible, including polynomial approximations of exp, log, tanh, and sigmoid. </summary>
         bool useFastMath = true;
 
+        /// <summary> The accuracy of the math function approximations used if `useFastMath` is set. </summary>
+        FastMathAccuracy fastMathAccuracy = FastMathAccuracy::ulpBounded;
+
         /// <summary> Allow printing of diagnostic messages from the compiled model. </summary>
         bool includeDiagnosticInfo = false;
 
@@ -108,5 +125,8 @@ namespace utilities
 {
     template <>
     emitters::BlasType FromString<emitters::BlasType>(const std::string& s);
+
+    template <>
+    emitters::FastMathAccuracy FromString<emitters::FastMathAccuracy>(const std::string& s);
 }
 } // namespace ell
@@ -13,9 +13,11 @@
 #include <utilities/include/Exception.h>
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
 #include <llvm/IR/Module.h>
 
 #include <functional>
+#include <memory>
 #include <type_traits>
 
 namespace ell
@@ -43,7 +45,9 @@ namespace emitters
         ///
         /// <param name="pModule"> The module. </param>
         /// <param name="verify"> Indicates if the execution engine should run a verification pass before running the code. </param>
-        IRExecutionEngine(std::unique_ptr<llvm::Module> pModule, bool verify = false, llvm::CodeGenOpt::Level optLevel = llvm::CodeGenOpt::Level::Default);
+        /// <param name="optLevel"> The code generator's optimization level. </param>
+        /// <param name="objectCache"> Optional cache of previously-generated machine code. If it has code for a module, that code is loaded instead of compiling the module. </param>
+        IRExecutionEngine(std::unique_ptr<llvm::Module> pModule, bool verify = false, llvm::CodeGenOpt::Level optLevel = llvm::CodeGenOpt::Level::Default, std::shared_ptr<llvm::ObjectCache> objectCache = nullptr);
 
         /// <summary> Destructor </summary>
         ~IRExecutionEngine();
@@ -130,6 +134,7 @@ namespace emitters
         void PerformInitialization();
         void PerformFinalization();
 
+        std::shared_ptr<llvm::ObjectCache> _objectCache; // must outlive the engine
         std::unique_ptr<llvm::EngineBuilder> _pBuilder;
         std::unique_ptr<llvm::ExecutionEngine> _pEngine;
     };
@@ -1116,6 +1116,19 @@ namespace emitters
         /// <param name="body"> A function that emits the body of the loop. </param>
         void For(const std::string& tag, LLVMValue beginValue, LLVMValue endValue, LLVMValue increment, ForLoopBodyFunction body);
 
+        /// <summary>
+        /// Emits a for loop counting from a begin value up to (but not including) an end value with a given increment, which
+        /// the optimizer is required to vectorize with the given number of iterations per vector, regardless of its cost model.
+        /// </summary>
+        ///
+        /// <param name="tag"> Tag to use when naming the basic block regions </param>
+        /// <param name="beginValue"> The starting value of the loop iterator. </param>
+        /// <param name="endValue"> The ending value of the loop iterator. </param>
+        /// <param name="increment"> The increment for the iterator. </param>
+        /// <param name="vectorWidth"> The number of iterations per vector. </param>
+        /// <param name="body"> A function that emits the body of the loop. </param>
+        void VectorizedFor(const std::string& tag, LLVMValue beginValue, LLVMValue endValue, LLVMValue increment, int vectorWidth, ForLoopBodyFunction body);
+
         //
         // Extended for loops
         //
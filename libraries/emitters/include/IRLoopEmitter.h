@@ -28,7 +28,7 @@ namespace emitters
 
     protected:
         IRLoopEmitter(IRFunctionEmitter& functionEmitter);
-        void AddLoopMetadata(llvm::BranchInst* branch, bool unroll, bool parallel);
+        void AddLoopMetadata(llvm::BranchInst* branch, bool unroll, bool parallel, int vectorWidth = 0);
 
         IRFunctionEmitter& _functionEmitter; // Loop written into this function
     };
@@ -43,6 +43,13 @@ namespace emitters
         /// <param name="tag"> Optional, tag to use when naming the basic block regions </param>
         IRForLoopEmitter(IRFunctionEmitter& functionEmitter, const std::string& tag = "");
 
+        /// <summary> Constructs an instance of IRForLoopEmitter for a loop that must be vectorized. </summary>
+        ///
+        /// <param name="functionEmitter"> The function emitter. </param>
+        /// <param name="tag"> Tag to use when naming the basic block regions </param>
+        /// <param name="vectorWidth"> The number of iterations the optimizer must put in each vector. </param>
+        IRForLoopEmitter(IRFunctionEmitter& functionEmitter, const std::string& tag, int vectorWidth);
+
         /// <summary> Gets the block containing the body of the for loop. </summary>
         ///
         /// <returns> Pointer to an llvm::BasicBlock that represents the body of the for loop. </returns>
@@ -107,6 +114,7 @@ namespace emitters
         llvm::BasicBlock* _pAfterBlock = nullptr; // When the loop is done, we branch to this block
         LLVMValue _pIterationVariable = nullptr;
         std::string _tag;
+        int _vectorWidth = 0; // 0 lets the optimizer choose the vector width
     };
 
     /// <summary> Class that simplifies while loop creation. Used internally by IRFunctionEmitter. </summary>
@@ -24,6 +24,7 @@ namespace emitters
     IRLocalScalar Sqrt(IRLocalScalar a);
     IRLocalScalar Exp(IRLocalScalar a);
     IRLocalScalar Log(IRLocalScalar a);
+    IRLocalScalar Sigmoid(IRLocalScalar a);
     IRLocalScalar Sin(IRLocalScalar a);
     IRLocalScalar Cos(IRLocalScalar a);
 
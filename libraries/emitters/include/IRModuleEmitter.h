@@ -317,6 +317,18 @@ namespace emitters
         template <typename ValueType>
         llvm::GlobalVariable* GlobalArray(const std::string& name, const std::vector<ValueType>& value, bool isThreadLocal = false);
 
+        /// <summary>
+        /// Replaces already-emitted global vector variables with slices of a single, zero-initialized byte array (an "arena").
+        /// Existing references to the variables are rewritten to point into the arena.
+        /// </summary>
+        ///
+        /// <param name="name"> The name of the arena variable. </param>
+        /// <param name="size"> The size of the arena, in bytes. </param>
+        /// <param name="placements"> The variables to move into the arena, each paired with its byte offset in the arena. </param>
+        ///
+        /// <returns> Pointer to the llvm::GlobalVariable that represents the arena. </returns>
+        llvm::GlobalVariable* PlaceGlobalsInArena(const std::string& name, size_t size, const std::vector<std::pair<Variable*, size_t>>& placements);
+
         //
         // Functions
         //
@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRObjectCache.h (emitters)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <memory>
+#include <string>
+
+namespace ell
+{
+namespace emitters
+{
+    /// <summary>
+    /// Writes a cache file: a header with the size and MD5 hash of the contents, followed by the contents. The file is
+    /// written under a unique temporary name and renamed into place, so processes sharing a cache directory never see
+    /// each other's partial files.
+    /// </summary>
+    ///
+    /// <param name="filePath"> The path of the cache file. </param>
+    /// <param name="contents"> The data to cache. </param>
+    ///
+    /// <returns> true if the file was written. </returns>
+    bool WriteCacheFile(const std::string& filePath, llvm::StringRef contents);
+
+    /// <summary> Reads a cache file written by `WriteCacheFile`. </summary>
+    ///
+    /// <param name="filePath"> The path of the cache file. </param>
+    ///
+    /// <returns> The cached data, or null if the file is missing, truncated, or doesn't match its hash. </returns>
+    std::unique_ptr<llvm::MemoryBuffer> ReadCacheFile(const std::string& filePath);
+
+    /// <summary>
+    /// An object cache for the execution engine that keeps the machine code generated for a module in a file, so a
+    /// later process that JITs the same module can load it instead of running the LLVM code generator again. The caller
+    /// is responsible for choosing a key that identifies the module's contents and the target it's compiled for.
+    /// </summary>
+    class IRObjectCache : public llvm::ObjectCache
+    {
+    public:
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="directory"> The directory to keep the object file in. It's created if it doesn't exist. </param>
+        /// <param name="key"> The key that identifies the module being compiled. Used as the object file's base name. </param>
+        IRObjectCache(const std::string& directory, const std::string& key);
+
+        /// <summary> Returns the name of the file the object code is kept in. </summary>
+        const std::string& GetObjectFilePath() const { return _objectFilePath; }
+
+        /// <summary> Indicates if there is cached object code for the key. </summary>
+        bool HasObject() const;
+
+        /// <summary> Indicates if the execution engine got its object code from the cache file. </summary>
+        bool WasObjectLoaded() const { return _wasObjectLoaded; }
+
+        /// <summary> Indicates if the execution engine had to generate the object code. </summary>
+        bool WasObjectCompiled() const { return _wasObjectCompiled; }
+
+        /// <summary> Called by the execution engine after it generates code for a module. Writes the object code to the cache file. </summary>
+        void notifyObjectCompiled(const llvm::Module* module, llvm::MemoryBufferRef object) override;
+
+        /// <summary> Called by the execution engine before it generates code for a module. Returns the cached object code, or null if there's no valid cache file. </summary>
+        std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override;
+
+    private:
+        std::string _objectFilePath;
+        bool _wasObjectLoaded = false;
+        bool _wasObjectCompiled = false;
+    };
+} // namespace emitters
+} // namespace ell
@@ -88,6 +88,12 @@ namespace emitters
         template <typename ValueType>
         LLVMFunction GetTanhFunction();
 
+        /// <summary> Get the logistic sigmoid function, 1 / (1 + exp(-x)) </summary>
+        ///
+        /// <returns> An LLVM function pointer to the function. </returns>
+        template <typename ValueType>
+        LLVMFunction GetSigmoidFunction();
+
         /// <summary> Get the fma function </summary>
         ///
         /// <returns> An LLVM function pointer to the function. </returns>
@@ -103,6 +109,7 @@ namespace emitters
         LLVMFunction GetLog10Function(VariableType argType);
         LLVMFunction GetLog2Function(VariableType argType);
         LLVMFunction GetTanhFunction(VariableType argType);
+        LLVMFunction GetSigmoidFunction(VariableType argType);
         LLVMFunction GetSinFunction(VariableType argType);
         LLVMFunction GetCosFunction(VariableType argType);
         LLVMFunction GetRoundFunction(VariableType argType);
@@ -120,6 +127,7 @@ namespace emitters
         LLVMFunction GetLog10Function(LLVMType argType);
         LLVMFunction GetLog2Function(LLVMType argType);
         LLVMFunction GetTanhFunction(LLVMType argType);
+        LLVMFunction GetSigmoidFunction(LLVMType argType);
         LLVMFunction GetSinFunction(LLVMType argType);
         LLVMFunction GetCosFunction(LLVMType argType);
         LLVMFunction GetRoundFunction(LLVMType argType);
@@ -185,6 +193,7 @@ namespace emitters
         LLVMType GetIntType(); // returns LLVM type for native `int`
 
         std::string GetNamespacePrefix() const;
+        bool UseApproximateMathFunctions(LLVMType argType) const;
 
         //
         // Getting pointers to functions
@@ -259,6 +268,12 @@ namespace emitters
         return GetTanhFunction(GetVariableType<ValueType>());
     }
 
+    template <typename ValueType>
+    LLVMFunction IRRuntime::GetSigmoidFunction()
+    {
+        return GetSigmoidFunction(GetVariableType<ValueType>());
+    }
+
     template <typename ValueType>
     LLVMFunction IRRuntime::GetSinFunction()
     {
@@ -29,6 +29,12 @@ namespace emitters
     //
     // IRThreadPool: Simple thread pool class that schedules tasks in blocks, and associated classes:
     //
+    // By default, tasks are handed out from a single queue protected by a mutex. If the `useWorkStealing`
+    // compiler option is set, each worker (and the client thread waiting on the tasks) instead gets its own
+    // contiguous range of task indices, claims tasks from it with atomic compare-and-swap, and steals half of
+    // another worker's remaining range when its own runs out. Idle workers spin for a while before parking on
+    // a condition variable, so the mutex is only touched when threads go to sleep or wake up.
+    //
     // IRThreadPoolTask
     // IRThreadPoolTaskArray
     // IRThreadPoolTaskQueue
@@ -185,6 +191,19 @@ namespace emitters
         void UnlockQueueMutex(IRFunctionEmitter& function);
         void ShutDown(IRFunctionEmitter& function);
 
+        // Work-stealing scheduler
+        bool UsesWorkStealing() const { return _useWorkStealing; }
+        void StartWorkStealingTasks(IRFunctionEmitter& function, LLVMFunction taskFunction, const std::vector<std::vector<LLVMValue>>& arguments);
+        void WaitAllWorkStealing(IRFunctionEmitter& function);
+        void WaitForNewTasks(IRFunctionEmitter& function, LLVMValue lastGenerationVar);
+        void RunAvailableTasks(IRFunctionEmitter& function, LLVMValue slotIndex);
+        LLVMFunction GetRunTasksFunction(IRModuleEmitter& module);
+        LLVMValue PopOwnTask(IRFunctionEmitter& function, LLVMValue slotIndex);
+        LLVMValue StealTasks(IRFunctionEmitter& function, LLVMValue slotIndex);
+        void RunTask(IRFunctionEmitter& function, LLVMValue taskIndex);
+        LLVMValue GetWorkerRangePointer(IRFunctionEmitter& function, LLVMValue slotIndex);
+        LLVMValue GetFieldPointer(IRFunctionEmitter& function, int field) const;
+
         enum class Fields
         {
             queueMutex = 0,
@@ -192,10 +211,17 @@ namespace emitters
             workFinishedCondVar,
             unscheduledCount,
             unfinishedCount,
-            shutdownFlag
+            shutdownFlag,
+            generation,
+            numSleepingWorkers
         };
         LLVMValue _queueData = nullptr; // a struct with the above fields
         IRThreadPoolTaskArray _tasks;
+
+        bool _useWorkStealing = false;
+        int _numSlots = 0; // one per worker thread, plus one for the client thread
+        llvm::GlobalVariable* _workerRanges = nullptr; // packed [begin, end) task ranges, one cache line per slot
+        LLVMFunction _runTasksFunction = nullptr;
     };
 
     //
@@ -229,6 +255,7 @@ namespace emitters
         void AddGlobalInitializer();
         void AddGlobalFinalizer();
         LLVMFunction GetWorkerThreadFunction();
+        LLVMFunction GetWorkStealingWorkerThreadFunction();
 
         IRModuleEmitter& _module;
         size_t _maxThreads = 0;
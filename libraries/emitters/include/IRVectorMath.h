@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRVectorMath.h (emitters)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CompilerOptions.h"
+#include "LLVMUtilities.h"
+
+namespace ell
+{
+namespace emitters
+{
+    class IRModuleEmitter;
+
+    //
+    // Polynomial approximations of transcendental functions, emitted into the module as small internal functions that
+    // are always inlined. Unlike the LLVM intrinsics, which lower to one libm call per element, they are straight-line
+    // arithmetic, so loops that use them can be vectorized. They work on `float` and on vectors of `float`.
+    //
+    // Accuracy, relative to the exact result:
+    //   ulpBounded: exp, log, and tanh are within 2 ULPs; sigmoid is within 3 ULPs.
+    //   fast:       relative error below 1e-4 for all four, including near 0 for tanh and near 1 for log.
+    //
+    // Special inputs: exp returns infinity above log(FLT_MAX) and for +inf, and 0 below log(2^-150) and for -inf;
+    // its results between those are normal or subnormal floats. log returns -infinity for +-0, NaN for negative
+    // inputs, and +inf for +inf, and handles subnormal inputs. tanh returns +-1 for +-inf. All of them return NaN
+    // for NaN inputs. These cases are detected from the bits of the input, so they hold under fast math.
+    //
+
+    /// <summary> Indicates if there are approximations for values of the given type. </summary>
+    ///
+    /// <param name="type"> The argument type: a scalar or vector type. </param>
+    ///
+    /// <returns> true if the type is `float` or a vector of `float`. </returns>
+    bool CanApproximateMathFunctions(LLVMType type);
+
+    /// <summary> Gets the approximation of exp for the given argument type, emitting it if necessary. </summary>
+    ///
+    /// <param name="module"> The module to emit the function into. </param>
+    /// <param name="type"> The argument type: `float` or a vector of `float`. </param>
+    /// <param name="accuracy"> The accuracy of the approximation. </param>
+    ///
+    /// <returns> An LLVM function pointer to the function. </returns>
+    LLVMFunction GetApproximateExpFunction(IRModuleEmitter& module, LLVMType type, FastMathAccuracy accuracy);
+
+    /// <summary> Gets the approximation of the natural log for the given argument type, emitting it if necessary. </summary>
+    ///
+    /// <param name="module"> The module to emit the function into. </param>
+    /// <param name="type"> The argument type: `float` or a vector of `float`. </param>
+    /// <param name="accuracy"> The accuracy of the approximation. </param>
+    ///
+    /// <returns> An LLVM function pointer to the function. </returns>
+    LLVMFunction GetApproximateLogFunction(IRModuleEmitter& module, LLVMType type, FastMathAccuracy accuracy);
+
+    /// <summary> Gets the approximation of tanh for the given argument type, emitting it if necessary. </summary>
+    ///
+    /// <param name="module"> The module to emit the function into. </param>
+    /// <param name="type"> The argument type: `float` or a vector of `float`. </param>
+    /// <param name="accuracy"> The accuracy of the approximation. </param>
+    ///
+    /// <returns> An LLVM function pointer to the function. </returns>
+    LLVMFunction GetApproximateTanhFunction(IRModuleEmitter& module, LLVMType type, FastMathAccuracy accuracy);
+} // namespace emitters
+} // namespace ell
@@ -37,6 +37,19 @@ namespace emitters
         }
     }
 
+    std::string ToString(FastMathAccuracy accuracy)
+    {
+        switch (accuracy)
+        {
+        case FastMathAccuracy::ulpBounded:
+            return "ulpBounded";
+        case FastMathAccuracy::fast:
+            return "fast";
+        default:
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument);
+        }
+    }
+
     /// <summary> Constructor from a property bag </summary>
     CompilerOptions::CompilerOptions(const utilities::PropertyBag& properties)
     {
@@ -70,7 +83,9 @@ namespace emitters
         parallelize = properties.GetOrParseEntry<bool>("parallelize", parallelize);
         useThreadPool = properties.GetOrParseEntry<bool>("useThreadPool", useThreadPool);
         maxThreads = properties.GetOrParseEntry<int>("maxThreads", maxThreads);
+        useWorkStealing = properties.GetOrParseEntry<bool>("useWorkStealing", useWorkStealing);
         useFastMath = properties.GetOrParseEntry<bool>("useFastMath", useFastMath);
+        fastMathAccuracy = properties.GetOrParseEntry<FastMathAccuracy>("fastMathAccuracy", fastMathAccuracy);
         debug = properties.GetOrParseEntry<bool>("debug", debug);
         globalValueAlignment = properties.GetOrParseEntry<int>("globalValueAlignment", globalValueAlignment);
         skip_ellcode = properties.GetOrParseEntry<bool>("skip_ellcode", skip_ellcode);
@@ -99,5 +114,19 @@ namespace utilities
         
         return it->second;
     }
+
+    template <>
+    emitters::FastMathAccuracy FromString<emitters::FastMathAccuracy>(const std::string& s)
+    {
+        static std::map<std::string, emitters::FastMathAccuracy> nameMap = { { "ulpBounded", emitters::FastMathAccuracy::ulpBounded },
+                                                                             { "fast", emitters::FastMathAccuracy::fast } };
+        auto it = nameMap.find(s);
+        if (it == nameMap.end())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "Unknown FastMathAccuracy");
+        }
+
+        return it->second;
+    }
 } // namespace utilities
 } // namespace ell
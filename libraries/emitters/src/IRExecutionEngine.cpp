@@ -45,7 +45,8 @@ namespace emitters
     {
     }
 
-    IRExecutionEngine::IRExecutionEngine(std::unique_ptr<llvm::Module> pModule, bool verify, llvm::CodeGenOpt::Level optLevel)
+    IRExecutionEngine::IRExecutionEngine(std::unique_ptr<llvm::Module> pModule, bool verify, llvm::CodeGenOpt::Level optLevel, std::shared_ptr<llvm::ObjectCache> objectCache) :
+        _objectCache(std::move(objectCache))
     {
         auto debugPrintFunction = pModule->getFunction("DebugPrint");
 
@@ -157,6 +158,12 @@ namespace emitters
         {
             auto pEngine = _pBuilder->create();
             _pEngine.reset(pEngine);
+
+            // The cache has to be in place before any code is generated, including for static constructors
+            if (_objectCache)
+            {
+                _pEngine->setObjectCache(_objectCache.get());
+            }
             PerformInitialization();
         }
     }
@@ -1137,6 +1137,19 @@ namespace emitters
         loop.End();
     }
 
+    void IRFunctionEmitter::VectorizedFor(const std::string& tag, LLVMValue beginValue, LLVMValue endValue, LLVMValue increment, int vectorWidth, std::function<void(IRFunctionEmitter&, IRLocalScalar)> body)
+    {
+        if (vectorWidth < 1)
+        {
+            throw EmitterException(EmitterError::badFunctionArguments, "Vector width must be positive");
+        }
+
+        auto loop = IRForLoopEmitter(*this, tag, vectorWidth);
+        loop.Begin(beginValue, endValue, increment);
+        body(*this, LocalScalar(loop.LoadIterationVariable()));
+        loop.End();
+    }
+
     //
     // Extended for loops
     //
@@ -40,6 +40,13 @@ namespace emitters
             return { llvm::MDString::get(context, "llvm.loop.vectorize.followup_vectorized"), llvm::MDNode::get(context, GenerateUnrollMetadata(context)) };
         }
 
+        std::array<llvm::Metadata*, 2> GenerateIntegerMetadata(llvm::LLVMContext& context, const std::string& name, int value)
+        {
+            return { llvm::MDString::get(context, name),
+                     llvm::ConstantAsMetadata::get(llvm::ConstantInt::get(
+                         llvm::Type::getInt32Ty(context), value)) };
+        }
+
         std::array<llvm::Metadata*, 1> GenerateDisableNonforcedMetadata(llvm::LLVMContext& context)
         {
             return { llvm::MDString::get(context, "llvm.loop.disable_nonforced") };
@@ -49,7 +56,7 @@ namespace emitters
     IRLoopEmitter::IRLoopEmitter(IRFunctionEmitter& functionEmitter) :
         _functionEmitter(functionEmitter) {}
 
-    void IRLoopEmitter::AddLoopMetadata(llvm::BranchInst* branch, bool unroll, bool vectorize)
+    void IRLoopEmitter::AddLoopMetadata(llvm::BranchInst* branch, bool unroll, bool vectorize, int vectorWidth)
     {
         // Add metadata
         auto& context = _functionEmitter.GetEmitter().GetContext();
@@ -62,6 +69,12 @@ namespace emitters
         if (vectorize)
         {
             metadataElements.push_back(llvm::MDNode::get(context, GenerateVectorizeMetadata(context)));
+            if (vectorWidth > 0)
+            {
+                // A fixed width, without interleaving, makes each vector hold exactly `vectorWidth` consecutive iterations
+                metadataElements.push_back(llvm::MDNode::get(context, GenerateIntegerMetadata(context, "llvm.loop.vectorize.width", vectorWidth)));
+                metadataElements.push_back(llvm::MDNode::get(context, GenerateIntegerMetadata(context, "llvm.loop.interleave.count", 1)));
+            }
             if (unroll)
             {
                 metadataElements.push_back(llvm::MDNode::get(context, GenerateVectorizeFollowupMetadata(context)));
@@ -96,6 +109,12 @@ namespace emitters
         _tag(tag)
     {}
 
+    IRForLoopEmitter::IRForLoopEmitter(IRFunctionEmitter& functionEmitter, const std::string& tag, int vectorWidth) :
+        IRLoopEmitter(functionEmitter),
+        _tag(tag),
+        _vectorWidth(vectorWidth)
+    {}
+
     void IRForLoopEmitter::CreateBlocks()
     {
         _pInitializationBlock = _functionEmitter.Block(_tag + LoopInitBlockName);
@@ -157,7 +176,7 @@ namespace emitters
 
         bool unroll = false;
         bool vectorize = true;
-        AddLoopMetadata(branchInst, unroll, vectorize);
+        AddLoopMetadata(branchInst, unroll, vectorize, _vectorWidth);
     }
 
     void IRForLoopEmitter::EmitIncrement(LLVMValue pIncrementValue)
@@ -54,6 +54,12 @@ namespace emitters
         return { a.function, a.function.Call(f, { a }) };
     }
 
+    IRLocalScalar Sigmoid(IRLocalScalar a)
+    {
+        auto f = a.function.GetModule().GetRuntime().GetSigmoidFunction((a.value)->getType());
+        return { a.function, a.function.Call(f, { a }) };
+    }
+
     IRLocalScalar Sin(IRLocalScalar a)
     {
         auto f = a.function.GetModule().GetRuntime().GetSinFunction((a.value)->getType());
@@ -478,6 +478,32 @@ namespace emitters
         return AddGlobal(name, pArrayType, ZeroInitializer(pArrayType), false, isThreadLocal);
     }
 
+    llvm::GlobalVariable* IRModuleEmitter::PlaceGlobalsInArena(const std::string& name, size_t size, const std::vector<std::pair<Variable*, size_t>>& placements)
+    {
+        auto arena = GlobalArray(VariableType::Byte, name, size);
+        auto int64Type = llvm::Type::getInt64Ty(GetLLVMContext());
+        for (const auto& placement : placements)
+        {
+            auto& var = *placement.first;
+            auto global = llvm::dyn_cast_or_null<llvm::GlobalVariable>(GetEmittedVariable(var.Scope(), var.EmittedName()));
+            if (global == nullptr)
+            {
+                throw EmitterException(EmitterError::unexpected, "Only emitted global variables can be placed in an arena");
+            }
+
+            llvm::Constant* indices[] = { llvm::ConstantInt::get(int64Type, 0), llvm::ConstantInt::get(int64Type, placement.second) };
+            auto slice = llvm::ConstantExpr::getInBoundsGetElementPtr(arena->getValueType(), arena, indices);
+            auto typedSlice = llvm::ConstantExpr::getBitCast(slice, global->getType());
+            global->replaceAllUsesWith(typedSlice);
+            global->eraseFromParent();
+
+            // Keep the symbol table pointing at the variable's new home
+            _globals.Remove(var.EmittedName());
+            _globals.Add(var.EmittedName(), typedSlice);
+        }
+        return arena;
+    }
+
     // This function has the actual implementation for all the above Global/GlobalArray() methods
     llvm::GlobalVariable* IRModuleEmitter::AddGlobal(const std::string& name, LLVMType pType, llvm::Constant* pInitial, bool isConst, bool isThreadLocal)
     {
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRObjectCache.cpp (emitters)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "IRObjectCache.h"
+
+#include <utilities/include/Files.h>
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <cstdint>
+#include <cstring>
+
+namespace ell
+{
+namespace emitters
+{
+    namespace
+    {
+        const char cacheFileMagic[8] = { 'E', 'L', 'L', 'C', 'A', 'C', 'H', 'E' };
+
+        // Written at the start of every cache file, so truncated or corrupted files can be detected
+        struct CacheFileHeader
+        {
+            char magic[8];
+            uint64_t size;
+            uint8_t hash[16];
+        };
+
+        void GetHash(llvm::StringRef contents, uint8_t (&hash)[16])
+        {
+            llvm::MD5 md5;
+            md5.update(llvm::ArrayRef<uint8_t>(reinterpret_cast<const uint8_t*>(contents.data()), contents.size()));
+            llvm::MD5::MD5Result result;
+            md5.final(result);
+            for (size_t i = 0; i < 16; ++i)
+            {
+                hash[i] = result[i];
+            }
+        }
+    } // namespace
+
+    bool WriteCacheFile(const std::string& filePath, llvm::StringRef contents)
+    {
+        CacheFileHeader header;
+        std::memcpy(header.magic, cacheFileMagic, sizeof(header.magic));
+        header.size = contents.size();
+        GetHash(contents, header.hash);
+
+        // Each writer gets its own temporary file, which is renamed into place once it's complete
+        int fd = -1;
+        llvm::SmallString<256> tempFilePath;
+        if (llvm::sys::fs::createUniqueFile(filePath + ".%%%%%%%%.tmp", fd, tempFilePath))
+        {
+            return false;
+        }
+
+        {
+            llvm::raw_fd_ostream stream(fd, /* shouldClose */ true);
+            stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            stream << contents;
+            stream.close();
+            if (stream.has_error())
+            {
+                stream.clear_error();
+                llvm::sys::fs::remove(tempFilePath);
+                return false;
+            }
+        }
+
+        if (llvm::sys::fs::rename(tempFilePath, filePath))
+        {
+            llvm::sys::fs::remove(tempFilePath);
+            return false;
+        }
+        return true;
+    }
+
+    std::unique_ptr<llvm::MemoryBuffer> ReadCacheFile(const std::string& filePath)
+    {
+        auto buffer = llvm::MemoryBuffer::getFile(filePath);
+        if (!buffer || (*buffer)->getBufferSize() < sizeof(CacheFileHeader))
+        {
+            return nullptr;
+        }
+
+        CacheFileHeader header;
+        std::memcpy(&header, (*buffer)->getBufferStart(), sizeof(header));
+        auto contents = (*buffer)->getBuffer().drop_front(sizeof(header));
+        if (std::memcmp(header.magic, cacheFileMagic, sizeof(header.magic)) != 0 || header.size != contents.size())
+        {
+            return nullptr;
+        }
+
+        uint8_t hash[16];
+        GetHash(contents, hash);
+        if (std::memcmp(header.hash, hash, sizeof(hash)) != 0)
+        {
+            return nullptr;
+        }
+
+        // Copy the contents, so the cache file can be replaced while they're in use
+        return llvm::MemoryBuffer::getMemBufferCopy(contents, filePath);
+    }
+
+    IRObjectCache::IRObjectCache(const std::string& directory, const std::string& key) :
+        _objectFilePath(utilities::JoinPaths(directory, key + ".o"))
+    {
+        utilities::EnsureDirectoryExists(directory);
+    }
+
+    bool IRObjectCache::HasObject() const
+    {
+        return utilities::FileExists(_objectFilePath);
+    }
+
+    void IRObjectCache::notifyObjectCompiled(const llvm::Module* module, llvm::MemoryBufferRef object)
+    {
+        // Failing to write the cache isn't an error: the code has already been generated
+        _wasObjectCompiled = true;
+        WriteCacheFile(_objectFilePath, object.getBuffer());
+    }
+
+    std::unique_ptr<llvm::MemoryBuffer> IRObjectCache::getObject(const llvm::Module* module)
+    {
+        // A missing or damaged file is a miss: the engine generates the code and replaces the file
+        auto object = ReadCacheFile(_objectFilePath);
+        _wasObjectLoaded = object != nullptr;
+        return object;
+    }
+} // namespace emitters
+} // namespace ell
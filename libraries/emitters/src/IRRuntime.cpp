@@ -10,6 +10,7 @@
 #include "IRFunctionEmitter.h"
 #include "IRMetadata.h"
 #include "IRModuleEmitter.h"
+#include "IRVectorMath.h"
 
 #include <utilities/include/Unused.h>
 
@@ -154,6 +155,11 @@ namespace emitters
         }
     }
 
+    bool IRRuntime::UseApproximateMathFunctions(LLVMType argType) const
+    {
+        return _module.GetCompilerOptions().useFastMath && CanApproximateMathFunctions(argType);
+    }
+
     std::string IRRuntime::GetNamespacePrefix() const
     {
         return _module.GetModuleName();
@@ -382,7 +388,7 @@ namespace emitters
 
     LLVMFunction IRRuntime::GetExpFunction(VariableType argType)
     {
-        return _module.GetIntrinsic(llvm::Intrinsic::exp, { argType });
+        return GetExpFunction(_module.GetIREmitter().Type(argType));
     }
 
     LLVMFunction IRRuntime::GetPowFunction(VariableType argType)
@@ -392,7 +398,7 @@ namespace emitters
 
     LLVMFunction IRRuntime::GetLogFunction(VariableType argType)
     {
-        return _module.GetIntrinsic(llvm::Intrinsic::log, { argType });
+        return GetLogFunction(_module.GetIREmitter().Type(argType));
     }
 
     LLVMFunction IRRuntime::GetLog10Function(VariableType argType)
@@ -443,6 +449,11 @@ namespace emitters
         return GetTanhFunction(valueType);
     }
 
+    LLVMFunction IRRuntime::GetSigmoidFunction(VariableType argType)
+    {
+        return GetSigmoidFunction(_module.GetIREmitter().Type(argType));
+    }
+
     LLVMFunction IRRuntime::GetRoundFunction(VariableType argType)
     {
         return _module.GetIntrinsic(llvm::Intrinsic::round, { argType });
@@ -460,6 +471,10 @@ namespace emitters
 
     LLVMFunction IRRuntime::GetExpFunction(LLVMType argType)
     {
+        if (UseApproximateMathFunctions(argType))
+        {
+            return GetApproximateExpFunction(_module, argType, _module.GetCompilerOptions().fastMathAccuracy);
+        }
         return _module.GetIntrinsic(llvm::Intrinsic::exp, { argType });
     }
 
@@ -470,6 +485,10 @@ namespace emitters
 
     LLVMFunction IRRuntime::GetLogFunction(LLVMType argType)
     {
+        if (UseApproximateMathFunctions(argType))
+        {
+            return GetApproximateLogFunction(_module, argType, _module.GetCompilerOptions().fastMathAccuracy);
+        }
         return _module.GetIntrinsic(llvm::Intrinsic::log, { argType });
     }
 
@@ -495,6 +514,11 @@ namespace emitters
 
     LLVMFunction IRRuntime::GetTanhFunction(LLVMType valueType)
     {
+        if (UseApproximateMathFunctions(valueType))
+        {
+            return GetApproximateTanhFunction(_module, valueType, _module.GetCompilerOptions().fastMathAccuracy);
+        }
+
         // This assumes a standard C runtime library is linked
         const char* funcName = "";
         if (valueType->isDoubleTy())
@@ -514,6 +538,39 @@ namespace emitters
         return _module.GetFunction(funcName);
     }
 
+    LLVMFunction IRRuntime::GetSigmoidFunction(LLVMType valueType)
+    {
+        auto elementType = valueType->isVectorTy() ? llvm::cast<llvm::VectorType>(valueType)->getElementType() : valueType;
+        auto typeName = std::string(elementType->isDoubleTy() ? "f64" : "f32");
+        if (valueType->isVectorTy())
+        {
+            typeName = "v" + std::to_string(llvm::cast<llvm::VectorType>(valueType)->getNumElements()) + typeName;
+        }
+        auto functionName = GetNamespacePrefix() + "_Sigmoid_" + typeName;
+        if (auto function = _module.GetFunction(functionName))
+        {
+            return function;
+        }
+
+        // sigmoid(x) = 1 / (1 + exp(-x)) for x >= 0, and exp(x) / (1 + exp(x)) otherwise. Both are computed from
+        // exp(-|x|), which never overflows, and chosen with a select so vectors don't need a branch.
+        auto expFunction = GetExpFunction(valueType);
+        auto absFunction = GetAbsFunction(valueType);
+        auto function = _module.BeginFunction(functionName, valueType, std::vector<LLVMType>{ valueType });
+        auto x = &(*function.Arguments().begin());
+        auto& builder = function.GetEmitter().GetIRBuilder();
+        auto zero = llvm::Constant::getNullValue(valueType);
+        auto one = llvm::ConstantFP::get(valueType, 1.0);
+        auto expNegAbsX = builder.CreateCall(expFunction, { builder.CreateFSub(zero, builder.CreateCall(absFunction, { x })) });
+        auto reciprocal = builder.CreateFDiv(one, builder.CreateFAdd(one, expNegAbsX));
+        auto result = builder.CreateSelect(builder.CreateFCmpOGE(x, zero), reciprocal, builder.CreateFMul(expNegAbsX, reciprocal));
+        function.Return(result);
+        _module.EndFunction();
+
+        function.SetInlineState(FunctionInlining::always);
+        return function.GetFunction();
+    }
+
     LLVMFunction IRRuntime::GetSinFunction(LLVMType argType)
     {
         return _module.GetIntrinsic(llvm::Intrinsic::sin, { argType });
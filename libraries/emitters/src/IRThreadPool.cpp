@@ -23,6 +23,79 @@ namespace ell
 {
 namespace emitters
 {
+    namespace
+    {
+        // Number of times an idle thread polls for new work before it parks on a condition variable
+        const int c_spinCount = 4096;
+
+        // Distance between the task ranges of adjacent slots, in 64-bit words, so each slot gets its own cache line
+        const int c_rangeStride = 8;
+
+        unsigned GetAtomicAlignment(IRFunctionEmitter& function, LLVMType type)
+        {
+            return function.GetModule().GetTargetDataLayout().getTypeAllocSize(type);
+        }
+
+        LLVMValue AtomicLoad(IRFunctionEmitter& function, LLVMValue pointer, llvm::AtomicOrdering ordering)
+        {
+            auto& irBuilder = function.GetEmitter().GetIRBuilder();
+            auto load = irBuilder.CreateLoad(pointer);
+            load->setAtomic(ordering);
+            load->setAlignment(GetAtomicAlignment(function, load->getType()));
+            return load;
+        }
+
+        void AtomicStore(IRFunctionEmitter& function, LLVMValue pointer, LLVMValue value, llvm::AtomicOrdering ordering)
+        {
+            auto& irBuilder = function.GetEmitter().GetIRBuilder();
+            auto store = irBuilder.CreateStore(value, pointer);
+            store->setAtomic(ordering);
+            store->setAlignment(GetAtomicAlignment(function, value->getType()));
+        }
+
+        // Returns the value stored at `pointer` before the addition
+        LLVMValue AtomicAdd(IRFunctionEmitter& function, LLVMValue pointer, int value, llvm::AtomicOrdering ordering)
+        {
+            auto& irBuilder = function.GetEmitter().GetIRBuilder();
+            return irBuilder.CreateAtomicRMW(llvm::AtomicRMWInst::Add, pointer, function.Literal<int>(value), ordering);
+        }
+
+        // Returns `true` if the exchange succeeded
+        LLVMValue AtomicCompareExchange(IRFunctionEmitter& function, LLVMValue pointer, LLVMValue expected, LLVMValue desired)
+        {
+            auto& irBuilder = function.GetEmitter().GetIRBuilder();
+            auto result = irBuilder.CreateAtomicCmpXchg(pointer, expected, desired, llvm::AtomicOrdering::AcquireRelease, llvm::AtomicOrdering::Acquire);
+            return irBuilder.CreateExtractValue(result, 1);
+        }
+
+        // Task ranges are packed into a single 64-bit word, with `begin` in the low half and `end` in the high half,
+        // so that claiming or stealing tasks is a single compare-and-swap
+        int64_t PackRange(int begin, int end)
+        {
+            return (static_cast<int64_t>(end) << 32) | static_cast<uint32_t>(begin);
+        }
+
+        LLVMValue PackRange(IRFunctionEmitter& function, LLVMValue begin, LLVMValue end)
+        {
+            auto& irBuilder = function.GetEmitter().GetIRBuilder();
+            auto int64Type = irBuilder.getInt64Ty();
+            auto high = irBuilder.CreateShl(irBuilder.CreateZExt(end, int64Type), 32);
+            return irBuilder.CreateOr(high, irBuilder.CreateZExt(begin, int64Type));
+        }
+
+        LLVMValue GetRangeBegin(IRFunctionEmitter& function, LLVMValue range)
+        {
+            auto& irBuilder = function.GetEmitter().GetIRBuilder();
+            return irBuilder.CreateTrunc(range, irBuilder.getInt32Ty());
+        }
+
+        LLVMValue GetRangeEnd(IRFunctionEmitter& function, LLVMValue range)
+        {
+            auto& irBuilder = function.GetEmitter().GetIRBuilder();
+            return irBuilder.CreateTrunc(irBuilder.CreateLShr(range, 32), irBuilder.getInt32Ty());
+        }
+    } // namespace
+
     //
     // IRThreadPool
     //
@@ -60,11 +133,15 @@ namespace emitters
                 initThreadPoolFunction.Store(isInitedVar, initThreadPoolFunction.TrueBit());
                 _taskQueue.Initialize(initThreadPoolFunction);
 
-                auto workerThreadFunction = this->GetWorkerThreadFunction(); // STYLE gcc bug requires `this->` inside generic lambda (https://gcc.gnu.org/bugzilla/show_bug.cgi?id=67274)
+                auto useWorkStealing = _taskQueue.UsesWorkStealing();
+                auto workerThreadFunction = useWorkStealing ? this->GetWorkStealingWorkerThreadFunction() : this->GetWorkerThreadFunction(); // STYLE gcc bug requires `this->` inside generic lambda (https://gcc.gnu.org/bugzilla/show_bug.cgi?id=67274)
                 llvm::ConstantPointerNull* nullAttr = initThreadPoolFunction.NullPointer(int8PtrType);
-                initThreadPoolFunction.For(_maxThreads, [this, int8PtrType, nullAttr, workerThreadFunction](auto& initThreadPoolFunction, LLVMValue index) {
+                initThreadPoolFunction.For(_maxThreads, [this, int8PtrType, nullAttr, workerThreadFunction, useWorkStealing](auto& initThreadPoolFunction, LLVMValue index) {
                     auto threadPtr = initThreadPoolFunction.PointerOffset(_threads, index);
-                    initThreadPoolFunction.PthreadCreate(threadPtr, nullAttr, workerThreadFunction, initThreadPoolFunction.CastPointer(_taskQueue.GetDataStruct(), int8PtrType));
+
+                    // Work-stealing workers get their slot index as their argument, the others get the task queue
+                    auto threadArg = useWorkStealing ? initThreadPoolFunction.CastIntToPointer(index, int8PtrType) : initThreadPoolFunction.CastPointer(_taskQueue.GetDataStruct(), int8PtrType);
+                    initThreadPoolFunction.PthreadCreate(threadPtr, nullAttr, workerThreadFunction, threadArg);
                 });
             });
         }
@@ -149,6 +226,38 @@ namespace emitters
         return workerThreadFunction.GetFunction();
     }
 
+    LLVMFunction IRThreadPool::GetWorkStealingWorkerThreadFunction()
+    {
+        assert(IsInitialized());
+
+        auto& context = _module.GetLLVMContext();
+        auto boolType = llvm::Type::getInt1Ty(context);
+        auto int32Type = llvm::Type::getInt32Ty(context);
+        auto int8PtrType = llvm::Type::getInt8PtrTy(context);
+
+        auto workerThreadFunction = _module.BeginFunction("WorkStealingWorkerThreadFunction", int8PtrType, { int8PtrType });
+        {
+            auto slotIndex = workerThreadFunction.CastPointerToInt(&(*workerThreadFunction.GetFunction()->arg_begin()), int32Type);
+            auto lastGenerationVar = workerThreadFunction.Variable(int32Type, "lastGeneration");
+            auto notDoneVar = workerThreadFunction.Variable(boolType, "notDone");
+            workerThreadFunction.Store(lastGenerationVar, workerThreadFunction.Literal<int>(0));
+            workerThreadFunction.Store(notDoneVar, workerThreadFunction.TrueBit());
+            workerThreadFunction.While(notDoneVar, [this, notDoneVar, lastGenerationVar, slotIndex](IRFunctionEmitter& workerThreadFunction) {
+                _taskQueue.WaitForNewTasks(workerThreadFunction, lastGenerationVar);
+                workerThreadFunction.If(_taskQueue.GetShutdownFlag(workerThreadFunction), [notDoneVar](auto& workerThreadFunction) {
+                                            workerThreadFunction.Store(notDoneVar, workerThreadFunction.FalseBit());
+                                        })
+                    .Else([this, slotIndex](IRFunctionEmitter& workerThreadFunction) {
+                        workerThreadFunction.Call(_taskQueue.GetRunTasksFunction(workerThreadFunction.GetModule()), { slotIndex });
+                    });
+            });
+
+            workerThreadFunction.Return(workerThreadFunction.NullPointer(int8PtrType));
+        }
+        _module.EndFunction();
+        return workerThreadFunction.GetFunction();
+    }
+
     bool IRThreadPool::IsInitialized() const
     {
         return _threads != nullptr;
@@ -197,8 +306,19 @@ namespace emitters
         function.Store(count, function.Literal<int>(0));
         function.Store(unfinishedCount, function.Literal<int>(0));
         function.Store(shutdownFlag, function.FalseBit());
+        function.Store(GetFieldPointer(function, static_cast<int>(Fields::generation)), function.Literal<int>(0));
+        function.Store(GetFieldPointer(function, static_cast<int>(Fields::numSleepingWorkers)), function.Literal<int>(0));
 
         _tasks.Initialize(function);
+
+        const auto& compilerOptions = module.GetCompilerOptions();
+        _useWorkStealing = compilerOptions.useWorkStealing;
+        if (_useWorkStealing)
+        {
+            _numSlots = compilerOptions.maxThreads + 1;
+            _workerRanges = module.GlobalArray("taskQueueRanges", llvm::Type::getInt64Ty(context), _numSlots * c_rangeStride);
+            GetRunTasksFunction(module);
+        }
     }
 
     IRThreadPoolTaskArray& IRThreadPoolTaskQueue::StartTasks(IRFunctionEmitter& function, LLVMFunction taskFunction, const std::vector<std::vector<LLVMValue>>& arguments)
@@ -207,6 +327,12 @@ namespace emitters
 
         // TODO: assert we're idle (until we can handle multiple task arrays to be active)
 
+        if (_useWorkStealing)
+        {
+            StartWorkStealingTasks(function, taskFunction, arguments);
+            return GetTaskArray();
+        }
+
         const auto numTasks = arguments.size();
 
         LockQueueMutex(function);
@@ -272,6 +398,15 @@ namespace emitters
     void IRThreadPoolTaskQueue::ShutDown(IRFunctionEmitter& function)
     {
         SetShutdownFlag(function);
+        if (_useWorkStealing)
+        {
+            // Start a new generation so that spinning workers notice the shutdown flag, then wake up any parked ones
+            AtomicAdd(function, GetFieldPointer(function, static_cast<int>(Fields::generation)), 1, llvm::AtomicOrdering::SequentiallyConsistent);
+            LockQueueMutex(function);
+            function.PthreadCondBroadcast(GetWorkAvailableConditionVariablePointer(function));
+            UnlockQueueMutex(function);
+            return;
+        }
 
         // Now wake up the threads so they see it is time to shutdown.
         function.PthreadCondBroadcast(GetWorkAvailableConditionVariablePointer(function));
@@ -280,6 +415,12 @@ namespace emitters
 
     void IRThreadPoolTaskQueue::WaitAll(IRFunctionEmitter& function)
     {
+        if (_useWorkStealing)
+        {
+            WaitAllWorkStealing(function);
+            return;
+        }
+
         auto& module = function.GetModule();
         auto& context = module.GetLLVMContext();
         auto boolType = llvm::Type::getInt1Ty(context);
@@ -305,7 +446,7 @@ namespace emitters
         auto boolType = llvm::Type::getInt1Ty(context);
         auto int32Type = llvm::Type::getInt32Ty(context);
 
-        std::vector<LLVMType> fieldTypes = { mutexType, conditionVarType, conditionVarType, int32Type, int32Type, boolType };
+        std::vector<LLVMType> fieldTypes = { mutexType, conditionVarType, conditionVarType, int32Type, int32Type, boolType, int32Type, int32Type };
         return module.GetAnonymousStructType(fieldTypes);
     }
 
@@ -387,6 +528,232 @@ namespace emitters
         function.Store(fieldPtr, function.TrueBit());
     }
 
+    LLVMValue IRThreadPoolTaskQueue::GetFieldPointer(IRFunctionEmitter& function, int field) const
+    {
+        return function.GetStructFieldPointer(_queueData, field);
+    }
+
+    //
+    // Work-stealing scheduler
+    //
+
+    void IRThreadPoolTaskQueue::StartWorkStealingTasks(IRFunctionEmitter& function, LLVMFunction taskFunction, const std::vector<std::vector<LLVMValue>>& arguments)
+    {
+        const auto numTasks = static_cast<int>(arguments.size());
+        _tasks.SetTasks(function, taskFunction, arguments);
+        AtomicStore(function, GetFieldPointer(function, static_cast<int>(Fields::unfinishedCount)), function.Literal<int>(numTasks), llvm::AtomicOrdering::Release);
+
+        // Deal out the tasks in contiguous blocks, one per slot. Publishing a range (with release semantics) makes
+        // the task array visible to whoever claims from it, so workers may start before the generation changes.
+        for (int slot = 0; slot < _numSlots; ++slot)
+        {
+            auto begin = static_cast<int>(static_cast<int64_t>(numTasks) * slot / _numSlots);
+            auto end = static_cast<int>(static_cast<int64_t>(numTasks) * (slot + 1) / _numSlots);
+            AtomicStore(function, GetWorkerRangePointer(function, function.Literal<int>(slot)), function.Literal<int64_t>(PackRange(begin, end)), llvm::AtomicOrdering::Release);
+        }
+
+        // Only take the mutex if some worker has given up spinning and parked. This is sequentially consistent with the
+        // check in `WaitForNewTasks`, so either the worker sees the new generation or we see the worker.
+        AtomicAdd(function, GetFieldPointer(function, static_cast<int>(Fields::generation)), 1, llvm::AtomicOrdering::SequentiallyConsistent);
+        auto numSleeping = AtomicLoad(function, GetFieldPointer(function, static_cast<int>(Fields::numSleepingWorkers)), llvm::AtomicOrdering::SequentiallyConsistent);
+        function.If(function.Comparison(TypedComparison::greaterThan, numSleeping, function.Literal<int>(0)), [this](IRFunctionEmitter& function) {
+            LockQueueMutex(function);
+            function.PthreadCondBroadcast(GetWorkAvailableConditionVariablePointer(function));
+            UnlockQueueMutex(function);
+        });
+    }
+
+    void IRThreadPoolTaskQueue::WaitAllWorkStealing(IRFunctionEmitter& function)
+    {
+        // The client thread works on its own slot (and steals) instead of just blocking
+        function.Call(GetRunTasksFunction(function.GetModule()), { function.Literal<int>(_numSlots - 1) });
+
+        auto unfinishedCountPtr = GetFieldPointer(function, static_cast<int>(Fields::unfinishedCount));
+        auto isNotFinished = [unfinishedCountPtr](IRFunctionEmitter& function) {
+            auto count = AtomicLoad(function, unfinishedCountPtr, llvm::AtomicOrdering::Acquire);
+            return function.Comparison(TypedComparison::notEquals, count, function.Literal<int>(0));
+        };
+
+        // Every task has been claimed by now, so spin briefly for the stragglers before going to sleep
+        auto spinCountVar = function.Variable(VariableType::Int32, "spinCount");
+        function.Store(spinCountVar, function.Literal<int>(0));
+        function.While([spinCountVar, isNotFinished](IRFunctionEmitter& function) {
+            auto keepSpinning = function.Comparison(TypedComparison::lessThan, function.Load(spinCountVar), function.Literal<int>(c_spinCount));
+            return function.Operator(TypedOperator::logicalAnd, isNotFinished(function), keepSpinning);
+        },
+                       [spinCountVar](IRFunctionEmitter& function) {
+                           function.OperationAndUpdate(spinCountVar, TypedOperator::add, function.Literal<int>(1));
+                       });
+
+        function.If(isNotFinished(function), [this, isNotFinished](IRFunctionEmitter& function) {
+            auto mutex = GetQueueMutexPointer(function);
+            auto workFinishedCondVar = GetWorkFinishedConditionVariablePointer(function);
+            LockQueueMutex(function);
+            function.While(isNotFinished, [mutex, workFinishedCondVar](IRFunctionEmitter& function) {
+                function.PthreadCondWait(workFinishedCondVar, mutex);
+            });
+            UnlockQueueMutex(function);
+        });
+    }
+
+    void IRThreadPoolTaskQueue::WaitForNewTasks(IRFunctionEmitter& function, LLVMValue lastGenerationVar)
+    {
+        auto generationPtr = GetFieldPointer(function, static_cast<int>(Fields::generation));
+        auto numSleepingPtr = GetFieldPointer(function, static_cast<int>(Fields::numSleepingWorkers));
+        auto isSameGeneration = [generationPtr, lastGenerationVar](IRFunctionEmitter& function) {
+            auto generation = AtomicLoad(function, generationPtr, llvm::AtomicOrdering::SequentiallyConsistent);
+            return function.Comparison(TypedComparison::equals, generation, function.Load(lastGenerationVar));
+        };
+
+        // Spin first, in case another batch of tasks arrives right away
+        auto spinCountVar = function.Variable(VariableType::Int32, "spinCount");
+        function.Store(spinCountVar, function.Literal<int>(0));
+        function.While([spinCountVar, isSameGeneration](IRFunctionEmitter& function) {
+            auto keepSpinning = function.Comparison(TypedComparison::lessThan, function.Load(spinCountVar), function.Literal<int>(c_spinCount));
+            return function.Operator(TypedOperator::logicalAnd, isSameGeneration(function), keepSpinning);
+        },
+                       [spinCountVar](IRFunctionEmitter& function) {
+                           function.OperationAndUpdate(spinCountVar, TypedOperator::add, function.Literal<int>(1));
+                       });
+
+        // Then park on the condition variable. Registering as a sleeper before re-checking the generation pairs with
+        // the check in `StartWorkStealingTasks`, so a new generation can't slip by without a wakeup.
+        function.If(isSameGeneration(function), [this, numSleepingPtr, isSameGeneration](IRFunctionEmitter& function) {
+            AtomicAdd(function, numSleepingPtr, 1, llvm::AtomicOrdering::SequentiallyConsistent);
+            auto mutex = GetQueueMutexPointer(function);
+            auto workAvailableCondVar = GetWorkAvailableConditionVariablePointer(function);
+            LockQueueMutex(function);
+            function.While(isSameGeneration, [mutex, workAvailableCondVar](IRFunctionEmitter& function) {
+                function.PthreadCondWait(workAvailableCondVar, mutex);
+            });
+            UnlockQueueMutex(function);
+            AtomicAdd(function, numSleepingPtr, -1, llvm::AtomicOrdering::SequentiallyConsistent);
+        });
+
+        function.Store(lastGenerationVar, AtomicLoad(function, generationPtr, llvm::AtomicOrdering::Acquire));
+    }
+
+    LLVMFunction IRThreadPoolTaskQueue::GetRunTasksFunction(IRModuleEmitter& module)
+    {
+        if (_runTasksFunction == nullptr)
+        {
+            const NamedVariableTypeList parameters = { { "slotIndex", VariableType::Int32 } };
+            auto runTasksFunction = module.BeginFunction("RunThreadPoolTasks", VariableType::Void, parameters);
+            {
+                RunAvailableTasks(runTasksFunction, runTasksFunction.GetFunctionArgument("slotIndex"));
+                runTasksFunction.Return();
+            }
+            module.EndFunction();
+            _runTasksFunction = runTasksFunction.GetFunction();
+        }
+        return _runTasksFunction;
+    }
+
+    void IRThreadPoolTaskQueue::RunAvailableTasks(IRFunctionEmitter& function, LLVMValue slotIndex)
+    {
+        // Run tasks from our own range, then from other slots' ranges, until no slot has any tasks left
+        auto isWorkingVar = function.Variable(llvm::Type::getInt1Ty(function.GetLLVMContext()), "isWorking");
+        auto taskIndexVar = function.Variable(VariableType::Int32, "taskIndex");
+        function.Store(isWorkingVar, function.TrueBit());
+        function.While(isWorkingVar, [this, slotIndex, isWorkingVar, taskIndexVar](IRFunctionEmitter& function) {
+            function.Store(taskIndexVar, PopOwnTask(function, slotIndex));
+            function.If(function.Comparison(TypedComparison::lessThan, function.Load(taskIndexVar), function.Literal<int>(0)), [this, slotIndex, taskIndexVar](IRFunctionEmitter& function) {
+                function.Store(taskIndexVar, StealTasks(function, slotIndex));
+            });
+
+            auto taskIndex = function.Load(taskIndexVar);
+            function.If(function.Comparison(TypedComparison::lessThan, taskIndex, function.Literal<int>(0)), [isWorkingVar](IRFunctionEmitter& function) {
+                        function.Store(isWorkingVar, function.FalseBit());
+                    })
+                .Else([this, taskIndex](IRFunctionEmitter& function) {
+                    RunTask(function, taskIndex);
+                });
+        });
+    }
+
+    LLVMValue IRThreadPoolTaskQueue::PopOwnTask(IRFunctionEmitter& function, LLVMValue slotIndex)
+    {
+        // Take the first task of our range. Returns -1 if the range is empty.
+        auto resultVar = function.Variable(VariableType::Int32, "ownTask");
+        auto retryVar = function.Variable(llvm::Type::getInt1Ty(function.GetLLVMContext()), "retry");
+        function.Store(resultVar, function.Literal<int>(-1));
+        function.Store(retryVar, function.TrueBit());
+        function.While(retryVar, [this, slotIndex, resultVar, retryVar](IRFunctionEmitter& function) {
+            auto rangePtr = GetWorkerRangePointer(function, slotIndex);
+            auto range = AtomicLoad(function, rangePtr, llvm::AtomicOrdering::Acquire);
+            auto begin = GetRangeBegin(function, range);
+            auto end = GetRangeEnd(function, range);
+            function.If(function.Comparison(TypedComparison::lessThan, begin, end), [=](IRFunctionEmitter& function) {
+                        auto newRange = PackRange(function, function.Operator(TypedOperator::add, begin, function.Literal<int>(1)), end);
+                        function.If(AtomicCompareExchange(function, rangePtr, range, newRange), [=](IRFunctionEmitter& function) {
+                            function.Store(resultVar, begin);
+                            function.Store(retryVar, function.FalseBit());
+                        });
+                    })
+                .Else([retryVar](IRFunctionEmitter& function) {
+                    function.Store(retryVar, function.FalseBit());
+                });
+        });
+        return function.Load(resultVar);
+    }
+
+    LLVMValue IRThreadPoolTaskQueue::StealTasks(IRFunctionEmitter& function, LLVMValue slotIndex)
+    {
+        // Visit the other slots in order, and take the back half of the first nonempty range we find. We run the
+        // first stolen task and put the rest in our own slot, where others may steal them in turn. Returns -1 if
+        // there was nothing to steal.
+        auto resultVar = function.Variable(VariableType::Int32, "stolenTask");
+        auto retryVar = function.Variable(llvm::Type::getInt1Ty(function.GetLLVMContext()), "retry");
+        function.Store(resultVar, function.Literal<int>(-1));
+        function.For(1, _numSlots, [this, slotIndex, resultVar, retryVar](IRFunctionEmitter& function, IRLocalScalar offset) {
+            function.If(function.Comparison(TypedComparison::lessThan, function.Load(resultVar), function.Literal<int>(0)), [=](IRFunctionEmitter& function) {
+                auto victimIndex = function.Operator(TypedOperator::moduloSigned, function.Operator(TypedOperator::add, slotIndex, offset), function.Literal<int>(_numSlots));
+                function.Store(retryVar, function.TrueBit());
+                function.While(retryVar, [=](IRFunctionEmitter& function) {
+                    auto victimRangePtr = GetWorkerRangePointer(function, victimIndex);
+                    auto range = AtomicLoad(function, victimRangePtr, llvm::AtomicOrdering::Acquire);
+                    auto begin = GetRangeBegin(function, range);
+                    auto end = GetRangeEnd(function, range);
+                    function.If(function.Comparison(TypedComparison::lessThan, begin, end), [=](IRFunctionEmitter& function) {
+                                auto count = function.Operator(TypedOperator::subtract, end, begin);
+                                auto stealCount = function.Operator(TypedOperator::divideSigned, function.Operator(TypedOperator::add, count, function.Literal<int>(1)), function.Literal<int>(2));
+                                auto newEnd = function.Operator(TypedOperator::subtract, end, stealCount);
+                                function.If(AtomicCompareExchange(function, victimRangePtr, range, PackRange(function, begin, newEnd)), [=](IRFunctionEmitter& function) {
+                                    auto remainingBegin = function.Operator(TypedOperator::add, newEnd, function.Literal<int>(1));
+                                    AtomicStore(function, GetWorkerRangePointer(function, slotIndex), PackRange(function, remainingBegin, end), llvm::AtomicOrdering::Release);
+                                    function.Store(resultVar, newEnd);
+                                    function.Store(retryVar, function.FalseBit());
+                                });
+                            })
+                        .Else([retryVar](IRFunctionEmitter& function) {
+                            function.Store(retryVar, function.FalseBit());
+                        });
+                });
+            });
+        });
+        return function.Load(resultVar);
+    }
+
+    void IRThreadPoolTaskQueue::RunTask(IRFunctionEmitter& function, LLVMValue taskIndex)
+    {
+        auto task = _tasks.GetTask(function, taskIndex);
+        task.Run(function);
+
+        // The thread that finishes the last task wakes up the client, if it's parked
+        auto previousCount = AtomicAdd(function, GetFieldPointer(function, static_cast<int>(Fields::unfinishedCount)), -1, llvm::AtomicOrdering::AcquireRelease);
+        function.If(function.Comparison(TypedComparison::equals, previousCount, function.Literal<int>(1)), [this](IRFunctionEmitter& function) {
+            LockQueueMutex(function);
+            NotifyWaitingClients(function);
+            UnlockQueueMutex(function);
+        });
+    }
+
+    LLVMValue IRThreadPoolTaskQueue::GetWorkerRangePointer(IRFunctionEmitter& function, LLVMValue slotIndex)
+    {
+        assert(_workerRanges != nullptr);
+        return function.PointerOffset(_workerRanges, function.Operator(TypedOperator::multiply, slotIndex, function.Literal<int>(c_rangeStride)));
+    }
+
     void IRThreadPoolTaskQueue::LockQueueMutex(IRFunctionEmitter& function)
     {
         assert(IsInitialized());
@@ -0,0 +1,281 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRVectorMath.cpp (emitters)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "IRVectorMath.h"
+#include "EmitterException.h"
+#include "IRModuleEmitter.h"
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/IRBuilder.h>
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace emitters
+{
+    namespace
+    {
+        // The polynomial coefficients and range reduction constants are from the Cephes single-precision library.
+        // Polynomials are listed from the highest-degree coefficient down.
+
+        // exp(x) = 2^n * exp(r), where n = round(x / ln(2)) and r = x - n * ln(2), with ln(2) split in two parts so
+        // the reduction is exact. 2^n is applied as two factors, so that both are normalized floats for every n
+        // between the smallest subnormal result and the largest finite one.
+        constexpr double expMaxInput = 88.7228394; // log(FLT_MAX); larger inputs overflow to infinity
+        constexpr double expMinInput = -103.972084; // log(2^-150); smaller inputs underflow to zero
+        constexpr double log2e = 1.44269504088896341;
+        constexpr double ln2Hi = 0.693359375;
+        constexpr double ln2Lo = -2.12194440e-4;
+        const std::vector<double> expCoefficients = { 1.9875691500e-4, 1.3981999507e-3, 8.3334519073e-3, 4.1665795894e-2, 1.6666665459e-1, 5.0000001201e-1 };
+        const std::vector<double> fastExpCoefficients = { 4.1665795894e-2, 1.6666665459e-1, 5.0000001201e-1 };
+
+        // log(x) = e * ln(2) + log(m), where x = m * 2^e and m is in [sqrt(1/2), sqrt(2))
+        constexpr double sqrtHalf = 0.707106781186547524;
+        constexpr double subnormalScale = 8388608.0; // 2^23, moves subnormal inputs into the normal range
+        const std::vector<double> logCoefficients = { 7.0376836292e-2, -1.1514610310e-1, 1.1676998740e-1, -1.2420140846e-1, 1.4249322787e-1, -1.6668057665e-1, 2.0000714765e-1, -2.4999993993e-1, 3.3333331174e-1 };
+        const std::vector<double> fastLogCoefficients = { 1.1676998740e-1, -1.2420140846e-1, 1.4249322787e-1, -1.6668057665e-1, 2.0000714765e-1, -2.4999993993e-1, 3.3333331174e-1 };
+
+        // tanh(x) = x + x^3 * P(x^2) for small |x|, and sign(x) * (1 - 2 / (exp(2|x|) + 1)) otherwise. The fast
+        // version uses a shorter polynomial over a smaller range.
+        constexpr double tanhPolynomialMaxInput = 0.625;
+        constexpr double fastTanhPolynomialMaxInput = 0.3;
+        const std::vector<double> tanhCoefficients = { -5.70498872745e-3, 2.06390887954e-2, -5.37397155531e-2, 1.33314422036e-1, -3.33332819422e-1 };
+        const std::vector<double> fastTanhCoefficients = { 1.33314422036e-1, -3.33332819422e-1 };
+
+        // Fast math lets the code generator assume that there are no NaNs or infinities, so special inputs are
+        // detected from their bits with integer comparisons instead of floating-point ones
+        constexpr uint32_t absMask = 0x7fffffff;
+        constexpr uint32_t infinityBits = 0x7f800000;
+        constexpr uint32_t smallestNormalBits = 0x00800000;
+
+        using EmitBodyFunction = std::function<LLVMValue(IRModuleEmitter&, llvm::IRBuilder<>&, LLVMValue, FastMathAccuracy)>;
+
+        std::string GetTypeSuffix(LLVMType type)
+        {
+            if (type->isVectorTy())
+            {
+                return "v" + std::to_string(llvm::cast<llvm::VectorType>(type)->getNumElements()) + "f32";
+            }
+            return "f32";
+        }
+
+        LLVMType GetIntegerType(LLVMType type)
+        {
+            auto intType = llvm::Type::getInt32Ty(type->getContext());
+            if (type->isVectorTy())
+            {
+                return llvm::VectorType::get(intType, llvm::cast<llvm::VectorType>(type)->getNumElements());
+            }
+            return intType;
+        }
+
+        LLVMValue Constant(LLVMType type, double value)
+        {
+            return llvm::ConstantFP::get(type, value);
+        }
+
+        LLVMValue IntConstant(LLVMType type, uint64_t value)
+        {
+            return llvm::ConstantInt::get(GetIntegerType(type), value);
+        }
+
+        LLVMValue CallIntrinsic(IRModuleEmitter& module, llvm::IRBuilder<>& builder, llvm::Intrinsic::ID id, std::vector<LLVMValue> args)
+        {
+            auto function = module.GetIntrinsic(id, { args[0]->getType() });
+            return builder.CreateCall(function, args);
+        }
+
+        uint32_t GetBits(float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        // x > limit, for a positive limit
+        LLVMValue EmitIsGreaterThanPositive(llvm::IRBuilder<>& builder, LLVMValue bits, float limit)
+        {
+            return builder.CreateICmpSGT(bits, IntConstant(bits->getType(), GetBits(limit)));
+        }
+
+        // x < limit, for a negative limit
+        LLVMValue EmitIsLessThanNegative(llvm::IRBuilder<>& builder, LLVMValue bits, float limit)
+        {
+            return builder.CreateICmpUGT(bits, IntConstant(bits->getType(), GetBits(limit)));
+        }
+
+        LLVMValue EmitIsNaN(llvm::IRBuilder<>& builder, LLVMValue bits)
+        {
+            auto type = bits->getType();
+            return builder.CreateICmpUGT(builder.CreateAnd(bits, IntConstant(type, absMask)), IntConstant(type, infinityBits));
+        }
+
+        LLVMValue EmitPolynomial(llvm::IRBuilder<>& builder, LLVMValue x, const std::vector<double>& coefficients)
+        {
+            auto type = x->getType();
+            LLVMValue result = Constant(type, coefficients[0]);
+            for (size_t index = 1; index < coefficients.size(); ++index)
+            {
+                result = builder.CreateFAdd(builder.CreateFMul(result, x), Constant(type, coefficients[index]));
+            }
+            return result;
+        }
+
+        LLVMValue EmitExp(IRModuleEmitter& module, llvm::IRBuilder<>& builder, LLVMValue x, FastMathAccuracy accuracy)
+        {
+            auto type = x->getType();
+            auto intType = GetIntegerType(type);
+            auto bits = builder.CreateBitCast(x, intType);
+
+            // The clamped value is only used to keep the arithmetic below in range; out-of-range inputs are
+            // replaced at the end
+            auto clampedX = CallIntrinsic(module, builder, llvm::Intrinsic::minnum, { x, Constant(type, expMaxInput) });
+            clampedX = CallIntrinsic(module, builder, llvm::Intrinsic::maxnum, { clampedX, Constant(type, expMinInput) });
+
+            auto n = CallIntrinsic(module, builder, llvm::Intrinsic::floor, { builder.CreateFAdd(builder.CreateFMul(clampedX, Constant(type, log2e)), Constant(type, 0.5)) });
+            auto r = builder.CreateFSub(clampedX, builder.CreateFMul(n, Constant(type, ln2Hi)));
+            r = builder.CreateFSub(r, builder.CreateFMul(n, Constant(type, ln2Lo)));
+
+            // exp(r) = 1 + r + r^2 * P(r)
+            const auto& coefficients = accuracy == FastMathAccuracy::fast ? fastExpCoefficients : expCoefficients;
+            auto p = EmitPolynomial(builder, r, coefficients);
+            p = builder.CreateFAdd(builder.CreateFMul(p, builder.CreateFMul(r, r)), r);
+            p = builder.CreateFAdd(p, Constant(type, 1.0));
+
+            // 2^n = 2^(n / 2) * 2^(n - n / 2), each built from its exponent bits
+            auto intN = builder.CreateFPToSI(n, intType);
+            auto halfN = builder.CreateAShr(intN, IntConstant(type, 1));
+            auto scale1 = builder.CreateBitCast(builder.CreateShl(builder.CreateAdd(halfN, IntConstant(type, 127)), IntConstant(type, 23)), type);
+            auto scale2 = builder.CreateBitCast(builder.CreateShl(builder.CreateAdd(builder.CreateSub(intN, halfN), IntConstant(type, 127)), IntConstant(type, 23)), type);
+            auto result = builder.CreateFMul(builder.CreateFMul(p, scale1), scale2);
+
+            // Special cases: overflow (including +inf), underflow (including -inf), and NaN
+            result = builder.CreateSelect(EmitIsGreaterThanPositive(builder, bits, static_cast<float>(expMaxInput)), Constant(type, std::numeric_limits<float>::infinity()), result);
+            result = builder.CreateSelect(EmitIsLessThanNegative(builder, bits, static_cast<float>(expMinInput)), Constant(type, 0.0), result);
+            result = builder.CreateSelect(EmitIsNaN(builder, bits), x, result);
+            return result;
+        }
+
+        LLVMValue EmitLog(IRModuleEmitter& module, llvm::IRBuilder<>& builder, LLVMValue x, FastMathAccuracy accuracy)
+        {
+            auto type = x->getType();
+            auto intType = GetIntegerType(type);
+            auto one = Constant(type, 1.0);
+            auto bits = builder.CreateBitCast(x, intType);
+            auto absBits = builder.CreateAnd(bits, IntConstant(type, absMask));
+
+            // Scale subnormal inputs into the normal range
+            auto isSubnormal = builder.CreateICmpULT(absBits, IntConstant(type, smallestNormalBits));
+            auto normalBits = builder.CreateBitCast(builder.CreateSelect(isSubnormal, builder.CreateFMul(x, Constant(type, subnormalScale)), x), intType);
+            auto exponentOffset = builder.CreateSelect(isSubnormal, IntConstant(type, 126 + 23), IntConstant(type, 126));
+
+            // Split x into an exponent e and a mantissa m in [0.5, 1)
+            auto e = builder.CreateSIToFP(builder.CreateSub(builder.CreateLShr(normalBits, IntConstant(type, 23)), exponentOffset), type);
+            auto mantissaBits = builder.CreateOr(builder.CreateAnd(normalBits, IntConstant(type, 0x807fffff)), IntConstant(type, 0x3f000000));
+            auto m = builder.CreateBitCast(mantissaBits, type);
+
+            // Shift m into [sqrt(1/2), sqrt(2)), and compute log(1 + f) for f = m - 1
+            auto isSmallMantissa = builder.CreateFCmpOLT(m, Constant(type, sqrtHalf));
+            e = builder.CreateSelect(isSmallMantissa, builder.CreateFSub(e, one), e);
+            auto f = builder.CreateSelect(isSmallMantissa, builder.CreateFSub(builder.CreateFAdd(m, m), one), builder.CreateFSub(m, one));
+
+            // log(1 + f) = f - f^2 / 2 + f^3 * P(f)
+            const auto& coefficients = accuracy == FastMathAccuracy::fast ? fastLogCoefficients : logCoefficients;
+            auto z = builder.CreateFMul(f, f);
+            auto y = builder.CreateFMul(builder.CreateFMul(f, z), EmitPolynomial(builder, f, coefficients));
+            y = builder.CreateFAdd(y, builder.CreateFMul(e, Constant(type, ln2Lo)));
+            y = builder.CreateFSub(y, builder.CreateFMul(z, Constant(type, 0.5)));
+            auto result = builder.CreateFAdd(builder.CreateFAdd(f, y), builder.CreateFMul(e, Constant(type, ln2Hi)));
+
+            // Special cases: +-0, negative numbers (including -inf), +inf, and NaN
+            auto isZero = builder.CreateICmpEQ(absBits, IntConstant(type, 0));
+            auto isNegative = builder.CreateICmpSLT(bits, IntConstant(type, 0));
+            result = builder.CreateSelect(isNegative, Constant(type, std::numeric_limits<float>::quiet_NaN()), result);
+            result = builder.CreateSelect(isZero, Constant(type, -std::numeric_limits<float>::infinity()), result);
+            result = builder.CreateSelect(builder.CreateICmpEQ(bits, IntConstant(type, infinityBits)), x, result);
+            result = builder.CreateSelect(EmitIsNaN(builder, bits), x, result);
+            return result;
+        }
+
+        LLVMValue EmitTanh(IRModuleEmitter& module, llvm::IRBuilder<>& builder, LLVMValue x, FastMathAccuracy accuracy)
+        {
+            auto type = x->getType();
+            auto one = Constant(type, 1.0);
+            auto two = Constant(type, 2.0);
+
+            // sign(x) * (1 - 2 / (exp(2|x|) + 1)) loses precision near zero, where the odd polynomial is used instead
+            auto absX = CallIntrinsic(module, builder, llvm::Intrinsic::fabs, { x });
+            auto expTwoX = EmitExp(module, builder, builder.CreateFMul(absX, two), accuracy);
+            auto result = builder.CreateFSub(one, builder.CreateFDiv(two, builder.CreateFAdd(expTwoX, one)));
+            result = CallIntrinsic(module, builder, llvm::Intrinsic::copysign, { result, x });
+
+            auto isFast = accuracy == FastMathAccuracy::fast;
+            auto z = builder.CreateFMul(x, x);
+            auto smallResult = builder.CreateFAdd(builder.CreateFMul(builder.CreateFMul(x, z), EmitPolynomial(builder, z, isFast ? fastTanhCoefficients : tanhCoefficients)), x);
+            return builder.CreateSelect(builder.CreateFCmpOLT(absX, Constant(type, isFast ? fastTanhPolynomialMaxInput : tanhPolynomialMaxInput)), smallResult, result);
+        }
+
+        LLVMFunction GetApproximationFunction(IRModuleEmitter& module, const std::string& baseName, LLVMType type, FastMathAccuracy accuracy, const EmitBodyFunction& emitBody)
+        {
+            if (!CanApproximateMathFunctions(type))
+            {
+                throw EmitterException(EmitterError::functionNotFound, "Math function approximations are only available for float values");
+            }
+
+            auto functionName = module.GetModuleName() + "_" + baseName + (accuracy == FastMathAccuracy::fast ? "Fast_" : "_") + GetTypeSuffix(type);
+            if (auto function = module.GetFunction(functionName))
+            {
+                return function;
+            }
+
+            auto& function = module.BeginFunction(functionName, type, std::vector<LLVMType>{ type });
+            auto x = &(*function.Arguments().begin());
+            auto& builder = function.GetEmitter().GetIRBuilder();
+            function.Return(emitBody(module, builder, x, accuracy));
+            module.EndFunction();
+
+            auto llvmFunction = function.GetFunction();
+            IRFunctionEmitter::SetInlineState(llvmFunction, FunctionInlining::always);
+            llvmFunction->addFnAttr(llvm::Attribute::AttrKind::ReadNone);
+            llvmFunction->addFnAttr(llvm::Attribute::AttrKind::NoUnwind);
+            return llvmFunction;
+        }
+    } // namespace
+
+    bool CanApproximateMathFunctions(LLVMType type)
+    {
+        if (type->isVectorTy())
+        {
+            return llvm::cast<llvm::VectorType>(type)->getElementType()->isFloatTy();
+        }
+        return type->isFloatTy();
+    }
+
+    LLVMFunction GetApproximateExpFunction(IRModuleEmitter& module, LLVMType type, FastMathAccuracy accuracy)
+    {
+        return GetApproximationFunction(module, "Exp", type, accuracy, EmitExp);
+    }
+
+    LLVMFunction GetApproximateLogFunction(IRModuleEmitter& module, LLVMType type, FastMathAccuracy accuracy)
+    {
+        return GetApproximationFunction(module, "Log", type, accuracy, EmitLog);
+    }
+
+    LLVMFunction GetApproximateTanhFunction(IRModuleEmitter& module, LLVMType type, FastMathAccuracy accuracy)
+    {
+        return GetApproximationFunction(module, "Tanh", type, accuracy, EmitTanh);
+    }
+} // namespace emitters
+} // namespace ell
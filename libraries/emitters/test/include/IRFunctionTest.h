@@ -7,7 +7,10 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include <emitters/include/CompilerOptions.h>
+
 void TestIRAddFunction();
 void TestCompilableFunction();
 void TestStringCompareFunction();
 void TestAllocaPlacement();
+void TestApproximateMathFunctions(ell::emitters::FastMathAccuracy accuracy);
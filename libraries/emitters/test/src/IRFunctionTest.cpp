@@ -22,7 +22,11 @@
 
 #include <testing/include/testing.h>
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -50,8 +54,43 @@ public:
 };
 
 using UnaryScalarDoubleFunction = double (*)(double);
+using UnaryScalarFloatFunction = float (*)(float);
+using UnaryVectorFloatFunction = void (*)(const float*, float*);
 using BinaryScalarDoubleFunction = double (*)(double, double);
 
+namespace
+{
+// The distance from a float to the next one away from zero
+double GetUlp(float value)
+{
+    value = std::abs(value);
+    return static_cast<double>(std::nextafter(value, std::numeric_limits<float>::infinity())) - value;
+}
+
+// ulpBounded results must be within `maxUlps` ULPs of the exact result. fast results must have a relative error below
+// 1e-4, or be within 1 ULP for subnormal results. Infinite and NaN results must match exactly.
+bool IsApproximationAccurate(float result, double expected, FastMathAccuracy accuracy, double maxUlps)
+{
+    auto roundedExpected = static_cast<float>(expected);
+    if (std::isnan(expected))
+    {
+        return std::isnan(result);
+    }
+    if (std::isinf(roundedExpected))
+    {
+        return result == roundedExpected;
+    }
+
+    auto error = std::abs(result - expected);
+    auto ulp = GetUlp(roundedExpected);
+    if (accuracy == FastMathAccuracy::ulpBounded)
+    {
+        return error <= maxUlps * ulp;
+    }
+    return error <= std::max(1.0e-4 * std::abs(expected), ulp);
+}
+} // namespace
+
 //
 // Tests
 //
@@ -214,4 +253,84 @@ void TestAllocaPlacement()
         }
     }
     testing::ProcessTest("Testing alloca placement", ok);
-}
\ No newline at end of file
+}
+
+void TestApproximateMathFunctions(FastMathAccuracy accuracy)
+{
+    using GetFunction = std::function<LLVMFunction(IRRuntime&, LLVMType)>;
+    struct MathFunctionInfo
+    {
+        std::string name;
+        GetFunction getFunction;
+        std::function<double(double)> reference;
+        std::vector<float> inputs;
+        double maxUlps;
+    };
+
+    const int vectorSize = 4;
+    const auto infinity = std::numeric_limits<float>::infinity();
+    const auto nan = std::numeric_limits<float>::quiet_NaN();
+    const std::vector<float> specialInputs = { nan, infinity, -infinity, -0.0f };
+    const std::vector<float> expInputs = { -103.5f, -100.0f, -87.0f, -20.5f, -3.3f, -1.0f, -0.01f, -1.0e-7f, 0.0f, 1.0e-30f, 1.0e-6f, 0.3f, 0.69314718f, 1.0f, 2.5f, 5.0f, 10.25f, 40.0f, 88.5f, 89.0f };
+    const std::vector<float> logInputs = { 1.0e-40f, 1.0e-30f, 1.0e-5f, 0.01f, 0.5f, 0.70710678f, 0.99f, 0.99999994f, 1.0f, 1.00000012f, 1.01f, 1.41421356f, 2.0f, 2.718281828f, 7.0f, 10.0f, 1000.0f, 123456.0f, 1.0e20f, 3.0e38f };
+    const std::vector<float> sigmoidInputs = { -30.0f, -10.0f, -5.0f, -2.0f, -0.7f, -0.624f, -0.29f, -0.1f, -1.0e-4f, -1.0e-20f, 0.0f, 1.0e-20f, 1.0e-4f, 0.1f, 0.31f, 0.624f, 0.7f, 2.0f, 5.0f, 30.0f };
+    auto withSpecialInputs = [&specialInputs](std::vector<float> inputs) {
+        inputs.insert(inputs.end(), specialInputs.begin(), specialInputs.end());
+        return inputs;
+    };
+    std::vector<MathFunctionInfo> mathFunctions = {
+        { "Exp", [](IRRuntime& runtime, LLVMType type) { return runtime.GetExpFunction(type); }, [](double x) { return std::exp(x); }, withSpecialInputs(expInputs), 2 },
+        { "Log", [](IRRuntime& runtime, LLVMType type) { return runtime.GetLogFunction(type); }, [](double x) { return std::log(x); }, withSpecialInputs(logInputs), 2 },
+        { "Tanh", [](IRRuntime& runtime, LLVMType type) { return runtime.GetTanhFunction(type); }, [](double x) { return std::tanh(x); }, withSpecialInputs(sigmoidInputs), 2 },
+        { "Sigmoid", [](IRRuntime& runtime, LLVMType type) { return runtime.GetSigmoidFunction(type); }, [](double x) { return 1.0 / (1.0 + std::exp(-x)); }, withSpecialInputs(sigmoidInputs), 3 }
+    };
+
+    CompilerOptions options;
+    options.useFastMath = true;
+    options.fastMathAccuracy = accuracy;
+    IRModuleEmitter module("ApproximateMathFunctions", options);
+    auto& emitter = module.GetIREmitter();
+    auto floatType = emitter.Type(VariableType::Float);
+    auto vectorType = emitter.VectorType(floatType, vectorSize);
+
+    // Emit a scalar and a vector version of each function
+    for (const auto& info : mathFunctions)
+    {
+        auto scalarFunction = module.BeginFunction(info.name, VariableType::Float, NamedVariableTypeList{ { "x", VariableType::Float } });
+        auto x = scalarFunction.GetFunctionArgument("x");
+        scalarFunction.Return(scalarFunction.Call(info.getFunction(module.GetRuntime(), floatType), { x }));
+        module.EndFunction();
+
+        auto vectorFunction = module.BeginFunction(info.name + "Vector", VariableType::Void, NamedVariableTypeList{ { "input", VariableType::FloatPointer }, { "output", VariableType::FloatPointer } });
+        auto& builder = vectorFunction.GetEmitter().GetIRBuilder();
+        auto input = builder.CreateBitCast(vectorFunction.GetFunctionArgument("input"), vectorType->getPointerTo());
+        auto output = builder.CreateBitCast(vectorFunction.GetFunctionArgument("output"), vectorType->getPointerTo());
+        auto value = vectorFunction.Call(info.getFunction(module.GetRuntime(), vectorType), { builder.CreateAlignedLoad(input, sizeof(float)) });
+        builder.CreateAlignedStore(value, output, sizeof(float));
+        vectorFunction.Return();
+        module.EndFunction();
+    }
+
+    IRExecutionEngine executionEngine(std::move(module));
+
+    for (const auto& info : mathFunctions)
+    {
+        auto scalarFunction = (UnaryScalarFloatFunction)executionEngine.ResolveFunctionAddress(info.name);
+        auto vectorFunction = (UnaryVectorFloatFunction)executionEngine.ResolveFunctionAddress(info.name + "Vector");
+
+        std::vector<float> vectorResults(info.inputs.size());
+        for (size_t index = 0; index < info.inputs.size(); index += vectorSize)
+        {
+            vectorFunction(info.inputs.data() + index, vectorResults.data() + index);
+        }
+
+        bool ok = true;
+        for (size_t index = 0; index < info.inputs.size(); ++index)
+        {
+            auto x = info.inputs[index];
+            auto expected = info.reference(x);
+            ok = ok && IsApproximationAccurate(scalarFunction(x), expected, accuracy, info.maxUlps) && IsApproximationAccurate(vectorResults[index], expected, accuracy, info.maxUlps);
+        }
+        testing::ProcessTest("Testing approximate " + info.name + " function (" + ToString(accuracy) + " accuracy)", ok);
+    }
+}
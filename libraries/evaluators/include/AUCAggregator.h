@@ -34,6 +34,14 @@ namespace evaluators
         /// <summary> Resets the aggregator to its initial state. </summary>
         void Reset();
 
+        /// <summary>
+        /// Adds the examples seen by another aggregator to this one, as if they had been passed to `Update`. Both
+        /// sets of examples are sorted and then merged, so the result is exact.
+        /// </summary>
+        ///
+        /// <param name="other"> The other aggregator. </param>
+        void Merge(const AUCAggregator& other);
+
         /// <summary> Gets a header that describes the values of this aggregator. </summary>
         ///
         /// <returns> The header string vector. </returns>
@@ -49,7 +57,10 @@ namespace evaluators
             bool operator<(const Aggregate& other) const;
         };
 
+        void Sort() const;
+
         mutable std::vector<Aggregate> _aggregates; // mutable because Get() const has to sort this vector
+        mutable bool _isSorted = true;
     };
 } // namespace evaluators
 } // namespace ell
@@ -34,6 +34,11 @@ namespace evaluators
         /// <summary> Resets the aggregator to its initial state. </summary>
         void Reset();
 
+        /// <summary> Adds the counts of another aggregator to this one. </summary>
+        ///
+        /// <param name="other"> The other aggregator. </param>
+        void Merge(const BinaryErrorAggregator& other);
+
         /// <summary> Gets a header that describes the values of this aggregator. </summary>
         ///
         /// <returns> The header string vector. </returns>
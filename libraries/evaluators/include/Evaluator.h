@@ -14,9 +14,12 @@
 #include <data/include/Example.h>
 
 #include <utilities/include/FunctionUtils.h>
+#include <utilities/include/ThreadPool.h>
 
+#include <algorithm>
 #include <functional>
 #include <memory>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -54,9 +57,19 @@ namespace evaluators
     {
         size_t evaluationFrequency;
         bool addZeroEvaluation;
+
+        /// <summary>
+        /// The number of threads to evaluate with. Each thread scores a contiguous shard of the dataset into its own
+        /// copy of the aggregators, and the copies are merged afterwards. Zero means one thread per core.
+        /// </summary>
+        size_t numThreads = 1;
     };
 
-    /// <summary> Implements an evaluator that holds a data set and a set of evaluation aggregators. </summary>
+    /// <summary>
+    /// Implements an evaluator that holds a data set and a set of evaluation aggregators. When evaluating with more
+    /// than one thread, the predictor's `Predict` is called concurrently, and each aggregator type must provide
+    /// `Merge(const AggregatorType&)`.
+    /// </summary>
     ///
     /// <typeparam name="PredictorType"> The predictor type. </typeparam>
     /// <typeparam name="AggregatorTypes"> The aggregator types. </typeparam>
@@ -151,6 +164,19 @@ namespace evaluators
         template <std::size_t... Sequence>
         std::vector<std::vector<std::string>> DispatchGetValueNames(std::index_sequence<Sequence...>) const;
 
+        using AggregatorTupleType = std::tuple<AggregatorTypes...>;
+
+        void EvaluateShards(const PredictorType& predictor);
+
+        template <std::size_t... Sequence>
+        static void UpdateShard(AggregatorTupleType& aggregators, double prediction, double label, double weight, std::index_sequence<Sequence...>);
+
+        template <std::size_t... Sequence>
+        static void FinishShard(const AggregatorTupleType& aggregators, std::index_sequence<Sequence...>);
+
+        template <std::size_t... Sequence>
+        static void MergeShard(AggregatorTupleType& aggregators, const AggregatorTupleType& shardAggregators, std::index_sequence<Sequence...>);
+
         // the type of example used by this evaluator
         using ExampleType = data::Example<typename PredictorType::DataVectorType, data::WeightLabel>;
 
@@ -160,6 +186,7 @@ namespace evaluators
         size_t _evaluateCounter = 0;
         typename std::tuple<AggregatorTypes...> _aggregatorTuple;
         std::vector<std::vector<std::vector<double>>> _values;
+        std::shared_ptr<utilities::ThreadPool> _threadPool;
     };
 
     /// <summary> Makes an evaluator. </summary>
@@ -189,6 +216,13 @@ namespace evaluators
     {
         static_assert(sizeof...(AggregatorTypes) > 0, "Evaluator must contains at least one aggregator");
 
+        // The calling thread works on a shard too, so the pool needs one thread fewer than requested
+        if (_evaluatorParameters.numThreads != 1)
+        {
+            auto numThreads = _evaluatorParameters.numThreads == 0 ? std::thread::hardware_concurrency() : _evaluatorParameters.numThreads;
+            _threadPool = std::make_shared<utilities::ThreadPool>(std::max<size_t>(numThreads, 2) - 1);
+        }
+
         if (_evaluatorParameters.addZeroEvaluation)
         {
             EvaluateZero();
@@ -204,6 +238,12 @@ namespace evaluators
             return;
         }
 
+        if (_threadPool)
+        {
+            EvaluateShards(predictor);
+            return;
+        }
+
         auto iterator = _dataset.GetExampleReferenceIterator();
 
         while (iterator.IsValid())
@@ -220,6 +260,61 @@ namespace evaluators
         Aggregate(std::make_index_sequence<sizeof...(AggregatorTypes)>());
     }
 
+    template <typename PredictorType, typename... AggregatorTypes>
+    void Evaluator<PredictorType, AggregatorTypes...>::EvaluateShards(const PredictorType& predictor)
+    {
+        // _aggregatorTuple is always in its reset state here, so copies of it are empty aggregators
+        const auto sequence = std::make_index_sequence<sizeof...(AggregatorTypes)>();
+        const auto numExamples = _dataset.NumExamples();
+        const auto numShards = std::min(_threadPool->NumThreads() + 1, std::max<size_t>(numExamples, 1));
+        std::vector<AggregatorTupleType> shards(numShards, _aggregatorTuple);
+        _threadPool->ParallelFor(
+            numShards,
+            [&](size_t shardIndex) {
+                auto& aggregators = shards[shardIndex];
+                auto begin = numExamples * shardIndex / numShards;
+                auto end = numExamples * (shardIndex + 1) / numShards;
+                for (auto index = begin; index < end; ++index)
+                {
+                    const auto& example = _dataset[index];
+                    double prediction = predictor.Predict(example.GetDataVector());
+                    UpdateShard(aggregators, prediction, example.GetMetadata().label, example.GetMetadata().weight, sequence);
+                }
+                FinishShard(aggregators, sequence);
+            },
+            1);
+
+        // Merge in shard order, so the result doesn't depend on thread scheduling
+        for (const auto& shard : shards)
+        {
+            MergeShard(_aggregatorTuple, shard, sequence);
+        }
+        Aggregate(sequence);
+    }
+
+    template <typename PredictorType, typename... AggregatorTypes>
+    template <std::size_t... Sequence>
+    void Evaluator<PredictorType, AggregatorTypes...>::UpdateShard(AggregatorTupleType& aggregators, double prediction, double label, double weight, std::index_sequence<Sequence...>)
+    {
+        (std::get<Sequence>(aggregators).Update(prediction, label, weight), ...);
+    }
+
+    template <typename PredictorType, typename... AggregatorTypes>
+    template <std::size_t... Sequence>
+    void Evaluator<PredictorType, AggregatorTypes...>::FinishShard(const AggregatorTupleType& aggregators, std::index_sequence<Sequence...>)
+    {
+        // Computing each shard's result on its own thread lets aggregators that sort their state (like AUCAggregator)
+        // do the sorting in parallel, leaving only a linear merge for the calling thread
+        ((void)std::get<Sequence>(aggregators).GetResult(), ...);
+    }
+
+    template <typename PredictorType, typename... AggregatorTypes>
+    template <std::size_t... Sequence>
+    void Evaluator<PredictorType, AggregatorTypes...>::MergeShard(AggregatorTupleType& aggregators, const AggregatorTupleType& shardAggregators, std::index_sequence<Sequence...>)
+    {
+        (std::get<Sequence>(aggregators).Merge(std::get<Sequence>(shardAggregators)), ...);
+    }
+
     template <typename PredictorType, typename... AggregatorTypes>
     double Evaluator<PredictorType, AggregatorTypes...>::GetGoodness() const
     {
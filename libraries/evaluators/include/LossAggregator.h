@@ -42,6 +42,11 @@ namespace evaluators
         /// <summary> Resets the aggregator to its initial state. </summary>
         void Reset();
 
+        /// <summary> Adds the weighted losses of another aggregator to this one. </summary>
+        ///
+        /// <param name="other"> The other aggregator. </param>
+        void Merge(const LossAggregator<LossFunctionType>& other);
+
         /// <summary> Gets a header that describes the values of this aggregator. </summary>
         ///
         /// <returns> The header string vector. </returns>
@@ -92,6 +97,13 @@ namespace evaluators
         _sumWeightedLosses = 0.0;
     }
 
+    template <typename LossFunctionType>
+    void LossAggregator<LossFunctionType>::Merge(const LossAggregator<LossFunctionType>& other)
+    {
+        _sumWeights += other._sumWeights;
+        _sumWeightedLosses += other._sumWeightedLosses;
+    }
+
     template <typename LossFunctionType>
     std::vector<std::string> LossAggregator<LossFunctionType>::GetValueNames() const
     {
@@ -17,12 +17,13 @@ namespace evaluators
     void AUCAggregator::Update(double prediction, double label, double weight)
     {
         _aggregates.push_back(Aggregate{ prediction, label, weight });
+        _isSorted = false;
     }
 
     std::vector<double> AUCAggregator::GetResult() const
     {
         // sort aggregates by prediction
-        std::sort(_aggregates.begin(), _aggregates.end());
+        Sort();
 
         // collect statistics
         double sumPositiveWeights = 0.0;
@@ -57,6 +58,24 @@ namespace evaluators
     void AUCAggregator::Reset()
     {
         _aggregates.resize(0);
+        _isSorted = true;
+    }
+
+    void AUCAggregator::Merge(const AUCAggregator& other)
+    {
+        Sort();
+        other.Sort();
+        auto middle = _aggregates.insert(_aggregates.end(), other._aggregates.begin(), other._aggregates.end());
+        std::inplace_merge(_aggregates.begin(), middle, _aggregates.end());
+    }
+
+    void AUCAggregator::Sort() const
+    {
+        if (!_isSorted)
+        {
+            std::sort(_aggregates.begin(), _aggregates.end());
+            _isSorted = true;
+        }
     }
 
     bool AUCAggregator::Aggregate::operator<(const Aggregate& other) const
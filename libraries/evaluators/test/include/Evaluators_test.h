@@ -10,4 +10,5 @@
 namespace ell
 {
 void TestEvaluators();
+void TestParallelEvaluator(size_t numThreads);
 }
\ No newline at end of file
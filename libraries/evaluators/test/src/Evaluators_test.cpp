@@ -21,6 +21,7 @@
 #include <testing/include/testing.h>
 
 #include <iostream>
+#include <random>
 
 namespace ell
 {
@@ -45,4 +46,46 @@ void TestEvaluators()
     std::cout << "Goodness: " << evaluator->GetGoodness() << std::endl;
     testing::ProcessTest("Evaluator sanity check", !testing::IsEqual(evaluator->GetGoodness(), 0.0, 1e-8));
 }
+
+void TestParallelEvaluator(size_t numThreads)
+{
+    // A dataset with many tied predictions, so the AUC depends on how ties are ordered
+    using ExampleType = data::DenseSupervisedDataset::DatasetExampleType;
+    data::DenseSupervisedDataset dataset;
+    std::default_random_engine engine(123);
+    std::uniform_int_distribution<int> featureDistribution(-4, 4);
+    std::bernoulli_distribution labelDistribution(0.4);
+    std::uniform_real_distribution<double> weightDistribution(0.5, 2.0);
+    for (int index = 0; index < 1001; ++index)
+    {
+        double feature = featureDistribution(engine);
+        double label = labelDistribution(engine) ? 1.0 : -1.0;
+        dataset.AddExample(ExampleType{ { feature, 1.0 }, data::WeightLabel{ weightDistribution(engine), label } });
+    }
+
+    predictors::LinearPredictor<double> predictor({ 1.0, 0.5 }, -0.25);
+    auto makeEvaluator = [&](size_t threads) {
+        evaluators::EvaluatorParameters evaluatorParams{ 1, false, threads };
+        return evaluators::MakeEvaluator<predictors::LinearPredictor<double>>(dataset.GetAnyDataset(), evaluatorParams, evaluators::BinaryErrorAggregator(), evaluators::AUCAggregator(), evaluators::MakeLossAggregator(functions::SquaredLoss()));
+    };
+    using EvaluatorType = evaluators::Evaluator<predictors::LinearPredictor<double>, evaluators::BinaryErrorAggregator, evaluators::AUCAggregator, evaluators::LossAggregator<functions::SquaredLoss>>;
+
+    auto serialEvaluator = makeEvaluator(1);
+    auto parallelEvaluator = makeEvaluator(numThreads);
+    serialEvaluator->Evaluate(predictor);
+    parallelEvaluator->Evaluate(predictor);
+    parallelEvaluator->Evaluate(predictor);
+
+    const auto& serialValues = std::dynamic_pointer_cast<EvaluatorType>(serialEvaluator)->GetValues();
+    const auto& parallelValues = std::dynamic_pointer_cast<EvaluatorType>(parallelEvaluator)->GetValues();
+    bool ok = serialValues.size() == 1 && parallelValues.size() == 2;
+    for (size_t evaluation = 0; ok && evaluation < parallelValues.size(); ++evaluation)
+    {
+        for (size_t aggregator = 0; aggregator < serialValues[0].size(); ++aggregator)
+        {
+            ok = ok && testing::IsEqual(serialValues[0][aggregator], parallelValues[evaluation][aggregator], 1e-12);
+        }
+    }
+    testing::ProcessTest("Parallel evaluator matches serial evaluator with " + std::to_string(numThreads) + " threads", ok);
+}
 } // namespace ell
@@ -24,6 +24,8 @@ int main()
     try
     {
         TestEvaluators();
+        TestParallelEvaluator(2);
+        TestParallelEvaluator(4);
     }
     catch (const utilities::Exception& exception)
     {
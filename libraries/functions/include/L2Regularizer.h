@@ -49,6 +49,14 @@ namespace functions
         /// <param name="w"> The output vector. </param>
         /// <param name="b"> [in,out] The output bias term. </param>
         void ConjugateGradient(math::ConstColumnVectorReference<double> v, double d, math::ColumnVectorReference<double> w, double& b) const;
+
+        /// <summary> Computes one coordinate of the conjugate gradient function. The regularizer is separable, so
+        /// coordinate j of the conjugate gradient depends only on coordinate j of v. </summary>
+        ///
+        /// <param name="v"> A coordinate of the point at which the conjugate gradient is computed. </param>
+        ///
+        /// <returns> The corresponding coordinate of the conjugate gradient. </returns>
+        double ConjugateGradient(double v) const { return v; }
     };
 } // namespace functions
 } // namespace ell
\ No newline at end of file
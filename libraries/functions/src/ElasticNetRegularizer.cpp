@@ -77,35 +77,28 @@ namespace functions
     {
         for (size_t j = 0; j < v.Size(); ++j)
         {
-            double z = v[j] - _ratioL1L2;
-            if (z > 0)
-            {
-                w[j] = z;
-                continue;
-            }
-
-            z = v[j] + _ratioL1L2;
-            if (z < 0)
-            {
-                w[j] = z;
-            }
-
-            w[j] = 0;
+            w[j] = ConjugateGradient(v[j]);
         }
     }
 
     void ElasticNetRegularizer::ConjugateGradient(math::ConstColumnVectorReference<double> v, double d, math::ColumnVectorReference<double> w, double& b) const
     {
         ConjugateGradient(v, w);
-        b = d - _ratioL1L2;
-        if (b < 0)
+        b = ConjugateGradient(d);
+    }
+
+    double ElasticNetRegularizer::ConjugateGradient(double v) const
+    {
+        // soft thresholding
+        if (v > _ratioL1L2)
         {
-            b = d + _ratioL1L2;
-            if (b > 0)
-            {
-                b = 0;
-            }
+            return v - _ratioL1L2;
+        }
+        if (v < -_ratioL1L2)
+        {
+            return v + _ratioL1L2;
         }
+        return 0;
     }
 } // namespace functions
 } // namespace ell
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     BatchTransformer.h (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "InputPort.h"
+#include "Map.h"
+#include "Model.h"
+#include "ModelTransformer.h"
+#include "Node.h"
+#include "OutputPort.h"
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace ell
+{
+namespace model
+{
+    /// <summary>
+    /// A class that turns a map that computes one sample into a map that computes a batch of samples at once. Each
+    /// input and output of the batched map holds `batchSize` samples of the original size, stored one after another.
+    ///
+    /// Nodes whose values don't depend on the map's inputs (e.g., the weights) are copied once and shared by the
+    /// whole batch. Nodes that know how to compute a batch at once (see `Node::Batch`) are replaced by their batched
+    /// form, and all other nodes are copied once per sample.
+    /// </summary>
+    class BatchTransformer
+    {
+    public:
+        /// <summary> Returns a batched version of a map. The map must not have any stateful nodes, since the samples
+        /// in a batch are independent of each other. </summary>
+        ///
+        /// <param name="map"> The map to batch. </param>
+        /// <param name="batchSize"> The number of samples the new map computes at once. </param>
+        ///
+        /// <returns> The batched map. </returns>
+        Map Transform(const Map& map, int batchSize);
+
+        /// <summary> Returns the number of samples in a batch </summary>
+        int GetBatchSize() const { return _batchSize; }
+
+        /// <summary> Indicates if the value of an input port is the same for every sample in the batch </summary>
+        bool IsBatchInvariant(const InputPortBase& input) const;
+
+        /// <summary> Returns the port in the new model holding the value of an input port that is the same for every
+        /// sample in the batch (see `IsBatchInvariant`) </summary>
+        const OutputPortBase& GetCorrespondingInputs(const InputPortBase& input);
+
+        /// <summary> Returns the port in the new model holding the value of an input port that is the same for every
+        /// sample in the batch (see `IsBatchInvariant`) </summary>
+        template <typename ValueType>
+        const OutputPort<ValueType>& GetCorrespondingInputs(const InputPort<ValueType>& input);
+
+        /// <summary> Returns a port in the new model holding the values of an input port for all the samples in the
+        /// batch, one after another </summary>
+        const OutputPortBase& GetBatchedInputs(const InputPortBase& input);
+
+        /// <summary> Returns a port in the new model holding the values of an input port for all the samples in the
+        /// batch, one after another </summary>
+        template <typename ValueType>
+        const OutputPort<ValueType>& GetBatchedInputs(const InputPort<ValueType>& input);
+
+        /// <summary> Sets the port in the new model that holds the values of an output port for all the samples in the
+        /// batch, one after another </summary>
+        void MapBatchedNodeOutput(const OutputPortBase& oldPort, const OutputPortBase& newPort);
+
+        /// <summary> Creates a new node in the new model </summary>
+        template <typename NodeType, typename... Args>
+        NodeType* AddNode(Args&&... args);
+
+    private:
+        void TransformNode(const Node& node);
+        void AddBatchedInputNode(const InputNodeBase& node);
+        void AddBatchedOutputNode(const Node& node);
+        void CopyNodePerSample(const Node& node);
+
+        bool IsBatchInvariant(const OutputPortBase& port) const;
+        const OutputPortBase& GetBatchedPort(const OutputPortBase& port);
+        const OutputPortBase& GetSamplePort(const OutputPortBase& port, int sampleIndex);
+
+        int _batchSize = 1;
+        Model _model;
+        ModelTransformer _transformer; // copies the nodes, and holds the new ports of the batch-invariant ones
+        std::unordered_set<const OutputPortBase*> _invariantPorts;
+        std::unordered_map<const OutputPortBase*, const OutputPortBase*> _batchedPorts;
+        std::unordered_map<const OutputPortBase*, std::vector<const OutputPortBase*>> _samplePorts;
+    };
+} // namespace model
+} // namespace ell
+
+#pragma region implementation
+
+namespace ell
+{
+namespace model
+{
+    template <typename ValueType>
+    const OutputPort<ValueType>& BatchTransformer::GetCorrespondingInputs(const InputPort<ValueType>& input)
+    {
+        return static_cast<const OutputPort<ValueType>&>(GetCorrespondingInputs(static_cast<const InputPortBase&>(input)));
+    }
+
+    template <typename ValueType>
+    const OutputPort<ValueType>& BatchTransformer::GetBatchedInputs(const InputPort<ValueType>& input)
+    {
+        return static_cast<const OutputPort<ValueType>&>(GetBatchedInputs(static_cast<const InputPortBase&>(input)));
+    }
+
+    template <typename NodeType, typename... Args>
+    NodeType* BatchTransformer::AddNode(Args&&... args)
+    {
+        return _model.AddNode<NodeType>(std::forward<Args>(args)...);
+    }
+} // namespace model
+} // namespace ell
+
+#pragma endregion implementation
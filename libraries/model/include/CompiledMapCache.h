@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     CompiledMapCache.h (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <emitters/include/IRObjectCache.h>
+
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+
+#include <memory>
+#include <string>
+
+namespace ell
+{
+namespace model
+{
+    /// <summary>
+    /// An on-disk cache of compiled maps. Each entry holds the optimized LLVM bitcode for a map (so the map doesn't have
+    /// to be refined, optimized, and emitted again) and the machine code the JIT generated for it. Entries are keyed by a
+    /// hash of everything that determines the generated code: the serialized map, the compiler options, the target, and
+    /// the LLVM version. The cache directory can be shared by several processes: entries are written to unique temporary
+    /// files and renamed into place, and entries that are truncated or don't match their hash are treated as misses.
+    /// </summary>
+    class CompiledMapCache
+    {
+    public:
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="directory"> The directory to keep the cache entries in. It's created if it doesn't exist. </param>
+        explicit CompiledMapCache(const std::string& directory);
+
+        /// <summary> Returns the cache key for a description of a compilation. </summary>
+        ///
+        /// <param name="description"> A string that uniquely describes the code to be generated. </param>
+        ///
+        /// <returns> The cache key, a hex string suitable for use as a file name. </returns>
+        static std::string GetKey(const std::string& description);
+
+        /// <summary> Loads the bitcode cached for a key. </summary>
+        ///
+        /// <param name="key"> The key, from `GetKey`. </param>
+        /// <param name="context"> The LLVM context to load the module into. </param>
+        ///
+        /// <returns> The cached module, or null if there's no entry for the key or it can't be read. </returns>
+        std::unique_ptr<llvm::Module> LoadBitcode(const std::string& key, llvm::LLVMContext& context) const;
+
+        /// <summary> Adds or replaces the bitcode cached for a key. Failing to write the entry isn't an error. </summary>
+        ///
+        /// <param name="key"> The key, from `GetKey`. </param>
+        /// <param name="module"> The module to save. </param>
+        void SaveBitcode(const std::string& key, const llvm::Module& module) const;
+
+        /// <summary> Returns an object cache for the execution engine that keeps the machine code for a key. </summary>
+        ///
+        /// <param name="key"> The key, from `GetKey`. </param>
+        ///
+        /// <returns> The object cache. </returns>
+        std::shared_ptr<emitters::IRObjectCache> GetObjectCache(const std::string& key) const;
+
+        /// <summary> Returns the cache directory. </summary>
+        const std::string& GetDirectory() const { return _directory; }
+
+    private:
+        std::string GetBitcodeFilePath(const std::string& key) const;
+
+        std::string _directory;
+    };
+} // namespace model
+} // namespace ell
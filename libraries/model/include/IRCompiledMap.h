@@ -18,11 +18,13 @@
 
 #include <emitters/include/IRExecutionEngine.h>
 #include <emitters/include/IRModuleEmitter.h>
+#include <emitters/include/IRObjectCache.h>
 #include <emitters/include/ModuleEmitter.h>
 
 #include <utilities/include/Boolean.h>
 #include <utilities/include/TypeName.h>
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <ostream>
@@ -106,6 +108,14 @@ namespace model
         /// <returns> The jitter. </returns>
         emitters::IRExecutionEngine& GetJitter();
 
+        /// <summary>
+        /// Indicates if this map's code was loaded from the compiled map cache (see `MapCompilerOptions::compiledMapCachePath`)
+        /// instead of being generated: its optimized module, and, once it has been jitted, its machine code.
+        /// </summary>
+        ///
+        /// <returns> true if no code had to be generated for this map. </returns>
+        bool IsLoadedFromCache() const;
+
         //
         // Node profiling support
         //
@@ -200,6 +210,21 @@ namespace model
         /// <param name="outputs"> A vector containing all the output buffers. </param>
         void ComputeMultiple(const std::vector<void*>& inputs, const std::vector<void*>& outputs) override;
 
+        /// <summary> Like ComputeMultiple, but computes a batch of samples in one call. Each input and output
+        /// buffer must hold `batchSize` samples, stored one after another, where a sample is the corresponding port
+        /// size divided by `GetCompiledBatchSize()`. Any number of samples can be passed: the compiled code calls the
+        /// predict function once per group of `GetCompiledBatchSize()` samples, and pads out the last group. When
+        /// the map was compiled for one sample at a time, stateful nodes see the samples as a sequence. </summary>
+        ///
+        /// <param name="inputs"> A vector containing all the input buffers. </param>
+        /// <param name="outputs"> A vector containing all the output buffers. </param>
+        /// <param name="batchSize"> The number of samples in each buffer. </param>
+        void ComputeBatch(const std::vector<void*>& inputs, const std::vector<void*>& outputs, int batchSize);
+
+        /// <summary> Returns the number of samples each call to the compiled predict function computes (see
+        /// `MapCompilerOptions::batchSize`). The sizes of the map's inputs and outputs cover all of them. </summary>
+        int GetCompiledBatchSize() const { return std::max(1, GetMapCompilerOptions().batchSize); }
+
         /// <summary> Reset any model state. </summary>
         void Reset() override;
 
@@ -235,6 +260,8 @@ namespace model
         emitters::IRModuleEmitter& _module;
         std::string _moduleName;
 
+        std::shared_ptr<emitters::IRObjectCache> _objectCache; // machine code cached by `CompiledMapCache`, if any
+        bool _isModuleFromCache = false;
         std::unique_ptr<emitters::IRExecutionEngine> _executionEngine;
         bool _verifyJittedModule = true;
         void* _context = nullptr;
@@ -249,6 +276,7 @@ namespace model
         std::variant<ComputeFunction<bool>, ComputeFunction<int>, ComputeFunction<int64_t>, ComputeFunction<float>, ComputeFunction<double>> _computeInputFunction;
         std::variant<Vector<bool>, Vector<int>, Vector<int64_t>, Vector<float>, Vector<double>> _cachedOutput;
         std::function<void(void*, void* const*, void* const*)> _computeDispatchFunction;
+        std::function<void(void*, void* const*, void* const*, int)> _computeBatchFunction;
         std::function<void()> _resetFunction;
     };
 } // namespace model
@@ -329,6 +357,9 @@ namespace model
             functionPointer = _executionEngine->ResolveFunctionAddress(_functionName + "_dispatch");
             _computeDispatchFunction = reinterpret_cast<void(*)(void*, void* const*, void* const*)>(functionPointer);
 
+            functionPointer = _executionEngine->ResolveFunctionAddress(_moduleName + "_PredictBatch");
+            _computeBatchFunction = reinterpret_cast<void(*)(void*, void* const*, void* const*, int)>(functionPointer);
+
             functionPointer = _executionEngine->ResolveFunctionAddress(_moduleName + "_Reset");
             _resetFunction = reinterpret_cast<void(*)()>(functionPointer);
         }
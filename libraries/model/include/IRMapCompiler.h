@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "CompiledMapCache.h"
 #include "IRCompiledMap.h"
 #include "InputPort.h"
 #include "MapCompiler.h"
@@ -165,13 +166,21 @@ namespace model
         NodeMap<emitters::IRBlockRegion*>& GetCurrentNodeBlocks();
         const Node* GetUniqueParent(const Node& node);
         void RefineAndOptimize(Map& map);
+        void BatchMap(Map& map);
+        std::string GetCompiledMapCacheDescription(const Map& map) const;
+        bool TryLoadCachedModule(const CompiledMapCache& cache, const std::string& key);
+        void PlanPortMemory();
         bool TryMergeNodeIntoRegion(emitters::IRBlockRegion* pDestination, const Node& src);
 
         void EmitPredictDispatchFunction(const Map& map);
+        // Emits <prefix>_PredictBatch, which computes any number of samples by calling the predict function on
+        // groups of `MapCompilerOptions::batchSize` samples
+        void EmitPredictBatchFunction(const Map& map);
         void EmitGetInputSizeFunction(const Map& map);
         void EmitGetOutputSizeFunction(const Map& map);
         void EmitGetSinkOutputSizeFunction(const Map& map);
         void EmitGetNumNodesFunction(const Map& map);
+        void EmitGetScratchSizeFunction();
         void EmitSizeConditionals(emitters::IRFunctionEmitter& fn, std::vector<int> sizes);
 
         void EmitShapeEnum();
@@ -185,6 +194,10 @@ namespace model
 
         // stack of node regions
         std::vector<NodeMap<emitters::IRBlockRegion*>> _nodeRegions;
+
+        // top-level nodes in the order their code executes, used to compute port buffer lifetimes
+        std::vector<const Node*> _compiledNodes;
+        size_t _scratchSize = 0;
     };
 } // namespace model
 } // namespace ell
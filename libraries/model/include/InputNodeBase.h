@@ -92,6 +92,8 @@ namespace model
         /// <param name="name"> The callback name to set. </param>
         void SetCallbackName(const std::string& name) { _callbackName = name; };
 
+        bool IsStateful() const override { return true; } // gets its data from a callback
+
     protected:
         // Note: Source nodes still receive timestamps as input, even though data is retrieved through callbacks.
         // Therefore, they have input ports.
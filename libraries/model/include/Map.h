@@ -29,6 +29,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -40,6 +41,7 @@ namespace model
 {
     class ModelTransformer;
     class OutputNodeBase;
+    class ParallelModelExecutor;
     class TransformContext;
 
     enum class InputMethod
@@ -94,6 +96,22 @@ namespace model
         /// <summary> Gets the submodel wrapped by this map </summary>
         Submodel GetSubmodel();
 
+        /// <summary>
+        /// Computes independent branches of the model on multiple threads in subsequent calls to `Compute`.
+        /// Nodes are dispatched to a thread pool as soon as the nodes they depend on have been computed.
+        /// </summary>
+        ///
+        /// <param name="numThreads"> The number of worker threads to use. If zero, uses the hardware concurrency of the machine. </param>
+        void EnableParallelCompute(size_t numThreads = 0);
+
+        /// <summary> Goes back to computing the model's nodes one at a time, on the calling thread. </summary>
+        void DisableParallelCompute();
+
+        /// <summary> Indicates if the map computes its model on multiple threads. </summary>
+        ///
+        /// <returns> `true` if `EnableParallelCompute` has been called. </returns>
+        bool IsParallelComputeEnabled() const { return _parallelExecutor != nullptr; }
+
         /// <summary> Computes the map's output from input values </summary>
         ///
         /// <param name="inputValues"> The input to the map </param>
@@ -465,6 +483,9 @@ namespace model
         std::vector<const Node*> GetMatchingNodesByType(const std::string name) const;
         void FixTransformedIO(ModelTransformer& transformer);
 
+        template <typename ValueType>
+        std::vector<ValueType> ComputeModelOutput(const PortElementsBase& outputs);
+
         Model _model;
 
         std::vector<InputNodeBase*> _inputNodes;
@@ -477,6 +498,7 @@ namespace model
         utilities::PropertyBag _metadata;
 
         value::ComputeContext _computeContext{ "map_compute" };
+        std::shared_ptr<ParallelModelExecutor> _parallelExecutor;
     };
 
     /// <summary> A serialization context used during Map deserialization. Wraps an existing `ModelSerializationContext` </summary>
@@ -12,6 +12,7 @@
 #include "MapCompilerOptions.h"
 #include "ModelOptimizerOptions.h"
 #include "OutputPort.h"
+#include "TuningCache.h"
 
 #include <emitters/include/CompilerOptions.h>
 #include <emitters/include/EmitterTypes.h>
@@ -80,6 +81,11 @@ namespace model
         /// <returns> The ModelOptimizerOptions struct used by the map compiler to control code generation. </returns>
         ModelOptimizerOptions GetModelOptimizerOptions(const Node& node) const;
 
+        /// <summary> Gets the tuned schedule parameters loaded from `MapCompilerOptions::tuningCachePath`. </summary>
+        ///
+        /// <returns> The tuning cache, which is empty if no cache file was specified. </returns>
+        const TuningCache& GetTuningCache() const { return _tuningCache; }
+
         //
         // Routines for Node implementers
         //
@@ -149,6 +155,7 @@ namespace model
 
         MapCompilerOptions _parameters;
         ModelOptimizerOptions _optimizerOptions;
+        TuningCache _tuningCache;
 
         // map from ports to runtime variables, for all ports in the model
         // stored as a stack, with the top of the stack being the innermost scope
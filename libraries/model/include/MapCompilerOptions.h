@@ -36,6 +36,10 @@ namespace model
         std::string sinkFunctionName;
         bool verifyJittedModule = true;
         bool profile = false;
+        bool reusePortMemory = false; // pack intermediate port buffers with disjoint lifetimes into a shared arena
+        std::string tuningCachePath; // file of tuned schedule parameters to use when refining nodes (see `TuningCache`)
+        std::string compiledMapCachePath; // directory of previously compiled maps to reuse (see `CompiledMapCache`)
+        int batchSize = 1; // number of samples the predict function computes in one call (see `BatchTransformer`)
 
         // per-node options
         bool inlineNodes = false;
@@ -22,6 +22,7 @@ namespace ell
 /// <summary> model namespace </summary>
 namespace model
 {
+    class BatchTransformer;
     class InputPortBase;
     class MapCompiler;
     class Model;
@@ -173,6 +174,10 @@ namespace model
         /// <summary> Resets any state on the node, if any </summary>
         virtual void Reset() {}
 
+        /// <summary> Indicates if this node's output depends on more than its current input values, because it keeps
+        /// state between calls or interacts with the outside world. Such nodes can't be evaluated ahead of time. </summary>
+        virtual bool IsStateful() const { return false; }
+
         /// <summary> Get this object's metadata object. </summary>
         ///
         /// <returns> A reference to the PropertyBag containing the metadata for this object. </returns>
@@ -204,12 +209,14 @@ namespace model
         void ReadFromArchive(utilities::Unarchiver& archiver) override = 0;
 
     private:
+        friend class BatchTransformer;
         friend class Model;
         friend class ModelEditor;
         friend class ModelTransformer;
 
         virtual void Copy(ModelTransformer& transformer) const = 0;
         virtual bool Refine(ModelTransformer& transformer) const;
+        virtual bool Batch(BatchTransformer& transformer) const;
 
         void SetId(Node::NodeId id);
         void SetModel(Model* model);
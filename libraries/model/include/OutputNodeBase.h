@@ -86,6 +86,8 @@ namespace model
         /// <param name="name"> The callback name to set. </param>
         void SetCallbackName(const std::string& name) { _callbackName = name; };
 
+        bool IsStateful() const override { return true; } // passes its data to a callback
+
     protected:
         SinkNodeBase(InputPortBase& input, InputPortBase& trigger, OutputPortBase& output, const MemoryShape& shape, const std::string& callbackName) :
             OutputNodeBase({ &input, &trigger }, output, shape),
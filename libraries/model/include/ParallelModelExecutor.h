@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ParallelModelExecutor.h (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Model.h"
+#include "OutputPort.h"
+#include "PortElements.h"
+
+#include <utilities/include/ThreadPool.h>
+
+#include <cstddef>
+#include <unordered_set>
+#include <vector>
+
+namespace ell
+{
+namespace model
+{
+    /// <summary>
+    /// Computes the nodes of a model on a pool of threads. The nodes needed for a set of outputs form a
+    /// dependency graph, and each node is computed as soon as all of the nodes it reads from have finished,
+    /// so independent branches of the model run at the same time. Nodes that are implemented with the
+    /// value library share a single compute context, so those are still computed one at a time.
+    /// </summary>
+    class ParallelModelExecutor
+    {
+    public:
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="numThreads"> The number of worker threads to use. If zero, uses the hardware concurrency of the machine. </param>
+        explicit ParallelModelExecutor(size_t numThreads = 0);
+
+        /// <summary> Returns the number of worker threads used to compute nodes. </summary>
+        ///
+        /// <returns> The number of worker threads. </returns>
+        size_t NumThreads() const { return _threadPool.NumThreads(); }
+
+        /// <summary> Computes all the nodes the given outputs depend on. </summary>
+        ///
+        /// <param name="model"> The model to compute. </param>
+        /// <param name="outputs"> The output ports to compute. </param>
+        void ComputeNodes(const Model& model, const std::vector<const OutputPortBase*>& outputs);
+
+        /// <summary> Computes the nodes the given elements depend on, and returns the values of the elements. </summary>
+        ///
+        /// <param name="model"> The model to compute. </param>
+        /// <param name="elements"> The elements to compute. </param>
+        ///
+        /// <returns> The computed values of the elements. </returns>
+        template <typename ValueType>
+        std::vector<ValueType> ComputeOutput(const Model& model, const PortElementsBase& elements);
+
+    private:
+        utilities::ThreadPool _threadPool;
+    };
+} // namespace model
+} // namespace ell
+
+#pragma region implementation
+
+namespace ell
+{
+namespace model
+{
+    template <typename ValueType>
+    std::vector<ValueType> ParallelModelExecutor::ComputeOutput(const Model& model, const PortElementsBase& elements)
+    {
+        auto typedElements = PortElements<ValueType>(elements);
+        std::unordered_set<const OutputPortBase*> usedPorts;
+        for (const auto& range : typedElements.GetRanges())
+        {
+            usedPorts.insert(range.ReferencedPort());
+        }
+
+        ComputeNodes(model, std::vector<const OutputPortBase*>(usedPorts.begin(), usedPorts.end()));
+
+        auto numElements = typedElements.Size();
+        std::vector<ValueType> result(numElements);
+        for (size_t index = 0; index < numElements; ++index)
+        {
+            auto element = typedElements.GetElement(index);
+            result[index] = element.ReferencedPort()->GetOutput()[element.GetIndex()];
+        }
+        return result;
+    }
+} // namespace model
+} // namespace ell
+
+#pragma endregion implementation
@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     PortMemoryPlanner.h (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace ell
+{
+namespace model
+{
+    /// <summary>
+    /// Assigns offsets within a single shared memory arena to a set of buffers with known lifetimes.
+    /// Buffers whose lifetimes don't overlap may be assigned overlapping memory. Lifetimes are
+    /// specified as closed intervals of execution steps, so a buffer that dies at step `i` never shares
+    /// memory with a buffer that is born at step `i`.
+    /// </summary>
+    class PortMemoryPlanner
+    {
+    public:
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="alignment"> The byte alignment of every buffer placed in the arena. </param>
+        explicit PortMemoryPlanner(size_t alignment = 1);
+
+        /// <summary> Adds a buffer to be placed in the arena. </summary>
+        ///
+        /// <param name="size"> The size of the buffer, in bytes. </param>
+        /// <param name="firstUse"> The first execution step that writes or reads the buffer. </param>
+        /// <param name="lastUse"> The last execution step that writes or reads the buffer. </param>
+        ///
+        /// <returns> The index of the buffer, used to query its offset after planning. </returns>
+        size_t AddBuffer(size_t size, int firstUse, int lastUse);
+
+        /// <summary> Assigns arena offsets to all the buffers, using a greedy best-fit strategy. </summary>
+        void Plan();
+
+        /// <summary> Returns the number of buffers added to the planner. </summary>
+        ///
+        /// <returns> The number of buffers. </returns>
+        size_t NumBuffers() const { return _buffers.size(); }
+
+        /// <summary> Returns the arena offset for a buffer. Must be called after `Plan`. </summary>
+        ///
+        /// <param name="bufferIndex"> The index of the buffer, as returned by `AddBuffer`. </param>
+        ///
+        /// <returns> The offset of the buffer in the arena, in bytes. </returns>
+        size_t GetOffset(size_t bufferIndex) const;
+
+        /// <summary> Returns the total size of the arena needed to hold all the buffers. Must be called after `Plan`. </summary>
+        ///
+        /// <returns> The arena size, in bytes. </returns>
+        size_t GetArenaSize() const;
+
+        /// <summary> Returns the memory that would be needed if every buffer got its own memory. </summary>
+        ///
+        /// <returns> The sum of the (aligned) sizes of all buffers, in bytes. </returns>
+        size_t GetTotalBufferSize() const;
+
+    private:
+        struct Buffer
+        {
+            size_t size;
+            int firstUse;
+            int lastUse;
+            size_t offset;
+        };
+
+        static bool LifetimesOverlap(const Buffer& a, const Buffer& b);
+        size_t AlignSize(size_t size) const;
+
+        size_t _alignment;
+        std::vector<Buffer> _buffers;
+        size_t _arenaSize = 0;
+        bool _isPlanned = false;
+    };
+} // namespace model
+} // namespace ell
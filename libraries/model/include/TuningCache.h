@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     TuningCache.h (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <emitters/include/TargetDevice.h>
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace model
+{
+    /// <summary>
+    /// A persistent table of tuned schedule parameters (e.g., tile sizes), keyed by node type, problem shape, and
+    /// target device. Entries are written by a tuner that times candidate schedules, and read back by nodes when the
+    /// map compiler refines them.
+    /// </summary>
+    class TuningCache
+    {
+    public:
+        /// <summary> Default constructor. Creates an empty cache. </summary>
+        TuningCache() = default;
+
+        /// <summary> Returns the key for a node type and problem shape on a particular target. </summary>
+        ///
+        /// <param name="nodeType"> The name of the node type being tuned. </param>
+        /// <param name="shape"> The sizes that define the problem (e.g., m, n, and k for a matrix multiplication). </param>
+        /// <param name="target"> The target device the schedule is tuned for. </param>
+        ///
+        /// <returns> The cache key. </returns>
+        static std::string GetKey(const std::string& nodeType, const std::vector<int>& shape, const emitters::TargetDevice& target);
+
+        /// <summary> Looks up the parameters stored for a key. </summary>
+        ///
+        /// <param name="key"> The key, from `GetKey`. </param>
+        /// <param name="parameters"> Receives the stored parameters, if there are any. </param>
+        ///
+        /// <returns> `true` if the cache has an entry for the key. </returns>
+        bool TryGetParameters(const std::string& key, std::vector<int>& parameters) const;
+
+        /// <summary> Adds or replaces the parameters stored for a key. </summary>
+        ///
+        /// <param name="key"> The key, from `GetKey`. </param>
+        /// <param name="parameters"> The parameters to store. </param>
+        void SetParameters(const std::string& key, const std::vector<int>& parameters);
+
+        /// <summary> Indicates if the cache has an entry for a key. </summary>
+        bool HasEntry(const std::string& key) const { return _entries.find(key) != _entries.end(); }
+
+        /// <summary> Returns the number of entries in the cache. </summary>
+        size_t Size() const { return _entries.size(); }
+
+        /// <summary> Reads cache entries from a stream, adding them to (or replacing) the existing ones. </summary>
+        void Read(std::istream& stream);
+
+        /// <summary> Writes the cache to a stream, one entry per line. </summary>
+        void Write(std::ostream& stream) const;
+
+        /// <summary> Loads a cache from a file. A file that doesn't exist yet results in an empty cache. </summary>
+        ///
+        /// <param name="filename"> The name of the cache file. </param>
+        ///
+        /// <returns> The cache. </returns>
+        static TuningCache Load(const std::string& filename);
+
+        /// <summary> Saves the cache to a file. </summary>
+        ///
+        /// <param name="filename"> The name of the cache file. </param>
+        void Save(const std::string& filename) const;
+
+    private:
+        std::map<std::string, std::vector<int>> _entries;
+    };
+} // namespace model
+} // namespace ell
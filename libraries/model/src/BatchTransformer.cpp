@@ -0,0 +1,317 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     BatchTransformer.cpp (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "BatchTransformer.h"
+#include "InputNode.h"
+#include "InputNodeBase.h"
+#include "OutputNode.h"
+#include "OutputNodeBase.h"
+#include "PortElements.h"
+#include "Submodel.h"
+#include "TransformContext.h"
+
+#include <utilities/include/Exception.h>
+
+#include <algorithm>
+#include <string>
+
+namespace ell
+{
+namespace model
+{
+    namespace
+    {
+        template <typename ValueType>
+        const OutputPortBase& AddInputNode(Model& model, const PortMemoryLayout& layout)
+        {
+            return model.AddNode<InputNode<ValueType>>(layout)->output;
+        }
+
+        template <typename ValueType>
+        const OutputPortBase& AddOutputNode(Model& model, const OutputPortBase& input)
+        {
+            return model.AddNode<OutputNode<ValueType>>(static_cast<const OutputPort<ValueType>&>(input))->output;
+        }
+    } // namespace
+
+    Map BatchTransformer::Transform(const Map& map, int batchSize)
+    {
+        if (batchSize < 1)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Batch size must be positive");
+        }
+
+        _batchSize = batchSize;
+        _model = Model();
+        _transformer = ModelTransformer();
+        _invariantPorts.clear();
+        _batchedPorts.clear();
+        _samplePorts.clear();
+
+        std::vector<const OutputPortBase*> outputs;
+        for (size_t index = 0; index < map.NumOutputs(); ++index)
+        {
+            outputs.push_back(&map.GetOutput(index));
+        }
+        std::unordered_set<const OutputPortBase*> outputSet(outputs.begin(), outputs.end());
+
+        Submodel submodel(outputs);
+        _transformer.TransformSubmodelOnto(submodel, _model, {}, TransformContext{}, [this, &outputSet](const Node& node, ModelTransformer&) {
+            TransformNode(node);
+
+            // The transformer needs a port for each of the submodel's outputs. The samples all have the shape of
+            // the original output, so give it the first one.
+            for (auto output : node.GetOutputPorts())
+            {
+                if (outputSet.find(output) != outputSet.end())
+                {
+                    _transformer.MapNodeOutput(*output, GetSamplePort(*output, 0));
+                }
+            }
+        });
+
+        std::vector<std::pair<std::string, InputNodeBase*>> newInputs;
+        for (size_t index = 0; index < map.NumInputs(); ++index)
+        {
+            auto inputNode = map.GetInput(index);
+            if (_batchedPorts.find(&inputNode->GetOutputPort()) == _batchedPorts.end())
+            {
+                // The input isn't used by any of the outputs, but the map still needs it
+                AddBatchedInputNode(*inputNode);
+            }
+            auto newInputNode = static_cast<const InputNodeBase*>(_batchedPorts[&inputNode->GetOutputPort()]->GetNode());
+            newInputs.emplace_back(map.GetInputName(index), const_cast<InputNodeBase*>(newInputNode));
+        }
+
+        std::vector<std::pair<std::string, const OutputPortBase&>> newOutputs;
+        for (size_t index = 0; index < map.NumOutputs(); ++index)
+        {
+            newOutputs.emplace_back(map.GetOutputName(index), GetBatchedPort(map.GetOutput(index)));
+        }
+
+        return Map(std::move(_model), newInputs, newOutputs);
+    }
+
+    bool BatchTransformer::IsBatchInvariant(const InputPortBase& input) const
+    {
+        return IsBatchInvariant(input.GetReferencedPort());
+    }
+
+    const OutputPortBase& BatchTransformer::GetCorrespondingInputs(const InputPortBase& input)
+    {
+        if (!IsBatchInvariant(input))
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Input port " + input.GetName() + " has a different value for each sample in the batch");
+        }
+        return _transformer.GetCorrespondingOutputs(input.GetReferencedPort());
+    }
+
+    const OutputPortBase& BatchTransformer::GetBatchedInputs(const InputPortBase& input)
+    {
+        return GetBatchedPort(input.GetReferencedPort());
+    }
+
+    void BatchTransformer::MapBatchedNodeOutput(const OutputPortBase& oldPort, const OutputPortBase& newPort)
+    {
+        if (newPort.Size() != oldPort.Size() * _batchSize)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "Batched port " + oldPort.GetName() + " must hold " + std::to_string(_batchSize) + " samples");
+        }
+        _batchedPorts[&oldPort] = &newPort;
+    }
+
+    void BatchTransformer::TransformNode(const Node& node)
+    {
+        // The samples in a batch are computed at the same time, so a node can't carry state from one to the next
+        if (node.IsStateful())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Can't batch a map with a stateful node (" + node.GetRuntimeTypeName() + ")");
+        }
+
+        if (auto inputNode = dynamic_cast<const InputNodeBase*>(&node))
+        {
+            AddBatchedInputNode(*inputNode);
+            return;
+        }
+
+        const auto& inputs = node.GetInputPorts();
+        if (std::all_of(inputs.begin(), inputs.end(), [this](const InputPortBase* input) { return IsBatchInvariant(*input); }))
+        {
+            // e.g., constants: one copy serves all the samples
+            _transformer.CopyNode(node);
+            for (auto output : node.GetOutputPorts())
+            {
+                _invariantPorts.insert(output);
+            }
+            return;
+        }
+
+        if (dynamic_cast<const OutputNodeBase*>(&node) != nullptr)
+        {
+            AddBatchedOutputNode(node);
+            return;
+        }
+
+        if (!node.Batch(*this))
+        {
+            CopyNodePerSample(node);
+            return;
+        }
+
+        for (auto output : node.GetOutputPorts())
+        {
+            if (_batchedPorts.find(output) == _batchedPorts.end())
+            {
+                throw utilities::LogicException(utilities::LogicExceptionErrors::illegalState, "Node " + node.GetRuntimeTypeName() + " didn't map all its outputs when batched");
+            }
+        }
+    }
+
+    void BatchTransformer::AddBatchedInputNode(const InputNodeBase& node)
+    {
+        // Stack the samples along the slowest-moving dimension, so each one can be sliced back out with its
+        // original layout
+        auto layout = node.GetMemoryLayout();
+        if (layout.HasPadding())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Can't batch an input with padding");
+        }
+        auto shape = layout.GetActiveSize();
+        shape[0] *= _batchSize;
+        PortMemoryLayout batchedLayout(shape, layout.GetLogicalDimensionOrder());
+
+        const OutputPortBase* port = nullptr;
+        switch (node.GetOutputType())
+        {
+        case Port::PortType::boolean:
+            port = &AddInputNode<bool>(_model, batchedLayout);
+            break;
+        case Port::PortType::integer:
+            port = &AddInputNode<int>(_model, batchedLayout);
+            break;
+        case Port::PortType::bigInt:
+            port = &AddInputNode<int64_t>(_model, batchedLayout);
+            break;
+        case Port::PortType::smallReal:
+            port = &AddInputNode<float>(_model, batchedLayout);
+            break;
+        case Port::PortType::real:
+            port = &AddInputNode<double>(_model, batchedLayout);
+            break;
+        default:
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+        }
+        MapBatchedNodeOutput(node.GetOutputPort(), *port);
+    }
+
+    void BatchTransformer::AddBatchedOutputNode(const Node& node)
+    {
+        const auto& input = GetBatchedInputs(*node.GetInputPort(0));
+        const OutputPortBase* port = nullptr;
+        switch (input.GetType())
+        {
+        case Port::PortType::boolean:
+            port = &AddOutputNode<bool>(_model, input);
+            break;
+        case Port::PortType::integer:
+            port = &AddOutputNode<int>(_model, input);
+            break;
+        case Port::PortType::bigInt:
+            port = &AddOutputNode<int64_t>(_model, input);
+            break;
+        case Port::PortType::smallReal:
+            port = &AddOutputNode<float>(_model, input);
+            break;
+        case Port::PortType::real:
+            port = &AddOutputNode<double>(_model, input);
+            break;
+        default:
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+        }
+        MapBatchedNodeOutput(*node.GetOutputPort(0), *port);
+    }
+
+    void BatchTransformer::CopyNodePerSample(const Node& node)
+    {
+        const auto& outputs = node.GetOutputPorts();
+        std::vector<std::vector<const OutputPortBase*>> newOutputs(outputs.size());
+        for (int sampleIndex = 0; sampleIndex < _batchSize; ++sampleIndex)
+        {
+            for (auto input : node.GetInputPorts())
+            {
+                const auto& referencedPort = input->GetReferencedPort();
+                _transformer.MapNodeOutput(referencedPort, GetSamplePort(referencedPort, sampleIndex));
+            }
+
+            _transformer.CopyNode(node);
+            for (size_t index = 0; index < outputs.size(); ++index)
+            {
+                newOutputs[index].push_back(&_transformer.GetCorrespondingOutputs(*outputs[index]));
+            }
+        }
+
+        for (size_t index = 0; index < outputs.size(); ++index)
+        {
+            _samplePorts[outputs[index]] = std::move(newOutputs[index]);
+        }
+    }
+
+    bool BatchTransformer::IsBatchInvariant(const OutputPortBase& port) const
+    {
+        return _invariantPorts.find(&port) != _invariantPorts.end();
+    }
+
+    const OutputPortBase& BatchTransformer::GetBatchedPort(const OutputPortBase& port)
+    {
+        auto it = _batchedPorts.find(&port);
+        if (it != _batchedPorts.end())
+        {
+            return *it->second;
+        }
+
+        // Concatenate the samples
+        std::vector<PortRange> ranges;
+        for (int sampleIndex = 0; sampleIndex < _batchSize; ++sampleIndex)
+        {
+            ranges.emplace_back(GetSamplePort(port, sampleIndex));
+        }
+        const auto& batchedPort = _model.SimplifyOutputs(PortElementsBase(ranges));
+        _batchedPorts[&port] = &batchedPort;
+        return batchedPort;
+    }
+
+    const OutputPortBase& BatchTransformer::GetSamplePort(const OutputPortBase& port, int sampleIndex)
+    {
+        if (IsBatchInvariant(port))
+        {
+            return _transformer.GetCorrespondingOutputs(port);
+        }
+
+        auto it = _samplePorts.find(&port);
+        if (it == _samplePorts.end())
+        {
+            // Slice the samples out of the batch
+            auto batchedIt = _batchedPorts.find(&port);
+            if (batchedIt == _batchedPorts.end())
+            {
+                throw utilities::LogicException(utilities::LogicExceptionErrors::illegalState, "Port " + port.GetName() + " hasn't been batched yet");
+            }
+
+            const auto& batchedPort = *batchedIt->second;
+            auto size = port.Size();
+            std::vector<const OutputPortBase*> samplePorts;
+            for (int index = 0; index < _batchSize; ++index)
+            {
+                samplePorts.push_back(&_model.SimplifyOutputs(PortElementsBase(batchedPort, index * size, size)));
+            }
+            it = _samplePorts.emplace(&port, std::move(samplePorts)).first;
+        }
+        return *it->second[sampleIndex];
+    }
+} // namespace model
+} // namespace ell
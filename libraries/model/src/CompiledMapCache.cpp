@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     CompiledMapCache.cpp (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "CompiledMapCache.h"
+
+#include <emitters/include/IRObjectCache.h>
+
+#include <utilities/include/Files.h>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+namespace ell
+{
+namespace model
+{
+    CompiledMapCache::CompiledMapCache(const std::string& directory) :
+        _directory(directory)
+    {
+        utilities::EnsureDirectoryExists(_directory);
+    }
+
+    std::string CompiledMapCache::GetKey(const std::string& description)
+    {
+        llvm::MD5 hash;
+        hash.update(description);
+        llvm::MD5::MD5Result result;
+        hash.final(result);
+
+        llvm::SmallString<32> key;
+        llvm::MD5::stringifyResult(result, key);
+        return key.str().str();
+    }
+
+    std::unique_ptr<llvm::Module> CompiledMapCache::LoadBitcode(const std::string& key, llvm::LLVMContext& context) const
+    {
+        // A missing, damaged, or unreadable entry is treated as a miss, and gets replaced when the map is compiled
+        auto buffer = emitters::ReadCacheFile(GetBitcodeFilePath(key));
+        if (!buffer)
+        {
+            return nullptr;
+        }
+
+        auto module = llvm::parseBitcodeFile(buffer->getMemBufferRef(), context);
+        if (!module)
+        {
+            llvm::consumeError(module.takeError());
+            return nullptr;
+        }
+        return std::move(module.get());
+    }
+
+    void CompiledMapCache::SaveBitcode(const std::string& key, const llvm::Module& module) const
+    {
+        llvm::SmallVector<char, 0> bitcode;
+        llvm::raw_svector_ostream stream(bitcode);
+        llvm::WriteBitcodeToFile(module, stream);
+        emitters::WriteCacheFile(GetBitcodeFilePath(key), llvm::StringRef(bitcode.data(), bitcode.size()));
+    }
+
+    std::shared_ptr<emitters::IRObjectCache> CompiledMapCache::GetObjectCache(const std::string& key) const
+    {
+        return std::make_shared<emitters::IRObjectCache>(_directory, key);
+    }
+
+    std::string CompiledMapCache::GetBitcodeFilePath(const std::string& key) const
+    {
+        return utilities::JoinPaths(_directory, key + ".bc");
+    }
+} // namespace model
+} // namespace ell
@@ -45,6 +45,8 @@ namespace model
         CompiledMap(std::move(other)),
         _module(other._module),
         _moduleName(std::move(other._moduleName)),
+        _objectCache(std::move(other._objectCache)),
+        _isModuleFromCache(other._isModuleFromCache),
         _executionEngine(std::move(other._executionEngine)),
         _verifyJittedModule(other._verifyJittedModule),
         _context(other._context),
@@ -74,6 +76,8 @@ namespace model
 
         Map newMap(*this);
         IRCompiledMap result(std::move(newMap), GetFunctionName(), GetMapCompilerOptions(), _module, _verifyJittedModule);
+        result._objectCache = _objectCache;
+        result._isModuleFromCache = _isModuleFromCache;
         result.SetContext(GetContext());
         result.FinishJitting();
         return result;
@@ -90,12 +94,21 @@ namespace model
         return *_executionEngine;
     }
 
+    bool IRCompiledMap::IsLoadedFromCache() const
+    {
+        if (!_isModuleFromCache || !_objectCache)
+        {
+            return false;
+        }
+        return !_executionEngine || !_objectCache->WasObjectCompiled();
+    }
+
     void IRCompiledMap::EnsureExecutionEngine()
     {
         if (!_executionEngine)
         {
             auto moduleClone = std::unique_ptr<llvm::Module>(llvm::CloneModule(*_module.GetLLVMModule()));
-            _executionEngine = std::make_unique<emitters::IRExecutionEngine>(std::move(moduleClone), _verifyJittedModule);
+            _executionEngine = std::make_unique<emitters::IRExecutionEngine>(std::move(moduleClone), _verifyJittedModule, llvm::CodeGenOpt::Level::Default, _objectCache);
         }
     }
 
@@ -112,6 +125,21 @@ namespace model
         _computeDispatchFunction(InternalGetContext(), inputs.data(), outputs.data());
     }
 
+    void IRCompiledMap::ComputeBatch(const std::vector<void*>& inputs, const std::vector<void*>& outputs, int batchSize)
+    {
+        if (inputs.size() != NumInputs() || outputs.size() != NumOutputs())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "ComputeBatch needs one buffer per map input and output");
+        }
+        if (batchSize < 0)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Batch size must not be negative");
+        }
+
+        FinishJitting();
+        _computeBatchFunction(InternalGetContext(), inputs.data(), outputs.data(), batchSize);
+    }
+
     void IRCompiledMap::Reset()
     {
         FinishJitting();
@@ -7,12 +7,14 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "IRMapCompiler.h"
+#include "BatchTransformer.h"
 #include "CompilableNode.h"
 #include "CompilableNodeUtilities.h"
 #include "IRModelProfiler.h"
 #include "Model.h"
 #include "OptimizeModelTransformation.h"
 #include "OutputNode.h"
+#include "PortMemoryPlanner.h"
 #include "RefineTransformation.h"
 
 #include <emitters/include/EmitterException.h>
@@ -23,13 +25,22 @@
 #include <nodes/include/SinkNode.h>
 #include <nodes/include/SourceNode.h>
 
+#include <utilities/include/JsonArchiver.h>
 #include <utilities/include/Logger.h>
 #include <utilities/include/StringUtil.h>
 
 #include <value/include/LLVMContext.h>
 
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Linker/Linker.h>
+
+#include <algorithm>
 #include <memory>
+#include <optional>
+#include <sstream>
 #include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace ell
@@ -73,7 +84,33 @@ namespace model
     {
         Log() << "Compile called for map" << EOL;
 
+        // The profiler keeps per-node state in the compiler, so profiled maps aren't cached
+        std::optional<CompiledMapCache> cache;
+        std::string cacheKey;
+        if (!GetMapCompilerOptions().compiledMapCachePath.empty() && !GetMapCompilerOptions().profile)
+        {
+            cache.emplace(GetMapCompilerOptions().compiledMapCachePath);
+            cacheKey = CompiledMapCache::GetKey(GetCompiledMapCacheDescription(map));
+            if (TryLoadCachedModule(*cache, cacheKey))
+            {
+                Log() << "Loaded compiled map from cache entry " << cacheKey << EOL;
+                if (GetMapCompilerOptions().batchSize > 1)
+                {
+                    // The cached code computes a batch per call, so the compiled map needs the batched inputs and outputs
+                    BatchMap(map);
+                }
+                IRCompiledMap result(std::move(map), GetMapCompilerOptions().mapFunctionName, GetMapCompilerOptions(), _moduleEmitter, GetMapCompilerOptions().verifyJittedModule);
+                result._objectCache = cache->GetObjectCache(cacheKey);
+                result._isModuleFromCache = true;
+                return result;
+            }
+        }
+
         RefineAndOptimize(map);
+        if (GetMapCompilerOptions().batchSize > 1)
+        {
+            BatchMap(map);
+        }
 
         // Renaming callbacks based on map compiler parameters
         // Note: a more elegant solution is emit variables which get assigned to
@@ -98,6 +135,12 @@ namespace model
             CompileMap(map, GetPredictFunctionName());
         }
 
+        if (GetMapCompilerOptions().reusePortMemory)
+        {
+            Log() << "Planning port memory..." << EOL;
+            PlanPortMemory();
+        }
+
         // Emit runtime model APIs
         EmitModelAPIFunctions(map);
 
@@ -123,7 +166,105 @@ namespace model
                 _moduleEmitter.IncludeInCallbackInterface(functionName, std::get<2>(savedCallback)[0]);
             }
         }
-        return IRCompiledMap(std::move(map), GetMapCompilerOptions().mapFunctionName, GetMapCompilerOptions(), _moduleEmitter, GetMapCompilerOptions().verifyJittedModule);
+
+        IRCompiledMap result(std::move(map), GetMapCompilerOptions().mapFunctionName, GetMapCompilerOptions(), _moduleEmitter, GetMapCompilerOptions().verifyJittedModule);
+        if (cache)
+        {
+            // Callbacks are registered with the compiler while the map is compiled, so maps that use them can't be
+            // loaded from the cache
+            if (emitters::GetFunctionsWithTag(_moduleEmitter, emitters::c_callbackFunctionTagName).empty())
+            {
+                Log() << "Saving compiled map to cache entry " << cacheKey << EOL;
+                cache->SaveBitcode(cacheKey, *_moduleEmitter.GetLLVMModule());
+            }
+            result._objectCache = cache->GetObjectCache(cacheKey);
+        }
+        return result;
+    }
+
+    std::string IRMapCompiler::GetCompiledMapCacheDescription(const Map& map) const
+    {
+        // Everything that affects the generated code. The compiler options come from the module emitter, where the
+        // target device has been filled in (e.g., "host" resolved to a triple, cpu, and features).
+        std::stringstream description;
+        description << "ELL compiled map v1\n";
+        description << "llvm " << LLVM_VERSION_STRING << "\n";
+
+        const auto& options = GetMapCompilerOptions();
+        description << "moduleName " << options.moduleName << "\n";
+        description << "mapFunctionName " << options.mapFunctionName << "\n";
+        description << "sourceFunctionName " << options.sourceFunctionName << "\n";
+        description << "sinkFunctionName " << options.sinkFunctionName << "\n";
+        description << "reusePortMemory " << options.reusePortMemory << "\n";
+        description << "batchSize " << options.batchSize << "\n";
+        description << "inlineNodes " << options.inlineNodes << "\n";
+
+        const auto& compilerOptions = GetModule().GetCompilerOptions();
+        description << "optimize " << compilerOptions.optimize << "\n";
+        description << "blasType " << emitters::ToString(compilerOptions.blasType) << "\n";
+        description << "positionIndependentCode " << (compilerOptions.positionIndependentCode.HasValue() ? std::to_string(compilerOptions.positionIndependentCode.GetValue()) : "default") << "\n";
+        description << "parallelize " << compilerOptions.parallelize << "\n";
+        description << "useThreadPool " << compilerOptions.useThreadPool << "\n";
+        description << "maxThreads " << compilerOptions.maxThreads << "\n";
+        description << "useWorkStealing " << compilerOptions.useWorkStealing << "\n";
+        description << "useFastMath " << compilerOptions.useFastMath << "\n";
+        description << "fastMathAccuracy " << emitters::ToString(compilerOptions.fastMathAccuracy) << "\n";
+        description << "includeDiagnosticInfo " << compilerOptions.includeDiagnosticInfo << "\n";
+        description << "useBlas " << compilerOptions.useBlas << "\n";
+        description << "unrollLoops " << compilerOptions.unrollLoops << "\n";
+        description << "inlineOperators " << compilerOptions.inlineOperators << "\n";
+        description << "allowVectorInstructions " << compilerOptions.allowVectorInstructions << "\n";
+        description << "vectorWidth " << compilerOptions.vectorWidth << "\n";
+        description << "debug " << compilerOptions.debug << "\n";
+        description << "modelFile " << compilerOptions.modelFile << "\n";
+        description << "globalValueAlignment " << compilerOptions.globalValueAlignment << "\n";
+        description << "skip_ellcode " << compilerOptions.skip_ellcode << "\n";
+
+        const auto& target = compilerOptions.targetDevice;
+        description << "target " << target.deviceName << " " << target.triple << " " << target.architecture << " " << target.cpu << " " << target.features << "\n";
+        description << "dataLayout " << target.dataLayout << "\n";
+
+        auto optimizerOptions = GetModelOptimizerOptions();
+        auto optimizerOptionNames = optimizerOptions.AsPropertyBag().Keys();
+        std::sort(optimizerOptionNames.begin(), optimizerOptionNames.end());
+        for (const auto& name : optimizerOptionNames)
+        {
+            description << "optimizerOption " << name << " " << optimizerOptions.GetEntry(name).ToString() << "\n";
+        }
+
+        description << "tuningCache\n";
+        GetTuningCache().Write(description);
+
+        // The serialized map includes the per-node compiler and optimizer options in its metadata
+        description << "map\n";
+        utilities::JsonArchiver archiver(description);
+        archiver.Archive(map);
+        return description.str();
+    }
+
+    bool IRMapCompiler::TryLoadCachedModule(const CompiledMapCache& cache, const std::string& key)
+    {
+        // The cached module takes the place of everything the compiler emits, so it can only be used if the module
+        // doesn't have any code yet
+        auto& module = *_moduleEmitter.GetLLVMModule();
+        auto isDefinition = [](const llvm::GlobalValue& value) { return !value.isDeclaration(); };
+        if (std::any_of(module.begin(), module.end(), isDefinition) || std::any_of(module.global_begin(), module.global_end(), isDefinition))
+        {
+            return false;
+        }
+
+        auto cachedModule = cache.LoadBitcode(key, _moduleEmitter.GetLLVMContext());
+        if (!cachedModule)
+        {
+            return false;
+        }
+
+        // linkModules returns true on error
+        if (llvm::Linker::linkModules(module, std::move(cachedModule)))
+        {
+            throw emitters::EmitterException(emitters::EmitterError::unexpected, "Failed to load cached compiled map " + key);
+        }
+        return true;
     }
 
     void IRMapCompiler::RefineAndOptimize(Map& map)
@@ -139,6 +280,103 @@ namespace model
         map.Prune();
     }
 
+    void IRMapCompiler::BatchMap(Map& map)
+    {
+        // Computing the samples of a batch together lets nodes share work across them, e.g., a matrix-vector product
+        // with fixed weights becomes one matrix-matrix product that reads the weights once per batch
+        Log() << "Batching map to " << GetMapCompilerOptions().batchSize << " samples per call..." << EOL;
+        BatchTransformer batcher;
+        map = batcher.Transform(map, GetMapCompilerOptions().batchSize);
+    }
+
+    void IRMapCompiler::PlanPortMemory()
+    {
+        // Compute the lifetime of each port variable in terms of the order in which the nodes' code executes.
+        // A variable can be shared by several ports (e.g., when a node forwards its input variable as its output),
+        // so lifetimes are tracked per variable, not per port.
+        std::vector<emitters::Variable*> variables;
+        std::unordered_map<emitters::Variable*, std::pair<int, int>> lifetimes;
+        std::unordered_set<emitters::Variable*> pinnedVariables;
+        auto extendLifetime = [&](emitters::Variable* pVar, int step) {
+            auto it = lifetimes.find(pVar);
+            if (it == lifetimes.end())
+            {
+                variables.push_back(pVar);
+                lifetimes[pVar] = { step, step };
+            }
+            else
+            {
+                it->second.first = std::min(it->second.first, step);
+                it->second.second = std::max(it->second.second, step);
+            }
+        };
+
+        for (int step = 0, numSteps = static_cast<int>(_compiledNodes.size()); step < numSteps; ++step)
+        {
+            const Node* node = _compiledNodes[step];
+            for (auto output : node->GetOutputPorts())
+            {
+                auto pVar = GetVariableForPort(*output);
+                if (pVar == nullptr)
+                {
+                    continue;
+                }
+
+                // Only zero-initialized global buffers are candidates. Padded outputs are excluded, because
+                // nodes rely on the padding region keeping its initial (zero) value.
+                bool isReusable = pVar->Scope() == emitters::VariableScope::global && pVar->IsVector() && !pVar->HasInitValue() && !output->GetMemoryLayout().HasPadding();
+                if (!isReusable)
+                {
+                    pinnedVariables.insert(pVar);
+                }
+                extendLifetime(pVar, step);
+            }
+
+            for (auto input : node->GetInputPorts())
+            {
+                auto pVar = GetVariableForPort(input->GetReferencedPort());
+                if (pVar != nullptr)
+                {
+                    extendLifetime(pVar, step);
+                }
+            }
+        }
+
+        auto alignment = std::max(GetMapCompilerOptions().compilerSettings.globalValueAlignment, 1);
+        PortMemoryPlanner planner(static_cast<size_t>(alignment));
+        std::vector<emitters::Variable*> plannedVariables;
+        for (auto pVar : variables)
+        {
+            if (pinnedVariables.find(pVar) != pinnedVariables.end())
+            {
+                continue;
+            }
+
+            GetModule().EnsureEmitted(*pVar);
+            auto size = pVar->Dimension() * GetModule().GetIREmitter().SizeOf(pVar->Type());
+            const auto& lifetime = lifetimes[pVar];
+            planner.AddBuffer(size, lifetime.first, lifetime.second);
+            plannedVariables.push_back(pVar);
+        }
+
+        if (planner.NumBuffers() == 0)
+        {
+            Log() << "No port buffers to place in scratch memory" << EOL;
+            return;
+        }
+
+        planner.Plan();
+        _scratchSize = planner.GetArenaSize();
+        Log() << "Placing " << planner.NumBuffers() << " port buffers in " << _scratchSize << " bytes of scratch memory (" << planner.GetTotalBufferSize() << " bytes without reuse)" << EOL;
+
+        std::vector<std::pair<emitters::Variable*, size_t>> placements;
+        for (size_t index = 0; index < plannedVariables.size(); ++index)
+        {
+            placements.emplace_back(plannedVariables[index], planner.GetOffset(index));
+        }
+        _moduleEmitter.PlaceGlobalsInArena(GetNamespacePrefix() + "_scratch", _scratchSize, placements);
+    }
+
     void IRMapCompiler::EmitPredictDispatchFunction(const Map& map)
     {
         auto& emitter = _moduleEmitter.GetIREmitter();
@@ -205,18 +443,134 @@ namespace model
         _moduleEmitter.EndFunction();
     }
 
+    void IRMapCompiler::EmitPredictBatchFunction(const Map& map)
+    {
+        auto& emitter = _moduleEmitter.GetIREmitter();
+
+        // A batched version of "predict_dispatch": each input and output buffer holds `batchSize` samples stored
+        // one after another. The predict function computes `MapCompilerOptions::batchSize` samples per call (see
+        // `BatchMap`), so we call it on each full group of samples, and then on a copy of the samples that are left,
+        // padded out to a full group.
+        const int samplesPerCall = std::max(1, GetMapCompilerOptions().batchSize);
+        auto predictFunction = _moduleEmitter.GetFunction(GetPredictFunctionName());
+        emitters::NamedLLVMTypeList predictArgs;
+        for (auto arg = predictFunction->arg_begin(), end = predictFunction->arg_end(); arg != end; ++arg)
+        {
+            predictArgs.push_back({ arg->getName(), arg->getType() });
+        }
+
+        emitters::NamedLLVMTypeList args;
+        args.push_back(predictArgs[0]); // the context parameter
+        emitters::LLVMType argType = llvm::PointerType::getUnqual(emitter.Type(emitters::VariableType::Char8Pointer));
+        args.push_back({ "inputs", argType });
+        args.push_back({ "outputs", argType });
+        args.push_back({ "batchSize", emitter.Type(emitters::VariableType::Int32) });
+
+        auto function = _moduleEmitter.BeginFunction(GetNamespacePrefix() + "_PredictBatch", emitter.Type(emitters::VariableType::Void), args);
+        function.GetFunction()->setLinkage(llvm::GlobalValue::LinkageTypes::ExternalLinkage);
+        function.IncludeInHeader();
+        _moduleEmitter.GetFunctionDeclaration(GetNamespacePrefix() + "_PredictBatch").GetComments() = {
+            "Computes batchSize samples, stored one after another in each buffer",
+            "Calls " + GetPredictFunctionName() + " once per " + (samplesPerCall == 1 ? std::string("sample") : "group of " + std::to_string(samplesPerCall) + " samples")
+        };
+
+        auto context = function.GetFunctionArgument("context");
+        auto inputs = function.GetFunctionArgument("inputs");
+        auto outputs = function.GetFunctionArgument("outputs");
+        auto batchSize = function.LocalScalar(function.GetFunctionArgument("batchSize"));
+
+        // Unpack the buffer pointers once, outside the loop
+        struct BatchBuffer
+        {
+            emitters::LLVMValue pointer;
+            emitters::LLVMType pointerType;
+            emitters::VariableType elementType;
+            int sampleSize;
+            bool isOutput;
+        };
+        std::vector<BatchBuffer> buffers;
+        int predictArgIndex = 1; // skip context.
+        for (size_t i = 0, n = map.NumInputs(); i < n; ++i)
+        {
+            auto pointerType = predictArgs[predictArgIndex++].second;
+            auto ptr = function.Load(emitter.PointerOffset(inputs, function.Literal(static_cast<int>(i))));
+            buffers.push_back({ function.CastPointer(ptr, pointerType), pointerType, PortTypeToVariableType(map.GetInput(i)->GetOutputType()), static_cast<int>(map.GetInputSize(i)) / samplesPerCall, false });
+        }
+        for (size_t i = 0, n = map.NumOutputs(); i < n; ++i)
+        {
+            auto pointerType = predictArgs[predictArgIndex++].second;
+            auto ptr = function.Load(emitter.PointerOffset(outputs, function.Literal(static_cast<int>(i))));
+            buffers.push_back({ function.CastPointer(ptr, pointerType), pointerType, PortTypeToVariableType(map.GetOutput(i).GetType()), static_cast<int>(map.GetOutputSize(i)) / samplesPerCall, true });
+        }
+
+        auto numCalls = batchSize / samplesPerCall;
+        function.For(numCalls, [&](emitters::IRFunctionEmitter& fn, emitters::IRLocalScalar callIndex) {
+            emitters::IRValueList arguments;
+            arguments.push_back(context);
+            for (const auto& buffer : buffers)
+            {
+                auto offset = callIndex * (buffer.sampleSize * samplesPerCall);
+                arguments.push_back(fn.PointerOffset(buffer.pointer, offset));
+            }
+            fn.Call(predictFunction, arguments);
+        });
+
+        if (samplesPerCall > 1)
+        {
+            auto numSamplesLeft = batchSize - numCalls * samplesPerCall;
+            function.If(numSamplesLeft > 0, [&](emitters::IRFunctionEmitter& fn) {
+                // The maps that get batched are stateless, so whatever the unused samples in the scratch buffers
+                // hold only affects the unused outputs
+                std::vector<std::tuple<emitters::LLVMValue, emitters::LLVMValue, emitters::LLVMValue>> outputCopies; // (scratch buffer, samples, byte count)
+                emitters::IRValueList arguments;
+                arguments.push_back(context);
+                for (size_t index = 0; index < buffers.size(); ++index)
+                {
+                    const auto& buffer = buffers[index];
+                    auto scratchBuffer = _moduleEmitter.GlobalArray(buffer.elementType, GetNamespacePrefix() + "_PredictBatchBuffer_" + std::to_string(index), buffer.sampleSize * samplesPerCall);
+                    auto scratchPointer = fn.CastPointer(fn.PointerOffset(scratchBuffer, 0), buffer.pointerType);
+                    auto samplesPointer = fn.PointerOffset(buffer.pointer, numCalls * (buffer.sampleSize * samplesPerCall));
+                    auto byteCount = numSamplesLeft * static_cast<int>(buffer.sampleSize * emitter.SizeOf(buffer.elementType));
+                    if (buffer.isOutput)
+                    {
+                        outputCopies.emplace_back(scratchPointer, samplesPointer, byteCount);
+                    }
+                    else
+                    {
+                        emitter.MemoryCopy(samplesPointer, scratchPointer, byteCount);
+                    }
+                    arguments.push_back(scratchPointer);
+                }
+                fn.Call(predictFunction, arguments);
+
+                for (const auto& copy : outputCopies)
+                {
+                    emitter.MemoryCopy(std::get<0>(copy), std::get<1>(copy), std::get<2>(copy));
+                }
+            });
+        }
+
+        function.Return();
+        _moduleEmitter.EndFunction();
+    }
+
     void IRMapCompiler::EmitModelAPIFunctions(const Map& map)
     {
         EmitGetInputSizeFunction(map);
         EmitGetOutputSizeFunction(map);
         EmitGetSinkOutputSizeFunction(map);
         EmitGetNumNodesFunction(map);
+        if (GetMapCompilerOptions().reusePortMemory)
+        {
+            EmitGetScratchSizeFunction();
+        }
         EmitShapeEnum();
         EmitGetInputShapeFunction(map);
         EmitGetOutputShapeFunction(map);
         EmitGetSinkOutputShapeFunction(map);
         EmitGetMetadataFunction(map);
         EmitPredictDispatchFunction(map);
+        EmitPredictBatchFunction(map);
 
         // Finish any profiling stuff we need to do and emit functions
         _profiler.EmitModelProfilerFunctions();
@@ -536,6 +890,15 @@ namespace model
         _moduleEmitter.EndFunction();
     }
 
+    void IRMapCompiler::EmitGetScratchSizeFunction()
+    {
+        // Returns the number of bytes of shared memory used for intermediate port buffers
+        auto function = _moduleEmitter.BeginFunction(GetNamespacePrefix() + "_GetScratchSize", emitters::VariableType::Int32);
+        function.IncludeInHeader();
+        function.Return(function.Literal(static_cast<int>(_scratchSize)));
+        _moduleEmitter.EndFunction();
+    }
+
     void IRMapCompiler::EmitGetMetadataFunction(const Map& map)
     {
         const emitters::NamedVariableTypeList parameters = { { "key", emitters::VariableType::Char8Pointer } };
@@ -685,6 +1048,7 @@ namespace model
             currentFunction.AddRegion(currentFunction.GetCurrentBlock());
         }
 
+        _compiledNodes.push_back(&node);
         _profiler.InitNode(currentFunction, node);
         _profiler.StartNode(currentFunction, node);
     }
@@ -814,6 +1178,13 @@ namespace model
     {
         Log() << "Trying to merge parent node " << DiagnosticString(dest) << " with child node " << DiagnosticString(src) << EOL;
 
+        // Merging moves a node's code next to its parent's, which would invalidate the port lifetimes computed from compile order
+        if (GetMapCompilerOptions().reusePortMemory)
+        {
+            Log() << "Not merging code regions, because port memory is being reused" << EOL;
+            return false;
+        }
+
         emitters::IRBlockRegion* pDestRegion = GetCurrentNodeBlocks().Get(dest);
         if (pDestRegion == nullptr)
         {
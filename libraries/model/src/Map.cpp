@@ -10,6 +10,7 @@
 #include "ModelTransformer.h"
 #include "OptimizeModelTransformation.h"
 #include "OutputNode.h"
+#include "ParallelModelExecutor.h"
 #include "RefineTransformation.h"
 
 #include <utilities/include/Exception.h>
@@ -92,6 +93,9 @@ namespace model
 
         // TODO (kerha): _computeContext isn't copied right now. Not sure if it should be. [2019-08-23]
 
+        // The executor holds no per-model state, so copies can share its threads
+        _parallelExecutor = other._parallelExecutor;
+
         _model.Verify();
     }
 
@@ -131,29 +135,49 @@ namespace model
         node->SetInput(inputValues);
     }
 
+    void Map::EnableParallelCompute(size_t numThreads)
+    {
+        _parallelExecutor = std::make_shared<ParallelModelExecutor>(numThreads);
+    }
+
+    void Map::DisableParallelCompute()
+    {
+        _parallelExecutor.reset();
+    }
+
+    template <typename ValueType>
+    std::vector<ValueType> Map::ComputeModelOutput(const PortElementsBase& outputs)
+    {
+        if (_parallelExecutor)
+        {
+            return _parallelExecutor->ComputeOutput<ValueType>(_model, outputs);
+        }
+        return _model.ComputeOutput<ValueType>(outputs);
+    }
+
     std::vector<bool> Map::ComputeBoolOutput(const PortElementsBase& outputs)
     {
-        return _model.ComputeOutput<bool>(outputs);
+        return ComputeModelOutput<bool>(outputs);
     }
 
     std::vector<int> Map::ComputeIntOutput(const PortElementsBase& outputs)
     {
-        return _model.ComputeOutput<int>(outputs);
+        return ComputeModelOutput<int>(outputs);
     }
 
     std::vector<int64_t> Map::ComputeInt64Output(const PortElementsBase& outputs)
     {
-        return _model.ComputeOutput<int64_t>(outputs);
+        return ComputeModelOutput<int64_t>(outputs);
     }
 
     std::vector<float> Map::ComputeFloatOutput(const PortElementsBase& outputs)
     {
-        return _model.ComputeOutput<float>(outputs);
+        return ComputeModelOutput<float>(outputs);
     }
 
     std::vector<double> Map::ComputeDoubleOutput(const PortElementsBase& outputs)
     {
-        return _model.ComputeOutput<double>(outputs);
+        return ComputeModelOutput<double>(outputs);
     }
 
     template <>
@@ -240,7 +264,20 @@ namespace model
             }
         }
 
-        _model.Step();
+        if (_parallelExecutor)
+        {
+            // Compute the same nodes as `Model::Step`
+            std::vector<const OutputPortBase*> ports;
+            for (auto node : _model.GetNodesByType<OutputNodeBase>())
+            {
+                ports.push_back(&(node->GetOutputPort()));
+            }
+            _parallelExecutor->ComputeNodes(_model, ports);
+        }
+        else
+        {
+            _model.Step();
+        }
 
         auto numOutputs = NumOutputs();
         for (size_t i = 0; i < numOutputs && i < outputs.size(); i++)
@@ -332,6 +369,7 @@ namespace model
         swap(a._outputsMap, b._outputsMap);
         swap(a._metadata, b._metadata);
         swap(a._computeContext, b._computeContext);
+        swap(a._parallelExecutor, b._parallelExecutor);
     }
 
     std::vector<const Node*> Map::GetAllOutputNodes() const
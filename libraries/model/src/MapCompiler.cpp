@@ -28,6 +28,10 @@ namespace model
         _parameters(settings),
         _optimizerOptions(optimizerOptions)
     {
+        if (!_parameters.tuningCachePath.empty())
+        {
+            _tuningCache = TuningCache::Load(_parameters.tuningCachePath);
+        }
         PushScope();
     }
 
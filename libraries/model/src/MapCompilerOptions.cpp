@@ -33,6 +33,10 @@ namespace model
         sinkFunctionName = properties.GetOrParseEntry("sinkFunctionName", sinkFunctionName);
         verifyJittedModule = properties.GetOrParseEntry("verifyJittedModule", verifyJittedModule);
         profile = properties.GetOrParseEntry("profile", profile);
+        reusePortMemory = properties.GetOrParseEntry("reusePortMemory", reusePortMemory);
+        tuningCachePath = properties.GetOrParseEntry("tuningCachePath", tuningCachePath);
+        compiledMapCachePath = properties.GetOrParseEntry("compiledMapCachePath", compiledMapCachePath);
+        batchSize = properties.GetOrParseEntry("batchSize", batchSize);
         inlineNodes = properties.GetOrParseEntry("inlineNodes", inlineNodes);
     }
 } // namespace model
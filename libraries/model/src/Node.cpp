@@ -188,6 +188,13 @@ namespace model
         return false;
     }
 
+    // Default implementation of Batch has no batched form, so the BatchTransformer copies the node once per sample
+    bool Node::Batch(BatchTransformer& transformer) const
+    {
+        UNUSED(transformer);
+        return false;
+    }
+
     void Node::Print(std::ostream& os) const
     {
         bool isFirstInputPort = true;
@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ParallelModelExecutor.cpp (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ParallelModelExecutor.h"
+#include "CompilableCodeNode.h"
+#include "Node.h"
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <unordered_map>
+
+namespace ell
+{
+namespace model
+{
+    ParallelModelExecutor::ParallelModelExecutor(size_t numThreads) :
+        _threadPool(numThreads)
+    {
+    }
+
+    void ParallelModelExecutor::ComputeNodes(const Model& model, const std::vector<const OutputPortBase*>& outputs)
+    {
+        // Gather the nodes in the order a sequential compute would visit them
+        std::vector<const Node*> nodes;
+        model.VisitSubmodel(outputs, [&nodes](const Node& node) { nodes.push_back(&node); });
+
+        const auto numNodes = nodes.size();
+        std::unordered_map<const Node*, size_t> nodeIndices;
+        for (size_t index = 0; index < numNodes; ++index)
+        {
+            nodeIndices[nodes[index]] = index;
+        }
+
+        // Build the dependency graph. A node is ready to compute when its count of unfinished parents drops to zero.
+        std::vector<std::vector<size_t>> dependents(numNodes);
+        std::vector<size_t> numPendingParents(numNodes, 0);
+        std::vector<size_t> readyNodes;
+        for (size_t index = 0; index < numNodes; ++index)
+        {
+            std::unordered_set<const Node*> parents;
+            for (auto parent : nodes[index]->GetParentNodes())
+            {
+                auto it = nodeIndices.find(parent);
+                if (it != nodeIndices.end() && parents.insert(parent).second)
+                {
+                    dependents[it->second].push_back(index);
+                    ++numPendingParents[index];
+                }
+            }
+
+            if (numPendingParents[index] == 0)
+            {
+                readyNodes.push_back(index);
+            }
+        }
+
+        // Run one scheduling loop per thread. Each loop takes a ready node, computes it, and releases its dependents.
+        std::mutex mutex;
+        std::condition_variable nodesReady;
+        std::mutex valueNodeMutex;
+        size_t numFinished = 0;
+        std::exception_ptr exception;
+
+        auto scheduleNodes = [&](size_t) {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true)
+            {
+                nodesReady.wait(lock, [&] { return !readyNodes.empty() || numFinished == numNodes || exception; });
+                if (numFinished == numNodes || exception)
+                {
+                    return;
+                }
+
+                auto index = readyNodes.back();
+                readyNodes.pop_back();
+                lock.unlock();
+
+                try
+                {
+                    const auto& node = *nodes[index];
+                    if (dynamic_cast<const CompilableCodeNode*>(&node) != nullptr)
+                    {
+                        std::lock_guard<std::mutex> valueNodeLock(valueNodeMutex);
+                        node.Compute();
+                    }
+                    else
+                    {
+                        node.Compute();
+                    }
+                }
+                catch (...)
+                {
+                    lock.lock();
+                    if (!exception)
+                    {
+                        exception = std::current_exception();
+                    }
+                    nodesReady.notify_all();
+                    return;
+                }
+
+                lock.lock();
+                ++numFinished;
+                size_t numReleased = 0;
+                for (auto dependent : dependents[index])
+                {
+                    if (--numPendingParents[dependent] == 0)
+                    {
+                        readyNodes.push_back(dependent);
+                        ++numReleased;
+                    }
+                }
+
+                if (numFinished == numNodes)
+                {
+                    nodesReady.notify_all();
+                }
+                else if (numReleased > 1)
+                {
+                    // This thread picks up one of the released nodes itself
+                    nodesReady.notify_all();
+                }
+            }
+        };
+
+        if (numNodes < 2)
+        {
+            scheduleNodes(0);
+        }
+        else
+        {
+            _threadPool.ParallelFor(NumThreads() + 1, scheduleNodes, 1);
+        }
+
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+} // namespace model
+} // namespace ell
@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     PortMemoryPlanner.cpp (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PortMemoryPlanner.h"
+
+#include <utilities/include/Exception.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+namespace ell
+{
+namespace model
+{
+    PortMemoryPlanner::PortMemoryPlanner(size_t alignment) :
+        _alignment(std::max<size_t>(alignment, 1))
+    {
+    }
+
+    size_t PortMemoryPlanner::AddBuffer(size_t size, int firstUse, int lastUse)
+    {
+        if (lastUse < firstUse)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Buffer lifetime must end after it begins");
+        }
+
+        _isPlanned = false;
+        _buffers.push_back({ AlignSize(size), firstUse, lastUse, 0 });
+        return _buffers.size() - 1;
+    }
+
+    void PortMemoryPlanner::Plan()
+    {
+        // Place the largest buffers first, breaking ties by birth order
+        std::vector<size_t> order(_buffers.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+            if (_buffers[a].size != _buffers[b].size)
+            {
+                return _buffers[a].size > _buffers[b].size;
+            }
+            return _buffers[a].firstUse < _buffers[b].firstUse;
+        });
+
+        _arenaSize = 0;
+        std::vector<size_t> placed;
+        for (auto bufferIndex : order)
+        {
+            auto& buffer = _buffers[bufferIndex];
+
+            // Collect the memory ranges of already-placed buffers that are alive at the same time as this one
+            std::vector<std::pair<size_t, size_t>> occupied;
+            for (auto placedIndex : placed)
+            {
+                const auto& other = _buffers[placedIndex];
+                if (LifetimesOverlap(buffer, other))
+                {
+                    occupied.emplace_back(other.offset, other.offset + other.size);
+                }
+            }
+            std::sort(occupied.begin(), occupied.end());
+
+            // Find the smallest gap between occupied ranges that fits the buffer, otherwise put it after the last one
+            size_t bestOffset = 0;
+            size_t bestGap = std::numeric_limits<size_t>::max();
+            bool foundGap = false;
+            size_t gapStart = 0;
+            for (const auto& range : occupied)
+            {
+                if (range.first > gapStart)
+                {
+                    auto gap = range.first - gapStart;
+                    if (gap >= buffer.size && gap < bestGap)
+                    {
+                        bestGap = gap;
+                        bestOffset = gapStart;
+                        foundGap = true;
+                    }
+                }
+                gapStart = std::max(gapStart, range.second);
+            }
+
+            buffer.offset = foundGap ? bestOffset : gapStart;
+            _arenaSize = std::max(_arenaSize, buffer.offset + buffer.size);
+            placed.push_back(bufferIndex);
+        }
+        _isPlanned = true;
+    }
+
+    size_t PortMemoryPlanner::GetOffset(size_t bufferIndex) const
+    {
+        if (!_isPlanned)
+        {
+            throw utilities::LogicException(utilities::LogicExceptionErrors::illegalState, "PortMemoryPlanner::Plan must be called before querying offsets");
+        }
+        return _buffers.at(bufferIndex).offset;
+    }
+
+    size_t PortMemoryPlanner::GetArenaSize() const
+    {
+        if (!_isPlanned)
+        {
+            throw utilities::LogicException(utilities::LogicExceptionErrors::illegalState, "PortMemoryPlanner::Plan must be called before querying the arena size");
+        }
+        return _arenaSize;
+    }
+
+    size_t PortMemoryPlanner::GetTotalBufferSize() const
+    {
+        return std::accumulate(_buffers.begin(), _buffers.end(), size_t{ 0 }, [](size_t sum, const Buffer& buffer) { return sum + buffer.size; });
+    }
+
+    bool PortMemoryPlanner::LifetimesOverlap(const Buffer& a, const Buffer& b)
+    {
+        return a.firstUse <= b.lastUse && b.firstUse <= a.lastUse;
+    }
+
+    size_t PortMemoryPlanner::AlignSize(size_t size) const
+    {
+        return ((size + _alignment - 1) / _alignment) * _alignment;
+    }
+} // namespace model
+} // namespace ell
@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     TuningCache.cpp (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "TuningCache.h"
+
+#include <utilities/include/Exception.h>
+#include <utilities/include/Files.h>
+
+#include <cctype>
+#include <istream>
+#include <ostream>
+#include <sstream>
+
+namespace ell
+{
+namespace model
+{
+    std::string TuningCache::GetKey(const std::string& nodeType, const std::vector<int>& shape, const emitters::TargetDevice& target)
+    {
+        // Keys can't contain whitespace, since the file format is a whitespace-separated key followed by the parameters
+        std::stringstream key;
+        key << nodeType;
+        for (auto size : shape)
+        {
+            key << '_' << size;
+        }
+        key << '@' << (target.triple.empty() ? "host" : target.triple);
+        if (!target.cpu.empty())
+        {
+            key << '/' << target.cpu;
+        }
+        auto result = key.str();
+        for (auto& ch : result)
+        {
+            if (std::isspace(static_cast<unsigned char>(ch)))
+            {
+                ch = '_';
+            }
+        }
+        return result;
+    }
+
+    bool TuningCache::TryGetParameters(const std::string& key, std::vector<int>& parameters) const
+    {
+        auto iter = _entries.find(key);
+        if (iter == _entries.end())
+        {
+            return false;
+        }
+        parameters = iter->second;
+        return true;
+    }
+
+    void TuningCache::SetParameters(const std::string& key, const std::vector<int>& parameters)
+    {
+        _entries[key] = parameters;
+    }
+
+    void TuningCache::Read(std::istream& stream)
+    {
+        std::string line;
+        while (std::getline(stream, line))
+        {
+            std::stringstream lineStream(line);
+            std::string key;
+            if (!(lineStream >> key) || key[0] == '#')
+            {
+                continue;
+            }
+
+            std::vector<int> parameters;
+            int value;
+            while (lineStream >> value)
+            {
+                parameters.push_back(value);
+            }
+            if (!lineStream.eof())
+            {
+                throw utilities::InputException(utilities::InputExceptionErrors::badData, "Bad tuning cache entry: " + line);
+            }
+            _entries[key] = parameters;
+        }
+    }
+
+    void TuningCache::Write(std::ostream& stream) const
+    {
+        for (const auto& [key, parameters] : _entries)
+        {
+            stream << key;
+            for (auto value : parameters)
+            {
+                stream << ' ' << value;
+            }
+            stream << '\n';
+        }
+    }
+
+    TuningCache TuningCache::Load(const std::string& filename)
+    {
+        TuningCache cache;
+        if (utilities::FileExists(filename))
+        {
+            auto stream = utilities::OpenIfstream(filename);
+            cache.Read(stream);
+        }
+        return cache;
+    }
+
+    void TuningCache::Save(const std::string& filename) const
+    {
+        auto stream = utilities::OpenOfstream(filename);
+        Write(stream);
+    }
+} // namespace model
+} // namespace ell
@@ -76,6 +76,9 @@ void TestMatrixVectorMultiplyNode(int m, int n, bool useBlas);
 void TestMatrixMatrixMultiplyNode(int m, int n, int k, bool useBlas);
 void TestOrderedMatrixMatrixMultiplyNode(int m, int n, int k, bool transposeA, bool transposeB, bool transposeC, bool useBlas);
 void TestMatrixMatrixMultiplyCodeNode(int m, int n, int k, int panelM, int panelN, int panelK, int kernelM, int kernelN, int kernelK, nodes::MatrixMatrixMultiplyImplementation gemmImpl);
+void TestMatrixMatrixMultiplyCodeNodeEpilogue(int m, int n, int k, int panelK);
+void TestQuantizedMatrixMatrixMultiplyNode(int m, int n, int k, bool transposeOutput);
+void TestQuantizedMatrixMatrixMultiplyNodeChain();
 
 void TestBroadcasUnaryOperationNodeCompile();
 void TestBroadcasBinaryOperationNodeCompileAdd();
@@ -103,7 +106,7 @@ void TestParametricReLUActivationLayerNode(size_t inputPadding = 0, size_t outpu
 void TestSigmoidActivationLayerNode(size_t inputPadding = 0, size_t outputPadding = 0);
 void TestBatchNormalizationLayerNode(size_t inputPadding = 0, size_t outputPadding = 0);
 void TestBiasLayerNode(size_t inputPadding = 0, size_t outputPadding = 0);
-void TestBinaryConvolutionalLayerNode(size_t imageRows, size_t imageColumns, size_t numChannels, size_t numFilters, size_t inputPadding = 1, size_t outputPadding = 0, ell::predictors::neural::PaddingScheme = ell::predictors::neural::PaddingScheme::zeros, bool scaleByFilterMeans = true);
+void TestBinaryConvolutionalLayerNode(size_t imageRows, size_t imageColumns, size_t numChannels, size_t numFilters, size_t inputPadding = 1, size_t outputPadding = 0, ell::predictors::neural::PaddingScheme = ell::predictors::neural::PaddingScheme::zeros, bool scaleByFilterMeans = true, bool allowVectorInstructions = false);
 void TestBroadcastLinearFunctionNode();
 void TestConvolutionalLayerNode(ConvolutionMethod convolutionMethod, size_t inputPadding = 1, size_t outputPadding = 0);
 void TestConvolutionalLayerNode2(ConvolutionMethod convolutionMethod, size_t inputPadding = 1, size_t outputPadding = 0);
@@ -114,6 +117,7 @@ void TestMeanPoolingLayerNode(size_t inRows, size_t inCols, size_t numChannels,
 void TestScalingLayerNode(size_t inputPadding = 0, size_t outputPadding = 0);
 void TestSoftmaxLayerNode(size_t inputPadding = 0, size_t outputPadding = 0);
 void TestSpatialConvolutionNode(size_t inputPadding = 1, size_t outputPadding = 0);
+void TestSpatialConvolutionNodeEpilogue(int columnTile);
 void TestFusedLinearLayerNodes(size_t rows, size_t columns, size_t channels);
 void TestRegionDetectionNode();
 void TestIRNode();
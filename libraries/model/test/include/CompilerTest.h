@@ -48,14 +48,19 @@ void TestForestMap();
 void TestNodeMetadata();
 
 void TestSimpleMap(bool optimize);
+void TestReusePortMemoryMap();
+void TestPredictBatchMap();
+void TestPredictBatchMapWithMatrixProduct();
 void TestSqEuclideanDistanceMap();
 void TestProtoNNPredictorMap();
+void TestProtoNNPredictorMapWithPrototypeOnInput();
 void TestCombineOutputMap();
 void TestMultiOutputMap();
 void TestMultiSourceSinkMap();
 void TestCompiledMapMove();
 void TestCompiledMapClone();
 void TestCompiledMapParallelClone();
+void TestCompiledMapCache();
 
 #pragma region implementation
 
@@ -10,6 +10,7 @@
 void TestMapCreate();
 void TestMapCompute();
 void TestMapComputeDataVector();
+void TestMapParallelCompute();
 void TestMapRefine();
 void TestMapSerialization();
 void TestMapClockNode();
@@ -0,0 +1,12 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     PortMemoryPlanner_test.h (model_test)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+void TestPortMemoryPlannerChain();
+void TestPortMemoryPlannerOverlappingLifetimes();
+void TestPortMemoryPlannerAlignment();
@@ -57,6 +57,7 @@
 #include <nodes/include/NeuralNetworkPredictorNode.h>
 #include <nodes/include/NodeOperations.h>
 #include <nodes/include/PoolingLayerNode.h>
+#include <nodes/include/QuantizedMatrixMatrixMultiplyNode.h>
 #include <nodes/include/ReceptiveFieldMatrixNode.h>
 #include <nodes/include/RegionDetectionLayerNode.h>
 #include <nodes/include/ReinterpretLayoutNode.h>
@@ -97,6 +98,7 @@
 #include <utilities/include/TypeName.h>
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <ostream>
 #include <sstream>
@@ -1851,6 +1853,164 @@ void TestMatrixMatrixMultiplyCodeNode(int m, int n, int k, int panelM, int panel
     });
 }
 
+void TestMatrixMatrixMultiplyCodeNodeEpilogue(int m, int n, int k, int panelK)
+{
+    using ValueType = float;
+    std::vector<ValueType> matrixBVals(k * n);
+    FillRandomVector(matrixBVals);
+    std::vector<ValueType> scale(m);
+    std::vector<ValueType> bias(m);
+    FillRandomVector(scale, static_cast<ValueType>(0.5), static_cast<ValueType>(2));
+    FillRandomVector(bias);
+
+    // output = ReLU(scale * (A * B) + bias), with one scale and bias entry per row of the output
+    OutputEpilogue<ValueType> epilogue;
+    epilogue.AppendLinearFunction(scale, bias);
+    epilogue.AppendActivation({ new ReLUActivation<ValueType>() });
+
+    model::Model model;
+    auto inputMatrixNode = model.AddNode<model::InputNode<ValueType>>(m * k);
+    auto matrixBNode = model.AddNode<ConstantNode<ValueType>>(matrixBVals);
+    auto matMatMultNode = model.AddNode<MatrixMatrixMultiplyCodeNode<ValueType>>(inputMatrixNode->output, m, n, k, k, false, matrixBNode->output, n, false, n, false, 0, 0, panelK, 0, 0, 0, MatrixMatrixMultiplyImplementation::Mlas_Loopnest_Value, epilogue);
+    auto map = model::Map(model, { { "inputMatrix", inputMatrixNode } }, { { "output", matMatMultNode->output } });
+
+    std::vector<ValueType> matrixAVals(m * k);
+    FillRandomVector(matrixAVals);
+    std::vector<std::vector<ValueType>> signal = { matrixAVals };
+
+    // Large enough products are split between threads by rows (m > n) or by columns, each of which applies the epilogue
+    model::MapCompilerOptions settings;
+    settings.compilerSettings.parallelize = true;
+    model::ModelOptimizerOptions optimizerOptions;
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    auto compiledMap = compiler.Compile(map);
+
+    std::vector<ValueType> expectedResult(m * n);
+    for (int i = 0; i < m; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            ValueType sum = 0;
+            for (int kVal = 0; kVal < k; kVal++)
+            {
+                sum += matrixAVals[i * k + kVal] * matrixBVals[kVal * n + j];
+            }
+            expectedResult[i * n + j] = std::max(scale[i] * sum + bias[i], static_cast<ValueType>(0));
+        }
+    }
+
+    std::vector<std::vector<ValueType>> expected{ expectedResult };
+    std::stringstream id;
+    id << "MatrixMatrixMultiplyCodeNode with epilogue (m = " << m << ", n = " << n << ", k = " << k << ", panelK = " << panelK << ")";
+    VerifyCompiledOutputAndResult(map, compiledMap, signal, expected, id.str(), "", 1e-4);
+}
+
+static std::vector<int8_t> GetQuantizedTestWeights(int size, int seed)
+{
+    std::vector<int8_t> weights(size);
+    for (int index = 0; index < size; ++index)
+    {
+        weights[index] = static_cast<int8_t>((((index + seed) * 37) % 255) - 127);
+    }
+    return weights;
+}
+
+// Computes weights (m x k) * input (k x n) the way QuantizedMatrixMatrixMultiplyNode does, with integer arithmetic
+template <typename ValueType>
+static std::vector<ValueType> QuantizedMatrixMatrixMultiply(const std::vector<ValueType>& input, int m, int n, int k, const std::vector<int8_t>& weights, const std::vector<ValueType>& weightScales, ValueType inputScale, bool transposeOutput)
+{
+    const auto inverseInputScale = static_cast<ValueType>(1) / inputScale;
+    std::vector<int> quantizedInput(k * n);
+    for (int index = 0; index < k * n; ++index)
+    {
+        auto scaled = std::round(input[index] * inverseInputScale);
+        quantizedInput[index] = static_cast<int>(std::max(std::min(scaled, static_cast<ValueType>(127)), static_cast<ValueType>(-127)));
+    }
+
+    std::vector<ValueType> result(m * n);
+    for (int i = 0; i < m; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            int sum = 0;
+            for (int kVal = 0; kVal < k; kVal++)
+            {
+                sum += weights[i * k + kVal] * quantizedInput[kVal * n + j];
+            }
+            auto outputIndex = transposeOutput ? j * m + i : i * n + j;
+            result[outputIndex] = static_cast<ValueType>(sum) * (weightScales[i] * inputScale);
+        }
+    }
+    return result;
+}
+
+void TestQuantizedMatrixMatrixMultiplyNode(int m, int n, int k, bool transposeOutput)
+{
+    using ValueType = float;
+    const ValueType inputScale = static_cast<ValueType>(1) / 127;
+
+    // output (m x n) = weights (m x k) * input (k x n)
+    auto weights = GetQuantizedTestWeights(m * k, 0);
+    std::vector<ValueType> weightScales(m);
+    FillRandomVector(weightScales, static_cast<ValueType>(0.001), static_cast<ValueType>(0.01));
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ValueType>>(k * n);
+    auto outputLayout = transposeOutput ? model::PortMemoryLayout(model::MemoryShape{ n, m }) : model::PortMemoryLayout(model::MemoryShape{ m, n });
+    auto quantizedNode = model.AddNode<QuantizedMatrixMatrixMultiplyNode<ValueType>>(inputNode->output, m, n, k, weights, weightScales, inputScale, transposeOutput, outputLayout);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", quantizedNode->output } });
+
+    model::MapCompilerOptions settings;
+    model::ModelOptimizerOptions optimizerOptions;
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    auto compiledMap = compiler.Compile(map);
+
+    // Some inputs are outside the quantized range, and are clamped to +/-127
+    std::vector<ValueType> input(k * n);
+    FillRandomVector(input, static_cast<ValueType>(-1.5), static_cast<ValueType>(1.5));
+    std::vector<std::vector<ValueType>> signal = { input };
+
+    std::vector<std::vector<ValueType>> expected{ QuantizedMatrixMatrixMultiply(input, m, n, k, weights, weightScales, inputScale, transposeOutput) };
+    std::stringstream id;
+    id << "QuantizedMatrixMatrixMultiplyNode (m = " << m << ", n = " << n << ", k = " << k << ", transposeOutput = " << std::boolalpha << transposeOutput << ")";
+    VerifyCompiledOutputAndResult(map, compiledMap, signal, expected, id.str(), "", 1e-4);
+}
+
+void TestQuantizedMatrixMatrixMultiplyNodeChain()
+{
+    using ValueType = float;
+    const ValueType inputScale = static_cast<ValueType>(1) / 127;
+
+    // Two quantized products in one module, each with its own weights and scratch buffer
+    const int n = 3;
+    const int k1 = 8;
+    const int m1 = 6;
+    const int m2 = 4;
+    auto weights1 = GetQuantizedTestWeights(m1 * k1, 0);
+    auto weights2 = GetQuantizedTestWeights(m2 * m1, 5);
+    std::vector<ValueType> weightScales1(m1, static_cast<ValueType>(0.004));
+    std::vector<ValueType> weightScales2(m2, static_cast<ValueType>(0.008));
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ValueType>>(k1 * n);
+    auto firstNode = model.AddNode<QuantizedMatrixMatrixMultiplyNode<ValueType>>(inputNode->output, m1, n, k1, weights1, weightScales1, inputScale, false, model::PortMemoryLayout(model::MemoryShape{ m1, n }));
+    auto secondNode = model.AddNode<QuantizedMatrixMatrixMultiplyNode<ValueType>>(firstNode->output, m2, n, m1, weights2, weightScales2, inputScale, false, model::PortMemoryLayout(model::MemoryShape{ m2, n }));
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", secondNode->output } });
+
+    model::MapCompilerOptions settings;
+    model::ModelOptimizerOptions optimizerOptions;
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    auto compiledMap = compiler.Compile(map);
+
+    std::vector<ValueType> input(k1 * n);
+    FillRandomVector(input);
+    std::vector<std::vector<ValueType>> signal = { input };
+
+    auto intermediate = QuantizedMatrixMatrixMultiply(input, m1, n, k1, weights1, weightScales1, inputScale, false);
+    std::vector<std::vector<ValueType>> expected{ QuantizedMatrixMatrixMultiply(intermediate, m2, n, m1, weights2, weightScales2, inputScale, false) };
+    VerifyCompiledOutputAndResult(map, compiledMap, signal, expected, "QuantizedMatrixMatrixMultiplyNode chain", "", 1e-4);
+}
+
 // C callback (called by emitted code)
 static int lagNotificationCallbackCount = 0;
 extern "C" {
@@ -2989,7 +3149,7 @@ void TestBiasLayerNode(size_t inputPaddingSize, size_t outputPaddingSize)
     VerifyArchiveAndUnarchivingMap<ElementType>(map, computeNode, inputWithPadding, output);
 }
 
-void TestBinaryConvolutionalLayerNode(size_t imageRows, size_t imageColumns, size_t numChannels, size_t numFilters, size_t inputPaddingSize, size_t outputPaddingSize, PaddingScheme paddingScheme, bool scaleByFilterMeans)
+void TestBinaryConvolutionalLayerNode(size_t imageRows, size_t imageColumns, size_t numChannels, size_t numFilters, size_t inputPaddingSize, size_t outputPaddingSize, PaddingScheme paddingScheme, bool scaleByFilterMeans, bool allowVectorInstructions)
 {
     using ElementType = float;
     using LayerParameters = typename Layer<ElementType>::LayerParameters;
@@ -3030,7 +3190,7 @@ void TestBinaryConvolutionalLayerNode(size_t imageRows, size_t imageColumns, siz
     model::MapCompilerOptions settings;
     settings.compilerSettings.optimize = true;
     settings.compilerSettings.useBlas = true; // !!! if BLAS is off, this fails
-    settings.compilerSettings.allowVectorInstructions = false;
+    settings.compilerSettings.allowVectorInstructions = allowVectorInstructions;
     settings.compilerSettings.vectorWidth = 2;
     model::ModelOptimizerOptions optimizerOptions;
     model::IRMapCompiler compiler(settings, optimizerOptions);
@@ -3039,6 +3199,20 @@ void TestBinaryConvolutionalLayerNode(size_t imageRows, size_t imageColumns, siz
     auto signal = std::vector<std::vector<ElementType>>{ inputWithPadding.ToArray() };
     VerifyCompiledOutput<ElementType>(map, compiledMap, { signal }, computeNode->GetRuntimeTypeName());
 
+    // Compare the compiled output with the layer's own output. The sums are large, so the tolerance is relative to them.
+    auto expected = output.ToArray();
+    double maxAbsValue = 1;
+    for (auto value : expected)
+    {
+        maxAbsValue = std::max(maxAbsValue, std::abs(static_cast<double>(value)));
+    }
+    compiledMap.SetInputValue(0, signal[0]);
+    auto compiledOutput = compiledMap.ComputeOutput<ElementType>(0);
+    std::stringstream id;
+    id << std::boolalpha << "Testing compiled BinaryConvolutionalLayerNode against the layer (" << numChannels << " channels, " << numFilters
+       << " filters, vector instructions = " << allowVectorInstructions << ")";
+    testing::ProcessTest(id.str(), testing::IsEqual(compiledOutput, expected, static_cast<ElementType>(1e-5 * maxAbsValue)));
+
     // Test archiving / unarchiving produces same result
     VerifyArchiveAndUnarchivingMap<ElementType>(map, computeNode, inputWithPadding, output);
 }
@@ -3933,3 +4107,86 @@ void TestSpatialConvolutionNode(size_t inputPaddingSize, size_t outputPaddingSiz
     // Test archiving / unarchiving produces same result
     VerifyArchiveAndUnarchivingMap<ElementType>(map, computeNode, inputWithPadding, output, info);
 }
+
+void TestSpatialConvolutionNodeEpilogue(int columnTile)
+{
+    using ElementType = float;
+    using LayerParameters = typename Layer<ElementType>::LayerParameters;
+    using TensorType = typename Layer<ElementType>::TensorType;
+    using Shape = typename Layer<ElementType>::Shape;
+
+    // 4 x 4 x 3 input with padding 1, and one 3 x 3 filter per channel
+    const int rows = 4;
+    const int columns = 4;
+    const int channels = 3;
+    const size_t inputPaddingSize = 1;
+    TensorType inputWithPadding(rows + 2 * inputPaddingSize, columns + 2 * inputPaddingSize, channels);
+    inputWithPadding.Fill(0);
+    std::vector<ElementType> inputValues(rows * columns * channels);
+    FillRandomVector(inputValues);
+    auto inputValue = inputValues.begin();
+    for (int i = 0; i < rows; ++i)
+    {
+        for (int j = 0; j < columns; ++j)
+        {
+            for (int c = 0; c < channels; ++c)
+            {
+                inputWithPadding(i + inputPaddingSize, j + inputPaddingSize, c) = *inputValue++;
+            }
+        }
+    }
+
+    Shape outputShape = { rows, columns, channels };
+    LayerParameters parameters{ inputWithPadding, ZeroPadding(inputPaddingSize), outputShape, NoPadding() };
+    ConvolutionalParameters convolutionalParams{ 3, 1, ConvolutionMethod::automatic, 1 };
+    TensorType weights(convolutionalParams.receptiveField * channels, convolutionalParams.receptiveField, 1);
+    std::vector<ElementType> weightsValues(weights.Size());
+    FillRandomVector(weightsValues);
+    auto weightsValue = weightsValues.begin();
+    for (size_t i = 0; i < weights.NumRows(); ++i)
+    {
+        for (size_t j = 0; j < weights.NumColumns(); ++j)
+        {
+            weights(i, j, 0) = *weightsValue++;
+        }
+    }
+
+    ConvolutionalLayer<ElementType> layer(parameters, convolutionalParams, weights);
+    layer.Compute();
+    auto layerOutput = layer.GetOutput();
+
+    // output = ReLU(scale * convolution + bias), with one scale and bias entry per channel
+    std::vector<ElementType> scale = { 0.5f, 2.0f, -1.0f };
+    std::vector<ElementType> bias = { 0.25f, -0.5f, 0.0f };
+    OutputEpilogue<ElementType> epilogue;
+    epilogue.AppendLinearFunction(scale, bias);
+    epilogue.AppendActivation({ new ReLUActivation<ElementType>() });
+
+    std::vector<ElementType> expectedOutput;
+    for (int i = 0; i < rows; ++i)
+    {
+        for (int j = 0; j < columns; ++j)
+        {
+            for (int c = 0; c < channels; ++c)
+            {
+                expectedOutput.push_back(std::max(scale[c] * layerOutput(i, j, c) + bias[c], 0.0f));
+            }
+        }
+    }
+
+    model::Model model;
+    auto inputMemoryLayout = utilities::MemoryLayout(utilities::MemoryShape{ rows, columns, channels }, utilities::MemoryShape{ static_cast<int>(inputPaddingSize), static_cast<int>(inputPaddingSize), 0 });
+    auto inputNode = model.AddNode<model::InputNode<ElementType>>(inputMemoryLayout);
+    auto outputMemoryLayout = utilities::MemoryLayout(utilities::MemoryShape{ rows, columns, channels });
+    auto computeNode = model.AddNode<SpatialConvolutionNode<ElementType>>(inputNode->output, layer, outputMemoryLayout, columnTile, epilogue);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", computeNode->output } });
+
+    model::MapCompilerOptions settings;
+    model::ModelOptimizerOptions optimizerOptions;
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    auto compiledMap = compiler.Compile(map);
+
+    std::vector<std::vector<ElementType>> signal = { inputWithPadding.ToArray() };
+    std::vector<std::vector<ElementType>> expected = { expectedOutput };
+    VerifyCompiledOutputAndResult(map, compiledMap, signal, expected, "SpatialConvolutionNode with epilogue (columnTile = " + std::to_string(columnTile) + ")", "", 1e-4);
+}
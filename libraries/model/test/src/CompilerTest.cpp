@@ -18,6 +18,7 @@
 #include <model/include/Model.h>
 
 #include <nodes/include/AccumulatorNode.h>
+#include <nodes/include/BinaryOperationNode.h>
 #include <nodes/include/ClockNode.h>
 #include <nodes/include/ConstantNode.h>
 #include <nodes/include/DelayNode.h>
@@ -25,12 +26,15 @@
 #include <nodes/include/ForestPredictorNode.h>
 #include <nodes/include/L2NormSquaredNode.h>
 #include <nodes/include/LinearPredictorNode.h>
+#include <nodes/include/MatrixMatrixMultiplyNode.h>
+#include <nodes/include/MatrixVectorMultiplyNode.h>
 #include <nodes/include/MatrixVectorProductNode.h>
 #include <nodes/include/ProtoNNPredictorNode.h>
 #include <nodes/include/SinkNode.h>
 #include <nodes/include/SourceNode.h>
 #include <nodes/include/SquaredEuclideanDistanceNode.h>
 #include <nodes/include/SumNode.h>
+#include <nodes/include/UnaryOperationNode.h>
 
 #include <emitters/include/EmitterException.h>
 #include <emitters/include/EmitterTypes.h>
@@ -43,6 +47,7 @@
 #include <predictors/include/LinearPredictor.h>
 #include <predictors/include/ProtoNNPredictor.h>
 
+#include <utilities/include/Files.h>
 #include <utilities/include/Logger.h>
 #include <utilities/include/RandomEngines.h>
 
@@ -50,6 +55,8 @@
 
 #include <algorithm>
 #include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <future>
 #include <iostream>
 #include <memory>
@@ -161,6 +168,112 @@ void TestSimpleMap(bool optimize)
     VerifyCompiledOutput(map, compiledMap, signal, " map");
 }
 
+void TestReusePortMemoryMap()
+{
+    // Two branches that merge, followed by a chain, so that some intermediate buffers can share memory
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(4);
+    const auto& branch1 = nodes::Square(inputNode->output);
+    const auto& branch2 = nodes::Abs(inputNode->output);
+    const auto& merged = nodes::Add(branch1, branch2);
+    const auto& chain1 = nodes::Multiply(merged, branch1);
+    const auto& chain2 = nodes::Sqrt(chain1);
+    const auto& chain3 = nodes::Add(chain2, chain2);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", chain3 } });
+
+    model::MapCompilerOptions settings;
+    settings.moduleName = "TestReuse";
+    settings.reusePortMemory = true;
+    model::ModelOptimizerOptions optimizerOptions;
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    auto compiledMap = compiler.Compile(map);
+
+    testing::ProcessTest("Testing reusePortMemory emits scratch size function", compiler.GetModule().HasFunction("TestReuse_GetScratchSize"));
+
+    std::vector<std::vector<double>> signal = { { 1, -2, 3, -4 }, { 4, 5, 6, 7 }, { -7, 8, 9, 0.5 }, { 3, 4, 5, 6 } };
+    VerifyCompiledOutput(map, compiledMap, signal, " reusePortMemory map");
+}
+
+void TestPredictBatchMap()
+{
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(3);
+    const auto& squared = nodes::Square(inputNode->output);
+    const auto& sum = nodes::Add(squared, inputNode->output);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", sum } });
+
+    model::MapCompilerOptions settings;
+    settings.moduleName = "TestBatch";
+    model::ModelOptimizerOptions optimizerOptions;
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    auto compiledMap = compiler.Compile(map);
+
+    testing::ProcessTest("Testing compiled map emits batch predict function", compiler.GetModule().HasFunction("TestBatch_PredictBatch"));
+
+    const int batchSize = 4;
+    std::vector<double> batchInput = { 1, -2, 3, 4, 5, 6, -7, 8, 9, 0.5, 0.25, -1 };
+    std::vector<double> batchOutput(batchSize * 3);
+    compiledMap.ComputeBatch({ batchInput.data() }, { batchOutput.data() }, batchSize);
+
+    std::vector<double> expected;
+    for (int i = 0; i < batchSize; ++i)
+    {
+        std::vector<double> sample(batchInput.begin() + 3 * i, batchInput.begin() + 3 * (i + 1));
+        auto output = compiledMap.Compute<double>(sample);
+        expected.insert(expected.end(), output.begin(), output.end());
+    }
+    testing::ProcessTest("Testing ComputeBatch matches per-sample Compute", testing::IsEqual(batchOutput, expected));
+}
+
+void TestPredictBatchMapWithMatrixProduct()
+{
+    // A fully-connected layer followed by an activation
+    const int inputSize = 3;
+    const int outputSize = 2;
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(inputSize);
+    math::RowMatrix<double> weights{
+        { 0.5, -1.0, 2.0 },
+        { 1.5, 0.25, -0.75 }
+    };
+    auto productNode = model.AddNode<nodes::MatrixVectorProductNode<double, math::MatrixLayout::rowMajor>>(inputNode->output, weights);
+    const auto& sum = nodes::Add(productNode->output, nodes::Constant(model, std::vector<double>{ 0.1, -0.2 }));
+    const auto& activation = nodes::Square(sum);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", activation } });
+
+    model::MapCompilerOptions settings;
+    settings.moduleName = "TestBatchGEMM";
+    settings.batchSize = 4;
+    model::ModelOptimizerOptions optimizerOptions;
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    auto compiledMap = compiler.Compile(map);
+
+    const auto& compiledModel = compiledMap.GetModel();
+    auto numMatrixMatrixProducts = compiledModel.GetNodesByType<nodes::MatrixMatrixMultiplyNode<double>>().size();
+    auto numMatrixVectorProducts = compiledModel.GetNodesByType<nodes::MatrixVectorMultiplyNode<double>>().size();
+    testing::ProcessTest("Testing batched map computes its matrix-vector products with one matrix-matrix product", numMatrixMatrixProducts == 1 && numMatrixVectorProducts == 0);
+    testing::ProcessTest("Testing batched map inputs and outputs hold the whole batch", compiledMap.GetCompiledBatchSize() == 4 && compiledMap.GetInputSize(0) == 4 * inputSize && compiledMap.GetOutputSize(0) == 4 * outputSize);
+
+    // One full batch, and 2 samples that get padded out to a batch
+    const int batchSize = 6;
+    std::vector<double> batchInput(batchSize * inputSize);
+    for (size_t index = 0; index < batchInput.size(); ++index)
+    {
+        batchInput[index] = 0.5 * index - 4.0;
+    }
+    std::vector<double> batchOutput(batchSize * outputSize);
+    compiledMap.ComputeBatch({ batchInput.data() }, { batchOutput.data() }, batchSize);
+
+    std::vector<double> expected;
+    for (int i = 0; i < batchSize; ++i)
+    {
+        std::vector<double> sample(batchInput.begin() + inputSize * i, batchInput.begin() + inputSize * (i + 1));
+        auto output = map.Compute<double>(sample);
+        expected.insert(expected.end(), output.begin(), output.end());
+    }
+    testing::ProcessTest("Testing batched ComputeBatch matches per-sample Compute", testing::IsEqual(batchOutput, expected, 1e-10));
+}
+
 void TestSqEuclideanDistanceMap()
 {
     model::Model model;
@@ -267,6 +380,74 @@ void TestProtoNNPredictorMap()
     }
 }
 
+void TestProtoNNPredictorMapWithPrototypeOnInput()
+{
+    // A prototype that lies exactly on the projected input has similarity exp(0) = 1; the refined model expands the
+    // squared distance, so large norms and a large gamma exercise the cancellation in the exponent
+    size_t dim = 4, projectedDim = 3, numPrototypes = 3, numLabels = 2;
+    double gamma = 4.0;
+    predictors::ProtoNNPredictor protonnPredictor(dim, projectedDim, numPrototypes, numLabels, gamma);
+
+    auto& W = protonnPredictor.GetProjectionMatrix();
+    W = {
+        { 0.3, -1.7, 2.1, 0.9 },
+        { 1.1, 0.4, -0.6, 2.7 },
+        { -2.3, 0.8, 1.3, -0.2 }
+    };
+
+    std::vector<double> input = { 123.456, -78.9, 45.678, 91.011 };
+    auto& B = protonnPredictor.GetPrototypes();
+    B = {
+        { 0.0, 10.0, -5.0 },
+        { 0.0, -3.0, 8.0 },
+        { 0.0, 6.0, 2.0 }
+    };
+    for (size_t i = 0; i < projectedDim; ++i)
+    {
+        double value = 0;
+        for (size_t j = 0; j < dim; ++j)
+        {
+            value += W(i, j) * input[j];
+        }
+        B(i, 0) = value;
+    }
+
+    auto& Z = protonnPredictor.GetLabelEmbeddings();
+    Z = {
+        { 1.0, 0.25, 0.5 },
+        { 0.5, 1.0, 0.75 }
+    };
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(dim);
+    auto protonnPredictorNode = model.AddNode<nodes::ProtoNNPredictorNode>(inputNode->output, protonnPredictor);
+    auto outputNode = model.AddNode<model::OutputNode<double>>(protonnPredictorNode->output);
+    auto map = model::Map{ model, { { "input", inputNode } }, { { "output", outputNode->output } } };
+
+    model::MapCompilerOptions settings;
+    model::ModelOptimizerOptions optimizerOptions;
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    auto compiledMap = compiler.Compile(map);
+
+    auto expected = protonnPredictor.Predict(input).ToArray();
+
+    compiledMap.SetInputValue(0, input);
+    auto compiledOutput = compiledMap.ComputeOutput<double>(0);
+    testing::ProcessTest("ProtoNN: compiled output matches predictor with a prototype on the projected input", IsEqual(expected, compiledOutput, 1e-6));
+
+    bool isBounded = true;
+    for (size_t label = 0; label < numLabels; ++label)
+    {
+        double maxScore = 0;
+        for (size_t prototype = 0; prototype < numPrototypes; ++prototype)
+        {
+            maxScore += Z(label, prototype);
+        }
+        isBounded = isBounded && compiledOutput[label] <= maxScore;
+    }
+    testing::ProcessTest("ProtoNN: compiled scores are bounded by the label embeddings", isBounded);
+}
+
 void TestCombineOutputMap()
 {
     model::Model model;
@@ -421,6 +602,85 @@ void TestCompiledMapParallelClone()
     }
 }
 
+void TestCompiledMapCache()
+{
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(4);
+    auto constantNode = model.AddNode<nodes::ConstantNode<double>>(std::vector<double>{ 5.0, 5.0, 7.0, 3.0 });
+    auto addNode = model.AddNode<nodes::BinaryOperationNode<double>>(inputNode->output, constantNode->output, nodes::BinaryOperationType::add);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", addNode->output } });
+
+    auto cacheDirectory = utilities::JoinPaths(utilities::GetWorkingDirectory(), "TestCompiledMapCache");
+    std::filesystem::remove_all(cacheDirectory);
+    auto countCacheFiles = [&cacheDirectory](const std::string& extension) {
+        return std::count_if(std::filesystem::directory_iterator(cacheDirectory), std::filesystem::directory_iterator(), [&extension](const auto& entry) {
+            return entry.path().extension() == extension;
+        });
+    };
+
+    auto getCacheFile = [&cacheDirectory](const std::string& extension) {
+        for (const auto& entry : std::filesystem::directory_iterator(cacheDirectory))
+        {
+            if (entry.path().extension() == extension)
+            {
+                return entry.path();
+            }
+        }
+        return std::filesystem::path();
+    };
+
+    model::MapCompilerOptions settings;
+    settings.compiledMapCachePath = cacheDirectory;
+    std::vector<std::vector<double>> signal = { { 1, 2, 3, 4 }, { 4, 5, 6, 7 }, { 7, 8, 9, 10 } };
+
+    // The first compilation fills in the cache: bitcode when the map is compiled, and object code when it's JITted
+    model::IRMapCompiler compiler1(settings, {});
+    auto compiledMap1 = compiler1.Compile(map);
+    VerifyCompiledOutput(map, compiledMap1, signal, " map compiled with an empty cache");
+    testing::ProcessTest("Testing compiled map cache entries", !compiledMap1.IsLoadedFromCache() && countCacheFiles(".bc") == 1 && countCacheFiles(".o") == 1 && countCacheFiles(".tmp") == 0);
+
+    // The second compilation loads the map from the cache, and neither compiles the map nor generates machine code
+    model::IRMapCompiler compiler2(settings, {});
+    auto compiledMap2 = compiler2.Compile(map);
+    VerifyCompiledOutput(map, compiledMap2, signal, " map loaded from the cache");
+    testing::ProcessTest("Testing compiled map cache reuses entries", compiledMap2.IsLoadedFromCache() && countCacheFiles(".bc") == 1 && countCacheFiles(".o") == 1);
+
+    // A damaged object file is a miss: the machine code is generated again, and the entry is replaced
+    {
+        std::fstream objectFile(getCacheFile(".o"), std::ios::in | std::ios::out | std::ios::binary);
+        objectFile.seekg(-1, std::ios::end);
+        auto lastByte = static_cast<char>(objectFile.get() ^ 0xff);
+        objectFile.seekp(-1, std::ios::end);
+        objectFile.put(lastByte);
+    }
+    model::IRMapCompiler compiler3(settings, {});
+    auto compiledMap3 = compiler3.Compile(map);
+    VerifyCompiledOutput(map, compiledMap3, signal, " map with a damaged object file");
+    testing::ProcessTest("Testing compiled map cache rejects damaged object code", !compiledMap3.IsLoadedFromCache());
+
+    model::IRMapCompiler compiler4(settings, {});
+    auto compiledMap4 = compiler4.Compile(map);
+    VerifyCompiledOutput(map, compiledMap4, signal, " map with a replaced object file");
+    testing::ProcessTest("Testing compiled map cache replaces damaged object code", compiledMap4.IsLoadedFromCache());
+
+    // A truncated bitcode file is a miss too
+    auto bitcodeFile = getCacheFile(".bc");
+    std::filesystem::resize_file(bitcodeFile, std::filesystem::file_size(bitcodeFile) / 2);
+    model::IRMapCompiler compiler5(settings, {});
+    auto compiledMap5 = compiler5.Compile(map);
+    VerifyCompiledOutput(map, compiledMap5, signal, " map with a truncated bitcode file");
+    testing::ProcessTest("Testing compiled map cache rejects truncated bitcode", !compiledMap5.IsLoadedFromCache() && countCacheFiles(".bc") == 1 && countCacheFiles(".tmp") == 0);
+
+    // Different compiler options make a different entry
+    settings.compilerSettings.optimize = false;
+    model::IRMapCompiler compiler6(settings, {});
+    auto compiledMap6 = compiler6.Compile(map);
+    VerifyCompiledOutput(map, compiledMap6, signal, " unoptimized map");
+    testing::ProcessTest("Testing compiled map cache keys on compiler options", !compiledMap6.IsLoadedFromCache() && countCacheFiles(".bc") == 2 && countCacheFiles(".o") == 2);
+
+    std::filesystem::remove_all(cacheDirectory);
+}
+
 typedef void (*MapPredictFunction)(void* context, double*, double*);
 
 void TestBinaryVector(bool expanded, bool runJit)
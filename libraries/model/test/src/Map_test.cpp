@@ -19,6 +19,7 @@
 #include <model/include/Model.h>
 #include <model/include/OutputNode.h>
 
+#include <nodes/include/BinaryOperationNode.h>
 #include <nodes/include/ClockNode.h>
 #include <nodes/include/ExtremalValueNode.h>
 #include <nodes/include/MovingAverageNode.h>
@@ -101,6 +102,55 @@ void TestMapComputeDataVector()
     testing::ProcessTest("Testing map compute 2", testing::IsEqual(resultValues[0], 8.5) && testing::IsEqual(resultValues[1], 10.5));
 }
 
+void TestMapParallelCompute()
+{
+    auto model = GetSimpleModel();
+    auto inputNodes = model.GetNodesByType<model::InputNode<double>>();
+    auto outputNodes = model.GetNodesByType<model::OutputNode<double>>();
+    auto sequentialMap = model::Map(model, { { "doubleInput", inputNodes[0] } }, { { "doubleOutput", outputNodes[0]->output } });
+    auto parallelMap = model::Map(model, { { "doubleInput", inputNodes[0] } }, { { "doubleOutput", outputNodes[0]->output } });
+    parallelMap.EnableParallelCompute(4);
+
+    auto input = std::vector<std::vector<double>>{ { 1.0, 2.0, 3.0 },
+                                                   { 4.0, 5.0, 6.0 },
+                                                   { 7.0, 8.0, 9.0 },
+                                                   { 10.0, 11.0, 12.0 } };
+    bool ok = parallelMap.IsParallelComputeEnabled();
+    std::vector<double> resultValues;
+    for (const auto& inVec : input)
+    {
+        auto expected = sequentialMap.Compute<double>(inVec);
+        resultValues = parallelMap.Compute<double>(inVec);
+        ok = ok && testing::IsEqual(resultValues, expected);
+    }
+
+    testing::ProcessTest("Testing parallel map compute", ok && testing::IsEqual(resultValues[0], 8.5) && testing::IsEqual(resultValues[1], 10.5));
+
+    // Two independent branches, x * x * x and x + x, that merge into x^3 - 2x
+    model::Model branchingModel;
+    auto branchInputNode = branchingModel.AddNode<model::InputNode<double>>(3);
+    const auto& x = branchInputNode->output;
+    auto squareNode = branchingModel.AddNode<nodes::BinaryOperationNode<double>>(x, x, nodes::BinaryOperationType::multiply);
+    auto cubeNode = branchingModel.AddNode<nodes::BinaryOperationNode<double>>(squareNode->output, x, nodes::BinaryOperationType::multiply);
+    auto doubleNode = branchingModel.AddNode<nodes::BinaryOperationNode<double>>(x, x, nodes::BinaryOperationType::add);
+    auto mergeNode = branchingModel.AddNode<nodes::BinaryOperationNode<double>>(cubeNode->output, doubleNode->output, nodes::BinaryOperationType::subtract);
+    auto branchOutputNode = branchingModel.AddNode<model::OutputNode<double>>(mergeNode->output);
+
+    auto sequentialBranchingMap = model::Map(branchingModel, { { "input", branchInputNode } }, { { "output", branchOutputNode->output } });
+    auto parallelBranchingMap = model::Map(branchingModel, { { "input", branchInputNode } }, { { "output", branchOutputNode->output } });
+    parallelBranchingMap.EnableParallelCompute(4);
+
+    bool branchesOk = parallelBranchingMap.IsParallelComputeEnabled();
+    for (const auto& inVec : input)
+    {
+        auto expected = sequentialBranchingMap.Compute<double>(inVec);
+        auto result = parallelBranchingMap.Compute<double>(inVec);
+        branchesOk = branchesOk && testing::IsEqual(result, expected);
+    }
+    auto lastResult = parallelBranchingMap.Compute<double>(input.back());
+    testing::ProcessTest("Testing parallel map compute with merging branches", branchesOk && testing::IsEqual(lastResult, std::vector<double>{ 980.0, 1309.0, 1704.0 }));
+}
+
 void TestMapRefine()
 {
     auto model = GetSimpleModel();
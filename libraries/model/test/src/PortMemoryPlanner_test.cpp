@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     PortMemoryPlanner_test.cpp (model_test)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PortMemoryPlanner_test.h"
+
+#include <model/include/PortMemoryPlanner.h>
+
+#include <testing/include/testing.h>
+
+#include <vector>
+
+using namespace ell;
+
+namespace
+{
+bool RangesOverlap(size_t offset1, size_t size1, size_t offset2, size_t size2)
+{
+    return offset1 < offset2 + size2 && offset2 < offset1 + size1;
+}
+} // namespace
+
+void TestPortMemoryPlannerChain()
+{
+    // A chain of layers: each buffer is written by one step and read by the next
+    model::PortMemoryPlanner planner;
+    auto b0 = planner.AddBuffer(100, 0, 1);
+    auto b1 = planner.AddBuffer(200, 1, 2);
+    auto b2 = planner.AddBuffer(100, 2, 3);
+    auto b3 = planner.AddBuffer(50, 3, 4);
+    planner.Plan();
+
+    testing::ProcessTest("PortMemoryPlanner chain total size", testing::IsEqual(planner.GetTotalBufferSize(), size_t{ 450 }));
+    testing::ProcessTest("PortMemoryPlanner chain arena size", testing::IsEqual(planner.GetArenaSize(), size_t{ 300 }));
+    testing::ProcessTest("PortMemoryPlanner chain adjacent buffers don't overlap",
+                         !RangesOverlap(planner.GetOffset(b0), 100, planner.GetOffset(b1), 200) &&
+                             !RangesOverlap(planner.GetOffset(b1), 200, planner.GetOffset(b2), 100) &&
+                             !RangesOverlap(planner.GetOffset(b2), 100, planner.GetOffset(b3), 50));
+}
+
+void TestPortMemoryPlannerOverlappingLifetimes()
+{
+    // Two parallel branches that merge, plus a buffer that lives through the whole graph
+    model::PortMemoryPlanner planner;
+    std::vector<size_t> sizes = { 64, 32, 32, 16, 8 };
+    std::vector<std::pair<int, int>> lifetimes = { { 0, 5 }, { 1, 3 }, { 2, 3 }, { 3, 4 }, { 4, 5 } };
+    for (size_t index = 0; index < sizes.size(); ++index)
+    {
+        planner.AddBuffer(sizes[index], lifetimes[index].first, lifetimes[index].second);
+    }
+    planner.Plan();
+
+    bool ok = true;
+    for (size_t i = 0; i < sizes.size(); ++i)
+    {
+        for (size_t j = i + 1; j < sizes.size(); ++j)
+        {
+            bool aliveTogether = lifetimes[i].first <= lifetimes[j].second && lifetimes[j].first <= lifetimes[i].second;
+            if (aliveTogether && RangesOverlap(planner.GetOffset(i), sizes[i], planner.GetOffset(j), sizes[j]))
+            {
+                ok = false;
+            }
+        }
+        ok = ok && planner.GetOffset(i) + sizes[i] <= planner.GetArenaSize();
+    }
+    testing::ProcessTest("PortMemoryPlanner live buffers never share memory", ok);
+    testing::ProcessTest("PortMemoryPlanner reuses memory", planner.GetArenaSize() < planner.GetTotalBufferSize());
+}
+
+void TestPortMemoryPlannerAlignment()
+{
+    model::PortMemoryPlanner planner(32);
+    auto b0 = planner.AddBuffer(12, 0, 1);
+    auto b1 = planner.AddBuffer(40, 0, 1);
+    planner.Plan();
+
+    testing::ProcessTest("PortMemoryPlanner aligned offsets", planner.GetOffset(b0) % 32 == 0 && planner.GetOffset(b1) % 32 == 0);
+    testing::ProcessTest("PortMemoryPlanner aligned arena size", testing::IsEqual(planner.GetArenaSize(), size_t{ 96 }));
+}
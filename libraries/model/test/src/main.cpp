@@ -17,6 +17,7 @@
 #include "ModelTransformerTest.h"
 #include "Model_test.h"
 #include "PortElements_test.h"
+#include "PortMemoryPlanner_test.h"
 #include "Submodel_test.h"
 
 #include <testing/include/testing.h>
@@ -49,10 +50,16 @@ int main()
         TestParsePortElements();
         TestConvertPortElements();
 
+        // PortMemoryPlanner tests
+        TestPortMemoryPlannerChain();
+        TestPortMemoryPlannerOverlappingLifetimes();
+        TestPortMemoryPlannerAlignment();
+
         // Map tests
         TestMapCreate();
         TestMapCompute();
         TestMapComputeDataVector();
+        TestMapParallelCompute();
         TestMapRefine();
         TestMapSerialization();
         TestMapClockNode();
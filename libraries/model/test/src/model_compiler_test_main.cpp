@@ -68,9 +68,13 @@ void TestIRCompiler()
     TestCompileIsEqual();
     TestSimpleMap(false);
     TestSimpleMap(true);
+    TestReusePortMemoryMap();
+    TestPredictBatchMap();
+    TestPredictBatchMapWithMatrixProduct();
     TestCompiledMapMove();
     TestCompiledMapClone();
     TestCompiledMapParallelClone();
+    TestCompiledMapCache();
 
     TestBinaryScalar();
     TestBinaryVector(true);
@@ -126,6 +130,17 @@ void TestIRCompiler()
 
     TestMatrixMatrixMultiplyCodeNodeImplementations();
 
+    // Epilogues: single-threaded with a partial last K panel, then split between threads by rows and by columns
+    TestMatrixMatrixMultiplyCodeNodeEpilogue(8, 16, 40, 16);
+    TestMatrixMatrixMultiplyCodeNodeEpilogue(64, 32, 128, 32);
+    TestMatrixMatrixMultiplyCodeNodeEpilogue(32, 64, 128, 32);
+
+    // Quantized products, including sizes that aren't multiples of the vector width
+    TestQuantizedMatrixMatrixMultiplyNode(4, 3, 8, false);
+    TestQuantizedMatrixMatrixMultiplyNode(7, 5, 19, false);
+    TestQuantizedMatrixMatrixMultiplyNode(7, 5, 19, true);
+    TestQuantizedMatrixMatrixMultiplyNodeChain();
+
     TestCompilableScalarOutputNode();
     TestCompilableVectorOutputNode();
     TestCompilableAccumulatorNode();
@@ -251,6 +266,12 @@ void TestIRCompiler()
     TestBinaryConvolutionalLayerNode(32, 32, 3, 4, 1, 0, PaddingScheme::minusOnes, false);
     TestBinaryConvolutionalLayerNode(32, 32, 3, 4, 1, 0, PaddingScheme::minusOnes, true);
 
+    // 32 channels make 5 packed words per filter (2 vector blocks and a remainder), and 5-7 filters leave a partial filter block
+    TestBinaryConvolutionalLayerNode(8, 8, 32, 5, 1, 0, PaddingScheme::zeros, true, true);
+    TestBinaryConvolutionalLayerNode(8, 8, 32, 6, 1, 0, PaddingScheme::minusOnes, false, true);
+    TestBinaryConvolutionalLayerNode(8, 8, 32, 7, 1, 0, PaddingScheme::zeros, false, true);
+    TestBinaryConvolutionalLayerNode(8, 8, 32, 7, 1, 0, PaddingScheme::minusOnes, true, false);
+
     // TestConvolutionalLayerNode(ConvolutionMethod::unrolled);
     TestConvolutionalLayerNode(ConvolutionMethod::unrolled, 1, 0);
 
@@ -272,6 +293,8 @@ void TestIRCompiler()
 
 	//BUGBUG: This test currently fails for Compute but passes for Compile.
 	//TestSpatialConvolutionNode(1, 0);
+    TestSpatialConvolutionNodeEpilogue(0);
+    TestSpatialConvolutionNodeEpilogue(2);
 
     TestFullyConnectedLayerNode();
     // TestFullyConnectedLayerNode(0, 1); // Fully-connected layer nodes can't have padding (yet)
@@ -279,6 +302,7 @@ void TestIRCompiler()
     // TestFullyConnectedLayerNode(1, 1); // Fully-connected layer nodes can't have padding (yet)
 
     TestProtoNNPredictorMap();
+    TestProtoNNPredictorMapWithPrototypeOnInput();
     TestMultiSourceSinkMap();
 
     TestRegionDetectionNode();
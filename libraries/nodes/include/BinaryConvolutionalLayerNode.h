@@ -19,6 +19,7 @@
 
 #include <string>
 #include <type_traits>
+#include <vector>
 
 namespace ell
 {
@@ -196,7 +197,7 @@ namespace nodes
         /// <param name="convolutionalParameters"> The convolutional parameters. </param>
         /// <param name="inputPaddingParameters"> The input padding parameters. </param>
         /// <param name="inputMemoryLayout"> The layout of the input data. </param>
-        /// <param name="outputMemoryLayout"> The layout of the output data. </param>
+        /// <param name="outputMemoryLayout"> The layout of the output data, in the canonical (h x w x f) order. </param>
         BinaryXnorNode(const model::OutputPort<PackedBitsType>& input,
                        const model::OutputPort<PackedBitsType>& inputPaddingMasks,
                        const model::OutputPort<int>& inputPaddingMaskSums,
@@ -235,7 +236,7 @@ namespace nodes
     protected:
         void Compute() const override;
         void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
-        void ComputeFilterOutput(model::IRMapCompiler& compiler,
+        void ComputeOutputColumn(model::IRMapCompiler& compiler,
                                  emitters::IRFunctionEmitter& function,
                                  emitters::LLVMValue pInput,
                                  emitters::LLVMValue pFilterWeights,
@@ -243,14 +244,30 @@ namespace nodes
                                  emitters::LLVMValue pInputPaddingMask,
                                  emitters::LLVMValue pInputPaddingMaskSums,
                                  emitters::LLVMValue pOutput,
-                                 emitters::LLVMValue filterIndex,
+                                 emitters::LLVMValue outputColumnIndex,
                                  bool hasZeroPadding,
-                                 int outputColumns,
+                                 int numFilters,
                                  int packedRowSize,
                                  int packedRowStride,
-                                 bool useVectorInstructions,
                                  int vectorSize,
                                  int numVectorBlocks);
+        void ComputeFilterBlockOutput(model::IRMapCompiler& compiler,
+                                      emitters::IRFunctionEmitter& function,
+                                      emitters::LLVMValue pInput,
+                                      emitters::LLVMValue pFilterWeights,
+                                      emitters::LLVMValue pFilterMeans,
+                                      emitters::LLVMValue pInputPaddingMask,
+                                      emitters::LLVMValue pInputPaddingMaskSums,
+                                      emitters::LLVMValue pOutput,
+                                      emitters::LLVMValue outputColumnIndex,
+                                      emitters::LLVMValue filterBlockStart,
+                                      int filterBlockSize,
+                                      bool hasZeroPadding,
+                                      int numFilters,
+                                      int packedRowSize,
+                                      int packedRowStride,
+                                      int vectorSize,
+                                      int numVectorBlocks);
 
         bool HasState() const override { return true; } // stored state: convolutional parameters and input/output memory layouts
         void WriteToArchive(utilities::Archiver& archiver) const override;
@@ -262,8 +279,8 @@ namespace nodes
         void EmitInnerLoop(emitters::IRFunctionEmitter& function,
                            emitters::LLVMValue reshapedInput,
                            emitters::LLVMValue paddingMask,
-                           emitters::LLVMValue weights,
-                           emitters::LLVMValue xorSumVariable,
+                           const std::vector<emitters::LLVMValue>& weights,
+                           const std::vector<emitters::LLVMValue>& xorSumVariables,
                            emitters::LLVMFunction popCountFunction,
                            int startBlock,
                            int numBlocks,
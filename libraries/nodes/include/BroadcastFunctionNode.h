@@ -334,10 +334,9 @@ namespace nodes
         using BroadcastFunctionNode<ValueType, FunctionType>::GetOutputMemoryLayout;
         using BroadcastFunctionNode<ValueType, FunctionType>::GetBroadcastDimension;
         using BroadcastFunctionNode<ValueType, FunctionType>::NumPrimaryInputDimensions;
-
-    protected:
         using BroadcastFunctionNode<ValueType, FunctionType>::GetFunction;
 
+    protected:
         utilities::ArchiveVersion GetArchiveVersion() const override;
         bool CanReadArchiveVersion(const utilities::ArchiveVersion& version) const override;
         void WriteToArchive(utilities::Archiver& archiver) const override;
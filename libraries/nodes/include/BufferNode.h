@@ -68,6 +68,8 @@ namespace nodes
         /// <returns> The window size </returns>
         size_t GetWindowSize() const { return _windowSize; }
 
+        bool IsStateful() const override { return true; } // runtime state: the samples in the buffer
+
     protected:
         void Define(value::FunctionDeclaration& fn) override;
         void DefineReset(value::FunctionDeclaration& fn) override;
@@ -76,6 +76,8 @@ namespace nodes
         /// <summary> Get the custom name of the lag notification callback function. </summary>
         std::string GetLagNotificationFunctionName() const { return _lagNotificationFunctionName; }
 
+        bool IsStateful() const override { return true; } // reads the current time
+
     protected:
         void Compute() const override;
         void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
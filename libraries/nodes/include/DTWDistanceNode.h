@@ -67,6 +67,8 @@ namespace nodes
         /// <summary> Reset the state of the node </summary>
         void Reset() override;
 
+        bool IsStateful() const override { return true; } // runtime state: the alignment costs of the recent inputs
+
     protected:
         void Compute() const override;
         void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
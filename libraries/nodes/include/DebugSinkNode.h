@@ -73,6 +73,8 @@ namespace nodes
         /// <returns> The node label. </returns>
         virtual std::string GetLabel() const { return _label; }
 
+        bool IsStateful() const override { return true; } // calls a user-supplied function
+
     protected:
         bool ShouldCompileInline() const override;
         void Compute() const override;
@@ -60,6 +60,8 @@ namespace nodes
         /// <summary>Return the window size</summary>
         size_t GetWindowSize() const { return _windowSize; }
 
+        bool IsStateful() const override { return true; } // runtime state: the delayed samples
+
     protected:
         void Compute() const override;
         void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ExponentialMovingAverageNode.h (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <model/include/CompilableNode.h>
+#include <model/include/IRMapCompiler.h>
+#include <model/include/InputPort.h>
+#include <model/include/MapCompiler.h>
+#include <model/include/ModelTransformer.h>
+#include <model/include/Node.h>
+#include <model/include/OutputPort.h>
+
+#include <utilities/include/Exception.h>
+#include <utilities/include/TypeName.h>
+
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace nodes
+{
+    /// <summary>
+    /// A node that computes the exponential moving average of each channel of its input:
+    /// `y[t] = y[t-1] + smoothingFactor * (x[t] - y[t-1])`, with `y[-1] = 0`.
+    /// </summary>
+    template <typename ValueType>
+    class ExponentialMovingAverageNode : public model::CompilableNode
+    {
+    public:
+        /// @name Input and Output Ports
+        /// @{
+        const model::InputPort<ValueType>& input = _input;
+        const model::OutputPort<ValueType>& output = _output;
+        /// @}
+
+        /// <summary> Default Constructor </summary>
+        ExponentialMovingAverageNode();
+
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="input"> The signal to average. </param>
+        /// <param name="smoothingFactor"> The weight of the newest sample, in (0, 1]. </param>
+        ExponentialMovingAverageNode(const model::OutputPort<ValueType>& input, ValueType smoothingFactor);
+
+        /// <summary> Gets the weight of the newest sample. </summary>
+        ValueType GetSmoothingFactor() const { return _smoothingFactor; }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        static std::string GetTypeName() { return utilities::GetCompositeTypeName<ValueType>("ExponentialMovingAverageNode"); }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        std::string GetRuntimeTypeName() const override { return GetTypeName(); }
+
+        /// <summary> Resets any state on the node, if any </summary>
+        void Reset() override;
+
+        bool IsStateful() const override { return true; } // runtime state: the current average
+
+    protected:
+        void Compute() const override;
+        void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
+        void WriteToArchive(utilities::Archiver& archiver) const override;
+        void ReadFromArchive(utilities::Unarchiver& archiver) override;
+        bool HasState() const override { return true; } // stored state: smoothing factor and the current average
+
+    private:
+        void Copy(model::ModelTransformer& transformer) const override;
+
+        // Inputs
+        model::InputPort<ValueType> _input;
+
+        // Output
+        model::OutputPort<ValueType> _output;
+
+        ValueType _smoothingFactor;
+        mutable std::vector<ValueType> _average;
+    };
+
+    /// <summary> Convenience function for adding a node to a model. </summary>
+    ///
+    /// <param name="input"> The port to get the input data from </param>
+    /// <param name="smoothingFactor"> The weight of the newest sample, in (0, 1]. </param>
+    ///
+    /// <returns> The output of the new node. </returns>
+    template <typename ValueType>
+    const model::OutputPort<ValueType>& ExponentialMovingAverage(const model::OutputPort<ValueType>& input, ValueType smoothingFactor);
+
+    //
+    // Explicit instantiation declarations
+    //
+    extern template class ExponentialMovingAverageNode<float>;
+    extern template class ExponentialMovingAverageNode<double>;
+} // namespace nodes
+} // namespace ell
+
+#pragma region implementation
+
+namespace ell
+{
+namespace nodes
+{
+    template <typename ValueType>
+    const model::OutputPort<ValueType>& ExponentialMovingAverage(const model::OutputPort<ValueType>& input, ValueType smoothingFactor)
+    {
+        model::Model* model = input.GetNode()->GetModel();
+        if (model == nullptr)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Input not part of a model");
+        }
+        auto node = model->AddNode<ExponentialMovingAverageNode<ValueType>>(input, smoothingFactor);
+        return node->output;
+    }
+} // namespace nodes
+} // namespace ell
+
+#pragma endregion implementation
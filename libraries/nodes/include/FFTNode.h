@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <dsp/include/FFTPlan.h>
+
 #include <emitters/include/LLVMUtilities.h>
 
 #include <model/include/CompilableNode.h>
@@ -22,6 +24,7 @@
 #include <utilities/include/TypeTraits.h>
 
 #include <cmath>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -80,10 +83,8 @@ namespace nodes
         void EmitFFT_2(emitters::IRFunctionEmitter& function, emitters::LLVMValue input);
         void EmitFFT_4(emitters::IRFunctionEmitter& function, emitters::LLVMValue input);
         void EmitFFT(emitters::IRFunctionEmitter& function, size_t length, emitters::LLVMValue input, emitters::LLVMValue scratch);
-        void EmitRealFFT(emitters::IRFunctionEmitter& function, size_t length, emitters::LLVMValue input, emitters::LLVMValue scratch, emitters::LLVMValue complexInput);
 
         // Getting FFT functions
-        emitters::LLVMFunction GetRealFFTFunction(emitters::IRModuleEmitter& moduleEmitter, size_t length);
         emitters::LLVMFunction GetFFTFunction(emitters::IRModuleEmitter& moduleEmitter, size_t length);
 
         // Hand-unrolled fixed-size versions
@@ -92,7 +93,6 @@ namespace nodes
 
         // Performing FFT (either by calling a function or emitting inline code)
         void DoFFT(emitters::IRFunctionEmitter& function, size_t length, emitters::LLVMValue input, emitters::LLVMValue scratch);
-        void DoRealFFT(emitters::IRFunctionEmitter& function, size_t length, emitters::LLVMValue input, emitters::LLVMValue scratch, emitters::LLVMValue complexInput);
 
         // Inputs
         model::InputPort<ValueType> _input;
@@ -101,6 +101,7 @@ namespace nodes
         model::OutputPort<ValueType> _output;
 
         size_t _fftSize;
+        std::shared_ptr<const dsp::FFTPlan<ValueType>> _plan;
     };
 
     template <typename ValueType>
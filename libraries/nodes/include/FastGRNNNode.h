@@ -101,6 +101,8 @@ namespace nodes
         /// <returns> The name of this type. </returns>
         std::string GetRuntimeTypeName() const override { return GetTypeName(); }
 
+        bool IsStateful() const override { return true; } // runtime state: the hidden state
+
     protected:
         void Define(ell::value::FunctionDeclaration& fn) override;
         void DefineReset(ell::value::FunctionDeclaration& fn) override;
@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FlatForestPredictorNode.h (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <model/include/CompilableNode.h>
+#include <model/include/IRMapCompiler.h>
+#include <model/include/ModelTransformer.h>
+
+#include <predictors/include/FlatForestPredictor.h>
+
+#include <string>
+
+namespace ell
+{
+namespace nodes
+{
+    /// <summary>
+    /// A node that evaluates a forest stored as a `FlatForestPredictor`. The emitted code walks each tree over
+    /// constant arrays of feature indices, thresholds and child indices, instead of expanding every interior
+    /// node into its own sub-model. `SimpleForestPredictorNode` refines into this node.
+    /// </summary>
+    class FlatForestPredictorNode : public model::CompilableNode
+    {
+    public:
+        /// @name Input and Output Ports
+        /// @{
+        static constexpr const char* treeOutputsPortName = "treeOutputs";
+        static constexpr const char* edgeIndicatorVectorPortName = "edgeIndicatorVector";
+        const model::InputPort<double>& input = _input;
+        const model::OutputPort<double>& output = _output;
+        const model::OutputPort<double>& treeOutputs = _treeOutputs;
+        const model::OutputPort<bool>& edgeIndicatorVector = _edgeIndicatorVector;
+        /// @}
+
+        /// <summary> Default Constructor </summary>
+        FlatForestPredictorNode();
+
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="input"> The predictor's input. Must have at least `forest.NumFeatures()` elements. </param>
+        /// <param name="forest"> The flattened forest. </param>
+        FlatForestPredictorNode(const model::OutputPort<double>& input, const predictors::FlatForestPredictor& forest);
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        static std::string GetTypeName() { return "FlatForestPredictorNode"; }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        std::string GetRuntimeTypeName() const override { return GetTypeName(); }
+
+        /// <summary> Gets the flattened forest. </summary>
+        ///
+        /// <returns> The forest. </returns>
+        const predictors::FlatForestPredictor& GetForest() const { return _forest; }
+
+    protected:
+        void Compute() const override;
+        void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
+        void WriteToArchive(utilities::Archiver& archiver) const override;
+        void ReadFromArchive(utilities::Unarchiver& archiver) override;
+        bool HasState() const override { return true; } // stored state: forest
+
+    private:
+        void Copy(model::ModelTransformer& transformer) const override;
+
+        // Input
+        model::InputPort<double> _input;
+
+        // Outputs
+        model::OutputPort<double> _output;
+        model::OutputPort<double> _treeOutputs;
+        model::OutputPort<bool> _edgeIndicatorVector;
+
+        // Forest
+        predictors::FlatForestPredictor _forest;
+    };
+} // namespace nodes
+} // namespace ell
@@ -11,7 +11,7 @@
 #include "BinaryOperationNode.h"
 #include "ConstantNode.h"
 #include "DemultiplexerNode.h"
-#include "ForestPredictorNode.h"
+#include "FlatForestPredictorNode.h"
 #include "MultiplexerNode.h"
 #include "SingleElementThresholdNode.h"
 #include "SumNode.h"
@@ -20,11 +20,13 @@
 #include <model/include/ModelTransformer.h>
 #include <model/include/Node.h>
 
+#include <predictors/include/FlatForestPredictor.h>
 #include <predictors/include/ForestPredictor.h>
 #include <predictors/include/SingleElementThresholdPredictor.h>
 
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace ell
@@ -169,6 +171,17 @@ namespace nodes
     bool ForestPredictorNode<SplitRuleType, EdgePredictorType>::Refine(model::ModelTransformer& transformer) const
     {
         const auto& newPortElements = transformer.GetCorrespondingInputs(_input);
+
+        // forests of single-element threshold rules and constant edges refine into a single node that walks a flattened copy of the forest
+        if constexpr (std::is_same_v<ForestPredictor, predictors::SimpleForestPredictor>)
+        {
+            auto flatForestNode = transformer.AddNode<FlatForestPredictorNode>(newPortElements, predictors::FlatForestPredictor(_forest));
+            transformer.MapNodeOutput(output, flatForestNode->output);
+            transformer.MapNodeOutput(treeOutputs, flatForestNode->treeOutputs);
+            transformer.MapNodeOutput(edgeIndicatorVector, flatForestNode->edgeIndicatorVector);
+            return true;
+        }
+
         const auto& interiorNodes = _forest.GetInteriorNodes();
 
         // create a place to store references to the output ports of the sub-models at each interior node
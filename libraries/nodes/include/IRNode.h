@@ -60,6 +60,8 @@ namespace nodes
         /// <summary></summary>
         std::string GetIRCode() const { return _irCode; }
 
+        bool IsStateful() const override { return true; } // arbitrary emitted code, which may keep state
+
     protected:
         /// <summary> Constructor </summary>
         ///
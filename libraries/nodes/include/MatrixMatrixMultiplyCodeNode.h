@@ -17,6 +17,9 @@
 #include <model/include/OutputPort.h>
 
 #include <nodes/include/MatrixMatrixMultiplyImplementation.h>
+#include <nodes/include/OutputEpilogue.h>
+
+#include <emitters/include/TargetDevice.h>
 
 #include <utilities/include/ArchiveVersion.h>
 #include <utilities/include/IArchivable.h>
@@ -34,6 +37,7 @@
 #include <value/include/loopnests/LoopNest.h>
 
 #include <string>
+#include <vector>
 
 namespace ell
 {
@@ -200,11 +204,64 @@ namespace nodes
         /// <param name="kernelN"> The kernel size to use in the N dimension (columns of B, C). </param>
         /// <param name="kernelK"> The kernel size to use in the K dimension (columns of A, rows of B). </param>
         /// <param name="gemmImpl"> Which implementation of matrix-matrix multiplication to use </param>
-        MatrixMatrixMultiplyCodeNode(const model::OutputPort<ValueType>& input1, int m, int n, int k, int matrix1Stride, bool transpose1, const model::OutputPort<ValueType>& input2, int matrix2Stride, bool transpose2, int outputMatrixStride, bool transposeOutput, int panelM, int panelN, int panelK, int kernelM, int kernelN, int kernelK, const MatrixMatrixMultiplyImplementation& gemmImpl = MatrixMatrixMultiplyImplementation::DEFAULT);
+        /// <param name="epilogue"> Elementwise operations to apply to the output, with one channel per row of the output. </param>
+        MatrixMatrixMultiplyCodeNode(const model::OutputPort<ValueType>& input1, int m, int n, int k, int matrix1Stride, bool transpose1, const model::OutputPort<ValueType>& input2, int matrix2Stride, bool transpose2, int outputMatrixStride, bool transposeOutput, int panelM, int panelN, int panelK, int kernelM, int kernelN, int kernelK, const MatrixMatrixMultiplyImplementation& gemmImpl = MatrixMatrixMultiplyImplementation::DEFAULT, const OutputEpilogue<ValueType>& epilogue = {});
 
         /// <summary> Gets the name of this type (for serialization). </summary>
         ///
         /// <returns> The name of this type. </returns>
+        /// <summary> Returns the number of rows in matrix 1 and the output. </summary>
+        int GetM() const { return _m; }
+
+        /// <summary> Returns the number of columns in matrix 2 and the output. </summary>
+        int GetN() const { return _n; }
+
+        /// <summary> Returns the number of columns in matrix 1 and rows in matrix 2. </summary>
+        int GetK() const { return _k; }
+
+        /// <summary> Returns the stride of matrix 1. </summary>
+        int GetMatrix1Stride() const { return _lda; }
+
+        /// <summary> Returns the stride of matrix 2. </summary>
+        int GetMatrix2Stride() const { return _ldb; }
+
+        /// <summary> Returns the stride of the output matrix. </summary>
+        int GetOutputMatrixStride() const { return _ldc; }
+
+        /// <summary> Returns true if matrix 1 is stored in column-major order. </summary>
+        bool IsMatrix1Transposed() const { return _transpose1; }
+
+        /// <summary> Returns true if matrix 2 is stored in column-major order. </summary>
+        bool IsMatrix2Transposed() const { return _transpose2; }
+
+        /// <summary> Returns true if the output is stored in column-major order. </summary>
+        bool IsOutputTransposed() const { return _transposeOutput; }
+
+        /// <summary> Returns the tile sizes, in the order panelM, panelN, panelK, kernelM, kernelN, kernelK. A size of 0 means "choose automatically". </summary>
+        std::vector<int> GetTileSizes() const { return { _panelM, _panelN, _panelK, _kernelM, _kernelN, _kernelK }; }
+
+        /// <summary> Returns the implementation of matrix-matrix multiplication the node uses. </summary>
+        MatrixMatrixMultiplyImplementation GetImplementation() const { return _impl; }
+
+        /// <summary>
+        /// Returns true if all of the tile sizes are left for the compiler to choose. When the map compiler refines such
+        /// a node, it uses the tile sizes from its tuning cache if there's an entry for the node's shape and target.
+        /// </summary>
+        bool HasAutomaticTileSizes() const;
+
+        /// <summary>
+        /// Returns the elementwise operations applied to the output, with the rows of the output as the epilogue's channels.
+        /// They're applied to each block of the output as it's stored after its last K panel, not in a separate pass.
+        /// </summary>
+        const OutputEpilogue<ValueType>& GetEpilogue() const { return _epilogue; }
+
+        /// <summary>
+        /// Returns the tuning cache key for this node's shape and memory layout (strides and transposes) on a given target.
+        /// </summary>
+        ///
+        /// <param name="target"> The target device. </param>
+        std::string GetTuningKey(const emitters::TargetDevice& target) const;
+
         static std::string GetTypeName() { return utilities::GetCompositeTypeName<ValueType>("MatrixMatrixMultiplyCodeNode"); }
 
         /// <summary> Gets the name of this type (for serialization). </summary>
@@ -226,11 +283,13 @@ namespace nodes
         void ZeroMatrix(value::Matrix matrix) const;
 
         void ForLoopGEMM(const value::Matrix matA, const value::Matrix matB, value::Matrix matC);
-        void Gemm(const value::Matrix mat, const value::Matrix matB, value::Matrix matC);
-        void GemmFn(const value::Matrix mat, const value::Matrix matB, value::Matrix matC, int thread_num = 0);
+        void Gemm(const value::Matrix mat, const value::Matrix matB, value::Matrix matC, int firstRow);
+        void GemmFn(const value::Matrix mat, const value::Matrix matB, value::Matrix matC, int firstRow, int thread_num = 0);
         void ParallelizeGemmCol(const value::Matrix matA, const value::Matrix matB, value::Matrix matC, int numThreads = 2);
         void ParallelizeGemmRow(const value::Matrix matA, const value::Matrix matB, value::Matrix matC, int numThreads = 2);
         void ELLCodeGEMM(const value::Matrix matA, const value::Matrix matB, value::Matrix matC);
+        value::ReduceOutputStoreFunction GetEpilogueStoreFunction(int firstRow) const;
+        void ApplyEpilogue(value::Matrix matC, value::Scalar firstRow) const;
 
         // Inputs
         model::InputPort<ValueType> _input1;
@@ -245,7 +304,7 @@ namespace nodes
         int _lda = 0, _ldb = 0, _ldc = 0;
         bool _transpose1 = false, _transpose2 = false, _transposeOutput = false;
 
-        // Implementation-controlling members
+        // Implementation-controlling members. A tile size of 0 means the size is chosen from the target.
         int _panelM;
         int _panelN;
         int _panelK;
@@ -254,12 +313,14 @@ namespace nodes
         int _kernelK;
         MatrixMatrixMultiplyImplementation _impl;
 
-        static const int _defaultPanelM = 64;
-        static const int _defaultPanelN = 64;
-        static const int _defaultPanelK = 64;
-        static const int _defaultKernelM = 4;
-        static const int _defaultKernelN = 4;
-        static const int _defaultKernelK = 4;
+        OutputEpilogue<ValueType> _epilogue;
+
+        static const int _defaultPanelM = 0;
+        static const int _defaultPanelN = 0;
+        static const int _defaultPanelK = 0;
+        static const int _defaultKernelM = 0;
+        static const int _defaultKernelN = 0;
+        static const int _defaultKernelK = 0;
     };
 
     //
@@ -82,6 +82,33 @@ namespace nodes
         /// <param name="transposeOutput"> If true, transpose the output matrix. </param>
         MatrixMatrixMultiplyNode(const model::OutputPort<ValueType>& input1, int m, int n, int k, int matrix1Stride, bool transpose1, const model::OutputPort<ValueType>& input2, int matrix2Stride, bool transpose2, int outputMatrixStride, bool transposeOutput);
 
+        /// <summary> Returns the number of rows in matrix 1 and the output. </summary>
+        int GetM() const { return _m; }
+
+        /// <summary> Returns the number of columns in matrix 2 and the output. </summary>
+        int GetN() const { return _n; }
+
+        /// <summary> Returns the number of columns in matrix 1 and rows in matrix 2. </summary>
+        int GetK() const { return _k; }
+
+        /// <summary> Returns the stride of matrix 1. </summary>
+        int GetMatrix1Stride() const { return _lda; }
+
+        /// <summary> Returns the stride of matrix 2. </summary>
+        int GetMatrix2Stride() const { return _ldb; }
+
+        /// <summary> Returns the stride of the output matrix. </summary>
+        int GetOutputMatrixStride() const { return _ldc; }
+
+        /// <summary> Returns true if matrix 1 is stored in column-major order. </summary>
+        bool IsMatrix1Transposed() const { return _transpose1; }
+
+        /// <summary> Returns true if matrix 2 is stored in column-major order. </summary>
+        bool IsMatrix2Transposed() const { return _transpose2; }
+
+        /// <summary> Returns true if the output is stored in column-major order. </summary>
+        bool IsOutputTransposed() const { return _transposeOutput; }
+
         /// <summary> Gets the name of this type (for serialization). </summary>
         ///
         /// <returns> The name of this type. </returns>
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <model/include/BatchTransformer.h>
 #include <model/include/CompilableNode.h>
 #include <model/include/IRMapCompiler.h>
 #include <model/include/InputPort.h>
@@ -55,6 +56,15 @@ namespace nodes
         /// <param name="inputVector"> The right-hand input of the matrix multiplication. </param>
         MatrixVectorMultiplyNode(const model::OutputPort<ValueType>& inputMatrix, size_t m, size_t n, size_t matrixStride, const model::OutputPort<ValueType>& inputVector);
 
+        /// <summary> Returns the number of rows in the matrix. </summary>
+        size_t GetM() const { return _m; }
+
+        /// <summary> Returns the number of columns in the matrix. </summary>
+        size_t GetN() const { return _n; }
+
+        /// <summary> Returns the stride of the matrix. </summary>
+        size_t GetMatrixStride() const { return _lda; }
+
         /// <summary> Gets the name of this type (for serialization). </summary>
         ///
         /// <returns> The name of this type. </returns>
@@ -74,6 +84,7 @@ namespace nodes
 
     private:
         void Copy(model::ModelTransformer& transformer) const override;
+        bool Batch(model::BatchTransformer& transformer) const override;
 
         // Inputs
         model::InputPort<ValueType> _inputMatrix;
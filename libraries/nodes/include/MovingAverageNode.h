@@ -59,6 +59,8 @@ namespace nodes
         /// <summary> Refines this node in the model being constructed by the transformer </summary>
         bool Refine(model::ModelTransformer& transformer) const override;
 
+        bool IsStateful() const override { return true; } // runtime state: the samples in the window
+
     protected:
         void Compute() const override;
         void WriteToArchive(utilities::Archiver& archiver) const override;
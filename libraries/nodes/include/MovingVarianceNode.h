@@ -51,6 +51,8 @@ namespace nodes
         /// <returns> The name of this type. </returns>
         std::string GetRuntimeTypeName() const override { return GetTypeName(); }
 
+        bool IsStateful() const override { return true; } // runtime state: the samples in the window
+
     protected:
         void Compute() const override;
         void WriteToArchive(utilities::Archiver& archiver) const override;
@@ -0,0 +1,228 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     OutputEpilogue.h (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <predictors/neural/include/Activation.h>
+
+#include <utilities/include/Archiver.h>
+#include <utilities/include/Exception.h>
+
+#include <value/include/Scalar.h>
+
+#include <optional>
+#include <vector>
+
+namespace ell
+{
+namespace nodes
+{
+    /// <summary>
+    /// Elementwise operations that a convolution or matrix multiplication node applies to each output value as it is
+    /// produced: `output = activation(scale[channel] * value + bias[channel])`, where `channel` is the output filter
+    /// (the row of a matrix product). An empty scale means 1, an empty bias means 0, and the activation is optional.
+    /// </summary>
+    template <typename ValueType>
+    class OutputEpilogue
+    {
+    public:
+        using ActivationType = predictors::neural::Activation<ValueType>;
+
+        /// <summary> Returns true if the epilogue doesn't change its input. </summary>
+        bool IsEmpty() const { return _scale.empty() && _bias.empty() && !_activation; }
+
+        /// <summary> Returns true if the epilogue ends with an activation function. </summary>
+        bool HasActivation() const { return _activation.has_value(); }
+
+        /// <summary> Returns true if the scale and bias, if present, have one entry per channel. </summary>
+        bool IsValidForNumChannels(int numChannels) const;
+
+        /// <summary> Returns the per-channel scale, or an empty vector if there's no scale. </summary>
+        const std::vector<ValueType>& GetScale() const { return _scale; }
+
+        /// <summary> Returns the per-channel bias, or an empty vector if there's no bias. </summary>
+        const std::vector<ValueType>& GetBias() const { return _bias; }
+
+        /// <summary> Returns the per-channel scale, with missing values filled in with 1. </summary>
+        std::vector<ValueType> GetScale(int numChannels) const;
+
+        /// <summary> Returns the per-channel bias, with missing values filled in with 0. </summary>
+        std::vector<ValueType> GetBias(int numChannels) const;
+
+        /// <summary>
+        /// Composes a per-channel linear function `scale * x + bias` after the current epilogue. An empty scale means 1
+        /// and an empty bias means 0. Throws if the epilogue already ends with an activation.
+        /// </summary>
+        void AppendLinearFunction(const std::vector<ValueType>& scale, const std::vector<ValueType>& bias);
+
+        /// <summary> Adds an activation function to the end of the epilogue. Throws if it already has one. </summary>
+        void AppendActivation(const ActivationType& activation);
+
+        /// <summary> Emits the epilogue for one output value, given the scale and bias of its channel. </summary>
+        ///
+        /// <param name="value"> The value computed by the node. </param>
+        /// <param name="scale"> The scale for the value's channel. </param>
+        /// <param name="bias"> The bias for the value's channel. </param>
+        ///
+        /// <returns> The output value. </returns>
+        value::Scalar Apply(value::Scalar value, value::Scalar scale, value::Scalar bias) const;
+
+        /// <summary> Adds the epilogue to an archive, if it isn't empty. </summary>
+        void WriteToArchive(utilities::Archiver& archiver) const;
+
+        /// <summary> Reads the epilogue from an archive, leaving it empty if the archive doesn't have one. </summary>
+        void ReadFromArchive(utilities::Unarchiver& archiver);
+
+    private:
+        std::vector<ValueType> _scale;
+        std::vector<ValueType> _bias;
+        std::optional<ActivationType> _activation;
+    };
+} // namespace nodes
+} // namespace ell
+
+#pragma region implementation
+
+namespace ell
+{
+namespace nodes
+{
+    template <typename ValueType>
+    bool OutputEpilogue<ValueType>::IsValidForNumChannels(int numChannels) const
+    {
+        auto isValidSize = [numChannels](const std::vector<ValueType>& values) {
+            return values.empty() || static_cast<int>(values.size()) == numChannels;
+        };
+        return isValidSize(_scale) && isValidSize(_bias);
+    }
+
+    template <typename ValueType>
+    std::vector<ValueType> OutputEpilogue<ValueType>::GetScale(int numChannels) const
+    {
+        return _scale.empty() ? std::vector<ValueType>(numChannels, static_cast<ValueType>(1)) : _scale;
+    }
+
+    template <typename ValueType>
+    std::vector<ValueType> OutputEpilogue<ValueType>::GetBias(int numChannels) const
+    {
+        return _bias.empty() ? std::vector<ValueType>(numChannels, static_cast<ValueType>(0)) : _bias;
+    }
+
+    template <typename ValueType>
+    void OutputEpilogue<ValueType>::AppendLinearFunction(const std::vector<ValueType>& scale, const std::vector<ValueType>& bias)
+    {
+        if (_activation)
+        {
+            throw utilities::LogicException(utilities::LogicExceptionErrors::illegalState, "Can't add a linear function after the epilogue's activation");
+        }
+        if (!scale.empty() && !bias.empty() && scale.size() != bias.size())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "Epilogue scale and bias must have the same size");
+        }
+
+        // s2 * (s1 * x + b1) + b2 = (s2 * s1) * x + (s2 * b1 + b2)
+        if (!scale.empty())
+        {
+            if (_scale.empty())
+            {
+                _scale = scale;
+            }
+            else
+            {
+                for (size_t index = 0; index < _scale.size(); ++index)
+                {
+                    _scale[index] *= scale[index];
+                }
+            }
+
+            for (size_t index = 0; index < _bias.size(); ++index)
+            {
+                _bias[index] *= scale[index];
+            }
+        }
+
+        if (!bias.empty())
+        {
+            if (_bias.empty())
+            {
+                _bias = bias;
+            }
+            else
+            {
+                for (size_t index = 0; index < _bias.size(); ++index)
+                {
+                    _bias[index] += bias[index];
+                }
+            }
+        }
+    }
+
+    template <typename ValueType>
+    void OutputEpilogue<ValueType>::AppendActivation(const ActivationType& activation)
+    {
+        if (_activation)
+        {
+            throw utilities::LogicException(utilities::LogicExceptionErrors::illegalState, "The epilogue already has an activation");
+        }
+        _activation = activation;
+    }
+
+    template <typename ValueType>
+    value::Scalar OutputEpilogue<ValueType>::Apply(value::Scalar value, value::Scalar scale, value::Scalar bias) const
+    {
+        value::Scalar result = value;
+        if (!_scale.empty())
+        {
+            result = result * scale;
+        }
+        if (!_bias.empty())
+        {
+            result = result + bias;
+        }
+        if (_activation)
+        {
+            result = _activation->Apply(result);
+        }
+        return result;
+    }
+
+    template <typename ValueType>
+    void OutputEpilogue<ValueType>::WriteToArchive(utilities::Archiver& archiver) const
+    {
+        if (IsEmpty())
+        {
+            return;
+        }
+
+        archiver["epilogueScale"] << _scale;
+        archiver["epilogueBias"] << _bias;
+        if (_activation)
+        {
+            _activation->WriteToArchive(archiver);
+        }
+    }
+
+    template <typename ValueType>
+    void OutputEpilogue<ValueType>::ReadFromArchive(utilities::Unarchiver& archiver)
+    {
+        _scale.clear();
+        _bias.clear();
+        _activation.reset();
+        archiver.OptionalProperty("epilogueScale") >> _scale;
+        archiver.OptionalProperty("epilogueBias") >> _bias;
+        if (archiver.HasNextPropertyName("activation"))
+        {
+            ActivationType activation;
+            activation.ReadFromArchive(archiver);
+            _activation = activation;
+        }
+    }
+} // namespace nodes
+} // namespace ell
+
+#pragma endregion implementation
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     QuantizedMatrixMatrixMultiplyNode.h (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <model/include/CompilableCodeNode.h>
+#include <model/include/InputPort.h>
+#include <model/include/OutputPort.h>
+#include <model/include/PortMemoryLayout.h>
+
+#include <utilities/include/IArchivable.h>
+#include <utilities/include/TypeName.h>
+
+#include <value/include/FunctionDeclaration.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace nodes
+{
+    /// <summary>
+    /// A node that multiplies a constant matrix of 8-bit integer weights with a real-valued input matrix.
+    /// Each row of the weights (one output channel) has its own scale, so weight row `i` represents
+    /// `weightScales[i] * weights[i, :]`. The input is quantized to 8-bit integers with a single scale
+    /// (typically found by calibrating on a dataset), the products are accumulated in 32-bit integers,
+    /// and the result is converted back to real values. Matrix 1 (the weights) is MxK, matrix 2 (the input)
+    /// is KxN, and the output is MxN.
+    /// </summary>
+    template <typename ValueType>
+    class QuantizedMatrixMatrixMultiplyNode : public model::CompilableCodeNode
+    {
+    public:
+        /// @name Input and Output Ports
+        /// @{
+        const model::InputPort<ValueType>& input = _input;
+        const model::OutputPort<ValueType>& output = _output;
+        /// @}
+
+        /// <summary> Default constructor. </summary>
+        QuantizedMatrixMatrixMultiplyNode();
+
+        /// <summary> Constructor. </summary>
+        ///
+        /// <param name="input"> The right-hand input of the multiplication, a row-major matrix of size k x n. </param>
+        /// <param name="m"> The number of rows in the weights matrix and the output. </param>
+        /// <param name="n"> The number of columns in the input and the output. </param>
+        /// <param name="k"> The number of columns in the weights matrix and rows in the input. </param>
+        /// <param name="weights"> The quantized weights, a row-major matrix of size m x k. </param>
+        /// <param name="weightScales"> The scale of each row of the weights. </param>
+        /// <param name="inputScale"> The scale used to quantize the input: an input value `x` is represented by `round(x / inputScale)`, clamped to [-127, 127]. </param>
+        /// <param name="transposeOutput"> If true, the output is written in column-major order. </param>
+        /// <param name="outputMemoryLayout"> The memory layout of the output port. Must have m*n elements. </param>
+        QuantizedMatrixMatrixMultiplyNode(const model::OutputPort<ValueType>& input, int m, int n, int k, const std::vector<int8_t>& weights, const std::vector<ValueType>& weightScales, ValueType inputScale, bool transposeOutput, const model::PortMemoryLayout& outputMemoryLayout);
+
+        /// <summary> Returns the quantized weights, a row-major matrix of size m x k. </summary>
+        const std::vector<int8_t>& GetWeights() const { return _weights; }
+
+        /// <summary> Returns the scale of each row of the weights. </summary>
+        const std::vector<ValueType>& GetWeightScales() const { return _weightScales; }
+
+        /// <summary> Returns the scale used to quantize the input. </summary>
+        ValueType GetInputScale() const { return _inputScale; }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        static std::string GetTypeName() { return utilities::GetCompositeTypeName<ValueType>("QuantizedMatrixMatrixMultiplyNode"); }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        std::string GetRuntimeTypeName() const override { return GetTypeName(); }
+
+    protected:
+        void Define(value::FunctionDeclaration& fn) override;
+        void WriteToArchive(utilities::Archiver& archiver) const override;
+        void ReadFromArchive(utilities::Unarchiver& archiver) override;
+        bool HasState() const override { return true; } // stored state: m, n, k, weights, scales, transposeOutput
+
+    private:
+        void Copy(model::ModelTransformer& transformer) const override;
+
+        // Inputs
+        model::InputPort<ValueType> _input;
+
+        // Output
+        model::OutputPort<ValueType> _output;
+
+        // Matrix dimensions
+        int _m = 0, _n = 0, _k = 0;
+        bool _transposeOutput = false;
+
+        // Quantization parameters
+        std::vector<int8_t> _weights;
+        std::vector<ValueType> _weightScales;
+        ValueType _inputScale = 1;
+    };
+
+    //
+    // Explicit instantiation declarations
+    //
+    extern template class QuantizedMatrixMatrixMultiplyNode<float>;
+    extern template class QuantizedMatrixMatrixMultiplyNode<double>;
+} // namespace nodes
+} // namespace ell
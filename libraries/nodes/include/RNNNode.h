@@ -86,6 +86,8 @@ namespace nodes
         /// <summary> Resets any state on the node, if any </summary>
         void Reset() override;
 
+        bool IsStateful() const override { return true; } // runtime state: the hidden state
+
     protected:
         void Compute() const override;
         void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
@@ -110,6 +112,11 @@ namespace nodes
 
         void ApplyActivation(emitters::IRFunctionEmitter& function, const ActivationType& activation, emitters::LLVMValue data, size_t dataLength);
 
+        // Emits gates = W_i * x + b_i + W_h * h + b_h for all `stackHeight` stacked gates. When the weights and biases
+        // are constants they are concatenated at compile time into [W_i | W_h] and b_i + b_h, so that one GEMV over
+        // [x; h] computes every gate; otherwise both products accumulate into the same buffer.
+        void EmitGatePreactivations(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function, size_t stackHeight, emitters::LLVMValue hiddenState, emitters::IRLocalArray gates);
+
         using VectorType = math::ColumnVector<ValueType>;
 
         // Hidden state for compute
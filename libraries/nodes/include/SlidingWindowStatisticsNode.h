@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     SlidingWindowStatisticsNode.h (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <model/include/CompilableNode.h>
+#include <model/include/IRMapCompiler.h>
+#include <model/include/InputPort.h>
+#include <model/include/MapCompiler.h>
+#include <model/include/ModelTransformer.h>
+#include <model/include/Node.h>
+#include <model/include/OutputPort.h>
+
+#include <utilities/include/Exception.h>
+#include <utilities/include/TypeName.h>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace nodes
+{
+    /// <summary> The statistics computed by SlidingWindowStatisticsNode. </summary>
+    enum class SlidingWindowStatistic
+    {
+        mean,
+        variance,
+        min,
+        max
+    };
+
+    /// <summary> Gets the name of a sliding-window statistic (for serialization). </summary>
+    std::string ToString(SlidingWindowStatistic statistic);
+
+    /// <summary> Gets the sliding-window statistic with the given name. </summary>
+    SlidingWindowStatistic SlidingWindowStatisticFromString(const std::string& name);
+
+    /// <summary>
+    /// A node that computes a statistic of each channel of its input over a sliding window of the most recent samples.
+    /// The samples are kept in a circular buffer and the statistic is updated incrementally, so each sample costs O(1)
+    /// time regardless of the window size (amortized). The window starts out filled with zeros.
+    ///
+    /// mean: a running sum.
+    /// variance: the population variance, from a running mean and sum of squared deviations (Welford's method).
+    /// The running sums are kept in double precision, and are recomputed from the buffer once per pass over it, so
+    /// rounding errors don't accumulate over long streams.
+    /// min, max: a monotonic deque of the positions of the samples that can still become the extremum.
+    /// </summary>
+    template <typename ValueType>
+    class SlidingWindowStatisticsNode : public model::CompilableNode
+    {
+    public:
+        /// @name Input and Output Ports
+        /// @{
+        const model::InputPort<ValueType>& input = _input;
+        const model::OutputPort<ValueType>& output = _output;
+        /// @}
+
+        /// <summary> Default Constructor </summary>
+        SlidingWindowStatisticsNode();
+
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="input"> The signal to compute the statistic of. </param>
+        /// <param name="windowSize"> The number of samples in the window. </param>
+        /// <param name="statistic"> The statistic to compute. </param>
+        SlidingWindowStatisticsNode(const model::OutputPort<ValueType>& input, size_t windowSize, SlidingWindowStatistic statistic);
+
+        /// <summary> Gets the number of samples in the window. </summary>
+        size_t GetWindowSize() const { return _windowSize; }
+
+        /// <summary> Gets the statistic computed by this node. </summary>
+        SlidingWindowStatistic GetStatistic() const { return _statistic; }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        static std::string GetTypeName() { return utilities::GetCompositeTypeName<ValueType>("SlidingWindowStatisticsNode"); }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        std::string GetRuntimeTypeName() const override { return GetTypeName(); }
+
+        /// <summary> Resets any state on the node, if any </summary>
+        void Reset() override;
+
+        bool IsStateful() const override { return true; } // runtime state: the samples in the window
+
+    protected:
+        void Compute() const override;
+        void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
+        void WriteToArchive(utilities::Archiver& archiver) const override;
+        void ReadFromArchive(utilities::Unarchiver& archiver) override;
+        bool HasState() const override { return true; } // stored state: window size, statistic, and the samples in the window
+
+    private:
+        void Copy(model::ModelTransformer& transformer) const override;
+        void RecomputeAccumulators() const;
+
+        void CompileMean(emitters::IRFunctionEmitter& function, emitters::LLVMValue pInput, emitters::LLVMValue pOutput, llvm::GlobalVariable* history, emitters::IRLocalScalar position);
+        void CompileVariance(emitters::IRFunctionEmitter& function, emitters::LLVMValue pInput, emitters::LLVMValue pOutput, llvm::GlobalVariable* history, emitters::IRLocalScalar position);
+        void CompileExtremum(emitters::IRFunctionEmitter& function, emitters::LLVMValue pInput, emitters::LLVMValue pOutput, llvm::GlobalVariable* history, emitters::IRLocalScalar position);
+
+        // Inputs
+        model::InputPort<ValueType> _input;
+
+        // Output
+        model::OutputPort<ValueType> _output;
+
+        size_t _windowSize;
+        SlidingWindowStatistic _statistic;
+
+        // The samples in the window, indexed by [position * numChannels + channel]. `_position` is where the next
+        // sample goes, replacing the oldest one.
+        mutable std::vector<ValueType> _history;
+        mutable size_t _position = 0;
+
+        // Per-channel state: the running sum (mean), or the running mean and sum of squared deviations (variance)
+        mutable std::vector<double> _sum;
+        mutable std::vector<double> _mean;
+        mutable std::vector<double> _sumSquaredDeviations;
+
+        // Per-channel state for min and max: the positions of the candidate samples, oldest first, whose values are
+        // increasing (min) or decreasing (max)
+        mutable std::vector<std::deque<size_t>> _candidates;
+    };
+
+    /// <summary> Convenience function for adding a node to a model. </summary>
+    ///
+    /// <param name="input"> The port to get the input data from </param>
+    /// <param name="windowSize"> The number of samples in the window. </param>
+    /// <param name="statistic"> The statistic to compute. </param>
+    ///
+    /// <returns> The output of the new node. </returns>
+    template <typename ValueType>
+    const model::OutputPort<ValueType>& SlidingWindowStatistics(const model::OutputPort<ValueType>& input, size_t windowSize, SlidingWindowStatistic statistic);
+
+    //
+    // Explicit instantiation declarations
+    //
+    extern template class SlidingWindowStatisticsNode<float>;
+    extern template class SlidingWindowStatisticsNode<double>;
+} // namespace nodes
+} // namespace ell
+
+#pragma region implementation
+
+namespace ell
+{
+namespace nodes
+{
+    template <typename ValueType>
+    const model::OutputPort<ValueType>& SlidingWindowStatistics(const model::OutputPort<ValueType>& input, size_t windowSize, SlidingWindowStatistic statistic)
+    {
+        model::Model* model = input.GetNode()->GetModel();
+        if (model == nullptr)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Input not part of a model");
+        }
+        auto node = model->AddNode<SlidingWindowStatisticsNode<ValueType>>(input, windowSize, statistic);
+        return node->output;
+    }
+} // namespace nodes
+} // namespace ell
+
+#pragma endregion implementation
@@ -12,11 +12,15 @@
 #include <model/include/IRMapCompiler.h>
 #include <model/include/InputPort.h>
 #include <model/include/OutputPort.h>
+#include <model/include/TuningCache.h>
+
+#include <nodes/include/OutputEpilogue.h>
 
 #include <value/include/FunctionDeclaration.h>
 #include <value/include/Scalar.h>
 #include <value/include/ScalarOperations.h>
 #include <value/include/Tensor.h>
+#include <value/include/Vector.h>
 
 #include <predictors/neural/include/ConvolutionalLayer.h>
 
@@ -58,6 +62,27 @@ namespace nodes
         /// <param name="layer"> The convolutional layer to wrap. </param>
         SpatialConvolutionNode(const model::OutputPort<ValueType>& input, const LayerType& layer, const model::PortMemoryLayout& outputMemoryLayout);
 
+        /// <summary> Constructor from a layer, with a schedule parameter. </summary>
+        ///
+        /// <param name="input"> </param>
+        /// <param name="layer"> The convolutional layer to wrap. </param>
+        /// <param name="outputMemoryLayout"> The memory layout of the output. </param>
+        /// <param name="columnTile"> The number of output columns to compute in each unrolled tile, or 0 to not tile the columns. </param>
+        /// <param name="epilogue"> Elementwise operations to apply to each output value as it's computed, with one channel per filter. </param>
+        SpatialConvolutionNode(const model::OutputPort<ValueType>& input, const LayerType& layer, const model::PortMemoryLayout& outputMemoryLayout, int columnTile, const OutputEpilogue<ValueType>& epilogue = {});
+
+        /// <summary> Returns the convolutional layer this node wraps. </summary>
+        const LayerType& GetLayer() const { return _layer; }
+
+        /// <summary> Returns the number of output columns computed in each unrolled tile, or 0 if the columns aren't tiled. </summary>
+        int GetColumnTile() const { return _columnTile; }
+
+        /// <summary> Returns the elementwise operations applied to each output value before it's stored. </summary>
+        const OutputEpilogue<ValueType>& GetEpilogue() const { return _epilogue; }
+
+        /// <summary> Returns the tuning cache key for this node's shape on a given target. </summary>
+        std::string GetTuningKey(const emitters::TargetDevice& target) const;
+
         /// <summary> Returns true if the node can accept input with this memory layout order, else false </summary>
         ///
         /// <param name="order"> The memory layout order for all the input ports </summary>
@@ -85,6 +110,11 @@ namespace nodes
         // Called with output i, j, k
         void spatial_convolutional_kernel(value::Tensor output, value::Tensor input, value::Tensor weights, value::Scalar i, value::Scalar j, value::Scalar k);
 
+        // Called with output i, j, k, and the epilogue's per-channel scale and bias
+        void spatial_convolutional_epilogue_kernel(value::Tensor output, value::Tensor input, value::Tensor weights, value::Vector scale, value::Vector bias, value::Scalar i, value::Scalar j, value::Scalar k);
+
+        value::Scalar ComputeConvolution(value::Tensor input, value::Tensor weights, value::Scalar row, value::Scalar column, value::Scalar channel);
+
         // Inputs
         model::InputPort<ValueType> _input;
 
@@ -93,6 +123,11 @@ namespace nodes
 
         // Convolutional layer
         LayerType _layer;
+
+        // Schedule parameters
+        int _columnTile = 0;
+
+        OutputEpilogue<ValueType> _epilogue;
     };
 
 } // namespace nodes
@@ -121,10 +156,21 @@ namespace nodes
     SpatialConvolutionNode<ValueType>::SpatialConvolutionNode(const model::OutputPort<ValueType>& input,
                                                               const LayerType& layer,
                                                               const model::PortMemoryLayout& outputMemoryLayout) :
+        SpatialConvolutionNode(input, layer, outputMemoryLayout, 0)
+    {}
+
+    template <typename ValueType>
+    SpatialConvolutionNode<ValueType>::SpatialConvolutionNode(const model::OutputPort<ValueType>& input,
+                                                              const LayerType& layer,
+                                                              const model::PortMemoryLayout& outputMemoryLayout,
+                                                              int columnTile,
+                                                              const OutputEpilogue<ValueType>& epilogue) :
         CompilableCodeNode("SpatialConvolutionNode", { &_input }, { &_output }),
         _input(this, input, defaultInputPortName),
         _output(this, defaultOutputPortName, outputMemoryLayout),
-        _layer(layer)
+        _layer(layer),
+        _columnTile(columnTile),
+        _epilogue(epilogue)
     {
         const auto& weights = _layer.GetWeights();
         if (weights.NumChannels() != 1)
@@ -137,13 +183,18 @@ namespace nodes
             throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument,
                                             "Error: input and output number of channels must match for Spatial Convolution");
         }
+        if (!_epilogue.IsValidForNumChannels(_output.GetMemoryLayout().GetLogicalDimensionActiveSize(2)))
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument,
+                                            "Error: epilogue must have one entry per channel for Spatial Convolution");
+        }
     }
 
     //
     // A spatial convolution kernel
     //
     template <typename ValueType>
-    void SpatialConvolutionNode<ValueType>::spatial_convolutional_kernel(value::Tensor output, value::Tensor input, value::Tensor weights, value::Scalar row, value::Scalar column, value::Scalar channel)
+    value::Scalar SpatialConvolutionNode<ValueType>::ComputeConvolution(value::Tensor input, value::Tensor weights, value::Scalar row, value::Scalar column, value::Scalar channel)
     {
         const auto& parameters = _layer.GetConvolutionalParameters();
         const int receptiveFieldRows = (int)parameters.receptiveField;
@@ -151,7 +202,7 @@ namespace nodes
         const int rowStride = (int)parameters.stride;
         const int columnStride = (int)parameters.stride;
 
-        value::Scalar temp = value::Allocate(output.GetValue().GetBaseType(), ell::utilities::ScalarLayout);
+        value::Scalar temp = value::Allocate(input.GetValue().GetBaseType(), ell::utilities::ScalarLayout);
         temp = static_cast<ValueType>(0.0);
 
         // Unroll the calculations for the receptive field size in row and column dimensions
@@ -164,7 +215,20 @@ namespace nodes
                 temp += input(row * rowStride + k_r, column * columnStride + k_c, channel) * weights(channel * receptiveFieldRows + k_r, k_c, 0);
             }
         }
-        output(row, column, channel) = temp;
+        return temp;
+    }
+
+    template <typename ValueType>
+    void SpatialConvolutionNode<ValueType>::spatial_convolutional_kernel(value::Tensor output, value::Tensor input, value::Tensor weights, value::Scalar row, value::Scalar column, value::Scalar channel)
+    {
+        output(row, column, channel) = ComputeConvolution(input, weights, row, column, channel);
+    }
+
+    template <typename ValueType>
+    void SpatialConvolutionNode<ValueType>::spatial_convolutional_epilogue_kernel(value::Tensor output, value::Tensor input, value::Tensor weights, value::Vector scale, value::Vector bias, value::Scalar row, value::Scalar column, value::Scalar channel)
+    {
+        // The epilogue is applied to the accumulated value before it's stored
+        output(row, column, channel) = _epilogue.Apply(ComputeConvolution(input, weights, row, column, channel), scale(channel), bias(channel));
     }
 
     template <typename ValueType>
@@ -189,16 +253,40 @@ namespace nodes
             loopnests::IndexRange j("j", { 0, (int)(output.Columns()) });
             loopnests::IndexRange k("k", { 0, (int)(output.Channels()) });
 
-            auto kernel = loopnests::Kernel("kernel")
-                              .Inputs(output.GetValue(), input.GetValue(), weights.GetValue())
-                              .Indices(i.GetIndex(), j.GetIndex(), k.GetIndex())
-                              .Define([this](value::Tensor output, value::Tensor input, value::Tensor weights, value::Scalar row, value::Scalar column, value::Scalar channel) {
-                                  spatial_convolutional_kernel(output, input, weights, row, column, channel);
-                              });
-
             loopnests::LoopNest loop(std::vector<loopnests::IndexRange>{ i, j, k });
-            loop.AddKernel(kernel);
-            loop.SetLoopOrder({ k.GetIndex(), i.GetIndex(), j.GetIndex() });
+            if (_epilogue.IsEmpty())
+            {
+                auto kernel = loopnests::Kernel("kernel")
+                                  .Inputs(output.GetValue(), input.GetValue(), weights.GetValue())
+                                  .Indices(i.GetIndex(), j.GetIndex(), k.GetIndex())
+                                  .Define([this](value::Tensor output, value::Tensor input, value::Tensor weights, value::Scalar row, value::Scalar column, value::Scalar channel) {
+                                      spatial_convolutional_kernel(output, input, weights, row, column, channel);
+                                  });
+                loop.AddKernel(kernel);
+            }
+            else
+            {
+                const int numChannels = static_cast<int>(output.Channels());
+                value::Vector scale(_epilogue.GetScale(numChannels));
+                value::Vector bias(_epilogue.GetBias(numChannels));
+                auto kernel = loopnests::Kernel("kernel")
+                                  .Inputs(output.GetValue(), input.GetValue(), weights.GetValue(), scale.GetValue(), bias.GetValue())
+                                  .Indices(i.GetIndex(), j.GetIndex(), k.GetIndex())
+                                  .Define([this](value::Tensor output, value::Tensor input, value::Tensor weights, value::Vector scale, value::Vector bias, value::Scalar row, value::Scalar column, value::Scalar channel) {
+                                      spatial_convolutional_epilogue_kernel(output, input, weights, scale, bias, row, column, channel);
+                                  });
+                loop.AddKernel(kernel);
+            }
+            if (_columnTile > 1 && _columnTile < (int)(output.Columns()))
+            {
+                auto [jOuter, jInner] = loop.Split(j.GetIndex(), _columnTile);
+                loop.SetLoopOrder({ k.GetIndex(), i.GetIndex(), jOuter, jInner });
+                loop.Unroll(jInner);
+            }
+            else
+            {
+                loop.SetLoopOrder({ k.GetIndex(), i.GetIndex(), j.GetIndex() });
+            }
 
             loopnests::CodeGenerator generator;
             generator.Run(loop);
@@ -212,6 +300,8 @@ namespace nodes
         archiver[defaultInputPortName] << _input;
         archiver["outputLayout"] << _output.GetMemoryLayout();
         archiver["layer"] << _layer;
+        archiver["columnTile"] << _columnTile;
+        _epilogue.WriteToArchive(archiver);
     }
 
     template <typename ValueType>
@@ -223,16 +313,42 @@ namespace nodes
         archiver["outputLayout"] >> outputMemoryLayout;
         _output.SetMemoryLayout(outputMemoryLayout);
         archiver["layer"] >> _layer;
+        archiver.OptionalProperty("columnTile", 0) >> _columnTile;
+        _epilogue.ReadFromArchive(archiver);
     }
 
     template <typename ValueType>
     void SpatialConvolutionNode<ValueType>::Copy(model::ModelTransformer& transformer) const
     {
         const auto& newInputs = transformer.GetCorrespondingInputs(_input);
-        auto newNode = transformer.AddNode<SpatialConvolutionNode<ValueType>>(newInputs, _layer, _output.GetMemoryLayout());
+
+        // If the schedule was left for the compiler to choose, use a tuned one if the compiler has it
+        auto columnTile = _columnTile;
+        if (columnTile == 0)
+        {
+            if (auto compiler = transformer.GetContext().GetCompiler())
+            {
+                std::vector<int> parameters;
+                if (compiler->GetTuningCache().TryGetParameters(GetTuningKey(compiler->GetMapCompilerOptions().compilerSettings.targetDevice), parameters) && parameters.size() == 1)
+                {
+                    columnTile = parameters[0];
+                }
+            }
+        }
+
+        auto newNode = transformer.AddNode<SpatialConvolutionNode<ValueType>>(newInputs, _layer, _output.GetMemoryLayout(), columnTile, _epilogue);
         transformer.MapNodeOutput(output, newNode->output);
     }
 
+    template <typename ValueType>
+    std::string SpatialConvolutionNode<ValueType>::GetTuningKey(const emitters::TargetDevice& target) const
+    {
+        const auto& outputLayout = _output.GetMemoryLayout();
+        const auto& parameters = _layer.GetConvolutionalParameters();
+        std::vector<int> shape = { outputLayout.GetLogicalDimensionActiveSize(0), outputLayout.GetLogicalDimensionActiveSize(1), outputLayout.GetLogicalDimensionActiveSize(2), (int)parameters.receptiveField, (int)parameters.stride };
+        return model::TuningCache::GetKey(GetTypeName(), shape, target);
+    }
+
 } // namespace nodes
 } // namespace ell
 
@@ -69,6 +69,8 @@ namespace nodes
         /// <returns> The name of this type. </returns>
         static std::string GetTypeName() { return "VoiceActivityDetectorCodeNode"; }
 
+        bool IsStateful() const override { return true; } // runtime state: the signal level and activity history
+
     protected:
         void Define(ell::value::FunctionDeclaration& fn) override;
         void DefineReset(ell::value::FunctionDeclaration& fn) override;
@@ -143,14 +143,7 @@ namespace nodes
     template <typename ValueType>
     emitters::IRLocalScalar SigmoidActivationFunction<ValueType>::Compile(emitters::IRLocalScalar x) const
     {
-        auto function = x.function;
-        const auto zero = emitters::IRLocalScalar(function, function.Literal(ValueType{ 0.0 }));
-        const auto one = emitters::IRLocalScalar(function, function.Literal(static_cast<ValueType>(1.0)));
-        auto a = one / (emitters::Exp(x * -one) + one);
-        auto b = emitters::Exp(x);
-        auto c = b / (b + one);
-        auto result = function.Select(x >= zero, a, c);
-        return { function, result };
+        return emitters::Sigmoid(x);
     }
 
     //
@@ -8,7 +8,6 @@
 
 #include "BinaryConvolutionalLayerNode.h"
 #include "ConstantNode.h"
-#include "ReorderDataCodeNode.h"
 
 #include <emitters/include/IRAsyncTask.h>
 #include <emitters/include/IREmitter.h>
@@ -32,6 +31,10 @@ namespace nodes
         // convolution parameters
         const auto scaleOutputByFilterMeans = ell::predictors::neural::BinaryWeightsScale::mean;
 
+        // The number of filters whose xnor sums are accumulated together, so that each block of the
+        // packed input is loaded once per group of filters instead of once per filter
+        const int maxFilterBlockSize = 4;
+
         //
         // Functions
         //
@@ -228,20 +231,14 @@ namespace nodes
         const auto& newInput = static_cast<const model::OutputPort<ValueType>&>(newInputElements);
 
         auto&& outputLayout = this->GetOutputMemoryLayout();
-        const auto outputImageHeight = outputLayout.GetActiveSize(0);
-        const auto outputImageWidth = outputLayout.GetActiveSize(1);
-        const auto numFilters = outputLayout.GetActiveSize(2);
         const auto outputDataPadding = outputLayout.GetOffset(0);
+        DEBUG_USED(outputDataPadding);
 
         assert(outputDataPadding == 0 && "Convolutional node output padding not supported yet");
 
+        // The xnor node writes its output directly in the canonical (h x w x f) order
         const auto& xnorOutput = (numPackedBits == 32) ? AddRefinedNodes<int32_t>(transformer, newInput) : AddRefinedNodes<int64_t>(transformer, newInput);
-
-        // Output of xnor is in (f x h x w) order, need to transpose to the canonical (h x w x f) order
-        model::PortMemoryLayout outputShape(model::MemoryShape{ numFilters, outputImageHeight, outputImageWidth }, model::DimensionOrder{ 2, 0, 1 }); // Note: memory layout constructor takes the sizes in physical dimension order
-        model::PortMemoryLayout transposedOutputShape(model::MemoryShape{ outputImageHeight, outputImageWidth, numFilters }, model::MemoryShape{ outputDataPadding, outputDataPadding, 0 }, model::DimensionOrder{ 0, 1, 2 });
-        const auto& reorderedOutput = ReorderDataWithCodeNode(xnorOutput, outputShape, transposedOutputShape);
-        transformer.MapNodeOutput(this->output, reorderedOutput);
+        transformer.MapNodeOutput(this->output, xnorOutput);
         return true;
     }
 
@@ -516,33 +513,43 @@ namespace nodes
     void BinaryXnorNode<ValueType, PackedBitsType>::EmitInnerLoop(emitters::IRFunctionEmitter& function,
                                                                   emitters::LLVMValue reshapedInputPtr,
                                                                   emitters::LLVMValue paddingMaskPtr,
-                                                                  emitters::LLVMValue weightsPtr,
-                                                                  emitters::LLVMValue xorSumVariable,
+                                                                  const std::vector<emitters::LLVMValue>& weightsPtrs,
+                                                                  const std::vector<emitters::LLVMValue>& xorSumVariables,
                                                                   emitters::LLVMFunction popCountFunction,
                                                                   int startBlock,
                                                                   int numBlocks,
                                                                   bool hasZeroPadding)
     {
+        assert(weightsPtrs.size() == xorSumVariables.size());
         auto reshapedInput = function.LocalArray(reshapedInputPtr);
         auto paddingMask = function.LocalArray(paddingMaskPtr);
-        auto weights = function.LocalArray(weightsPtr);
-        function.For(startBlock, startBlock + numBlocks, [reshapedInput, paddingMask, weights, xorSumVariable, popCountFunction, hasZeroPadding](emitters::IRFunctionEmitter& function, emitters::LLVMValue i) {
-            auto blockIndex = function.LocalScalar(i);
+        std::vector<emitters::IRLocalArray> weights;
+        for (auto weightsPtr : weightsPtrs)
+        {
+            weights.push_back(function.LocalArray(weightsPtr));
+        }
 
-            auto inputVal = reshapedInput[blockIndex];
-            auto filterVal = weights[blockIndex];
-            auto xorVal = inputVal ^ filterVal;
+        function.For(startBlock, startBlock + numBlocks, [reshapedInput, paddingMask, weights, xorSumVariables, popCountFunction, hasZeroPadding](emitters::IRFunctionEmitter& function, emitters::LLVMValue i) {
+            auto blockIndex = function.LocalScalar(i);
 
-            if (hasZeroPadding)
+            // Load the input (and padding mask) block once, and reuse it for every filter in the block
+            emitters::IRLocalScalar inputVal = reshapedInput[blockIndex];
+            emitters::IRLocalScalar paddingMaskVal = hasZeroPadding ? paddingMask[blockIndex] : function.LocalScalar();
+            for (size_t filter = 0; filter < weights.size(); ++filter)
             {
-                // Mask out the bits associated with zero padding from the XOR value
-                auto paddingMaskVal = paddingMask[blockIndex];
-                xorVal = paddingMaskVal & xorVal;
-            }
+                emitters::IRLocalScalar filterVal = weights[filter][blockIndex];
+                auto xorVal = inputVal ^ filterVal;
+
+                if (hasZeroPadding)
+                {
+                    // Mask out the bits associated with zero padding from the XOR value
+                    xorVal = paddingMaskVal & xorVal;
+                }
 
-            auto xorCount = function.Call(popCountFunction, { xorVal });
-            const auto plus = emitters::TypedOperator::add;
-            function.OperationAndUpdate(xorSumVariable, plus, xorCount);
+                auto xorCount = function.Call(popCountFunction, { xorVal });
+                const auto plus = emitters::TypedOperator::add;
+                function.OperationAndUpdate(xorSumVariables[filter], plus, xorCount);
+            }
         });
     }
 
@@ -566,7 +573,6 @@ namespace nodes
         const auto& inputSize = inputLayout.GetActiveSize();
 
         const auto& outputLayout = this->GetOutputMemoryLayout();
-        // const auto& outputLayout = this->GetOutputMemoryLayout().ReorderedCopy({2,0,1}); // TODO: reorder from r,c,d -> d,r,c
         const auto& outputSize = outputLayout.GetActiveSize();
 
         // The workspace buffer element sizes are dependent on the processor architecture's bitness
@@ -579,10 +585,8 @@ namespace nodes
         const auto numInputChannels = inputSize[2]; // inputSize is the dimensions of the input to the original layer node
         const auto fieldVolumeSize = filterWidth * filterWidth * numInputChannels; // = size*size*numInputChannels
 
-        // TODO: Put this back once we're using the transposed output layout
-        // const auto numFilters = outputSize[0]; // == # output rows
-        // const auto outputColumns = outputSize[1] * outputSize[2];
-        const auto numFilters = outputSize[2]; // == # output rows
+        // The output is in (h x w x f) order: one row of `numFilters` values per output image pixel
+        const auto numFilters = outputSize[2];
         const auto outputColumns = outputSize[0] * outputSize[1];
         const auto numStoredBlocksPerFilter = (fieldVolumeSize - 1) / storedElementNumBits + 1;
         const auto packedRowSize = numStoredBlocksPerFilter; // numStoredBlocksPerFilter * (storedElementSize / elementSize);
@@ -595,16 +599,13 @@ namespace nodes
         const int packedRowStride = numStrideBlocks * (rowStrideElementSize / elementSize);
         const bool hasZeroPadding = predictors::neural::HasPadding(_inputPaddingParameters, predictors::neural::PaddingScheme::zeros);
 
-        bool useVectorInstructions = compilerSettings.allowVectorInstructions;
+        const bool useVectorInstructions = compilerSettings.allowVectorInstructions;
         const int numVectorBlocks = useVectorInstructions ? packedRowSize / vectorSize : 0;
-        if (numVectorBlocks == 0)
-        {
-            useVectorInstructions = false;
-        }
 
+        // Parallelize over output image pixels, so that each task writes a contiguous range of the output
         const int numDesiredTasks = compilerSettings.maxThreads;
-        const int taskSize = CeilDiv(numFilters, numDesiredTasks);
-        const int numTasks = CeilDiv(numFilters, taskSize);
+        const int taskSize = CeilDiv(outputColumns, numDesiredTasks);
+        const int numTasks = CeilDiv(outputColumns, taskSize);
         if (compilerSettings.parallelize && numTasks > 1)
         {
             auto taskFunction = GetTaskFunction(compiler, function);
@@ -612,7 +613,7 @@ namespace nodes
             for (int taskIndex = 0; taskIndex < numTasks; ++taskIndex)
             {
                 auto start = taskIndex * taskSize;
-                auto end = std::min((taskIndex + 1) * taskSize, numFilters);
+                auto end = std::min((taskIndex + 1) * taskSize, static_cast<int>(outputColumns));
                 std::vector<emitters::LLVMValue> args = { pInput, pFilterWeights, pFilterMeans, pInputPaddingMask, pInputPaddingMaskSums, pOutput, function.Literal<int32_t>(start), function.Literal<int32_t>(end) };
                 taskArgs.push_back(args);
             }
@@ -621,9 +622,8 @@ namespace nodes
         }
         else // single-threaded
         {
-            function.For(numFilters, [=, &compiler](emitters::IRFunctionEmitter& function, emitters::LLVMValue i) {
-                auto filterIndex = function.LocalScalar(i);
-                ComputeFilterOutput(compiler,
+            function.For(outputColumns, [=, &compiler](emitters::IRFunctionEmitter& function, emitters::LLVMValue outputColumnIndex) {
+                ComputeOutputColumn(compiler,
                                     function,
                                     pInput,
                                     pFilterWeights,
@@ -631,12 +631,11 @@ namespace nodes
                                     pInputPaddingMask,
                                     pInputPaddingMaskSums,
                                     pOutput,
-                                    filterIndex,
+                                    outputColumnIndex,
                                     hasZeroPadding,
-                                    outputColumns,
+                                    numFilters,
                                     packedRowSize,
                                     packedRowStride,
-                                    useVectorInstructions,
                                     vectorSize,
                                     numVectorBlocks);
             });
@@ -667,7 +666,6 @@ namespace nodes
         const auto& inputSize = inputLayout.GetActiveSize();
 
         const auto& outputLayout = this->GetOutputMemoryLayout();
-        // const auto& outputLayout = this->GetOutputMemoryLayout().ReorderedCopy({2,0,1}); // TODO: reorder from r,c,d -> d,r,c
         const auto& outputSize = outputLayout.GetActiveSize();
 
         // The workspace buffer element sizes are dependent on the processor architecture's bitness
@@ -680,9 +678,7 @@ namespace nodes
         const auto numInputChannels = inputSize[2]; // inputSize is the dimensions of the input to the original layer node
         const auto fieldVolumeSize = filterWidth * filterWidth * numInputChannels; // = size*size*numInputChannels
 
-        // TODO: Put this back once we're using the transposed output layout
-        // const auto outputColumns = outputSize[1] * outputSize[2];
-        const auto outputColumns = outputSize[0] * outputSize[1];
+        const auto numFilters = outputSize[2];
         const auto numStoredBlocksPerFilter = (fieldVolumeSize - 1) / storedElementNumBits + 1;
         const auto packedRowSize = numStoredBlocksPerFilter; // numStoredBlocksPerFilter * (storedElementSize / elementSize);
         assert(packedRowSize != 0);
@@ -694,13 +690,9 @@ namespace nodes
         const int packedRowStride = numStrideBlocks * (rowStrideElementSize / elementSize);
         const bool hasZeroPadding = predictors::neural::HasPadding(_inputPaddingParameters, predictors::neural::PaddingScheme::zeros);
 
-        bool useVectorInstructions = compilerSettings.allowVectorInstructions;
+        const bool useVectorInstructions = compilerSettings.allowVectorInstructions;
         const int vectorSize = compilerSettings.vectorWidth;
         const int numVectorBlocks = useVectorInstructions ? packedRowSize / vectorSize : 0;
-        if (numVectorBlocks == 0)
-        {
-            useVectorInstructions = false;
-        }
 
         // TODO: get types in a way that doesn't require emitting these variables
         auto argTypes = emitters::GetLLVMTypes({ pInput, pFilterWeights, pFilterMeans, pInputPaddingMask, pInputPaddingMaskSums, pOutput, function.Literal<int32_t>(0), function.Literal<int32_t>(0) });
@@ -720,8 +712,8 @@ namespace nodes
             auto blockStartVal = &(*arguments++);
             auto blockEndVal = &(*arguments++);
 
-            taskFunction.For(blockStartVal, blockEndVal, taskFunction.Literal<int>(1), [pInput, pFilterWeights, pFilterMeans, pInputPaddingMask, pInputPaddingMaskSums, pOutput, hasZeroPadding, outputColumns, packedRowSize, packedRowStride, useVectorInstructions, vectorSize, numVectorBlocks, &compiler, this](emitters::IRFunctionEmitter& taskFunction, emitters::LLVMValue filterIndex) {
-                ComputeFilterOutput(compiler,
+            taskFunction.For(blockStartVal, blockEndVal, taskFunction.Literal<int>(1), [pInput, pFilterWeights, pFilterMeans, pInputPaddingMask, pInputPaddingMaskSums, pOutput, hasZeroPadding, numFilters, packedRowSize, packedRowStride, vectorSize, numVectorBlocks, &compiler, this](emitters::IRFunctionEmitter& taskFunction, emitters::LLVMValue outputColumnIndex) {
+                ComputeOutputColumn(compiler,
                                     taskFunction,
                                     pInput,
                                     pFilterWeights,
@@ -729,12 +721,11 @@ namespace nodes
                                     pInputPaddingMask,
                                     pInputPaddingMaskSums,
                                     pOutput,
-                                    filterIndex,
+                                    outputColumnIndex,
                                     hasZeroPadding,
-                                    outputColumns,
+                                    numFilters,
                                     packedRowSize,
                                     packedRowStride,
-                                    useVectorInstructions,
                                     vectorSize,
                                     numVectorBlocks);
             });
@@ -746,7 +737,7 @@ namespace nodes
     }
 
     template <typename ValueType, typename PackedBitsType>
-    void BinaryXnorNode<ValueType, PackedBitsType>::ComputeFilterOutput(model::IRMapCompiler& compiler,
+    void BinaryXnorNode<ValueType, PackedBitsType>::ComputeOutputColumn(model::IRMapCompiler& compiler,
                                                                         emitters::IRFunctionEmitter& function,
                                                                         emitters::LLVMValue pInput,
                                                                         emitters::LLVMValue pFilterWeights,
@@ -754,14 +745,49 @@ namespace nodes
                                                                         emitters::LLVMValue pInputPaddingMask,
                                                                         emitters::LLVMValue pInputPaddingMaskSums,
                                                                         emitters::LLVMValue pOutput,
-                                                                        emitters::LLVMValue filterIndexPtr,
+                                                                        emitters::LLVMValue outputColumnIndex,
                                                                         bool hasZeroPadding,
-                                                                        int outputColumns,
+                                                                        int numFilters,
                                                                         int packedRowSize,
                                                                         int packedRowStride,
-                                                                        bool useVectorInstructions,
                                                                         int vectorSize,
                                                                         int numVectorBlocks)
+    {
+        // Compute the filters in blocks, plus one smaller block for the leftover filters
+        const int filterBlockSize = std::min(maxFilterBlockSize, numFilters);
+        const int numFilterBlocks = numFilters / filterBlockSize;
+        const int numLeftoverFilters = numFilters % filterBlockSize;
+
+        function.For(numFilterBlocks, [=, &compiler](emitters::IRFunctionEmitter& function, emitters::LLVMValue i) {
+            auto filterBlockStart = function.LocalScalar(i) * filterBlockSize;
+            ComputeFilterBlockOutput(compiler, function, pInput, pFilterWeights, pFilterMeans, pInputPaddingMask, pInputPaddingMaskSums, pOutput, outputColumnIndex, filterBlockStart, filterBlockSize, hasZeroPadding, numFilters, packedRowSize, packedRowStride, vectorSize, numVectorBlocks);
+        });
+
+        if (numLeftoverFilters > 0)
+        {
+            auto filterBlockStart = function.Literal<int>(numFilterBlocks * filterBlockSize);
+            ComputeFilterBlockOutput(compiler, function, pInput, pFilterWeights, pFilterMeans, pInputPaddingMask, pInputPaddingMaskSums, pOutput, outputColumnIndex, filterBlockStart, numLeftoverFilters, hasZeroPadding, numFilters, packedRowSize, packedRowStride, vectorSize, numVectorBlocks);
+        }
+    }
+
+    template <typename ValueType, typename PackedBitsType>
+    void BinaryXnorNode<ValueType, PackedBitsType>::ComputeFilterBlockOutput(model::IRMapCompiler& compiler,
+                                                                             emitters::IRFunctionEmitter& function,
+                                                                             emitters::LLVMValue pInput,
+                                                                             emitters::LLVMValue pFilterWeights,
+                                                                             emitters::LLVMValue pFilterMeans,
+                                                                             emitters::LLVMValue pInputPaddingMask,
+                                                                             emitters::LLVMValue pInputPaddingMaskSums,
+                                                                             emitters::LLVMValue pOutput,
+                                                                             emitters::LLVMValue outputColumnIndexValue,
+                                                                             emitters::LLVMValue filterBlockStartValue,
+                                                                             int filterBlockSize,
+                                                                             bool hasZeroPadding,
+                                                                             int numFilters,
+                                                                             int packedRowSize,
+                                                                             int packedRowStride,
+                                                                             int vectorSize,
+                                                                             int numVectorBlocks)
     {
         // Input / output memory layouts (of the original node)
         const auto& inputLayout = this->GetInputMemoryLayout();
@@ -779,7 +805,8 @@ namespace nodes
 
         const auto partialBlockSize = fieldVolumeSize % numBits;
 
-        auto filterIndex = function.LocalScalar(filterIndexPtr);
+        auto outputColumnIndex = function.LocalScalar(outputColumnIndexValue);
+        auto filterBlockStart = function.LocalScalar(filterBlockStartValue);
 
         // Get LLVM types
         auto& emitter = function.GetEmitter();
@@ -791,66 +818,64 @@ namespace nodes
         emitters::LLVMFunction popcountFunction = function.GetModule().GetIntrinsic(llvm::Intrinsic::ctpop, { packedBitsType });
         emitters::LLVMFunction vecPopcountFunction = function.GetModule().GetIntrinsic(llvm::Intrinsic::ctpop, { vectorType });
 
-        // The start of the binarized weights matrix for this filter
-        auto weightsBegin = filterIndex * packedRowStride;
-        auto weightsBeginPtr = function.PointerOffset(pFilterWeights, weightsBegin);
-        auto weightsVector = function.CastPointer(weightsBeginPtr, vectorPointerType);
+        // The start of the binarized receptive field matrix for this output image pixel
+        auto inputBeginPtr = function.PointerOffset(pInput, outputColumnIndex * packedRowSize);
+        auto paddingMaskBeginPtr = function.PointerOffset(pInputPaddingMask, outputColumnIndex * packedRowStride);
 
-        emitters::LLVMValue filterMean = nullptr;
-        if (_convolutionalParameters.weightsScale == scaleOutputByFilterMeans)
+        // The start of the binarized weights matrix for each filter in the block
+        std::vector<emitters::LLVMValue> weightsBeginPtrs;
+        std::vector<emitters::LLVMValue> weightsVectors;
+        for (int filter = 0; filter < filterBlockSize; ++filter)
         {
-            filterMean = function.ValueAt(pFilterMeans, filterIndex);
+            auto weightsBeginPtr = function.PointerOffset(pFilterWeights, (filterBlockStart + filter) * packedRowStride);
+            weightsBeginPtrs.push_back(weightsBeginPtr);
+            weightsVectors.push_back(function.CastPointer(weightsBeginPtr, vectorPointerType));
         }
 
         const int numScalarBlocks = packedRowSize - (vectorSize * numVectorBlocks);
 
-        // Variables to hold the running sum of xor values
-        emitters::LLVMValue vectorSumVar = useVectorInstructions ? function.Variable(vectorType, "vecXorSum") : nullptr;
-        emitters::LLVMValue sumVar = numScalarBlocks > 0 ? function.Variable(packedBitsType, "xorSum") : nullptr;
-
-        // Compute and accumulate xnor counts
-
-        function.For(outputColumns, [=](emitters::IRFunctionEmitter& function, emitters::LLVMValue i) {
-            auto outputColumnIndex = function.LocalScalar(i);
-
-            // The start of the binarized receptive field matrix for this output image pixel
-            auto inputBegin = outputColumnIndex * packedRowSize;
-            auto paddingBegin = outputColumnIndex * packedRowStride;
-
-            auto inputBeginPtr = function.PointerOffset(pInput, inputBegin);
-            auto paddingMaskBeginPtr = function.PointerOffset(pInputPaddingMask, paddingBegin);
-
-            auto vectorXorSum = function.LocalScalar();
+        // Variables to hold the running sums of xor values, one per filter
+        std::vector<emitters::LLVMValue> vectorSumVars;
+        std::vector<emitters::LLVMValue> sumVars;
+        for (int filter = 0; filter < filterBlockSize; ++filter)
+        {
             if (numVectorBlocks > 0)
             {
-                assert(vectorSumVar != nullptr);
-
-                // cast to vector pointer
-                auto inputVector = function.CastPointer(inputBeginPtr, vectorPointerType);
-                auto paddingMaskVector = function.CastPointer(paddingMaskBeginPtr, vectorPointerType);
-
-                // If vector instructions are enabled, create a variable to store the running vector sum
+                auto vectorSumVar = function.Variable(vectorType, "vecXorSum");
                 function.Store(vectorSumVar, emitters::FillVector<PackedBitsType>(function, vectorType, 0));
-                EmitInnerLoop(function, inputVector, paddingMaskVector, weightsVector, vectorSumVar, vecPopcountFunction, 0, numVectorBlocks, hasZeroPadding);
-
-                // Accumulate horizontal sum into output
-                vectorXorSum = emitters::HorizontalVectorSum<PackedBitsType>(function, function.Load(vectorSumVar));
-                assert(vectorXorSum.value->getType() == packedBitsType);
+                vectorSumVars.push_back(vectorSumVar);
             }
-
-            // Now compute the non-vectorized values
-            const int numScalarBlocks = packedRowSize - (vectorSize * numVectorBlocks);
             if (numScalarBlocks > 0)
             {
-                assert(sumVar != nullptr);
+                auto sumVar = function.Variable(packedBitsType, "xorSum");
                 function.StoreZero(sumVar);
-                auto start = vectorSize * numVectorBlocks;
-                EmitInnerLoop(function, inputBeginPtr, paddingMaskBeginPtr, weightsBeginPtr, sumVar, popcountFunction, start, numScalarBlocks, hasZeroPadding);
+                sumVars.push_back(sumVar);
             }
+        }
 
-            emitters::LLVMValue xorSum = (sumVar == nullptr) ? nullptr : function.Load(sumVar);
-            if (vectorXorSum.value != nullptr)
+        // Compute and accumulate xnor counts
+        if (numVectorBlocks > 0)
+        {
+            auto inputVector = function.CastPointer(inputBeginPtr, vectorPointerType);
+            auto paddingMaskVector = function.CastPointer(paddingMaskBeginPtr, vectorPointerType);
+            EmitInnerLoop(function, inputVector, paddingMaskVector, weightsVectors, vectorSumVars, vecPopcountFunction, 0, numVectorBlocks, hasZeroPadding);
+        }
+
+        // Now compute the non-vectorized values
+        if (numScalarBlocks > 0)
+        {
+            auto start = vectorSize * numVectorBlocks;
+            EmitInnerLoop(function, inputBeginPtr, paddingMaskBeginPtr, weightsBeginPtrs, sumVars, popcountFunction, start, numScalarBlocks, hasZeroPadding);
+        }
+
+        for (int filter = 0; filter < filterBlockSize; ++filter)
+        {
+            emitters::LLVMValue xorSum = (numScalarBlocks > 0) ? function.Load(sumVars[filter]) : nullptr;
+            if (numVectorBlocks > 0)
             {
+                // Accumulate horizontal sum into output
+                auto vectorXorSum = function.LocalScalar(emitters::HorizontalVectorSum<PackedBitsType>(function, function.Load(vectorSumVars[filter])));
+                assert(vectorXorSum.value->getType() == packedBitsType);
                 xorSum = (xorSum == nullptr) ? vectorXorSum : xorSum + vectorXorSum;
             }
             assert(xorSum != nullptr);
@@ -875,11 +900,13 @@ namespace nodes
                 adjustedSum = sumFloat - function.LocalScalar<ValueType>(filterAdjust);
             }
 
-            auto outIndex = (filterIndex * outputColumns) + outputColumnIndex;
+            // The output is in (h x w x f) order
+            auto filterIndex = filterBlockStart + filter;
+            auto outIndex = (outputColumnIndex * numFilters) + filterIndex;
             if (_convolutionalParameters.weightsScale == scaleOutputByFilterMeans)
             {
                 // Scale output by the filters mean
-                assert(filterMean != nullptr);
+                emitters::LLVMValue filterMean = function.ValueAt(pFilterMeans, filterIndex);
                 auto scaledOutput = adjustedSum * filterMean;
                 function.SetValueAt(pOutput, outIndex, scaledOutput);
             }
@@ -888,7 +915,7 @@ namespace nodes
                 // No output scaling
                 function.SetValueAt(pOutput, outIndex, adjustedSum);
             }
-        });
+        }
     }
 
     template <typename ValueType, typename PackedBitsType>
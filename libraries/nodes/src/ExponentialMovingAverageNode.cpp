@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ExponentialMovingAverageNode.cpp (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ExponentialMovingAverageNode.h"
+
+#include <emitters/include/EmitterTypes.h>
+#include <emitters/include/IRLocalValue.h>
+
+#include <algorithm>
+
+namespace ell
+{
+namespace nodes
+{
+    template <typename ValueType>
+    ExponentialMovingAverageNode<ValueType>::ExponentialMovingAverageNode() :
+        CompilableNode({ &_input }, { &_output }),
+        _input(this, {}, defaultInputPortName),
+        _output(this, defaultOutputPortName, 0),
+        _smoothingFactor(1)
+    {
+    }
+
+    template <typename ValueType>
+    ExponentialMovingAverageNode<ValueType>::ExponentialMovingAverageNode(const model::OutputPort<ValueType>& input, ValueType smoothingFactor) :
+        CompilableNode({ &_input }, { &_output }),
+        _input(this, input, defaultInputPortName),
+        _output(this, defaultOutputPortName, _input.Size()),
+        _smoothingFactor(smoothingFactor),
+        _average(_input.Size())
+    {
+        if (!(smoothingFactor > 0 && smoothingFactor <= 1))
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "ExponentialMovingAverageNode: smoothing factor must be in (0, 1]");
+        }
+    }
+
+    template <typename ValueType>
+    void ExponentialMovingAverageNode<ValueType>::Compute() const
+    {
+        auto inputSample = _input.GetValue();
+        for (size_t index = 0; index < inputSample.size(); ++index)
+        {
+            _average[index] += _smoothingFactor * (inputSample[index] - _average[index]);
+        }
+        _output.SetOutput(_average);
+    };
+
+    template <typename ValueType>
+    void ExponentialMovingAverageNode<ValueType>::Reset()
+    {
+        std::fill(_average.begin(), _average.end(), static_cast<ValueType>(0));
+    }
+
+    template <typename ValueType>
+    void ExponentialMovingAverageNode<ValueType>::Copy(model::ModelTransformer& transformer) const
+    {
+        const auto& newInputs = transformer.GetCorrespondingInputs(_input);
+        auto newNode = transformer.AddNode<ExponentialMovingAverageNode<ValueType>>(newInputs, _smoothingFactor);
+        transformer.MapNodeOutput(output, newNode->output);
+    }
+
+    template <typename ValueType>
+    void ExponentialMovingAverageNode<ValueType>::Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
+    {
+        using namespace std::string_literals;
+
+        const auto size = input.Size();
+        const auto smoothingFactor = _smoothingFactor;
+        llvm::GlobalVariable* average = function.GetModule().GlobalArray("average_"s + GetInternalStateIdentifier(), std::vector<ValueType>(size, 0));
+
+        emitters::LLVMValue pInput = compiler.EnsurePortEmitted(input);
+        emitters::LLVMValue pOutput = compiler.EnsurePortEmitted(output);
+        function.For(size, [=](emitters::IRFunctionEmitter& function, emitters::LLVMValue index) {
+            auto x = function.LocalScalar(function.ValueAt(pInput, index));
+            auto previous = function.LocalScalar(function.ValueAt(average, index));
+            auto result = previous + (smoothingFactor * (x - previous));
+            function.SetValueAt(average, index, result);
+            function.SetValueAt(pOutput, index, result);
+        });
+    }
+
+    template <typename ValueType>
+    void ExponentialMovingAverageNode<ValueType>::WriteToArchive(utilities::Archiver& archiver) const
+    {
+        Node::WriteToArchive(archiver);
+        archiver[defaultInputPortName] << _input;
+        archiver["smoothingFactor"] << _smoothingFactor;
+    }
+
+    template <typename ValueType>
+    void ExponentialMovingAverageNode<ValueType>::ReadFromArchive(utilities::Unarchiver& archiver)
+    {
+        Node::ReadFromArchive(archiver);
+        archiver[defaultInputPortName] >> _input;
+        archiver["smoothingFactor"] >> _smoothingFactor;
+        _average.assign(_input.Size(), 0);
+        _output.SetSize(_input.Size());
+    }
+
+    //
+    // Explicit instantiation definitions
+    //
+    template class ExponentialMovingAverageNode<float>;
+    template class ExponentialMovingAverageNode<double>;
+} // namespace nodes
+} // namespace ell
@@ -14,18 +14,17 @@
 #include <emitters/include/IRMath.h>
 #include <emitters/include/LLVMUtilities.h>
 
-#include <math/include/MathConstants.h>
+#include <dsp/include/FFTPlan.h>
 
-#include <dsp/include/FFT.h>
+#include <utilities/include/Unused.h>
 
 #include <llvm/IR/Type.h>
 
 #include <cmath>
+#include <complex>
 
-#define USE_STORED_TWIDDLE_FACTORS 1
 #define USE_FIXED_SMALL_FFT 1
 #define MAX_INLINE_FFT_SIZE 0 // 0 to disable inlining FFT code
-#define USE_REAL_FFT 0 // The real-valued FFT is slower than the complex one. Disable it for now.
 
 namespace ell
 {
@@ -68,23 +67,6 @@ namespace nodes
             return { function, function.Load(result) };
         }
 
-        inline emitters::IRLocalValue RealComplexAdd(emitters::IRLocalScalar a_re, emitters::IRLocalValue b)
-        {
-            if (!(b.value->getType()->isStructTy() && b.value->getType()->getNumContainedTypes() == 2 && a_re.value->getType() == b.value->getType()->getContainedType(0)))
-            {
-                throw emitters::EmitterException(emitters::EmitterError::valueTypeNotSupported);
-            }
-
-            // c.re = a.re + b.re
-            // c.im = b.im
-            auto& function = a_re.function;
-            auto b_re = function.LocalScalar(function.ExtractStructField(b, 0));
-            auto b_im = function.LocalScalar(function.ExtractStructField(b, 1));
-            auto result = function.Variable(b.value->getType(), "rc_add");
-            function.FillStruct(result, { a_re + b_re, b_im });
-            return { function, function.Load(result) };
-        }
-
         inline emitters::IRLocalValue ComplexSubtract(emitters::IRLocalValue a, emitters::IRLocalValue b)
         {
             if (!(a.value->getType()->isStructTy() && a.value->getType()->getNumContainedTypes() == 2 && a.value->getType() == b.value->getType()))
@@ -104,23 +86,6 @@ namespace nodes
             return { function, function.Load(result) };
         }
 
-        inline emitters::IRLocalValue RealComplexSubtract(emitters::IRLocalScalar a_re, emitters::IRLocalValue b)
-        {
-            if (!(b.value->getType()->isStructTy() && b.value->getType()->getNumContainedTypes() == 2 && a_re.value->getType() == b.value->getType()->getContainedType(0)))
-            {
-                throw emitters::EmitterException(emitters::EmitterError::valueTypeNotSupported);
-            }
-
-            // c.re = a.re - b.re
-            // c.im = b.im
-            auto& function = a_re.function;
-            auto b_re = function.LocalScalar(function.ExtractStructField(b, 0));
-            auto b_im = function.LocalScalar(function.ExtractStructField(b, 1));
-            auto result = function.Variable(b.value->getType(), "rc_sub");
-            function.FillStruct(result, { a_re - b_re, b_im });
-            return { function, function.Load(result) };
-        }
-
         inline emitters::IRLocalValue ComplexMultiply(emitters::IRLocalValue a, emitters::IRLocalValue b)
         {
             if (!(a.value->getType()->isStructTy() && a.value->getType()->getNumContainedTypes() == 2 && a.value->getType() == b.value->getType()))
@@ -158,23 +123,6 @@ namespace nodes
             return { function, function.Load(result) };
         }
 
-        inline emitters::IRLocalValue ComplexRealMultiply(emitters::IRLocalValue a, emitters::IRLocalScalar b_re)
-        {
-            if (!(a.value->getType()->isStructTy() && a.value->getType()->getNumContainedTypes() == 2 && a.value->getType()->getContainedType(0) == b_re.value->getType()))
-            {
-                throw emitters::EmitterException(emitters::EmitterError::valueTypeNotSupported);
-            }
-
-            // c.re = a.re * b
-            // c.im = a.im * b
-            auto& function = a.function;
-            auto a_re = function.LocalScalar(function.ExtractStructField(a, 0));
-            auto a_im = function.LocalScalar(function.ExtractStructField(a, 1));
-            auto result = function.Variable(a.value->getType(), "rc_mul");
-            function.FillStruct(result, { (a_re * b_re), (a_im * b_re) });
-            return { function, function.Load(result) };
-        }
-
         inline emitters::IRLocalValue ComplexAbs(emitters::IRLocalValue a)
         {
             if (!(a.value->getType()->isStructTy() && a.value->getType()->getNumContainedTypes() == 2))
@@ -190,34 +138,9 @@ namespace nodes
             return { function, Sqrt(magSquared) };
         }
 
-        inline emitters::IRLocalValue ImaginaryExp(emitters::IRLocalScalar x)
-        {
-            auto& function = x.function;
-            auto& module = function.GetModule();
-            auto type = x.value->getType();
-            auto complexType = GetComplexType(module, type);
-            // returns e ^ ix == cos(x) + isin(x)
-            auto result = function.Variable(complexType, "i_exp");
-            function.FillStruct(result, { Cos(x), Sin(x) });
-            return { function, function.Load(result) };
-        }
-
         //
         // FFT-specific functions
         //
-        template <typename ValueType>
-        std::vector<std::complex<ValueType>> GetTwiddleFactors(size_t size)
-        {
-            // size == FFT length / 2
-            const auto pi = math::Constants<ValueType>::pi;
-            std::vector<std::complex<ValueType>> result(size);
-            for (size_t k = 0; k < size; ++k)
-            {
-                result[k] = std::exp(std::complex<ValueType>(0, pi * k / size));
-            }
-            return result;
-        }
-
         template <typename ValueType>
         std::string GetFFTFunctionName(size_t length)
         {
@@ -226,14 +149,6 @@ namespace nodes
             return std::string("FFTC_") + utilities::GetTypeName<ValueType>() + "_" + std::to_string(length);
         }
 
-        template <typename ValueType>
-        std::string GetRealFFTFunctionName(size_t length)
-        {
-            // function name: FFTR_<T>_<N>  (e.g., FFT_float_32)
-            // function signature: void FFTR(T*, T*, complex<T>*)
-            return std::string("FFTR_") + utilities::GetTypeName<ValueType>() + "_" + std::to_string(length);
-        }
-
         template <typename ValueType>
         std::vector<emitters::LLVMType> GetFFTFunctionArguments(emitters::IRModuleEmitter& module)
         {
@@ -242,17 +157,6 @@ namespace nodes
             return { complexPtrType, complexPtrType };
         }
 
-        template <typename ValueType>
-        std::vector<emitters::LLVMType> GetRealFFTFunctionArguments(emitters::IRModuleEmitter& module)
-        {
-            auto& emitter = module.GetIREmitter();
-            auto valueType = emitter.Type(emitters::GetVariableType<ValueType>());
-            auto valuePtrType = valueType->getPointerTo();
-            auto complexType = detail::GetComplexType(module, valueType);
-            auto complexPtrType = complexType->getPointerTo();
-            return { valuePtrType, valuePtrType, complexPtrType };
-        }
-
         template <typename ValueType>
         emitters::IRFunctionEmitter GetFFTFunctionEmitter(emitters::IRModuleEmitter& module, size_t length)
         {
@@ -267,20 +171,6 @@ namespace nodes
             return function;
         }
 
-        template <typename ValueType>
-        emitters::IRFunctionEmitter GetRealFFTFunctionEmitter(emitters::IRModuleEmitter& module, size_t length)
-        {
-            auto& context = module.GetLLVMContext();
-            auto voidType = llvm::Type::getVoidTy(context);
-
-            std::string functionName = GetRealFFTFunctionName<ValueType>(length);
-            auto argumentTypes = detail::GetRealFFTFunctionArguments<ValueType>(module);
-            emitters::IRFunctionEmitter function = module.BeginFunction(functionName, voidType, argumentTypes);
-            function.SetAttributeForArguments(emitters::IRFunctionEmitter::Attributes::NoAlias);
-
-            return function;
-        }
-
     } // namespace detail
 
     template <typename ValueType>
@@ -302,6 +192,7 @@ namespace nodes
         double nearestPowerOf2Size = std::pow(2, std::ceil(std::log2(input.Size())));
         _fftSize = static_cast<size_t>(nearestPowerOf2Size);
         _output.SetSize(_fftSize / 2 + 1);
+        _plan = dsp::GetFFTPlan<ValueType>(_fftSize);
     }
 
     template <typename ValueType>
@@ -320,26 +211,7 @@ namespace nodes
         {
             throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "fftSize must be a power of 2");
         }
-    }
-
-    inline void Deinterleave(emitters::IRFunctionEmitter& function, emitters::LLVMValue array, emitters::LLVMValue halfLength, emitters::LLVMValue scratch)
-    {
-        auto halfN = function.LocalScalar(halfLength);
-        function.For(halfN, [&scratch, &array](emitters::IRFunctionEmitter& function, auto index) {
-            auto evenIndex = index * 2;
-            auto oddIndex = evenIndex + 1;
-            function.SetValueAt(scratch, index, function.ValueAt(array, oddIndex));
-            function.SetValueAt(array, index, function.ValueAt(array, evenIndex));
-        });
-
-        function.For(halfN, [&scratch, &array, halfN](emitters::IRFunctionEmitter& function, auto index) {
-            function.SetValueAt(array, index + halfN, function.ValueAt(scratch, index));
-        });
-    }
-
-    inline void Deinterleave(emitters::IRFunctionEmitter& function, emitters::LLVMValue array, int halfN, emitters::LLVMValue scratch)
-    {
-        Deinterleave(function, array, function.Literal(halfN), scratch);
+        _plan = dsp::GetFFTPlan<ValueType>(_fftSize);
     }
 
     // FFT1 twiddle factors: [1]
@@ -432,64 +304,109 @@ namespace nodes
     template <typename ValueType>
     void FFTNode<ValueType>::EmitFFT(emitters::IRFunctionEmitter& function, size_t length, emitters::LLVMValue input, emitters::LLVMValue scratch)
     {
+        UNUSED(scratch);
 #if (USE_FIXED_SMALL_FFT)
         if (length == 2)
         {
             EmitFFT_2(function, input);
+            return;
         }
         if (length == 4)
         {
             EmitFFT_4(function, input);
+            return;
         }
 #endif // USE_FIXED_SMALL_FFT
 
-        // TODO: assert(bitcount(length) == 1)  (i.e., length is a power of 2)
+        // The emitted code is the same iterative radix-4 algorithm as `dsp::FFTPlan`, and gets its
+        // bit-reversal permutation and twiddle factors from the plan for this size
+        auto plan = dsp::GetFFTPlan<ValueType>(length);
         auto& module = function.GetModule();
         auto& emitter = module.GetIREmitter();
         auto valueType = emitter.Type(emitters::GetVariableType<ValueType>());
         auto complexType = detail::GetComplexType(module, valueType);
         auto complexPtrType = complexType->getPointerTo();
+        const auto suffix = utilities::GetTypeName<ValueType>() + "_" + std::to_string(length);
 
-        auto halfN = length / 2;
-        assert(halfN >= 1);
-
-        Deinterleave(function, input, halfN, scratch);
-        auto evens = input;
-        auto odds = function.PointerOffset(evens, halfN);
-
-        if (halfN > 1) // call recursive case if necessary
+        // Bit-reversal permutation, stored as the list of pairs of entries to swap
+        const auto& bitReversal = plan->GetBitReversalPermutation();
+        std::vector<int> swapIndices;
+        for (size_t index = 0; index < length; ++index)
         {
-            DoFFT(function, halfN, evens, scratch);
-            DoFFT(function, halfN, odds, scratch);
+            if (index < bitReversal[index])
+            {
+                swapIndices.push_back(static_cast<int>(index));
+                swapIndices.push_back(static_cast<int>(bitReversal[index]));
+            }
         }
+        auto swapIndicesVar = module.ConstantArray(std::string("fft_swaps_") + suffix, swapIndices);
+        function.For(static_cast<int>(swapIndices.size() / 2), [swapIndicesVar, input](emitters::IRFunctionEmitter& function, auto pair) {
+            auto a = function.LocalScalar(function.ValueAt(swapIndicesVar, 2 * pair));
+            auto b = function.LocalScalar(function.ValueAt(swapIndicesVar, 2 * pair + 1));
+            auto x_a = function.LocalScalar(function.ValueAt(input, a));
+            auto x_b = function.LocalScalar(function.ValueAt(input, b));
+            function.SetValueAt(input, a, x_b);
+            function.SetValueAt(input, b, x_a);
+        });
 
-#if (USE_STORED_TWIDDLE_FACTORS)
-        auto twiddleFactors = detail::GetTwiddleFactors<ValueType>(halfN);
+        const auto& twiddleFactors = plan->GetTwiddleFactors();
         std::vector<ValueType> twiddleFactorsUnwrapped(twiddleFactors.size() * 2);
-        ValueType* dataPtr = reinterpret_cast<ValueType*>(twiddleFactors.data());
+        const ValueType* dataPtr = reinterpret_cast<const ValueType*>(twiddleFactors.data());
         std::copy(dataPtr, dataPtr + twiddleFactorsUnwrapped.size(), twiddleFactorsUnwrapped.begin());
-        auto twiddleFactorsUnwrappedVar = module.ConstantArray(std::string("twiddles_") + std::to_string(halfN), twiddleFactorsUnwrapped); // TODO: encode type name in variable name
+        auto twiddleFactorsUnwrappedVar = module.ConstantArray(std::string("fft_twiddles_") + suffix, twiddleFactorsUnwrapped);
         auto twiddleFactorsVar = function.CastPointer(twiddleFactorsUnwrappedVar, complexPtrType);
-#else
-        bool twiddleFactorsVar = false;
-#endif
-
-        function.For(halfN, [&evens, &odds, &twiddleFactorsVar](emitters::IRFunctionEmitter& function, auto k) {
-
-#if (USE_STORED_TWIDDLE_FACTORS)
-            auto w = function.LocalScalar(function.ValueAt(twiddleFactorsVar, k));
-#else
-            // w = e^i(2*pi*k/N)
-            auto kValue = function.LocalScalar(function.CastValue<ValueType>(k));
-            auto w = detail::ImaginaryExp(function.LocalScalar(pi / halfN) * kValue);
-#endif
-
-            auto e = function.LocalScalar(function.ValueAt(evens, k));
-            auto o = function.LocalScalar(function.ValueAt(odds, k));
-            auto wo = detail::ComplexMultiply(w, o); // wo = w*o
-            function.SetValueAt(evens, k, detail::ComplexAdd(e, wo)); // even
-            function.SetValueAt(odds, k, detail::ComplexSubtract(e, wo)); // odd
-        });
+
+        size_t numBits = 0;
+        while ((size_t{ 1 } << numBits) < length)
+        {
+            ++numBits;
+        }
+
+        // If the number of passes is odd, start with a radix-2 pass
+        size_t passSize = 1;
+        if (numBits % 2 == 1)
+        {
+            function.For(static_cast<int>(length / 2), [this, input](emitters::IRFunctionEmitter& function, auto index) {
+                EmitFFT_2(function, function.PointerOffset(input, 2 * index));
+            });
+            passSize = 2;
+        }
+
+        // Radix-4 passes. The 4 inputs to each butterfly hold the entries whose indices are 0, 2, 1, and 3 (mod 4).
+        for (; passSize < length; passSize *= 4)
+        {
+            const auto blockSize = static_cast<int>(4 * passSize);
+            const auto halfBlock = static_cast<int>(2 * passSize);
+            const auto quarterBlock = static_cast<int>(passSize);
+            const auto twiddleStride = static_cast<int>(length / (4 * passSize));
+            function.For(static_cast<int>(length / (4 * passSize)), [=](emitters::IRFunctionEmitter& function, auto block) {
+                auto begin = block * blockSize;
+                function.For(quarterBlock, [=](emitters::IRFunctionEmitter& function, auto k) {
+                    auto i0 = begin + k;
+                    auto i2 = i0 + quarterBlock;
+                    auto i1 = i0 + halfBlock;
+                    auto i3 = i1 + quarterBlock;
+                    auto w1 = function.LocalScalar(function.ValueAt(twiddleFactorsVar, k * twiddleStride));
+                    auto w2 = function.LocalScalar(function.ValueAt(twiddleFactorsVar, k * (2 * twiddleStride)));
+                    auto w3 = function.LocalScalar(function.ValueAt(twiddleFactorsVar, k * (3 * twiddleStride)));
+
+                    auto a0 = function.LocalScalar(function.ValueAt(input, i0));
+                    auto a1 = detail::ComplexMultiply(w1, function.LocalScalar(function.ValueAt(input, i1)));
+                    auto a2 = detail::ComplexMultiply(w2, function.LocalScalar(function.ValueAt(input, i2)));
+                    auto a3 = detail::ComplexMultiply(w3, function.LocalScalar(function.ValueAt(input, i3)));
+
+                    auto sum02 = detail::ComplexAdd(a0, a2);
+                    auto diff02 = detail::ComplexSubtract(a0, a2);
+                    auto sum13 = detail::ComplexAdd(a1, a3);
+                    auto diff13 = detail::TimesI<ValueType>(detail::ComplexSubtract(a1, a3));
+
+                    function.SetValueAt(input, i0, detail::ComplexAdd(sum02, sum13));
+                    function.SetValueAt(input, i2, detail::ComplexAdd(diff02, diff13));
+                    function.SetValueAt(input, i1, detail::ComplexSubtract(sum02, sum13));
+                    function.SetValueAt(input, i3, detail::ComplexSubtract(diff02, diff13));
+                });
+            });
+        }
     }
 
     // Fixed-size FFT function implementation: size is known at compile time
@@ -527,89 +444,6 @@ namespace nodes
         return function.GetFunction();
     }
 
-    // Real-valued fixed-size FFT function implementation: size is known at compile time
-    template <typename ValueType>
-    void FFTNode<ValueType>::EmitRealFFT(emitters::IRFunctionEmitter& function, size_t length, emitters::LLVMValue input, emitters::LLVMValue scratch, emitters::LLVMValue complexInput)
-    {
-        // TODO: assert(bitcount(length) == 1)  (i.e., length is a power of 2)
-        auto& module = function.GetModule();
-        auto complexType = detail::GetComplexType<ValueType>(module);
-        auto complexPtrType = complexType->getPointerTo();
-
-        auto halfN = length / 2;
-        assert(halfN >= 1);
-
-        Deinterleave(function, input, halfN, scratch);
-        auto evens = input;
-        auto odds = function.PointerOffset(evens, halfN);
-        auto complexEvens = complexInput;
-        auto complexOdds = function.PointerOffset(complexEvens, halfN);
-
-        if (halfN > 1) // call recursive case if necessary
-        {
-            DoRealFFT(function, halfN, evens, scratch, complexEvens);
-            DoRealFFT(function, halfN, odds, scratch, complexOdds);
-        }
-        else // here halfN == 1
-        {
-            // Base case: copy from real to complex
-            function.FillStruct(complexEvens, { function.Load(evens), function.Literal<ValueType>(0) });
-            function.FillStruct(complexOdds, { function.Load(odds), function.Literal<ValueType>(0) });
-        }
-
-#if (USE_STORED_TWIDDLE_FACTORS)
-        auto twiddleFactors = detail::GetTwiddleFactors<ValueType>(halfN);
-        std::vector<ValueType> twiddleFactorsUnwrapped(twiddleFactors.size() * 2);
-        ValueType* dataPtr = reinterpret_cast<ValueType*>(twiddleFactors.data());
-        std::copy(dataPtr, dataPtr + twiddleFactorsUnwrapped.size(), twiddleFactorsUnwrapped.begin());
-        auto twiddleFactorsUnwrappedVar = module.ConstantArray(std::string("twiddles_") + std::to_string(halfN), twiddleFactorsUnwrapped);
-        auto twiddleFactorsVar = function.CastPointer(twiddleFactorsUnwrappedVar, complexPtrType);
-#else
-        bool twiddleFactorsVar = false; // Just here to appease the compiler
-#endif
-
-        function.For(halfN, [&evens, &odds, &complexEvens, complexOdds, &twiddleFactorsVar](emitters::IRFunctionEmitter& function, auto k) {
-
-#if (USE_STORED_TWIDDLE_FACTORS)
-            auto w = function.LocalScalar(function.ValueAt(twiddleFactorsVar, k));
-#else
-            // w = e^i(2*pi*k/N)
-            auto kValue = function.LocalScalar(function.CastValue<ValueType>(k));
-            auto w = detail::ImaginaryExp(function.LocalScalar(pi / halfN) * kValue);
-#endif
-
-            auto e = function.LocalScalar(function.ValueAt(evens, k));
-            auto o = function.LocalScalar(function.ValueAt(odds, k));
-            auto wo = detail::ComplexRealMultiply(w, o); // wo = w*o
-            function.SetValueAt(complexEvens, k, detail::RealComplexAdd(e, wo)); // even
-            function.SetValueAt(complexOdds, k, detail::RealComplexSubtract(e, wo)); // odd
-        });
-    }
-
-    // Real-valued fixed-size FFT function implementation: size is known at compile time
-    template <typename ValueType>
-    emitters::LLVMFunction FFTNode<ValueType>::GetRealFFTFunction(emitters::IRModuleEmitter& module, size_t length)
-    {
-        auto functionName = detail::GetRealFFTFunctionName<ValueType>(length);
-        auto existingFunction = module.GetFunction(functionName);
-        if (existingFunction != nullptr)
-        {
-            return existingFunction;
-        }
-
-        emitters::IRFunctionEmitter function = detail::GetFFTFunctionEmitter<ValueType>(module, length);
-        {
-            auto arguments = function.Arguments().begin();
-            auto input = function.LocalScalar(&(*arguments++));
-            auto scratch = function.LocalScalar(&(*arguments++));
-            auto complexInput = function.LocalScalar(&(*arguments++));
-
-            EmitRealFFT(function, length, input, scratch, complexInput);
-        }
-        module.EndFunction();
-        return function.GetFunction();
-    }
-
     // Perform fixed-size FFT: size is known at compile time
     template <typename ValueType>
     void FFTNode<ValueType>::DoFFT(emitters::IRFunctionEmitter& function, size_t length, emitters::LLVMValue input, emitters::LLVMValue scratch)
@@ -627,23 +461,6 @@ namespace nodes
         }
     }
 
-    // Fixed-size FFT function implementation: size is known at compile time
-    template <typename ValueType>
-    void FFTNode<ValueType>::DoRealFFT(emitters::IRFunctionEmitter& function, size_t length, emitters::LLVMValue input, emitters::LLVMValue scratch, emitters::LLVMValue complexInput)
-    {
-        const bool inlineFFT = length <= MAX_INLINE_FFT_SIZE;
-        if (inlineFFT)
-        {
-            EmitRealFFT(function, length, input, scratch, complexInput);
-        }
-        else
-        {
-            auto& module = function.GetModule();
-            auto fftFunction = GetRealFFTFunction(module, length);
-            function.Call(fftFunction, { input, scratch, complexInput });
-        }
-    }
-
     template <typename ValueType>
     void FFTNode<ValueType>::Compute() const
     {
@@ -652,9 +469,16 @@ namespace nodes
         {
             temp.resize(_fftSize);
         }
-        dsp::FFT(temp);
-        temp.resize(output.Size());
-        _output.SetOutput(temp);
+
+        std::vector<std::complex<ValueType>> spectrum(_fftSize / 2 + 1);
+        _plan->RealTransform(temp.data(), spectrum.data());
+
+        std::vector<ValueType> result(output.Size());
+        for (size_t index = 0; index < result.size(); ++index)
+        {
+            result[index] = std::abs(spectrum[index]);
+        }
+        _output.SetOutput(result);
     };
 
     template <typename ValueType>
@@ -689,13 +513,6 @@ namespace nodes
             inputSize = _fftSize;
         }
 
-#if (USE_REAL_FFT)
-
-        emitters::LLVMValue scratch = function.Variable(valueType, _fftSize / 2);
-        DoRealFFT(function, _fftSize, pInput, scratch, complexBuffer);
-
-#else // Complex-input FFT
-
         emitters::LLVMValue scratch = function.Variable(complexType, _fftSize / 2);
         emitters::LLVMValue temp = function.Variable(complexType, "temp");
 
@@ -717,8 +534,6 @@ namespace nodes
 
         DoFFT(function, _fftSize, complexBuffer, scratch);
 
-#endif // USE_REAL_FFT
-
         function.For(outputSize, [pOutput, complexBuffer](emitters::IRFunctionEmitter& function, auto index) {
             auto complexValue = function.LocalScalar(function.ValueAt(complexBuffer, index));
             auto absValue = detail::ComplexAbs(complexValue);
@@ -741,6 +556,7 @@ namespace nodes
         archiver[defaultInputPortName] >> _input;
         archiver["fftSize"] >> _fftSize;
         _output.SetSize(_fftSize / 2 + 1);
+        _plan = dsp::GetFFTPlan<ValueType>(_fftSize);
     }
 
     // Explicit instantiations
@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FlatForestPredictorNode.cpp (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "FlatForestPredictorNode.h"
+
+#include <utilities/include/Exception.h>
+
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace nodes
+{
+    using namespace std::string_literals;
+
+    FlatForestPredictorNode::FlatForestPredictorNode() :
+        CompilableNode({ &_input }, { &_output, &_treeOutputs, &_edgeIndicatorVector }),
+        _input(this, {}, defaultInputPortName),
+        _output(this, defaultOutputPortName, 1),
+        _treeOutputs(this, treeOutputsPortName, 0),
+        _edgeIndicatorVector(this, edgeIndicatorVectorPortName, 0)
+    {
+    }
+
+    FlatForestPredictorNode::FlatForestPredictorNode(const model::OutputPort<double>& input, const predictors::FlatForestPredictor& forest) :
+        CompilableNode({ &_input }, { &_output, &_treeOutputs, &_edgeIndicatorVector }),
+        _input(this, input, defaultInputPortName),
+        _output(this, defaultOutputPortName, 1),
+        _treeOutputs(this, treeOutputsPortName, forest.NumTrees()),
+        _edgeIndicatorVector(this, edgeIndicatorVectorPortName, forest.NumEdges()),
+        _forest(forest)
+    {
+        if (_input.Size() < _forest.NumFeatures())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "FlatForestPredictorNode input is smaller than the number of features used by the forest");
+        }
+    }
+
+    void FlatForestPredictorNode::Compute() const
+    {
+        auto input = _input.GetValue();
+
+        std::vector<double> treeOutputs(_forest.NumTrees());
+        double output = _forest.GetBias();
+        for (size_t treeIndex = 0; treeIndex < treeOutputs.size(); ++treeIndex)
+        {
+            treeOutputs[treeIndex] = _forest.PredictTree(input.data(), treeIndex);
+            output += treeOutputs[treeIndex];
+        }
+
+        _output.SetOutput({ output });
+        _treeOutputs.SetOutput(std::move(treeOutputs));
+        _edgeIndicatorVector.SetOutput(_forest.GetEdgeIndicatorVector(input.data()));
+    }
+
+    void FlatForestPredictorNode::Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
+    {
+        auto& module = function.GetModule();
+        auto pInput = compiler.EnsurePortEmitted(input);
+        auto pOutput = compiler.EnsurePortEmitted(output);
+        auto pTreeOutputs = compiler.EnsurePortEmitted(treeOutputs);
+        auto pEdgeIndicator = compiler.EnsurePortEmitted(edgeIndicatorVector);
+
+        auto numTrees = static_cast<int>(_forest.NumTrees());
+        if (numTrees == 0)
+        {
+            function.Store(pOutput, function.Literal(_forest.GetBias()));
+            return;
+        }
+
+        // the forest, as constant arrays
+        auto featureIndices = module.ConstantArray("forestFeatures_"s + GetInternalStateIdentifier(), _forest.GetFeatureIndices());
+        auto thresholds = module.ConstantArray("forestThresholds_"s + GetInternalStateIdentifier(), _forest.GetThresholds());
+        auto childIndices = module.ConstantArray("forestChildren_"s + GetInternalStateIdentifier(), _forest.GetChildIndices());
+        auto nodeValues = module.ConstantArray("forestValues_"s + GetInternalStateIdentifier(), _forest.GetNodeValues());
+        auto firstEdgeIndices = module.ConstantArray("forestEdges_"s + GetInternalStateIdentifier(), _forest.GetFirstEdgeIndices());
+        auto rootIndices = module.ConstantArray("forestRoots_"s + GetInternalStateIdentifier(), _forest.GetRootIndices());
+        auto treeDepths = module.ConstantArray("forestDepths_"s + GetInternalStateIdentifier(), _forest.GetTreeDepths());
+
+        function.StoreZero(pEdgeIndicator, static_cast<int>(_forest.NumEdges()));
+        auto sum = function.Variable(emitters::VariableType::Double, "forestSum");
+        auto nodeIndex = function.Variable(emitters::VariableType::Int32, "forestNode");
+        function.Store(sum, function.Literal(_forest.GetBias()));
+
+        function.For(numTrees, [=](emitters::IRFunctionEmitter& function, auto treeIndex) {
+            function.Store(nodeIndex, function.ValueAt(rootIndices, treeIndex));
+            auto depth = function.LocalScalar(function.ValueAt(treeDepths, treeIndex));
+
+            // every tree takes exactly `depth` steps: leaves compare against +infinity and point to themselves
+            function.For(depth, [=](emitters::IRFunctionEmitter& function, auto) {
+                auto node = function.LocalScalar(function.Load(nodeIndex));
+                auto feature = function.LocalScalar(function.ValueAt(featureIndices, node));
+                auto value = function.LocalScalar(function.ValueAt(pInput, feature));
+                auto threshold = function.LocalScalar(function.ValueAt(thresholds, node));
+                auto childPosition = function.LocalScalar(function.CastUnsignedValue<int>(value > threshold));
+
+                auto firstEdge = function.LocalScalar(function.ValueAt(firstEdgeIndices, node));
+                function.If(emitters::TypedComparison::greaterThanOrEquals, firstEdge, function.Literal<int>(0), [=](emitters::IRFunctionEmitter& function) {
+                    function.SetValueAt(pEdgeIndicator, firstEdge + childPosition, function.Literal(true));
+                });
+
+                function.Store(nodeIndex, function.ValueAt(childIndices, 2 * node + childPosition));
+            });
+
+            auto treeOutput = function.LocalScalar(function.ValueAt(nodeValues, function.Load(nodeIndex)));
+            function.SetValueAt(pTreeOutputs, treeIndex, treeOutput);
+            function.Store(sum, function.LocalScalar(function.Load(sum)) + treeOutput);
+        });
+
+        function.Store(pOutput, function.Load(sum));
+    }
+
+    void FlatForestPredictorNode::Copy(model::ModelTransformer& transformer) const
+    {
+        const auto& newInputs = transformer.GetCorrespondingInputs(_input);
+        auto newNode = transformer.AddNode<FlatForestPredictorNode>(newInputs, _forest);
+        transformer.MapNodeOutput(output, newNode->output);
+        transformer.MapNodeOutput(treeOutputs, newNode->treeOutputs);
+        transformer.MapNodeOutput(edgeIndicatorVector, newNode->edgeIndicatorVector);
+    }
+
+    void FlatForestPredictorNode::WriteToArchive(utilities::Archiver& archiver) const
+    {
+        Node::WriteToArchive(archiver);
+        archiver[defaultInputPortName] << _input;
+        archiver["forest"] << _forest;
+    }
+
+    void FlatForestPredictorNode::ReadFromArchive(utilities::Unarchiver& archiver)
+    {
+        Node::ReadFromArchive(archiver);
+        archiver[defaultInputPortName] >> _input;
+        archiver["forest"] >> _forest;
+
+        _treeOutputs.SetSize(_forest.NumTrees());
+        _edgeIndicatorVector.SetSize(_forest.NumEdges());
+    }
+} // namespace nodes
+} // namespace ell
@@ -201,16 +201,8 @@ namespace nodes
         ht = ot * tanh(ct)
         */
         const int hiddenUnits = static_cast<int>(this->_hiddenUnits);
-        const int inputSize = static_cast<int>(this->input.Size());
         size_t stackHeight = 4; // LSTM has 4 stacked weights for (input, forget, cell, output).
 
-        // Get LLVM references for all node inputs
-        auto input = compiler.EnsurePortEmitted(this->input);
-        auto inputWeights = compiler.EnsurePortEmitted(this->inputWeights);
-        auto hiddenWeights = compiler.EnsurePortEmitted(this->hiddenWeights);
-        auto inputBias = compiler.EnsurePortEmitted(this->inputBias);
-        auto hiddenBias = compiler.EnsurePortEmitted(this->hiddenBias);
-
         // Get LLVM reference for node output
         auto output = function.LocalArray(compiler.EnsurePortEmitted(this->output));
         auto outputCellState = function.LocalArray(compiler.EnsurePortEmitted(this->outputCellState));
@@ -221,95 +213,43 @@ namespace nodes
         auto hiddenStateValue = module.EnsureEmitted(*hiddenStateVariable);
         auto hiddenStatePointer = function.PointerOffset(hiddenStateValue, 0); // convert "global variable" to a pointer
         auto hiddenState = function.LocalArray(hiddenStatePointer);
-        auto& prevHiddenState = hiddenState;
 
         // Allocate global buffer for cell state
         auto cellStateVariable = module.Variables().AddVectorVariable<ValueType>(emitters::VariableScope::global, hiddenUnits);
         auto cellStateValue = module.EnsureEmitted(*cellStateVariable);
         auto cellStatePointer = function.PointerOffset(cellStateValue, 0); // convert "global variable" to a pointer
         auto cellState = function.LocalArray(cellStatePointer);
-        auto& prevCellState = cellState;
 
-        // Allocate local variables
+        // W_i * x + b_i + W_h * h + b_h, one matrix multiplication for all 4 gates (input, forget, cell, output)
         const size_t stackSize = hiddenUnits * stackHeight;
-        auto istack = function.LocalArray(function.Variable(emitters::GetVariableType<ValueType>(), stackSize));
-        auto hstack = function.LocalArray(function.Variable(emitters::GetVariableType<ValueType>(), stackSize));
-        auto inputGate = function.LocalArray(function.Variable(emitters::GetVariableType<ValueType>(), hiddenUnits));
-        auto forgetGate = function.LocalArray(function.Variable(emitters::GetVariableType<ValueType>(), hiddenUnits));
-        auto cellGate = function.LocalArray(function.Variable(emitters::GetVariableType<ValueType>(), hiddenUnits));
-        auto outputGate = function.LocalArray(function.Variable(emitters::GetVariableType<ValueType>(), hiddenUnits));
-
-        auto alpha = static_cast<ValueType>(1.0); // GEMV scaling of the matrix multipication
-        auto beta = static_cast<ValueType>(1.0); // GEMV scaling of the bias addition
-
-        // W_i * x + b_i, one matrix multiplication for all 4 gates (input, forget, cell, output)
-        function.MemoryCopy<ValueType>(inputBias, istack, stackSize); // Copy bias values into output so GEMM call accumulates them
-        function.CallGEMV(stackSize, inputSize, alpha, inputWeights, inputSize, input, 1, beta, istack, 1);
-
-        // W_h * h + b_h
-        function.MemoryCopy<ValueType>(hiddenBias, hstack, stackSize); // Copy bias values into output so GEMM call accumulates them
-        function.CallGEMV(stackSize, hiddenUnits, alpha, hiddenWeights, hiddenUnits, prevHiddenState, 1, beta, hstack, 1);
-
-        // the weights are stacked in 4 slices for (input, forget, cell, output).
-        auto istack_slice0 = istack;
-        auto istack_slice1 = function.LocalArray(function.PointerOffset(istack, function.LocalScalar(hiddenUnits)));
-        auto istack_slice2 = function.LocalArray(function.PointerOffset(istack, function.LocalScalar(hiddenUnits * 2)));
-        auto istack_slice3 = function.LocalArray(function.PointerOffset(istack, function.LocalScalar(hiddenUnits * 3)));
-
-        auto hstack_slice0 = hstack;
-        auto hstack_slice1 = function.LocalArray(function.PointerOffset(hstack, function.LocalScalar(hiddenUnits)));
-        auto hstack_slice2 = function.LocalArray(function.PointerOffset(hstack, function.LocalScalar(hiddenUnits * 2)));
-        auto hstack_slice3 = function.LocalArray(function.PointerOffset(hstack, function.LocalScalar(hiddenUnits * 3)));
-
-        // input_gate = sigma(W_{ iz } x + b_{ iz } + W_{ hz } h + b_{ hz })
-        function.For(hiddenUnits, [=](emitters::IRFunctionEmitter& fn, emitters::IRLocalScalar i) {
-            inputGate[i] = istack_slice0[i] + hstack_slice0[i];
-        });
-        this->ApplyActivation(function, this->_recurrentActivation, inputGate, hiddenUnits);
-
-        // forget_gate = sigma(W_{if} x + b_{if} + W_{hf} h + b_{hf})
-        function.For(hiddenUnits, [=](emitters::IRFunctionEmitter& fn, emitters::IRLocalScalar i) {
-            forgetGate[i] = istack_slice1[i] + hstack_slice1[i];
-        });
-        this->ApplyActivation(function, this->_recurrentActivation, forgetGate, hiddenUnits);
-
-        // cell_gate = tanh(W_{ig} x + b_{ig} + W_{hg} h + b_{hg})
-        function.For(hiddenUnits, [=](emitters::IRFunctionEmitter& fn, emitters::IRLocalScalar i) {
-            cellGate[i] = istack_slice2[i] + hstack_slice2[i];
+        auto gates = function.LocalArray(function.Variable(emitters::GetVariableType<ValueType>(), stackSize));
+        this->EmitGatePreactivations(compiler, function, stackHeight, hiddenState, gates);
+
+        // Apply the gate nonlinearities and update the cell and hidden state in a single pass over the hidden units,
+        // instead of one loop and one temporary buffer per gate.
+        auto recurrentActivation = GetNodeActivationFunction(this->_recurrentActivation);
+        auto activation = GetNodeActivationFunction(this->_activation);
+        function.For(hiddenUnits, [=, &recurrentActivation, &activation](emitters::IRFunctionEmitter& fn, emitters::IRLocalScalar i) {
+            emitters::IRLocalScalar inputPreactivation = gates[i];
+            emitters::IRLocalScalar forgetPreactivation = gates[i + hiddenUnits];
+            emitters::IRLocalScalar cellPreactivation = gates[i + 2 * hiddenUnits];
+            emitters::IRLocalScalar outputPreactivation = gates[i + 3 * hiddenUnits];
+            auto it = fn.LocalScalar(recurrentActivation->Compile(fn, inputPreactivation));
+            auto ft = fn.LocalScalar(recurrentActivation->Compile(fn, forgetPreactivation));
+            auto gt = fn.LocalScalar(activation->Compile(fn, cellPreactivation));
+            auto ot = fn.LocalScalar(recurrentActivation->Compile(fn, outputPreactivation));
+
+            // ct = ft * c + it * gt
+            emitters::IRLocalScalar prevCellState = cellState[i];
+            auto ct = ft * prevCellState + it * gt;
+            cellState[i] = ct;
+            outputCellState[i] = ct;
+
+            // ht = ot * tanh(ct)
+            auto ht = ot * fn.LocalScalar(activation->Compile(fn, ct));
+            hiddenState[i] = ht;
+            output[i] = ht;
         });
-        this->ApplyActivation(function, this->_activation, cellGate, hiddenUnits);
-
-        // output_gate = sigma(W_{io} x + b_{io} + W_{ho} h + b_{ho})
-        function.For(hiddenUnits, [=](emitters::IRFunctionEmitter& fn, emitters::IRLocalScalar i) {
-            outputGate[i] = istack_slice3[i] + hstack_slice3[i];
-        });
-        this->ApplyActivation(function, this->_recurrentActivation, outputGate, hiddenUnits);
-
-        // cellState = forget_gate * cellState + input_gate * cell_gate
-        function.For(hiddenUnits, [=](emitters::IRFunctionEmitter& fn, emitters::IRLocalScalar i) {
-            auto ft = forgetGate[i];
-            auto ct = prevCellState[i];
-            auto it = inputGate[i];
-            auto gt = cellGate[i];
-            auto newValue = ft * ct + it * gt;
-            cellState[i] = newValue;
-        });
-
-        // newHiddenState = output_gate * tanh(ct), we'll reuse inputGate local variable to compile tanh(ct)
-        function.MemoryCopy<ValueType>(cellState, inputGate, hiddenUnits);
-        this->ApplyActivation(function, this->_activation, inputGate, hiddenUnits);
-
-        function.For(hiddenUnits, [=](emitters::IRFunctionEmitter& fn, emitters::IRLocalScalar i) {
-            auto tan_ct = inputGate[i];
-            auto ot = outputGate[i];
-            auto newValue = ot * tan_ct;
-            hiddenState[i] = newValue;
-        });
-
-        // Copy hidden state to the output.
-        function.MemoryCopy<ValueType>(hiddenState, output, hiddenUnits);
-        // Copy cell state to the output cell state
-        function.MemoryCopy<ValueType>(cellState, outputCellState, hiddenUnits);
 
         // Add the internal reset function
         std::string resetFunctionName = compiler.GetGlobalName(*this, "LSTMNodeReset");
@@ -6,7 +6,9 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <model/include/MapCompiler.h>
 #include <model/include/ModelTransformer.h>
+#include <model/include/TuningCache.h>
 
 #include <nodes/include/MatrixMatrixMultiplyCodeNode.h>
 
@@ -19,6 +21,7 @@
 #include <value/include/MatrixOperations.h>
 #include <value/include/Scalar.h>
 #include <value/include/ScalarOperations.h>
+#include <value/include/Vector.h>
 
 #include <value/include/loopnests/CodeGenerator.h>
 #include <value/include/loopnests/Kernel.h>
@@ -35,6 +38,24 @@ namespace ell
 {
 namespace nodes
 {
+    namespace
+    {
+        int RoundUpToMultiple(int value, int factor)
+        {
+            return ((value + factor - 1) / factor) * factor;
+        }
+
+        // Before automatic tile sizes, the default tile sizes were stored in the archive
+        constexpr utilities::ArchiveVersion automaticTileSizesArchiveVersion = { utilities::ArchiveVersionNumbers::v11_automatic_tile_sizes };
+        const std::vector<int> legacyDefaultTileSizes = { 64, 64, 64, 4, 4, 4 };
+
+        // Tile sizes of 0 mean "choose automatically"; ZeroMatrix still needs something to split by
+        int GetTileSizeOrDefault(int tileSize, int defaultSize)
+        {
+            return tileSize > 0 ? tileSize : defaultSize;
+        }
+    } // namespace
+
     template <typename ValueType>
     MatrixMatrixMultiplyCodeNode<ValueType>::MatrixMatrixMultiplyCodeNode() :
         CompilableCodeNode("MatrixMatrixMultiplyCodeNode", { &_input1, &_input2 }, { &_output }),
@@ -125,7 +146,7 @@ namespace nodes
     }
 
     template <typename ValueType>
-    MatrixMatrixMultiplyCodeNode<ValueType>::MatrixMatrixMultiplyCodeNode(const model::OutputPort<ValueType>& input1, int m, int n, int k, int matrix1Stride, bool transpose1, const model::OutputPort<ValueType>& input2, int matrix2Stride, bool transpose2, int outputMatrixStride, bool transposeOutput, int panelM, int panelN, int panelK, int kernelM, int kernelN, int kernelK, const MatrixMatrixMultiplyImplementation& gemmImpl) :
+    MatrixMatrixMultiplyCodeNode<ValueType>::MatrixMatrixMultiplyCodeNode(const model::OutputPort<ValueType>& input1, int m, int n, int k, int matrix1Stride, bool transpose1, const model::OutputPort<ValueType>& input2, int matrix2Stride, bool transpose2, int outputMatrixStride, bool transposeOutput, int panelM, int panelN, int panelK, int kernelM, int kernelN, int kernelK, const MatrixMatrixMultiplyImplementation& gemmImpl, const OutputEpilogue<ValueType>& epilogue) :
         CompilableCodeNode("MatrixMatrixMultiplyCodeNode", { &_input1, &_input2 }, { &_output }),
         _input1(this, input1, defaultInput1PortName),
         _input2(this, input2, defaultInput2PortName),
@@ -145,7 +166,8 @@ namespace nodes
         _kernelM(kernelM),
         _kernelN(kernelN),
         _kernelK(kernelK),
-        _impl(gemmImpl)
+        _impl(gemmImpl),
+        _epilogue(epilogue)
     {
         if (static_cast<int>(input1.Size()) != m * k)
         {
@@ -156,6 +178,11 @@ namespace nodes
         {
             throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Input matrix 2 size incorrect");
         }
+
+        if (!_epilogue.IsValidForNumChannels(m))
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Epilogue size incorrect");
+        }
     }
 
     template <typename ValueType>
@@ -168,8 +195,8 @@ namespace nodes
         loopnests::LoopNest zeroingLoop({ { m, { 0, M } },
                                           { n, { 0, N } } });
 
-        auto [mKernelOuter, mKernelInner] = zeroingLoop.Split(m, _kernelM);
-        auto [nKernelOuter, nKernelInner] = zeroingLoop.Split(n, _kernelN);
+        auto [mKernelOuter, mKernelInner] = zeroingLoop.Split(m, GetTileSizeOrDefault(_kernelM, 4));
+        auto [nKernelOuter, nKernelInner] = zeroingLoop.Split(n, GetTileSizeOrDefault(_kernelN, 4));
         auto zeroingKernel = loopnests::Kernel("Zero_output")
                                  .Inputs(matrix.GetValue())
                                  .Indices(m, n)
@@ -217,7 +244,7 @@ namespace nodes
     }
 
     template <typename ValueType>
-    void MatrixMatrixMultiplyCodeNode<ValueType>::Gemm(value::Matrix A, value::Matrix B, value::Matrix C)
+    void MatrixMatrixMultiplyCodeNode<ValueType>::Gemm(value::Matrix A, value::Matrix B, value::Matrix C, int firstRow)
     {
         using namespace value;
 
@@ -245,13 +272,24 @@ namespace nodes
             NumRowsInKernel *= 2;
         }
 
+        // Tile sizes given to the node (e.g., from a tuning cache) override the target-derived ones above.
+        // The kernel width is kept a multiple of the vector size, and each block a multiple of its kernel.
+        if (_kernelM > 0)
+        {
+            NumRowsInKernel = _kernelM;
+        }
+        if (_kernelN > 0)
+        {
+            NumColumnsInKernel = RoundUpToMultiple(_kernelN, vectorSize);
+        }
+
         // Declare and/or calculate constants
         const int OutputRows = (int)(A.Rows());
         const int OutputColumns = (int)(B.Columns());
         const int InnerDimension = (int)(A.Columns());
-        const int kUnroll = 4;
-        int columnBlock = std::min(64, OutputColumns);
-        int innerDimensionBlock = std::min(256, InnerDimension);    
+        const int kUnroll = _kernelK > 0 ? _kernelK : 4;
+        int columnBlock = std::min(_panelN > 0 ? RoundUpToMultiple(_panelN, NumColumnsInKernel) : 64, OutputColumns);
+        int innerDimensionBlock = std::min(_panelK > 0 ? RoundUpToMultiple(_panelK, kUnroll) : 256, InnerDimension);
 
         // Declare indexes
         loopnests::Index i("i"), j("j"), k("k");
@@ -291,7 +329,9 @@ namespace nodes
                                     std::nullopt, // Order isn't used by BLASTCopy
                                     extraCacheBParams);
         }
-        auto extraZeroInputReduceOutputParams = std::make_tuple(vectorSize);
+        // The output block is final after its last K panel, so the epilogue is applied as the block is stored then
+        const int lastPanelK = ((InnerDimension - 1) / innerDimensionBlock) * innerDimensionBlock;
+        auto extraZeroInputReduceOutputParams = std::make_tuple(vectorSize, kCache, lastPanelK, GetEpilogueStoreFunction(firstRow));
         schedule.template Cache<ZeroInputReduceOutput>(C,
                                             { iKernelOuter, jKernelOuter2 },
                                             { NumRowsInKernel, NumColumnsInKernel },
@@ -299,22 +339,23 @@ namespace nodes
                                             utilities::RowMajorMatrixOrder,
                                             extraZeroInputReduceOutputParams);
 
-        // Set unrolling
+        // Set unrolling, and emit the innermost columns as explicit vector operations
         schedule.Unroll(jKernelOuter);
         schedule.Unroll(i);
         schedule.Unroll(k);
+        schedule.Vectorize(j, vectorSize * static_cast<int>(sizeof(float)));
 
         // Run the generator
         nest.Run();
     }
 
     template <typename ValueType>
-    void MatrixMatrixMultiplyCodeNode<ValueType>::GemmFn(value::Matrix A, value::Matrix B, value::Matrix C, int thread_num)
+    void MatrixMatrixMultiplyCodeNode<ValueType>::GemmFn(value::Matrix A, value::Matrix B, value::Matrix C, int firstRow, int thread_num)
     {
         value::DeclareFunction("InnerMatMul" + std::to_string(thread_num))
             .Parameters(A, B, C)
-            .Define([this](value::Matrix A, value::Matrix B, value::Matrix C) {
-                Gemm(A, B, C);
+            .Define([this, firstRow](value::Matrix A, value::Matrix B, value::Matrix C) {
+                Gemm(A, B, C, firstRow);
             })(A, B, C);
     }
 
@@ -338,6 +379,7 @@ namespace nodes
                             A,
                             B.SubMatrix(value::Scalar{0}, colStart, (int)B.Rows(), columns),
                             C.SubMatrix(value::Scalar{0}, colStart, (int)C.Rows(), columns),
+                            0,
                             thread_seq);
                 });
                 
@@ -348,11 +390,11 @@ namespace nodes
                     IfCxt.ElseIf(id == i,
                     [&] {
                             int actualColumns = i==(numThreads-1) ? columns + col_spill : columns;
-                            
                             GemmFn(
                                 A,
                                 B.SubMatrix(value::Scalar{0}, colStart, (int)B.Rows(), actualColumns),
                                 C.SubMatrix(value::Scalar{0}, colStart, (int)C.Rows(), actualColumns),
+                                0,
                                 i);
                     });
                 }
@@ -379,6 +421,7 @@ namespace nodes
                             A.SubMatrix(rowStart, value::Scalar{0}, rows, (int)A.Columns()),
                             B,
                             C.SubMatrix(rowStart, value::Scalar{0}, rows, (int)C.Columns()),
+                            0,
                             thread_seq);
                 });
                 
@@ -393,6 +436,7 @@ namespace nodes
                                 A.SubMatrix(rowStart, value::Scalar{0}, actualRows, (int)A.Columns()),
                                 B,
                                 C.SubMatrix(rowStart, value::Scalar{0}, actualRows, (int)C.Columns()),
+                                i * rows,
                                 i);
                     });
                 }
@@ -425,7 +469,57 @@ namespace nodes
         }
         else
         {
-            Gemm(matA, matB, matC);
+            Gemm(matA, matB, matC, 0);
+        }
+    }
+
+    template <typename ValueType>
+    value::ReduceOutputStoreFunction MatrixMatrixMultiplyCodeNode<ValueType>::GetEpilogueStoreFunction(int firstRow) const
+    {
+        if (_epilogue.IsEmpty())
+        {
+            return {};
+        }
+
+        // The rows of the output are the epilogue's channels. The output may be a block of rows starting at `firstRow`.
+        return [this, firstRow](value::Matrix C, value::Scalar row, value::Scalar column, value::Scalar sum) {
+            auto scale = value::Vector(_epilogue.GetScale(_m));
+            auto bias = value::Vector(_epilogue.GetBias(_m));
+            value::Scalar channel = row + firstRow;
+            C(row, column) = _epilogue.Apply(sum, scale(channel), bias(channel));
+        };
+    }
+
+    template <typename ValueType>
+    void MatrixMatrixMultiplyCodeNode<ValueType>::ApplyEpilogue(value::Matrix matC, value::Scalar firstRow) const
+    {
+        if (_epilogue.IsEmpty())
+        {
+            return;
+        }
+
+        // The rows of the output are the epilogue's channels. `matC` may be a block of rows starting at `firstRow`.
+        auto scale = value::Vector(_epilogue.GetScale(_m));
+        auto bias = value::Vector(_epilogue.GetBias(_m));
+        auto applyToElement = [&](value::Scalar row, value::Scalar column) {
+            value::Scalar channel = firstRow + row;
+            matC(row, column) = _epilogue.Apply(matC(row, column), scale(channel), bias(channel));
+        };
+
+        // Visit the block in memory order, while it's still in cache
+        const int rows = static_cast<int>(matC.Rows());
+        const int columns = static_cast<int>(matC.Columns());
+        if (_transposeOutput)
+        {
+            ForRange(columns, [&](value::Scalar column) {
+                ForRange(rows, [&](value::Scalar row) { applyToElement(row, column); });
+            });
+        }
+        else
+        {
+            ForRange(rows, [&](value::Scalar row) {
+                ForRange(columns, [&](value::Scalar column) { applyToElement(row, column); });
+            });
         }
     }
 
@@ -455,6 +549,7 @@ namespace nodes
             {
             case (MatrixMatrixMultiplyImplementation::SimpleForLoops):
                 ForLoopGEMM(matA, matB, matC);
+                ApplyEpilogue(matC, value::Scalar{0});
                 break;
             case (MatrixMatrixMultiplyImplementation::Mlas_Loopnest_Value):
                 ELLCodeGEMM(matA, matB, matC);
@@ -471,21 +566,48 @@ namespace nodes
     {
         const auto& newInput1 = transformer.GetCorrespondingInputs(_input1);
         const auto& newInput2 = transformer.GetCorrespondingInputs(_input2);
-        auto newNode = transformer.AddNode<MatrixMatrixMultiplyCodeNode<ValueType>>(newInput1, _m, _n, _k, _lda, _transpose1, newInput2, _ldb, _transpose2, _ldc, _transposeOutput, _panelM, _panelN, _panelK, _kernelM, _kernelN, _kernelK, _impl);
+
+        // If the tile sizes were left for the compiler to choose, use tuned ones if the compiler has them
+        std::vector<int> tileSizes = { _panelM, _panelN, _panelK, _kernelM, _kernelN, _kernelK };
+        if (HasAutomaticTileSizes())
+        {
+            if (auto compiler = transformer.GetContext().GetCompiler())
+            {
+                std::vector<int> tunedTileSizes;
+                auto key = GetTuningKey(compiler->GetMapCompilerOptions().compilerSettings.targetDevice);
+                if (compiler->GetTuningCache().TryGetParameters(key, tunedTileSizes) && tunedTileSizes.size() == tileSizes.size())
+                {
+                    tileSizes = tunedTileSizes;
+                }
+            }
+        }
+
+        auto newNode = transformer.AddNode<MatrixMatrixMultiplyCodeNode<ValueType>>(newInput1, _m, _n, _k, _lda, _transpose1, newInput2, _ldb, _transpose2, _ldc, _transposeOutput, tileSizes[0], tileSizes[1], tileSizes[2], tileSizes[3], tileSizes[4], tileSizes[5], _impl, _epilogue);
         transformer.MapNodeOutput(output, newNode->output);
     }
 
+    template <typename ValueType>
+    bool MatrixMatrixMultiplyCodeNode<ValueType>::HasAutomaticTileSizes() const
+    {
+        return _panelM == 0 && _panelN == 0 && _panelK == 0 && _kernelM == 0 && _kernelN == 0 && _kernelK == 0;
+    }
+
+    template <typename ValueType>
+    std::string MatrixMatrixMultiplyCodeNode<ValueType>::GetTuningKey(const emitters::TargetDevice& target) const
+    {
+        return model::TuningCache::GetKey(GetTypeName(), { _m, _n, _k, _lda, _ldb, _ldc, _transpose1, _transpose2, _transposeOutput }, target);
+    }
+
     template <typename ValueType>
     utilities::ArchiveVersion MatrixMatrixMultiplyCodeNode<ValueType>::GetArchiveVersion() const
     {
-        constexpr utilities::ArchiveVersion currentArchiveVersion = { utilities::ArchiveVersionNumbers::v2 };
-        return std::max(currentArchiveVersion, CompilableCodeNode::GetArchiveVersion());
+        return std::max(automaticTileSizesArchiveVersion, CompilableCodeNode::GetArchiveVersion());
     }
 
     template <typename ValueType>
     bool MatrixMatrixMultiplyCodeNode<ValueType>::CanReadArchiveVersion(const utilities::ArchiveVersion& version) const
     {
-        return CompilableCodeNode::CanReadArchiveVersion(version);
+        return version <= automaticTileSizesArchiveVersion;
     }
 
     template <typename ValueType>
@@ -511,6 +633,7 @@ namespace nodes
         archiver["kernelN"] << _kernelN;
         archiver["kernelK"] << _kernelK;
         archiver["gemmImpl"] << static_cast<int>(_impl);
+        _epilogue.WriteToArchive(archiver);
     }
 
     template <typename ValueType>
@@ -535,9 +658,15 @@ namespace nodes
         archiver["kernelM"] >> _kernelM;
         archiver["kernelN"] >> _kernelN;
         archiver["kernelK"] >> _kernelK;
+        if (archiver.GetCurrentObjectInfo().version < automaticTileSizesArchiveVersion && GetTileSizes() == legacyDefaultTileSizes)
+        {
+            // Older archives stored the then-default tile sizes explicitly. Let the compiler choose them instead.
+            _panelM = _panelN = _panelK = _kernelM = _kernelN = _kernelK = 0;
+        }
         int gemmImpl = 0;
         archiver["gemmImpl"] >> gemmImpl;
         _impl = static_cast<MatrixMatrixMultiplyImplementation>(gemmImpl);
+        _epilogue.ReadFromArchive(archiver);
     }
 
     //
@@ -7,6 +7,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "MatrixVectorMultiplyNode.h"
+#include "MatrixMatrixMultiplyNode.h"
 
 #include <math/include/Matrix.h>
 #include <math/include/MatrixOperations.h>
@@ -77,6 +78,25 @@ namespace nodes
         transformer.MapNodeOutput(output, newNode->output);
     }
 
+    template <typename ValueType>
+    bool MatrixVectorMultiplyNode<ValueType>::Batch(model::BatchTransformer& transformer) const
+    {
+        // If every sample uses the same matrix (e.g., the weights of a fully-connected layer), the whole batch is
+        // one matrix-matrix product, which reads the matrix once instead of once per sample:
+        // output (batchSize x m) = vectors (batchSize x n) * matrix' (n x m)
+        if (!transformer.IsBatchInvariant(_inputMatrix) || _incx != 1)
+        {
+            return false;
+        }
+
+        const auto& matrix = transformer.GetCorrespondingInputs(_inputMatrix);
+        const auto& vectors = transformer.GetBatchedInputs(_inputVector);
+        auto batchSize = transformer.GetBatchSize();
+        auto newNode = transformer.AddNode<MatrixMatrixMultiplyNode<ValueType>>(vectors, batchSize, (int)_m, (int)_n, (int)_n, false, matrix, (int)_lda, true, (int)_m);
+        transformer.MapBatchedNodeOutput(output, newNode->output);
+        return true;
+    }
+
     template <typename ValueType>
     void MatrixVectorMultiplyNode<ValueType>::Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
     {
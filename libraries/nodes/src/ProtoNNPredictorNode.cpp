@@ -13,7 +13,6 @@
 #include "ExtremalValueNode.h"
 #include "L2NormSquaredNode.h"
 #include "MatrixVectorProductNode.h"
-#include "SquaredEuclideanDistanceNode.h"
 #include "UnaryOperationNode.h"
 
 #include <utilities/include/Exception.h>
@@ -75,25 +74,45 @@ namespace nodes
         const auto& newInputs = transformer.GetCorrespondingInputs(_input);
 
         // Projection
-        auto projectionMatrix = _predictor.GetProjectionMatrix();
-        const auto& projectedInput = MatrixVectorProduct(newInputs, projectionMatrix);
-
-        auto prototypes = _predictor.GetPrototypes();
-        auto m = _predictor.GetNumPrototypes();
-
-        std::vector<double> multiplier(m, _predictor.GetGamma() * _predictor.GetGamma() * -1);
-        const auto& gamma = Constant(transformer, multiplier);
+        const auto& projectedInput = MatrixVectorProduct(newInputs, _predictor.GetProjectionMatrix());
+
+        // The similarity to prototype p is exp(-gamma^2 * ||x - p||^2), for the projected input x. Expanding the
+        // distance as ||x||^2 + ||p||^2 - 2 * x.p and folding the constant factors into the prototypes gives
+        // exp(2 * gamma^2 * x.p - gamma^2 * ||p||^2 - gamma^2 * ||x||^2), which takes one matrix-vector product for all
+        // the prototypes, and no elementwise scaling.
+        const auto& prototypes = _predictor.GetPrototypes();
+        auto numPrototypes = _predictor.GetNumPrototypes();
+        auto gammaSquared = _predictor.GetGamma() * _predictor.GetGamma();
+
+        math::RowMatrix<double> scaledPrototypes(prototypes.Transpose());
+        scaledPrototypes.Transform([gammaSquared](double value) { return 2.0 * gammaSquared * value; });
+        const auto& dotProducts = MatrixVectorProduct(projectedInput, scaledPrototypes);
+
+        std::vector<double> prototypeNorms(numPrototypes);
+        for (size_t index = 0; index < numPrototypes; ++index)
+        {
+            prototypeNorms[index] = -gammaSquared * prototypes.GetColumn(index).Norm2Squared();
+        }
+        const auto& prototypeNormsConstant = Constant(transformer, prototypeNorms);
 
-        // Distance to each prototype
-        math::RowMatrixReference<double> prototypesMatrix = prototypes.Transpose();
-        auto squareDistanceNode = transformer.AddNode<SquaredEuclideanDistanceNode<double, math::MatrixLayout::rowMajor>>(projectedInput, prototypesMatrix);
+        auto inputNormNode = transformer.AddNode<L2NormSquaredNode<double>>(projectedInput);
+        const auto& scaledInputNorm = Multiply(inputNormNode->output, Constant(transformer, -gammaSquared));
+        model::PortElements<double> inputNorms;
+        for (size_t index = 0; index < numPrototypes; ++index)
+        {
+            inputNorms.Append(scaledInputNorm);
+        }
 
         // Similarity to each prototype
-        const auto& scaledDistance = Multiply(squareDistanceNode->output, gamma);
-        const auto& expDistance = Exp(scaledDistance);
+        const auto& exponent = Add(Add(dotProducts, prototypeNormsConstant), transformer.SimplifyOutputs(inputNorms));
+
+        // The exponent is -gamma^2 * ||x - p||^2 <= 0, but cancellation in the expanded form can leave it slightly
+        // positive when a prototype lies on the projected input, so clamp it at zero
+        const auto& clampedExponent = Minimum(exponent, Constant(transformer, std::vector<double>(numPrototypes, 0.0)));
+        const auto& similarity = Exp(clampedExponent);
 
         // Get the prediction label
-        const auto& labelScores = MatrixVectorProduct(expDistance, _predictor.GetLabelEmbeddings());
+        const auto& labelScores = MatrixVectorProduct(similarity, _predictor.GetLabelEmbeddings());
 
         transformer.MapNodeOutput(output, labelScores);
 
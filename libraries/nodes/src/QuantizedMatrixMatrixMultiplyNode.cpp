@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     QuantizedMatrixMatrixMultiplyNode.cpp (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "QuantizedMatrixMatrixMultiplyNode.h"
+
+#include <model/include/ModelTransformer.h>
+
+#include <utilities/include/Exception.h>
+#include <utilities/include/MemoryLayout.h>
+
+#include <value/include/EmitterContext.h>
+#include <value/include/Matrix.h>
+#include <value/include/Scalar.h>
+#include <value/include/ScalarOperations.h>
+#include <value/include/Vector.h>
+
+#include <cstring>
+
+namespace ell
+{
+namespace nodes
+{
+    namespace
+    {
+        // Weights are archived four to an int, to keep archives close to the in-memory size
+        std::vector<int> PackWeights(const std::vector<int8_t>& weights)
+        {
+            std::vector<int> packed((weights.size() + sizeof(int) - 1) / sizeof(int), 0);
+            std::memcpy(packed.data(), weights.data(), weights.size());
+            return packed;
+        }
+
+        std::vector<int8_t> UnpackWeights(const std::vector<int>& packed, size_t size)
+        {
+            if (packed.size() * sizeof(int) < size)
+            {
+                throw utilities::InputException(utilities::InputExceptionErrors::badData, "Not enough quantized weights in archive");
+            }
+            std::vector<int8_t> weights(size);
+            std::memcpy(weights.data(), packed.data(), size);
+            return weights;
+        }
+    } // namespace
+
+    template <typename ValueType>
+    QuantizedMatrixMatrixMultiplyNode<ValueType>::QuantizedMatrixMatrixMultiplyNode() :
+        CompilableCodeNode("QuantizedMatrixMatrixMultiplyNode", { &_input }, { &_output }),
+        _input(this, {}, defaultInputPortName),
+        _output(this, defaultOutputPortName, 0)
+    {
+    }
+
+    template <typename ValueType>
+    QuantizedMatrixMatrixMultiplyNode<ValueType>::QuantizedMatrixMatrixMultiplyNode(const model::OutputPort<ValueType>& input, int m, int n, int k, const std::vector<int8_t>& weights, const std::vector<ValueType>& weightScales, ValueType inputScale, bool transposeOutput, const model::PortMemoryLayout& outputMemoryLayout) :
+        CompilableCodeNode("QuantizedMatrixMatrixMultiplyNode", { &_input }, { &_output }),
+        _input(this, input, defaultInputPortName),
+        _output(this, defaultOutputPortName, outputMemoryLayout),
+        _m(m),
+        _n(n),
+        _k(k),
+        _transposeOutput(transposeOutput),
+        _weights(weights),
+        _weightScales(weightScales),
+        _inputScale(inputScale)
+    {
+        if (static_cast<int>(input.Size()) != k * n)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Input matrix size incorrect");
+        }
+
+        if (static_cast<int>(_weights.size()) != m * k || static_cast<int>(_weightScales.size()) != m)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Quantized weights size incorrect");
+        }
+
+        if (static_cast<int>(outputMemoryLayout.NumElements()) != m * n)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Output memory layout size incorrect");
+        }
+
+        if (inputScale <= 0)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Input scale must be positive");
+        }
+    }
+
+    template <typename ValueType>
+    void QuantizedMatrixMatrixMultiplyNode<ValueType>::Define(value::FunctionDeclaration& fn)
+    {
+        (void)fn.Define([this](const value::Value inputValue, value::Value outputValue) {
+            using namespace value;
+
+            auto tempInput = inputValue;
+            tempInput.SetLayout(utilities::MemoryLayout({ _k, _n }));
+            auto tempOutput = outputValue;
+            if (_transposeOutput)
+            {
+                tempOutput.SetLayout(utilities::MemoryLayout({ _n, _m }, utilities::DimensionOrder{ 1, 0 }));
+            }
+            else
+            {
+                tempOutput.SetLayout(utilities::MemoryLayout({ _m, _n }));
+            }
+            auto input = Matrix(tempInput);
+            auto output = Matrix(tempOutput);
+
+            // The weights are stored as 8-bit constants. Each output element is dequantized with the
+            // product of its row's weight scale and the input scale.
+            std::vector<char> weightData(_weights.begin(), _weights.end());
+            std::vector<ValueType> outputScaleData(_weightScales);
+            for (auto& scale : outputScaleData)
+            {
+                scale *= _inputScale;
+            }
+            const auto nodeId = GetInternalStateIdentifier();
+            auto weights = Matrix(StaticAllocate("quantizedWeights_" + nodeId, weightData, utilities::MemoryLayout({ _m, _k })));
+            auto outputScales = Vector(StaticAllocate("outputScales_" + nodeId, outputScaleData, utilities::MemoryLayout({ _m })));
+
+            // Quantize the input into an n x k buffer, so that each dot product below reads
+            // contiguous 8-bit values from both operands and can be vectorized. The buffer is too
+            // big for the stack in general, so each thread gets its own static copy instead.
+            auto quantizedInput = Matrix(StaticAllocate("quantizedInput_" + nodeId, value::ValueType::Char8, utilities::MemoryLayout({ _n, _k }), AllocateFlags::ThreadLocal));
+            const auto inverseInputScale = static_cast<ValueType>(1) / _inputScale;
+            const auto maxQuantizedValue = static_cast<ValueType>(127);
+            ForRange(_k, [&](Scalar kIndex) {
+                ForRange(_n, [&](Scalar nIndex) {
+                    Scalar scaled = Round(input(kIndex, nIndex) * inverseInputScale);
+                    Scalar clamped = Max(Min(scaled, Scalar(maxQuantizedValue)), Scalar(-maxQuantizedValue));
+                    quantizedInput(nIndex, kIndex) = Cast<char>(clamped);
+                });
+            });
+
+            // 8-bit products, 32-bit accumulation
+            ForRange(_n, [&](Scalar nIndex) {
+                ForRange(_m, [&](Scalar mIndex) {
+                    Scalar accumulator = MakeScalar<int>();
+                    accumulator = 0;
+                    ForRange(_k, [&](Scalar kIndex) {
+                        accumulator += Cast<int>(weights(mIndex, kIndex)) * Cast<int>(quantizedInput(nIndex, kIndex));
+                    });
+                    output(mIndex, nIndex) = Cast<ValueType>(accumulator) * outputScales[mIndex];
+                });
+            });
+        });
+    }
+
+    template <typename ValueType>
+    void QuantizedMatrixMatrixMultiplyNode<ValueType>::Copy(model::ModelTransformer& transformer) const
+    {
+        const auto& newInput = transformer.GetCorrespondingInputs(_input);
+        auto newNode = transformer.AddNode<QuantizedMatrixMatrixMultiplyNode<ValueType>>(newInput, _m, _n, _k, _weights, _weightScales, _inputScale, _transposeOutput, _output.GetMemoryLayout());
+        transformer.MapNodeOutput(output, newNode->output);
+    }
+
+    template <typename ValueType>
+    void QuantizedMatrixMatrixMultiplyNode<ValueType>::WriteToArchive(utilities::Archiver& archiver) const
+    {
+        Node::WriteToArchive(archiver);
+        archiver[defaultInputPortName] << _input;
+        archiver[defaultOutputPortName] << _output;
+        archiver["m"] << _m;
+        archiver["n"] << _n;
+        archiver["k"] << _k;
+        archiver["transposeOutput"] << _transposeOutput;
+        archiver["weights"] << PackWeights(_weights);
+        archiver["weightScales"] << _weightScales;
+        archiver["inputScale"] << _inputScale;
+    }
+
+    template <typename ValueType>
+    void QuantizedMatrixMatrixMultiplyNode<ValueType>::ReadFromArchive(utilities::Unarchiver& archiver)
+    {
+        Node::ReadFromArchive(archiver);
+        archiver[defaultInputPortName] >> _input;
+        archiver[defaultOutputPortName] >> _output;
+        archiver["m"] >> _m;
+        archiver["n"] >> _n;
+        archiver["k"] >> _k;
+        archiver["transposeOutput"] >> _transposeOutput;
+        std::vector<int> packedWeights;
+        archiver["weights"] >> packedWeights;
+        _weights = UnpackWeights(packedWeights, static_cast<size_t>(_m * _k));
+        archiver["weightScales"] >> _weightScales;
+        archiver["inputScale"] >> _inputScale;
+    }
+
+    //
+    // Explicit instantiation definitions
+    //
+    template class QuantizedMatrixMatrixMultiplyNode<float>;
+    template class QuantizedMatrixMatrixMultiplyNode<double>;
+} // namespace nodes
+} // namespace ell
@@ -8,6 +8,7 @@
 
 #include "RNNNode.h"
 #include "ActivationFunctions.h"
+#include "ConstantNode.h"
 
 #include <emitters/include/IRMath.h>
 
@@ -15,10 +16,26 @@
 
 #include <utilities/include/Exception.h>
 
+#include <algorithm>
+
 namespace ell
 {
 namespace nodes
 {
+    namespace
+    {
+        template <typename ValueType>
+        const ConstantNode<ValueType>* GetConstantInput(const model::InputPort<ValueType>& input)
+        {
+            auto constantNode = dynamic_cast<const ConstantNode<ValueType>*>(input.GetReferencedPort().GetNode());
+            if (constantNode == nullptr || constantNode->GetValues().size() != input.Size())
+            {
+                return nullptr;
+            }
+            return constantNode;
+        }
+    } // namespace
+
     template <typename ValueType>
     RNNNode<ValueType>::RNNNode() :
         CompilableNode(
@@ -188,6 +205,67 @@ namespace nodes
         });
     }
 
+    template <typename ValueType>
+    void RNNNode<ValueType>::EmitGatePreactivations(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function, size_t stackHeight, emitters::LLVMValue hiddenState, emitters::IRLocalArray gates)
+    {
+        const int hiddenUnits = static_cast<int>(this->_hiddenUnits);
+        const int inputSize = static_cast<int>(this->input.Size());
+        const int stackSize = static_cast<int>(stackHeight) * hiddenUnits;
+
+        auto alpha = static_cast<ValueType>(1.0); // GEMV scaling of the matrix multipication
+        auto beta = static_cast<ValueType>(1.0); // GEMV scaling of the bias addition
+
+        auto input = compiler.EnsurePortEmitted(this->input);
+        auto constantInputWeights = GetConstantInput(this->inputWeights);
+        auto constantHiddenWeights = GetConstantInput(this->hiddenWeights);
+        auto constantInputBias = GetConstantInput(this->inputBias);
+        auto constantHiddenBias = GetConstantInput(this->hiddenBias);
+        if (constantInputWeights != nullptr && constantHiddenWeights != nullptr && constantInputBias != nullptr && constantHiddenBias != nullptr)
+        {
+            // Each row of the fused weights is [W_i row | W_h row], so that it multiplies [x; h]
+            const int fusedSize = inputSize + hiddenUnits;
+            const auto& inputWeightsValues = constantInputWeights->GetValues();
+            const auto& hiddenWeightsValues = constantHiddenWeights->GetValues();
+            const auto& inputBiasValues = constantInputBias->GetValues();
+            const auto& hiddenBiasValues = constantHiddenBias->GetValues();
+            std::vector<ValueType> fusedWeightsValues(static_cast<size_t>(stackSize) * fusedSize);
+            std::vector<ValueType> fusedBiasValues(stackSize);
+            for (int row = 0; row < stackSize; ++row)
+            {
+                auto fusedRow = fusedWeightsValues.begin() + row * fusedSize;
+                std::copy_n(inputWeightsValues.begin() + row * inputSize, inputSize, fusedRow);
+                std::copy_n(hiddenWeightsValues.begin() + row * hiddenUnits, hiddenUnits, fusedRow + inputSize);
+                fusedBiasValues[row] = inputBiasValues[row] + hiddenBiasValues[row];
+            }
+
+            emitters::IRModuleEmitter& module = function.GetModule();
+            auto fusedWeights = function.PointerOffset(module.ConstantArray(compiler.GetGlobalName(*this, "fusedWeights"), fusedWeightsValues), 0);
+            auto fusedBias = function.PointerOffset(module.ConstantArray(compiler.GetGlobalName(*this, "fusedBias"), fusedBiasValues), 0);
+
+            // [x; h]
+            auto inputAndHiddenState = function.Variable(emitters::GetVariableType<ValueType>(), fusedSize);
+            function.MemoryCopy<ValueType>(input, 0, inputAndHiddenState, 0, inputSize);
+            function.MemoryCopy<ValueType>(hiddenState, 0, inputAndHiddenState, inputSize, hiddenUnits);
+
+            function.MemoryCopy<ValueType>(fusedBias, gates, stackSize); // Copy bias values into output so GEMV call accumulates them
+            function.CallGEMV(stackSize, fusedSize, alpha, fusedWeights, fusedSize, inputAndHiddenState, 1, beta, gates, 1);
+        }
+        else
+        {
+            auto inputWeights = compiler.EnsurePortEmitted(this->inputWeights);
+            auto hiddenWeights = compiler.EnsurePortEmitted(this->hiddenWeights);
+            auto inputBias = compiler.EnsurePortEmitted(this->inputBias);
+            auto hiddenBias = function.LocalArray(compiler.EnsurePortEmitted(this->hiddenBias));
+
+            function.MemoryCopy<ValueType>(inputBias, gates, stackSize); // Copy bias values into output so GEMV calls accumulate them
+            function.For(stackSize, [=](emitters::IRFunctionEmitter& fn, emitters::IRLocalScalar i) {
+                gates[i] = gates[i] + hiddenBias[i];
+            });
+            function.CallGEMV(stackSize, inputSize, alpha, inputWeights, inputSize, input, 1, beta, gates, 1);
+            function.CallGEMV(stackSize, hiddenUnits, alpha, hiddenWeights, hiddenUnits, hiddenState, 1, beta, gates, 1);
+        }
+    }
+
     template <typename ValueType>
     void RNNNode<ValueType>::ApplySoftmax(emitters::IRFunctionEmitter& function, emitters::LLVMValue dataValue, size_t dataLength)
     {
@@ -212,14 +290,6 @@ namespace nodes
         // it = sigma(W_{ ii } x + b_{ ii } +W_{ hi } h + b_{ hi })
         // h = tanh(it)
         const int hiddenUnits = static_cast<int>(this->_hiddenUnits);
-        const int inputSize = static_cast<int>(this->input.Size());
-
-        // Get LLVM references for all node inputs
-        auto input = compiler.EnsurePortEmitted(this->input);
-        auto inputWeights = compiler.EnsurePortEmitted(this->inputWeights);
-        auto hiddenWeights = compiler.EnsurePortEmitted(this->hiddenWeights);
-        auto inputBias = compiler.EnsurePortEmitted(this->inputBias);
-        auto hiddenBias = compiler.EnsurePortEmitted(this->hiddenBias);
 
         // Get LLVM reference for node output
         auto output = function.LocalArray(compiler.EnsurePortEmitted(this->output));
@@ -230,37 +300,20 @@ namespace nodes
         auto hiddenStateValue = module.EnsureEmitted(*hiddenStateVariable);
         auto hiddenStatePointer = function.PointerOffset(hiddenStateValue, 0); // convert "global variable" to a pointer
         auto hiddenState = function.LocalArray(hiddenStatePointer);
-        auto& prevHiddenState = hiddenState;
 
-        // Allocate local variables
+        // W_i * x + b_i + W_h * h + b_h
         auto inputGate = function.LocalArray(function.Variable(emitters::GetVariableType<ValueType>(), hiddenUnits));
-        auto hiddenGate = function.LocalArray(function.Variable(emitters::GetVariableType<ValueType>(), hiddenUnits));
-
-        auto alpha = static_cast<ValueType>(1.0); // GEMV scaling of the matrix multipication
-        auto beta = static_cast<ValueType>(1.0); // GEMV scaling of the bias addition
-
-        // W_i * x + b_i
-        function.MemoryCopy<ValueType>(inputBias, inputGate, hiddenUnits); // Copy bias values into output so GEMM call accumulates them
-        function.CallGEMV(hiddenUnits, inputSize, alpha, inputWeights, inputSize, input, 1, beta, inputGate, 1);
-
-        // W_h * h + b_h
-        function.MemoryCopy<ValueType>(hiddenBias, hiddenGate, hiddenUnits); // Copy bias values into output so GEMM call accumulates them
-        function.CallGEMV(hiddenUnits, hiddenUnits, alpha, hiddenWeights, hiddenUnits, prevHiddenState, 1, beta, hiddenGate, 1);
-
-        // input_gate = sigma(W_{ iz } x + b_{ iz } + W_{ hz } h + b_{ hz })
-        function.For(hiddenUnits, [=](emitters::IRFunctionEmitter& fn, emitters::IRLocalScalar i) {
-            inputGate[i] = inputGate[i] + hiddenGate[i];
+        this->EmitGatePreactivations(compiler, function, 1, hiddenState, inputGate);
+
+        // h = tanh(it), written to the hidden state and the output in the same pass
+        auto activation = GetNodeActivationFunction(this->_activation);
+        function.For(hiddenUnits, [=, &activation](emitters::IRFunctionEmitter& fn, emitters::IRLocalScalar i) {
+            emitters::IRLocalScalar it = inputGate[i];
+            auto newValue = fn.LocalScalar(activation->Compile(fn, it));
+            hiddenState[i] = newValue;
+            output[i] = newValue;
         });
 
-        // tanh
-        this->ApplyActivation(function, this->_activation, inputGate, hiddenUnits);
-
-        // save new HiddenState
-        function.MemoryCopy<ValueType>(inputGate, hiddenState, hiddenUnits);
-
-        // Copy hidden state to the output.
-        function.MemoryCopy<ValueType>(hiddenState, output, hiddenUnits);
-
         // Add the internal reset function
         std::string resetFunctionName = compiler.GetGlobalName(*this, "RNNNodeReset");
         emitters::IRFunctionEmitter& resetFunction = module.BeginResetFunction(resetFunctionName);
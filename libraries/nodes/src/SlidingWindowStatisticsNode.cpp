@@ -0,0 +1,407 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     SlidingWindowStatisticsNode.cpp (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "SlidingWindowStatisticsNode.h"
+
+#include <emitters/include/EmitterTypes.h>
+#include <emitters/include/IRLocalValue.h>
+#include <emitters/include/IRMath.h>
+
+#include <algorithm>
+
+namespace ell
+{
+namespace nodes
+{
+    std::string ToString(SlidingWindowStatistic statistic)
+    {
+        switch (statistic)
+        {
+        case SlidingWindowStatistic::mean:
+            return "mean";
+        case SlidingWindowStatistic::variance:
+            return "variance";
+        case SlidingWindowStatistic::min:
+            return "min";
+        case SlidingWindowStatistic::max:
+            return "max";
+        default:
+            throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "Unknown sliding window statistic");
+        }
+    }
+
+    SlidingWindowStatistic SlidingWindowStatisticFromString(const std::string& name)
+    {
+        for (auto statistic : { SlidingWindowStatistic::mean, SlidingWindowStatistic::variance, SlidingWindowStatistic::min, SlidingWindowStatistic::max })
+        {
+            if (ToString(statistic) == name)
+            {
+                return statistic;
+            }
+        }
+        throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "Unknown sliding window statistic: '" + name + "'");
+    }
+
+    template <typename ValueType>
+    SlidingWindowStatisticsNode<ValueType>::SlidingWindowStatisticsNode() :
+        CompilableNode({ &_input }, { &_output }),
+        _input(this, {}, defaultInputPortName),
+        _output(this, defaultOutputPortName, 0),
+        _windowSize(0),
+        _statistic(SlidingWindowStatistic::mean)
+    {
+    }
+
+    template <typename ValueType>
+    SlidingWindowStatisticsNode<ValueType>::SlidingWindowStatisticsNode(const model::OutputPort<ValueType>& input, size_t windowSize, SlidingWindowStatistic statistic) :
+        CompilableNode({ &_input }, { &_output }),
+        _input(this, input, defaultInputPortName),
+        _output(this, defaultOutputPortName, _input.Size()),
+        _windowSize(windowSize),
+        _statistic(statistic)
+    {
+        if (windowSize == 0)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "SlidingWindowStatisticsNode: window size must be nonzero");
+        }
+        Reset();
+    }
+
+    template <typename ValueType>
+    void SlidingWindowStatisticsNode<ValueType>::Reset()
+    {
+        auto dimension = _input.Size();
+        _history.assign(_windowSize * dimension, 0);
+        _position = 0;
+        _sum.assign(dimension, 0);
+        _mean.assign(dimension, 0);
+        _sumSquaredDeviations.assign(dimension, 0);
+
+        // The window starts out full of zeros, of which the most recent one (at the end of the buffer) is the only candidate
+        _candidates.assign(dimension, std::deque<size_t>{ _windowSize - 1 });
+    }
+
+    template <typename ValueType>
+    void SlidingWindowStatisticsNode<ValueType>::Compute() const
+    {
+        auto inputSample = _input.GetValue();
+        const auto numChannels = inputSample.size();
+        const auto windowSize = static_cast<double>(_windowSize);
+
+        std::vector<ValueType> result(numChannels);
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            auto x = inputSample[channel];
+            auto& slot = _history[_position * numChannels + channel];
+            auto oldest = slot;
+            slot = x;
+
+            switch (_statistic)
+            {
+            case SlidingWindowStatistic::mean:
+                _sum[channel] += static_cast<double>(x) - static_cast<double>(oldest);
+                result[channel] = static_cast<ValueType>(_sum[channel] / windowSize);
+                break;
+
+            case SlidingWindowStatistic::variance:
+            {
+                auto delta = static_cast<double>(x) - static_cast<double>(oldest);
+                auto newMean = _mean[channel] + delta / windowSize;
+                _sumSquaredDeviations[channel] += delta * ((x - newMean) + (oldest - _mean[channel]));
+                _mean[channel] = newMean;
+                result[channel] = static_cast<ValueType>(std::max(_sumSquaredDeviations[channel] / windowSize, 0.0));
+                break;
+            }
+
+            case SlidingWindowStatistic::min:
+            case SlidingWindowStatistic::max:
+            {
+                auto& candidates = _candidates[channel];
+                if (!candidates.empty() && candidates.front() == _position)
+                {
+                    candidates.pop_front(); // the sample being replaced leaves the window
+                }
+
+                // Samples that are no better than the new one can't be the extremum while it's in the window
+                auto isDominated = [&](size_t position) {
+                    auto value = _history[position * numChannels + channel];
+                    return _statistic == SlidingWindowStatistic::max ? value <= x : value >= x;
+                };
+                while (!candidates.empty() && isDominated(candidates.back()))
+                {
+                    candidates.pop_back();
+                }
+                candidates.push_back(_position);
+                result[channel] = _history[candidates.front() * numChannels + channel];
+                break;
+            }
+            }
+        }
+
+        if (_position == _windowSize - 1)
+        {
+            RecomputeAccumulators();
+        }
+        _position = (_position + 1) % _windowSize;
+        _output.SetOutput(result);
+    };
+
+    template <typename ValueType>
+    void SlidingWindowStatisticsNode<ValueType>::RecomputeAccumulators() const
+    {
+        if (_statistic != SlidingWindowStatistic::mean && _statistic != SlidingWindowStatistic::variance)
+        {
+            return;
+        }
+
+        const auto numChannels = _sum.size();
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            double sum = 0;
+            for (size_t position = 0; position < _windowSize; ++position)
+            {
+                sum += _history[position * numChannels + channel];
+            }
+            _sum[channel] = sum;
+            _mean[channel] = sum / _windowSize;
+
+            double sumSquaredDeviations = 0;
+            for (size_t position = 0; position < _windowSize; ++position)
+            {
+                auto deviation = _history[position * numChannels + channel] - _mean[channel];
+                sumSquaredDeviations += deviation * deviation;
+            }
+            _sumSquaredDeviations[channel] = sumSquaredDeviations;
+        }
+    }
+
+    template <typename ValueType>
+    void SlidingWindowStatisticsNode<ValueType>::Copy(model::ModelTransformer& transformer) const
+    {
+        const auto& newInputs = transformer.GetCorrespondingInputs(_input);
+        auto newNode = transformer.AddNode<SlidingWindowStatisticsNode<ValueType>>(newInputs, _windowSize, _statistic);
+        transformer.MapNodeOutput(output, newNode->output);
+    }
+
+    template <typename ValueType>
+    void SlidingWindowStatisticsNode<ValueType>::Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
+    {
+        using namespace std::string_literals;
+
+        auto& module = function.GetModule();
+        const auto bufferSize = _windowSize * input.Size();
+
+        // The circular buffer of samples, and the position of the oldest one, which the new sample replaces
+        llvm::GlobalVariable* history = module.GlobalArray("history_"s + GetInternalStateIdentifier(), std::vector<ValueType>(bufferSize, 0));
+        llvm::GlobalVariable* positionVar = module.Global<int>("position_"s + GetInternalStateIdentifier(), 0);
+
+        emitters::LLVMValue pInput = compiler.EnsurePortEmitted(input);
+        emitters::LLVMValue pOutput = compiler.EnsurePortEmitted(output);
+        auto position = function.LocalScalar(function.Load(positionVar));
+
+        switch (_statistic)
+        {
+        case SlidingWindowStatistic::mean:
+            CompileMean(function, pInput, pOutput, history, position);
+            break;
+        case SlidingWindowStatistic::variance:
+            CompileVariance(function, pInput, pOutput, history, position);
+            break;
+        case SlidingWindowStatistic::min:
+        case SlidingWindowStatistic::max:
+            CompileExtremum(function, pInput, pOutput, history, position);
+            break;
+        }
+
+        function.Store(positionVar, function.Operator(emitters::TypedOperator::moduloSigned, position + function.LocalScalar(1), function.LocalScalar(static_cast<int>(_windowSize))));
+    }
+
+    template <typename ValueType>
+    void SlidingWindowStatisticsNode<ValueType>::CompileMean(emitters::IRFunctionEmitter& function, emitters::LLVMValue pInput, emitters::LLVMValue pOutput, llvm::GlobalVariable* history, emitters::IRLocalScalar position)
+    {
+        using namespace std::string_literals;
+
+        const int numChannels = static_cast<int>(input.Size());
+        const int windowSize = static_cast<int>(_windowSize);
+        llvm::GlobalVariable* sums = function.GetModule().GlobalArray("sum_"s + GetInternalStateIdentifier(), std::vector<double>(numChannels, 0));
+
+        function.For(numChannels, [=](emitters::IRFunctionEmitter& function, emitters::LLVMValue channelVar) {
+            auto channel = function.LocalScalar(channelVar);
+            auto historyIndex = position * numChannels + channel;
+            auto x = function.LocalScalar(function.ValueAt(pInput, channel));
+            auto oldest = function.LocalScalar(function.ValueAt(history, historyIndex));
+            function.SetValueAt(history, historyIndex, x);
+
+            auto delta = function.LocalScalar(function.CastValue<double>(x)) - function.LocalScalar(function.CastValue<double>(oldest));
+            auto sum = function.LocalScalar(function.ValueAt(sums, channel)) + delta;
+            function.SetValueAt(sums, channel, sum);
+            function.SetValueAt(pOutput, channel, function.CastValue<ValueType>(sum / static_cast<double>(windowSize)));
+        });
+
+        // Once per pass over the buffer, recompute the sums from the samples, so rounding errors don't build up
+        function.If(position == windowSize - 1, [=](emitters::IRFunctionEmitter& function) {
+            function.For(numChannels, [=](emitters::IRFunctionEmitter& function, emitters::LLVMValue channelVar) {
+                auto channel = function.LocalScalar(channelVar);
+                function.SetValueAt(sums, channel, function.Literal<double>(0));
+                function.For(windowSize, [=](emitters::IRFunctionEmitter& function, emitters::LLVMValue positionVar) {
+                    auto value = function.LocalScalar(function.CastValue<double>(function.ValueAt(history, function.LocalScalar(positionVar) * numChannels + channel)));
+                    function.SetValueAt(sums, channel, function.LocalScalar(function.ValueAt(sums, channel)) + value);
+                });
+            });
+        });
+    }
+
+    template <typename ValueType>
+    void SlidingWindowStatisticsNode<ValueType>::CompileVariance(emitters::IRFunctionEmitter& function, emitters::LLVMValue pInput, emitters::LLVMValue pOutput, llvm::GlobalVariable* history, emitters::IRLocalScalar position)
+    {
+        using namespace std::string_literals;
+
+        auto& module = function.GetModule();
+        const int numChannels = static_cast<int>(input.Size());
+        const int windowSize = static_cast<int>(_windowSize);
+        llvm::GlobalVariable* means = module.GlobalArray("mean_"s + GetInternalStateIdentifier(), std::vector<double>(numChannels, 0));
+        llvm::GlobalVariable* sumSquaredDeviations = module.GlobalArray("sumSquaredDeviations_"s + GetInternalStateIdentifier(), std::vector<double>(numChannels, 0));
+
+        function.For(numChannels, [=](emitters::IRFunctionEmitter& function, emitters::LLVMValue channelVar) {
+            auto channel = function.LocalScalar(channelVar);
+            auto historyIndex = position * numChannels + channel;
+            auto x = function.LocalScalar(function.ValueAt(pInput, channel));
+            auto oldest = function.LocalScalar(function.ValueAt(history, historyIndex));
+            function.SetValueAt(history, historyIndex, x);
+
+            // Welford's update, for replacing the oldest sample with the new one
+            auto newValue = function.LocalScalar(function.CastValue<double>(x));
+            auto oldValue = function.LocalScalar(function.CastValue<double>(oldest));
+            auto delta = newValue - oldValue;
+            auto mean = function.LocalScalar(function.ValueAt(means, channel));
+            auto newMean = mean + (delta / static_cast<double>(windowSize));
+            auto sumSquares = function.LocalScalar(function.ValueAt(sumSquaredDeviations, channel)) + (delta * ((newValue - newMean) + (oldValue - mean)));
+            function.SetValueAt(means, channel, newMean);
+            function.SetValueAt(sumSquaredDeviations, channel, sumSquares);
+            function.SetValueAt(pOutput, channel, function.CastValue<ValueType>(emitters::Max(sumSquares / static_cast<double>(windowSize), 0.0)));
+        });
+
+        // Once per pass over the buffer, recompute the mean and sum of squared deviations from the samples, so rounding
+        // errors don't build up
+        function.If(position == windowSize - 1, [=](emitters::IRFunctionEmitter& function) {
+            function.For(numChannels, [=](emitters::IRFunctionEmitter& function, emitters::LLVMValue channelVar) {
+                auto channel = function.LocalScalar(channelVar);
+                auto getValue = [=](emitters::IRFunctionEmitter& function, emitters::LLVMValue positionVar) {
+                    return function.LocalScalar(function.CastValue<double>(function.ValueAt(history, function.LocalScalar(positionVar) * numChannels + channel)));
+                };
+
+                function.SetValueAt(means, channel, function.Literal<double>(0));
+                function.For(windowSize, [=](emitters::IRFunctionEmitter& function, emitters::LLVMValue positionVar) {
+                    function.SetValueAt(means, channel, function.LocalScalar(function.ValueAt(means, channel)) + getValue(function, positionVar));
+                });
+                auto mean = function.LocalScalar(function.ValueAt(means, channel)) / static_cast<double>(windowSize);
+                function.SetValueAt(means, channel, mean);
+
+                function.SetValueAt(sumSquaredDeviations, channel, function.Literal<double>(0));
+                function.For(windowSize, [=](emitters::IRFunctionEmitter& function, emitters::LLVMValue positionVar) {
+                    auto deviation = getValue(function, positionVar) - mean;
+                    function.SetValueAt(sumSquaredDeviations, channel, function.LocalScalar(function.ValueAt(sumSquaredDeviations, channel)) + (deviation * deviation));
+                });
+            });
+        });
+    }
+
+    template <typename ValueType>
+    void SlidingWindowStatisticsNode<ValueType>::CompileExtremum(emitters::IRFunctionEmitter& function, emitters::LLVMValue pInput, emitters::LLVMValue pOutput, llvm::GlobalVariable* history, emitters::IRLocalScalar position)
+    {
+        using namespace std::string_literals;
+
+        auto& module = function.GetModule();
+        const int numChannels = static_cast<int>(input.Size());
+        const int windowSize = static_cast<int>(_windowSize);
+        const bool isMax = _statistic == SlidingWindowStatistic::max;
+
+        // Each channel's candidates are kept in a circular buffer of `windowSize` positions, starting at `firstCandidate`.
+        // Initially, the only candidate is the most recent of the zeros the window starts with.
+        std::vector<int> initialCandidates(numChannels * windowSize, 0);
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            initialCandidates[channel * windowSize] = windowSize - 1;
+        }
+        llvm::GlobalVariable* candidates = module.GlobalArray("candidates_"s + GetInternalStateIdentifier(), initialCandidates);
+        llvm::GlobalVariable* firstCandidates = module.GlobalArray("firstCandidate_"s + GetInternalStateIdentifier(), std::vector<int>(numChannels, 0));
+        llvm::GlobalVariable* numCandidates = module.GlobalArray("numCandidates_"s + GetInternalStateIdentifier(), std::vector<int>(numChannels, 1));
+
+        function.For(numChannels, [=](emitters::IRFunctionEmitter& function, emitters::LLVMValue channelVar) {
+            auto channel = function.LocalScalar(channelVar);
+            auto candidatesBegin = channel * windowSize;
+            auto wrap = [&function, windowSize](emitters::IRLocalScalar index) {
+                return function.LocalScalar(function.Operator(emitters::TypedOperator::moduloSigned, index, function.LocalScalar(windowSize)));
+            };
+            auto x = function.LocalScalar(function.ValueAt(pInput, channel));
+
+            // Remove the sample being replaced, if it's a candidate. There's always at least one candidate.
+            auto first = function.LocalScalar(function.ValueAt(firstCandidates, channel));
+            function.If(function.LocalScalar(function.ValueAt(candidates, candidatesBegin + first)) == position, [=](emitters::IRFunctionEmitter& function) {
+                function.SetValueAt(firstCandidates, channel, wrap(first + 1));
+                function.SetValueAt(numCandidates, channel, function.LocalScalar(function.ValueAt(numCandidates, channel)) - 1);
+            });
+
+            // Remove the candidates that are no better than the new sample. The last candidate's index is kept in
+            // range even when there are none, so the condition can be evaluated without branching.
+            auto getLastCandidateValue = [=](emitters::IRFunctionEmitter& function) {
+                auto count = function.LocalScalar(function.ValueAt(numCandidates, channel));
+                auto last = wrap(function.LocalScalar(function.ValueAt(firstCandidates, channel)) + count + (windowSize - 1));
+                auto lastPosition = function.LocalScalar(function.ValueAt(candidates, candidatesBegin + last));
+                return function.LocalScalar(function.ValueAt(history, lastPosition * numChannels + channel));
+            };
+            function.While([=](emitters::IRFunctionEmitter& function) {
+                auto count = function.LocalScalar(function.ValueAt(numCandidates, channel));
+                auto value = getLastCandidateValue(function);
+                return (count > 0) && (isMax ? value <= x : value >= x);
+            },
+                           [=](emitters::IRFunctionEmitter& function) {
+                               function.SetValueAt(numCandidates, channel, function.LocalScalar(function.ValueAt(numCandidates, channel)) - 1);
+                           });
+
+            // Add the new sample
+            auto count = function.LocalScalar(function.ValueAt(numCandidates, channel));
+            first = function.LocalScalar(function.ValueAt(firstCandidates, channel));
+            function.SetValueAt(candidates, candidatesBegin + wrap(first + count), position);
+            function.SetValueAt(numCandidates, channel, count + 1);
+            function.SetValueAt(history, position * numChannels + channel, x);
+
+            auto extremumPosition = function.LocalScalar(function.ValueAt(candidates, candidatesBegin + first));
+            function.SetValueAt(pOutput, channel, function.ValueAt(history, extremumPosition * numChannels + channel));
+        });
+    }
+
+    template <typename ValueType>
+    void SlidingWindowStatisticsNode<ValueType>::WriteToArchive(utilities::Archiver& archiver) const
+    {
+        Node::WriteToArchive(archiver);
+        archiver[defaultInputPortName] << _input;
+        archiver["windowSize"] << _windowSize;
+        archiver["statistic"] << ToString(_statistic);
+    }
+
+    template <typename ValueType>
+    void SlidingWindowStatisticsNode<ValueType>::ReadFromArchive(utilities::Unarchiver& archiver)
+    {
+        Node::ReadFromArchive(archiver);
+        archiver[defaultInputPortName] >> _input;
+        archiver["windowSize"] >> _windowSize;
+        std::string statistic;
+        archiver["statistic"] >> statistic;
+        _statistic = SlidingWindowStatisticFromString(statistic);
+        _output.SetSize(_input.Size());
+        Reset();
+    }
+
+    //
+    // Explicit instantiation definitions
+    //
+    template class SlidingWindowStatisticsNode<float>;
+    template class SlidingWindowStatisticsNode<double>;
+} // namespace nodes
+} // namespace ell
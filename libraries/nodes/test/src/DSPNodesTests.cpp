@@ -26,11 +26,13 @@
 #include <model/include/Model.h>
 #include <model/include/Node.h>
 
+#include <nodes/include/BinaryOperationNode.h>
 #include <nodes/include/BufferNode.h>
 #include <nodes/include/ConstantNode.h>
 #include <nodes/include/DTWDistanceNode.h>
 #include <nodes/include/DelayNode.h>
 #include <nodes/include/DiagonalConvolutionNode.h>
+#include <nodes/include/ExponentialMovingAverageNode.h>
 #include <nodes/include/FFTNode.h>
 #include <nodes/include/FilterBankNode.h>
 #include <nodes/include/GRUNode.h>
@@ -39,6 +41,7 @@
 #include <nodes/include/RNNNode.h>
 #include <nodes/include/ReorderDataCodeNode.h>
 #include <nodes/include/SimpleConvolutionNode.h>
+#include <nodes/include/SlidingWindowStatisticsNode.h>
 #include <nodes/include/UnrolledConvolutionNode.h>
 #include <nodes/include/WinogradConvolutionNode.h>
 
@@ -55,6 +58,7 @@
 #include <utilities/include/RandomEngines.h>
 #include <utilities/include/StringUtil.h>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <memory>
@@ -451,6 +455,173 @@ static void TestBufferNode()
     });
 }
 
+template <typename ValueType>
+static void TestSlidingWindowStatisticsNode(SlidingWindowStatistic statistic, size_t windowSize)
+{
+    const size_t inputSize = 3;
+    const size_t numEntries = 50;
+
+    std::vector<std::vector<ValueType>> data;
+    for (size_t index = 0; index < numEntries; ++index)
+    {
+        std::vector<ValueType> item(inputSize);
+        for (size_t channel = 0; channel < inputSize; ++channel)
+        {
+            item[channel] = static_cast<ValueType>(static_cast<int>((index * 7 + channel * 3) % 11) - 5);
+        }
+        data.push_back(item);
+    }
+
+    // Compute the expected output directly from the window, which starts out filled with zeros
+    std::vector<std::vector<ValueType>> expected;
+    for (size_t index = 0; index < numEntries; ++index)
+    {
+        std::vector<ValueType> result(inputSize);
+        for (size_t channel = 0; channel < inputSize; ++channel)
+        {
+            std::vector<double> window;
+            for (size_t offset = 0; offset < windowSize; ++offset)
+            {
+                window.push_back(index >= offset ? data[index - offset][channel] : 0.0);
+            }
+
+            auto mean = std::accumulate(window.begin(), window.end(), 0.0) / windowSize;
+            switch (statistic)
+            {
+            case SlidingWindowStatistic::mean:
+                result[channel] = static_cast<ValueType>(mean);
+                break;
+            case SlidingWindowStatistic::variance:
+                result[channel] = static_cast<ValueType>(std::accumulate(window.begin(), window.end(), 0.0, [mean](double sum, double x) { return sum + (x - mean) * (x - mean); }) / windowSize);
+                break;
+            case SlidingWindowStatistic::min:
+                result[channel] = static_cast<ValueType>(*std::min_element(window.begin(), window.end()));
+                break;
+            case SlidingWindowStatistic::max:
+                result[channel] = static_cast<ValueType>(*std::max_element(window.begin(), window.end()));
+                break;
+            }
+        }
+        expected.push_back(result);
+    }
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ValueType>>(inputSize);
+    const auto& output = SlidingWindowStatistics(inputNode->output, windowSize, statistic);
+
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", output } });
+
+    TestWithSerialization(map, "TestSlidingWindowStatisticsNode", [&](model::Map& map, int iteration) {
+        model::MapCompilerOptions settings;
+        model::ModelOptimizerOptions optimizerOptions;
+        model::IRMapCompiler compiler(settings, optimizerOptions);
+        auto compiledMap = compiler.Compile(map);
+
+        auto message = utilities::FormatString("Testing SlidingWindowStatisticsNode (%s, window size %d) compile iteration %d", ToString(statistic).c_str(), static_cast<int>(windowSize), iteration);
+        VerifyCompiledOutputAndResult<ValueType, ValueType>(map, compiledMap, data, expected, message, "", 1e-4);
+    });
+}
+
+// A long stream of non-integer samples with a large offset, through a large window, so that rounding errors in the
+// running sums would build up
+template <typename ValueType>
+static void TestSlidingWindowStatisticsNodeLongStream(SlidingWindowStatistic statistic)
+{
+    const size_t inputSize = 2;
+    const size_t windowSize = 1000;
+    const size_t numEntries = 50000;
+
+    auto engine = utilities::GetRandomEngine("123");
+    std::uniform_real_distribution<double> noise(-0.5, 0.5);
+    std::vector<std::vector<ValueType>> data;
+    for (size_t index = 0; index < numEntries; ++index)
+    {
+        std::vector<ValueType> item(inputSize);
+        for (size_t channel = 0; channel < inputSize; ++channel)
+        {
+            item[channel] = static_cast<ValueType>(1000.0 * (channel + 1) + std::sin(0.01 * index) + noise(engine));
+        }
+        data.push_back(item);
+    }
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ValueType>>(inputSize);
+    const auto& output = SlidingWindowStatistics(inputNode->output, windowSize, statistic);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", output } });
+
+    model::MapCompilerOptions settings;
+    model::ModelOptimizerOptions optimizerOptions;
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    auto compiledMap = compiler.Compile(map);
+
+    // Check the output against the statistic computed directly from the window, every so often and at the end
+    bool computedOk = true;
+    bool compiledOk = true;
+    for (size_t index = 0; index < numEntries; ++index)
+    {
+        map.SetInputValue(0, data[index]);
+        auto computed = map.ComputeOutput<ValueType>(0);
+        compiledMap.SetInputValue(0, data[index]);
+        auto compiled = compiledMap.ComputeOutput<ValueType>(0);
+        if (index % 997 != 0 && index != numEntries - 1)
+        {
+            continue;
+        }
+
+        for (size_t channel = 0; channel < inputSize; ++channel)
+        {
+            std::vector<double> window;
+            for (size_t offset = 0; offset < windowSize; ++offset)
+            {
+                window.push_back(index >= offset ? data[index - offset][channel] : 0.0);
+            }
+            auto mean = std::accumulate(window.begin(), window.end(), 0.0) / windowSize;
+            auto expected = mean;
+            if (statistic == SlidingWindowStatistic::variance)
+            {
+                expected = std::accumulate(window.begin(), window.end(), 0.0, [mean](double sum, double x) { return sum + (x - mean) * (x - mean); }) / windowSize;
+            }
+
+            auto tolerance = 1e-5 * (1 + std::abs(expected));
+            computedOk = computedOk && std::abs(computed[channel] - expected) <= tolerance;
+            compiledOk = compiledOk && std::abs(compiled[channel] - expected) <= tolerance;
+        }
+    }
+
+    auto message = utilities::FormatString("Testing SlidingWindowStatisticsNode (%s) over a long stream", ToString(statistic).c_str());
+    testing::ProcessTest(message + " compute", computedOk);
+    testing::ProcessTest(message + " compiled", compiledOk);
+}
+
+template <typename ValueType>
+static void TestExponentialMovingAverageNode()
+{
+    const ValueType smoothingFactor = static_cast<ValueType>(0.25);
+    std::vector<std::vector<ValueType>> data = { { 4, -8 }, { 0, 0 }, { 0, 8 }, { 4, 8 } };
+    std::vector<std::vector<ValueType>> expected = { { 1, -2 }, { 0.75, -1.5 }, { 0.5625, 0.875 }, { 1.421875, 2.65625 } };
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ValueType>>(data[0].size());
+    const auto& output = ExponentialMovingAverage(inputNode->output, smoothingFactor);
+
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", output } });
+
+    TestWithSerialization(map, "TestExponentialMovingAverageNode", [&](model::Map& map, int iteration) {
+        model::MapCompilerOptions settings;
+        model::ModelOptimizerOptions optimizerOptions;
+        model::IRMapCompiler compiler(settings, optimizerOptions);
+        auto compiledMap = compiler.Compile(map);
+
+        auto message = utilities::FormatString("Testing ExponentialMovingAverageNode compile iteration %d", iteration);
+        VerifyCompiledOutputAndResult<ValueType, ValueType>(map, compiledMap, data, expected, message);
+
+        // After a reset the average starts over from zero
+        map.Reset();
+        auto resetOutput = map.Compute<ValueType>(data[0]);
+        testing::ProcessTest(message + " after reset", testing::IsEqual(resetOutput, expected[0]));
+    });
+}
+
 template <typename ValueType>
 static void TestConvolutionNodeCompile(dsp::ConvolutionMethodOption convolutionMethod)
 {
@@ -762,7 +933,22 @@ void TestRNNNode()
         }
     });
 }
-void TestGRUNode()
+
+// Adds the given RNN weights to the model. Non-constant weights pass through an add-zero node, so the compiled RNN
+// nodes can't fuse them at compile time and fall back to separate input and hidden GEMVs.
+template <typename ElementType>
+static const model::OutputPort<ElementType>& AddRNNWeights(model::Model& model, const std::vector<ElementType>& values, bool constantWeights)
+{
+    auto constantNode = model.AddNode<nodes::ConstantNode<ElementType>>(values);
+    if (constantWeights)
+    {
+        return constantNode->output;
+    }
+    auto zerosNode = model.AddNode<nodes::ConstantNode<ElementType>>(std::vector<ElementType>(values.size()));
+    return model.AddNode<nodes::BinaryOperationNode<ElementType>>(constantNode->output, zerosNode->output, BinaryOperationType::add)->output;
+}
+
+void TestGRUNode(bool constantWeights)
 {
     using ElementType = double;
     using namespace ell::predictors;
@@ -796,14 +982,14 @@ void TestGRUNode()
     model::Model model;
     auto inputNode = model.AddNode<model::InputNode<ElementType>>(inputSize);
     auto resetTriggerNode = model.AddNode<nodes::ConstantNode<int>>(0);
-    auto inputWeightsNode = model.AddNode<nodes::ConstantNode<ElementType>>(inputWeights.ToArray());
-    auto hiddenWeightsNode = model.AddNode<nodes::ConstantNode<ElementType>>(hiddenWeights.ToArray());
-    auto inputBiasNode = model.AddNode<nodes::ConstantNode<ElementType>>(inputBias.ToArray());
-    auto hiddenBiasNode = model.AddNode<nodes::ConstantNode<ElementType>>(hiddenBias.ToArray());
+    const auto& inputWeightsOutput = AddRNNWeights(model, inputWeights.ToArray(), constantWeights);
+    const auto& hiddenWeightsOutput = AddRNNWeights(model, hiddenWeights.ToArray(), constantWeights);
+    const auto& inputBiasOutput = AddRNNWeights(model, inputBias.ToArray(), constantWeights);
+    const auto& hiddenBiasOutput = AddRNNWeights(model, hiddenBias.ToArray(), constantWeights);
     auto activation = ell::predictors::neural::Activation<ElementType>(new ell::predictors::neural::TanhActivation<ElementType>());
     auto recurrentActivation = ell::predictors::neural::Activation<ElementType>(new ell::predictors::neural::SigmoidActivation<ElementType>());
 
-    auto gruNode = model.AddNode<nodes::GRUNode<ElementType>>(inputNode->output, resetTriggerNode->output, hiddenSize, inputWeightsNode->output, hiddenWeightsNode->output, inputBiasNode->output, hiddenBiasNode->output, activation, recurrentActivation);
+    auto gruNode = model.AddNode<nodes::GRUNode<ElementType>>(inputNode->output, resetTriggerNode->output, hiddenSize, inputWeightsOutput, hiddenWeightsOutput, inputBiasOutput, hiddenBiasOutput, activation, recurrentActivation);
     auto map = model::Map(model, { { "input", inputNode } }, { { "output", gruNode->output } });
 
     TestWithSerialization(map, "TestGRUNode", [&](model::Map& map, int iteration) {
@@ -813,7 +999,7 @@ void TestGRUNode()
         model::ModelOptimizerOptions optimizerOptions;
         model::IRMapCompiler compiler(settings, optimizerOptions);
         auto compiledMap = compiler.Compile(map);
-        auto name = gruNode->GetRuntimeTypeName();
+        auto name = gruNode->GetRuntimeTypeName() + (constantWeights ? "" : " (non-constant weights)");
 
         std::vector<std::vector<ElementType>> signal = { input.ToArray() };
         map.SetInputValue(0, signal[0]);
@@ -842,7 +1028,7 @@ void TestGRUNode()
     });
 }
 
-void TestLSTMNode()
+void TestLSTMNode(bool constantWeights)
 {
     using ElementType = double;
     using namespace ell::predictors;
@@ -876,11 +1062,11 @@ void TestLSTMNode()
     model::Model model;
     auto inputNode = model.AddNode<model::InputNode<ElementType>>(inputSize);
     auto resetTriggerNode = model.AddNode<nodes::ConstantNode<int>>(0);
-    auto inputWeightsNode = model.AddNode<nodes::ConstantNode<ElementType>>(inputWeights.ToArray());
-    auto hiddenWeightsNode = model.AddNode<nodes::ConstantNode<ElementType>>(hiddenWeights.ToArray());
-    auto inputBiasNode = model.AddNode<nodes::ConstantNode<ElementType>>(inputBias.ToArray());
-    auto hiddenBiasNode = model.AddNode<nodes::ConstantNode<ElementType>>(hiddenBias.ToArray());
-    auto lstmNode = model.AddNode<nodes::LSTMNode<ElementType>>(inputNode->output, resetTriggerNode->output, hiddenSize, inputWeightsNode->output, hiddenWeightsNode->output, inputBiasNode->output, hiddenBiasNode->output, ell::predictors::neural::Activation<ElementType>(new ell::predictors::neural::TanhActivation<ElementType>()), ell::predictors::neural::Activation<ElementType>(new ell::predictors::neural::SigmoidActivation<ElementType>()));
+    const auto& inputWeightsOutput = AddRNNWeights(model, inputWeights.ToArray(), constantWeights);
+    const auto& hiddenWeightsOutput = AddRNNWeights(model, hiddenWeights.ToArray(), constantWeights);
+    const auto& inputBiasOutput = AddRNNWeights(model, inputBias.ToArray(), constantWeights);
+    const auto& hiddenBiasOutput = AddRNNWeights(model, hiddenBias.ToArray(), constantWeights);
+    auto lstmNode = model.AddNode<nodes::LSTMNode<ElementType>>(inputNode->output, resetTriggerNode->output, hiddenSize, inputWeightsOutput, hiddenWeightsOutput, inputBiasOutput, hiddenBiasOutput, ell::predictors::neural::Activation<ElementType>(new ell::predictors::neural::TanhActivation<ElementType>()), ell::predictors::neural::Activation<ElementType>(new ell::predictors::neural::SigmoidActivation<ElementType>()));
     auto map = model::Map(model, { { "input", inputNode } }, { { "output", lstmNode->output } });
 
     TestWithSerialization(map, "TestLSTMNode", [&](model::Map& map, int iteration) {
@@ -890,7 +1076,7 @@ void TestLSTMNode()
         model::ModelOptimizerOptions optimizerOptions;
         model::IRMapCompiler compiler(settings, optimizerOptions);
         auto compiledMap = compiler.Compile(map);
-        auto name = lstmNode->GetRuntimeTypeName();
+        auto name = lstmNode->GetRuntimeTypeName() + (constantWeights ? "" : " (non-constant weights)");
 
         std::vector<std::vector<ElementType>> signal = { input.ToArray() };
         map.SetInputValue(0, signal[0]);
@@ -925,8 +1111,10 @@ void TestLSTMNode()
 void TestDSPNodes(const std::string& path)
 {
     TestRNNNode();
-    TestGRUNode();
-    TestLSTMNode();
+    TestGRUNode(true);
+    TestGRUNode(false);
+    TestLSTMNode(true);
+    TestLSTMNode(false);
 
     //
     // Compute tests
@@ -951,6 +1139,17 @@ void TestDSPNodes(const std::string& path)
 
     TestBufferNode<float>();
 
+    for (auto statistic : { SlidingWindowStatistic::mean, SlidingWindowStatistic::variance, SlidingWindowStatistic::min, SlidingWindowStatistic::max })
+    {
+        TestSlidingWindowStatisticsNode<float>(statistic, 1);
+        TestSlidingWindowStatisticsNode<float>(statistic, 7);
+        TestSlidingWindowStatisticsNode<double>(statistic, 16);
+    }
+    TestSlidingWindowStatisticsNodeLongStream<float>(SlidingWindowStatistic::mean);
+    TestSlidingWindowStatisticsNodeLongStream<float>(SlidingWindowStatistic::variance);
+    TestExponentialMovingAverageNode<float>();
+    TestExponentialMovingAverageNode<double>();
+
     TestConvolutionNodeCompile<float>(dsp::ConvolutionMethodOption::simple);
     // TestConvolutionNodeCompile<float>(dsp::ConvolutionMethodOption::diagonal); // ERROR: diagonal test currently broken
     TestConvolutionNodeCompile<float>(dsp::ConvolutionMethodOption::unrolled);
@@ -187,7 +187,7 @@ namespace optimization
         double otherScale = otherTerm.rhs;
         const auto& otherSolution = otherTerm.lhs.get();
 
-        _baseSolution = (_baseSolution * thisScale) + (otherSolution * otherScale);
+        _baseSolution = (_baseSolution * thisScale) + (otherSolution.GetBaseSolution() * otherScale);
         UpdateBaseSolution();
     }
 
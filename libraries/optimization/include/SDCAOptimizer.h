@@ -10,12 +10,15 @@
 #include "Common.h"
 #include "Expression.h"
 
+#include <utilities/include/ThreadPool.h>
+
 #include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <numeric>
 #include <random>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace ell
@@ -27,6 +30,17 @@ namespace optimization
     {
         double regularizationParameter;
         bool permuteData = true;
+
+        /// <summary>
+        /// The number of threads to use. If greater than one, each epoch is processed in rounds: every thread runs
+        /// SDCA on its own copy of the solution for `miniBatchSize` examples of the permutation, and then the
+        /// updates of all the threads are averaged. Averaging keeps the dual variables feasible, so the dual
+        /// objective still increases monotonically. If zero, uses the hardware concurrency of the machine.
+        /// </summary>
+        size_t numThreads = 1;
+
+        /// <summary> The number of examples each thread processes per round, when `numThreads` is not one. </summary>
+        size_t miniBatchSize = 1024;
     };
 
     /// <summary> Information about the current solution found by SDCA. </summary>
@@ -111,9 +125,19 @@ namespace optimization
         };
         std::vector<ExampleInfo> _exampleInfo;
 
+        // per-thread state used by the parallel update
+        struct Worker
+        {
+            RegularizerType regularizer;
+            SolutionType w;
+            SolutionType v;
+            std::vector<ExampleInfo> exampleInfo;
+        };
+
         void OneTimeSetup(std::shared_ptr<const DatasetType> examples, std::string randomSeedString);
         void InitializeDuals();
-        void Step(ExampleType example, ExampleInfo& exampleInfo);
+        void ParallelEpoch(const std::vector<size_t>& permutation);
+        void Step(ExampleType example, ExampleInfo& exampleInfo, RegularizerType& regularizer, SolutionType& w, SolutionType& v) const;
 
         std::shared_ptr<const DatasetType> _examples;
         LossFunctionType _lossFunction;
@@ -132,6 +156,11 @@ namespace optimization
         double _normalizedInverseLambda = 1.0;
         bool _permuteData = true;
         bool _isInitialized = false;
+
+        size_t _numThreads = 1;
+        size_t _miniBatchSize = 1024;
+        std::shared_ptr<utilities::ThreadPool> _threadPool;
+        std::vector<Worker> _workers;
     };
 
     /// <summary> Convenience function for constructing an SDCA optimizer. </summary>
@@ -198,9 +227,16 @@ namespace optimization
             }
 
             // process each example
-            for (size_t index : permutation)
+            if (_numThreads == 1)
             {
-                Step(_examples->Get(index), _exampleInfo[index]);
+                for (size_t index : permutation)
+                {
+                    Step(_examples->Get(index), _exampleInfo[index], _regularizer, _w, _v);
+                }
+            }
+            else
+            {
+                ParallelEpoch(permutation);
             }
 
             _areObjectivesValid = false;
@@ -236,6 +272,18 @@ namespace optimization
         _lambda = parameters.regularizationParameter;
         _normalizedInverseLambda = 1.0 / (_examples->Size() * parameters.regularizationParameter);
         _permuteData = parameters.permuteData;
+
+        if (parameters.miniBatchSize == 0)
+        {
+            throw OptimizationException("miniBatchSize must be positive");
+        }
+        _numThreads = parameters.numThreads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : parameters.numThreads;
+        _miniBatchSize = parameters.miniBatchSize;
+        if (_numThreads > 1 && (_threadPool == nullptr || _threadPool->NumThreads() + 1 != _numThreads))
+        {
+            // the calling thread works on the loop too
+            _threadPool = std::make_shared<utilities::ThreadPool>(_numThreads - 1);
+        }
     }
 
     template <typename SolutionType, typename LossFunctionType, typename RegularizerType>
@@ -328,7 +376,62 @@ namespace optimization
     }
 
     template <typename SolutionType, typename LossFunctionType, typename RegularizerType>
-    void SDCAOptimizer<SolutionType, LossFunctionType, RegularizerType>::Step(ExampleType example, ExampleInfo& exampleInfo)
+    void SDCAOptimizer<SolutionType, LossFunctionType, RegularizerType>::ParallelEpoch(const std::vector<size_t>& permutation)
+    {
+        if (_workers.size() != _numThreads)
+        {
+            _workers.assign(_numThreads, Worker{ _regularizer, _w, _v, {} });
+        }
+
+        const size_t numExamples = permutation.size();
+        for (size_t roundStart = 0; roundStart < numExamples; roundStart += _numThreads * _miniBatchSize)
+        {
+            size_t numActiveWorkers = std::min(_numThreads, (numExamples - roundStart + _miniBatchSize - 1) / _miniBatchSize);
+
+            // each worker runs SDCA on a private copy of the solution, starting from the shared one
+            _threadPool->ParallelFor(
+                numActiveWorkers,
+                [&](size_t workerIndex) {
+                    auto& worker = _workers[workerIndex];
+                    worker.regularizer = _regularizer;
+                    worker.w = _w;
+                    worker.v = _v;
+                    worker.exampleInfo.clear();
+
+                    auto begin = roundStart + workerIndex * _miniBatchSize;
+                    auto end = std::min(begin + _miniBatchSize, numExamples);
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        auto index = permutation[i];
+                        worker.exampleInfo.push_back(_exampleInfo[index]);
+                        Step(_examples->Get(index), worker.exampleInfo.back(), worker.regularizer, worker.w, worker.v);
+                    }
+                },
+                1);
+
+            // average the updates: v = mean of the workers' v, and each dual moves by 1/numActiveWorkers of its change
+            double scale = 1.0 / numActiveWorkers;
+            for (size_t workerIndex = 0; workerIndex < numActiveWorkers; ++workerIndex)
+            {
+                auto& worker = _workers[workerIndex];
+                _v = _v * (workerIndex == 0 ? 0.0 : 1.0) + worker.v * scale;
+
+                auto begin = roundStart + workerIndex * _miniBatchSize;
+                for (size_t i = 0; i < worker.exampleInfo.size(); ++i)
+                {
+                    auto& dual = _exampleInfo[permutation[begin + i]].dual;
+                    auto& newDual = worker.exampleInfo[i].dual;
+                    newDual -= dual;
+                    newDual *= scale;
+                    dual += newDual;
+                }
+            }
+            _regularizer.ConjugateGradient(_v, _w);
+        }
+    }
+
+    template <typename SolutionType, typename LossFunctionType, typename RegularizerType>
+    void SDCAOptimizer<SolutionType, LossFunctionType, RegularizerType>::Step(ExampleType example, ExampleInfo& exampleInfo, RegularizerType& regularizer, SolutionType& w, SolutionType& v) const
     {
         const double tolerance = 1.0e-8;
         auto lipschitz = exampleInfo.norm2Squared * _normalizedInverseLambda;
@@ -338,7 +441,7 @@ namespace optimization
         }
 
         // p = ((input * w) / lipschitz) + dual
-        auto prediction = example.input * _w; // ## perf: creates new vector
+        auto prediction = example.input * w; // ## perf: creates new vector
         prediction /= lipschitz;
         prediction += exampleInfo.dual;
 
@@ -349,10 +452,10 @@ namespace optimization
         exampleInfo.dual *= _normalizedInverseLambda;
 
         // _v' = _v + (input.T * dual'')
-        _v += Transpose(example.input) * exampleInfo.dual;
+        v += Transpose(example.input) * exampleInfo.dual;
 
-        // L2: _w = _v
-        _regularizer.ConjugateGradient(_v, _w); // ## perf: L2 regularizer implements this as "_w = _v" (a matrix and a vector copy)
+        // L2: w = v
+        regularizer.ConjugateGradient(v, w); // ## perf: L2 regularizer implements this as "_w = _v" (a matrix and a vector copy)
 
         // dual = dual'
         exampleInfo.dual = newDual; // ## perf: vector copy
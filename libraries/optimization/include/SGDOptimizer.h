@@ -9,12 +9,15 @@
 
 #include "Common.h"
 
+#include <utilities/include/ThreadPool.h>
+
 #include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <numeric>
 #include <random>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace ell
@@ -26,6 +29,16 @@ namespace optimization
     {
         double regularizationParameter;
         std::string randomSeedString = "abc123";
+
+        /// <summary>
+        /// The number of threads to use. If greater than one, the optimizer takes mini-batch steps: the threads
+        /// compute the loss gradients of `miniBatchSize` examples each at the current solution, and a single step
+        /// is taken along their average. If zero, uses the hardware concurrency of the machine.
+        /// </summary>
+        size_t numThreads = 1;
+
+        /// <summary> The number of examples each thread processes per step, when `numThreads` is not one. </summary>
+        size_t miniBatchSize = 16;
     };
 
     /// <summary> Stochastic gradient descent optimizer. </summary>
@@ -55,7 +68,15 @@ namespace optimization
         const SolutionType& GetSolution() const { return _averagedW; }
 
     private:
+        // per-thread state used by the parallel update
+        struct Worker
+        {
+            SolutionType w;
+            SolutionType gradient;
+        };
+
         void Step(ExampleType example);
+        void MiniBatchStep(const std::vector<size_t>& permutation, size_t begin);
 
         std::shared_ptr<const DatasetType> _examples;
         LossFunctionType _lossFunction;
@@ -64,6 +85,11 @@ namespace optimization
         SolutionType _averagedW;
         double _t = 0;
         double _lambda;
+
+        size_t _numThreads = 1;
+        size_t _miniBatchSize = 16;
+        std::shared_ptr<utilities::ThreadPool> _threadPool;
+        std::vector<Worker> _workers;
     };
 
     /// <summary> Convenience function for constructing an SGD optimizer. </summary>
@@ -109,6 +135,19 @@ namespace optimization
         auto example = examples->Get(0);
         _lastW.Resize(example.input, example.output);
         _averagedW.Resize(example.input, example.output);
+
+        if (parameters.miniBatchSize == 0)
+        {
+            throw OptimizationException("miniBatchSize must be positive");
+        }
+        _numThreads = parameters.numThreads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : parameters.numThreads;
+        _miniBatchSize = parameters.miniBatchSize;
+        if (_numThreads > 1)
+        {
+            // the calling thread works on the loop too
+            _threadPool = std::make_shared<utilities::ThreadPool>(_numThreads - 1);
+            _workers.resize(_numThreads, Worker{ _lastW, _lastW });
+        }
     }
 
     template <typename SolutionType, typename LossFunctionType>
@@ -124,9 +163,19 @@ namespace optimization
             std::shuffle(permutation.begin(), permutation.end(), _randomEngine);
 
             // process each example
-            for (size_t index : permutation)
+            if (_numThreads == 1)
+            {
+                for (size_t index : permutation)
+                {
+                    Step(_examples->Get(index));
+                }
+            }
+            else
             {
-                Step(_examples->Get(index));
+                for (size_t begin = 0; begin < permutation.size(); begin += _numThreads * _miniBatchSize)
+                {
+                    MiniBatchStep(permutation, begin);
+                }
             }
         }
     }
@@ -153,6 +202,44 @@ namespace optimization
         _averagedW = _averagedW * (1.0 - inverseT) + _lastW * inverseT;
     }
 
+    template <typename SolutionType, typename LossFunctionType>
+    void SGDOptimizer<SolutionType, LossFunctionType>::MiniBatchStep(const std::vector<size_t>& permutation, size_t begin)
+    {
+        const size_t end = std::min(begin + _numThreads * _miniBatchSize, permutation.size());
+        const size_t numActiveWorkers = (end - begin + _miniBatchSize - 1) / _miniBatchSize;
+
+        ++_t;
+
+        // each worker sums the weighted loss gradients of its examples, predicting with its own copy of the solution
+        _threadPool->ParallelFor(
+            numActiveWorkers,
+            [&](size_t workerIndex) {
+                auto& worker = _workers[workerIndex];
+                worker.w = _lastW;
+                worker.gradient.Reset();
+
+                auto workerBegin = begin + workerIndex * _miniBatchSize;
+                auto workerEnd = std::min(workerBegin + _miniBatchSize, end);
+                for (size_t i = workerBegin; i < workerEnd; ++i)
+                {
+                    auto example = _examples->Get(permutation[i]);
+                    auto derivative = _lossFunction.Derivative(example.input * worker.w, example.output);
+                    derivative *= example.weight;
+                    worker.gradient += Transpose(example.input) * derivative;
+                }
+            },
+            1);
+
+        // update the solution with the average gradient
+        double inverseT = 1.0 / _t;
+        double gradientScale = -1.0 / (_lambda * _t * (end - begin));
+        for (size_t workerIndex = 0; workerIndex < numActiveWorkers; ++workerIndex)
+        {
+            _lastW = _lastW * (workerIndex == 0 ? 1.0 - inverseT : 1.0) + _workers[workerIndex].gradient * gradientScale;
+        }
+        _averagedW = _averagedW * (1.0 - inverseT) + _lastW * inverseT;
+    }
+
     template <typename SolutionType, typename LossFunctionType>
     SGDOptimizer<SolutionType, LossFunctionType> MakeSGDOptimizer(std::shared_ptr<const typename SolutionType::DatasetType> examples, LossFunctionType lossFunction, SGDOptimizerParameters parameters)
     {
@@ -131,6 +131,12 @@ int main()
     TestSDCAClassificationConvergence(SquaredHingeLoss{}, MaxRegularizer{ 0 }, { .1, true }, 1.0e-4, 1.0, 1.0, 3.0);
     TestSDCAClassificationConvergence(SquaredHingeLoss{}, MaxRegularizer{ 2 }, { .1, true }, 1.0e-4, 1.0, 1.0, 3.0);
 
+    // Test convergence of parallel (mini-batch averaged) SDCA
+    TestSDCARegressionConvergence(SquareLoss{}, L2Regularizer{}, { .1, true, 4, 16 }, 1.0e-4, 1.0, 1.0, 1.0);
+    TestSDCARegressionConvergence(SquareLoss{}, ElasticNetRegularizer{ .5 }, { .1, true, 4, 16 }, 1.0e-4, 1.0, 1.0, 1.0);
+    TestSDCAClassificationConvergence(LogisticLoss{}, L2Regularizer{}, { .1, true, 4, 16 }, 1.0e-4, 1.0, 1.0, 3.0);
+    TestSDCAClassificationConvergence(SmoothedHingeLoss{}, MaxRegularizer{ 20 }, { .01, true, 3, 7 }, 1.0e-4, 1.0, 1.0, 3.0);
+
     // SDCA Reset
     TestSDCAReset(SquaredHingeLoss{}, L2Regularizer{});
     TestGetSparseSolution(SmoothedHingeLoss{}, 0.01);
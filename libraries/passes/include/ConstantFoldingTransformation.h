@@ -0,0 +1,53 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ConstantFoldingTransformation.h (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <model/include/Transformation.h>
+
+#include <string>
+
+namespace ell
+{
+namespace passes
+{
+    /// <summary>
+    /// A transformation that precomputes the parts of a model whose inputs are all constant. Each node whose inputs
+    /// all come from `ConstantNode`s (or from nodes folded earlier in the same pass) is evaluated once with
+    /// `Node::Compute`, and is replaced by `ConstantNode`s holding its outputs. Nodes that keep state between calls or
+    /// interact with the outside world (sources, sinks, delays, recurrent nodes, ...) are never folded, and neither are
+    /// nodes built with the value library, which can only compute inside an emitter context.
+    /// </summary>
+    class ConstantFoldingTransformation : public model::Transformation
+    {
+    public:
+        /// <summary> Replaces constant subgraphs of a submodel with `ConstantNode`s. </summary>
+        model::Submodel Transform(const model::Submodel& submodel, model::ModelTransformer& transformer, const model::TransformContext& context) const override;
+
+        /// <summary> Returns the ID for this transformation </summary>
+        std::string GetRuntimeTypeName() const override { return { "ConstantFoldingTransformation" }; };
+    };
+
+    /// <summary>
+    /// A transformation that removes nodes nothing depends on. If the submodel lists its outputs, only the nodes those
+    /// outputs depend on are kept. Otherwise, every node without dependents is assumed to be observable (for instance,
+    /// as a map output), except for unused `ConstantNode`s and `NullNode`s, such as the constants left behind by
+    /// `ConstantFoldingTransformation`. A submodel without inputs is copied into a new model, so the removed nodes are
+    /// dropped rather than left in place. `Map::Prune` remains the way to remove everything the map's outputs don't need.
+    /// </summary>
+    class DeadNodeEliminationTransformation : public model::Transformation
+    {
+    public:
+        /// <summary> Removes dead nodes from a submodel. </summary>
+        model::Submodel Transform(const model::Submodel& submodel, model::ModelTransformer& transformer, const model::TransformContext& context) const override;
+
+        /// <summary> Returns the ID for this transformation </summary>
+        std::string GetRuntimeTypeName() const override { return { "DeadNodeEliminationTransformation" }; };
+    };
+} // namespace passes
+} // namespace ell
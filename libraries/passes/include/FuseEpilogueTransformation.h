@@ -0,0 +1,38 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FuseEpilogueTransformation.h (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <model/include/Transformation.h>
+
+#include <string>
+
+namespace ell
+{
+namespace passes
+{
+    /// <summary>
+    /// A transformation that folds the elementwise operations following a convolution or matrix multiplication into
+    /// the producing node's output epilogue, so they are applied while its output is still in registers or cache
+    /// instead of in separate passes over the output. Per-channel `BroadcastLinearFunctionNode`s (from bias and batch
+    /// normalization layers) and activation `BroadcastUnaryFunctionNode`s are fused into `MatrixMatrixMultiplyCodeNode`s
+    /// (which unrolled convolutions refine to) and `SpatialConvolutionNode`s. An operation is only fused if it is the
+    /// only consumer of the producing node, the data is laid out without padding, and the producer doesn't already end
+    /// with an activation.
+    /// </summary>
+    class FuseEpilogueTransformation : public model::Transformation
+    {
+    public:
+        /// <summary> Fuses elementwise operations into the preceding convolution and matrix multiplication nodes. </summary>
+        model::Submodel Transform(const model::Submodel& submodel, model::ModelTransformer& transformer, const model::TransformContext& context) const override;
+
+        /// <summary> Returns the ID for this transformation </summary>
+        std::string GetRuntimeTypeName() const override { return { "FuseEpilogueTransformation" }; };
+    };
+} // namespace passes
+} // namespace ell
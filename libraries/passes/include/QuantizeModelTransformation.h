@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     QuantizeModelTransformation.h (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <model/include/Map.h>
+#include <model/include/Transformation.h>
+
+#include <data/include/DenseDataVector.h>
+
+#include <utilities/include/UniqueId.h>
+
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <unordered_map>
+
+namespace ell
+{
+namespace passes
+{
+    /// <summary> The range of values an activation took while running calibration data through a model. </summary>
+    struct ActivationRange
+    {
+        double minimum = std::numeric_limits<double>::infinity();
+        double maximum = -std::numeric_limits<double>::infinity();
+
+        /// <summary> Extends the range to include a value. </summary>
+        void Add(double value);
+
+        /// <summary> Returns the largest absolute value in the range, or zero if the range is empty. </summary>
+        double GetMaxAbsoluteValue() const;
+    };
+
+    /// <summary> Activation ranges, keyed by the id of the matrix multiplication node that consumes the activation. </summary>
+    using ActivationRanges = std::unordered_map<utilities::UniqueId, ActivationRange>;
+
+    /// <summary>
+    /// Returns true if a node can be quantized by `QuantizeModelTransformation`: a `MatrixMatrixMultiplyNode`,
+    /// `MatrixMatrixMultiplyCodeNode`, or `MatrixVectorMultiplyNode` whose left-hand input is a `ConstantNode`.
+    /// </summary>
+    bool IsQuantizableNode(const model::Node& node);
+
+    /// <summary>
+    /// Extends the activation ranges with the values currently held by the activation inputs of the quantizable
+    /// nodes in a map. Call this after computing the map on a calibration example.
+    /// </summary>
+    ///
+    /// <param name="map"> The map. </param>
+    /// <param name="ranges"> The activation ranges to update. </param>
+    void UpdateActivationRanges(const model::Map& map, ActivationRanges& ranges);
+
+    /// <summary>
+    /// Runs a calibration dataset through a map with `Map::Compute` and records the range of the activations
+    /// that feed each quantizable node. The map should be refined first, so that convolutional and
+    /// fully-connected layers have been lowered to matrix multiplications. The returned ranges refer to the
+    /// nodes of this map, so it must be the map that is then transformed with `QuantizeModelTransformation`.
+    /// </summary>
+    ///
+    /// <typeparam name="DatasetType"> The dataset type. </typeparam>
+    /// <param name="map"> The refined map. </param>
+    /// <param name="dataset"> The calibration data. </param>
+    /// <param name="maxExamples"> The maximum number of examples to use, or zero to use them all. </param>
+    ///
+    /// <returns> The activation ranges. </returns>
+    template <typename DatasetType>
+    ActivationRanges CollectActivationRanges(model::Map& map, const DatasetType& dataset, size_t maxExamples = 0);
+
+    /// <summary>
+    /// A post-training quantization transformation. Each quantizable node that has a calibrated activation range
+    /// is replaced with a `QuantizedMatrixMatrixMultiplyNode`: the constant weights are quantized to 8 bits with
+    /// one symmetric scale per output row (channel), the activations are quantized with a single scale derived
+    /// from their calibrated range, and products are accumulated in 32 bits. Other nodes are copied unchanged.
+    /// </summary>
+    class QuantizeModelTransformation : public model::Transformation
+    {
+    public:
+        /// <summary> Constructor. </summary>
+        ///
+        /// <param name="ranges"> The calibrated activation ranges, from `CollectActivationRanges`. </param>
+        explicit QuantizeModelTransformation(ActivationRanges ranges);
+
+        /// <summary> Replaces calibrated matrix multiplication nodes with quantized versions. </summary>
+        model::Submodel Transform(const model::Submodel& submodel, model::ModelTransformer& transformer, const model::TransformContext& context) const override;
+
+        /// <summary> Returns the ID for this transformation </summary>
+        std::string GetRuntimeTypeName() const override { return { "QuantizeModelTransformation" }; };
+
+    private:
+        ActivationRanges _ranges;
+    };
+
+    /// <summary>
+    /// Quantizes a map in place: refines it, collects activation ranges by running the calibration data through it,
+    /// and applies `QuantizeModelTransformation`.
+    /// </summary>
+    ///
+    /// <typeparam name="DatasetType"> The dataset type. </typeparam>
+    /// <param name="map"> The map to quantize. </param>
+    /// <param name="dataset"> The calibration data. </param>
+    /// <param name="maxExamples"> The maximum number of examples to use, or zero to use them all. </param>
+    template <typename DatasetType>
+    void QuantizeMap(model::Map& map, const DatasetType& dataset, size_t maxExamples = 0);
+} // namespace passes
+} // namespace ell
+
+#pragma region implementation
+
+namespace ell
+{
+namespace passes
+{
+    template <typename DatasetType>
+    ActivationRanges CollectActivationRanges(model::Map& map, const DatasetType& dataset, size_t maxExamples)
+    {
+        ActivationRanges ranges;
+        auto numExamples = dataset.NumExamples();
+        if (maxExamples != 0 && maxExamples < numExamples)
+        {
+            numExamples = maxExamples;
+        }
+
+        for (size_t index = 0; index < numExamples; ++index)
+        {
+            map.Compute<data::DoubleDataVector>(dataset.GetExample(index).GetDataVector());
+            UpdateActivationRanges(map, ranges);
+        }
+        return ranges;
+    }
+
+    template <typename DatasetType>
+    void QuantizeMap(model::Map& map, const DatasetType& dataset, size_t maxExamples)
+    {
+        map.Refine();
+        QuantizeModelTransformation transformation(CollectActivationRanges(map, dataset, maxExamples));
+        map.Transform(transformation);
+    }
+} // namespace passes
+} // namespace ell
+
+#pragma endregion implementation
@@ -0,0 +1,62 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ScheduleTuner.h (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <model/include/Map.h>
+#include <model/include/MapCompilerOptions.h>
+#include <model/include/TuningCache.h>
+
+#include <nodes/include/MatrixMatrixMultiplyCodeNode.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace ell
+{
+namespace passes
+{
+    /// <summary> Options that control how candidate schedules are measured. </summary>
+    struct ScheduleTunerOptions
+    {
+        /// <summary> The number of timed runs of each candidate. The fastest run is used. </summary>
+        int numIterations = 10;
+    };
+
+    /// <summary>
+    /// Finds the fastest tile sizes for a matrix multiplication by JIT-compiling a copy of a
+    /// `MatrixMatrixMultiplyCodeNode` (same shape, strides and transposes) with each candidate tiling and timing
+    /// the compiled code.
+    /// </summary>
+    ///
+    /// <typeparam name="ValueType"> The element type of the matrices. </typeparam>
+    /// <param name="node"> The node to tune. </param>
+    /// <param name="compilerOptions"> The options to compile the candidates with. Their target device is the one being tuned for. </param>
+    /// <param name="options"> The tuner options. </param>
+    ///
+    /// <returns> The tile sizes, in the order used by `MatrixMatrixMultiplyCodeNode::GetTileSizes`. </returns>
+    template <typename ValueType>
+    std::vector<int> TuneMatrixMatrixMultiply(const nodes::MatrixMatrixMultiplyCodeNode<ValueType>& node, const model::MapCompilerOptions& compilerOptions, const ScheduleTunerOptions& options = {});
+
+    /// <summary>
+    /// Tunes the schedules of the nodes in a map that the map compiler is allowed to choose a schedule for:
+    /// `MatrixMatrixMultiplyCodeNode` nodes with automatic tile sizes (including the ones that convolutions
+    /// are refined into) and `SpatialConvolutionNode` nodes without a column tile. Nodes whose shape already has
+    /// an entry in the cache are skipped. Compiling the map with `MapCompilerOptions::tuningCachePath` set to the
+    /// saved cache then uses the tuned schedules.
+    /// </summary>
+    ///
+    /// <param name="map"> The map to tune. It isn't modified. </param>
+    /// <param name="compilerOptions"> The options to compile the candidates with. Their target device is the one being tuned for. </param>
+    /// <param name="cache"> The tuning cache to add the tuned schedules to. </param>
+    /// <param name="options"> The tuner options. </param>
+    ///
+    /// <returns> The number of entries added to the cache. </returns>
+    size_t TuneSchedules(const model::Map& map, const model::MapCompilerOptions& compilerOptions, model::TuningCache& cache, const ScheduleTunerOptions& options = {});
+} // namespace passes
+} // namespace ell
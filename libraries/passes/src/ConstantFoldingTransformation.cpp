@@ -0,0 +1,201 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ConstantFoldingTransformation.cpp (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ConstantFoldingTransformation.h"
+
+#include <model/include/CompilableCodeNode.h>
+#include <model/include/MapCompiler.h>
+#include <model/include/ModelTransformer.h>
+#include <model/include/OutputNodeBase.h>
+
+#include <nodes/include/ConstantNode.h>
+
+#include <utilities/include/Exception.h>
+#include <utilities/include/Logger.h>
+#include <utilities/include/StlVectorUtil.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace ell
+{
+namespace passes
+{
+    using namespace model;
+    using namespace utilities::logging;
+
+    namespace
+    {
+        bool HasTypeNamePrefix(const Node& node, const std::string& prefix)
+        {
+            return node.GetRuntimeTypeName().find(prefix) == 0;
+        }
+
+        bool IsConstantNode(const Node& node)
+        {
+            return HasTypeNamePrefix(node, "ConstantNode");
+        }
+
+        bool IsUnusedPlaceholderNode(const Node& node)
+        {
+            return node.GetDependentNodes().empty() && (IsConstantNode(node) || HasTypeNamePrefix(node, "NullNode"));
+        }
+
+        bool IsOptimizationEnabled(const Node& node, const TransformContext& context, const std::string& optionName)
+        {
+            const MapCompiler* compiler = context.GetCompiler();
+            return compiler == nullptr || compiler->GetModelOptimizerOptions(node).GetEntry<bool>(optionName, true);
+        }
+
+        bool CanFoldNodeType(const Node& node)
+        {
+            if (node.GetInputPorts().empty() || IsConstantNode(node))
+            {
+                return false;
+            }
+
+            // Nodes built with the value library compute through the active emitter context, which is the compiler's
+            // during compilation
+            if (dynamic_cast<const CompilableCodeNode*>(&node) != nullptr)
+            {
+                return false;
+            }
+
+            for (auto port : node.GetOutputPorts())
+            {
+                auto type = port->GetType();
+                if (type != Port::PortType::smallReal && type != Port::PortType::real && type != Port::PortType::integer && type != Port::PortType::bigInt)
+                {
+                    return false;
+                }
+            }
+
+            // Output nodes are the map's interface. Nodes that keep state between calls or interact with the outside
+            // world are never folded, even if all of their inputs are constant.
+            return dynamic_cast<const OutputNodeBase*>(&node) == nullptr && !node.IsStateful();
+        }
+
+        template <typename ValueType>
+        void AddConstantOutput(const OutputPortBase& port, ModelTransformer& transformer)
+        {
+            const auto& typedPort = static_cast<const OutputPort<ValueType>&>(port);
+            auto newNode = transformer.AddNode<nodes::ConstantNode<ValueType>>(typedPort.GetOutput(), typedPort.GetMemoryLayout());
+            transformer.MapNodeOutput(typedPort, newNode->output);
+        }
+
+        void AddConstantOutput(const OutputPortBase& port, ModelTransformer& transformer)
+        {
+            switch (port.GetType())
+            {
+            case Port::PortType::smallReal:
+                AddConstantOutput<float>(port, transformer);
+                break;
+            case Port::PortType::real:
+                AddConstantOutput<double>(port, transformer);
+                break;
+            case Port::PortType::integer:
+                AddConstantOutput<int>(port, transformer);
+                break;
+            case Port::PortType::bigInt:
+                AddConstantOutput<int64_t>(port, transformer);
+                break;
+            default:
+                throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch, "Can't fold a node with this output port type");
+            }
+        }
+
+        std::vector<const OutputPortBase*> GetReferencedPorts(const std::vector<const InputPortBase*>& inputs)
+        {
+            return utilities::TransformVector(inputs.begin(), inputs.end(), [](auto input) { return &input->GetReferencedPort(); });
+        }
+
+        // A submodel without inputs is transformed into a new model, so the nodes a pass replaces or skips are dropped
+        // instead of being left behind in the original model
+        Submodel TransformSubmodel(const Submodel& submodel, ModelTransformer& transformer, const TransformContext& context, const ModelTransformer::NodeTransformFunction& transformFunction)
+        {
+            auto onto = GetReferencedPorts(submodel.GetInputs());
+            if (onto.empty())
+            {
+                Model destModel;
+                return transformer.TransformSubmodelOnto(submodel, destModel, onto, context, transformFunction);
+            }
+
+            auto destModel = submodel.GetModel().ShallowCopy();
+            return transformer.TransformSubmodelOnto(submodel, destModel, onto, context, transformFunction);
+        }
+    } // namespace
+
+    //
+    // ConstantFoldingTransformation
+    //
+    Submodel ConstantFoldingTransformation::Transform(const Submodel& submodel, ModelTransformer& transformer, const TransformContext& context) const
+    {
+        // The nodes of the source model whose output values have been computed by this pass
+        std::unordered_set<const Node*> constantNodes;
+        return TransformSubmodel(submodel, transformer, context, [&constantNodes, context](const Node& node, ModelTransformer& transformer) {
+            if (IsConstantNode(node))
+            {
+                node.Compute();
+                constantNodes.insert(&node);
+                transformer.CopyNode(node);
+                return;
+            }
+
+            const auto& inputs = node.GetInputPorts();
+            bool hasConstantInputs = std::all_of(inputs.begin(), inputs.end(), [&constantNodes](const InputPortBase* input) {
+                return constantNodes.find(input->GetReferencedPort().GetNode()) != constantNodes.end();
+            });
+            if (!hasConstantInputs || !CanFoldNodeType(node) || !IsOptimizationEnabled(node, context, "foldConstants"))
+            {
+                transformer.CopyNode(node);
+                return;
+            }
+
+            try
+            {
+                node.Compute();
+            }
+            catch (const std::exception&)
+            {
+                // Some nodes can only be compiled
+                transformer.CopyNode(node);
+                return;
+            }
+
+            for (auto output : node.GetOutputPorts())
+            {
+                AddConstantOutput(*output, transformer);
+            }
+            constantNodes.insert(&node);
+            Log() << "Folded constant node " << node.GetRuntimeTypeName() << " [id = " << node.GetId().ToString() << "]" << EOL;
+        });
+    }
+
+    //
+    // DeadNodeEliminationTransformation
+    //
+    Submodel DeadNodeEliminationTransformation::Transform(const Submodel& submodel, ModelTransformer& transformer, const TransformContext& context) const
+    {
+        // A submodel with outputs only visits the nodes they depend on
+        const bool hasOutputs = !submodel.GetOutputs().empty();
+        return TransformSubmodel(submodel, transformer, context, [hasOutputs, context](const Node& node, ModelTransformer& transformer) {
+            if (!hasOutputs && IsUnusedPlaceholderNode(node) && IsOptimizationEnabled(node, context, "eliminateDeadNodes"))
+            {
+                Log() << "Removed unused node " << node.GetRuntimeTypeName() << " [id = " << node.GetId().ToString() << "]" << EOL;
+                return;
+            }
+
+            transformer.CopyNode(node);
+        });
+    }
+} // namespace passes
+} // namespace ell
@@ -0,0 +1,347 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FuseEpilogueTransformation.cpp (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "FuseEpilogueTransformation.h"
+
+#include <model/include/MapCompiler.h>
+#include <model/include/ModelTransformer.h>
+
+#include <nodes/include/ActivationFunctions.h>
+#include <nodes/include/BroadcastFunctionNode.h>
+#include <nodes/include/ConstantNode.h>
+#include <nodes/include/MatrixMatrixMultiplyCodeNode.h>
+#include <nodes/include/OutputEpilogue.h>
+#include <nodes/include/SpatialConvolutionNode.h>
+
+#include <predictors/neural/include/HardSigmoidActivation.h>
+#include <predictors/neural/include/HardTanhActivation.h>
+#include <predictors/neural/include/LeakyReLUActivation.h>
+#include <predictors/neural/include/ReLUActivation.h>
+#include <predictors/neural/include/SigmoidActivation.h>
+#include <predictors/neural/include/TanhActivation.h>
+
+#include <utilities/include/Logger.h>
+#include <utilities/include/StlVectorUtil.h>
+
+#include <optional>
+#include <vector>
+
+namespace ell
+{
+namespace passes
+{
+    using namespace model;
+    using namespace utilities::logging;
+
+    namespace
+    {
+        std::vector<const OutputPortBase*> GetReferencedPorts(const std::vector<const InputPortBase*>& inputs)
+        {
+            return utilities::TransformVector(inputs.begin(), inputs.end(), [](auto input) { return &input->GetReferencedPort(); });
+        }
+
+        // An elementwise operation that can be appended to an epilogue: either a per-channel linear function or an activation
+        template <typename ValueType>
+        struct EpilogueOperation
+        {
+            using ActivationType = predictors::neural::Activation<ValueType>;
+
+            const InputPort<ValueType>* input;
+            const OutputPort<ValueType>* output;
+            PortMemoryLayout layout;
+            std::optional<int> channelDimension; // only set for per-channel operations
+            std::vector<ValueType> scale;
+            std::vector<ValueType> bias;
+            std::optional<ActivationType> activation;
+        };
+
+        template <typename ValueType>
+        std::optional<std::vector<ValueType>> GetConstantValues(const InputPort<ValueType>& input)
+        {
+            if (input.Size() == 0)
+            {
+                return std::vector<ValueType>{};
+            }
+
+            auto constantNode = dynamic_cast<const nodes::ConstantNode<ValueType>*>(input.GetReferencedPort().GetNode());
+            if (constantNode == nullptr)
+            {
+                return std::nullopt;
+            }
+            return constantNode->GetValues();
+        }
+
+        template <typename ValueType>
+        predictors::neural::Activation<ValueType> MakeActivation(const nodes::ReLUActivationFunction<ValueType>&)
+        {
+            return { new predictors::neural::ReLUActivation<ValueType>() };
+        }
+
+        template <typename ValueType>
+        predictors::neural::Activation<ValueType> MakeActivation(const nodes::LeakyReLUActivationFunction<ValueType>& function)
+        {
+            return { new predictors::neural::LeakyReLUActivation<ValueType>(function.GetLeakyFactor()) };
+        }
+
+        template <typename ValueType>
+        predictors::neural::Activation<ValueType> MakeActivation(const nodes::SigmoidActivationFunction<ValueType>&)
+        {
+            return { new predictors::neural::SigmoidActivation<ValueType>() };
+        }
+
+        template <typename ValueType>
+        predictors::neural::Activation<ValueType> MakeActivation(const nodes::HardSigmoidActivationFunction<ValueType>&)
+        {
+            return { new predictors::neural::HardSigmoidActivation<ValueType>() };
+        }
+
+        template <typename ValueType>
+        predictors::neural::Activation<ValueType> MakeActivation(const nodes::TanhActivationFunction<ValueType>&)
+        {
+            return { new predictors::neural::TanhActivation<ValueType>() };
+        }
+
+        template <typename ValueType>
+        predictors::neural::Activation<ValueType> MakeActivation(const nodes::HardTanhActivationFunction<ValueType>&)
+        {
+            return { new predictors::neural::HardTanhActivation<ValueType>() };
+        }
+
+        template <typename ValueType>
+        std::optional<EpilogueOperation<ValueType>> GetLinearOperation(const Node& node)
+        {
+            auto linearNode = dynamic_cast<const nodes::BroadcastLinearFunctionNode<ValueType>*>(&node);
+            if (linearNode == nullptr)
+            {
+                return std::nullopt;
+            }
+
+            auto scale = GetConstantValues(linearNode->secondaryInput1);
+            auto bias = GetConstantValues(linearNode->secondaryInput2);
+            if (!scale || !bias || !(linearNode->GetInputMemoryLayout() == linearNode->GetOutputMemoryLayout()))
+            {
+                return std::nullopt;
+            }
+
+            EpilogueOperation<ValueType> operation{ &linearNode->primaryInput, &linearNode->output, linearNode->GetInputMemoryLayout() };
+            operation.channelDimension = static_cast<int>(linearNode->GetBroadcastDimension());
+            operation.scale = *scale;
+            operation.bias = *bias;
+            return operation;
+        }
+
+        template <typename ValueType, typename ActivationFunctionType>
+        std::optional<EpilogueOperation<ValueType>> GetActivationOperation(const Node& node)
+        {
+            auto activationNode = dynamic_cast<const nodes::BroadcastUnaryFunctionNode<ValueType, ActivationFunctionType>*>(&node);
+            if (activationNode == nullptr || !(activationNode->GetInputMemoryLayout() == activationNode->GetOutputMemoryLayout()))
+            {
+                return std::nullopt;
+            }
+
+            EpilogueOperation<ValueType> operation{ &activationNode->primaryInput, &activationNode->output, activationNode->GetInputMemoryLayout() };
+            operation.activation = MakeActivation(activationNode->GetFunction());
+            return operation;
+        }
+
+        template <typename ValueType>
+        std::optional<EpilogueOperation<ValueType>> GetEpilogueOperation(const Node& node)
+        {
+            if (auto operation = GetLinearOperation<ValueType>(node))
+            {
+                return operation;
+            }
+            if (auto operation = GetActivationOperation<ValueType, nodes::ReLUActivationFunction<ValueType>>(node))
+            {
+                return operation;
+            }
+            if (auto operation = GetActivationOperation<ValueType, nodes::LeakyReLUActivationFunction<ValueType>>(node))
+            {
+                return operation;
+            }
+            if (auto operation = GetActivationOperation<ValueType, nodes::SigmoidActivationFunction<ValueType>>(node))
+            {
+                return operation;
+            }
+            if (auto operation = GetActivationOperation<ValueType, nodes::HardSigmoidActivationFunction<ValueType>>(node))
+            {
+                return operation;
+            }
+            if (auto operation = GetActivationOperation<ValueType, nodes::TanhActivationFunction<ValueType>>(node))
+            {
+                return operation;
+            }
+            return GetActivationOperation<ValueType, nodes::HardTanhActivationFunction<ValueType>>(node);
+        }
+
+        // Returns the epilogue with the operation appended, or nothing if it can't be appended
+        template <typename ValueType>
+        std::optional<nodes::OutputEpilogue<ValueType>> AppendOperation(const nodes::OutputEpilogue<ValueType>& epilogue, const EpilogueOperation<ValueType>& operation, int numChannels, int channelDimension)
+        {
+            if (epilogue.HasActivation())
+            {
+                return std::nullopt;
+            }
+
+            if (operation.channelDimension && *operation.channelDimension != channelDimension)
+            {
+                return std::nullopt;
+            }
+
+            auto isValidSize = [numChannels](const std::vector<ValueType>& values) {
+                return values.empty() || static_cast<int>(values.size()) == numChannels;
+            };
+            if (!isValidSize(operation.scale) || !isValidSize(operation.bias))
+            {
+                return std::nullopt;
+            }
+
+            auto result = epilogue;
+            result.AppendLinearFunction(operation.scale, operation.bias);
+            if (operation.activation)
+            {
+                result.AppendActivation(*operation.activation);
+            }
+            return result;
+        }
+
+        template <typename ValueType>
+        const Node* TryFuseIntoMatrixMultiply(const EpilogueOperation<ValueType>& operation, const OutputPort<ValueType>& producerOutput, ModelTransformer& transformer)
+        {
+            auto producer = dynamic_cast<const nodes::MatrixMatrixMultiplyCodeNode<ValueType>*>(producerOutput.GetNode());
+            if (producer == nullptr)
+            {
+                return nullptr;
+            }
+
+            // The rows of the product are the channels: the last dimension of a column-major (transposed) output, or the first
+            // dimension of a row-major one
+            const auto m = producer->GetM();
+            const auto n = producer->GetN();
+            const auto& layout = operation.layout;
+            if (layout.HasPadding() || !layout.IsCanonicalOrder() || static_cast<int>(layout.NumElements()) != m * n)
+            {
+                return nullptr;
+            }
+            const auto channelDimension = producer->IsOutputTransposed() ? layout.NumDimensions() - 1 : 0;
+            const auto outputStride = producer->IsOutputTransposed() ? m : n;
+            if (producer->GetOutputMatrixStride() != outputStride || layout.GetActiveSize(channelDimension) != m)
+            {
+                return nullptr;
+            }
+
+            auto epilogue = AppendOperation(producer->GetEpilogue(), operation, m, channelDimension);
+            if (!epilogue)
+            {
+                return nullptr;
+            }
+
+            auto tileSizes = producer->GetTileSizes();
+            auto newNode = transformer.AddNode<nodes::MatrixMatrixMultiplyCodeNode<ValueType>>(producer->input1.GetReferencedPort(), m, n, producer->GetK(), producer->GetMatrix1Stride(), producer->IsMatrix1Transposed(), producer->input2.GetReferencedPort(), producer->GetMatrix2Stride(), producer->IsMatrix2Transposed(), producer->GetOutputMatrixStride(), producer->IsOutputTransposed(), tileSizes[0], tileSizes[1], tileSizes[2], tileSizes[3], tileSizes[4], tileSizes[5], producer->GetImplementation(), *epilogue);
+            transformer.MapNodeOutput(*operation.output, newNode->output);
+            return newNode;
+        }
+
+        template <typename ValueType>
+        const Node* TryFuseIntoSpatialConvolution(const EpilogueOperation<ValueType>& operation, const OutputPort<ValueType>& producerOutput, ModelTransformer& transformer)
+        {
+            auto producer = dynamic_cast<const nodes::SpatialConvolutionNode<ValueType>*>(producerOutput.GetNode());
+            if (producer == nullptr)
+            {
+                return nullptr;
+            }
+
+            // The epilogue is applied to the active area of the output, so the padding would be left unchanged
+            const auto& outputLayout = producer->output.GetMemoryLayout();
+            if (!(operation.layout == outputLayout) || outputLayout.HasPadding())
+            {
+                return nullptr;
+            }
+
+            const int channelDimension = 2;
+            auto epilogue = AppendOperation(producer->GetEpilogue(), operation, outputLayout.GetLogicalDimensionActiveSize(channelDimension), channelDimension);
+            if (!epilogue)
+            {
+                return nullptr;
+            }
+
+            auto newNode = transformer.AddNode<nodes::SpatialConvolutionNode<ValueType>>(producer->input.GetReferencedPort(), producer->GetLayer(), outputLayout, producer->GetColumnTile(), *epilogue);
+            transformer.MapNodeOutput(*operation.output, newNode->output);
+            return newNode;
+        }
+
+        // returns 'true' if we handled the node, else 'false'. If we return 'false', keep trying other ValueTypes.
+        template <typename ValueType>
+        bool TryFuseEpilogue(const Node& node, ModelTransformer& transformer)
+        {
+            auto operation = GetEpilogueOperation<ValueType>(node);
+            if (!operation)
+            {
+                return false;
+            }
+
+            // If something else reads the producer's output, fusing would compute the producer twice
+            const auto& producerOutput = operation->input->GetReferencedPort();
+            if (producerOutput.GetNode()->GetDependentNodes().size() != 1)
+            {
+                return false;
+            }
+
+            // The producer in the new model, which may already have other operations fused into it
+            const auto& newProducerOutput = transformer.GetCorrespondingInputs(*operation->input);
+            auto newNode = TryFuseIntoMatrixMultiply(*operation, newProducerOutput, transformer);
+            if (newNode == nullptr)
+            {
+                newNode = TryFuseIntoSpatialConvolution(*operation, newProducerOutput, transformer);
+            }
+            if (newNode == nullptr)
+            {
+                return false;
+            }
+
+            Log() << "Fused " << node.GetRuntimeTypeName() << " into the epilogue of " << newNode->GetRuntimeTypeName() << EOL;
+            return true;
+        }
+
+        void FuseEpilogue(const Node& node, ModelTransformer& transformer)
+        {
+            if (TryFuseEpilogue<float>(node, transformer))
+            {
+                return;
+            }
+            if (TryFuseEpilogue<double>(node, transformer))
+            {
+                return;
+            }
+            transformer.CopyNode(node);
+        }
+    } // namespace
+
+    Submodel FuseEpilogueTransformation::Transform(const Submodel& submodel, ModelTransformer& transformer, const TransformContext& context) const
+    {
+        auto compiler = context.GetCompiler();
+        if (!compiler)
+        {
+            return submodel;
+        }
+
+        auto onto = GetReferencedPorts(submodel.GetInputs());
+        auto destModel = submodel.GetModel().ShallowCopy();
+        return transformer.TransformSubmodelOnto(submodel, destModel, onto, context, [compiler](const Node& node, ModelTransformer& transformer) {
+            if (compiler->GetModelOptimizerOptions(node).GetEntry<bool>("fuseEpilogueOperations", true))
+            {
+                FuseEpilogue(node, transformer);
+            }
+            else
+            {
+                transformer.CopyNode(node);
+            }
+        });
+    }
+} // namespace passes
+} // namespace ell
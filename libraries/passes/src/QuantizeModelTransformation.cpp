@@ -0,0 +1,260 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     QuantizeModelTransformation.cpp (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "QuantizeModelTransformation.h"
+
+#include <model/include/ModelTransformer.h>
+
+#include <nodes/include/ConstantNode.h>
+#include <nodes/include/MatrixMatrixMultiplyCodeNode.h>
+#include <nodes/include/MatrixMatrixMultiplyNode.h>
+#include <nodes/include/MatrixVectorMultiplyNode.h>
+#include <nodes/include/QuantizedMatrixMatrixMultiplyNode.h>
+
+#include <utilities/include/Logger.h>
+#include <utilities/include/StlVectorUtil.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace ell
+{
+namespace passes
+{
+    using namespace model;
+    using namespace utilities::logging;
+    using utilities::logging::Log;
+
+    namespace
+    {
+        // symmetric 8-bit quantization: values are mapped to [-127, 127] so that zero is exact
+        constexpr double maxQuantizedValue = 127.0;
+
+        std::vector<const OutputPortBase*> GetReferencedPorts(const std::vector<const InputPortBase*>& inputs)
+        {
+            return utilities::TransformVector(inputs.begin(), inputs.end(), [](auto input) { return &input->GetReferencedPort(); });
+        }
+
+        double GetQuantizationScale(double maxAbsoluteValue)
+        {
+            return maxAbsoluteValue > 0 ? maxAbsoluteValue / maxQuantizedValue : 1.0;
+        }
+
+        int8_t Quantize(double value, double scale)
+        {
+            auto quantized = std::round(value / scale);
+            return static_cast<int8_t>(std::max(-maxQuantizedValue, std::min(maxQuantizedValue, quantized)));
+        }
+
+        // The parts of a matrix multiplication that quantization cares about, in the form
+        // output (m x n) = weights (m x k, a constant) * activations (k x n)
+        template <typename ValueType>
+        struct MatrixMultiplyInfo
+        {
+            const nodes::ConstantNode<ValueType>* weights;
+            const InputPort<ValueType>* activations;
+            const OutputPort<ValueType>* output;
+            int m;
+            int n;
+            int k;
+            int lda;
+            bool transposeWeights;
+            bool transposeOutput;
+        };
+
+        template <typename ValueType>
+        const nodes::ConstantNode<ValueType>* GetConstantInput(const InputPort<ValueType>& input)
+        {
+            return dynamic_cast<const nodes::ConstantNode<ValueType>*>(input.GetReferencedPort().GetNode());
+        }
+
+        template <typename ValueType, typename NodeType>
+        std::optional<MatrixMultiplyInfo<ValueType>> GetMatrixMatrixMultiplyInfo(const NodeType& node)
+        {
+            // The quantized node reads its input as a dense, row-major k x n matrix
+            auto outputStride = node.IsOutputTransposed() ? node.GetM() : node.GetN();
+            if (node.IsMatrix2Transposed() || node.GetMatrix2Stride() != node.GetN() || node.GetOutputMatrixStride() != outputStride)
+            {
+                return std::nullopt;
+            }
+
+            auto weights = GetConstantInput(node.input1);
+            if (weights == nullptr)
+            {
+                return std::nullopt;
+            }
+
+            return MatrixMultiplyInfo<ValueType>{ weights, &node.input2, &node.output, node.GetM(), node.GetN(), node.GetK(), node.GetMatrix1Stride(), node.IsMatrix1Transposed(), node.IsOutputTransposed() };
+        }
+
+        template <typename ValueType>
+        std::optional<MatrixMultiplyInfo<ValueType>> GetMatrixMultiplyInfo(const Node& node)
+        {
+            if (auto mmNode = dynamic_cast<const nodes::MatrixMatrixMultiplyNode<ValueType>*>(&node))
+            {
+                return GetMatrixMatrixMultiplyInfo<ValueType>(*mmNode);
+            }
+
+            if (auto mmCodeNode = dynamic_cast<const nodes::MatrixMatrixMultiplyCodeNode<ValueType>*>(&node))
+            {
+                return GetMatrixMatrixMultiplyInfo<ValueType>(*mmCodeNode);
+            }
+
+            if (auto mvNode = dynamic_cast<const nodes::MatrixVectorMultiplyNode<ValueType>*>(&node))
+            {
+                auto weights = GetConstantInput(mvNode->inputMatrix);
+                if (weights == nullptr)
+                {
+                    return std::nullopt;
+                }
+
+                auto m = static_cast<int>(mvNode->GetM());
+                auto k = static_cast<int>(mvNode->GetN());
+                auto lda = static_cast<int>(mvNode->GetMatrixStride());
+                return MatrixMultiplyInfo<ValueType>{ weights, &mvNode->inputVector, &mvNode->output, m, 1, k, lda, false, false };
+            }
+
+            return std::nullopt;
+        }
+
+        template <typename ValueType>
+        void UpdateActivationRange(const Node& node, ActivationRanges& ranges)
+        {
+            auto info = GetMatrixMultiplyInfo<ValueType>(node);
+            if (!info)
+            {
+                return;
+            }
+
+            auto& range = ranges[node.GetId()];
+            for (auto value : info->activations->GetReferencedPort().GetOutput())
+            {
+                range.Add(static_cast<double>(value));
+            }
+        }
+
+        // returns 'true' if we handled the node, else 'false'. If we return 'false', keep trying other ValueTypes.
+        template <typename ValueType>
+        bool TryQuantizeNode(const Node& node, const ActivationRange& range, ModelTransformer& transformer)
+        {
+            auto info = GetMatrixMultiplyInfo<ValueType>(node);
+            if (!info)
+            {
+                return false;
+            }
+
+            const auto& weightValues = info->weights->GetValues();
+            const auto m = info->m;
+            const auto k = info->k;
+            std::vector<int8_t> quantizedWeights(static_cast<size_t>(m) * k);
+            std::vector<ValueType> weightScales(m);
+            for (int row = 0; row < m; ++row)
+            {
+                auto getWeight = [&](int column) {
+                    auto index = info->transposeWeights ? column * info->lda + row : row * info->lda + column;
+                    return static_cast<double>(weightValues[index]);
+                };
+
+                double maxAbsoluteWeight = 0;
+                for (int column = 0; column < k; ++column)
+                {
+                    maxAbsoluteWeight = std::max(maxAbsoluteWeight, std::abs(getWeight(column)));
+                }
+
+                auto scale = GetQuantizationScale(maxAbsoluteWeight);
+                weightScales[row] = static_cast<ValueType>(scale);
+                for (int column = 0; column < k; ++column)
+                {
+                    quantizedWeights[row * k + column] = Quantize(getWeight(column), scale);
+                }
+            }
+            auto inputScale = static_cast<ValueType>(GetQuantizationScale(range.GetMaxAbsoluteValue()));
+
+            const auto& newInput = transformer.GetCorrespondingInputs(*info->activations);
+            auto newNode = transformer.AddNode<nodes::QuantizedMatrixMatrixMultiplyNode<ValueType>>(newInput, m, info->n, k, quantizedWeights, weightScales, inputScale, info->transposeOutput, info->output->GetMemoryLayout());
+            newNode->GetMetadata() = node.GetMetadata();
+            transformer.MapNodeOutput(*info->output, newNode->output);
+
+            Log() << "Quantized matrix multiplication node " << node.GetId() << " to 8 bits" << std::endl;
+            return true;
+        }
+
+        void QuantizeNode(const Node& node, const ActivationRanges& ranges, ModelTransformer& transformer)
+        {
+            auto rangeIter = ranges.find(node.GetId());
+            if (rangeIter != ranges.end())
+            {
+                if (TryQuantizeNode<float>(node, rangeIter->second, transformer))
+                {
+                    return;
+                }
+                if (TryQuantizeNode<double>(node, rangeIter->second, transformer))
+                {
+                    return;
+                }
+            }
+
+            transformer.CopyNode(node);
+        }
+    } // namespace
+
+    //
+    // ActivationRange
+    //
+    void ActivationRange::Add(double value)
+    {
+        minimum = std::min(minimum, value);
+        maximum = std::max(maximum, value);
+    }
+
+    double ActivationRange::GetMaxAbsoluteValue() const
+    {
+        if (minimum > maximum)
+        {
+            return 0;
+        }
+        return std::max(std::abs(minimum), std::abs(maximum));
+    }
+
+    //
+    // Calibration
+    //
+    bool IsQuantizableNode(const Node& node)
+    {
+        return GetMatrixMultiplyInfo<float>(node).has_value() || GetMatrixMultiplyInfo<double>(node).has_value();
+    }
+
+    void UpdateActivationRanges(const Map& map, ActivationRanges& ranges)
+    {
+        map.GetModel().Visit([&ranges](const Node& node) {
+            UpdateActivationRange<float>(node, ranges);
+            UpdateActivationRange<double>(node, ranges);
+        });
+    }
+
+    //
+    // QuantizeModelTransformation methods
+    //
+    QuantizeModelTransformation::QuantizeModelTransformation(ActivationRanges ranges) :
+        _ranges(std::move(ranges))
+    {
+    }
+
+    Submodel QuantizeModelTransformation::Transform(const Submodel& submodel, ModelTransformer& transformer, const TransformContext& context) const
+    {
+        auto onto = transformer.GetCorrespondingOutputs(GetReferencedPorts(submodel.GetInputs()));
+        model::Model destModel = submodel.GetModel().ShallowCopy();
+        return transformer.TransformSubmodelOnto(submodel, destModel, onto, context, [this](const Node& node, ModelTransformer& transformer) {
+            QuantizeNode(node, _ranges, transformer);
+        });
+    }
+} // namespace passes
+} // namespace ell
@@ -0,0 +1,203 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ScheduleTuner.cpp (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ScheduleTuner.h"
+
+#include <model/include/IRCompiledMap.h>
+#include <model/include/IRMapCompiler.h>
+#include <model/include/InputNode.h>
+#include <model/include/Model.h>
+
+#include <nodes/include/ConstantNode.h>
+#include <nodes/include/MatrixMatrixMultiplyCodeNode.h>
+#include <nodes/include/SpatialConvolutionNode.h>
+
+#include <utilities/include/Logger.h>
+#include <utilities/include/TunableParameters.h>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <set>
+
+namespace ell
+{
+namespace passes
+{
+    using namespace model;
+    using namespace utilities::logging;
+    using utilities::logging::Log;
+
+    namespace
+    {
+        // Compiles a map with one input and one output and returns the fastest time (in seconds) of several runs
+        template <typename ValueType>
+        double TimeCompiledMap(const Map& map, const MapCompilerOptions& compilerOptions, const ScheduleTunerOptions& options)
+        {
+            IRMapCompiler compiler(compilerOptions, ModelOptimizerOptions{});
+            auto compiledMap = compiler.Compile(map);
+
+            std::vector<ValueType> input(compiledMap.GetInputSize(0));
+            for (size_t index = 0; index < input.size(); ++index)
+            {
+                input[index] = static_cast<ValueType>(index % 17) / 17;
+            }
+            std::vector<ValueType> output(compiledMap.GetOutputSize(0));
+            std::vector<void*> inputs = { input.data() };
+            std::vector<void*> outputs = { output.data() };
+
+            // The first run is a warm-up
+            compiledMap.ComputeMultiple(inputs, outputs);
+            auto bestTime = std::numeric_limits<double>::infinity();
+            for (int iteration = 0; iteration < std::max(options.numIterations, 1); ++iteration)
+            {
+                auto start = std::chrono::steady_clock::now();
+                compiledMap.ComputeMultiple(inputs, outputs);
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                bestTime = std::min(bestTime, elapsed.count());
+            }
+            return bestTime;
+        }
+
+        template <typename ValueType>
+        Map MakeMatrixMatrixMultiplyMap(const nodes::MatrixMatrixMultiplyCodeNode<ValueType>& node, const std::vector<int>& tileSizes)
+        {
+            Model model;
+            auto weightsNode = model.AddNode<nodes::ConstantNode<ValueType>>(std::vector<ValueType>(node.input1.Size(), static_cast<ValueType>(0.5)));
+            auto inputNode = model.AddNode<InputNode<ValueType>>(node.input2.Size());
+            auto multiplyNode = model.AddNode<nodes::MatrixMatrixMultiplyCodeNode<ValueType>>(weightsNode->output, node.GetM(), node.GetN(), node.GetK(), node.GetMatrix1Stride(), node.IsMatrix1Transposed(), inputNode->output, node.GetMatrix2Stride(), node.IsMatrix2Transposed(), node.GetOutputMatrixStride(), node.IsOutputTransposed(), tileSizes[0], tileSizes[1], tileSizes[2], tileSizes[3], tileSizes[4], tileSizes[5]);
+            return Map(model, { { "input", inputNode } }, { { "output", multiplyNode->output } });
+        }
+
+        template <typename ValueType>
+        Map MakeSpatialConvolutionMap(const nodes::SpatialConvolutionNode<ValueType>& node, int columnTile)
+        {
+            Model model;
+            auto inputNode = model.AddNode<InputNode<ValueType>>(node.input.GetMemoryLayout());
+            auto convolutionNode = model.AddNode<nodes::SpatialConvolutionNode<ValueType>>(inputNode->output, node.GetLayer(), node.output.GetMemoryLayout(), columnTile);
+            return Map(model, { { "input", inputNode } }, { { "output", convolutionNode->output } });
+        }
+
+        template <typename ValueType>
+        std::vector<int> TuneSpatialConvolution(const nodes::SpatialConvolutionNode<ValueType>& node, const MapCompilerOptions& compilerOptions, const ScheduleTunerOptions& options)
+        {
+            const int numColumns = node.output.GetMemoryLayout().GetLogicalDimensionActiveSize(1);
+            auto bestTime = std::numeric_limits<double>::infinity();
+            int bestColumnTile = 0;
+            for (auto columnTile : { 0, 2, 4, 8 })
+            {
+                if (columnTile >= numColumns)
+                {
+                    break;
+                }
+                auto time = TimeCompiledMap<ValueType>(MakeSpatialConvolutionMap(node, columnTile), compilerOptions, options);
+                if (time < bestTime)
+                {
+                    bestTime = time;
+                    bestColumnTile = columnTile;
+                }
+            }
+            return { bestColumnTile };
+        }
+
+        // returns 'true' if we handled the node, else 'false'. If we return 'false', keep trying other ValueTypes.
+        template <typename ValueType>
+        bool TryTuneNode(const Node& node, const MapCompilerOptions& compilerOptions, TuningCache& cache, const ScheduleTunerOptions& options)
+        {
+            const auto& target = compilerOptions.compilerSettings.targetDevice;
+            if (auto multiplyNode = dynamic_cast<const nodes::MatrixMatrixMultiplyCodeNode<ValueType>*>(&node))
+            {
+                auto key = multiplyNode->GetTuningKey(target);
+                if (!multiplyNode->HasAutomaticTileSizes() || cache.HasEntry(key))
+                {
+                    return false;
+                }
+                cache.SetParameters(key, TuneMatrixMatrixMultiply(*multiplyNode, compilerOptions, options));
+                Log() << "Tuned " << key << std::endl;
+                return true;
+            }
+
+            if (auto convolutionNode = dynamic_cast<const nodes::SpatialConvolutionNode<ValueType>*>(&node))
+            {
+                auto key = convolutionNode->GetTuningKey(target);
+                if (convolutionNode->GetColumnTile() != 0 || cache.HasEntry(key))
+                {
+                    return false;
+                }
+                cache.SetParameters(key, TuneSpatialConvolution(*convolutionNode, compilerOptions, options));
+                Log() << "Tuned " << key << std::endl;
+                return true;
+            }
+
+            return false;
+        }
+    } // namespace
+
+    template <typename ValueType>
+    std::vector<int> TuneMatrixMatrixMultiply(const nodes::MatrixMatrixMultiplyCodeNode<ValueType>& node, const MapCompilerOptions& compilerOptions, const ScheduleTunerOptions& options)
+    {
+        const int m = node.GetM();
+        const int n = node.GetN();
+        const int k = node.GetK();
+
+        // The candidates are combinations of these sizes. kernelN is rounded up to a multiple of the
+        // vector size by the node, and panelM isn't used by its schedule.
+        utilities::TunableParameter<int> panelN{ std::vector{ 32, 64, 128 }, "panelN" };
+        utilities::TunableParameter<int> panelK{ std::vector{ 64, 128, 256 }, "panelK" };
+        utilities::TunableParameter<int> kernelM{ std::vector{ 2, 4, 6 }, "kernelM" };
+        utilities::TunableParameter<int> kernelN{ std::vector{ 8, 16 }, "kernelN" };
+        utilities::TunableParameter<int> kernelK{ std::vector{ 4 }, "kernelK" };
+        utilities::TuningEngine engine(panelN, panelK, kernelM, kernelN, kernelK);
+
+        // Blocks larger than the matrix are clamped to its size, so several candidates can produce the same code
+        std::set<std::vector<int>> triedTileSizes;
+        auto bestTime = std::numeric_limits<double>::infinity();
+        std::vector<int> bestTileSizes;
+        do
+        {
+            std::vector<int> tileSizes = { 0, std::min<int>(panelN, n), std::min<int>(panelK, k), std::min<int>(kernelM, m), kernelN, kernelK };
+            if (!triedTileSizes.insert(tileSizes).second)
+            {
+                continue;
+            }
+
+            auto time = TimeCompiledMap<ValueType>(MakeMatrixMatrixMultiplyMap(node, tileSizes), compilerOptions, options);
+            Log() << "GEMM " << m << "x" << n << "x" << k << " " << engine.ToString() << ": " << time << " s" << std::endl;
+            if (time < bestTime)
+            {
+                bestTime = time;
+                bestTileSizes = tileSizes;
+            }
+        } while (engine.Next());
+
+        return bestTileSizes;
+    }
+
+    size_t TuneSchedules(const Map& map, const MapCompilerOptions& compilerOptions, TuningCache& cache, const ScheduleTunerOptions& options)
+    {
+        // Lower the model first, so that convolutions show up as the nodes they're compiled as
+        Map refinedMap = map;
+        refinedMap.Refine();
+
+        size_t numTuned = 0;
+        refinedMap.GetModel().Visit([&](const Node& node) {
+            if (TryTuneNode<float>(node, compilerOptions, cache, options) || TryTuneNode<double>(node, compilerOptions, cache, options))
+            {
+                ++numTuned;
+            }
+        });
+        return numTuned;
+    }
+
+    //
+    // Explicit instantiations
+    //
+    template std::vector<int> TuneMatrixMatrixMultiply<float>(const nodes::MatrixMatrixMultiplyCodeNode<float>& node, const MapCompilerOptions& compilerOptions, const ScheduleTunerOptions& options);
+    template std::vector<int> TuneMatrixMatrixMultiply<double>(const nodes::MatrixMatrixMultiplyCodeNode<double>& node, const MapCompilerOptions& compilerOptions, const ScheduleTunerOptions& options);
+} // namespace passes
+} // namespace ell
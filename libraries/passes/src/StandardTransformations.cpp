@@ -6,7 +6,9 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include "ConstantFoldingTransformation.h"
 #include "DetectLowPrecisionConvolutionTransformation.h"
+#include "FuseEpilogueTransformation.h"
 #include "StandardTransformations.h"
 #include "FuseLinearOperationsTransformation.h"
 #include "OptimizeReorderDataNodesTransformation.h"
@@ -36,8 +38,11 @@ namespace passes
             registry.AddTransformation<DetectLowPrecisionConvolutionTransformation>();
             registry.AddTransformation<SetConvolutionMethodTransformation>();
             registry.AddTransformation<model::RefineTransformation>();
+            registry.AddTransformation<ConstantFoldingTransformation>();
             registry.AddTransformation<FuseLinearOperationsTransformation>();
+            registry.AddTransformation<FuseEpilogueTransformation>();
             registry.AddTransformation<OptimizeReorderDataNodesTransformation>();
+            registry.AddTransformation<DeadNodeEliminationTransformation>();
             done = true;
         }
     }
@@ -15,5 +15,11 @@
 void TestTransformations();
 
 void TestFuseLinearOperationsTransformation();
+void TestFuseEpilogueTransformation();
 void TestSetConvolutionMethodTransformation();
 void TestOptimizeReorderDataNodesTransformation();
+void TestQuantizeModelTransformation();
+void TestConstantFoldingTransformation();
+void TestConstantFoldingKeepsStatefulNodes();
+void TestDeadNodeEliminationTransformation();
+void TestScheduleTuner();
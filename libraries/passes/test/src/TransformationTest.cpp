@@ -8,18 +8,30 @@
 
 #include "TransformationTest.h"
 
+#include <passes/include/ConstantFoldingTransformation.h>
+#include <passes/include/FuseEpilogueTransformation.h>
 #include <passes/include/FuseLinearOperationsTransformation.h>
 #include <passes/include/OptimizeReorderDataNodesTransformation.h>
+#include <passes/include/QuantizeModelTransformation.h>
+#include <passes/include/ScheduleTuner.h>
 #include <passes/include/SetConvolutionMethodTransformation.h>
 
+#include <model/include/IRCompiledMap.h>
+#include <model/include/IRMapCompiler.h>
 #include <model/include/InputNode.h>
 #include <model/include/TransformContext.h>
 #include <model/include/Transformation.h>
+#include <model/include/TuningCache.h>
 
+#include <nodes/include/AccumulatorNode.h>
+#include <nodes/include/ActivationFunctions.h>
+#include <nodes/include/BinaryOperationNode.h>
 #include <nodes/include/BroadcastFunctionNode.h>
 #include <nodes/include/ConstantNode.h>
 #include <nodes/include/ConvolutionalLayerNode.h>
+#include <nodes/include/MatrixMatrixMultiplyCodeNode.h>
 #include <nodes/include/MatrixMatrixMultiplyNode.h>
+#include <nodes/include/QuantizedMatrixMatrixMultiplyNode.h>
 #include <nodes/include/ReorderDataCodeNode.h>
 
 #include <predictors/neural/include/ConvolutionalLayer.h>
@@ -28,7 +40,10 @@
 
 #include <utilities/include/JsonArchiver.h>
 
+#include <algorithm>
+#include <filesystem>
 #include <iostream>
+#include <sstream>
 
 #define PRINT_MODELS 0
 
@@ -62,6 +77,34 @@ bool HasNodeWithTypeName(const model::Model& model, std::string typeName)
     return false;
 }
 
+size_t CountNodesWithTypeName(const model::Model& model, std::string typeName)
+{
+    size_t count = 0;
+    auto iter = model.GetNodeIterator();
+    while (iter.IsValid())
+    {
+        if (iter.Get()->GetRuntimeTypeName() == typeName)
+        {
+            ++count;
+        }
+        iter.Next();
+    }
+    return count;
+}
+
+// output = input * (a + b), where a and b are constants
+template <typename ValueType>
+model::Map GenerateConstantSubgraphTestModel()
+{
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ValueType>>(3);
+    auto aNode = model.AddNode<nodes::ConstantNode<ValueType>>(std::vector<ValueType>{ 1, 2, 3 });
+    auto bNode = model.AddNode<nodes::ConstantNode<ValueType>>(std::vector<ValueType>{ 10, 20, 30 });
+    auto sumNode = model.AddNode<nodes::BinaryOperationNode<ValueType>>(aNode->output, bNode->output, nodes::BinaryOperationType::add);
+    auto productNode = model.AddNode<nodes::BinaryOperationNode<ValueType>>(inputNode->output, sumNode->output, nodes::BinaryOperationType::multiply);
+    return model::Map(model, { { "input", inputNode } }, { { "output", productNode->output } });
+}
+
 template <typename ValueType>
 auto Increment(ValueType start, ValueType inc = static_cast<ValueType>(1))
 {
@@ -128,8 +171,14 @@ model::Map GenerateLinearOpsTestModel(const model::PortMemoryLayout& inputLayout
 void TestTransformations()
 {
     TestFuseLinearOperationsTransformation();
+    TestFuseEpilogueTransformation();
     TestSetConvolutionMethodTransformation();
     TestOptimizeReorderDataNodesTransformation();
+    TestQuantizeModelTransformation();
+    TestConstantFoldingTransformation();
+    TestConstantFoldingKeepsStatefulNodes();
+    TestDeadNodeEliminationTransformation();
+    TestScheduleTuner();
 }
 
 void TestFuseLinearOperationsTransformation(std::vector<std::pair<bool, bool>> functionInfos)
@@ -228,6 +277,53 @@ void TestFuseLinearOperationsTransformation()
     TestFuseLinearOperationsTransformation({ linear, bias, bias });
 }
 
+void TestFuseEpilogueTransformation()
+{
+    using ValueType = float;
+
+    // output = ReLU(scale * (weights * input) + bias), with one scale and bias entry per row of the product
+    const int m = 4;
+    const int n = 3;
+    const int k = 5;
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ValueType>>(model::MemoryShape{ k, n });
+    std::vector<ValueType> weights(m * k);
+    std::generate(weights.begin(), weights.end(), Increment<ValueType>(static_cast<ValueType>(-2), static_cast<ValueType>(0.25)));
+    auto weightsNode = model.AddNode<nodes::ConstantNode<ValueType>>(weights, model::MemoryShape{ m, k });
+    auto matMatMultNode = model.AddNode<nodes::MatrixMatrixMultiplyCodeNode<ValueType>>(weightsNode->output, m, n, k, k, false, inputNode->output, n, false, n, false, 0, 0, 0, 0, 0, 0, nodes::MatrixMatrixMultiplyImplementation::SimpleForLoops);
+
+    model::PortMemoryLayout layout(model::MemoryShape{ m, n });
+    auto scaleNode = model.AddNode<nodes::ConstantNode<ValueType>>(std::vector<ValueType>{ 1, 2, 3, 4 });
+    auto biasNode = model.AddNode<nodes::ConstantNode<ValueType>>(std::vector<ValueType>{ -1, 0, 1, 2 });
+    auto linearNode = model.AddNode<nodes::BroadcastLinearFunctionNode<ValueType>>(matMatMultNode->output, layout, scaleNode->output, biasNode->output, 0, layout);
+    auto reluNode = model.AddNode<nodes::BroadcastUnaryFunctionNode<ValueType, nodes::ReLUActivationFunction<ValueType>>>(linearNode->output, layout, layout);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", reluNode->output } });
+
+    std::vector<ValueType> input(k * n);
+    std::generate(input.begin(), input.end(), Increment<ValueType>(static_cast<ValueType>(-1), static_cast<ValueType>(0.125)));
+    auto referenceOutput = map.Compute<ValueType>(input);
+
+    model::MapCompilerOptions settings;
+    model::ModelOptimizerOptions optimizerOptions;
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    model::TransformContext context(&compiler);
+    passes::FuseEpilogueTransformation fuseEpilogue;
+    map.Transform(fuseEpilogue, context);
+    map.Prune();
+
+#if PRINT_MODELS
+    PrintModel(map.GetModel());
+#endif
+
+    auto matMatMultNodes = map.GetModel().GetNodesByType<nodes::MatrixMatrixMultiplyCodeNode<ValueType>>();
+    bool fused = matMatMultNodes.size() == 1 && matMatMultNodes[0]->GetEpilogue().HasActivation() &&
+                 !HasNodeWithTypeName(map.GetModel(), nodes::BroadcastLinearFunctionNode<ValueType>::GetTypeName()) &&
+                 !HasNodeWithTypeName(map.GetModel(), nodes::BroadcastUnaryFunctionNode<ValueType, nodes::ReLUActivationFunction<ValueType>>::GetTypeName());
+    testing::ProcessTest("Testing FuseEpilogueTransformation fused nodes", fused);
+    testing::ProcessTest("Testing FuseEpilogueTransformation result", testing::IsEqual(referenceOutput, map.Compute<ValueType>(input)));
+}
+
 void TestSetConvolutionMethodTransformation(model::PreferredConvolutionMethod convolutionMethod, std::string expectedNodeTypeName)
 {
     using namespace predictors::neural;
@@ -470,3 +566,218 @@ void TestOptimizeReorderDataNodesTransformation()
     TestOptimizeReorderDataNodesTransformation3();
     TestOptimizeReorderDataNodesTransformation4();
 }
+
+void TestQuantizeModelTransformation()
+{
+    using ValueType = float;
+
+    // output (m x n) = weights (m x k) * input (k x n)
+    const int m = 4;
+    const int n = 3;
+    const int k = 8;
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ValueType>>(model::MemoryShape{ k, n });
+    std::vector<ValueType> weights(m * k);
+    for (int index = 0; index < m * k; ++index)
+    {
+        weights[index] = static_cast<ValueType>(((index * 7) % 11) - 5) / 4;
+    }
+    auto weightsNode = model.AddNode<nodes::ConstantNode<ValueType>>(weights, model::MemoryShape{ m, k });
+    auto matMatMultNode = model.AddNode<nodes::MatrixMatrixMultiplyNode<ValueType>>(weightsNode->output, m, n, k, k, inputNode->output, n, n);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", matMatMultNode->output } });
+
+    // Calibrate on a few inputs
+    std::vector<std::vector<ValueType>> inputs;
+    for (int example = 0; example < 4; ++example)
+    {
+        std::vector<ValueType> input(k * n);
+        std::generate(input.begin(), input.end(), Increment<ValueType>(static_cast<ValueType>(example - 2), static_cast<ValueType>(0.125)));
+        inputs.push_back(input);
+    }
+
+    std::vector<std::vector<ValueType>> referenceOutputs;
+    passes::ActivationRanges ranges;
+    for (const auto& input : inputs)
+    {
+        referenceOutputs.push_back(map.Compute<ValueType>(input));
+        passes::UpdateActivationRanges(map, ranges);
+    }
+    testing::ProcessTest("Testing QuantizeModelTransformation calibration", ranges.size() == 1 && ranges.begin()->second.minimum == -2.0 && ranges.begin()->second.maximum == 3.875);
+
+    // Transform model
+    passes::QuantizeModelTransformation quantize(ranges);
+    map.Transform(quantize);
+
+#if PRINT_MODELS
+    PrintModel(map.GetModel());
+#endif
+
+    testing::ProcessTest("Testing QuantizeModelTransformation replaced node", HasNodeWithTypeName(map.GetModel(), nodes::QuantizedMatrixMatrixMultiplyNode<ValueType>::GetTypeName()) && !HasNodeWithTypeName(map.GetModel(), nodes::MatrixMatrixMultiplyNode<ValueType>::GetTypeName()));
+
+    // Each product has a quantization error of at most about (|w| * inputScale + |x| * weightScale) / 2
+    bool ok = true;
+    for (size_t example = 0; example < inputs.size(); ++example)
+    {
+        auto quantizedOutput = map.Compute<ValueType>(inputs[example]);
+        ok = ok && testing::IsEqual(referenceOutputs[example], quantizedOutput, static_cast<ValueType>(0.1));
+    }
+    testing::ProcessTest("Testing QuantizeModelTransformation result", ok);
+}
+
+void TestConstantFoldingTransformation()
+{
+    using ValueType = float;
+    auto map = GenerateConstantSubgraphTestModel<ValueType>();
+    std::vector<ValueType> input = { 1, 2, 3 };
+    auto referenceOutput = map.Compute<ValueType>(input);
+
+    passes::ConstantFoldingTransformation foldConstants;
+    map.Transform(foldConstants);
+
+#if PRINT_MODELS
+    PrintModel(map.GetModel());
+#endif
+
+    // Only the multiplication by the input remains, and it reads a new constant holding a + b
+    const auto binaryOperationTypeName = nodes::BinaryOperationNode<ValueType>::GetTypeName();
+    const auto constantTypeName = nodes::ConstantNode<ValueType>::GetTypeName();
+    testing::ProcessTest("Testing ConstantFoldingTransformation folded node", CountNodesWithTypeName(map.GetModel(), binaryOperationTypeName) == 1 && CountNodesWithTypeName(map.GetModel(), constantTypeName) == 3);
+    testing::ProcessTest("Testing ConstantFoldingTransformation result", testing::IsEqual(referenceOutput, map.Compute<ValueType>(input)));
+}
+
+void TestConstantFoldingKeepsStatefulNodes()
+{
+    using ValueType = float;
+
+    // The accumulator's input is constant, but its output changes on every call
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ValueType>>(3);
+    auto constantNode = model.AddNode<nodes::ConstantNode<ValueType>>(std::vector<ValueType>{ 1, 2, 3 });
+    auto accumulatorNode = model.AddNode<nodes::AccumulatorNode<ValueType>>(constantNode->output);
+    auto productNode = model.AddNode<nodes::BinaryOperationNode<ValueType>>(inputNode->output, accumulatorNode->output, nodes::BinaryOperationType::multiply);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", productNode->output } });
+
+    passes::ConstantFoldingTransformation foldConstants;
+    map.Transform(foldConstants);
+
+    std::vector<ValueType> input = { 1, 2, 3 };
+    auto firstOutput = map.Compute<ValueType>(input);
+    auto secondOutput = map.Compute<ValueType>(input);
+    std::vector<ValueType> expectedFirstOutput = { 1, 4, 9 };
+    std::vector<ValueType> expectedSecondOutput = { 2, 8, 18 };
+    testing::ProcessTest("Testing ConstantFoldingTransformation keeps stateful nodes", CountNodesWithTypeName(map.GetModel(), nodes::AccumulatorNode<ValueType>::GetTypeName()) == 1 && testing::IsEqual(firstOutput, expectedFirstOutput) && testing::IsEqual(secondOutput, expectedSecondOutput));
+}
+
+void TestDeadNodeEliminationTransformation()
+{
+    using ValueType = float;
+    auto map = GenerateConstantSubgraphTestModel<ValueType>();
+    std::vector<ValueType> input = { 1, 2, 3 };
+    auto referenceOutput = map.Compute<ValueType>(input);
+
+    passes::ConstantFoldingTransformation foldConstants;
+    map.Transform(foldConstants);
+    passes::DeadNodeEliminationTransformation eliminateDeadNodes;
+    map.Transform(eliminateDeadNodes);
+
+#if PRINT_MODELS
+    PrintModel(map.GetModel());
+#endif
+
+    // The constants that fed the folded node are gone
+    const auto constantTypeName = nodes::ConstantNode<ValueType>::GetTypeName();
+    testing::ProcessTest("Testing DeadNodeEliminationTransformation removed nodes", CountNodesWithTypeName(map.GetModel(), constantTypeName) == 1);
+    testing::ProcessTest("Testing DeadNodeEliminationTransformation result", testing::IsEqual(referenceOutput, map.Compute<ValueType>(input)));
+}
+
+void TestScheduleTuner()
+{
+    using ValueType = float;
+    using MultiplyNodeType = nodes::MatrixMatrixMultiplyCodeNode<ValueType>;
+
+    // output (m x n) = weights (m x k) * input (k x n)
+    const int m = 8;
+    const int n = 16;
+    const int k = 16;
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ValueType>>(model::MemoryShape{ k, n });
+    std::vector<ValueType> weights(m * k);
+    std::generate(weights.begin(), weights.end(), Increment<ValueType>(static_cast<ValueType>(-1), static_cast<ValueType>(0.0625)));
+    auto weightsNode = model.AddNode<nodes::ConstantNode<ValueType>>(weights, model::MemoryShape{ m, k });
+    auto matMatMultNode = model.AddNode<MultiplyNodeType>(weightsNode->output, m, n, k, k, false, inputNode->output, n, false, n, false);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", matMatMultNode->output } });
+
+    model::MapCompilerOptions compilerOptions;
+    model::TuningCache cache;
+    passes::ScheduleTunerOptions tunerOptions;
+    tunerOptions.numIterations = 2;
+    auto numTuned = passes::TuneSchedules(map, compilerOptions, cache, tunerOptions);
+    auto key = matMatMultNode->GetTuningKey(compilerOptions.compilerSettings.targetDevice);
+    std::vector<int> tileSizes;
+    testing::ProcessTest("Testing TuneSchedules", numTuned == 1 && cache.TryGetParameters(key, tileSizes) && tileSizes.size() == 6);
+    testing::ProcessTest("Testing TuneSchedules skips tuned shapes", passes::TuneSchedules(map, compilerOptions, cache, tunerOptions) == 0);
+
+    std::stringstream cacheStream;
+    cache.Write(cacheStream);
+    model::TuningCache loadedCache;
+    loadedCache.Read(cacheStream);
+    std::vector<int> loadedTileSizes;
+    testing::ProcessTest("Testing TuningCache round trip", loadedCache.Size() == 1 && loadedCache.TryGetParameters(key, loadedTileSizes) && loadedTileSizes == tileSizes);
+
+    // The same shape with a different memory layout is tuned separately
+    auto transposedNode = model.AddNode<MultiplyNodeType>(weightsNode->output, m, n, k, k, false, inputNode->output, n, false, m, true);
+    testing::ProcessTest("Testing tuning keys include the memory layout", transposedNode->GetTuningKey(compilerOptions.compilerSettings.targetDevice) != key);
+
+    // Refining the map for a compiler that uses the cache picks up the tuned tile sizes
+    const std::string cacheFilename = (std::filesystem::temp_directory_path() / "passes_test_tuning_cache.txt").string();
+    cache.Save(cacheFilename);
+    compilerOptions.tuningCachePath = cacheFilename;
+    model::IRMapCompiler refiningCompiler(compilerOptions, {});
+    model::TransformContext context(&refiningCompiler);
+    auto refinedMap = map;
+    refinedMap.Refine(context);
+    bool usedTunedSizes = false;
+    refinedMap.GetModel().Visit([&](const model::Node& node) {
+        if (auto multiplyNode = dynamic_cast<const MultiplyNodeType*>(&node))
+        {
+            usedTunedSizes = multiplyNode->GetTileSizes() == tileSizes;
+        }
+    });
+    testing::ProcessTest("Testing refinement with a tuning cache", usedTunedSizes);
+
+    model::IRMapCompiler compiler(compilerOptions, {});
+    auto compiledMap = compiler.Compile(map);
+    std::vector<ValueType> input(k * n);
+    std::generate(input.begin(), input.end(), Increment<ValueType>(static_cast<ValueType>(-2), static_cast<ValueType>(0.125)));
+    auto expected = map.Compute<ValueType>(input);
+    auto actual = compiledMap.Compute<ValueType>(input);
+    testing::ProcessTest("Testing compiled map with tuned tile sizes", testing::IsEqual(expected, actual, static_cast<ValueType>(1e-4)));
+    std::filesystem::remove(cacheFilename);
+
+    // Archives from before automatic tile sizes stored the then-default tile sizes, which now read as automatic
+    model::Model legacyModel;
+    auto legacyInputNode = legacyModel.AddNode<model::InputNode<ValueType>>(k * n);
+    auto legacyWeightsNode = legacyModel.AddNode<nodes::ConstantNode<ValueType>>(weights);
+    legacyModel.AddNode<MultiplyNodeType>(legacyWeightsNode->output, m, n, k, k, false, legacyInputNode->output, n, false, n, false, 64, 64, 64, 4, 4, 4);
+    std::stringstream archiveStream;
+    utilities::JsonArchiver archiver(archiveStream);
+    archiver << legacyModel;
+    auto archiveText = archiveStream.str();
+    const std::string tileSizesVersion = "\"_version\": \"" + std::to_string(static_cast<int>(utilities::ArchiveVersionNumbers::v11_automatic_tile_sizes)) + "\"";
+    for (auto position = archiveText.find(tileSizesVersion); position != std::string::npos; position = archiveText.find(tileSizesVersion, position))
+    {
+        archiveText.replace(position, tileSizesVersion.size(), "\"_version\": \"3\"");
+    }
+    std::stringstream legacyArchiveStream(archiveText);
+    utilities::SerializationContext serializationContext;
+    serializationContext.GetTypeFactory().AddType<model::Node, model::InputNode<ValueType>>();
+    serializationContext.GetTypeFactory().AddType<model::Node, nodes::ConstantNode<ValueType>>();
+    serializationContext.GetTypeFactory().AddType<model::Node, MultiplyNodeType>();
+    utilities::JsonUnarchiver unarchiver(legacyArchiveStream, serializationContext);
+    model::Model unarchivedModel;
+    unarchiver >> unarchivedModel;
+    auto unarchivedNodes = unarchivedModel.GetNodesByType<MultiplyNodeType>();
+    testing::ProcessTest("Testing legacy default tile sizes are read as automatic", unarchivedNodes.size() == 1 && unarchivedNodes[0]->HasAutomaticTileSizes());
+}
@@ -0,0 +1,279 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FlatForestPredictor.h (predictors)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ForestPredictor.h"
+#include "IPredictor.h"
+
+#include <data/include/DenseDataVector.h>
+
+#include <utilities/include/IArchivable.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace predictors
+{
+    /// <summary>
+    /// An inference-only version of a `SimpleForestPredictor`, stored as a structure of arrays. Every tree node
+    /// (interior or leaf) has an entry in each array: the index of the input element it tests, the threshold
+    /// it compares against, the indices of its two children, and the sum of the edge values on the path from
+    /// the root (nonzero only for leaves). Leaves test element 0 against +infinity and point back to themselves,
+    /// so a tree is evaluated by taking exactly `GetTreeDepth(tree)` steps from its root, without branches.
+    /// </summary>
+    class FlatForestPredictor : public IPredictor<double>
+        , public utilities::IArchivable
+    {
+    public:
+        using DataVectorType = data::FloatDataVector;
+
+        /// <summary> Default constructor. Creates an empty forest. </summary>
+        FlatForestPredictor() = default;
+
+        /// <summary> Constructs a flat forest from a forest predictor. </summary>
+        ///
+        /// <param name="forest"> The forest. Every split rule must have exactly two outputs. </param>
+        explicit FlatForestPredictor(const SimpleForestPredictor& forest);
+
+        /// <summary> Returns the number of trees in the forest. </summary>
+        ///
+        /// <returns> The number of trees. </returns>
+        size_t NumTrees() const { return _rootIndices.size(); }
+
+        /// <summary> Returns the number of nodes (interior nodes and leaves) in the forest. </summary>
+        ///
+        /// <returns> The number of nodes. </returns>
+        size_t NumNodes() const { return _featureIndices.size(); }
+
+        /// <summary> Returns the number of edges in the original forest. </summary>
+        ///
+        /// <returns> The number of edges. </returns>
+        size_t NumEdges() const { return _numEdges; }
+
+        /// <summary> Returns the minimal size of an input vector: one more than the largest input index tested by the forest. </summary>
+        ///
+        /// <returns> The number of input features. </returns>
+        size_t NumFeatures() const { return _numFeatures; }
+
+        /// <summary> Returns the bias term of the forest. </summary>
+        ///
+        /// <returns> The bias. </returns>
+        double GetBias() const { return _bias; }
+
+        /// <summary> Returns the number of interior nodes on the longest root-to-leaf path of a tree. </summary>
+        ///
+        /// <param name="treeIndex"> The index of the tree. </param>
+        ///
+        /// <returns> The depth of the tree. </returns>
+        size_t GetTreeDepth(size_t treeIndex) const { return static_cast<size_t>(_treeDepths[treeIndex]); }
+
+        /// <summary> Returns the index of the input element tested by each node. </summary>
+        const std::vector<int>& GetFeatureIndices() const { return _featureIndices; }
+
+        /// <summary> Returns the threshold of each node. A node takes its second child if its input element is greater than its threshold. </summary>
+        const std::vector<double>& GetThresholds() const { return _thresholds; }
+
+        /// <summary> Returns the indices of the two children of each node, stored at 2*node and 2*node+1. </summary>
+        const std::vector<int>& GetChildIndices() const { return _childIndices; }
+
+        /// <summary> Returns the value of each node: the sum of the edge values on the path from the root for leaves, and zero for interior nodes. </summary>
+        const std::vector<double>& GetNodeValues() const { return _nodeValues; }
+
+        /// <summary> Returns, for each node, the index in the original forest of its first outgoing edge, or -1 for leaves. </summary>
+        const std::vector<int>& GetFirstEdgeIndices() const { return _firstEdgeIndices; }
+
+        /// <summary> Returns the index of the root node of each tree. </summary>
+        const std::vector<int>& GetRootIndices() const { return _rootIndices; }
+
+        /// <summary> Returns the depth of each tree. </summary>
+        const std::vector<int>& GetTreeDepths() const { return _treeDepths; }
+
+        /// <summary> Returns the output of the forest for a given input. </summary>
+        ///
+        /// <param name="input"> The data vector. Elements past its prefix length are treated as zeros. </param>
+        ///
+        /// <returns> The prediction. </returns>
+        double Predict(const DataVectorType& input) const;
+
+        /// <summary> Returns the output of the forest for a given input. </summary>
+        ///
+        /// <typeparam name="ValueType"> The input element type. </typeparam>
+        /// <param name="input"> Pointer to the input, which has at least `NumFeatures()` elements. </param>
+        ///
+        /// <returns> The prediction. </returns>
+        template <typename ValueType>
+        double Predict(const ValueType* input) const;
+
+        /// <summary> Returns the output of a single tree for a given input. </summary>
+        ///
+        /// <typeparam name="ValueType"> The input element type. </typeparam>
+        /// <param name="input"> Pointer to the input, which has at least `NumFeatures()` elements. </param>
+        /// <param name="treeIndex"> The index of the tree. </param>
+        ///
+        /// <returns> The output of the tree. </returns>
+        template <typename ValueType>
+        double PredictTree(const ValueType* input, size_t treeIndex) const;
+
+        /// <summary>
+        /// Computes the forest output for a batch of inputs. The inputs are processed in blocks, and each tree
+        /// is advanced one level at a time for every input in the block, so the inner loop has no branches and
+        /// no dependencies between inputs and can be vectorized by the compiler.
+        /// </summary>
+        ///
+        /// <typeparam name="ValueType"> The input element type. </typeparam>
+        /// <param name="inputs"> Pointer to the first input. </param>
+        /// <param name="numInputs"> The number of inputs. </param>
+        /// <param name="inputStride"> The distance, in elements, between consecutive inputs. Must be at least `NumFeatures()`. </param>
+        /// <param name="outputs"> Pointer to an array of `numInputs` outputs. </param>
+        template <typename ValueType>
+        void PredictBatch(const ValueType* inputs, size_t numInputs, size_t inputStride, double* outputs) const;
+
+        /// <summary> Returns a vector that indicates which edges of the original forest are on the paths taken by an input. </summary>
+        ///
+        /// <typeparam name="ValueType"> The input element type. </typeparam>
+        /// <param name="input"> Pointer to the input, which has at least `NumFeatures()` elements. </param>
+        ///
+        /// <returns> The edge indicator vector, with `NumEdges()` entries. </returns>
+        template <typename ValueType>
+        std::vector<bool> GetEdgeIndicatorVector(const ValueType* input) const;
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        static std::string GetTypeName() { return "FlatForestPredictor"; }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        std::string GetRuntimeTypeName() const override { return GetTypeName(); }
+
+    protected:
+        void WriteToArchive(utilities::Archiver& archiver) const override;
+        void ReadFromArchive(utilities::Unarchiver& archiver) override;
+
+    private:
+        size_t AddLeaf();
+
+        template <typename ValueType>
+        int GetChildPosition(const ValueType* input, int nodeIndex) const;
+
+        std::vector<int> _featureIndices;
+        std::vector<double> _thresholds;
+        std::vector<int> _childIndices;
+        std::vector<double> _nodeValues;
+        std::vector<int> _firstEdgeIndices;
+        std::vector<int> _rootIndices;
+        std::vector<int> _treeDepths;
+        double _bias = 0.0;
+        size_t _numEdges = 0;
+        size_t _numFeatures = 0;
+    };
+} // namespace predictors
+} // namespace ell
+
+#pragma region implementation
+
+namespace ell
+{
+namespace predictors
+{
+    template <typename ValueType>
+    int FlatForestPredictor::GetChildPosition(const ValueType* input, int nodeIndex) const
+    {
+        auto value = static_cast<double>(input[_featureIndices[nodeIndex]]);
+        return value > _thresholds[nodeIndex] ? 1 : 0;
+    }
+
+    template <typename ValueType>
+    double FlatForestPredictor::PredictTree(const ValueType* input, size_t treeIndex) const
+    {
+        auto nodeIndex = _rootIndices[treeIndex];
+        for (int level = 0; level < _treeDepths[treeIndex]; ++level)
+        {
+            nodeIndex = _childIndices[2 * nodeIndex + GetChildPosition(input, nodeIndex)];
+        }
+        return _nodeValues[nodeIndex];
+    }
+
+    template <typename ValueType>
+    double FlatForestPredictor::Predict(const ValueType* input) const
+    {
+        double output = _bias;
+        for (size_t treeIndex = 0; treeIndex < _rootIndices.size(); ++treeIndex)
+        {
+            output += PredictTree(input, treeIndex);
+        }
+        return output;
+    }
+
+    template <typename ValueType>
+    void FlatForestPredictor::PredictBatch(const ValueType* inputs, size_t numInputs, size_t inputStride, double* outputs) const
+    {
+        constexpr size_t blockSize = 16;
+        int nodeIndices[blockSize];
+        double blockOutputs[blockSize];
+
+        const int* featureIndices = _featureIndices.data();
+        const double* thresholds = _thresholds.data();
+        const int* childIndices = _childIndices.data();
+        const double* nodeValues = _nodeValues.data();
+
+        for (size_t blockStart = 0; blockStart < numInputs; blockStart += blockSize)
+        {
+            const auto count = std::min(blockSize, numInputs - blockStart);
+            const ValueType* blockInputs = inputs + blockStart * inputStride;
+            std::fill(blockOutputs, blockOutputs + count, _bias);
+
+            for (size_t treeIndex = 0; treeIndex < _rootIndices.size(); ++treeIndex)
+            {
+                std::fill(nodeIndices, nodeIndices + count, _rootIndices[treeIndex]);
+                for (int level = 0; level < _treeDepths[treeIndex]; ++level)
+                {
+                    for (size_t lane = 0; lane < count; ++lane)
+                    {
+                        auto nodeIndex = nodeIndices[lane];
+                        auto value = static_cast<double>(blockInputs[lane * inputStride + featureIndices[nodeIndex]]);
+                        nodeIndices[lane] = childIndices[2 * nodeIndex + (value > thresholds[nodeIndex] ? 1 : 0)];
+                    }
+                }
+
+                for (size_t lane = 0; lane < count; ++lane)
+                {
+                    blockOutputs[lane] += nodeValues[nodeIndices[lane]];
+                }
+            }
+
+            std::copy(blockOutputs, blockOutputs + count, outputs + blockStart);
+        }
+    }
+
+    template <typename ValueType>
+    std::vector<bool> FlatForestPredictor::GetEdgeIndicatorVector(const ValueType* input) const
+    {
+        std::vector<bool> edgeIndicator(_numEdges);
+        for (size_t treeIndex = 0; treeIndex < _rootIndices.size(); ++treeIndex)
+        {
+            auto nodeIndex = _rootIndices[treeIndex];
+            while (_firstEdgeIndices[nodeIndex] >= 0)
+            {
+                auto childPosition = GetChildPosition(input, nodeIndex);
+                edgeIndicator[_firstEdgeIndices[nodeIndex] + childPosition] = true;
+                nodeIndex = _childIndices[2 * nodeIndex + childPosition];
+            }
+        }
+        return edgeIndicator;
+    }
+} // namespace predictors
+} // namespace ell
+
+#pragma endregion implementation
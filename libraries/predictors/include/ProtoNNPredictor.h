@@ -118,6 +118,16 @@ namespace predictors
         /// <returns> The predicted label scores. </returns>
         math::ColumnVector<double> Predict(const std::vector<double>& inputVector) const;
 
+        /// <summary>
+        /// Returns the label scores for a batch of inputs. The projections, the distances to the prototypes, and
+        /// the label scores are each computed with one matrix-matrix product for the whole batch.
+        /// </summary>
+        ///
+        /// <param name="inputs"> The inputs, one per row. The number of columns must equal the predictor dimension. </param>
+        ///
+        /// <returns> The predicted label scores, one row per input. </returns>
+        math::RowMatrix<double> Predict(math::ConstRowMatrixReference<double> inputs) const;
+
         /// <summary> Resets the projection predictor to the zero projection matrix. </summary>
         void Reset();
 
@@ -137,6 +147,7 @@ namespace predictors
 
     private:
         math::ColumnVector<double> GetLabelScores(const std::vector<double>& inputVector) const;
+        math::RowMatrix<double> GetLabelScores(math::ConstRowMatrixReference<double> inputs) const;
 
         // Input dimension
         size_t _dimension;
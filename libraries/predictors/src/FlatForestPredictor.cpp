@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FlatForestPredictor.cpp (predictors)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "FlatForestPredictor.h"
+
+#include <utilities/include/Exception.h>
+
+#include <deque>
+#include <limits>
+
+namespace ell
+{
+namespace predictors
+{
+    FlatForestPredictor::FlatForestPredictor(const SimpleForestPredictor& forest) :
+        _bias(forest.GetBias()),
+        _numEdges(forest.NumEdges())
+    {
+        struct PendingNode
+        {
+            size_t flatIndex;
+            size_t interiorNodeIndex;
+            bool isLeaf;
+            double pathValue;
+            int depth;
+        };
+
+        const auto& interiorNodes = forest.GetInteriorNodes();
+        for (auto rootIndex : forest.GetRootIndices())
+        {
+            // lay out each tree breadth-first, so that the top levels of a tree share cache lines
+            auto flatRootIndex = AddLeaf();
+            _rootIndices.push_back(static_cast<int>(flatRootIndex));
+            _treeDepths.push_back(0);
+
+            std::deque<PendingNode> pendingNodes;
+            pendingNodes.push_back({ flatRootIndex, rootIndex, rootIndex >= interiorNodes.size(), 0.0, 0 });
+            while (!pendingNodes.empty())
+            {
+                auto pendingNode = pendingNodes.front();
+                pendingNodes.pop_front();
+                if (pendingNode.isLeaf)
+                {
+                    _nodeValues[pendingNode.flatIndex] = pendingNode.pathValue;
+                    continue;
+                }
+
+                const auto& interiorNode = interiorNodes[pendingNode.interiorNodeIndex];
+                const auto& edges = interiorNode.GetOutgoingEdges();
+                if (edges.size() != 2)
+                {
+                    throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "FlatForestPredictor requires every interior node to have two outgoing edges");
+                }
+
+                const auto& splitRule = interiorNode.GetSplitRule();
+                auto flatIndex = pendingNode.flatIndex;
+                _featureIndices[flatIndex] = static_cast<int>(splitRule.GetElementIndex());
+                _thresholds[flatIndex] = splitRule.GetThreshold();
+                _firstEdgeIndices[flatIndex] = static_cast<int>(interiorNode.GetFirstEdgeIndex());
+                _numFeatures = std::max(_numFeatures, splitRule.GetElementIndex() + 1);
+                _treeDepths.back() = std::max(_treeDepths.back(), pendingNode.depth + 1);
+
+                for (size_t childPosition = 0; childPosition < 2; ++childPosition)
+                {
+                    const auto& edge = edges[childPosition];
+                    auto childIndex = AddLeaf();
+                    _childIndices[2 * flatIndex + childPosition] = static_cast<int>(childIndex);
+                    pendingNodes.push_back({ childIndex, edge.GetTargetNodeIndex(), !edge.IsTargetInterior(), pendingNode.pathValue + edge.GetPredictor().GetValue(), pendingNode.depth + 1 });
+                }
+            }
+        }
+    }
+
+    size_t FlatForestPredictor::AddLeaf()
+    {
+        auto index = _featureIndices.size();
+        _featureIndices.push_back(0);
+        _thresholds.push_back(std::numeric_limits<double>::infinity());
+        _childIndices.push_back(static_cast<int>(index));
+        _childIndices.push_back(static_cast<int>(index));
+        _nodeValues.push_back(0.0);
+        _firstEdgeIndices.push_back(-1);
+        return index;
+    }
+
+    double FlatForestPredictor::Predict(const DataVectorType& input) const
+    {
+        auto dense = input.ToArray(std::max(_numFeatures, input.PrefixLength()));
+        return Predict(dense.data());
+    }
+
+    void FlatForestPredictor::WriteToArchive(utilities::Archiver& archiver) const
+    {
+        archiver["featureIndices"] << _featureIndices;
+        archiver["thresholds"] << _thresholds;
+        archiver["childIndices"] << _childIndices;
+        archiver["nodeValues"] << _nodeValues;
+        archiver["firstEdgeIndices"] << _firstEdgeIndices;
+        archiver["rootIndices"] << _rootIndices;
+        archiver["treeDepths"] << _treeDepths;
+        archiver["bias"] << _bias;
+        archiver["numEdges"] << _numEdges;
+        archiver["numFeatures"] << _numFeatures;
+    }
+
+    void FlatForestPredictor::ReadFromArchive(utilities::Unarchiver& archiver)
+    {
+        archiver["featureIndices"] >> _featureIndices;
+        archiver["thresholds"] >> _thresholds;
+        archiver["childIndices"] >> _childIndices;
+        archiver["nodeValues"] >> _nodeValues;
+        archiver["firstEdgeIndices"] >> _firstEdgeIndices;
+        archiver["rootIndices"] >> _rootIndices;
+        archiver["treeDepths"] >> _treeDepths;
+        archiver["bias"] >> _bias;
+        archiver["numEdges"] >> _numEdges;
+        archiver["numFeatures"] >> _numFeatures;
+    }
+} // namespace predictors
+} // namespace ell
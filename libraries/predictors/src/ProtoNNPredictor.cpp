@@ -10,6 +10,10 @@
 
 #include <math/include/MatrixOperations.h>
 
+#include <utilities/include/Exception.h>
+
+#include <algorithm>
+#include <cmath>
 #include <memory>
 
 namespace ell
@@ -45,31 +49,50 @@ namespace predictors
 
     math::ColumnVector<double> ProtoNNPredictor::GetLabelScores(const std::vector<double>& inputVector) const
     {
-        // Projection
-        math::ColumnVector<double> data(inputVector);
         auto dimension = GetDimension();
-        data.Resize(dimension);
-        math::ColumnVector<double> projectedInput(GetProjectedDimension());
-        math::MultiplyScaleAddUpdate(1.0, _W, data, 0.0, projectedInput);
+        math::RowMatrix<double> input(1, dimension);
+        std::copy_n(inputVector.begin(), std::min(inputVector.size(), dimension), input.GetDataPointer());
 
-        // Similarity to each prototype
+        auto labels = GetLabelScores(input);
+        return math::ColumnVector<double>(labels.GetRow(0).ToArray());
+    }
+
+    math::RowMatrix<double> ProtoNNPredictor::GetLabelScores(math::ConstRowMatrixReference<double> inputs) const
+    {
+        auto batchSize = inputs.NumRows();
         auto numPrototypes = GetNumPrototypes();
-        math::ColumnVector<double> similarityToPrototypes(numPrototypes);
-        auto prototypes = GetPrototypes();
-        auto gammaVal = GetGamma();
 
-        for (size_t i = 0; i < numPrototypes; i++)
+        // Projection
+        math::RowMatrix<double> projectedInputs(batchSize, GetProjectedDimension());
+        math::MultiplyScaleAddUpdate(1.0, inputs, _W.Transpose(), 0.0, projectedInputs);
+
+        // Squared distance to each prototype, as ||x||^2 + ||p||^2 - 2 * x.p, where the dot products for the whole
+        // batch are one matrix product
+        math::RowMatrix<double> similarityToPrototypes(batchSize, numPrototypes);
+        math::MultiplyScaleAddUpdate(-2.0, projectedInputs, _B, 0.0, similarityToPrototypes);
+
+        std::vector<double> prototypeNorms(numPrototypes);
+        for (size_t j = 0; j < numPrototypes; ++j)
         {
-            math::ColumnVector<double> prototype(prototypes.GetColumn(i).ToArray());
-            prototype -= projectedInput;
-            auto prototypeDistance = prototype.Norm2();
-            auto similarity = std::exp(-1 * gammaVal * gammaVal * prototypeDistance * prototypeDistance);
-            similarityToPrototypes[i] = similarity;
+            prototypeNorms[j] = _B.GetColumn(j).Norm2Squared();
+        }
+
+        // Similarity to each prototype
+        auto gammaSquared = _gamma * _gamma;
+        for (size_t i = 0; i < batchSize; ++i)
+        {
+            auto inputNorm = projectedInputs.GetRow(i).Norm2Squared();
+            auto similarities = similarityToPrototypes.GetRow(i);
+            for (size_t j = 0; j < numPrototypes; ++j)
+            {
+                auto squaredDistance = std::max(similarities[j] + inputNorm + prototypeNorms[j], 0.0);
+                similarities[j] = std::exp(-gammaSquared * squaredDistance);
+            }
         }
 
         // Get the prediction label
-        math::ColumnVector<double> labels(GetNumLabels());
-        math::MultiplyScaleAddUpdate(1.0, GetLabelEmbeddings(), similarityToPrototypes, 0.0, labels); // TODO due to the zero, there is a more appropriate operation
+        math::RowMatrix<double> labels(batchSize, GetNumLabels());
+        math::MultiplyScaleAddUpdate(1.0, similarityToPrototypes, _Z.Transpose(), 0.0, labels);
 
         return labels;
     }
@@ -86,6 +109,15 @@ namespace predictors
         return labels;
     }
 
+    math::RowMatrix<double> ProtoNNPredictor::Predict(math::ConstRowMatrixReference<double> inputs) const
+    {
+        if (inputs.NumColumns() != GetDimension())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "ProtoNNPredictor: the number of input columns must match the predictor dimension");
+        }
+        return GetLabelScores(inputs);
+    }
+
     void ProtoNNPredictor::WriteToArchive(utilities::Archiver& archiver) const
     {
         archiver["dim"] << _dimension;
@@ -11,3 +11,4 @@
 #include <testing/include/testing.h>
 
 void ForestPredictorTest();
+void FlatForestPredictorTest();
@@ -6,10 +6,13 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <predictors/include/FlatForestPredictor.h>
 #include <predictors/include/ForestPredictor.h>
 
 #include <testing/include/testing.h>
 
+#include <random>
+
 using namespace ell;
 
 void ForestPredictorTest()
@@ -65,3 +68,58 @@ void ForestPredictorTest()
     auto edgeIndicator = forest.GetEdgeIndicatorVector(ExampleType{ 0.25, 0.7, 0.0 });
     testing::ProcessTest("Testing ForestPredictor, SetEdgeIndicatorVector()", testing::IsEqual(edgeIndicator, std::vector<bool>{ 1, 0, 0, 1, 0, 0, 0, 1 }));
 }
+
+void FlatForestPredictorTest()
+{
+    using SplitAction = predictors::SimpleForestPredictor::SplitAction;
+    using SplitRule = predictors::SingleElementThresholdPredictor;
+    using EdgePredictorVector = std::vector<predictors::ConstantPredictor>;
+
+    // build a forest with trees of different depths
+    predictors::SimpleForestPredictor forest;
+    auto root = forest.Split(SplitAction{ forest.GetNewRootId(), SplitRule{ 0, 0.3 }, EdgePredictorVector{ -1.0, 1.0 } });
+    auto child = forest.Split(SplitAction{ forest.GetChildId(root, 0), SplitRule{ 1, 0.6 }, EdgePredictorVector{ -2.0, 2.0 } });
+    forest.Split(SplitAction{ forest.GetChildId(child, 1), SplitRule{ 3, 0.4 }, EdgePredictorVector{ -2.5, 2.5 } });
+    forest.Split(SplitAction{ forest.GetChildId(root, 1), SplitRule{ 2, 0.9 }, EdgePredictorVector{ -4.0, 4.0 } });
+    forest.Split(SplitAction{ forest.GetNewRootId(), SplitRule{ 0, 0.2 }, EdgePredictorVector{ -3.0, 3.0 } });
+    forest.AddToBias(0.25);
+
+    predictors::FlatForestPredictor flatForest(forest);
+    testing::ProcessTest("Testing FlatForestPredictor, NumTrees()", flatForest.NumTrees() == 2);
+    testing::ProcessTest("Testing FlatForestPredictor, NumNodes()", flatForest.NumNodes() == 12);
+    testing::ProcessTest("Testing FlatForestPredictor, NumFeatures()", flatForest.NumFeatures() == 4);
+    testing::ProcessTest("Testing FlatForestPredictor, GetTreeDepth()", flatForest.GetTreeDepth(0) == 3 && flatForest.GetTreeDepth(1) == 1);
+
+    // compare with the original forest on random inputs
+    const size_t numInputs = 37;
+    const size_t numFeatures = 4;
+    std::default_random_engine engine(1234);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<float> inputs(numInputs * numFeatures);
+    std::generate(inputs.begin(), inputs.end(), [&] { return distribution(engine); });
+
+    std::vector<double> batchOutputs(numInputs);
+    flatForest.PredictBatch(inputs.data(), numInputs, numFeatures, batchOutputs.data());
+
+    bool predictOk = true;
+    bool treesOk = true;
+    bool edgesOk = true;
+    bool batchOk = true;
+    for (size_t index = 0; index < numInputs; ++index)
+    {
+        const float* input = inputs.data() + index * numFeatures;
+        predictors::SimpleForestPredictor::DataVectorType dataVector(std::vector<float>(input, input + numFeatures));
+        auto expected = forest.Predict(dataVector);
+        predictOk = predictOk && flatForest.Predict(input) == expected && flatForest.Predict(dataVector) == expected;
+        batchOk = batchOk && batchOutputs[index] == expected;
+        for (size_t treeIndex = 0; treeIndex < forest.NumTrees(); ++treeIndex)
+        {
+            treesOk = treesOk && flatForest.PredictTree(input, treeIndex) == forest.Predict(dataVector, forest.GetRootIndex(treeIndex));
+        }
+        edgesOk = edgesOk && flatForest.GetEdgeIndicatorVector(input) == forest.GetEdgeIndicatorVector(dataVector);
+    }
+    testing::ProcessTest("Testing FlatForestPredictor, Predict()", predictOk);
+    testing::ProcessTest("Testing FlatForestPredictor, PredictTree()", treesOk);
+    testing::ProcessTest("Testing FlatForestPredictor, PredictBatch()", batchOk);
+    testing::ProcessTest("Testing FlatForestPredictor, GetEdgeIndicatorVector()", edgesOk);
+}
@@ -10,9 +10,15 @@
 
 #include <testing/include/testing.h>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 using namespace ell;
 
-void ProtoNNPredictorTest()
+namespace
+{
+predictors::ProtoNNPredictor GetTestPredictor()
 {
     size_t dim = 5, projectedDim = 4, numPrototypes = 3, numLabels = 2;
     double gamma = 0.3;
@@ -43,6 +49,13 @@ void ProtoNNPredictorTest()
     Z(1, 0) = 0.2; Z(1, 1) = 0.4; Z(1, 2) = 0.8;
     // clang-format on
 
+    return protonnPredictor;
+}
+} // namespace
+
+void ProtoNNPredictorTest()
+{
+    auto protonnPredictor = GetTestPredictor();
     auto prediction = protonnPredictor.Predict(std::vector<double>{ 0.2, 0.5, 0.6, 0.8, 0.1 });
 
     auto maxElement = std::max_element(prediction.GetDataPointer(), prediction.GetDataPointer() + prediction.Size());
@@ -54,3 +67,81 @@ void ProtoNNPredictorTest()
     testing::ProcessTest("ProtoNNPredictorTest", testing::IsEqual(maxLabelIndex, R));
     testing::ProcessTest("ProtoNNPredictorTest", testing::IsEqual(*maxElement, score, 1e-6));
 }
+
+void ProtoNNPredictorBatchTest()
+{
+    auto protonnPredictor = GetTestPredictor();
+    std::vector<std::vector<double>> inputs = { { 0.2, 0.5, 0.6, 0.8, 0.1 }, { 0, 0, 0, 0, 0 }, { 1.0, -0.5, 0.25, 2.0, -1.0 }, { 3.3, 1.7, 2.9, 0.1, 1.3 } };
+    auto dimension = protonnPredictor.GetDimension();
+    auto projectedDimension = protonnPredictor.GetProjectedDimension();
+    auto numPrototypes = protonnPredictor.GetNumPrototypes();
+    auto numLabels = protonnPredictor.GetNumLabels();
+    auto W = protonnPredictor.GetProjectionMatrix().GetReference();
+    auto B = protonnPredictor.GetPrototypes().GetReference();
+    auto Z = protonnPredictor.GetLabelEmbeddings().GetReference();
+    auto gamma = protonnPredictor.GetGamma();
+
+    auto project = [&](const std::vector<double>& x) {
+        std::vector<double> projected(projectedDimension, 0.0);
+        for (size_t row = 0; row < projectedDimension; ++row)
+        {
+            for (size_t column = 0; column < dimension; ++column)
+            {
+                projected[row] += W(row, column) * x[column];
+            }
+        }
+        return projected;
+    };
+
+    // Move the last prototype onto the projection of the last input, so its squared distance is computed as a
+    // difference of nearly equal terms that can round to slightly below 0
+    auto projectedInput = project(inputs.back());
+    for (size_t row = 0; row < projectedDimension; ++row)
+    {
+        B(row, numPrototypes - 1) = projectedInput[row];
+    }
+
+    math::RowMatrix<double> batch(inputs.size(), dimension);
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        std::copy(inputs[i].begin(), inputs[i].end(), batch.GetRow(i).GetDataPointer());
+    }
+    auto batchPrediction = protonnPredictor.Predict(batch);
+
+    // Compare with scores computed directly, as Z * exp(-gamma^2 * ||Wx - p||^2)
+    bool ok = batchPrediction.NumRows() == inputs.size() && batchPrediction.NumColumns() == numLabels;
+    for (size_t i = 0; ok && i < inputs.size(); ++i)
+    {
+        auto projected = project(inputs[i]);
+        std::vector<double> expected(numLabels, 0.0);
+        for (size_t prototype = 0; prototype < numPrototypes; ++prototype)
+        {
+            double squaredDistance = 0;
+            for (size_t row = 0; row < projectedDimension; ++row)
+            {
+                auto difference = projected[row] - B(row, prototype);
+                squaredDistance += difference * difference;
+            }
+            auto similarity = std::exp(-gamma * gamma * squaredDistance);
+            for (size_t label = 0; label < numLabels; ++label)
+            {
+                expected[label] += Z(label, prototype) * similarity;
+            }
+        }
+
+        ok = testing::IsEqual(batchPrediction.GetRow(i).ToArray(), expected, 1e-10) &&
+             testing::IsEqual(protonnPredictor.Predict(inputs[i]).ToArray(), expected, 1e-10);
+
+        // Similarities are at most 1, which needs the squared distances to be clamped at 0
+        for (size_t label = 0; ok && label < numLabels; ++label)
+        {
+            double maxScore = 0;
+            for (size_t prototype = 0; prototype < numPrototypes; ++prototype)
+            {
+                maxScore += Z(label, prototype);
+            }
+            ok = batchPrediction(i, label) <= maxScore;
+        }
+    }
+    testing::ProcessTest("ProtoNNPredictorBatchTest", ok);
+}
@@ -19,6 +19,7 @@ int main()
 {
     // ForestPredictor
     ForestPredictorTest();
+    FlatForestPredictorTest();
 
     // LinearPredictor
     LinearPredictorTest<double>();
@@ -59,6 +60,7 @@ int main()
     BinaryConvolutionalArchiveTest<float>();
 
     ProtoNNPredictorTest();
+    ProtoNNPredictorBatchTest();
 
     if (testing::DidTestFail())
     {
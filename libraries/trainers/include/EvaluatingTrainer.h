@@ -12,6 +12,7 @@
 
 #include <evaluators/include/Evaluator.h>
 
+#include <future>
 #include <memory>
 
 namespace ell
@@ -20,7 +21,8 @@ namespace trainers
 {
     /// <summary>
     /// Implements an evaluating incremental trainer. This trainer contains another incremental
-    /// trainer and an evaluator, and performs an evaluation after each update.
+    /// trainer and an evaluator, and performs an evaluation after each update. The evaluation can
+    /// run in the background on a copy of the predictor, overlapping with the next update.
     /// </summary>
     ///
     /// <typeparam name="PredictorType"> The predictor type. </typeparam>
@@ -35,7 +37,8 @@ namespace trainers
         ///
         /// <param name="internalTrainer"> An incremental trainer. </param>
         /// <param name="evaluator"> An evaluator. </param>
-        EvaluatingTrainer(std::unique_ptr<InternalTrainerType>&& internalTrainer, std::shared_ptr<EvaluatorType> evaluator);
+        /// <param name="evaluateInBackground"> If true, each evaluation runs on its own thread while training continues. </param>
+        EvaluatingTrainer(std::unique_ptr<InternalTrainerType>&& internalTrainer, std::shared_ptr<EvaluatorType> evaluator, bool evaluateInBackground = false);
 
         /// <summary> Sets the trainer's dataset. </summary>
         ///
@@ -50,14 +53,18 @@ namespace trainers
         /// <returns> A const reference to the current predictor. </returns>
         const PredictorType& GetPredictor() const override { return _internalTrainer->GetPredictor(); }
 
-        /// <summary> Gets a const reference to the evaluator. </summary>
+        /// <summary> Gets a const reference to the evaluator, after waiting for any background evaluation to finish. </summary>
         ///
         /// <returns> A shared pointer to the evaluator. </returns>
-        virtual const std::shared_ptr<const EvaluatorType> GetEvaluator() const { return _evaluator; }
+        virtual const std::shared_ptr<const EvaluatorType> GetEvaluator() const;
 
     private:
+        void WaitForEvaluation() const;
+
         std::unique_ptr<InternalTrainerType> _internalTrainer;
         std::shared_ptr<EvaluatorType> _evaluator;
+        bool _evaluateInBackground = false;
+        mutable std::future<void> _pendingEvaluation; // declared last, so it's waited for before the other members are destroyed
     };
 
     /// <summary> Makes an evaluating trainer. </summary>
@@ -65,12 +72,14 @@ namespace trainers
     /// <typeparam name="PredictorType"> Type of the predictor returned by this trainer. </typeparam>
     /// <param name="internalTrainer"> An incremental trainer. </param>
     /// <param name="evaluator"> An evaluator. </param>
+    /// <param name="evaluateInBackground"> If true, each evaluation runs on its own thread while training continues. </param>
     ///
     /// <returns> A unique_ptr to an evaluating trainer. </returns>
     template <typename PredictorType>
     EvaluatingTrainer<PredictorType> MakeEvaluatingTrainer(
         std::unique_ptr<ITrainer<PredictorType>>&& internalTrainer,
-        std::shared_ptr<evaluators::IEvaluator<PredictorType>> evaluator);
+        std::shared_ptr<evaluators::IEvaluator<PredictorType>> evaluator,
+        bool evaluateInBackground = false);
 } // namespace trainers
 } // namespace ell
 
@@ -85,9 +94,11 @@ namespace trainers
     template <typename PredictorType>
     EvaluatingTrainer<PredictorType>::EvaluatingTrainer(
         std::unique_ptr<InternalTrainerType>&& internalTrainer,
-        std::shared_ptr<EvaluatorType> evaluator) :
+        std::shared_ptr<EvaluatorType> evaluator,
+        bool evaluateInBackground) :
         _internalTrainer(std::move(internalTrainer)),
-        _evaluator(evaluator)
+        _evaluator(evaluator),
+        _evaluateInBackground(evaluateInBackground)
     {
         assert(_internalTrainer != nullptr);
         assert(_evaluator != nullptr);
@@ -103,15 +114,42 @@ namespace trainers
     void EvaluatingTrainer<PredictorType>::Update()
     {
         _internalTrainer->Update();
-        _evaluator->Evaluate(_internalTrainer->GetPredictor());
+        if (!_evaluateInBackground)
+        {
+            _evaluator->Evaluate(_internalTrainer->GetPredictor());
+            return;
+        }
+
+        // The evaluator isn't reentrant, so evaluations run one at a time, in order
+        WaitForEvaluation();
+        _pendingEvaluation = std::async(std::launch::async, [evaluator = _evaluator, predictor = _internalTrainer->GetPredictor()]() {
+            evaluator->Evaluate(predictor);
+        });
+    }
+
+    template <typename PredictorType>
+    auto EvaluatingTrainer<PredictorType>::GetEvaluator() const -> const std::shared_ptr<const EvaluatorType>
+    {
+        WaitForEvaluation();
+        return _evaluator;
+    }
+
+    template <typename PredictorType>
+    void EvaluatingTrainer<PredictorType>::WaitForEvaluation() const
+    {
+        if (_pendingEvaluation.valid())
+        {
+            _pendingEvaluation.get();
+        }
     }
 
     template <typename PredictorType>
     EvaluatingTrainer<PredictorType> MakeEvaluatingTrainer(
         std::unique_ptr<ITrainer<PredictorType>>&& internalTrainer,
-        std::shared_ptr<evaluators::IEvaluator<PredictorType>> evaluator)
+        std::shared_ptr<evaluators::IEvaluator<PredictorType>> evaluator,
+        bool evaluateInBackground)
     {
-        return EvaluatingTrainer<PredictorType>(std::move(internalTrainer), evaluator);
+        return EvaluatingTrainer<PredictorType>(std::move(internalTrainer), evaluator, evaluateInBackground);
     }
 } // namespace trainers
 } // namespace ell
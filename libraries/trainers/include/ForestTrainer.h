@@ -45,6 +45,7 @@ namespace trainers
             double sumWeightedLabels = 0;
 
             void Increment(const data::WeightLabel& weightLabel);
+            Sums& operator+=(const Sums& other);
             Sums operator-(const Sums& other) const;
             double GetMeanLabel() const;
             void Print(std::ostream& os) const;
@@ -84,6 +85,9 @@ namespace trainers
 
             // the output of the forest on this example
             double currentOutput = 0;
+
+            // the position of this example in the dataset given to SetDataset, which stays the same when the dataset is reordered
+            size_t exampleIndex = 0;
         };
 
         // keeps statistics about tree nodes
@@ -238,6 +242,7 @@ namespace trainers
             auto& metadata = example.GetMetadata();
             metadata.currentOutput = prediction;
             metadata.weak = _booster.GetWeakWeightLabel(metadata.strong, prediction);
+            metadata.exampleIndex = rowIndex;
         }
     }
 
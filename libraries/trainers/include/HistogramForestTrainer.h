@@ -10,12 +10,19 @@
 
 #include "ForestTrainer.h"
 #include "LogitBooster.h"
+#include "ThresholdFinder.h"
 
 #include <predictors/include/ConstantPredictor.h>
 #include <predictors/include/SingleElementThresholdPredictor.h>
 
+#include <utilities/include/ThreadPool.h>
+
+#include <cstdint>
+#include <memory>
 #include <random>
 #include <tuple>
+#include <unordered_map>
+#include <vector>
 
 namespace ell
 {
@@ -27,6 +34,15 @@ namespace trainers
         std::string randomSeed;
         size_t thresholdFinderSampleSize;
         size_t candidatesPerInput;
+
+        /// <summary>
+        /// If nonzero, each feature is bucketed into at most this many bins (up to 256) when the dataset is set, and
+        /// splits are found from per-node histograms of the bins instead of calling the threshold finder.
+        /// </summary>
+        size_t numBins = 0;
+
+        /// <summary> The number of threads used to build histograms. If zero, uses the hardware concurrency of the machine. </summary>
+        size_t numThreads = 0;
     };
 
     /// <summary> A histogram trainer for binary decision forests with threshold split rules and constant outputs. </summary>
@@ -54,11 +70,41 @@ namespace trainers
         using typename ForestTrainer<SplitRuleType, EdgePredictorType, BoosterType>::Range;
         using typename ForestTrainer<SplitRuleType, EdgePredictorType, BoosterType>::Sums;
 
+        /// <summary> Sets the trainer's dataset, and buckets its features if the trainer uses histograms of binned features. </summary>
+        ///
+        /// <param name="anyDataset"> A dataset. </param>
+        void SetDataset(const data::AnyDataset& anyDataset) override;
+
     protected:
         using ForestTrainer<SplitRuleType, EdgePredictorType, BoosterType>::_dataset;
+        using ForestTrainer<SplitRuleType, EdgePredictorType, BoosterType>::_parameters;
         SplitCandidate GetBestSplitRuleAtNode(SplittableNodeId nodeId, Range range, Sums sums) override;
         std::vector<EdgePredictorType> GetEdgePredictors(const NodeStats& nodeStats) override;
 
+        // the total weights and weak labels of the examples in one bin of a feature
+        struct HistogramBin
+        {
+            Sums sums;
+            size_t count = 0;
+        };
+
+        // bins of all features of a node, stored feature by feature
+        using Histogram = std::vector<HistogramBin>;
+
+        struct NodeHistogram
+        {
+            Range range;
+            Histogram histogram;
+        };
+
+        // gets the histogram of a node, by subtraction from its parent's histogram when it's the larger child of a split
+        Histogram GetNodeHistogram(const Range& range);
+
+        // computes the histogram of a node directly from the binned features of its examples
+        Histogram ComputeHistogram(const Range& range);
+
+        std::unordered_map<size_t, NodeHistogram> _nodeHistograms; // histograms of nodes that will be split, by the first index of their range
+
     private:
         struct EvaluateSplitRuleResult
         {
@@ -70,12 +116,21 @@ namespace trainers
         std::vector<SplitRuleType> CallThresholdFinder(Range range);
         std::tuple<Sums, size_t> EvaluateSplitRule(const SplitRuleType& splitRule, const Range& range) const;
 
+        void BinFeatures();
+        SplitCandidate GetBestBinnedSplitRuleAtNode(SplittableNodeId nodeId, Range range, Sums sums);
+
         // member variables
         LossFunctionType _lossFunction;
         ThresholdFinderType _thresholdFinder;
         std::default_random_engine _random;
         size_t _thresholdFinderSampleSize;
         size_t _candidatesPerInput;
+
+        // binned features
+        size_t _numBins;
+        std::unique_ptr<utilities::ThreadPool> _threadPool;
+        std::vector<std::vector<double>> _binThresholds; // the thresholds between the bins of each feature
+        std::vector<uint8_t> _binnedFeatures; // bin index of each feature of each example, indexed by [feature * numExamples + exampleIndex]
     };
 
     /// <summary> Makes a simple forest trainer. </summary>
@@ -92,8 +147,11 @@ namespace trainers
 
 #pragma region implementation
 
+#include <utilities/include/Exception.h>
 #include <utilities/include/RandomEngines.h>
 
+#include <algorithm>
+
 namespace ell
 {
 namespace trainers
@@ -105,17 +163,43 @@ namespace trainers
         _thresholdFinder(thresholdFinder),
         _random(utilities::GetRandomEngine(parameters.randomSeed)),
         _thresholdFinderSampleSize(parameters.thresholdFinderSampleSize),
-        _candidatesPerInput(parameters.candidatesPerInput)
+        _candidatesPerInput(parameters.candidatesPerInput),
+        _numBins(parameters.numBins)
     {
+        if (_numBins > 256)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "numBins must be at most 256");
+        }
+
+        if (_numBins > 0)
+        {
+            _threadPool = std::make_unique<utilities::ThreadPool>(parameters.numThreads);
+        }
+    }
+
+    template <typename LossFunctionType, typename BoosterType, typename ThresholdFinderType>
+    void HistogramForestTrainer<LossFunctionType, BoosterType, ThresholdFinderType>::SetDataset(const data::AnyDataset& anyDataset)
+    {
+        ForestTrainer<SplitRuleType, EdgePredictorType, BoosterType>::SetDataset(anyDataset);
+        if (_numBins > 0)
+        {
+            BinFeatures();
+        }
     }
 
     template <typename LossFunctionType, typename BoosterType, typename ThresholdFinderType>
     auto HistogramForestTrainer<LossFunctionType, BoosterType, ThresholdFinderType>::GetBestSplitRuleAtNode(SplittableNodeId nodeId, Range range, Sums sums) -> SplitCandidate
     {
+        if (_numBins > 0)
+        {
+            return GetBestBinnedSplitRuleAtNode(nodeId, range, sums);
+        }
+
         SplitCandidate bestSplitCandidate(nodeId, range, sums);
 
         auto splitRuleCandidates = CallThresholdFinder(range);
 
+        size_t bestSize0 = 0;
         for (const auto& splitRuleCandidate : splitRuleCandidates)
         {
             Sums sums0;
@@ -131,11 +215,13 @@ namespace trainers
             {
                 bestSplitCandidate.gain = gain;
                 bestSplitCandidate.splitRule = splitRuleCandidate;
-                bestSplitCandidate.ranges.SplitChildRange(0, size0);
                 bestSplitCandidate.stats.SetChildSums({ sums0, sums1 });
+                bestSize0 = size0;
             }
         }
 
+        // the child ranges can only be split once
+        bestSplitCandidate.ranges.SplitChildRange(0, bestSize0);
         return bestSplitCandidate;
     }
 
@@ -193,6 +279,170 @@ namespace trainers
         return std::make_tuple(sums0, size0);
     };
 
+    template <typename LossFunctionType, typename BoosterType, typename ThresholdFinderType>
+    void HistogramForestTrainer<LossFunctionType, BoosterType, ThresholdFinderType>::BinFeatures()
+    {
+        const auto numExamples = _dataset.NumExamples();
+        const auto numFeatures = _dataset.NumFeatures();
+
+        // place the bin thresholds at the quantiles of a random sample of the examples
+        _dataset.RandomPermute(_random, _thresholdFinderSampleSize);
+        QuantileThresholdFinder thresholdFinder(_numBins - 1);
+        auto thresholds = thresholdFinder.GetThresholds(_dataset.GetExampleReferenceIterator(0, _thresholdFinderSampleSize));
+
+        _binThresholds.assign(numFeatures, {});
+        for (const auto& threshold : thresholds)
+        {
+            _binThresholds[threshold.GetElementIndex()].push_back(threshold.GetThreshold());
+        }
+
+        // the bin of a value is the number of thresholds below it, so bin b holds the values that satisfy threshold b but not b-1
+        _binnedFeatures.assign(numFeatures * numExamples, 0);
+        _threadPool->ParallelFor(numExamples, [this, numExamples, numFeatures](size_t rowIndex) {
+            const auto& example = _dataset[rowIndex];
+            const auto& dataVector = example.GetDataVector();
+            const auto exampleIndex = example.GetMetadata().exampleIndex;
+            for (size_t feature = 0; feature < numFeatures; ++feature)
+            {
+                const auto& featureThresholds = _binThresholds[feature];
+                auto bin = std::lower_bound(featureThresholds.begin(), featureThresholds.end(), dataVector[feature]) - featureThresholds.begin();
+                _binnedFeatures[feature * numExamples + exampleIndex] = static_cast<uint8_t>(bin);
+            }
+        });
+    }
+
+    template <typename LossFunctionType, typename BoosterType, typename ThresholdFinderType>
+    auto HistogramForestTrainer<LossFunctionType, BoosterType, ThresholdFinderType>::GetBestBinnedSplitRuleAtNode(SplittableNodeId nodeId, Range range, Sums sums) -> SplitCandidate
+    {
+        // the weak labels change on every boosting round, so histograms from the previous round can't be reused
+        if (range.firstIndex == 0 && range.size == _dataset.NumExamples())
+        {
+            _nodeHistograms.clear();
+        }
+
+        auto histogram = GetNodeHistogram(range);
+
+        // find the best threshold of each feature in parallel, by sweeping over its bins
+        struct FeatureSplit
+        {
+            double gain = 0;
+            size_t thresholdIndex = 0;
+            Sums sums0;
+            size_t size0 = 0;
+        };
+
+        const auto numFeatures = _binThresholds.size();
+        std::vector<FeatureSplit> featureSplits(numFeatures);
+        _threadPool->ParallelFor(numFeatures, [&](size_t feature) {
+            const auto featureHistogram = histogram.data() + feature * _numBins;
+            auto& featureSplit = featureSplits[feature];
+            Sums sums0;
+            size_t size0 = 0;
+            for (size_t thresholdIndex = 0; thresholdIndex < _binThresholds[feature].size(); ++thresholdIndex)
+            {
+                sums0 += featureHistogram[thresholdIndex].sums;
+                size0 += featureHistogram[thresholdIndex].count;
+                double gain = CalculateGain(sums, sums0, sums - sums0);
+                if (gain > featureSplit.gain)
+                {
+                    featureSplit = { gain, thresholdIndex, sums0, size0 };
+                }
+            }
+        });
+
+        SplitCandidate bestSplitCandidate(nodeId, range, sums);
+        size_t bestSize0 = 0;
+        for (size_t feature = 0; feature < numFeatures; ++feature)
+        {
+            const auto& featureSplit = featureSplits[feature];
+            if (featureSplit.gain > bestSplitCandidate.gain)
+            {
+                bestSplitCandidate.gain = featureSplit.gain;
+                bestSplitCandidate.splitRule = SplitRuleType{ feature, _binThresholds[feature][featureSplit.thresholdIndex] };
+                bestSplitCandidate.stats.SetChildSums({ featureSplit.sums0, sums - featureSplit.sums0 });
+                bestSize0 = featureSplit.size0;
+            }
+        }
+        bestSplitCandidate.ranges.SplitChildRange(0, bestSize0);
+
+        // keep the histogram of a node that's going to be split, so its children can use the sibling-subtraction trick
+        if (bestSplitCandidate.gain > 0 && bestSplitCandidate.gain >= _parameters.minSplitGain)
+        {
+            _nodeHistograms[range.firstIndex] = { range, std::move(histogram) };
+        }
+
+        return bestSplitCandidate;
+    }
+
+    template <typename LossFunctionType, typename BoosterType, typename ThresholdFinderType>
+    auto HistogramForestTrainer<LossFunctionType, BoosterType, ThresholdFinderType>::GetNodeHistogram(const Range& range) -> Histogram
+    {
+        // After a node is split, its first child starts at the same index as the node, and the second child follows it
+        auto iter = _nodeHistograms.find(range.firstIndex);
+        if (iter == _nodeHistograms.end() || iter->second.range.size < range.size)
+        {
+            return ComputeHistogram(range);
+        }
+
+        auto stored = std::move(iter->second);
+        _nodeHistograms.erase(iter);
+        if (stored.range.size == range.size)
+        {
+            // the second child of a split, whose histogram was computed along with its sibling
+            return std::move(stored.histogram);
+        }
+
+        // the first child of a split: compute the histogram of the smaller child directly, and get the
+        // larger one by subtracting it from the parent
+        Range sibling{ range.firstIndex + range.size, stored.range.size - range.size };
+        const bool isSmaller = range.size <= sibling.size;
+        auto smallerHistogram = ComputeHistogram(isSmaller ? range : sibling);
+        auto& largerHistogram = stored.histogram;
+        for (size_t index = 0; index < largerHistogram.size(); ++index)
+        {
+            largerHistogram[index].sums = largerHistogram[index].sums - smallerHistogram[index].sums;
+            largerHistogram[index].count -= smallerHistogram[index].count;
+        }
+
+        if (isSmaller)
+        {
+            _nodeHistograms[sibling.firstIndex] = { sibling, std::move(largerHistogram) };
+            return smallerHistogram;
+        }
+        _nodeHistograms[sibling.firstIndex] = { sibling, std::move(smallerHistogram) };
+        return std::move(largerHistogram);
+    }
+
+    template <typename LossFunctionType, typename BoosterType, typename ThresholdFinderType>
+    auto HistogramForestTrainer<LossFunctionType, BoosterType, ThresholdFinderType>::ComputeHistogram(const Range& range) -> Histogram
+    {
+        // gather the example indices and weak labels of the range once, so the passes over the features read them sequentially
+        std::vector<size_t> exampleIndices(range.size);
+        std::vector<data::WeightLabel> weightLabels(range.size);
+        for (size_t index = 0; index < range.size; ++index)
+        {
+            const auto& metadata = _dataset[range.firstIndex + index].GetMetadata();
+            exampleIndices[index] = metadata.exampleIndex;
+            weightLabels[index] = metadata.weak;
+        }
+
+        const auto numExamples = _dataset.NumExamples();
+        const auto numFeatures = _binThresholds.size();
+        Histogram histogram(numFeatures * _numBins);
+        _threadPool->ParallelFor(numFeatures, [&](size_t feature) {
+            const auto featureBins = _binnedFeatures.data() + feature * numExamples;
+            const auto featureHistogram = histogram.data() + feature * _numBins;
+            for (size_t index = 0; index < range.size; ++index)
+            {
+                auto& bin = featureHistogram[featureBins[exampleIndices[index]]];
+                bin.sums.Increment(weightLabels[index]);
+                ++bin.count;
+            }
+        });
+
+        return histogram;
+    }
+
     template <typename LossFunctionType, typename BoosterType, typename ThresholdFinderType>
     std::unique_ptr<ITrainer<predictors::SimpleForestPredictor>> MakeHistogramForestTrainer(const LossFunctionType& lossFunction, const BoosterType& booster, const ThresholdFinderType& thresholdFinder, const HistogramForestTrainerParameters& parameters)
     {
@@ -17,7 +17,13 @@
 
 #include <math/include/Vector.h>
 
+#include <utilities/include/ThreadPool.h>
+
+#include <cstddef>
+#include <memory>
 #include <random>
+#include <string>
+#include <vector>
 
 namespace ell
 {
@@ -31,6 +37,17 @@ namespace trainers
         size_t maxEpochs;
         bool permute;
         std::string randomSeedString;
+
+        /// <summary>
+        /// The number of threads used by SDCATrainer. If greater than one, the trainer takes mini-batch steps: the
+        /// threads compute the dual steps of `miniBatchSize` examples each against the same solution, and the steps
+        /// are then added to the solution one by one. Each dual step is shortened by the size of the mini-batch, which
+        /// keeps the combined step an ascent step. If zero, uses the hardware concurrency of the machine.
+        /// </summary>
+        size_t numThreads = 1;
+
+        /// <summary> The number of examples each thread processes per mini-batch, when `numThreads` is not one. </summary>
+        size_t miniBatchSize = 16;
     };
 
     /// <summary> Information about the result of an SDCA training session. </summary>
@@ -93,6 +110,8 @@ namespace trainers
         using TrainerExampleType = data::Example<DataVectorType, TrainerMetadata>;
 
         void Step(TrainerExampleType& x);
+        double GetDualStep(const TrainerExampleType& x, double stepScale) const;
+        void AddDualStep(TrainerExampleType& x, double dualDiff);
         void ComputeObjectives();
         void ResizeTo(const data::AutoDataVector& x);
 
@@ -110,6 +129,10 @@ namespace trainers
         math::ColumnVector<double> _v;
         double _d = 0;
         math::RowVector<double> _a;
+
+        // mini-batch state: the dual step of each example in the current mini-batch
+        std::unique_ptr<utilities::ThreadPool> _threadPool;
+        std::vector<double> _dualSteps;
     };
 
     //
@@ -132,8 +155,11 @@ namespace trainers
 
 #include <data/include/DataVectorOperations.h>
 
+#include <utilities/include/Exception.h>
 #include <utilities/include/RandomEngines.h>
 
+#include <algorithm>
+
 namespace ell
 {
 namespace trainers
@@ -145,6 +171,17 @@ namespace trainers
         _parameters(parameters)
     {
         _random = utilities::GetRandomEngine(parameters.randomSeedString);
+        if (parameters.numThreads != 1)
+        {
+            if (parameters.miniBatchSize == 0)
+            {
+                throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "miniBatchSize must be positive");
+            }
+
+            // the calling thread works on the loop too
+            _threadPool = std::make_unique<utilities::ThreadPool>(parameters.numThreads == 0 ? 0 : parameters.numThreads - 1);
+            _dualSteps.resize((_threadPool->NumThreads() + 1) * parameters.miniBatchSize);
+        }
     }
 
     template <typename LossFunctionType, typename RegularizerType>
@@ -159,11 +196,12 @@ namespace trainers
         _predictorInfo.primalObjective = 0;
         _predictorInfo.dualObjective = 0;
 
-        // precompute the norm of each example
+        // precompute the norm of each example, and size the solution to fit all of them
         for (size_t rowIndex = 0; rowIndex < numExamples; ++rowIndex)
         {
             auto& example = _dataset[rowIndex];
             example.GetMetadata().norm2Squared = example.GetDataVector().Norm2Squared();
+            ResizeTo(example.GetDataVector());
 
             auto label = example.GetMetadata().weightLabel.label;
             _predictorInfo.primalObjective += _lossFunction(0, label) / numExamples;
@@ -179,9 +217,32 @@ namespace trainers
         }
 
         // Iterate
-        for (size_t i = 0; i < _dataset.NumExamples(); ++i)
+        if (_threadPool == nullptr)
         {
-            Step(_dataset[i]);
+            for (size_t i = 0; i < _dataset.NumExamples(); ++i)
+            {
+                Step(_dataset[i]);
+            }
+        }
+        else
+        {
+            // The threads only read the solution and each writes the dual steps of its own examples, so the mini-batch
+            // needs no locking. The steps are then added to the solution on this thread.
+            auto numExamples = _dataset.NumExamples();
+            for (size_t begin = 0; begin < numExamples; begin += _dualSteps.size())
+            {
+                auto batchSize = std::min(_dualSteps.size(), numExamples - begin);
+                auto stepScale = static_cast<double>(batchSize);
+                _threadPool->ParallelFor(
+                    batchSize,
+                    [this, begin, stepScale](size_t i) { _dualSteps[i] = GetDualStep(_dataset[begin + i], stepScale); },
+                    _parameters.miniBatchSize);
+
+                for (size_t i = 0; i < batchSize; ++i)
+                {
+                    AddDualStep(_dataset[begin + i], _dualSteps[i]);
+                }
+            }
         }
 
         // Finish
@@ -196,28 +257,41 @@ namespace trainers
     template <typename LossFunctionType, typename RegularizerType>
     void SDCATrainer<LossFunctionType, RegularizerType>::Step(TrainerExampleType& example)
     {
-        const auto& dataVector = example.GetDataVector();
-        ResizeTo(dataVector);
+        AddDualStep(example, GetDualStep(example, 1.0));
+    }
 
+    template <typename LossFunctionType, typename RegularizerType>
+    double SDCATrainer<LossFunctionType, RegularizerType>::GetDualStep(const TrainerExampleType& example, double stepScale) const
+    {
         auto weightLabel = example.GetMetadata().weightLabel;
         auto norm2Squared = example.GetMetadata().norm2Squared + 1; // add one because of bias term
-        auto lipschitz = norm2Squared * _inverseScaledRegularization;
+        auto lipschitz = stepScale * norm2Squared * _inverseScaledRegularization;
         auto dual = example.GetMetadata().dualVariable;
 
         if (lipschitz > 0)
         {
-            auto prediction = _predictor.Predict(dataVector);
-
+            auto prediction = _predictor.Predict(example.GetDataVector());
             auto newDual = _lossFunction.ConjugateProx(1.0 / lipschitz, dual + prediction / lipschitz, weightLabel.label);
-            auto dualDiff = newDual - dual;
+            return newDual - dual;
+        }
+        return 0;
+    }
 
-            if (dualDiff != 0)
-            {
-                _v.Transpose() += (-dualDiff * _inverseScaledRegularization) * dataVector;
-                _d += (-dualDiff * _inverseScaledRegularization);
-                _regularizer.ConjugateGradient(_v, _d, _predictor.GetWeights(), _predictor.GetBias());
-                example.GetMetadata().dualVariable = newDual;
-            }
+    template <typename LossFunctionType, typename RegularizerType>
+    void SDCATrainer<LossFunctionType, RegularizerType>::AddDualStep(TrainerExampleType& example, double dualDiff)
+    {
+        if (dualDiff != 0)
+        {
+            // v only changes where the example is nonzero, and the regularizer is separable, so only those
+            // coordinates of the weights need to be recomputed
+            const auto& dataVector = example.GetDataVector();
+            auto scale = -dualDiff * _inverseScaledRegularization;
+            auto& weights = _predictor.GetWeights();
+            dataVector.template AddTransformedTo<data::IterationPolicy::skipZeros>(_v.Transpose(), [scale](data::IndexValue x) { return scale * x.value; });
+            dataVector.template AddTransformedTo<data::IterationPolicy::skipZeros>(weights.Transpose(), [&](data::IndexValue x) { return _regularizer.ConjugateGradient(_v[x.index]) - weights[x.index]; });
+            _d += scale;
+            _predictor.GetBias() = _regularizer.ConjugateGradient(_d);
+            example.GetMetadata().dualVariable += dualDiff;
         }
     }
 
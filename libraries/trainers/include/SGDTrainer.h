@@ -15,10 +15,15 @@
 #include <data/include/Dataset.h>
 #include <data/include/Example.h>
 
+#include <utilities/include/Exception.h>
+#include <utilities/include/ThreadPool.h>
+
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <random>
 #include <string>
+#include <vector>
 
 namespace ell
 {
@@ -29,6 +34,17 @@ namespace trainers
     {
         double regularization;
         std::string randomSeedString;
+
+        /// <summary>
+        /// The number of threads used by SGDTrainer. If greater than one, the trainer takes mini-batch steps: the
+        /// threads compute the loss gradients of `miniBatchSize` examples each at the current predictor, and a single
+        /// step is taken along their average. If zero, uses the hardware concurrency of the machine. The sparse data
+        /// trainers are always sequential.
+        /// </summary>
+        size_t numThreads = 1;
+
+        /// <summary> The number of examples each thread processes per step, when `numThreads` is not one. </summary>
+        size_t miniBatchSize = 16;
     };
 
     /// <summary>
@@ -84,6 +100,9 @@ namespace trainers
         /// <param name="parameters"> The training parameters. </param>
         SGDTrainer(const LossFunctionType& lossFunction, const SGDTrainerParameters& parameters);
 
+        /// <summary> Updates the state of the trainer by performing a learning epoch. </summary>
+        void Update() override;
+
         /// <summary> Returns a const reference to the last predictor. </summary>
         ///
         /// <returns> A const reference to the last predictor. </returns>
@@ -106,7 +125,14 @@ namespace trainers
         PredictorType _lastPredictor;
         PredictorType _averagedPredictor;
 
+        // mini-batch state: one gradient sum per thread
+        std::unique_ptr<utilities::ThreadPool> _threadPool;
+        std::vector<math::ColumnVector<double>> _gradients;
+        std::vector<double> _biasGradients;
+
         void ResizeTo(const data::AutoDataVector& x);
+        void MiniBatchStep(size_t begin, size_t end);
+        void UpdatePredictors(double scaleCoefficient);
     };
 
     //
@@ -284,6 +310,48 @@ namespace trainers
         _lossFunction(lossFunction),
         _parameters(parameters)
     {
+        if (parameters.numThreads != 1)
+        {
+            if (parameters.miniBatchSize == 0)
+            {
+                throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "miniBatchSize must be positive");
+            }
+
+            // the calling thread works on the loop too
+            _threadPool = std::make_unique<utilities::ThreadPool>(parameters.numThreads == 0 ? 0 : parameters.numThreads - 1);
+            _gradients.resize(_threadPool->NumThreads() + 1);
+            _biasGradients.resize(_gradients.size());
+        }
+    }
+
+    template <typename LossFunctionType>
+    void SGDTrainer<LossFunctionType>::Update()
+    {
+        if (_threadPool == nullptr)
+        {
+            SGDTrainerBase::Update();
+            return;
+        }
+
+        _dataset.RandomPermute(_random);
+        _firstIteration = false;
+
+        // size the predictors up front, since the threads share them
+        const auto numExamples = _dataset.NumExamples();
+        for (size_t i = 0; i < numExamples; ++i)
+        {
+            ResizeTo(_dataset[i].GetDataVector());
+        }
+        for (auto& gradient : _gradients)
+        {
+            gradient.Resize(_lastPredictor.Size());
+        }
+
+        const auto batchSize = _gradients.size() * _parameters.miniBatchSize;
+        for (size_t begin = 0; begin < numExamples; begin += batchSize)
+        {
+            MiniBatchStep(begin, std::min(begin + batchSize, numExamples));
+        }
     }
 
     template <typename LossFunctionType>
@@ -318,7 +386,65 @@ namespace trainers
         lastW.Transpose() += updateCoefficient * x;
         lastB += updateCoefficient;
 
+        UpdatePredictors(scaleCoefficient);
+    }
+
+    template <typename LossFunctionType>
+    void SGDTrainer<LossFunctionType>::MiniBatchStep(size_t begin, size_t end)
+    {
+        const auto miniBatchSize = _parameters.miniBatchSize;
+        const auto numActiveThreads = (end - begin + miniBatchSize - 1) / miniBatchSize;
+
+        // each thread sums the weighted loss derivatives of its examples, at the current predictor
+        _threadPool->ParallelFor(
+            numActiveThreads,
+            [&](size_t threadIndex) {
+                auto& gradient = _gradients[threadIndex];
+                auto& biasGradient = _biasGradients[threadIndex];
+                gradient.Reset();
+                biasGradient = 0;
+
+                auto threadEnd = std::min(begin + (threadIndex + 1) * miniBatchSize, end);
+                for (size_t i = begin + threadIndex * miniBatchSize; i < threadEnd; ++i)
+                {
+                    const auto& example = _dataset[i];
+                    const auto& x = example.GetDataVector();
+                    double p = _lastPredictor.Predict(x);
+                    double g = example.GetMetadata().weight * _lossFunction.GetDerivative(p, example.GetMetadata().label);
+                    gradient.Transpose() += g * x;
+                    biasGradient += g;
+                }
+            },
+            1);
+
+        ++_t;
+
+        // get abbreviated names
+        auto& lastW = _lastPredictor.GetWeights();
+        double& lastB = _lastPredictor.GetBias();
+
+        // update the (last) predictor with the average gradient
+        double scaleCoefficient = 1.0 - 1.0 / _t;
+        lastW *= scaleCoefficient;
+        lastB *= scaleCoefficient;
+
+        const double lambda = _parameters.regularization;
+        double updateCoefficient = -1.0 / (lambda * _t * (end - begin));
+        for (size_t threadIndex = 0; threadIndex < numActiveThreads; ++threadIndex)
+        {
+            lastW += updateCoefficient * _gradients[threadIndex];
+            lastB += updateCoefficient * _biasGradients[threadIndex];
+        }
+
+        UpdatePredictors(scaleCoefficient);
+    }
+
+    template <typename LossFunctionType>
+    void SGDTrainer<LossFunctionType>::UpdatePredictors(double scaleCoefficient)
+    {
         // get abbreviated names
+        const auto& lastW = _lastPredictor.GetWeights();
+        double lastB = _lastPredictor.GetBias();
         auto& averagedW = _averagedPredictor.GetWeights();
         double& averagedB = _averagedPredictor.GetBias();
 
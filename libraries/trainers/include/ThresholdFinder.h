@@ -61,6 +61,31 @@ namespace trainers
         template <typename ExampleIteratorType>
         std::vector<predictors::SingleElementThresholdPredictor> GetThresholds(ExampleIteratorType exampleIterator) const;
     };
+
+    /// <summary>
+    /// A threshold finder that places a bounded number of thresholds on each feature, at the weighted
+    /// quantiles of the feature's values. Features with few unique values get all possible thresholds.
+    /// </summary>
+    class QuantileThresholdFinder : public ThresholdFinder
+    {
+    public:
+        /// <summary> Constructs an instance of QuantileThresholdFinder. </summary>
+        ///
+        /// <param name="maxThresholdsPerFeature"> The maximum number of thresholds to place on each feature. </param>
+        QuantileThresholdFinder(size_t maxThresholdsPerFeature);
+
+        /// <summary> Returns a vector of SingleElementThresholdPredictor, sorted by feature index and then by threshold. </summary>
+        ///
+        /// <typeparam name="ExampleIteratorType"> Type of example iterator. </typeparam>
+        /// <param name="exampleIterator"> The example iterator. </param>
+        ///
+        /// <returns> The thresholds. </returns>
+        template <typename ExampleIteratorType>
+        std::vector<predictors::SingleElementThresholdPredictor> GetThresholds(ExampleIteratorType exampleIterator) const;
+
+    private:
+        size_t _maxThresholdsPerFeature;
+    };
 } // namespace trainers
 } // namespace ell
 
@@ -125,6 +150,47 @@ namespace trainers
 
         return thresholdPredictors;
     }
+
+    template <typename ExampleIteratorType>
+    std::vector<predictors::SingleElementThresholdPredictor> trainers::QuantileThresholdFinder::GetThresholds(ExampleIteratorType exampleIterator) const
+    {
+        auto uniqueValuesResult = UniqueValues(exampleIterator);
+        std::vector<predictors::SingleElementThresholdPredictor> thresholdPredictors;
+
+        for (size_t j = 0; j < uniqueValuesResult.weightedValues.size(); ++j)
+        {
+            const auto& featureValues = uniqueValuesResult.weightedValues[j];
+            if (featureValues.size() <= _maxThresholdsPerFeature + 1)
+            {
+                for (size_t i = 0; i + 1 < featureValues.size(); ++i)
+                {
+                    thresholdPredictors.push_back({ j, 0.5 * (featureValues[i].value + featureValues[i + 1].value) });
+                }
+                continue;
+            }
+
+            // place the k'th threshold after the value where the cumulative weight first reaches k/(numThresholds+1) of the total
+            double featureWeight = 0.0;
+            for (const auto& valueWeight : featureValues)
+            {
+                featureWeight += valueWeight.weight;
+            }
+
+            size_t numThresholds = 0;
+            double cumulativeWeight = 0.0;
+            for (size_t i = 0; i + 1 < featureValues.size() && numThresholds < _maxThresholdsPerFeature; ++i)
+            {
+                cumulativeWeight += featureValues[i].weight;
+                if (cumulativeWeight * (_maxThresholdsPerFeature + 1) >= featureWeight * (numThresholds + 1))
+                {
+                    thresholdPredictors.push_back({ j, 0.5 * (featureValues[i].value + featureValues[i + 1].value) });
+                    ++numThresholds;
+                }
+            }
+        }
+
+        return thresholdPredictors;
+    }
 } // namespace trainers
 } // namespace ell
 
@@ -23,6 +23,13 @@ namespace trainers
         sumWeightedLabels += weightLabel.weight * weightLabel.label;
     }
 
+    typename ForestTrainerBase::Sums& ForestTrainerBase::Sums::operator+=(const Sums& other)
+    {
+        sumWeights += other.sumWeights;
+        sumWeightedLabels += other.sumWeightedLabels;
+        return *this;
+    }
+
     typename ForestTrainerBase::Sums ForestTrainerBase::Sums::operator-(const Sums& other) const
     {
         Sums difference;
@@ -40,5 +40,10 @@ namespace trainers
         }
         return current - begin + 1;
     }
+
+    QuantileThresholdFinder::QuantileThresholdFinder(size_t maxThresholdsPerFeature) :
+        _maxThresholdsPerFeature(maxThresholdsPerFeature)
+    {
+    }
 } // namespace trainers
 } // namespace ell
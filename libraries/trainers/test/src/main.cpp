@@ -8,22 +8,33 @@
 
 #include <data/include/Dataset.h>
 
+#include <evaluators/include/LossAggregator.h>
+
 #include <functions/include/L2Regularizer.h>
 #include <functions/include/LogLoss.h>
 #include <functions/include/SquaredLoss.h>
 
+#include <trainers/include/EvaluatingTrainer.h>
+#include <trainers/include/HistogramForestTrainer.h>
+#include <trainers/include/LogitBooster.h>
 #include <trainers/include/MeanCalculator.h>
 #include <trainers/include/SDCATrainer.h>
 #include <trainers/include/SGDTrainer.h>
 
 #include <testing/include/testing.h>
 
+#include <utilities/include/RandomEngines.h>
+
+#include <random>
+#include <sstream>
+#include <string>
+
 using namespace ell;
 
 /// Runs all tests
 ///
 
-void TestSDCATrainer()
+void TestSDCATrainer(size_t numThreads)
 {
     data::AutoSupervisedDataset dataset;
     dataset.AddExample({ { 1.0, 0.0, 2.0, 0.0, 3.0 }, { 1.0, 1.0 } });
@@ -31,7 +42,7 @@ void TestSDCATrainer()
     dataset.AddExample({ { 8.0, 0.0, 9.0 }, { 1.0, 1.0 } });
     dataset.AddExample({ { 0.0, 10.0 }, { 1.0, -1.0 } });
 
-    auto trainer = trainers::MakeSDCATrainer(functions::LogLoss(), functions::L2Regularizer(), { 1.0e-4, 1.0e-8, 20, false, "XYZ" });
+    auto trainer = trainers::MakeSDCATrainer(functions::LogLoss(), functions::L2Regularizer(), { 1.0e-4, 1.0e-8, 20, false, "XYZ", numThreads, 1 });
     trainer->SetDataset(dataset.GetAnyDataset());
 
     double error = 0;
@@ -54,12 +65,12 @@ void TestSDCATrainer()
         printf("TestSDCATrainer error is %f\n", error);
     }
 
-    testing::ProcessTest("TestSDCATrainer", error < 0.01);
+    testing::ProcessTest("TestSDCATrainer with " + std::to_string(numThreads) + " threads", error < 0.01);
 
     return;
 }
 
-void TestSGDTrainer()
+void TestSGDTrainer(size_t numThreads, size_t miniBatchSize)
 {
     data::AutoSupervisedDataset dataset;
     // sepal.length, sepal.width, petal.length => petal.width for IRIS
@@ -82,7 +93,7 @@ void TestSGDTrainer()
     dataset.AddExample({ { 5.4, 1.3 }, { 1.0, 4 } });
     dataset.AddExample({ { 5.1, 1.4 }, { 1.0, 3 } });
 
-    auto trainer = trainers::MakeSGDTrainer(functions::SquaredLoss(), { 4, "XYZ" });
+    auto trainer = trainers::MakeSGDTrainer(functions::SquaredLoss(), { 4, "XYZ", numThreads, miniBatchSize });
     trainer->SetDataset(dataset.GetAnyDataset());
 
     double error = 0;
@@ -112,11 +123,39 @@ void TestSGDTrainer()
     }
     auto bias = trainer->GetPredictor().GetBias();
     printf("bias == %f\n", bias);
-    testing::ProcessTest("TestSDGTrainer, final cumulative error", error < 10);
+    testing::ProcessTest("TestSDGTrainer with " + std::to_string(numThreads) + " threads, final cumulative error", error < 10);
 
     return;
 }
 
+void TestEvaluatingTrainer()
+{
+    data::AutoSupervisedDataset dataset;
+    for (int index = 0; index < 50; ++index)
+    {
+        double x = (index % 10) / 10.0;
+        dataset.AddExample({ { x, 1.0 - x }, { 1.0, 2 * x + 1 } });
+    }
+
+    // Evaluating in the background must produce the same log as evaluating in line
+    auto runTrainer = [&](bool evaluateInBackground) {
+        using PredictorType = predictors::LinearPredictor<double>;
+        evaluators::EvaluatorParameters evaluatorParameters{ 1, true };
+        auto evaluator = evaluators::MakeEvaluator<PredictorType>(dataset.GetAnyDataset(), evaluatorParameters, evaluators::MakeLossAggregator(functions::SquaredLoss()));
+        auto trainer = trainers::MakeEvaluatingTrainer(trainers::MakeSGDTrainer(functions::SquaredLoss(), { 1, "XYZ" }), evaluator, evaluateInBackground);
+        trainer.SetDataset(dataset.GetAnyDataset());
+        for (int epoch = 0; epoch < 5; ++epoch)
+        {
+            trainer.Update();
+        }
+        std::stringstream log;
+        trainer.GetEvaluator()->Print(log);
+        return log.str();
+    };
+
+    testing::ProcessTest("EvaluatingTrainer background evaluation", runTrainer(false) == runTrainer(true));
+}
+
 void TestMeanCalculator()
 {
     data::AutoSupervisedDataset dataset;
@@ -131,9 +170,136 @@ void TestMeanCalculator()
     testing::ProcessTest("TestMeanCalculator", mean == r);
 }
 
+// the label is positive inside a box in the first two elements, and the third element is noise
+static data::AutoSupervisedDataset GetHistogramForestTrainerDataset()
+{
+    data::AutoSupervisedDataset dataset;
+    auto randomEngine = utilities::GetRandomEngine("123");
+    std::uniform_real_distribution<double> uniform(0, 1);
+    for (size_t i = 0; i < 500; ++i)
+    {
+        double x0 = uniform(randomEngine);
+        double x1 = uniform(randomEngine);
+        double x2 = uniform(randomEngine);
+        double label = (x0 > 0.3 && x0 < 0.7 && x1 > 0.5) ? 1.0 : -1.0;
+        dataset.AddExample({ { x0, x1, x2 }, { 1.0, label } });
+    }
+    return dataset;
+}
+
+static trainers::HistogramForestTrainerParameters GetHistogramForestTrainerParameters(size_t numBins)
+{
+    trainers::HistogramForestTrainerParameters parameters;
+    parameters.minSplitGain = 0.0;
+    parameters.maxSplitsPerRound = 4;
+    parameters.numRounds = 8;
+    parameters.randomSeed = "XYZ";
+    parameters.thresholdFinderSampleSize = 500;
+    parameters.candidatesPerInput = 8;
+    parameters.numBins = numBins;
+    parameters.numThreads = 2;
+    return parameters;
+}
+
+void TestHistogramForestTrainer(size_t numBins)
+{
+    auto dataset = GetHistogramForestTrainerDataset();
+    auto parameters = GetHistogramForestTrainerParameters(numBins);
+
+    auto trainer = trainers::MakeHistogramForestTrainer(functions::SquaredLoss(), trainers::LogitBooster(), trainers::ExhaustiveThresholdFinder(), parameters);
+    trainer->SetDataset(dataset.GetAnyDataset());
+    trainer->Update();
+
+    const auto& predictor = trainer->GetPredictor();
+    size_t numErrors = 0;
+    for (size_t i = 0; i < dataset.NumExamples(); ++i)
+    {
+        const auto& example = dataset[i];
+        auto prediction = predictor.Predict(example.GetDataVector().CopyAs<data::FloatDataVector>());
+        if (prediction * example.GetMetadata().label <= 0)
+        {
+            ++numErrors;
+        }
+    }
+    printf("TestHistogramForestTrainer with %zu bins: %zu errors\n", numBins, numErrors);
+
+    testing::ProcessTest("TestHistogramForestTrainer with " + std::to_string(numBins) + " bins", numErrors < dataset.NumExamples() / 20);
+}
+
+// exposes the histograms of HistogramForestTrainer, to compare the ones built by subtraction with the ones computed directly
+template <typename LossFunctionType, typename BoosterType, typename ThresholdFinderType>
+class HistogramForestTrainerTester : public trainers::HistogramForestTrainer<LossFunctionType, BoosterType, ThresholdFinderType>
+{
+public:
+    using Base = trainers::HistogramForestTrainer<LossFunctionType, BoosterType, ThresholdFinderType>;
+    using Base::Base;
+    using typename Base::Histogram;
+    using typename Base::Range;
+
+    // gets the histograms of the two children of a root split after its first `firstChildSize` examples, the way
+    // the trainer gets them after the split, and checks them against the directly computed histograms
+    bool ChildHistogramsMatch(size_t firstChildSize)
+    {
+        auto numExamples = this->_dataset.NumExamples();
+        Range root{ 0, numExamples };
+        Range firstChild{ 0, firstChildSize };
+        Range secondChild{ firstChildSize, numExamples - firstChildSize };
+
+        this->_nodeHistograms.clear();
+        this->_nodeHistograms[root.firstIndex] = { root, this->ComputeHistogram(root) };
+        auto firstHistogram = this->GetNodeHistogram(firstChild);
+        auto secondHistogram = this->GetNodeHistogram(secondChild);
+
+        return HistogramsMatch(firstHistogram, this->ComputeHistogram(firstChild)) && HistogramsMatch(secondHistogram, this->ComputeHistogram(secondChild));
+    }
+
+private:
+    static bool HistogramsMatch(const Histogram& histogram, const Histogram& expected)
+    {
+        if (histogram.size() != expected.size())
+        {
+            return false;
+        }
+        for (size_t index = 0; index < histogram.size(); ++index)
+        {
+            if (histogram[index].count != expected[index].count ||
+                !testing::IsEqual(histogram[index].sums.sumWeights, expected[index].sums.sumWeights, 1.0e-9) ||
+                !testing::IsEqual(histogram[index].sums.sumWeightedLabels, expected[index].sums.sumWeightedLabels, 1.0e-9))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+void TestHistogramForestTrainerSubtraction(size_t numBins)
+{
+    auto dataset = GetHistogramForestTrainerDataset();
+    auto parameters = GetHistogramForestTrainerParameters(numBins);
+
+    // train a round first, so the examples have nonzero weak labels
+    HistogramForestTrainerTester<functions::SquaredLoss, trainers::LogitBooster, trainers::ExhaustiveThresholdFinder> trainer(functions::SquaredLoss(), trainers::LogitBooster(), trainers::ExhaustiveThresholdFinder(), parameters);
+    trainer.SetDataset(dataset.GetAnyDataset());
+    trainer.Update();
+
+    // the smaller child is computed directly and the larger one by subtraction, so try the larger child in either position
+    auto numExamples = dataset.NumExamples();
+    bool ok = trainer.ChildHistogramsMatch(numExamples / 4) && trainer.ChildHistogramsMatch(numExamples - numExamples / 4);
+    testing::ProcessTest("TestHistogramForestTrainerSubtraction with " + std::to_string(numBins) + " bins", ok);
+}
+
 int main()
 {
-    TestSDCATrainer();
-    TestSGDTrainer();
+    TestSDCATrainer(1);
+    TestSDCATrainer(2);
+    TestSGDTrainer(1, 1);
+    TestSGDTrainer(2, 2);
+    TestEvaluatingTrainer();
     TestMeanCalculator();
+    TestHistogramForestTrainer(0);
+    TestHistogramForestTrainer(16);
+    TestHistogramForestTrainer(256);
+    TestHistogramForestTrainerSubtraction(16);
+    TestHistogramForestTrainerSubtraction(256);
 }
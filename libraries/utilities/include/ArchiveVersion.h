@@ -28,6 +28,7 @@ namespace utilities
         v8_port_memory_layout = 8,
         v9_activation_objects = 9, // move activation from template parameters to member objects.
         v10_memory_layout_update = 10,
+        v11_automatic_tile_sizes = 11, // MatrixMatrixMultiplyCodeNode tile sizes of 0 mean "automatic"
         nextVersion
     };
 
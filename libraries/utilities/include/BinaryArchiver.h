@@ -0,0 +1,166 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     BinaryArchiver.h (utilities)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Archiver.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace utilities
+{
+    /// <summary>
+    /// An archiver that encodes data in a compact binary format. The archive is a sequence of tagged,
+    /// named records in native byte order. The contents of arrays of fundamental types are written
+    /// uncompressed and start on a 64-byte boundary relative to the beginning of the archive, so an
+    /// archive that is memory-mapped can be read without any parsing of the array data.
+    /// </summary>
+    class BinaryArchiver : public Archiver
+    {
+    public:
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="outputStream"> The stream to write data to. </param>
+        BinaryArchiver(std::ostream& outputStream);
+
+        /// <summary> The alignment, in bytes, of array data relative to the beginning of the archive. </summary>
+        static constexpr size_t arrayAlignment = 64;
+
+    protected:
+#define ARCHIVE_TYPE_OP(t) DECLARE_ARCHIVE_VALUE_OVERRIDE(t);
+        ARCHIVABLE_TYPES_LIST
+#undef ARCHIVE_TYPE_OP
+
+        void ArchiveValue(const char* name, const std::string& value) override;
+
+#define ARCHIVE_TYPE_OP(t) DECLARE_ARCHIVE_ARRAY_OVERRIDE(t);
+        ARCHIVABLE_TYPES_LIST
+#undef ARCHIVE_TYPE_OP
+
+        void ArchiveNull(const char* name) override;
+
+        void ArchiveArray(const char* name, const std::vector<std::string>& array) override;
+        void ArchiveArray(const char* name, const std::string& baseTypeName, const std::vector<const IArchivable*>& array) override;
+
+        void BeginArchiveObject(const char* name, const IArchivable& value) override;
+        void EndArchiveObject(const char* name, const IArchivable& value) override;
+
+    private:
+        template <typename ValueType>
+        void WriteScalar(const char* name, const ValueType& value);
+
+        template <typename ValueType>
+        void WriteArray(const char* name, const std::vector<ValueType>& array);
+
+        void WriteRecordHeader(uint8_t tag, const char* name);
+        void WriteString(const std::string& str);
+        void WriteBytes(const void* data, size_t size);
+        void WritePadding(size_t alignment);
+
+        std::ostream& _out;
+        uint64_t _position = 0;
+        std::string _pendingName; // name of an object that is archived as a primitive value
+    };
+
+    /// <summary>
+    /// An unarchiver that reads data encoded by a `BinaryArchiver`. The unarchiver can either read
+    /// the archive from a stream, or directly from a block of memory (for instance, a memory-mapped file)
+    /// that stays valid for the lifetime of the unarchiver.
+    /// </summary>
+    class BinaryUnarchiver : public Unarchiver
+    {
+    public:
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="inputStream"> The stream to read data from. The entire stream is read into memory. </param>
+        /// <param name="context"> The initial `SerializationContext` to use. </param>
+        BinaryUnarchiver(std::istream& inputStream, SerializationContext context);
+
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="data"> A pointer to the archive data. The data isn't copied, and must remain valid while the unarchiver is in use. </param>
+        /// <param name="size"> The size of the archive data, in bytes. </param>
+        /// <param name="context"> The initial `SerializationContext` to use. </param>
+        BinaryUnarchiver(const char* data, size_t size, SerializationContext context);
+
+        /// <summary> Indicates if a property with the given name is available to be read next </summary>
+        ///
+        /// <param name="name"> The name of the property </param>
+        ///
+        /// <returns> true if a property with the given name can be read next </returns>
+        bool HasNextPropertyName(const std::string& name) override;
+
+        /// <summary> Indicates if a block of memory starts with the header written by a `BinaryArchiver`. </summary>
+        ///
+        /// <param name="data"> A pointer to the data. </param>
+        /// <param name="size"> The size of the data, in bytes. </param>
+        ///
+        /// <returns> true if the data looks like a binary archive. </returns>
+        static bool IsBinaryArchive(const char* data, size_t size);
+
+        /// <summary> Indicates if a stream starts with the header written by a `BinaryArchiver`. Reads the header bytes from the stream. </summary>
+        ///
+        /// <param name="stream"> The stream to read from. </param>
+        ///
+        /// <returns> true if the stream looks like a binary archive. </returns>
+        static bool IsBinaryArchive(std::istream& stream);
+
+    protected:
+#define ARCHIVE_TYPE_OP(t) DECLARE_UNARCHIVE_VALUE_OVERRIDE(t);
+        ARCHIVABLE_TYPES_LIST
+#undef ARCHIVE_TYPE_OP
+
+        void UnarchiveValue(const char* name, std::string& value) override;
+
+        bool UnarchiveNull(const char* name) override;
+
+#define ARCHIVE_TYPE_OP(t) DECLARE_UNARCHIVE_ARRAY_OVERRIDE(t);
+        ARCHIVABLE_TYPES_LIST
+#undef ARCHIVE_TYPE_OP
+
+        void UnarchiveArray(const char* name, std::vector<std::string>& array) override;
+
+        void BeginUnarchiveArray(const char* name, const std::string& typeName) override;
+        bool BeginUnarchiveArrayItem(const std::string& typeName) override;
+        void EndUnarchiveArrayItem(const std::string& typeName) override;
+        void EndUnarchiveArray(const char* name, const std::string& typeName) override;
+
+        ArchivedObjectInfo BeginUnarchiveObject(const char* name, const std::string& typeName) override;
+        void EndUnarchiveObject(const char* name, const std::string& typeName) override;
+
+    private:
+        template <typename ValueType>
+        void ReadScalar(const char* name, ValueType& value);
+
+        template <typename ValueType>
+        void ReadArray(const char* name, std::vector<ValueType>& array);
+
+        void ReadHeader();
+        void ReadRecordHeader(uint8_t tag, const char* name);
+        bool TryPeekRecordHeader(uint8_t& tag, std::string& name);
+        std::string ReadString();
+        const char* ReadBytes(size_t size);
+        void SkipPadding(size_t alignment);
+
+        template <typename ValueType>
+        ValueType ReadRaw();
+
+        std::vector<uint64_t> _buffer; // holds the archive when it's read from a stream
+        const char* _data = nullptr;
+        size_t _size = 0;
+        size_t _position = 0;
+    };
+} // namespace utilities
+} // namespace ell
@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MemoryMappedFile.h (utilities)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace ell
+{
+namespace utilities
+{
+    /// <summary> A read-only view of the contents of a file, mapped into memory. </summary>
+    class MemoryMappedFile
+    {
+    public:
+        /// <summary> Maps a file into memory. Throws a `SystemException` if the file can't be opened. </summary>
+        ///
+        /// <param name="filepath"> The path of the file. </param>
+        explicit MemoryMappedFile(const std::string& filepath);
+
+        MemoryMappedFile(const MemoryMappedFile&) = delete;
+        MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+        /// <summary> Destructor. Unmaps the file. </summary>
+        ~MemoryMappedFile();
+
+        /// <summary> Returns a pointer to the contents of the file. The pointer is aligned to a page boundary. </summary>
+        ///
+        /// <returns> A pointer to the file contents, or `nullptr` if the file is empty. </returns>
+        const char* GetData() const { return _data; }
+
+        /// <summary> Returns the size of the file. </summary>
+        ///
+        /// <returns> The size of the file, in bytes. </returns>
+        size_t GetSize() const { return _size; }
+
+    private:
+        const char* _data = nullptr;
+        size_t _size = 0;
+#ifdef WIN32
+        void* _fileHandle = nullptr;
+        void* _mappingHandle = nullptr;
+#endif
+    };
+} // namespace utilities
+} // namespace ell
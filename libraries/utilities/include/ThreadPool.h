@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ThreadPool.h (utilities)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ell
+{
+namespace utilities
+{
+    /// <summary>
+    /// A set of persistent worker threads that run parallel loops. The thread calling `ParallelFor` works on
+    /// the loop too, so a loop always finishes even if every worker is busy. That makes it safe to call
+    /// `ParallelFor` from inside the body of another `ParallelFor` on the same pool.
+    /// </summary>
+    class ThreadPool
+    {
+    public:
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="numThreads"> The number of worker threads to create. If zero, uses the hardware concurrency of the machine. </param>
+        explicit ThreadPool(size_t numThreads = 0);
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /// <summary> Destructor. Waits for the worker threads to finish. </summary>
+        ~ThreadPool();
+
+        /// <summary> Returns the number of worker threads in the pool. </summary>
+        ///
+        /// <returns> The number of worker threads. </returns>
+        size_t NumThreads() const { return _threads.size(); }
+
+        /// <summary>
+        /// Calls a function for every index in [0, count), and waits for all the calls to finish. Indices are handed
+        /// out in chunks of consecutive values. If any call throws, the remaining calls are skipped and the first
+        /// exception is rethrown on the calling thread.
+        /// </summary>
+        ///
+        /// <param name="count"> The number of indices. </param>
+        /// <param name="body"> The function to call with each index. </param>
+        /// <param name="chunkSize"> The number of consecutive indices a thread claims at once. If zero, picks a size that gives every thread a few chunks. </param>
+        void ParallelFor(size_t count, const std::function<void(size_t)>& body, size_t chunkSize = 0);
+
+    private:
+        struct Job;
+
+        void WorkerThread();
+        void RemoveJob(const std::shared_ptr<Job>& job);
+        static void RunChunks(Job& job);
+
+        std::vector<std::thread> _threads;
+        std::vector<std::shared_ptr<Job>> _jobs; // jobs that may still have unclaimed indices, most recent last
+        std::mutex _mutex;
+        std::condition_variable _workAvailable;
+        bool _stop = false;
+    };
+} // namespace utilities
+} // namespace ell
@@ -0,0 +1,521 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     BinaryArchiver.cpp (utilities)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "BinaryArchiver.h"
+#include "Exception.h"
+#include "IArchivable.h"
+#include "Unused.h"
+
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+namespace ell
+{
+namespace utilities
+{
+    namespace
+    {
+        // Every archive starts with this 8-byte header: a magic number followed by the format version
+        const char c_binaryArchiveMagic[4] = { 'E', 'L', 'L', 'B' };
+        constexpr uint32_t c_binaryArchiveFormatVersion = 1;
+        constexpr size_t c_headerSize = sizeof(c_binaryArchiveMagic) + sizeof(c_binaryArchiveFormatVersion);
+
+        // Every record starts with one of these tags, followed by the record's name
+        enum class RecordTag : uint8_t
+        {
+            scalar = 1,
+            string,
+            null,
+            array,
+            stringArray,
+            beginObject,
+            endObject,
+            beginObjectArray,
+            endObjectArray
+        };
+
+        // Scalar and array values are stored with a type code that encodes the kind of value in the high
+        // nibble and its size in bytes in the low nibble
+        enum class ValueKind : uint8_t
+        {
+            boolean = 0,
+            signedInteger = 1,
+            unsignedInteger = 2,
+            floatingPoint = 3
+        };
+
+        constexpr uint8_t MakeTypeCode(ValueKind kind, size_t size)
+        {
+            return static_cast<uint8_t>((static_cast<uint8_t>(kind) << 4) | size);
+        }
+
+        template <typename ValueType>
+        constexpr uint8_t GetTypeCode()
+        {
+            if (std::is_same<ValueType, bool>::value)
+            {
+                return MakeTypeCode(ValueKind::boolean, 1);
+            }
+            if (std::is_floating_point<ValueType>::value)
+            {
+                return MakeTypeCode(ValueKind::floatingPoint, sizeof(ValueType));
+            }
+            return MakeTypeCode(std::is_signed<ValueType>::value ? ValueKind::signedInteger : ValueKind::unsignedInteger, sizeof(ValueType));
+        }
+
+        size_t GetValueSize(uint8_t typeCode)
+        {
+            return typeCode & 0x0f;
+        }
+
+        template <typename ValueType>
+        ValueType LoadValue(const char* data)
+        {
+            ValueType value;
+            std::memcpy(&value, data, sizeof(ValueType));
+            return value;
+        }
+
+        // Reads a value stored with the given type code, converting it to the requested type
+        template <typename ValueType>
+        ValueType ConvertValue(const char* data, uint8_t typeCode)
+        {
+            switch (typeCode)
+            {
+            case GetTypeCode<bool>():
+                return static_cast<ValueType>(LoadValue<uint8_t>(data) != 0);
+            case GetTypeCode<int8_t>():
+                return static_cast<ValueType>(LoadValue<int8_t>(data));
+            case GetTypeCode<int16_t>():
+                return static_cast<ValueType>(LoadValue<int16_t>(data));
+            case GetTypeCode<int32_t>():
+                return static_cast<ValueType>(LoadValue<int32_t>(data));
+            case GetTypeCode<int64_t>():
+                return static_cast<ValueType>(LoadValue<int64_t>(data));
+            case GetTypeCode<uint8_t>():
+                return static_cast<ValueType>(LoadValue<uint8_t>(data));
+            case GetTypeCode<uint16_t>():
+                return static_cast<ValueType>(LoadValue<uint16_t>(data));
+            case GetTypeCode<uint32_t>():
+                return static_cast<ValueType>(LoadValue<uint32_t>(data));
+            case GetTypeCode<uint64_t>():
+                return static_cast<ValueType>(LoadValue<uint64_t>(data));
+            case GetTypeCode<float>():
+                return static_cast<ValueType>(LoadValue<float>(data));
+            case GetTypeCode<double>():
+                return static_cast<ValueType>(LoadValue<double>(data));
+            default:
+                throw DataFormatException(DataFormatErrors::badFormat, "Unknown value type in binary archive");
+            }
+        }
+
+        size_t GetPaddingSize(size_t position, size_t alignment)
+        {
+            return (alignment - (position % alignment)) % alignment;
+        }
+    } // namespace
+
+    //
+    // Serialization
+    //
+    BinaryArchiver::BinaryArchiver(std::ostream& outputStream) :
+        _out(outputStream)
+    {
+        WriteBytes(c_binaryArchiveMagic, sizeof(c_binaryArchiveMagic));
+        WriteBytes(&c_binaryArchiveFormatVersion, sizeof(c_binaryArchiveFormatVersion));
+    }
+
+#define ARCHIVE_TYPE_OP(t) IMPLEMENT_ARCHIVE_VALUE(BinaryArchiver, t);
+    ARCHIVABLE_TYPES_LIST
+#undef ARCHIVE_TYPE_OP
+
+    // strings
+    void BinaryArchiver::ArchiveValue(const char* name, const std::string& value)
+    {
+        WriteRecordHeader(static_cast<uint8_t>(RecordTag::string), name);
+        WriteString(value);
+    }
+
+    void BinaryArchiver::ArchiveNull(const char* name)
+    {
+        WriteRecordHeader(static_cast<uint8_t>(RecordTag::null), name);
+    }
+
+    // IArchivable
+    void BinaryArchiver::BeginArchiveObject(const char* name, const IArchivable& value)
+    {
+        if (value.ArchiveAsPrimitive())
+        {
+            // The object writes a single unnamed value, which gets this object's name
+            _pendingName = name;
+            return;
+        }
+
+        WriteRecordHeader(static_cast<uint8_t>(RecordTag::beginObject), name);
+        WriteString(GetArchivedTypeName(value));
+        int32_t version = GetArchiveVersion(value).versionNumber;
+        WriteBytes(&version, sizeof(version));
+    }
+
+    void BinaryArchiver::EndArchiveObject(const char* name, const IArchivable& value)
+    {
+        UNUSED(name);
+        if (!value.ArchiveAsPrimitive())
+        {
+            WriteRecordHeader(static_cast<uint8_t>(RecordTag::endObject), "");
+        }
+    }
+
+//
+// Arrays
+//
+#define ARCHIVE_TYPE_OP(t) IMPLEMENT_ARCHIVE_ARRAY(BinaryArchiver, t);
+    ARCHIVABLE_TYPES_LIST
+#undef ARCHIVE_TYPE_OP
+
+    void BinaryArchiver::ArchiveArray(const char* name, const std::vector<std::string>& array)
+    {
+        WriteRecordHeader(static_cast<uint8_t>(RecordTag::stringArray), name);
+        uint64_t count = array.size();
+        WriteBytes(&count, sizeof(count));
+        for (const auto& str : array)
+        {
+            WriteString(str);
+        }
+    }
+
+    void BinaryArchiver::ArchiveArray(const char* name, const std::string& baseTypeName, const std::vector<const IArchivable*>& array)
+    {
+        UNUSED(baseTypeName);
+        WriteRecordHeader(static_cast<uint8_t>(RecordTag::beginObjectArray), name);
+        for (auto item : array)
+        {
+            Archive(*item);
+        }
+        WriteRecordHeader(static_cast<uint8_t>(RecordTag::endObjectArray), "");
+    }
+
+    template <typename ValueType>
+    void BinaryArchiver::WriteScalar(const char* name, const ValueType& value)
+    {
+        WriteRecordHeader(static_cast<uint8_t>(RecordTag::scalar), name);
+        uint8_t typeCode = GetTypeCode<ValueType>();
+        WriteBytes(&typeCode, sizeof(typeCode));
+        if (std::is_same<ValueType, bool>::value)
+        {
+            uint8_t byteValue = value ? 1 : 0;
+            WriteBytes(&byteValue, sizeof(byteValue));
+        }
+        else
+        {
+            WriteBytes(&value, sizeof(ValueType));
+        }
+    }
+
+    template <typename ValueType>
+    void BinaryArchiver::WriteArray(const char* name, const std::vector<ValueType>& array)
+    {
+        WriteRecordHeader(static_cast<uint8_t>(RecordTag::array), name);
+        uint8_t typeCode = GetTypeCode<ValueType>();
+        uint64_t count = array.size();
+        WriteBytes(&typeCode, sizeof(typeCode));
+        WriteBytes(&count, sizeof(count));
+        WritePadding(arrayAlignment);
+        if constexpr (std::is_same<ValueType, bool>::value)
+        {
+            std::vector<uint8_t> bytes(array.begin(), array.end());
+            WriteBytes(bytes.data(), bytes.size());
+        }
+        else
+        {
+            WriteBytes(array.data(), array.size() * sizeof(ValueType));
+        }
+    }
+
+    void BinaryArchiver::WriteRecordHeader(uint8_t tag, const char* name)
+    {
+        WriteBytes(&tag, sizeof(tag));
+        if (name[0] == '\0' && !_pendingName.empty())
+        {
+            WriteString(_pendingName);
+        }
+        else
+        {
+            WriteString(name);
+        }
+        _pendingName.clear();
+    }
+
+    void BinaryArchiver::WriteString(const std::string& str)
+    {
+        uint64_t length = str.size();
+        WriteBytes(&length, sizeof(length));
+        WriteBytes(str.data(), str.size());
+    }
+
+    void BinaryArchiver::WriteBytes(const void* data, size_t size)
+    {
+        _out.write(static_cast<const char*>(data), size);
+        _position += size;
+    }
+
+    void BinaryArchiver::WritePadding(size_t alignment)
+    {
+        static const char zeros[arrayAlignment] = {};
+        WriteBytes(zeros, GetPaddingSize(_position, alignment));
+    }
+
+    //
+    // Deserialization
+    //
+    BinaryUnarchiver::BinaryUnarchiver(std::istream& inputStream, SerializationContext context) :
+        Unarchiver(std::move(context))
+    {
+        std::string contents{ std::istreambuf_iterator<char>(inputStream), std::istreambuf_iterator<char>() };
+
+        // Copy into a buffer of 8-byte words, so the array data keeps the alignment it has in the archive
+        _buffer.resize((contents.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        std::memcpy(_buffer.data(), contents.data(), contents.size());
+        _data = reinterpret_cast<const char*>(_buffer.data());
+        _size = contents.size();
+        ReadHeader();
+    }
+
+    BinaryUnarchiver::BinaryUnarchiver(const char* data, size_t size, SerializationContext context) :
+        Unarchiver(std::move(context)),
+        _data(data),
+        _size(size)
+    {
+        ReadHeader();
+    }
+
+    bool BinaryUnarchiver::IsBinaryArchive(const char* data, size_t size)
+    {
+        return size >= c_headerSize && std::memcmp(data, c_binaryArchiveMagic, sizeof(c_binaryArchiveMagic)) == 0;
+    }
+
+    bool BinaryUnarchiver::IsBinaryArchive(std::istream& stream)
+    {
+        char header[c_headerSize];
+        stream.read(header, c_headerSize);
+        return IsBinaryArchive(header, static_cast<size_t>(stream.gcount()));
+    }
+
+#define ARCHIVE_TYPE_OP(t) IMPLEMENT_UNARCHIVE_VALUE(BinaryUnarchiver, t);
+    ARCHIVABLE_TYPES_LIST
+#undef ARCHIVE_TYPE_OP
+
+    // strings
+    void BinaryUnarchiver::UnarchiveValue(const char* name, std::string& value)
+    {
+        ReadRecordHeader(static_cast<uint8_t>(RecordTag::string), name);
+        value = ReadString();
+    }
+
+    bool BinaryUnarchiver::UnarchiveNull(const char* name)
+    {
+        uint8_t tag;
+        std::string recordName;
+        if (TryPeekRecordHeader(tag, recordName) && tag == static_cast<uint8_t>(RecordTag::null) && (name[0] == '\0' || recordName == name))
+        {
+            ReadRecordHeader(tag, name);
+            return true;
+        }
+        return false;
+    }
+
+    bool BinaryUnarchiver::HasNextPropertyName(const std::string& name)
+    {
+        uint8_t tag;
+        std::string recordName;
+        return TryPeekRecordHeader(tag, recordName) && recordName == name;
+    }
+
+    // IArchivable
+    ArchivedObjectInfo BinaryUnarchiver::BeginUnarchiveObject(const char* name, const std::string& typeName)
+    {
+        UNUSED(typeName);
+        ReadRecordHeader(static_cast<uint8_t>(RecordTag::beginObject), name);
+        auto encodedTypeName = ReadString();
+        auto version = ReadRaw<int32_t>();
+        return { encodedTypeName, version };
+    }
+
+    void BinaryUnarchiver::EndUnarchiveObject(const char* name, const std::string& typeName)
+    {
+        UNUSED(name, typeName);
+        ReadRecordHeader(static_cast<uint8_t>(RecordTag::endObject), "");
+    }
+
+//
+// Arrays
+//
+#define ARCHIVE_TYPE_OP(t) IMPLEMENT_UNARCHIVE_ARRAY(BinaryUnarchiver, t);
+    ARCHIVABLE_TYPES_LIST
+#undef ARCHIVE_TYPE_OP
+
+    void BinaryUnarchiver::UnarchiveArray(const char* name, std::vector<std::string>& array)
+    {
+        ReadRecordHeader(static_cast<uint8_t>(RecordTag::stringArray), name);
+        auto count = ReadRaw<uint64_t>();
+        array.reserve(count);
+        for (uint64_t index = 0; index < count; ++index)
+        {
+            array.push_back(ReadString());
+        }
+    }
+
+    void BinaryUnarchiver::BeginUnarchiveArray(const char* name, const std::string& typeName)
+    {
+        UNUSED(typeName);
+        ReadRecordHeader(static_cast<uint8_t>(RecordTag::beginObjectArray), name);
+    }
+
+    bool BinaryUnarchiver::BeginUnarchiveArrayItem(const std::string& typeName)
+    {
+        UNUSED(typeName);
+        uint8_t tag;
+        std::string recordName;
+        if (!TryPeekRecordHeader(tag, recordName))
+        {
+            throw DataFormatException(DataFormatErrors::abruptEnd, "Binary archive ended in the middle of an array");
+        }
+        return tag != static_cast<uint8_t>(RecordTag::endObjectArray);
+    }
+
+    void BinaryUnarchiver::EndUnarchiveArrayItem(const std::string& typeName)
+    {
+        UNUSED(typeName);
+    }
+
+    void BinaryUnarchiver::EndUnarchiveArray(const char* name, const std::string& typeName)
+    {
+        UNUSED(name, typeName);
+        ReadRecordHeader(static_cast<uint8_t>(RecordTag::endObjectArray), "");
+    }
+
+    template <typename ValueType>
+    void BinaryUnarchiver::ReadScalar(const char* name, ValueType& value)
+    {
+        ReadRecordHeader(static_cast<uint8_t>(RecordTag::scalar), name);
+        auto typeCode = ReadRaw<uint8_t>();
+        value = ConvertValue<ValueType>(ReadBytes(GetValueSize(typeCode)), typeCode);
+    }
+
+    template <typename ValueType>
+    void BinaryUnarchiver::ReadArray(const char* name, std::vector<ValueType>& array)
+    {
+        ReadRecordHeader(static_cast<uint8_t>(RecordTag::array), name);
+        auto typeCode = ReadRaw<uint8_t>();
+        auto count = ReadRaw<uint64_t>();
+        SkipPadding(BinaryArchiver::arrayAlignment);
+
+        // Check the size before multiplying, so a corrupt count can't wrap around and pass the bounds check
+        auto valueSize = GetValueSize(typeCode);
+        if (valueSize == 0)
+        {
+            throw DataFormatException(DataFormatErrors::badFormat, "Unknown value type in binary archive");
+        }
+        if (count > (_size - _position) / valueSize)
+        {
+            throw DataFormatException(DataFormatErrors::abruptEnd, "Unexpected end of binary archive");
+        }
+        const char* data = ReadBytes(static_cast<size_t>(count * valueSize));
+        array.resize(count);
+        if constexpr (!std::is_same<ValueType, bool>::value)
+        {
+            if (typeCode == GetTypeCode<ValueType>())
+            {
+                // The common case: the data is stored with the requested type, so copy it in one block
+                std::memcpy(array.data(), data, count * valueSize);
+                return;
+            }
+        }
+
+        for (uint64_t index = 0; index < count; ++index)
+        {
+            array[index] = ConvertValue<ValueType>(data + index * valueSize, typeCode);
+        }
+    }
+
+    void BinaryUnarchiver::ReadHeader()
+    {
+        if (!IsBinaryArchive(_data, _size))
+        {
+            throw DataFormatException(DataFormatErrors::badFormat, "Data is not a binary ELL archive");
+        }
+
+        _position = sizeof(c_binaryArchiveMagic);
+        auto formatVersion = ReadRaw<uint32_t>();
+        if (formatVersion > c_binaryArchiveFormatVersion)
+        {
+            throw InputException(InputExceptionErrors::versionMismatch, "Binary archive was written by a newer version of ELL");
+        }
+    }
+
+    void BinaryUnarchiver::ReadRecordHeader(uint8_t tag, const char* name)
+    {
+        auto foundTag = ReadRaw<uint8_t>();
+        if (foundTag != tag)
+        {
+            throw DataFormatException(DataFormatErrors::badFormat, "Unexpected record type in binary archive");
+        }
+
+        auto foundName = ReadString();
+        if (name[0] != '\0' && foundName != name)
+        {
+            throw InputException(InputExceptionErrors::badStringFormat, std::string{ "Failed to match field " } + name + ", instead found '" + foundName + "'");
+        }
+    }
+
+    bool BinaryUnarchiver::TryPeekRecordHeader(uint8_t& tag, std::string& name)
+    {
+        if (_position >= _size)
+        {
+            return false;
+        }
+
+        auto savedPosition = _position;
+        tag = ReadRaw<uint8_t>();
+        name = ReadString();
+        _position = savedPosition;
+        return true;
+    }
+
+    std::string BinaryUnarchiver::ReadString()
+    {
+        auto length = ReadRaw<uint64_t>();
+        auto data = ReadBytes(length);
+        return std::string(data, data + length);
+    }
+
+    const char* BinaryUnarchiver::ReadBytes(size_t size)
+    {
+        if (size > _size - _position)
+        {
+            throw DataFormatException(DataFormatErrors::abruptEnd, "Unexpected end of binary archive");
+        }
+
+        auto result = _data + _position;
+        _position += size;
+        return result;
+    }
+
+    void BinaryUnarchiver::SkipPadding(size_t alignment)
+    {
+        ReadBytes(GetPaddingSize(_position, alignment));
+    }
+
+    template <typename ValueType>
+    ValueType BinaryUnarchiver::ReadRaw()
+    {
+        return LoadValue<ValueType>(ReadBytes(sizeof(ValueType)));
+    }
+} // namespace utilities
+} // namespace ell
@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MemoryMappedFile.cpp (utilities)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "MemoryMappedFile.h"
+#include "Exception.h"
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // WIN32
+
+namespace ell
+{
+namespace utilities
+{
+#ifdef WIN32
+    MemoryMappedFile::MemoryMappedFile(const std::string& filepath)
+    {
+        auto file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            throw SystemException(SystemExceptionErrors::fileNotFound, "Unable to open file '" + filepath + "'");
+        }
+        _fileHandle = file;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            throw SystemException(SystemExceptionErrors::fileNotFound, "Unable to get the size of file '" + filepath + "'");
+        }
+        _size = static_cast<size_t>(size.QuadPart);
+        if (_size == 0)
+        {
+            return;
+        }
+
+        auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        auto view = mapping == nullptr ? nullptr : MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view == nullptr)
+        {
+            if (mapping != nullptr)
+            {
+                CloseHandle(mapping);
+            }
+            CloseHandle(file);
+            throw SystemException(SystemExceptionErrors::fileNotFound, "Unable to map file '" + filepath + "'");
+        }
+        _mappingHandle = mapping;
+        _data = static_cast<const char*>(view);
+    }
+
+    MemoryMappedFile::~MemoryMappedFile()
+    {
+        if (_data != nullptr)
+        {
+            UnmapViewOfFile(_data);
+        }
+        if (_mappingHandle != nullptr)
+        {
+            CloseHandle(_mappingHandle);
+        }
+        if (_fileHandle != nullptr)
+        {
+            CloseHandle(_fileHandle);
+        }
+    }
+#else
+    MemoryMappedFile::MemoryMappedFile(const std::string& filepath)
+    {
+        int fd = open(filepath.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw SystemException(SystemExceptionErrors::fileNotFound, "Unable to open file '" + filepath + "'");
+        }
+
+        struct stat fileInfo;
+        if (fstat(fd, &fileInfo) != 0)
+        {
+            close(fd);
+            throw SystemException(SystemExceptionErrors::fileNotFound, "Unable to get the size of file '" + filepath + "'");
+        }
+
+        _size = static_cast<size_t>(fileInfo.st_size);
+        if (_size > 0)
+        {
+            void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED)
+            {
+                close(fd);
+                throw SystemException(SystemExceptionErrors::fileNotFound, "Unable to map file '" + filepath + "'");
+            }
+            _data = static_cast<const char*>(data);
+        }
+
+        // The mapping stays valid after the file is closed
+        close(fd);
+    }
+
+    MemoryMappedFile::~MemoryMappedFile()
+    {
+        if (_data != nullptr)
+        {
+            munmap(const_cast<char*>(_data), _size);
+        }
+    }
+#endif // WIN32
+} // namespace utilities
+} // namespace ell
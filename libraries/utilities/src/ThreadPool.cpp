@@ -0,0 +1,180 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ThreadPool.cpp (utilities)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace ell
+{
+namespace utilities
+{
+    struct ThreadPool::Job
+    {
+        Job(size_t count, size_t chunkSize, const std::function<void(size_t)>& body) :
+            count(count),
+            chunkSize(chunkSize),
+            body(body),
+            remaining(count)
+        {
+        }
+
+        bool IsExhausted() const { return next.load() >= count; }
+
+        const size_t count;
+        const size_t chunkSize;
+        const std::function<void(size_t)>& body;
+
+        std::atomic<size_t> next = 0; // first index that hasn't been claimed yet
+        std::atomic<size_t> remaining; // number of indices that haven't finished yet
+        std::atomic<bool> failed = false;
+
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::exception_ptr exception;
+    };
+
+    ThreadPool::ThreadPool(size_t numThreads)
+    {
+        if (numThreads == 0)
+        {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        _threads.reserve(numThreads);
+        for (size_t i = 0; i < numThreads; ++i)
+        {
+            _threads.emplace_back([this] { WorkerThread(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _workAvailable.notify_all();
+        for (auto& thread : _threads)
+        {
+            thread.join();
+        }
+    }
+
+    void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& body, size_t chunkSize)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (chunkSize == 0)
+        {
+            // Aim for about 4 chunks per thread (counting the caller), to balance load without too much contention
+            chunkSize = std::max<size_t>(1, count / (4 * (NumThreads() + 1)));
+        }
+
+        auto job = std::make_shared<Job>(count, chunkSize, body);
+        if (count > chunkSize)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _jobs.push_back(job);
+            }
+            _workAvailable.notify_all();
+        }
+
+        // Work on our own loop, then wait for any chunks that other threads are still running
+        RunChunks(*job);
+        RemoveJob(job);
+        {
+            std::unique_lock<std::mutex> lock(job->mutex);
+            job->finished.wait(lock, [&job] { return job->remaining.load() == 0; });
+        }
+
+        if (job->exception)
+        {
+            std::rethrow_exception(job->exception);
+        }
+    }
+
+    void ThreadPool::WorkerThread()
+    {
+        while (true)
+        {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _workAvailable.wait(lock, [this] {
+                    // Drop jobs whose indices have all been claimed
+                    while (!_jobs.empty() && _jobs.back()->IsExhausted())
+                    {
+                        _jobs.pop_back();
+                    }
+                    return _stop || !_jobs.empty();
+                });
+
+                if (_stop)
+                {
+                    return;
+                }
+
+                // Prefer the most recent job, so nested loops finish and unblock their callers first
+                job = _jobs.back();
+            }
+
+            RunChunks(*job);
+        }
+    }
+
+    void ThreadPool::RemoveJob(const std::shared_ptr<Job>& job)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _jobs.erase(std::remove(_jobs.begin(), _jobs.end(), job), _jobs.end());
+    }
+
+    void ThreadPool::RunChunks(Job& job)
+    {
+        while (true)
+        {
+            auto begin = job.next.fetch_add(job.chunkSize);
+            if (begin >= job.count)
+            {
+                return;
+            }
+
+            auto end = std::min(begin + job.chunkSize, job.count);
+            for (auto index = begin; index < end && !job.failed.load(); ++index)
+            {
+                try
+                {
+                    job.body(index);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(job.mutex);
+                    if (!job.exception)
+                    {
+                        job.exception = std::current_exception();
+                    }
+                    job.failed = true;
+                }
+            }
+
+            auto numFinished = end - begin;
+            if (job.remaining.fetch_sub(numFinished) == numFinished)
+            {
+                std::lock_guard<std::mutex> lock(job.mutex);
+                job.finished.notify_all();
+            }
+        }
+    }
+} // namespace utilities
+} // namespace ell
@@ -18,4 +18,9 @@ void TestJsonUnarchiver();
 
 void TestXmlArchiver();
 void TestXmlUnarchiver();
+
+void TestBinaryArchiver();
+void TestBinaryUnarchiver();
+void TestBinaryArchiveArrayAlignment();
+void TestBinaryUnarchiverCorruptArrayCount();
 } // namespace ell
@@ -9,6 +9,7 @@
 #include "Archiver_test.h"
 
 #include <utilities/include/Archiver.h>
+#include <utilities/include/BinaryArchiver.h>
 #include <utilities/include/IArchivable.h>
 #include <utilities/include/JsonArchiver.h>
 #include <utilities/include/UniqueId.h>
@@ -16,6 +17,7 @@
 
 #include <testing/include/testing.h>
 
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <sstream>
@@ -370,4 +372,83 @@ void TestXmlUnarchiver()
 {
     TestUnarchiver<utilities::XmlArchiver, utilities::XmlUnarchiver>();
 }
+
+void TestBinaryArchiver()
+{
+    TestArchiver<utilities::BinaryArchiver>();
+}
+
+void TestBinaryUnarchiver()
+{
+    TestUnarchiver<utilities::BinaryArchiver, utilities::BinaryUnarchiver>();
+}
+
+void TestBinaryArchiveArrayAlignment()
+{
+    std::vector<float> weights(100);
+    for (size_t index = 0; index < weights.size(); ++index)
+    {
+        weights[index] = static_cast<float>(index) + 0.5f;
+    }
+
+    std::stringstream strstream;
+    {
+        utilities::BinaryArchiver archiver(strstream);
+        archiver.Archive("name", std::string{ "layer" });
+        archiver.Archive("weights", weights);
+        archiver.Archive("size", weights.size());
+    }
+
+    // The array data must start on an aligned boundary, so a memory-mapped archive can be read in place
+    auto archive = strstream.str();
+    auto dataOffset = archive.find(std::string(reinterpret_cast<const char*>(weights.data()), weights.size() * sizeof(float)));
+    testing::ProcessTest("BinaryArchiver array alignment", dataOffset != std::string::npos && dataOffset % utilities::BinaryArchiver::arrayAlignment == 0);
+
+    // Read directly from memory, converting the size to a different integer type
+    utilities::SerializationContext context;
+    utilities::BinaryUnarchiver unarchiver(archive.data(), archive.size(), context);
+    std::string name;
+    std::vector<float> newWeights;
+    int size = 0;
+    unarchiver.Unarchive("name", name);
+    unarchiver.Unarchive("weights", newWeights);
+    unarchiver.Unarchive("size", size);
+    testing::ProcessTest("BinaryUnarchiver from memory", name == "layer" && testing::IsEqual(weights, newWeights) && size == 100);
+    testing::ProcessTest("BinaryUnarchiver::IsBinaryArchive", utilities::BinaryUnarchiver::IsBinaryArchive(archive.data(), archive.size()) && !utilities::BinaryUnarchiver::IsBinaryArchive("{}", 2));
+
+    std::stringstream binaryStream(archive);
+    std::stringstream textStream("{}");
+    testing::ProcessTest("BinaryUnarchiver::IsBinaryArchive from stream", utilities::BinaryUnarchiver::IsBinaryArchive(binaryStream) && !utilities::BinaryUnarchiver::IsBinaryArchive(textStream));
+}
+
+void TestBinaryUnarchiverCorruptArrayCount()
+{
+    std::vector<float> weights = { 1, 2, 3, 4 };
+    std::stringstream strstream;
+    {
+        utilities::BinaryArchiver archiver(strstream);
+        archiver.Archive("weights", weights);
+    }
+
+    // Replace the element count with one whose size in bytes wraps around to 16
+    auto archive = strstream.str();
+    uint64_t count = weights.size();
+    auto countOffset = archive.find(std::string(reinterpret_cast<const char*>(&count), sizeof(count)), archive.find("weights"));
+    uint64_t corruptCount = (uint64_t{ 1 } << 62) + weights.size();
+    archive.replace(countOffset, sizeof(corruptCount), std::string(reinterpret_cast<const char*>(&corruptCount), sizeof(corruptCount)));
+
+    utilities::SerializationContext context;
+    utilities::BinaryUnarchiver unarchiver(archive.data(), archive.size(), context);
+    std::vector<float> newWeights;
+    bool threw = false;
+    try
+    {
+        unarchiver.Unarchive("weights", newWeights);
+    }
+    catch (const utilities::DataFormatException&)
+    {
+        threw = true;
+    }
+    testing::ProcessTest("BinaryUnarchiver rejects an array count that overflows", threw && newWeights.empty());
+}
 } // namespace ell
@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ThreadPool_test.cpp (utilities)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ThreadPool_test.h"
+
+#include <utilities/include/Exception.h>
+#include <utilities/include/ThreadPool.h>
+
+#include <testing/include/testing.h>
+
+#include <atomic>
+#include <vector>
+
+namespace ell
+{
+using namespace utilities;
+
+void TestThreadPoolParallelFor()
+{
+    ThreadPool pool(4);
+    const size_t count = 1000;
+    std::vector<int> visits(count, 0);
+    for (size_t chunkSize : { 0, 1, 7, 2000 })
+    {
+        std::fill(visits.begin(), visits.end(), 0);
+        pool.ParallelFor(count, [&visits](size_t index) { ++visits[index]; }, chunkSize);
+        testing::ProcessTest("ThreadPool::ParallelFor visits every index once, chunkSize = " + std::to_string(chunkSize), testing::IsEqual(visits, std::vector<int>(count, 1)));
+    }
+
+    // Reusing the pool many times shouldn't hang or lose work
+    std::atomic<size_t> total = 0;
+    for (int iteration = 0; iteration < 100; ++iteration)
+    {
+        pool.ParallelFor(10, [&total](size_t index) { total += index; });
+    }
+    testing::ProcessTest("ThreadPool::ParallelFor reuse", testing::IsEqual(total.load(), size_t{ 4500 }));
+}
+
+void TestThreadPoolNestedParallelFor()
+{
+    ThreadPool pool(2);
+    const size_t outer = 8;
+    const size_t inner = 50;
+    std::vector<std::atomic<int>> sums(outer);
+    pool.ParallelFor(outer, [&](size_t i) {
+        pool.ParallelFor(inner, [&sums, i](size_t j) { sums[i] += static_cast<int>(j); }, 1);
+    }, 1);
+
+    bool ok = true;
+    for (auto& sum : sums)
+    {
+        ok = ok && sum.load() == static_cast<int>(inner * (inner - 1) / 2);
+    }
+    testing::ProcessTest("ThreadPool nested ParallelFor", ok);
+}
+
+void TestThreadPoolException()
+{
+    ThreadPool pool(3);
+    bool threw = false;
+    try
+    {
+        pool.ParallelFor(100, [](size_t index) {
+            if (index == 42)
+            {
+                throw InputException(InputExceptionErrors::invalidArgument, "bad index");
+            }
+        });
+    }
+    catch (const InputException&)
+    {
+        threw = true;
+    }
+    testing::ProcessTest("ThreadPool::ParallelFor rethrows exceptions", threw);
+
+    // The pool is still usable afterwards
+    std::atomic<int> count = 0;
+    pool.ParallelFor(10, [&count](size_t) { ++count; });
+    testing::ProcessTest("ThreadPool usable after exception", testing::IsEqual(count.load(), 10));
+}
+} // namespace ell
@@ -16,6 +16,7 @@
 #include "ObjectArchive_test.h"
 #include "PropertyBag_test.h"
 #include "RingBuffer_test.h"
+#include "ThreadPool_test.h"
 #include "TunableParameters_test.h"
 #include "TypeFactory_test.h"
 #include "TypeName_test.h"
@@ -71,6 +72,11 @@ int main(int argc, char* argv[])
         // TypeFactory tests
         TypeFactoryTest();
 
+        // ThreadPool tests
+        TestThreadPoolParallelFor();
+        TestThreadPoolNestedParallelFor();
+        TestThreadPoolException();
+
         // Variant tests
         TestScalarVariant();
         TestVectorVariant();
@@ -92,6 +98,11 @@ int main(int argc, char* argv[])
         TestXmlArchiver();
         TestXmlUnarchiver();
 
+        TestBinaryArchiver();
+        TestBinaryUnarchiver();
+        TestBinaryArchiveArrayAlignment();
+        TestBinaryUnarchiverCorruptArrayCount();
+
         // ObjectArchive tests
         TestGetTypeDescription();
         TestGetObjectArchive();
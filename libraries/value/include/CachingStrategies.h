@@ -9,6 +9,9 @@
 #pragma once
 
 #include "CachingProvider.h"
+#include "Matrix.h"
+
+#include <functional>
 
 namespace ell
 {
@@ -33,6 +36,18 @@ namespace value
         void HandleCachingImpl(LoopNest&) override;
     };
 
+    /// <summary>
+    /// Stores one fully reduced element of an output cache: called with the output, the element's row and column, and
+    /// the element's final value.
+    /// </summary>
+    using ReduceOutputStoreFunction = std::function<void(value::Matrix, value::Scalar, value::Scalar, value::Scalar)>;
+
+    /// <summary>
+    /// Accumulates into a zeroed cache and adds the cache to the output when the cached block is done. The extra
+    /// parameters may be a `std::tuple<int, Index, int, ReduceOutputStoreFunction>`: the vector size, an outer index
+    /// over the reduction dimension, the value of that index on its last iteration, and a function that stores the
+    /// output elements on that iteration instead of adding the cache to them, e.g. to apply an epilogue to them.
+    /// </summary>
     class ZeroInputReduceOutput : public CachingProvider
     {
         void HandleCachingImpl(LoopNest&) override;
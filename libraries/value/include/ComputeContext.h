@@ -12,9 +12,12 @@
 #include "FunctionDeclaration.h"
 #include "Scalar.h"
 
+#include <utilities/include/ThreadPool.h>
+
 #include <atomic>
 #include <forward_list>
 #include <map>
+#include <memory>
 #include <optional>
 #include <mutex>
 #include <stack>
@@ -52,6 +55,7 @@ namespace value
 
         void ForImpl(MemoryLayout layout, std::function<void(std::vector<Scalar>)> fn, const std::string& name) override;
         void ForImpl(Scalar start, Scalar stop, Scalar step, std::function<void(Scalar)> fn, const std::string& name) override;
+        void VectorizedForImpl(Scalar start, Scalar stop, Scalar step, int vectorSize, std::function<void(Scalar)> fn, const std::string& name) override;
 
         void MoveDataImpl(Value& source, Value& destination) override;
 
@@ -111,6 +115,8 @@ namespace value
         Frame& GetTopFrame();
         const Frame& GetTopFrame() const;
 
+        utilities::ThreadPool& GetThreadPool();
+
         friend void swap(ComputeContext&, ComputeContext&) noexcept;
 
         class IfContextImpl;
@@ -122,6 +128,7 @@ namespace value
         std::unordered_map<FunctionDeclaration, DefinedFunction> _definedFunctions;
         std::unordered_map<Value, std::string> _namedValues;
         std::string _moduleName;
+        std::unique_ptr<utilities::ThreadPool> _threadPool; // created the first time Parallelize is called
     };
 
 } // namespace value
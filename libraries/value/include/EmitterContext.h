@@ -237,6 +237,18 @@ namespace value
         /// <param name="name"> Optional, a name that can be used by the emitter context to tag this loop in the emitted code </param>
         void For(Scalar start, Scalar stop, Scalar step, std::function<void(Scalar)> fn, const std::string& name = "");
 
+        /// <summary>
+        /// Creates a for loop like `For`, whose iterations are executed as vectors of `vectorSize` consecutive iterations
+        /// by contexts that emit vector code. The number of iterations must be a multiple of `vectorSize`.
+        /// </summary>
+        /// <param name="start"> The value used to initialize the loop counter </param>
+        /// <param name="stop"> The terminal value of the loop </param>
+        /// <param name="step"> The value by which the loop counter is incremented </param>
+        /// <param name="vectorSize"> The number of iterations per vector </param>
+        /// <param name="fn"> The function to be called for each iteration </param>
+        /// <param name="name"> Optional, a name that can be used by the emitter context to tag this loop in the emitted code </param>
+        void VectorizedFor(Scalar start, Scalar stop, Scalar step, int vectorSize, std::function<void(Scalar)> fn, const std::string& name = "");
+
         /// <summary> Moves the data from one location to another </summary>
         /// <param name="source"> The source of the memory to be moved </param>
         /// <param name="destination"> The destination of the memory to be moved </param>
@@ -353,6 +365,7 @@ namespace value
 
         virtual void ForImpl(MemoryLayout layout, std::function<void(std::vector<Scalar>)> fn, const std::string& name) = 0;
         virtual void ForImpl(Scalar start, Scalar stop, Scalar step, std::function<void(Scalar)> fn, const std::string& name) = 0;
+        virtual void VectorizedForImpl(Scalar start, Scalar stop, Scalar step, int vectorSize, std::function<void(Scalar)> fn, const std::string& name) = 0;
 
         virtual void MoveDataImpl(Value& source, Value& destination) = 0;
 
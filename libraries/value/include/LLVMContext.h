@@ -79,6 +79,7 @@ namespace value
 
         void ForImpl(MemoryLayout layout, std::function<void(std::vector<Scalar>)> fn, const std::string& name) override;
         void ForImpl(Scalar start, Scalar stop, Scalar step, std::function<void(Scalar)> fn, const std::string& name) override;
+        void VectorizedForImpl(Scalar start, Scalar stop, Scalar step, int vectorSize, std::function<void(Scalar)> fn, const std::string& name) override;
 
         void MoveDataImpl(Value& source, Value& destination) override;
 
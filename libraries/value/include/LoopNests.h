@@ -77,6 +77,16 @@ namespace value
         /// <returns> The index which represents the outer loop, now unrolled </returns>
         Index Unroll(Index index, int factor);
 
+        /// <summary>
+        /// Vectorizes the loop represented by the index. The iterations that fill whole vector registers are emitted as a loop
+        /// that the compiler must vectorize, so the kernel's loads, stores, and arithmetic become vector instructions;
+        /// iterations that don't fill a whole vector are emitted as a scalar loop. The number of iterations per vector is
+        /// `vectorBytes` divided by the size of the largest element type used by the loop nest.
+        /// </summary>
+        /// <param name="index"> Represents the loop to vectorize. Typically the innermost index of a split, with a stride-1 access pattern </param>
+        /// <param name="vectorBytes"> The width of the target's vector registers, in bytes </param>
+        void Vectorize(Index index, int vectorBytes);
+
         void Cache(std::unique_ptr<CachingProvider> provider);
 
         template <typename CachingStrategyType>
@@ -203,6 +203,9 @@ namespace value
             void Unroll(Index index);
             [[maybe_unused]] SplitIndex Unroll(Index index, int factor);
 
+            /// <summary> Emit the loop over an index as vectors of `vectorSize` iterations, with a scalar loop for any remainder </summary>
+            void Vectorize(Index index, int vectorSize);
+
             [[maybe_unused]] SplitIndex Split(Index index, int size);
 
             void SetLoopOrder(const std::vector<Index>& order);
@@ -228,6 +231,11 @@ namespace value
 
             bool IsUnrolled(const Index& index) const;
 
+            bool IsVectorized(const Index& index) const;
+
+            /// <summary> Returns the number of iterations per vector of a vectorized index, or 1 if the index isn't vectorized </summary>
+            int GetVectorSize(const Index& index) const;
+
             /// <summary> See if an Index is used as a parameter to a kernel </summary>
             bool IsUsed(const Index& index, const std::vector<ScheduledKernel>& activeKernels) const;
 
@@ -261,6 +269,7 @@ namespace value
             std::vector<RenameAction> _renameActions;
             std::vector<Index> _parallelizedIndices;
             std::vector<Index> _unrolledIndices;
+            std::vector<std::pair<Index, int>> _vectorizedIndices;
             std::string _name = UniqueName("LoopNest");
         };
 
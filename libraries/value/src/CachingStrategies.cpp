@@ -328,26 +328,61 @@ namespace value
         auto& underlyingNest = nest.GetUnderlyingLoopNest();
         underlyingNest.AddKernel(kernel3, loopnests::CodePositionConstraints{ loopnests::LoopFragmentType::prologue, _atIndices, {} });
 
-        auto kernel2 = loopnests::Kernel(cacheName + "_Reduce_Kernel")
-                           .Inputs(_value, cacheRef)
-                           .Indices(_kernelIndices)
-                           .Define([shape = orderedLayout](value::Matrix C, value::Value temp, value::Scalar i, value::Scalar j) {
-                               auto cacheTmpOffset = temp.Dereference().Offset({ i, j });
-                               cacheTmpOffset.SetLayout(shape);
-                               temp = cacheTmpOffset.Reference();
-                               auto cache = value::Matrix(temp.Dereference());
-
-                               int M = static_cast<int>(C.Rows());
-                               int N = static_cast<int>(C.Columns());
-                               Scalar extraM = value::Min(M - i, shape.GetLogicalDimensionActiveSize(0));
-                               Scalar extraN = value::Min(N - j, shape.GetLogicalDimensionActiveSize(1));
+        // Adds the cache into the block of the output at (i, j), or stores the sums with `store`
+        auto reduce = [shape = orderedLayout](value::Matrix C, value::Value temp, value::Scalar i, value::Scalar j, const ReduceOutputStoreFunction& store) {
+            auto cacheTmpOffset = temp.Dereference().Offset({ i, j });
+            cacheTmpOffset.SetLayout(shape);
+            temp = cacheTmpOffset.Reference();
+            auto cache = value::Matrix(temp.Dereference());
+
+            int M = static_cast<int>(C.Rows());
+            int N = static_cast<int>(C.Columns());
+            Scalar extraM = value::Min(M - i, shape.GetLogicalDimensionActiveSize(0));
+            Scalar extraN = value::Min(N - j, shape.GetLogicalDimensionActiveSize(1));
+
+            ForRange(extraM, [&](Scalar i_inner) {
+                ForRange(extraN, [&](Scalar j_inner) {
+                    if (store)
+                    {
+                        store(C, i + i_inner, j + j_inner, C(i + i_inner, j + j_inner) + cache(i_inner, j_inner));
+                    }
+                    else
+                    {
+                        C(i + i_inner, j + j_inner) += cache(i_inner, j_inner);
+                    }
+                });
+            });
+        };
 
-                               ForRange(extraM, [&](Scalar i_inner) {
-                                   ForRange(extraN, [&](Scalar j_inner) {
-                                       C(i + i_inner, j + j_inner) += cache(i_inner, j_inner);
-                                   });
-                               });
-                           });
+        loopnests::Kernel kernel2(cacheName + "_Reduce_Kernel");
+        using StoreParams = std::tuple<int, Index, int, ReduceOutputStoreFunction>;
+        if (auto storeParams = std::any_cast<StoreParams>(&_extra); storeParams != nullptr && std::get<3>(*storeParams))
+        {
+            // On the last iteration over the reduction dimension, the sums are final: store them with the store function
+            auto [vectorSize, reductionIndex, lastReductionValue, store] = *storeParams;
+            UNUSED(vectorSize);
+            auto indices = _kernelIndices;
+            indices.push_back(reductionIndex);
+            kernel2 = loopnests::Kernel(cacheName + "_Reduce_Kernel")
+                          .Inputs(_value, cacheRef)
+                          .Indices(indices)
+                          .Define([reduce, lastReductionValue = lastReductionValue, store = store](value::Matrix C, value::Value temp, value::Scalar i, value::Scalar j, value::Scalar k) {
+                              If(k == lastReductionValue, [&] {
+                                  reduce(C, temp, i, j, store);
+                              }).Else([&] {
+                                  reduce(C, temp, i, j, {});
+                              });
+                          });
+        }
+        else
+        {
+            kernel2 = loopnests::Kernel(cacheName + "_Reduce_Kernel")
+                          .Inputs(_value, cacheRef)
+                          .Indices(_kernelIndices)
+                          .Define([reduce](value::Matrix C, value::Value temp, value::Scalar i, value::Scalar j) {
+                              reduce(C, temp, i, j, {});
+                          });
+        }
         underlyingNest.AddKernel(kernel2, loopnests::CodePositionConstraints{ loopnests::LoopFragmentType::epilogue, _atIndices, {} });
         underlyingNest.RenameVariable(_value, cacheRef, _atIndices, { kernel2, kernel3 });
     } // namespace value
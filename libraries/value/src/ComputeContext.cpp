@@ -19,10 +19,11 @@
 #include <cassert>
 #include <cmath>
 #include <cstring>
-#include <future>
 #include <iostream>
+#include <map>
 #include <string>
 #include <thread>
+#include <utility>
 
 namespace ell
 {
@@ -33,16 +34,21 @@ namespace value
 
     namespace
     {
+        // How many parallel tasks the current thread is running, one inside the other. A thread that waits on a
+        // nested region runs some of its tasks inline, and they need a different id from the task that's waiting.
+        thread_local int ParallelTaskDepth = 0;
+
         struct
         {
             int Current()
             {
                 std::lock_guard lock{ _mutex };
 
-                auto it = _idMap.find(std::this_thread::get_id());
+                auto key = std::make_pair(std::this_thread::get_id(), ParallelTaskDepth);
+                auto it = _idMap.find(key);
                 if (it == _idMap.end())
                 {
-                    it = _idMap.emplace_hint(it, std::this_thread::get_id(), ++_nextThreadId);
+                    it = _idMap.emplace_hint(it, key, ++_nextThreadId);
                 }
 
                 return it->second;
@@ -55,9 +61,16 @@ namespace value
                 _nextThreadId = 0;
             }
 
+            // Returns true for the outermost parallel region. Ids can only be reset there, since the tasks of
+            // an outer region are still using theirs while a nested region runs.
+            bool EnterParallelRegion() { return _activeParallelRegions++ == 0; }
+
+            void LeaveParallelRegion() { --_activeParallelRegions; }
+
             std::mutex _mutex;
-            std::unordered_map<std::thread::id, int> _idMap;
+            std::map<std::pair<std::thread::id, int>, int> _idMap;
             int _nextThreadId = 0;
+            std::atomic<int> _activeParallelRegions = 0;
         } ThreadIds;
 
         // TODO: Make this the basis of an iterator for MemoryLayout
@@ -1032,6 +1045,11 @@ namespace value
             start.GetValue().GetUnderlyingData());
     }
 
+    void ComputeContext::VectorizedForImpl(Scalar start, Scalar stop, Scalar step, [[maybe_unused]] int vectorSize, std::function<void(Scalar)> fn, const std::string& name)
+    {
+        ForImpl(start, stop, step, fn, name);
+    }
+
     Value ComputeContext::ReferenceImpl(Value source)
     {
         return std::visit(
@@ -1480,18 +1498,38 @@ namespace value
 
     void ComputeContext::ParallelizeImpl(int numTasks, std::vector<Value> captured, std::function<void(Scalar, std::vector<Value>)> fn)
     {
-        ThreadIds.Clear();
+        if (ThreadIds.EnterParallelRegion())
+        {
+            ThreadIds.Clear();
+        }
 
-        std::vector<std::future<void>> futures;
-        futures.reserve(numTasks);
-        for (int i = 0; i < numTasks; ++i)
+        try
         {
-            futures.push_back(std::async(fn, Scalar{ i }, captured));
+            GetThreadPool().ParallelFor(static_cast<size_t>(numTasks), [&](size_t i) {
+                struct TaskDepthScope
+                {
+                    TaskDepthScope() { ++ParallelTaskDepth; }
+                    ~TaskDepthScope() { --ParallelTaskDepth; }
+                } scope;
+                fn(Scalar{ static_cast<int>(i) }, captured);
+            });
+        }
+        catch (...)
+        {
+            ThreadIds.LeaveParallelRegion();
+            throw;
         }
-        for (auto& future : futures)
+        ThreadIds.LeaveParallelRegion();
+    }
+
+    utilities::ThreadPool& ComputeContext::GetThreadPool()
+    {
+        std::lock_guard lock{ _mutex };
+        if (!_threadPool)
         {
-            future.wait();
+            _threadPool = std::make_unique<utilities::ThreadPool>();
         }
+        return *_threadPool;
     }
 
     namespace
@@ -1716,6 +1754,7 @@ namespace value
         swap(l._definedFunctions, r._definedFunctions);
         swap(l._namedValues, r._namedValues);
         swap(l._moduleName, r._moduleName);
+        swap(l._threadPool, r._threadPool);
     }
 } // namespace value
 } // namespace ell
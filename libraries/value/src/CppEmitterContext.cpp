@@ -628,6 +628,11 @@ namespace value
         Out() << "}" << optionalTag << "\n\n";
     }
 
+    void CppEmitterContext::VectorizedForImpl(Scalar start, Scalar stop, Scalar step, [[maybe_unused]] int vectorSize, std::function<void(Scalar)> fn, const std::string& name)
+    {
+        ForImpl(start, stop, step, fn, name);
+    }
+
     void CppEmitterContext::MoveDataImpl(Value& source, Value& destination)
     {
         // we treat a move the same as a copy, except we clear out the source
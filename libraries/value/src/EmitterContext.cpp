@@ -180,6 +180,21 @@ namespace value
         return ForImpl(start, stop, step, fn, name);
     }
 
+    void EmitterContext::VectorizedFor(Scalar start, Scalar stop, Scalar step, int vectorSize, std::function<void(Scalar)> fn, const std::string& name)
+    {
+        if (!(start.GetType() == ValueType::Int32 && stop.GetType() == ValueType::Int32 && step.GetType() == ValueType::Int32))
+        {
+            throw InputException(InputExceptionErrors::typeMismatch, "start/stop/step must be Int32");
+        }
+
+        if (vectorSize < 1)
+        {
+            throw InputException(InputExceptionErrors::invalidArgument, "vectorSize must be positive");
+        }
+
+        return VectorizedForImpl(start, stop, step, vectorSize, fn, name);
+    }
+
     void EmitterContext::MoveData(Value& source, Value& destination) { return MoveDataImpl(source, destination); }
 
     void EmitterContext::CopyData(const Value& source, Value& destination) { return CopyDataImpl(source, destination); }
@@ -1030,6 +1030,30 @@ namespace value
             });
     }
 
+    void LLVMContext::VectorizedForImpl(Scalar start, Scalar stop, Scalar step, int vectorSize, std::function<void(Scalar)> fn, const std::string& name)
+    {
+        auto startValue = EnsureEmittable(start.GetValue());
+        auto stopValue = EnsureEmittable(stop.GetValue());
+        auto stepValue = EnsureEmittable(step.GetValue());
+
+        auto& fnEmitter = GetFunctionEmitter();
+
+        // The loop metadata makes the loop vectorizer turn each group of `vectorSize` iterations into vector loads,
+        // stores, and arithmetic, rather than leaving it to its cost model
+        Scalar index = value::Allocate<int>(ScalarLayout);
+
+        fnEmitter.VectorizedFor(
+            name,
+            fnEmitter.Load(ToLLVMValue(startValue)),
+            fnEmitter.Load(ToLLVMValue(stopValue)),
+            fnEmitter.Load(ToLLVMValue(stepValue)),
+            vectorSize,
+            [&](IRFunctionEmitter&, IRLocalScalar iterationVariable) {
+                index = Scalar(Value{ Emittable{ iterationVariable.value }, ScalarLayout });
+                fn(index);
+            });
+    }
+
     void LLVMContext::MoveDataImpl(Value& source, Value& destination)
     {
         // we treat a move the same as a copy, except we clear out the source
@@ -14,6 +14,9 @@
 #include "loopnests/Kernel.h"
 #include "loopnests/LoopNest.h"
 
+#include <utilities/include/Exception.h>
+
+#include <algorithm>
 #include <map>
 #include <optional>
 #include <tuple>
@@ -24,6 +27,30 @@ namespace ell
 {
 namespace value
 {
+    namespace
+    {
+        int GetElementSize(ValueType type)
+        {
+            switch (type)
+            {
+            case ValueType::Boolean:
+            case ValueType::Char8:
+            case ValueType::Byte:
+                return 1;
+            case ValueType::Int16:
+                return 2;
+            case ValueType::Int32:
+            case ValueType::Float:
+                return 4;
+            case ValueType::Int64:
+            case ValueType::Double:
+                return 8;
+            default:
+                throw InputException(InputExceptionErrors::invalidArgument, "Vectorize() --- loop nest argument has no element size");
+            }
+        }
+    } // namespace
+
     class LoopNestImpl
     {
     public:
@@ -129,6 +156,22 @@ namespace value
             _nest->Unroll(index);
         }
 
+        void Vectorize(Index index, int vectorBytes)
+        {
+            int elementSize = 0;
+            for (const auto& arg : _arguments)
+            {
+                elementSize = std::max(elementSize, GetElementSize(arg.first.GetBaseType()));
+            }
+            if (elementSize == 0)
+            {
+                throw InputException(InputExceptionErrors::invalidArgument, "Vectorize() --- loop nest has no arguments");
+            }
+
+            EnsureCreated();
+            _nest->Vectorize(index, std::max(1, vectorBytes / elementSize));
+        }
+
         void SetOrder(std::vector<Index> indices)
         {
             EnsureCreated();
@@ -302,6 +345,11 @@ namespace value
         return outer;
     }
 
+    void Schedule::Vectorize(Index index, int vectorBytes)
+    {
+        _impl.get().Vectorize(index, vectorBytes);
+    }
+
     void Schedule::Cache(std::unique_ptr<CachingProvider> provider)
     {
         provider->HandleCaching(_nest.get());
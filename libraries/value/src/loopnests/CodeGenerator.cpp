@@ -12,8 +12,10 @@
 #include "LLVMContext.h"
 
 #include <algorithm>
+#include <functional>
 #include <numeric>
 #include <optional>
+#include <string>
 #include <variant>
 
 namespace ell
@@ -29,6 +31,26 @@ namespace value
             {
                 return (a - 1) / b + 1;
             }
+
+            // Emits the iterations that fill whole vectors as a loop that the optimizer is required to vectorize with
+            // `vectorSize` iterations per vector, so the kernel's loads, stores, and arithmetic become vector instructions
+            // independently of whether its cost model would have considered the loop profitable. Iterations that don't fill
+            // a whole vector are emitted as a scalar loop.
+            void GenerateVectorizedLoop(const std::string& name, int start, int stop, int step, int vectorSize, std::function<void(Scalar)> codegenFn)
+            {
+                const int vectorStep = vectorSize * step;
+                const int numVectors = (stop - start) / vectorStep;
+                const int vectorStop = start + numVectors * vectorStep;
+                if (numVectors > 0)
+                {
+                    GetContext().VectorizedFor(start, vectorStop, step, vectorSize, codegenFn, name);
+                }
+
+                if (vectorStop < stop)
+                {
+                    ForRange(name, vectorStop, stop, step, codegenFn);
+                }
+            }
         } // namespace
 
         void CodeGenerator::Run(const LoopNest& loopNest) const
@@ -43,7 +65,9 @@ namespace value
 
             bool isParallelized = loopNest.IsParallelized(loopIndex);
             bool isUnrolled = loopNest.IsUnrolled(loopIndex);
+            bool isVectorized = loopNest.IsVectorized(loopIndex);
             assert(!(isParallelized && isUnrolled) && "An index cannot be both unrolled and parallelized");
+            assert(!(isVectorized && (isParallelized || isUnrolled)) && "A vectorized index cannot also be unrolled or parallelized");
 
             const int startInt = r.start.Get<int>();
             const int stopInt = r.stop.Get<int>();
@@ -55,7 +79,11 @@ namespace value
                 isParallelized = false;
             }
 
-            if (!(isParallelized || isUnrolled))
+            if (isVectorized)
+            {
+                GenerateVectorizedLoop(UniqueName(loopNest.Name()), startInt, stopInt, stepInt, loopNest.GetVectorSize(loopIndex), codegenFn);
+            }
+            else if (!(isParallelized || isUnrolled))
             {
                 ForRange(UniqueName(loopNest.Name()), r.start, r.stop, r.step, codegenFn);
             }
@@ -109,7 +137,9 @@ namespace value
 
             bool isParallelized = loopNest.IsParallelized(loopIndex);
             bool isUnrolled = loopNest.IsUnrolled(loopIndex);
+            bool isVectorized = loopNest.IsVectorized(loopIndex);
             assert(!(isParallelized && isUnrolled) && "An index cannot be both unrolled and parallelized");
+            assert(!(isVectorized && (isParallelized || isUnrolled)) && "A vectorized index cannot also be unrolled or parallelized");
 
             const int startInt = r.start.Get<int>();
             const int stopInt = r.stop.Get<int>();
@@ -121,7 +151,11 @@ namespace value
                 isParallelized = false;
             }
 
-            if (!(isParallelized || isUnrolled))
+            if (isVectorized)
+            {
+                GenerateVectorizedLoop(UniqueName(loopNest.Name()), startInt, stopInt, stepInt, loopNest.GetVectorSize(loopIndex), codegenFn);
+            }
+            else if (!(isParallelized || isUnrolled))
             {
                 ForRange(UniqueName(loopNest.Name()), r.start, r.stop, r.step, codegenFn);
             }
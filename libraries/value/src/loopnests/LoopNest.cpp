@@ -632,6 +632,15 @@ namespace value
             return result;
         }
 
+        void LoopNest::Vectorize(Index index, int vectorSize)
+        {
+            if (vectorSize < 1)
+            {
+                throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Vectorize() --- vector size must be positive");
+            }
+            _vectorizedIndices.emplace_back(index, vectorSize);
+        }
+
         void LoopNest::SetLoopOrder(const std::vector<Index>& order)
         {
             if (order.size() != _loopSequence.size())
@@ -728,6 +737,17 @@ namespace value
             return std::find(_unrolledIndices.begin(), _unrolledIndices.end(), index) != _unrolledIndices.end();
         }
 
+        bool LoopNest::IsVectorized(const Index& index) const
+        {
+            return GetVectorSize(index) > 1;
+        }
+
+        int LoopNest::GetVectorSize(const Index& index) const
+        {
+            auto it = std::find_if(_vectorizedIndices.begin(), _vectorizedIndices.end(), [&index](const auto& entry) { return entry.first == index; });
+            return it == _vectorizedIndices.end() ? 1 : it->second;
+        }
+
         const std::vector<RenameAction>& LoopNest::GetRenameActions() const
         {
             return _renameActions;
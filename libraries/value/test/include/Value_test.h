@@ -40,6 +40,8 @@ value::Scalar Fma_test2();
 value::Scalar Fma_test3();
 value::Scalar UniqueName_test1();
 value::Scalar Parallelized_ComputeContext_test1();
+value::Scalar Parallelized_ComputeContext_test2();
+value::Scalar Parallelized_ComputeContext_test3();
 
 value::Scalar MemCopy_test1();
 value::Scalar MemSet_test1();
@@ -265,6 +265,49 @@ Scalar LoopNest_api_Unrolled_test1()
     return matrix(2, 3) - 19; // will return 0 if calculation is correct
 }
 
+Scalar LoopNest_api_Vectorized_test1()
+{
+    const int N = 3;
+    const int M = 10;
+    auto expected = MakeMatrix<int>(N, M);
+    auto matrix = MakeMatrix<int>(N, M);
+    auto splitMatrix = MakeMatrix<int>(N, M);
+    ForRange(N, [&](Scalar i) {
+        ForRange(M, [&](Scalar j) {
+            expected(i, j) = i * 2 + j * 5;
+        });
+    });
+
+    // 16-byte vectors of ints: two full vectors of 4 and a scalar tail of 2
+    Index i("i"), j("j");
+    auto nest = Using({ matrix }, ArgumentType::Output)
+                    .ForAll(i, 0, N)
+                    .ForAll(j, 0, M)
+                    .Do(loopnest_kernel);
+    nest.GetSchedule().Vectorize(j, 16);
+    nest.Run();
+
+    // vectorizing the inner index of a split, whose last block is a partial vector
+    Index i2("i"), j2("j");
+    auto splitNest = Using({ splitMatrix }, ArgumentType::Output)
+                         .ForAll(i2, 0, N)
+                         .ForAll(j2, 0, M)
+                         .Do(loopnest_kernel);
+    auto& schedule = splitNest.GetSchedule();
+    schedule.Split(j2, 4);
+    schedule.Vectorize(j2, 16);
+    splitNest.Run();
+
+    Scalar ok = Allocate<int>(ScalarLayout);
+    ok = 1;
+    If(VerifySame(matrix, expected) == 0, [&] {
+        If(VerifySame(splitMatrix, expected) == 0, [&] {
+            ok = 0;
+        });
+    });
+    return ok;
+}
+
 Scalar LoopNest_api_SetOrder_test1()
 {
     auto matrix = MakeMatrix<int>(4, 5);
@@ -930,6 +930,83 @@ Scalar Parallelized_ComputeContext_test1()
     return ok;
 }
 
+Scalar Parallelized_ComputeContext_test2()
+{
+    Scalar ok = Allocate<int>(ScalarLayout);
+
+    InvokeForContext<ComputeContext>([&] {
+        // Nested parallel regions run on the same thread pool as the outer one
+        constexpr int OuterTasks = 4;
+        constexpr int InnerTasks = 3;
+        auto data = MakeVector<int>(OuterTasks * InnerTasks);
+        Parallelize(
+            OuterTasks,
+            std::tuple{ data },
+            std::function<void(Scalar, Vector)>{ [&](Scalar outer, Vector outerData) {
+                Parallelize(
+                    InnerTasks,
+                    std::tuple{ outerData },
+                    std::function<void(Scalar, Vector)>{ [=](Scalar inner, Vector innerData) {
+                        innerData[outer * InnerTasks + inner] = outer * 10 + inner;
+                    } });
+            } });
+
+        auto expected = MakeVector<int>(data.Size());
+        for (int outer = 0; outer < OuterTasks; ++outer)
+        {
+            for (int inner = 0; inner < InnerTasks; ++inner)
+            {
+                expected[outer * InnerTasks + inner] = outer * 10 + inner;
+            }
+        }
+
+        If(VerifySame(data, expected) != 0, [&] {
+            ok = 1;
+        });
+    });
+
+    return ok;
+}
+
+Scalar Parallelized_ComputeContext_test3()
+{
+    Scalar ok = Allocate<int>(ScalarLayout);
+
+    InvokeForContext<ComputeContext>([&] {
+        // Nested tasks that run inline on an outer task's thread get their own thread-local allocations
+        constexpr int OuterTasks = 4;
+        constexpr int InnerTasks = 8;
+        auto data = MakeVector<int>(OuterTasks);
+        Parallelize(
+            OuterTasks,
+            std::tuple{ data },
+            std::function<void(Scalar, Vector)>{ [&](Scalar outer, Vector outerData) {
+                Scalar outerValue = StaticAllocate("NestedTaskValue", ValueType::Int32, ScalarLayout, AllocateFlags::ThreadLocal);
+                outerValue = outer + 1;
+                Parallelize(
+                    InnerTasks,
+                    std::tuple{ outerData },
+                    std::function<void(Scalar, Vector)>{ [=](Scalar, Vector) {
+                        Scalar innerValue = StaticAllocate("NestedTaskValue", ValueType::Int32, ScalarLayout, AllocateFlags::ThreadLocal);
+                        innerValue = -1;
+                    } });
+                outerData[outer] = outerValue;
+            } });
+
+        auto expected = MakeVector<int>(data.Size());
+        for (int outer = 0; outer < OuterTasks; ++outer)
+        {
+            expected[outer] = outer + 1;
+        }
+
+        If(VerifySame(data, expected) != 0, [&] {
+            ok = 1;
+        });
+    });
+
+    return ok;
+}
+
 Scalar MemCopy_test1()
 {
     auto vec = MakeVector<int>(4);
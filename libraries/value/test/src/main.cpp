@@ -21,11 +21,14 @@
 #include <value/include/CppEmitterContext.h>
 #include <value/include/FunctionDeclaration.h>
 #include <value/include/LLVMContext.h>
+#include <value/include/LoopNests.h>
+#include <value/include/Matrix.h>
 #include <value/include/Vector.h>
 
 #include <emitters/include/CompilerOptions.h>
 #include <emitters/include/IRExecutionEngine.h>
 #include <emitters/include/IRModuleEmitter.h>
+#include <emitters/include/IROptimizer.h>
 
 #include <utilities/include/Exception.h>
 #include <utilities/include/Logger.h>
@@ -36,6 +39,7 @@
 
 #include <functional>
 #include <iostream>
+#include <sstream>
 #include <type_traits>
 
 using namespace ell::logging;
@@ -318,6 +322,50 @@ void CppEmitterTest(std::string testName, std::function<Scalar()> defineFunction
     fn.Define(defineFunction);
 }
 
+// Checks that a vectorized loop nest index is emitted as vector loads, stores, and arithmetic
+void LLVMVectorizedIRTest()
+{
+    const std::string testName = "LoopNest_api_Vectorized_IR_test";
+    std::cout << "Running LLVM IR test " << testName << std::endl;
+
+    ell::emitters::CompilerOptions compilerSettings;
+    compilerSettings.useBlas = false;
+    ell::emitters::IRModuleEmitter moduleEmitter("Value_test_llvm_ir", compilerSettings);
+    {
+        ContextGuard<TestLLVMContext> guard(moduleEmitter);
+
+        // 16-byte vectors of floats: two full vectors of 4 and a scalar tail of 2
+        const int N = 3;
+        const int M = 10;
+        DeclareFunction(testName)
+            .Parameters(Value(ValueType::Float, MemoryLayout{ { N, M } }), Value(ValueType::Float, MemoryLayout{ { N, M } }))
+            .Define([](Matrix output, Matrix input) {
+                Index i("i"), j("j");
+                auto nest = Using({ output }, ArgumentType::InputOutput)
+                                .Using({ input }, ArgumentType::Input)
+                                .ForAll(i, 0, N)
+                                .ForAll(j, 0, M)
+                                .Do([](Matrix out, Matrix in, Scalar row, Scalar column) {
+                                    out(row, column) += in(row, column) * 3.0f;
+                                });
+                nest.GetSchedule().Vectorize(j, 16);
+                nest.Run();
+            });
+    }
+
+    ell::emitters::IROptimizer optimizer(moduleEmitter);
+    moduleEmitter.Optimize(optimizer);
+
+    std::stringstream ir;
+    moduleEmitter.WriteToStream(ir, ell::emitters::ModuleOutputFormat::ir);
+    auto irText = ir.str();
+
+    bool hasVectorLoad = irText.find("load <4 x float>") != std::string::npos;
+    bool hasVectorStore = irText.find("store <4 x float>") != std::string::npos;
+    bool hasVectorArithmetic = irText.find("fmul <4 x float>") != std::string::npos || irText.find("fmuladd.v4f32") != std::string::npos;
+    ell::testing::ProcessTest(testName + ": vectorized loop emits vector loads, stores, and arithmetic", hasVectorLoad && hasVectorStore && hasVectorArithmetic);
+}
+
 void RunTest(std::string testName, std::function<Scalar()> defineFunction)
 {
     try
@@ -489,12 +537,15 @@ int main()
         ADD_TEST_FUNCTION(LoopNest_api_Parallelized_test1);
         ADD_TEST_FUNCTION(LoopNest_api_Parallelized_test2);
         ADD_TEST_FUNCTION(LoopNest_api_Unrolled_test1);
+        ADD_TEST_FUNCTION(LoopNest_api_Vectorized_test1);
         ADD_TEST_FUNCTION(LoopNest_api_SetOrder_test1);
         // ADD_TEST_FUNCTION(LoopNest_api_CachedMatrix_test1); // Fails
         ADD_TEST_FUNCTION(GotoBLASGemmWithRefDeref);
         ADD_TEST_FUNCTION(YG12LowLevel_TestBoundary);
 
         ADD_TEST_FUNCTION(Parallelized_ComputeContext_test1);
+        ADD_TEST_FUNCTION(Parallelized_ComputeContext_test2);
+        ADD_TEST_FUNCTION(Parallelized_ComputeContext_test3);
 
         ADD_TEST_FUNCTION(MemCopy_test1);
         ADD_TEST_FUNCTION(MemSet_test1);
@@ -661,6 +712,8 @@ int main()
         }
 
 #undef ADD_TEST_FUNCTION
+
+        LLVMVectorizedIRTest();
     }
     catch (const std::exception& exception)
     {
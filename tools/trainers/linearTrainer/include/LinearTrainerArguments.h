@@ -29,6 +29,8 @@ struct LinearTrainerArguments
     size_t maxEpochs;
     bool permute;
     std::string randomSeedString;
+    size_t numThreads;
+    size_t miniBatchSize;
 };
 
 /// <summary> Parsed version of LinearTrainerArguments. </summary>
@@ -55,5 +55,17 @@ void ParsedLinearTrainerArguments::AddArgs(utilities::CommandLineParser& parser)
                      "seed",
                      "The random seed string",
                      "ABCDEFG");
+
+    parser.AddOption(numThreads,
+                     "numThreads",
+                     "nt",
+                     "The number of threads used by the SGD and SDCA algorithms (0 = use the hardware concurrency). Both take mini-batch steps when this is not 1",
+                     1);
+
+    parser.AddOption(miniBatchSize,
+                     "miniBatchSize",
+                     "mbs",
+                     "The number of examples each thread processes per SGD or SDCA mini-batch, when numThreads is not 1",
+                     16);
 }
 } // namespace ell
@@ -110,8 +110,7 @@ int main(int argc, char* argv[])
 
         // load dataset
         if (trainerArguments.verbose) std::cout << "Loading data ..." << std::endl;
-        auto stream = utilities::OpenIfstream(dataLoadArguments.inputDataFilename);
-        auto parsedDataset = common::GetDataset(stream);
+        auto parsedDataset = common::GetDataset(dataLoadArguments);
         auto mappedDataset = common::TransformDataset(parsedDataset, map);
         auto mappedDatasetDimension = map.GetOutput(0).Size();
 
@@ -142,7 +141,7 @@ int main(int argc, char* argv[])
         switch (linearTrainerArguments.algorithm)
         {
         case LinearTrainerArguments::Algorithm::SGD:
-            trainer = common::MakeSGDTrainer(trainerArguments.lossFunctionArguments, { linearTrainerArguments.regularization, linearTrainerArguments.randomSeedString });
+            trainer = common::MakeSGDTrainer(trainerArguments.lossFunctionArguments, { linearTrainerArguments.regularization, linearTrainerArguments.randomSeedString, linearTrainerArguments.numThreads, linearTrainerArguments.miniBatchSize });
             break;
         case LinearTrainerArguments::Algorithm::SparseDataSGD:
             trainer = common::MakeSparseDataSGDTrainer(trainerArguments.lossFunctionArguments, { linearTrainerArguments.regularization, linearTrainerArguments.randomSeedString });
@@ -155,7 +154,7 @@ int main(int argc, char* argv[])
         }
         case LinearTrainerArguments::Algorithm::SDCA:
         {
-            trainer = common::MakeSDCATrainer(trainerArguments.lossFunctionArguments, { linearTrainerArguments.regularization, linearTrainerArguments.desiredPrecision, linearTrainerArguments.maxEpochs, linearTrainerArguments.permute, linearTrainerArguments.randomSeedString });
+            trainer = common::MakeSDCATrainer(trainerArguments.lossFunctionArguments, { linearTrainerArguments.regularization, linearTrainerArguments.desiredPrecision, linearTrainerArguments.maxEpochs, linearTrainerArguments.permute, linearTrainerArguments.randomSeedString, linearTrainerArguments.numThreads, linearTrainerArguments.miniBatchSize });
             break;
         }
         default:
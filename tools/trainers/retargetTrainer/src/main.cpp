@@ -422,14 +422,15 @@ int main(int argc, char* argv[])
         std::cout << "Using output from node of type " << node->GetRuntimeTypeName() << std::endl;
 
         // load dataset and map the output
+        common::DataLoadArguments dataLoadArguments;
+        dataLoadArguments.inputDataFilename = retargetArguments.inputDataFilename;
         if (retargetArguments.verbose) std::cout << "Loading data ...";
         model::Map result;
         if (retargetArguments.multiClass)
         {
             // This is a multi-class dataset
             _timer.Start();
-            auto stream = utilities::OpenIfstream(retargetArguments.inputDataFilename);
-            auto multiclassDataset = common::GetMultiClassDataset(stream);
+            auto multiclassDataset = common::GetMultiClassDataset(dataLoadArguments);
             if (retargetArguments.verbose) std::cout << "(" << _timer.Elapsed() << " ms)" << std::endl;
 
             // Obtain a new training dataset for the set of Linear Predictors by running the
@@ -468,8 +469,7 @@ int main(int argc, char* argv[])
         {
             // This is a binary classification dataset
             _timer.Start();
-            auto stream = utilities::OpenIfstream(retargetArguments.inputDataFilename);
-            auto binaryDataset = common::GetDataset(stream);
+            auto binaryDataset = common::GetDataset(dataLoadArguments);
             if (retargetArguments.verbose) std::cout << "Loading dataset took :" << _timer.Elapsed() << " ms" << std::endl;
             // Obtain a new training dataset for the Linear Predictor by running the
             // binaryDataset through the modified model
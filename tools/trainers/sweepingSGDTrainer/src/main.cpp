@@ -59,6 +59,19 @@ int main(int argc, char* argv[])
         commandLineParser.AddOptionSet(mapLoadArguments);
         commandLineParser.AddOptionSet(modelSaveArguments);
 
+        size_t numThreads = 1;
+        size_t miniBatchSize = 16;
+        commandLineParser.AddOption(numThreads,
+                                    "numThreads",
+                                    "nt",
+                                    "The number of threads used by each SGD trainer (0 = use the hardware concurrency). The trainers take mini-batch steps when this is not 1",
+                                    1);
+        commandLineParser.AddOption(miniBatchSize,
+                                    "miniBatchSize",
+                                    "mbs",
+                                    "The number of examples each thread processes per SGD step, when numThreads is not 1",
+                                    16);
+
         // parse command line
         commandLineParser.Parse();
 
@@ -68,6 +81,8 @@ int main(int argc, char* argv[])
         // manually define regularization parameters to sweep over
         std::vector<double> regularization{ 1.0e-0, 1.0e-1, 1.0e-2, 1.0e-3, 1.0e-4, 1.0e-5, 1.0e-6 };
         std::vector<std::string> randomSeeds(regularization.size(), defaultRandomSeed);
+        std::vector<size_t> numThreadsValues{ numThreads };
+        std::vector<size_t> miniBatchSizes{ miniBatchSize };
 
         if (trainerArguments.verbose)
         {
@@ -81,8 +96,7 @@ int main(int argc, char* argv[])
 
         // load dataset
         if (trainerArguments.verbose) std::cout << "Loading data ..." << std::endl;
-        auto stream = utilities::OpenIfstream(dataLoadArguments.inputDataFilename);
-        auto parsedDataset = common::GetDataset(stream);
+        auto parsedDataset = common::GetDataset(dataLoadArguments);
         auto mappedDataset = common::TransformDataset(parsedDataset, map);
         auto mappedDatasetDimension = map.GetOutput(0).Size();
 
@@ -94,7 +108,7 @@ int main(int argc, char* argv[])
         evaluators::EvaluatorParameters evaluatorParameters{ 1, false };
 
         // create trainers
-        auto generator = common::MakeParametersEnumerator<trainers::SGDTrainerParameters>(regularization, randomSeeds);
+        auto generator = common::MakeParametersEnumerator<trainers::SGDTrainerParameters>(regularization, randomSeeds, numThreadsValues, miniBatchSizes);
         std::vector<trainers::EvaluatingTrainer<PredictorType>> evaluatingTrainers;
         std::vector<std::shared_ptr<evaluators::IEvaluator<PredictorType>>> evaluators;
         for (size_t i = 0; i < regularization.size(); ++i)
@@ -0,0 +1,23 @@
+#
+# Runs apply on the same data in its default mode and with the given options, and checks that the outputs match
+#
+
+set(reference_output ${OUTPUT_DIR}/apply_reference_output.txt)
+set(test_output ${OUTPUT_DIR}/apply_test_output.txt)
+separate_arguments(test_options UNIX_COMMAND "${TEST_OPTIONS}")
+
+execute_process(COMMAND ${APPLY_EXE} -idf ${DATA_FILE} -imf ${MODEL_FILE} -odf ${reference_output} RESULT_VARIABLE COMMAND_RESULT)
+if(COMMAND_RESULT)
+  message(FATAL_ERROR "Error running apply: " ${COMMAND_RESULT})
+endif()
+
+execute_process(COMMAND ${APPLY_EXE} -idf ${DATA_FILE} -imf ${MODEL_FILE} -odf ${test_output} ${test_options} RESULT_VARIABLE COMMAND_RESULT)
+if(COMMAND_RESULT)
+  message(FATAL_ERROR "Error running apply ${TEST_OPTIONS}: " ${COMMAND_RESULT})
+endif()
+
+# The output must have the same values, in the same order as the input
+execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${reference_output} ${test_output} RESULT_VARIABLE COMMAND_RESULT)
+if(COMMAND_RESULT)
+  message(FATAL_ERROR "The output of apply ${TEST_OPTIONS} doesn't match its default output")
+endif()
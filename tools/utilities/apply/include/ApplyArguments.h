@@ -22,6 +22,15 @@ struct ApplyArguments
 
     /// <summary> Instead of raw output, report a summary. </summary>
     bool summarize = false;
+
+    /// <summary> Compile the map(s) with the JIT instead of interpreting them. </summary>
+    bool compile = false;
+
+    /// <summary> The number of examples read and computed together. </summary>
+    int batchSize = 64;
+
+    /// <summary> The number of threads computing batches of examples. </summary>
+    int numThreads = 1;
 };
 
 /// <summary> Parsed command line arguments for the apply executable. </summary>
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ApplyPipeline.h (apply)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <data/include/Example.h>
+#include <data/include/ExampleIterator.h>
+
+#include <model/include/IRCompiledMap.h>
+#include <model/include/Map.h>
+#include <model/include/MapCompilerOptions.h>
+#include <model/include/ModelOptimizerOptions.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace ell
+{
+/// <summary> Computes the output of a map for batches of examples. An instance is only used by one thread at a time. </summary>
+class MapEvaluator
+{
+public:
+    virtual ~MapEvaluator() = default;
+
+    /// <summary> Computes the map output for each example in a batch. </summary>
+    ///
+    /// <param name="examples"> The examples. </param>
+    /// <param name="outputs"> [out] The map output for each example. </param>
+    virtual void Compute(const std::vector<data::AutoSupervisedExample>& examples, std::vector<std::vector<double>>& outputs) = 0;
+};
+
+/// <summary> Evaluates a map with the reference implementation, one example at a time. </summary>
+class ReferenceMapEvaluator : public MapEvaluator
+{
+public:
+    /// <summary> Constructor </summary>
+    ///
+    /// <param name="map"> The map. The evaluator works on its own copy. </param>
+    ReferenceMapEvaluator(const model::Map& map);
+
+    void Compute(const std::vector<data::AutoSupervisedExample>& examples, std::vector<std::vector<double>>& outputs) override;
+
+private:
+    model::Map _map;
+};
+
+/// <summary> Evaluates a compiled map, a batch at a time. </summary>
+class CompiledMapEvaluator : public MapEvaluator
+{
+public:
+    /// <summary> Constructor </summary>
+    ///
+    /// <param name="map"> The compiled map. It must have one input and one output, of type float or double, and no source nodes. </param>
+    CompiledMapEvaluator(model::IRCompiledMap map);
+
+    void Compute(const std::vector<data::AutoSupervisedExample>& examples, std::vector<std::vector<double>>& outputs) override;
+
+private:
+    template <typename InputType, typename OutputType>
+    void ComputeBatch(const std::vector<data::AutoSupervisedExample>& examples, std::vector<std::vector<double>>& outputs);
+
+    model::IRCompiledMap _map;
+};
+
+/// <summary> Evaluates the difference between the outputs of two maps. </summary>
+class DifferenceMapEvaluator : public MapEvaluator
+{
+public:
+    /// <summary> Constructor </summary>
+    ///
+    /// <param name="evaluator1"> The evaluator for the first map. </param>
+    /// <param name="evaluator2"> The evaluator for the map to subtract from the first one. </param>
+    DifferenceMapEvaluator(std::unique_ptr<MapEvaluator> evaluator1, std::unique_ptr<MapEvaluator> evaluator2);
+
+    void Compute(const std::vector<data::AutoSupervisedExample>& examples, std::vector<std::vector<double>>& outputs) override;
+
+private:
+    std::unique_ptr<MapEvaluator> _evaluator1;
+    std::unique_ptr<MapEvaluator> _evaluator2;
+    std::vector<std::vector<double>> _outputs2;
+};
+
+/// <summary> Compiles a map and returns `count` evaluators for it, each with its own copy of the compiled code. </summary>
+///
+/// <param name="map"> The map. </param>
+/// <param name="settings"> The compiler settings. </param>
+/// <param name="optimizerOptions"> The model optimizer options. </param>
+/// <param name="count"> The number of evaluators. </param>
+///
+/// <returns> The evaluators. </returns>
+std::vector<std::unique_ptr<MapEvaluator>> MakeCompiledMapEvaluators(const model::Map& map, const model::MapCompilerOptions& settings, const model::ModelOptimizerOptions& optimizerOptions, size_t count);
+
+/// <summary> Indicates if a map has nodes that keep state between calls, so its output depends on the order it sees the examples in. </summary>
+///
+/// <param name="map"> The map. </param>
+///
+/// <returns> true if any node in the map is stateful. </returns>
+bool HasStatefulNodes(const model::Map& map);
+
+/// <summary> Callback that receives an example and the map output for it. </summary>
+using ApplyOutputFunction = std::function<void(const data::AutoSupervisedExample& example, const std::vector<double>& output)>;
+
+/// <summary>
+/// Applies a map to a stream of examples, with reading, computing, and consuming the results running concurrently.
+/// Examples are read in batches on one thread and computed on one thread per evaluator. The results are passed to
+/// `outputFunction` on the calling thread, in the order the examples were read. The number of batches in flight is
+/// bounded, so memory use doesn't depend on the size of the dataset.
+/// </summary>
+///
+/// <param name="exampleIterator"> The examples. </param>
+/// <param name="evaluators"> The evaluators, one per compute thread. </param>
+/// <param name="batchSize"> The number of examples in a batch. </param>
+/// <param name="outputFunction"> The function to call with each example and its output. </param>
+void ApplyMapInPipeline(data::AutoSupervisedExampleIterator& exampleIterator, std::vector<std::unique_ptr<MapEvaluator>>& evaluators, size_t batchSize, const ApplyOutputFunction& outputFunction);
+} // namespace ell
@@ -25,11 +25,40 @@ void ParsedApplyArguments::AddArgs(utilities::CommandLineParser& parser)
         "s",
         "Aggregate and summarize map output.",
         false);
+
+    parser.AddOption(
+        compile,
+        "compile",
+        "c",
+        "Compile the map with the JIT instead of interpreting it.",
+        false);
+
+    parser.AddOption(
+        batchSize,
+        "batchSize",
+        "bs",
+        "Number of examples read and computed together.",
+        64);
+
+    parser.AddOption(
+        numThreads,
+        "applyThreads",
+        "at",
+        "Number of threads computing batches of examples. Output doesn't depend on it. Maps with state (such as delays or recurrent layers) always use one thread.",
+        1);
 }
 
 utilities::CommandLineParseResult ParsedApplyArguments::PostProcess(const utilities::CommandLineParser& parser)
 {
-    std::vector<std::string> errors;
-    return errors;
+    std::vector<std::string> parseErrorMessages;
+    if (batchSize < 1)
+    {
+        parseErrorMessages.push_back("The batch size must be at least 1.");
+    }
+    if (numThreads < 1)
+    {
+        parseErrorMessages.push_back("The number of apply threads must be at least 1.");
+    }
+    return parseErrorMessages;
 }
 } // namespace ell
@@ -0,0 +1,338 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ApplyPipeline.cpp (apply)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ApplyPipeline.h"
+
+#include <data/include/DenseDataVector.h>
+
+#include <model/include/IRMapCompiler.h>
+
+#include <utilities/include/Exception.h>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace ell
+{
+//
+// ReferenceMapEvaluator
+//
+ReferenceMapEvaluator::ReferenceMapEvaluator(const model::Map& map) :
+    _map(map)
+{
+}
+
+void ReferenceMapEvaluator::Compute(const std::vector<data::AutoSupervisedExample>& examples, std::vector<std::vector<double>>& outputs)
+{
+    outputs.resize(examples.size());
+    for (size_t index = 0; index < examples.size(); ++index)
+    {
+        outputs[index] = _map.Compute<data::DoubleDataVector>(examples[index].GetDataVector()).ToArray();
+        outputs[index].resize(_map.GetOutputSize());
+    }
+}
+
+//
+// CompiledMapEvaluator
+//
+CompiledMapEvaluator::CompiledMapEvaluator(model::IRCompiledMap map) :
+    _map(std::move(map))
+{
+    if (_map.NumInputs() != 1 || _map.NumOutputs() != 1 || !_map.GetSourceNodes().empty())
+    {
+        throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Compiled maps can only be applied if they have one input and one output, and no source nodes");
+    }
+}
+
+void CompiledMapEvaluator::Compute(const std::vector<data::AutoSupervisedExample>& examples, std::vector<std::vector<double>>& outputs)
+{
+    auto inputType = _map.GetInputType();
+    auto outputType = _map.GetOutputType();
+    if (inputType == model::Port::PortType::smallReal && outputType == model::Port::PortType::smallReal)
+    {
+        ComputeBatch<float, float>(examples, outputs);
+    }
+    else if (inputType == model::Port::PortType::smallReal && outputType == model::Port::PortType::real)
+    {
+        ComputeBatch<float, double>(examples, outputs);
+    }
+    else if (inputType == model::Port::PortType::real && outputType == model::Port::PortType::smallReal)
+    {
+        ComputeBatch<double, float>(examples, outputs);
+    }
+    else if (inputType == model::Port::PortType::real && outputType == model::Port::PortType::real)
+    {
+        ComputeBatch<double, double>(examples, outputs);
+    }
+    else
+    {
+        throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch, "Compiled maps can only be applied if their input and output are float or double");
+    }
+}
+
+template <typename InputType, typename OutputType>
+void CompiledMapEvaluator::ComputeBatch(const std::vector<data::AutoSupervisedExample>& examples, std::vector<std::vector<double>>& outputs)
+{
+    auto batchSize = examples.size();
+    // A map compiled for a batch of samples has inputs and outputs that hold all of them
+    auto inputSize = _map.GetInputSize() / _map.GetCompiledBatchSize();
+    auto outputSize = _map.GetOutputSize() / _map.GetCompiledBatchSize();
+
+    std::vector<InputType> input(batchSize * inputSize);
+    for (size_t index = 0; index < batchSize; ++index)
+    {
+        auto values = examples[index].GetDataVector().ToArray(inputSize);
+        std::copy(values.begin(), values.end(), input.begin() + index * inputSize);
+    }
+
+    std::vector<OutputType> output(batchSize * outputSize);
+    _map.ComputeBatch({ input.data() }, { output.data() }, static_cast<int>(batchSize));
+
+    outputs.resize(batchSize);
+    for (size_t index = 0; index < batchSize; ++index)
+    {
+        auto begin = output.begin() + index * outputSize;
+        outputs[index].assign(begin, begin + outputSize);
+    }
+}
+
+//
+// DifferenceMapEvaluator
+//
+DifferenceMapEvaluator::DifferenceMapEvaluator(std::unique_ptr<MapEvaluator> evaluator1, std::unique_ptr<MapEvaluator> evaluator2) :
+    _evaluator1(std::move(evaluator1)),
+    _evaluator2(std::move(evaluator2))
+{
+}
+
+void DifferenceMapEvaluator::Compute(const std::vector<data::AutoSupervisedExample>& examples, std::vector<std::vector<double>>& outputs)
+{
+    _evaluator1->Compute(examples, outputs);
+    _evaluator2->Compute(examples, _outputs2);
+    for (size_t index = 0; index < outputs.size(); ++index)
+    {
+        if (outputs[index].size() != _outputs2[index].size())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "The maps to subtract have different output sizes");
+        }
+
+        for (size_t i = 0; i < outputs[index].size(); ++i)
+        {
+            outputs[index][i] -= _outputs2[index][i];
+        }
+    }
+}
+
+std::vector<std::unique_ptr<MapEvaluator>> MakeCompiledMapEvaluators(const model::Map& map, const model::MapCompilerOptions& settings, const model::ModelOptimizerOptions& optimizerOptions, size_t count)
+{
+    model::IRMapCompiler compiler(settings, optimizerOptions);
+    auto compiledMap = compiler.Compile(map);
+    compiledMap.FinishJitting();
+
+    // Each thread needs its own copy of the jitted code, because compiled maps keep their state and buffers in
+    // global variables
+    std::vector<std::unique_ptr<MapEvaluator>> evaluators;
+    for (size_t index = 1; index < count; ++index)
+    {
+        evaluators.push_back(std::make_unique<CompiledMapEvaluator>(compiledMap.Clone()));
+    }
+    evaluators.push_back(std::make_unique<CompiledMapEvaluator>(std::move(compiledMap)));
+    return evaluators;
+}
+
+bool HasStatefulNodes(const model::Map& map)
+{
+    bool hasStatefulNodes = false;
+    map.GetModel().Visit([&hasStatefulNodes](const model::Node& node) {
+        hasStatefulNodes = hasStatefulNodes || node.IsStateful();
+    });
+    return hasStatefulNodes;
+}
+
+//
+// ApplyMapInPipeline
+//
+namespace
+{
+    struct Batch
+    {
+        size_t sequenceNumber = 0;
+        std::vector<data::AutoSupervisedExample> examples;
+        std::vector<std::vector<double>> outputs;
+    };
+
+    // The state shared by the reader, compute, and output stages
+    struct PipelineState
+    {
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::deque<Batch> pendingBatches; // read, waiting to be computed
+        std::map<size_t, Batch> computedBatches; // computed, waiting to be output, keyed by sequence number
+        size_t numBatchesRead = 0;
+        size_t numBatchesWritten = 0;
+        bool doneReading = false;
+        std::exception_ptr error;
+    };
+
+    void SetError(PipelineState& state)
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (!state.error)
+        {
+            state.error = std::current_exception();
+        }
+        state.changed.notify_all();
+    }
+
+    void ReadBatches(PipelineState& state, data::AutoSupervisedExampleIterator& exampleIterator, size_t batchSize, size_t maxBatchesInFlight)
+    {
+        try
+        {
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(state.mutex);
+                    state.changed.wait(lock, [&] { return state.error || state.numBatchesRead - state.numBatchesWritten < maxBatchesInFlight; });
+                    if (state.error)
+                    {
+                        return;
+                    }
+                }
+
+                Batch batch;
+                batch.examples.reserve(batchSize);
+                while (batch.examples.size() < batchSize && exampleIterator.IsValid())
+                {
+                    batch.examples.push_back(exampleIterator.Get());
+                    exampleIterator.Next();
+                }
+
+                std::lock_guard<std::mutex> lock(state.mutex);
+                if (!batch.examples.empty())
+                {
+                    batch.sequenceNumber = state.numBatchesRead++;
+                    state.pendingBatches.push_back(std::move(batch));
+                }
+                if (!exampleIterator.IsValid())
+                {
+                    state.doneReading = true;
+                }
+                state.changed.notify_all();
+                if (state.doneReading)
+                {
+                    return;
+                }
+            }
+        }
+        catch (...)
+        {
+            SetError(state);
+        }
+    }
+
+    void ComputeBatches(PipelineState& state, MapEvaluator& evaluator)
+    {
+        try
+        {
+            while (true)
+            {
+                Batch batch;
+                {
+                    std::unique_lock<std::mutex> lock(state.mutex);
+                    state.changed.wait(lock, [&] { return state.error || state.doneReading || !state.pendingBatches.empty(); });
+                    if (state.error || state.pendingBatches.empty())
+                    {
+                        return;
+                    }
+                    batch = std::move(state.pendingBatches.front());
+                    state.pendingBatches.pop_front();
+                }
+
+                evaluator.Compute(batch.examples, batch.outputs);
+
+                std::lock_guard<std::mutex> lock(state.mutex);
+                auto sequenceNumber = batch.sequenceNumber;
+                state.computedBatches.emplace(sequenceNumber, std::move(batch));
+                state.changed.notify_all();
+            }
+        }
+        catch (...)
+        {
+            SetError(state);
+        }
+    }
+} // namespace
+
+void ApplyMapInPipeline(data::AutoSupervisedExampleIterator& exampleIterator, std::vector<std::unique_ptr<MapEvaluator>>& evaluators, size_t batchSize, const ApplyOutputFunction& outputFunction)
+{
+    if (evaluators.empty() || batchSize == 0)
+    {
+        throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Applying a map needs at least one evaluator and a nonzero batch size");
+    }
+
+    // Enough batches to keep every compute thread busy while the output is written
+    const auto maxBatchesInFlight = 2 * evaluators.size() + 1;
+
+    PipelineState state;
+    std::vector<std::thread> threads;
+    threads.emplace_back(ReadBatches, std::ref(state), std::ref(exampleIterator), batchSize, maxBatchesInFlight);
+    for (auto& evaluator : evaluators)
+    {
+        threads.emplace_back(ComputeBatches, std::ref(state), std::ref(*evaluator));
+    }
+
+    // Output the batches in order on this thread
+    try
+    {
+        while (true)
+        {
+            Batch batch;
+            {
+                std::unique_lock<std::mutex> lock(state.mutex);
+                state.changed.wait(lock, [&] {
+                    return state.error || state.computedBatches.count(state.numBatchesWritten) != 0 || (state.doneReading && state.numBatchesWritten == state.numBatchesRead);
+                });
+                if (state.error || state.computedBatches.count(state.numBatchesWritten) == 0)
+                {
+                    break;
+                }
+                auto it = state.computedBatches.find(state.numBatchesWritten);
+                batch = std::move(it->second);
+                state.computedBatches.erase(it);
+            }
+
+            for (size_t index = 0; index < batch.examples.size(); ++index)
+            {
+                outputFunction(batch.examples[index], batch.outputs[index]);
+            }
+
+            std::lock_guard<std::mutex> lock(state.mutex);
+            ++state.numBatchesWritten;
+            state.changed.notify_all();
+        }
+    }
+    catch (...)
+    {
+        SetError(state);
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    if (state.error)
+    {
+        std::rethrow_exception(state.error);
+    }
+}
+} // namespace ell
@@ -7,6 +7,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "ApplyArguments.h"
+#include "ApplyPipeline.h"
 
 #include <utilities/include/CommandLineParser.h>
 #include <utilities/include/Exception.h>
@@ -25,14 +26,21 @@
 #include <common/include/DataLoaders.h>
 #include <common/include/DataSaveArguments.h>
 #include <common/include/LoadModel.h>
+#include <common/include/MapCompilerArguments.h>
 #include <common/include/MapLoadArguments.h>
 
 #include <model/include/Map.h>
 #include <model/include/OutputNode.h>
 
+#include <passes/include/StandardTransformations.h>
+
+#include <cmath>
 #include <iostream>
+#include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 using namespace ell;
 
@@ -44,15 +52,18 @@ int main(int argc, char* argv[])
         utilities::CommandLineParser commandLineParser(argc, argv);
 
         // add arguments to the command line parser
-        common::ParsedDataLoadArguments dataLoadArguments;
+        // The examples are parsed as they're read, so there's no option for the number of data loading threads
+        common::ParsedDataLoadArguments dataLoadArguments(std::nullopt, std::nullopt, std::nullopt, common::OptionName(""));
         common::ParsedDataSaveArguments dataSaveArguments;
         common::ParsedMapLoadArguments mapLoadArguments;
         ParsedApplyArguments applyArguments;
+        common::ParsedMapCompilerArguments mapCompilerArguments;
 
         commandLineParser.AddOptionSet(dataLoadArguments);
         commandLineParser.AddOptionSet(dataSaveArguments);
         commandLineParser.AddOptionSet(mapLoadArguments);
         commandLineParser.AddOptionSet(applyArguments);
+        commandLineParser.AddOptionSet(mapCompilerArguments);
 
         // parse command line
         commandLineParser.Parse();
@@ -60,44 +71,76 @@ int main(int argc, char* argv[])
         // load map
         auto map = common::LoadMap(mapLoadArguments);
 
-        // get data iterator
-        auto stream = utilities::OpenIfstream(dataLoadArguments.inputDataFilename);
-        auto exampleIterator = common::GetAutoSupervisedExampleIterator(stream);
+        // get an iterator that parses the examples as they're read
+        auto dataStream = utilities::OpenIfstream(dataLoadArguments.GetDataFilePath());
+        auto exampleIterator = common::GetAutoSupervisedExampleIterator(dataStream);
 
         // get output stream
         auto& outputStream = dataSaveArguments.outputDataStream;
 
-        // output summarization mode
-        if (applyArguments.summarize)
+        // get the map(s) to apply, with an evaluator for each compute thread
+        model::Map map2;
+        bool subtractMap2 = applyArguments.summarize && applyArguments.inputMapFilename2 != "";
+        if (subtractMap2)
+        {
+            map2 = common::LoadMap(applyArguments.inputMapFilename2);
+        }
+
+        // Batches are handed to threads as the threads become free, so a map with state (such as delays or recurrent
+        // layers) would see the examples in a different order on every run. Those maps are computed on one thread.
+        auto numThreads = static_cast<size_t>(applyArguments.numThreads);
+        if (numThreads > 1 && (HasStatefulNodes(map) || (subtractMap2 && HasStatefulNodes(map2))))
         {
-            model::Map map2;
-            if (applyArguments.inputMapFilename2 != "")
+            std::cerr << "The map has stateful nodes, so it is applied on one thread" << std::endl;
+            numThreads = 1;
+        }
+        std::vector<std::unique_ptr<MapEvaluator>> evaluators;
+        if (applyArguments.compile)
+        {
+            passes::AddStandardTransformationsToRegistry();
+            auto settings = mapCompilerArguments.GetMapCompilerOptions("apply");
+            auto optimizerOptions = mapCompilerArguments.GetModelOptimizerOptions();
+            evaluators = MakeCompiledMapEvaluators(map, settings, optimizerOptions, numThreads);
+            if (subtractMap2)
             {
-                map2 = common::LoadMap(applyArguments.inputMapFilename2);
+                settings.moduleName = "apply2";
+                auto evaluators2 = MakeCompiledMapEvaluators(map2, settings, optimizerOptions, numThreads);
+                for (size_t index = 0; index < numThreads; ++index)
+                {
+                    evaluators[index] = std::make_unique<DifferenceMapEvaluator>(std::move(evaluators[index]), std::move(evaluators2[index]));
+                }
             }
+        }
+        else
+        {
+            for (size_t index = 0; index < numThreads; ++index)
+            {
+                std::unique_ptr<MapEvaluator> evaluator = std::make_unique<ReferenceMapEvaluator>(map);
+                if (subtractMap2)
+                {
+                    evaluator = std::make_unique<DifferenceMapEvaluator>(std::move(evaluator), std::make_unique<ReferenceMapEvaluator>(map2));
+                }
+                evaluators.push_back(std::move(evaluator));
+            }
+        }
+        auto batchSize = static_cast<size_t>(applyArguments.batchSize);
 
+        // output summarization mode
+        if (applyArguments.summarize)
+        {
             math::RowVector<double> u(map.GetOutputSize());
             math::RowVector<double> v(map.GetOutputSize());
             size_t count = 0;
 
-            while (exampleIterator.IsValid())
-            {
-                auto example = exampleIterator.Get();
-                auto mappedDataVector = map.Compute<data::DoubleDataVector>(example.GetDataVector());
-                math::RowVector<double> w(map.GetOutputSize());
-                w += mappedDataVector;
-
-                auto mappedDataVector2 = map2.Compute<data::DoubleDataVector>(example.GetDataVector());
-                w += (-1.0) * mappedDataVector2;
+            ApplyMapInPipeline(exampleIterator, evaluators, batchSize, [&](const data::AutoSupervisedExample& example, const std::vector<double>& output) {
+                math::RowVector<double> w(output);
 
                 // accumulate vectors for mean and standard deviation computation
                 u += w;
                 w.Transform([](double x) { return x * x; });
                 v += w;
-
-                exampleIterator.Next();
                 ++count;
-            }
+            });
 
             // calculate and print mean and standard deviation
             double denominator = static_cast<double>(count);
@@ -114,15 +157,11 @@ int main(int argc, char* argv[])
         // output new dataset mode
         else
         {
-            while (exampleIterator.IsValid())
-            {
-                auto example = exampleIterator.Get();
-                auto mappedDataVector = map.Compute<data::FloatDataVector>(example.GetDataVector());
-                auto mappedExample = data::DenseSupervisedExample(std::move(mappedDataVector), example.GetMetadata());
+            ApplyMapInPipeline(exampleIterator, evaluators, batchSize, [&](const data::AutoSupervisedExample& example, const std::vector<double>& output) {
+                auto mappedExample = data::DenseSupervisedExample(data::FloatDataVector(output), example.GetMetadata());
                 mappedExample.Print(outputStream);
                 outputStream << '\n';
-                exampleIterator.Next();
-            }
+            });
         }
     }
     catch (const utilities::CommandLineParserPrintHelpException& exception)
@@ -39,6 +39,10 @@ struct CompileArguments
 
     // model-generation options
     int maxRefinementIterations = 0;
+
+    // schedule tuning options
+    bool tuneSchedules = false;
+    int tuningIterations = 0;
 };
 
 /// <summary> Parsed command line arguments for the compile executable. </summary>
@@ -91,6 +91,22 @@ void ParsedCompileArguments::AddArgs(utilities::CommandLineParser& parser)
         "Base filename for compiled model files (if none specified, use the input model filename)",
         "");
 
+    parser.AddDocumentationString("");
+    parser.AddDocumentationString("Schedule tuning options");
+    parser.AddOption(
+        tuneSchedules,
+        "tuneSchedules",
+        "tune",
+        "Time candidate tile sizes for the matrix multiplications and convolutions in the map, and save the fastest ones to the file given by tuningCachePath before compiling",
+        false);
+
+    parser.AddOption(
+        tuningIterations,
+        "tuningIterations",
+        "ti",
+        "The number of timed runs of each candidate schedule when tuning (only valid if tuneSchedules is set)",
+        10);
+
     parser.AddDocumentationString("");
     parser.AddDocumentationString("Misc options");
     parser.AddOption(
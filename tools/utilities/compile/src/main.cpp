@@ -19,7 +19,9 @@
 #include <model/include/Map.h>
 #include <model/include/OutputNode.h>
 #include <model/include/SetCompilerOptionsTransformation.h>
+#include <model/include/TuningCache.h>
 
+#include <passes/include/ScheduleTuner.h>
 #include <passes/include/StandardTransformations.h>
 
 #include <utilities/include/CommandLineParser.h>
@@ -135,6 +137,35 @@ void ProduceMapOutput(ParsedCompileArguments& compileArguments, common::ParsedMa
         common::SaveMap(map, baseFilename + "_refined.ell");
     }
 
+    // A map loaded from the compiled map cache only has its generated code, not the function declarations a header
+    // needs or the refined map
+    if (compileArguments.outputHeader || compileArguments.outputSwigInterface || compileArguments.outputCompiledMap)
+    {
+        settings.compiledMapCachePath.clear();
+    }
+
+    // Tune before creating the compiler, which loads the tuning cache when it's constructed
+    if (compileArguments.tuneSchedules)
+    {
+        if (settings.tuningCachePath.empty())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "tuneSchedules requires a tuningCachePath to save the tuned schedules to");
+        }
+
+        TimingOutputCollector timer(timingOutput, "Time to tune schedules", compileArguments.verbose);
+        auto cache = model::TuningCache::Load(settings.tuningCachePath);
+        passes::ScheduleTunerOptions tunerOptions;
+        tunerOptions.numIterations = compileArguments.tuningIterations;
+
+        // Don't fill the compiled map cache with the maps that time each candidate schedule
+        auto tunerCompilerOptions = settings;
+        tunerCompilerOptions.compiledMapCachePath.clear();
+        auto numTuned = passes::TuneSchedules(map, tunerCompilerOptions, cache, tunerOptions);
+        cache.Save(settings.tuningCachePath);
+        timer.Stop();
+        std::cout << "Tuned " << numTuned << " schedules, saved to " << settings.tuningCachePath << std::endl;
+    }
+
     auto optimizerOptions = mapCompilerArguments.GetModelOptimizerOptions();
 
     model::IRMapCompiler compiler(settings, optimizerOptions);
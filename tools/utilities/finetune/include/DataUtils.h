@@ -73,7 +73,8 @@ using MultiClassDataContainer = VectorContainer<MultiClassExample>;
 using VectorLabelDataContainer = ell::optimization::VectorIndexedContainer<VectorLabelExample, VectorLabelSolutionExample>;
 
 /// <summary> Load a dataset with binary labels from a GSDF-format text file. </summary>
-BinaryLabelDataContainer LoadBinaryLabelDataContainer(std::string filename);
+/// The default "0" value for numLoadThreads means "use all available cores"
+BinaryLabelDataContainer LoadBinaryLabelDataContainer(std::string filename, size_t numLoadThreads = 0);
 
 /// <summary> Load a multiclass dataset from a file, attempting to guess the data format from the filename extension. </summary>
 /// The default "-1" value for maxRows means "all rows"
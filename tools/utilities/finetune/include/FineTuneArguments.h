@@ -67,6 +67,9 @@ struct FineTuneArguments
     bool multiClass = true;
     std::string dataFormat;
     int maxCacheEntries = 8;
+    int maxCacheMemoryMB = 0;
+    bool cacheHalfPrecision = false;
+    std::string cacheSpillDirectory;
 
     // Node selection
     int numPrefixNodesToSkip = 0;
@@ -118,8 +121,8 @@ struct FineTuneArguments
     ell::utilities::OutputStreamImpostor GetReportStream() const;
 
     FineTuneArguments() :
-        trainDataArguments(ell::common::OptionName{ "trainDataFilename" }, ell::common::OptionName{ "trainDataDirectory" }, ell::common::OptionName{ "trainDataDimension" }),
-        testDataArguments(ell::common::OptionName{ "testDataFilename" }, ell::common::OptionName{ "testDataDirectory" }, ell::common::OptionName{ "testDataDimension" })
+        trainDataArguments(ell::common::OptionName{ "trainDataFilename" }, ell::common::OptionName{ "trainDataDirectory" }, ell::common::OptionName{ "trainDataDimension" }, ell::common::OptionName{ "trainDataLoadThreads" }),
+        testDataArguments(ell::common::OptionName{ "testDataFilename" }, ell::common::OptionName{ "testDataDirectory" }, ell::common::OptionName{ "testDataDimension" }, ell::common::OptionName{ "testDataLoadThreads" })
     {}
 
 private:
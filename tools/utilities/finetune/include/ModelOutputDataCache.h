@@ -12,34 +12,98 @@
 
 #include <model/include/OutputPort.h>
 
+#include <cstdint>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace ell
 {
-/// <summary> Caches the results from running a dataset through a model. </summary>
+/// <summary> Options for limiting the memory used by a `ModelOutputDataCache`. </summary>
+struct ModelOutputDataCacheOptions
+{
+    /// <summary> The maximum number of entries, whether in memory or spilled to disk (0 = no limit). </summary>
+    int maxEntries = 0;
+
+    /// <summary> The maximum number of bytes of data to keep in memory (0 = no limit). </summary>
+    size_t maxMemoryBytes = 0;
+
+    /// <summary> Store the data as 16-bit floats, halving the memory it takes, at the cost of rounding the values. </summary>
+    bool useHalfPrecision = false;
+
+    /// <summary>
+    /// A directory to write entries to when they don't fit in memory (empty = discard them instead). Spilled entries
+    /// are memory-mapped when they're read.
+    /// </summary>
+    std::string spillDirectory;
+};
+
+/// <summary>
+/// Caches the results from running a dataset through a model. When the cache is over its memory budget, the
+/// least-recently-used entries are moved to the spill directory, or discarded if there isn't one.
+/// </summary>
 class ModelOutputDataCache
 {
 public:
     ModelOutputDataCache();
     ModelOutputDataCache(int maxCacheSize);
+    ModelOutputDataCache(const ModelOutputDataCacheOptions& options);
+    ~ModelOutputDataCache();
+
+    ModelOutputDataCache(const ModelOutputDataCache&) = delete;
+    ModelOutputDataCache& operator=(const ModelOutputDataCache&) = delete;
+
     bool HasCachedData(const ell::model::OutputPortBase* port) const;
-    const UnlabeledDataContainer& GetCachedData(const ell::model::OutputPortBase* port) const;
+
+    /// <summary>
+    /// Gets the data cached for a port. The reference is valid until the next call that gets, sets or removes data,
+    /// because entries that are stored in half precision or spilled to disk are decoded into a buffer that is reused.
+    /// The decoded buffer counts against the memory limit, and other entries are evicted to make room for it.
+    /// </summary>
+    const UnlabeledDataContainer& GetCachedData(const ell::model::OutputPortBase* port);
     void RemoveCachedData(const ell::model::OutputPortBase* port);
     void SetCachedData(const ell::model::OutputPortBase* port, UnlabeledDataContainer data);
 
     // ??
     const ell::model::OutputPortBase* FindNearestCachedOutputPort(const ell::model::OutputPortBase* output);
 
+    /// <summary> Returns the number of bytes of cached data held in memory, including the buffer that the last entry read was decoded into. </summary>
+    size_t GetMemoryUsage() const { return _memoryUsage; }
+
+    /// <summary> Indicates if the data for a port has been spilled to disk. </summary>
+    bool IsSpilled(const ell::model::OutputPortBase* port) const;
+
 private:
-    void RemoveLeastRecentlyUsedEntry();
+    enum class StorageLocation
+    {
+        memory,
+        disk
+    };
 
     struct CacheEntry
     {
-        int64_t generation;
-        UnlabeledDataContainer data;
+        int64_t generation = 0;
+        StorageLocation location = StorageLocation::memory;
+        UnlabeledDataContainer data; // used for full-precision entries in memory
+        std::vector<uint16_t> halfData; // used for half-precision entries in memory
+        std::vector<size_t> rowOffsets; // the start of each row in the stored values, and the total number of values
+        std::string spillFilePath;
     };
+
+    void RemoveLeastRecentlyUsedEntry();
+    bool EvictLeastRecentlyUsedInMemoryEntry(const ell::model::OutputPortBase* excludedPort = nullptr);
+    void ReleaseDecodedData();
+    void Spill(CacheEntry& entry);
+    void Remove(std::unordered_map<const ell::model::OutputPortBase*, CacheEntry>::iterator entry);
+    size_t GetStoredSize(const CacheEntry& entry) const;
+    size_t GetBytesPerValue() const { return _options.useHalfPrecision ? sizeof(uint16_t) : sizeof(float); }
+
     mutable std::unordered_map<const ell::model::OutputPortBase*, CacheEntry> _cache;
     mutable int64_t _currentGeneration = 0;
-    int _maxCacheSize = 0;
+    UnlabeledDataContainer _decodedData;
+    size_t _decodedDataSize = 0;
+    ModelOutputDataCacheOptions _options;
+    size_t _memoryUsage = 0;
+    int _nextSpillFileIndex = 0;
 };
 } // namespace ell
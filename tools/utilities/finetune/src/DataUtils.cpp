@@ -226,14 +226,16 @@ namespace
         return result;
     }
 
-    BinaryDataset LoadBinaryDataset(std::string filename)
+    BinaryDataset LoadBinaryDataset(std::string filename, size_t numLoadThreads)
     {
         if (!utilities::IsFileReadable(filename))
         {
             throw utilities::SystemException(utilities::SystemExceptionErrors::fileNotFound, "Dataset file not readable: " + filename);
         }
-        auto stream = utilities::OpenIfstream(filename);
-        auto dataset = common::GetDataset(stream);
+        common::DataLoadArguments dataLoadArguments;
+        dataLoadArguments.inputDataFilename = filename;
+        dataLoadArguments.numLoadThreads = numLoadThreads;
+        auto dataset = common::GetDataset(dataLoadArguments);
         return dataset;
     }
 
@@ -303,9 +305,9 @@ UnlabeledDataContainer GetDatasetInputs(const DatasetType& dataset);
 void AppendCifarData(std::string cifarBatchFile, int maxRows, ell::math::ConstRowVectorReference<float> scale, ell::math::ConstRowVectorReference<float> biasAdjust, MultiClassDataContainer& dataset);
 
 // Implementations
-BinaryLabelDataContainer LoadBinaryLabelDataContainer(std::string filename)
+BinaryLabelDataContainer LoadBinaryLabelDataContainer(std::string filename, size_t numLoadThreads)
 {
-    return FromDataset(LoadBinaryDataset(filename));
+    return FromDataset(LoadBinaryDataset(filename, numLoadThreads));
 }
 
 template <typename IndexValueParsingIterator>
@@ -232,6 +232,16 @@ void InitArguments(utilities::CommandLineParser& parser, FineTuneArguments& args
 
     parser.AddOption(args.dataFormat, "format", "", "Dataset format (GSDF, CIFAR, MNIST; default: guess)", "");
 
+    parser.AddDocumentationString("");
+    parser.AddDocumentationString("Transformed data cache");
+    parser.AddOption(args.maxCacheEntries, "maxCacheEntries", "", "Maximum number of layer outputs to cache (0 = no limit)", 8);
+
+    parser.AddOption(args.maxCacheMemoryMB, "maxCacheMemory", "", "Maximum amount of cached layer output data to keep in memory, in MB (0 = no limit)", 0);
+
+    parser.AddOption(args.cacheHalfPrecision, "cacheHalfPrecision", "", "Store cached layer outputs as 16-bit floats", false);
+
+    parser.AddOption(args.cacheSpillDirectory, "cacheSpillDirectory", "", "Directory to move cached layer outputs to when they don't fit in memory (default: discard them)", "");
+
     parser.AddDocumentationString("");
     parser.AddDocumentationString("Node selection");
     parser.AddOption(args.numPrefixNodesToSkip, "skipStart", "", "Number of nodes in the beginning of the model to skip", 0);
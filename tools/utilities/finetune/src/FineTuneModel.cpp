@@ -158,7 +158,7 @@ const typename NodeTypeFromParametersType<ElementType, LayerParametersType>::Nod
 
 BinaryLabelDataContainer GetBinaryTrainingDataset(const FineTuneArguments& args)
 {
-    return LoadBinaryLabelDataContainer(args.trainDataArguments.inputDataFilename);
+    return LoadBinaryLabelDataContainer(args.trainDataArguments.inputDataFilename, args.trainDataArguments.numLoadThreads);
 }
 
 MultiClassDataContainer GetMultiClassTrainingDataset(const FineTuneArguments& args)
@@ -184,7 +184,7 @@ BinaryLabelDataContainer GetBinaryTestDataset(const FineTuneArguments& args)
         return {};
     }
 
-    return LoadBinaryLabelDataContainer(args.testDataArguments.inputDataFilename);
+    return LoadBinaryLabelDataContainer(args.testDataArguments.inputDataFilename, args.testDataArguments.numLoadThreads);
 }
 
 MultiClassDataContainer GetMultiClassTestDataset(const FineTuneArguments& args)
@@ -240,7 +240,12 @@ FineTuningResult FineTuneNodesInSubmodel(const Submodel& submodel,
     std::chrono::milliseconds::rep optimizationTime = 0;
     std::vector<FineTuningLayerResult> layerResults;
 
-    ModelOutputDataCache dataCache(args.maxCacheEntries);
+    ModelOutputDataCacheOptions cacheOptions;
+    cacheOptions.maxEntries = args.maxCacheEntries;
+    cacheOptions.maxMemoryBytes = static_cast<size_t>(args.maxCacheMemoryMB) * 1024 * 1024;
+    cacheOptions.useHalfPrecision = args.cacheHalfPrecision;
+    cacheOptions.spillDirectory = args.cacheSpillDirectory;
+    ModelOutputDataCache dataCache(cacheOptions);
 
     bool didModifyAnyNodes = false;
     auto problemParams = args.GetFineTuneProblemParameters();
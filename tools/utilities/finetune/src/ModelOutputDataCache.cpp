@@ -11,20 +11,115 @@
 #include <model/include/InputPort.h>
 
 #include <utilities/include/Exception.h>
+#include <utilities/include/Files.h>
 #include <utilities/include/Logger.h>
+#include <utilities/include/MemoryMappedFile.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 
 namespace ell
 {
 using namespace ell::model;
 
-ModelOutputDataCache::ModelOutputDataCache() :
-    _maxCacheSize(0)
+namespace
+{
+    // Converts a float to IEEE half precision, rounding to nearest even
+    uint16_t FloatToHalf(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        uint32_t sign = (bits >> 16) & 0x8000;
+        uint32_t absBits = bits & 0x7fffffff;
+
+        if (absBits >= 0x47800000) // too large for a half, infinity or NaN
+        {
+            return static_cast<uint16_t>(sign | (absBits > 0x7f800000 ? 0x7e00 : 0x7c00));
+        }
+
+        if (absBits < 0x38800000) // a denormal half (or zero): let the FPU do the rounding
+        {
+            float absValue;
+            std::memcpy(&absValue, &absBits, sizeof(absValue));
+            absValue += 0.5f;
+            std::memcpy(&absBits, &absValue, sizeof(absBits));
+            return static_cast<uint16_t>(sign | (absBits - 0x3f000000));
+        }
+
+        uint32_t mantissaOdd = (absBits >> 13) & 1;
+        absBits += 0xc8000fff; // rebias the exponent from 127 to 15, and round
+        absBits += mantissaOdd;
+        return static_cast<uint16_t>(sign | (absBits >> 13));
+    }
+
+    float HalfToFloat(uint16_t value)
+    {
+        uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+        uint32_t exponent = (value >> 10) & 0x1f;
+        uint32_t mantissa = value & 0x3ff;
+
+        uint32_t bits;
+        if (exponent == 0) // zero or denormal
+        {
+            float absValue = static_cast<float>(mantissa) * 5.9604644775390625e-8f; // 2^-24
+            std::memcpy(&bits, &absValue, sizeof(bits));
+            bits |= sign;
+        }
+        else if (exponent == 0x1f) // infinity or NaN
+        {
+            bits = sign | 0x7f800000 | (mantissa << 13);
+        }
+        else
+        {
+            bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+        }
+
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    template <typename ValueType, typename ConvertFunction>
+    UnlabeledDataContainer DecodeRows(const ValueType* values, const std::vector<size_t>& rowOffsets, ConvertFunction convert)
+    {
+        UnlabeledDataContainer result;
+        std::vector<float> row;
+        for (size_t rowIndex = 0; rowIndex + 1 < rowOffsets.size(); ++rowIndex)
+        {
+            row.resize(rowOffsets[rowIndex + 1] - rowOffsets[rowIndex]);
+            std::transform(values + rowOffsets[rowIndex], values + rowOffsets[rowIndex + 1], row.begin(), convert);
+            result.Add(UnlabeledExample(row));
+        }
+        return result;
+    }
+} // namespace
+
+ModelOutputDataCache::ModelOutputDataCache() = default;
+
+ModelOutputDataCache::ModelOutputDataCache(int maxCacheSize)
+{
+    _options.maxEntries = maxCacheSize;
+}
+
+ModelOutputDataCache::ModelOutputDataCache(const ModelOutputDataCacheOptions& options) :
+    _options(options)
 {
+    if (!_options.spillDirectory.empty())
+    {
+        utilities::EnsureDirectoryExists(_options.spillDirectory);
+    }
 }
 
-ModelOutputDataCache::ModelOutputDataCache(int maxCacheSize) :
-    _maxCacheSize(maxCacheSize)
+ModelOutputDataCache::~ModelOutputDataCache()
 {
+    for (const auto& entry : _cache)
+    {
+        if (!entry.second.spillFilePath.empty())
+        {
+            std::remove(entry.second.spillFilePath.c_str());
+        }
+    }
 }
 
 bool ModelOutputDataCache::HasCachedData(const ell::model::OutputPortBase* port) const
@@ -32,27 +127,136 @@ bool ModelOutputDataCache::HasCachedData(const ell::model::OutputPortBase* port)
     return _cache.find(port) != _cache.end();
 }
 
-const UnlabeledDataContainer& ModelOutputDataCache::GetCachedData(const ell::model::OutputPortBase* port) const
+bool ModelOutputDataCache::IsSpilled(const ell::model::OutputPortBase* port) const
+{
+    auto it = _cache.find(port);
+    return it != _cache.end() && it->second.location == StorageLocation::disk;
+}
+
+const UnlabeledDataContainer& ModelOutputDataCache::GetCachedData(const ell::model::OutputPortBase* port)
 {
     ++_currentGeneration;
-    _cache.at(port).generation = _currentGeneration;
-    return _cache.at(port).data;
+    auto& entry = _cache.at(port);
+    entry.generation = _currentGeneration;
+
+    ReleaseDecodedData();
+    if (entry.location == StorageLocation::memory && !_options.useHalfPrecision)
+    {
+        return entry.data;
+    }
+
+    // The decoded copy counts against the memory limit, so make room for it by evicting other entries
+    auto decodedSize = entry.rowOffsets.back() * sizeof(float);
+    while (_options.maxMemoryBytes > 0 && _memoryUsage + decodedSize > _options.maxMemoryBytes)
+    {
+        if (!EvictLeastRecentlyUsedInMemoryEntry(port))
+        {
+            break;
+        }
+    }
+
+    if (entry.location == StorageLocation::disk)
+    {
+        utilities::MemoryMappedFile file(entry.spillFilePath);
+        if (_options.useHalfPrecision)
+        {
+            _decodedData = DecodeRows(reinterpret_cast<const uint16_t*>(file.GetData()), entry.rowOffsets, HalfToFloat);
+        }
+        else
+        {
+            _decodedData = DecodeRows(reinterpret_cast<const float*>(file.GetData()), entry.rowOffsets, [](float value) { return value; });
+        }
+    }
+    else
+    {
+        _decodedData = DecodeRows(entry.halfData.data(), entry.rowOffsets, HalfToFloat);
+    }
+
+    _decodedDataSize = decodedSize;
+    _memoryUsage += decodedSize;
+    return _decodedData;
 }
 
 void ModelOutputDataCache::RemoveCachedData(const ell::model::OutputPortBase* port)
 {
-    _cache.erase(port);
+    ReleaseDecodedData();
+    auto it = _cache.find(port);
+    if (it != _cache.end())
+    {
+        Remove(it);
+    }
 }
 
 void ModelOutputDataCache::SetCachedData(const ell::model::OutputPortBase* port, UnlabeledDataContainer data)
 {
-    // if the cache is too big, first remove entries
-    while (_maxCacheSize > 0 && static_cast<int>(_cache.size()) >= _maxCacheSize)
+    using namespace logging;
+
+    RemoveCachedData(port);
+
+    CacheEntry entry;
+    entry.generation = _currentGeneration;
+    entry.rowOffsets.push_back(0);
+    for (const auto& row : data)
+    {
+        entry.rowOffsets.push_back(entry.rowOffsets.back() + row.Size());
+    }
+
+    // An entry that can never fit in memory is written straight to disk, or not cached at all, without evicting
+    // anything to make room for it
+    auto size = GetStoredSize(entry);
+    bool fitsInMemory = _options.maxMemoryBytes == 0 || size <= _options.maxMemoryBytes;
+    if (!fitsInMemory && _options.spillDirectory.empty())
+    {
+        Log() << "Not caching data for port " << port->GetFullName() << ": it's larger than the cache memory limit" << EOL;
+        return;
+    }
+
+    // if the cache has too many entries, first remove entries
+    while (_options.maxEntries > 0 && static_cast<int>(_cache.size()) >= _options.maxEntries)
     {
         RemoveLeastRecentlyUsedEntry();
     }
 
-    _cache[port] = { _currentGeneration, data };
+    if (_options.useHalfPrecision)
+    {
+        entry.halfData.reserve(entry.rowOffsets.back());
+        for (const auto& row : data)
+        {
+            for (size_t index = 0; index < row.Size(); ++index)
+            {
+                entry.halfData.push_back(FloatToHalf(row[index]));
+            }
+        }
+    }
+    else
+    {
+        entry.data = std::move(data);
+    }
+
+    // make room in memory for the new entry
+    while (fitsInMemory && _options.maxMemoryBytes > 0 && _memoryUsage + size > _options.maxMemoryBytes)
+    {
+        if (!EvictLeastRecentlyUsedInMemoryEntry())
+        {
+            break;
+        }
+    }
+
+    if (_options.maxMemoryBytes > 0 && _memoryUsage + size > _options.maxMemoryBytes)
+    {
+        if (_options.spillDirectory.empty())
+        {
+            Log() << "Not caching data for port " << port->GetFullName() << ": there isn't enough room within the cache memory limit" << EOL;
+            return;
+        }
+        Spill(entry);
+    }
+    else
+    {
+        _memoryUsage += size;
+    }
+
+    _cache[port] = std::move(entry);
 }
 
 void ModelOutputDataCache::RemoveLeastRecentlyUsedEntry()
@@ -72,7 +276,93 @@ void ModelOutputDataCache::RemoveLeastRecentlyUsedEntry()
             lruEntry = it;
         }
     }
-    _cache.erase(lruEntry);
+    Remove(lruEntry);
+}
+
+bool ModelOutputDataCache::EvictLeastRecentlyUsedInMemoryEntry(const ell::model::OutputPortBase* excludedPort)
+{
+    using namespace logging;
+
+    auto lruEntry = _cache.end();
+    for (auto it = _cache.begin(); it != _cache.end(); ++it)
+    {
+        if (it->first != excludedPort && it->second.location == StorageLocation::memory && GetStoredSize(it->second) > 0 && (lruEntry == _cache.end() || it->second.generation < lruEntry->second.generation))
+        {
+            lruEntry = it;
+        }
+    }
+
+    if (lruEntry == _cache.end())
+    {
+        return false;
+    }
+
+    if (_options.spillDirectory.empty())
+    {
+        Log() << "Removing least-recently-used entry to stay within the cache memory limit" << EOL;
+        Remove(lruEntry);
+    }
+    else
+    {
+        Log() << "Spilling least-recently-used entry to disk to stay within the cache memory limit" << EOL;
+        _memoryUsage -= GetStoredSize(lruEntry->second);
+        Spill(lruEntry->second);
+    }
+    return true;
+}
+
+void ModelOutputDataCache::Spill(CacheEntry& entry)
+{
+    entry.spillFilePath = utilities::JoinPaths(_options.spillDirectory, "ModelOutputDataCache_" + std::to_string(reinterpret_cast<uintptr_t>(this)) + "_" + std::to_string(_nextSpillFileIndex++) + ".bin");
+    {
+        auto stream = utilities::OpenBinaryOfstream(entry.spillFilePath);
+        if (_options.useHalfPrecision)
+        {
+            stream.write(reinterpret_cast<const char*>(entry.halfData.data()), entry.halfData.size() * sizeof(uint16_t));
+        }
+        else
+        {
+            for (const auto& row : entry.data)
+            {
+                auto values = row.ToArray();
+                stream.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+            }
+        }
+
+        if (!stream)
+        {
+            throw utilities::SystemException(utilities::SystemExceptionErrors::fileNotWritable, "Unable to write cache data to '" + entry.spillFilePath + "'");
+        }
+    }
+
+    entry.location = StorageLocation::disk;
+    entry.data = UnlabeledDataContainer();
+    entry.halfData = std::vector<uint16_t>();
+}
+
+void ModelOutputDataCache::Remove(std::unordered_map<const ell::model::OutputPortBase*, CacheEntry>::iterator entry)
+{
+    if (entry->second.location == StorageLocation::memory)
+    {
+        _memoryUsage -= GetStoredSize(entry->second);
+    }
+    else
+    {
+        std::remove(entry->second.spillFilePath.c_str());
+    }
+    _cache.erase(entry);
+}
+
+void ModelOutputDataCache::ReleaseDecodedData()
+{
+    _decodedData = UnlabeledDataContainer();
+    _memoryUsage -= _decodedDataSize;
+    _decodedDataSize = 0;
+}
+
+size_t ModelOutputDataCache::GetStoredSize(const CacheEntry& entry) const
+{
+    return entry.rowOffsets.back() * GetBytesPerValue();
 }
 
 const OutputPortBase* ModelOutputDataCache::FindNearestCachedOutputPort(const OutputPortBase* output)
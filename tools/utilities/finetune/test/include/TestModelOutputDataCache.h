@@ -14,4 +14,7 @@ void TestModelOutputDataCache();
 // Individual tests
 void TestModelOutputDataCache_CreateAndPopulate();
 void TestModelOutputDataCache_FindNearestCachedOutput();
+void TestModelOutputDataCache_MemoryLimit();
+void TestModelOutputDataCache_HalfPrecision();
+void TestModelOutputDataCache_Spill();
 void TestModelOutputDataCache_TransformWithCache();
@@ -20,9 +20,12 @@
 #include <testing/include/testing.h>
 
 #include <utilities/include/Exception.h>
+#include <utilities/include/Files.h>
 
 // stl
 #include <algorithm>
+#include <cmath>
+#include <filesystem>
 #include <iostream>
 #include <numeric>
 
@@ -66,6 +69,32 @@ Model GetLinearTestModel()
     return model;
 }
 
+bool IsEqual(const UnlabeledDataContainer& a, const UnlabeledDataContainer& b, float tolerance = 0)
+{
+    if (a.Size() != b.Size())
+    {
+        return false;
+    }
+
+    for (size_t rowIndex = 0; rowIndex < a.Size(); ++rowIndex)
+    {
+        auto rowA = a[rowIndex];
+        auto rowB = b[rowIndex];
+        if (rowA.Size() != rowB.Size())
+        {
+            return false;
+        }
+        for (size_t index = 0; index < rowA.Size(); ++index)
+        {
+            if (std::abs(rowA[index] - rowB[index]) > tolerance * std::abs(rowB[index]))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 std::vector<const OutputPortBase*> GetModelOutputPorts(const Model& model)
 {
     std::vector<const OutputPortBase*> result;
@@ -87,6 +116,9 @@ void TestModelOutputDataCache()
 {
     FailOnException(TestModelOutputDataCache_CreateAndPopulate);
     FailOnException(TestModelOutputDataCache_FindNearestCachedOutput);
+    FailOnException(TestModelOutputDataCache_MemoryLimit);
+    FailOnException(TestModelOutputDataCache_HalfPrecision);
+    FailOnException(TestModelOutputDataCache_Spill);
 }
 
 void TestModelOutputDataCache_CreateAndPopulate()
@@ -143,3 +175,131 @@ void TestModelOutputDataCache_FindNearestCachedOutput()
 
     ProcessTest("Testing FindNearestCachedOutput", cache.FindNearestCachedOutputPort(outputPorts[3]) == outputPorts[1]);
 }
+
+void TestModelOutputDataCache_MemoryLimit()
+{
+    auto model = GetLinearTestModel();
+    auto data = GetTestDataset(); // 12 rows of 10 floats: 480 bytes
+    auto outputPorts = GetModelOutputPorts(model);
+
+    ModelOutputDataCacheOptions options;
+    options.maxMemoryBytes = 1000;
+    ModelOutputDataCache cache(options);
+
+    cache.SetCachedData(outputPorts[0], data);
+    cache.SetCachedData(outputPorts[1], data);
+    ProcessTest("Testing cache memory usage", cache.GetMemoryUsage() == 960);
+
+    // Touch the first entry, so the second one is the least recently used
+    cache.GetCachedData(outputPorts[0]);
+    cache.SetCachedData(outputPorts[2], data);
+    ProcessTest("Testing cache memory limit evicts the least-recently-used entry",
+                cache.HasCachedData(outputPorts[0]) && !cache.HasCachedData(outputPorts[1]) && cache.HasCachedData(outputPorts[2]) && cache.GetMemoryUsage() == 960);
+
+    cache.RemoveCachedData(outputPorts[0]);
+    ProcessTest("Testing cache memory usage after removing an entry", cache.GetMemoryUsage() == 480);
+
+    // An entry larger than the whole memory limit is rejected without evicting the entries already in the cache
+    UnlabeledDataContainer largeData;
+    for (int index = 0; index < 3; ++index)
+    {
+        for (const auto& row : data)
+        {
+            largeData.Add(row);
+        }
+    }
+    cache.SetCachedData(outputPorts[0], data);
+    cache.SetCachedData(outputPorts[3], largeData);
+    ProcessTest("Testing cache doesn't evict entries for an entry larger than the memory limit",
+                cache.HasCachedData(outputPorts[0]) && cache.HasCachedData(outputPorts[2]) && !cache.HasCachedData(outputPorts[3]) && cache.GetMemoryUsage() == 960);
+
+    ModelOutputDataCacheOptions smallOptions;
+    smallOptions.maxMemoryBytes = 100;
+    ModelOutputDataCache smallCache(smallOptions);
+    smallCache.SetCachedData(outputPorts[0], data);
+    ProcessTest("Testing cache doesn't keep entries larger than the memory limit", !smallCache.HasCachedData(outputPorts[0]) && smallCache.GetMemoryUsage() == 0);
+}
+
+void TestModelOutputDataCache_HalfPrecision()
+{
+    auto model = GetLinearTestModel();
+    auto data = GetTestDataset();
+    auto outputPorts = GetModelOutputPorts(model);
+
+    ModelOutputDataCacheOptions options;
+    options.useHalfPrecision = true;
+    ModelOutputDataCache cache(options);
+    cache.SetCachedData(outputPorts[0], data);
+
+    ProcessTest("Testing half-precision cache memory usage", cache.GetMemoryUsage() == 240);
+
+    // Small integers are exact in half precision
+    ProcessTest("Testing half-precision GetCachedData", IsEqual(cache.GetCachedData(outputPorts[0]), data));
+
+    UnlabeledDataContainer fractionalData;
+    fractionalData.Add({ std::vector<float>{ 0.1f, -3.14159f, 1000.5f, 1.0e-3f } });
+    cache.SetCachedData(outputPorts[1], fractionalData);
+    ProcessTest("Testing half-precision rounding", IsEqual(cache.GetCachedData(outputPorts[1]), fractionalData, 1.0f / 1024));
+
+    // The decoded copy of an entry counts against the memory limit
+    options.maxMemoryBytes = 1000;
+    ModelOutputDataCache limitedCache(options);
+    for (int index = 0; index < 4; ++index)
+    {
+        limitedCache.SetCachedData(outputPorts[index], data);
+    }
+    ProcessTest("Testing half-precision cache memory usage with a memory limit", limitedCache.GetMemoryUsage() == 960);
+
+    ProcessTest("Testing half-precision GetCachedData with a memory limit", IsEqual(limitedCache.GetCachedData(outputPorts[0]), data));
+    ProcessTest("Testing decoded data counts against the memory limit",
+                limitedCache.HasCachedData(outputPorts[0]) && !limitedCache.HasCachedData(outputPorts[1]) && !limitedCache.HasCachedData(outputPorts[2]) && limitedCache.HasCachedData(outputPorts[3]) && limitedCache.GetMemoryUsage() == 960);
+
+    limitedCache.SetCachedData(outputPorts[4], data);
+    ProcessTest("Testing decoded data is released by the next call", limitedCache.GetMemoryUsage() == 720);
+}
+
+void TestModelOutputDataCache_Spill()
+{
+    auto model = GetLinearTestModel();
+    auto data = GetTestDataset();
+    auto outputPorts = GetModelOutputPorts(model);
+
+    auto spillDirectory = utilities::JoinPaths(utilities::GetWorkingDirectory(), "TestModelOutputDataCache_Spill");
+    std::filesystem::remove_all(spillDirectory);
+    auto countSpillFiles = [&spillDirectory]() {
+        return std::distance(std::filesystem::directory_iterator(spillDirectory), std::filesystem::directory_iterator());
+    };
+
+    for (auto useHalfPrecision : { false, true })
+    {
+        ModelOutputDataCacheOptions options;
+        options.maxMemoryBytes = 1000;
+        options.useHalfPrecision = useHalfPrecision;
+        options.spillDirectory = spillDirectory;
+        auto precisionName = std::string(useHalfPrecision ? " (half precision)" : "");
+        {
+            ModelOutputDataCache cache(options);
+            auto entriesInMemory = useHalfPrecision ? 4 : 2;
+            for (int index = 0; index <= entriesInMemory; ++index)
+            {
+                cache.SetCachedData(outputPorts[index], data);
+            }
+
+            ProcessTest("Testing cache spills the least-recently-used entry" + precisionName,
+                        cache.IsSpilled(outputPorts[0]) && !cache.IsSpilled(outputPorts[entriesInMemory]) && countSpillFiles() == 1);
+            ProcessTest("Testing GetCachedData for a spilled entry" + precisionName, IsEqual(cache.GetCachedData(outputPorts[0]), data));
+            ProcessTest("Testing decoding a spilled entry stays within the memory limit" + precisionName,
+                        cache.GetMemoryUsage() <= options.maxMemoryBytes && !cache.IsSpilled(outputPorts[entriesInMemory]));
+
+            // Decoding the spilled entry may have spilled other entries to make room for it
+            cache.RemoveCachedData(outputPorts[0]);
+            auto numSpilled = std::count_if(outputPorts.begin(), outputPorts.end(), [&cache](auto p) { return cache.IsSpilled(p); });
+            ProcessTest("Testing removing a spilled entry" + precisionName, !cache.HasCachedData(outputPorts[0]) && countSpillFiles() == numSpilled);
+
+            cache.SetCachedData(outputPorts[0], data);
+        }
+        ProcessTest("Testing cache removes spill files when destroyed" + precisionName, countSpillFiles() == 0);
+    }
+
+    std::filesystem::remove_all(spillDirectory);
+}